@@ -629,6 +629,16 @@ cPluginManager.AddHook(cPluginManager.HOOK_CHAT, OnChatMessage);
 				},
 				Notes = "Returns true if console Command is already bound (by any plugin)",
 			},
+			IsHookStatsEnabled =
+			{
+				Returns =
+				{
+					{
+						Type = "boolean",
+					},
+				},
+				Notes = "Returns true if the server is measuring the number of calls and the time spent in each plugin's hook handlers. The stats can be viewed using the \"hookstats\" console command or the \"Plugin hook stats\" webadmin page.",
+			},
 			IsPluginLoaded =
 			{
 				Params =
@@ -664,6 +674,21 @@ cPluginManager.AddHook(cPluginManager.HOOK_CHAT, OnChatMessage);
 			{
 				Notes = "Reloads all active plugins",
 			},
+			ResetHookStats =
+			{
+				Notes = "Zeroes the hook call counts and durations measured for all plugins.",
+			},
+			SetHookStatsEnabled =
+			{
+				Params =
+				{
+					{
+						Name = "IsEnabled",
+						Type = "boolean",
+					},
+				},
+				Notes = "Enables or disables measuring the number of calls and the time spent in each plugin's hook handlers. Measuring adds a small overhead to each hook call, so it is disabled by default.",
+			},
 			UnloadPlugin =
 			{
 				Params =
@@ -164,7 +164,7 @@ return
 						Type = "cItem",
 					},
 				},
-				Notes = "Returns the item that has been used to create the firework rocket. The item's m_FireworkItem member contains all the firework-related data.",
+				Notes = "Returns the item that has been used to create the firework rocket.",
 			},
 			GetTicksToExplosion =
 			{
@@ -2609,6 +2609,25 @@ function OnAllChunksAvailable()</pre> All return values from the callbacks are i
 			{
 				Notes = "Queues a cTask that unloads chunks that are no longer needed and are saved.",
 			},
+			QueueWriteBlockArea =
+			{
+				Params =
+				{
+					{
+						Name = "BlockArea",
+						Type = "cBlockArea",
+					},
+					{
+						Name = "MinCoords",
+						Type = "Vector3i",
+					},
+					{
+						Name = "DataTypes",
+						Type = "number",
+					},
+				},
+				Notes = "Writes a copy of the {{cBlockArea|BlockArea}} into the world at the specified coords, spread over multiple ticks so that large areas don't stall the world. Each tick writes at most as many blocks as the [General] BlockAreaWriteBudget setting in world.ini allows, but at least a single chunk. The area may be modified or destroyed right after this call returns. Chunks that aren't loaded when their turn comes are skipped. DataTypes is a bitmask of {{cBlockArea}}.ba* constants. The simulators in the area are woken up once the whole area has been written.",
+			},
 			RegenerateChunk =
 			{
 				Params =
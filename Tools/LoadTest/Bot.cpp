@@ -0,0 +1,762 @@
+
+// Bot.cpp
+
+// Implements the cBot class representing a single simulated client connected to the server under test
+
+#include "Globals.h"
+#include "Bot.h"
+
+#include <fcntl.h>
+#include <netdb.h>
+
+
+
+
+
+/** The protocol version the bots speak (1.8). */
+static const UInt32 PROTOCOL_VERSION = 47;
+
+/** The speeds of the walking and flying bots, in blocks per client tick. */
+static const double WALK_SPEED = 0.2;
+static const double FLY_SPEED = 1;
+
+/** The walking bots turn back towards their spawn when they get farther than this. */
+static const double WALK_RADIUS = 32;
+
+/** The height above the spawn at which the flying bots fly. */
+static const double FLY_HEIGHT = 40;
+
+/** The intervals of the actions, in client ticks. */
+static const int WALK_TURN_INTERVAL = 100;
+static const int DIG_INTERVAL = 10;
+static const int CHAT_INTERVAL = 40;
+
+
+
+
+
+/** Appends the VarInt-encoded value to the data. */
+static void AppendVarInt(ContiguousByteBuffer & a_Data, UInt32 a_Value)
+{
+	do
+	{
+		auto Byte = static_cast<UInt8>(a_Value & 0x7f);
+		a_Value >>= 7;
+		if (a_Value != 0)
+		{
+			Byte |= 0x80;
+		}
+		a_Data.push_back(static_cast<std::byte>(Byte));
+	} while (a_Value != 0);
+}
+
+
+
+
+
+/** Creates a random generator seeded by both the run seed and the bot's own seed. */
+static cFastRandom MakeRandom(UInt64 a_Seed)
+{
+	std::seed_seq Seq{ static_cast<UInt32>(a_Seed >> 32), static_cast<UInt32>(a_Seed) };
+	return cFastRandom(Seq);
+}
+
+
+
+
+
+cBot::cBot(AString a_Name, eBehavior a_Behavior, UInt64 a_Seed, int a_ViewDistance):
+	m_Name(std::move(a_Name)),
+	m_Behavior(a_Behavior),
+	m_Random(MakeRandom(a_Seed)),
+	m_ViewDistance(a_ViewDistance),
+	m_Socket(-1),
+	m_State(stLogin),
+	m_IsCompressed(false),
+	m_ReceivedData(4 MiB),
+	m_PacketData(1 MiB),
+	m_OutPacket(64 KiB),
+	m_HasSpawned(false),
+	m_Yaw(0),
+	m_TickNum(0),
+	m_CurrentChunk(0, 0)
+{
+}
+
+
+
+
+
+cBot::~cBot()
+{
+	if (m_Socket >= 0)
+	{
+		close(m_Socket);
+	}
+}
+
+
+
+
+
+const char * cBot::GetBehaviorName(eBehavior a_Behavior)
+{
+	switch (a_Behavior)
+	{
+		case bhWalker:  return "walker";
+		case bhFlyer:   return "flyer";
+		case bhBuilder: return "builder";
+		case bhChatter: return "chatter";
+		case bhNumBehaviors: break;
+	}
+	UNREACHABLE("Unknown bot behavior");
+}
+
+
+
+
+
+bool cBot::Connect(const AString & a_Host, UInt16 a_Port)
+{
+	addrinfo Hints = {};
+	Hints.ai_family = AF_UNSPEC;
+	Hints.ai_socktype = SOCK_STREAM;
+	addrinfo * Addresses = nullptr;
+	if (getaddrinfo(a_Host.c_str(), std::to_string(a_Port).c_str(), &Hints, &Addresses) != 0)
+	{
+		return Disconnect(fmt::format(FMT_STRING("Cannot resolve {}"), a_Host));
+	}
+	for (auto Address = Addresses; Address != nullptr; Address = Address->ai_next)
+	{
+		m_Socket = socket(Address->ai_family, Address->ai_socktype, Address->ai_protocol);
+		if (m_Socket < 0)
+		{
+			continue;
+		}
+		if (connect(m_Socket, Address->ai_addr, Address->ai_addrlen) == 0)
+		{
+			break;
+		}
+		close(m_Socket);
+		m_Socket = -1;
+	}
+	freeaddrinfo(Addresses);
+	if (m_Socket < 0)
+	{
+		return Disconnect(fmt::format(FMT_STRING("Cannot connect to {}:{}: {}"), a_Host, a_Port, strerror(errno)));
+	}
+
+	int NoDelay = 1;
+	setsockopt(m_Socket, IPPROTO_TCP, TCP_NODELAY, &NoDelay, sizeof(NoDelay));
+	fcntl(m_Socket, F_SETFL, fcntl(m_Socket, F_GETFL) | O_NONBLOCK);
+
+	// Handshake, with the next state being login:
+	m_OutPacket.WriteVarInt32(0x00);
+	m_OutPacket.WriteVarInt32(PROTOCOL_VERSION);
+	m_OutPacket.WriteVarUTF8String(a_Host);
+	m_OutPacket.WriteBEUInt16(a_Port);
+	m_OutPacket.WriteVarInt32(2);
+	if (!SendPacket())
+	{
+		return false;
+	}
+
+	// Login start:
+	m_OutPacket.WriteVarInt32(0x00);
+	m_OutPacket.WriteVarUTF8String(m_Name);
+	return SendPacket();
+}
+
+
+
+
+
+bool cBot::OnReadable(void)
+{
+	std::byte Buffer[64 KiB];
+	for (;;)
+	{
+		auto NumReceived = recv(m_Socket, Buffer, sizeof(Buffer), 0);
+		if (NumReceived == 0)
+		{
+			return Disconnect("Connection closed by the server");
+		}
+		if (NumReceived < 0)
+		{
+			if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+			{
+				return true;
+			}
+			return Disconnect(fmt::format(FMT_STRING("Receive failed: {}"), strerror(errno)));
+		}
+		m_Stats.m_BytesReceived += static_cast<UInt64>(NumReceived);
+		if (!m_ReceivedData.Write(Buffer, static_cast<size_t>(NumReceived)))
+		{
+			return Disconnect("Receive buffer overflow");
+		}
+		if (!ProcessReceivedData())
+		{
+			return false;
+		}
+	}
+}
+
+
+
+
+
+bool cBot::OnWritable(void)
+{
+	if (m_OutgoingData.empty())
+	{
+		return true;
+	}
+	auto NumSent = send(m_Socket, m_OutgoingData.data(), m_OutgoingData.size(), MSG_NOSIGNAL);
+	if (NumSent < 0)
+	{
+		if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+		{
+			return true;
+		}
+		return Disconnect(fmt::format(FMT_STRING("Send failed: {}"), strerror(errno)));
+	}
+	m_OutgoingData.erase(0, static_cast<size_t>(NumSent));
+	return true;
+}
+
+
+
+
+
+bool cBot::Tick(void)
+{
+	if (!m_HasSpawned || !IsConnected())
+	{
+		return IsConnected();
+	}
+	m_TickNum += 1;
+
+	switch (m_Behavior)
+	{
+		case bhWalker:
+		{
+			if ((m_TickNum % WALK_TURN_INTERVAL) == 1)
+			{
+				auto Angle = m_Random.RandReal(2 * M_PI);
+				m_Direction = { cos(Angle), 0, sin(Angle) };
+			}
+			if ((m_Position - m_SpawnPosition).SqrLength() > WALK_RADIUS * WALK_RADIUS)
+			{
+				m_Direction = (m_SpawnPosition - m_Position).NormalizeCopy();
+				m_Direction.y = 0;
+			}
+			m_Position += m_Direction * WALK_SPEED;
+			return SendPosition();
+		}
+
+		case bhFlyer:
+		{
+			// The direction was chosen on spawn, keep flying straight to force streaming new chunks:
+			m_Position += m_Direction * FLY_SPEED;
+			return SendPosition();
+		}
+
+		case bhBuilder:
+		{
+			if ((m_TickNum % DIG_INTERVAL) == 0)
+			{
+				auto Block = m_SpawnPosition.Floor() + Vector3i(m_Random.RandInt(-4, 4), -1, m_Random.RandInt(-4, 4));
+				if (!SendDigAndPlace(Block))
+				{
+					return false;
+				}
+			}
+			break;
+		}
+
+		case bhChatter:
+		{
+			if ((m_TickNum % CHAT_INTERVAL) == 0)
+			{
+				if (!SendChat(fmt::format(FMT_STRING("Message {} from {}"), m_TickNum / CHAT_INTERVAL, m_Name)))
+				{
+					return false;
+				}
+			}
+			break;
+		}
+
+		case bhNumBehaviors: break;
+	}
+
+	// The idle bots still send the on-ground packet each tick, as the vanilla client does:
+	m_OutPacket.WriteVarInt32(0x03);
+	m_OutPacket.WriteBool(true);
+	return SendPacket();
+}
+
+
+
+
+
+void cBot::ResetStats(void)
+{
+	m_Stats = sStats();
+	m_FirstWorldAge.reset();
+	m_LastWorldAge.reset();
+}
+
+
+
+
+
+double cBot::GetTPSEstimate(void) const
+{
+	if (!m_FirstWorldAge.has_value() || !m_LastWorldAge.has_value())
+	{
+		return -1;
+	}
+	auto Seconds = std::chrono::duration<double>(m_LastWorldAge->second - m_FirstWorldAge->second).count();
+	if (Seconds < 1)
+	{
+		return -1;
+	}
+	return static_cast<double>(m_LastWorldAge->first - m_FirstWorldAge->first) / Seconds;
+}
+
+
+
+
+
+bool cBot::Disconnect(const AString & a_Reason)
+{
+	if (m_DisconnectReason.empty())
+	{
+		m_DisconnectReason = a_Reason;
+	}
+	if (m_Socket >= 0)
+	{
+		close(m_Socket);
+		m_Socket = -1;
+	}
+	return false;
+}
+
+
+
+
+
+bool cBot::ProcessReceivedData(void)
+{
+	for (;;)
+	{
+		UInt32 PacketLen;
+		if (!m_ReceivedData.ReadVarInt32(PacketLen) || !m_ReceivedData.CanReadBytes(PacketLen))
+		{
+			// Not a complete packet yet
+			m_ReceivedData.ResetRead();
+			return true;
+		}
+
+		UInt32 UncompressedSize = 0;
+		if (m_IsCompressed)
+		{
+			if (!m_ReceivedData.ReadVarInt32(UncompressedSize) || (PacketLen < cByteBuffer::GetVarIntSize(UncompressedSize)))
+			{
+				return Disconnect("Bad compression header");
+			}
+			PacketLen -= static_cast<UInt32>(cByteBuffer::GetVarIntSize(UncompressedSize));
+		}
+		m_ReceivedData.ReadSome(m_CompressedPacket, PacketLen);
+		m_ReceivedData.CommitRead();
+		m_Stats.m_NumPacketsReceived += 1;
+
+		// Decompress into the packet buffer:
+		bool IsWritten;
+		if (UncompressedSize == 0)
+		{
+			IsWritten = m_PacketData.Write(m_CompressedPacket.data(), m_CompressedPacket.size());
+		}
+		else
+		{
+			try
+			{
+				auto Uncompressed = m_Extractor.ExtractZLib(m_CompressedPacket, UncompressedSize);
+				auto View = Uncompressed.GetView();
+				IsWritten = m_PacketData.Write(View.data(), View.size());
+			}
+			catch (const std::exception & Oops)
+			{
+				return Disconnect(fmt::format(FMT_STRING("Cannot decompress a packet: {}"), Oops.what()));
+			}
+		}
+		if (!IsWritten)
+		{
+			return Disconnect("Received packet too large");
+		}
+
+		UInt32 PacketType;
+		bool IsHandled = m_PacketData.ReadVarInt32(PacketType) && HandlePacket(PacketType);
+		m_PacketData.SkipRead(m_PacketData.GetReadableSpace());
+		m_PacketData.CommitRead();
+		if (!IsHandled)
+		{
+			return Disconnect(fmt::format(FMT_STRING("Malformed packet 0x{:02x}"), PacketType));
+		}
+		if (!IsConnected())
+		{
+			return false;
+		}
+	}
+}
+
+
+
+
+
+bool cBot::HandlePacket(UInt32 a_PacketType)
+{
+	switch (m_State)
+	{
+		case stLogin: return HandleLoginPacket(a_PacketType);
+		case stGame:  return HandleGamePacket(a_PacketType);
+	}
+	UNREACHABLE("Unknown bot state");
+}
+
+
+
+
+
+bool cBot::HandleLoginPacket(UInt32 a_PacketType)
+{
+	switch (a_PacketType)
+	{
+		case 0x00:
+		{
+			AString Reason;
+			m_PacketData.ReadVarUTF8String(Reason);
+			Disconnect(fmt::format(FMT_STRING("Login refused: {}"), Reason));
+			return true;
+		}
+		case 0x01:
+		{
+			Disconnect("The server requires authentication, set Authenticate=0 in its settings.ini");
+			return true;
+		}
+		case 0x02:
+		{
+			// Login success, the game starts; send the client settings with the view distance:
+			m_State = stGame;
+			m_OutPacket.WriteVarInt32(0x15);
+			m_OutPacket.WriteVarUTF8String("en_US");
+			m_OutPacket.WriteBEUInt8(static_cast<UInt8>(m_ViewDistance));
+			m_OutPacket.WriteBEUInt8(0);  // Chat enabled
+			m_OutPacket.WriteBool(true);  // Chat colors
+			m_OutPacket.WriteBEUInt8(0x7f);  // All skin parts
+			return SendPacket();
+		}
+		case 0x03:
+		{
+			m_IsCompressed = true;
+			return true;
+		}
+	}
+	return false;
+}
+
+
+
+
+
+bool cBot::HandleGamePacket(UInt32 a_PacketType)
+{
+	switch (a_PacketType)
+	{
+		case 0x00:
+		{
+			UInt32 KeepAliveID;
+			if (!m_PacketData.ReadVarInt32(KeepAliveID))
+			{
+				return false;
+			}
+			m_OutPacket.WriteVarInt32(0x00);
+			m_OutPacket.WriteVarInt32(KeepAliveID);
+			SendPacket();
+			return true;
+		}
+		case 0x02:
+		{
+			m_Stats.m_NumChatsReceived += 1;
+			return true;
+		}
+		case 0x03: return HandleTimeUpdate();
+		case 0x08: return HandlePlayerPosLook();
+		case 0x21: return HandleChunkData();
+		case 0x40:
+		{
+			AString Reason;
+			m_PacketData.ReadVarUTF8String(Reason);
+			Disconnect(fmt::format(FMT_STRING("Kicked: {}"), Reason));
+			return true;
+		}
+	}
+
+	// All the other packets are only counted:
+	return true;
+}
+
+
+
+
+
+bool cBot::HandleChunkData(void)
+{
+	Int32 ChunkX, ChunkZ;
+	bool IsGroundUp;
+	UInt16 SectionBitmask;
+	UInt32 DataSize;
+	if (
+		!m_PacketData.ReadBEInt32(ChunkX) || !m_PacketData.ReadBEInt32(ChunkZ) || !m_PacketData.ReadBool(IsGroundUp) ||
+		!m_PacketData.ReadBEUInt16(SectionBitmask) || !m_PacketData.ReadVarInt32(DataSize)
+	)
+	{
+		return false;
+	}
+
+	cChunkCoords Coords(ChunkX, ChunkZ);
+	if (IsGroundUp && (SectionBitmask == 0) && (DataSize == 0))
+	{
+		// The server unloads the chunk
+		m_LoadedChunks.erase(Coords);
+		m_Stats.m_NumChunksUnloaded += 1;
+		return true;
+	}
+
+	m_LoadedChunks.insert(Coords);
+	m_Stats.m_NumChunksReceived += 1;
+	auto Pending = m_PendingChunks.find(Coords);
+	if (Pending != m_PendingChunks.end())
+	{
+		m_Stats.m_ChunkLatencies.push_back(std::chrono::duration<double, std::milli>(cClock::now() - Pending->second).count());
+		m_PendingChunks.erase(Pending);
+	}
+	return true;
+}
+
+
+
+
+
+bool cBot::HandlePlayerPosLook(void)
+{
+	Vector3d Position;
+	float Yaw, Pitch;
+	UInt8 Flags;
+	if (
+		!m_PacketData.ReadBEDouble(Position.x) || !m_PacketData.ReadBEDouble(Position.y) || !m_PacketData.ReadBEDouble(Position.z) ||
+		!m_PacketData.ReadBEFloat(Yaw) || !m_PacketData.ReadBEFloat(Pitch) || !m_PacketData.ReadBEUInt8(Flags)
+	)
+	{
+		return false;
+	}
+
+	// Apply the relative coords:
+	m_Position.x = ((Flags & 0x01) != 0) ? (m_Position.x + Position.x) : Position.x;
+	m_Position.y = ((Flags & 0x02) != 0) ? (m_Position.y + Position.y) : Position.y;
+	m_Position.z = ((Flags & 0x04) != 0) ? (m_Position.z + Position.z) : Position.z;
+	m_Yaw = ((Flags & 0x08) != 0) ? (m_Yaw + Yaw) : Yaw;
+
+	if (m_HasSpawned)
+	{
+		m_Stats.m_NumTeleports += 1;
+	}
+	else
+	{
+		m_HasSpawned = true;
+		m_SpawnPosition = m_Position;
+		if (m_Behavior == bhFlyer)
+		{
+			// Fly high above the terrain, in a random direction:
+			auto Angle = m_Random.RandReal(2 * M_PI);
+			m_Direction = { cos(Angle), 0, sin(Angle) };
+			m_Position.y += FLY_HEIGHT;
+		}
+	}
+
+	// Confirm the position, as the vanilla client does:
+	m_OutPacket.WriteVarInt32(0x06);
+	m_OutPacket.WriteBEDouble(m_Position.x);
+	m_OutPacket.WriteBEDouble(m_Position.y);
+	m_OutPacket.WriteBEDouble(m_Position.z);
+	m_OutPacket.WriteBEFloat(m_Yaw);
+	m_OutPacket.WriteBEFloat(0);
+	m_OutPacket.WriteBool(true);
+	SendPacket();
+	UpdatePendingChunks(true);
+	return true;
+}
+
+
+
+
+
+bool cBot::HandleTimeUpdate(void)
+{
+	Int64 WorldAge, TimeOfDay;
+	if (!m_PacketData.ReadBEInt64(WorldAge) || !m_PacketData.ReadBEInt64(TimeOfDay))
+	{
+		return false;
+	}
+	auto Sample = std::make_pair(WorldAge, cClock::now());
+	if (!m_FirstWorldAge.has_value())
+	{
+		m_FirstWorldAge = Sample;
+	}
+	m_LastWorldAge = Sample;
+	return true;
+}
+
+
+
+
+
+bool cBot::SendPacket(void)
+{
+	ContiguousByteBuffer Payload;
+	m_OutPacket.ReadAll(Payload);
+	m_OutPacket.CommitRead();
+
+	// The bots never compress; an uncompressed size of 0 marks the packet as uncompressed:
+	ContiguousByteBuffer Packet;
+	if (m_IsCompressed)
+	{
+		AppendVarInt(Packet, static_cast<UInt32>(Payload.size() + 1));
+		AppendVarInt(Packet, 0);
+	}
+	else
+	{
+		AppendVarInt(Packet, static_cast<UInt32>(Payload.size()));
+	}
+	Packet.append(Payload);
+	m_Stats.m_NumPacketsSent += 1;
+	return SendRaw(Packet);
+}
+
+
+
+
+
+bool cBot::SendRaw(ContiguousByteBufferView a_Data)
+{
+	if (!IsConnected())
+	{
+		return false;
+	}
+	m_Stats.m_BytesSent += a_Data.size();
+	m_OutgoingData.append(a_Data);
+	return OnWritable();
+}
+
+
+
+
+
+bool cBot::SendPosition(void)
+{
+	m_OutPacket.WriteVarInt32(0x04);
+	m_OutPacket.WriteBEDouble(m_Position.x);
+	m_OutPacket.WriteBEDouble(m_Position.y);
+	m_OutPacket.WriteBEDouble(m_Position.z);
+	m_OutPacket.WriteBool(m_Behavior != bhFlyer);
+	if (!SendPacket())
+	{
+		return false;
+	}
+	UpdatePendingChunks(false);
+	return true;
+}
+
+
+
+
+
+bool cBot::SendDigAndPlace(Vector3i a_BlockPos)
+{
+	// Start and finish digging the block from the top:
+	for (Int8 Status: { 0, 2 })
+	{
+		m_OutPacket.WriteVarInt32(0x07);
+		m_OutPacket.WriteBEInt8(Status);
+		m_OutPacket.WriteXYZPosition64(a_BlockPos.x, a_BlockPos.y, a_BlockPos.z);
+		m_OutPacket.WriteBEInt8(1);
+		if (!SendPacket())
+		{
+			return false;
+		}
+	}
+
+	// Place onto the top of the block below, with the equipped item:
+	m_OutPacket.WriteVarInt32(0x08);
+	m_OutPacket.WriteXYZPosition64(a_BlockPos.x, a_BlockPos.y - 1, a_BlockPos.z);
+	m_OutPacket.WriteBEInt8(1);
+	m_OutPacket.WriteBEInt16(-1);  // Empty slot, the server uses the equipped item
+	m_OutPacket.WriteBEUInt8(8);
+	m_OutPacket.WriteBEUInt8(16);
+	m_OutPacket.WriteBEUInt8(8);
+	return SendPacket();
+}
+
+
+
+
+
+bool cBot::SendChat(const AString & a_Message)
+{
+	m_OutPacket.WriteVarInt32(0x01);
+	m_OutPacket.WriteVarUTF8String(a_Message);
+	return SendPacket();
+}
+
+
+
+
+
+void cBot::UpdatePendingChunks(bool a_Force)
+{
+	cChunkCoords Chunk(FloorC(m_Position.x / 16), FloorC(m_Position.z / 16));
+	if (!a_Force && (Chunk == m_CurrentChunk))
+	{
+		return;
+	}
+	m_CurrentChunk = Chunk;
+	auto Now = cClock::now();
+
+	// Chunks that went out of the view distance before arriving won't be sent anymore, stop waiting for them:
+	for (auto itr = m_PendingChunks.begin(); itr != m_PendingChunks.end();)
+	{
+		if (
+			(std::abs(itr->first.first - Chunk.first) > m_ViewDistance) ||
+			(std::abs(itr->first.second - Chunk.second) > m_ViewDistance)
+		)
+		{
+			itr = m_PendingChunks.erase(itr);
+		}
+		else
+		{
+			++itr;
+		}
+	}
+
+	for (int z = -m_ViewDistance; z <= m_ViewDistance; z++)
+	{
+		for (int x = -m_ViewDistance; x <= m_ViewDistance; x++)
+		{
+			cChunkCoords Coords(Chunk.first + x, Chunk.second + z);
+			if (m_LoadedChunks.find(Coords) == m_LoadedChunks.end())
+			{
+				m_PendingChunks.emplace(Coords, Now);  // Keeps the original time if already pending
+			}
+		}
+	}
+}
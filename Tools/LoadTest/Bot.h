@@ -0,0 +1,190 @@
+
+// Bot.h
+
+// Declares the cBot class representing a single simulated client connected to the server under test
+
+
+
+
+
+#pragma once
+
+#include <optional>
+
+#include "ByteBuffer.h"
+#include "FastRandom.h"
+#include "StringCompression.h"
+
+
+
+
+
+/** A simulated client, speaking the 1.8 protocol (#47) in offline mode over a non-blocking socket.
+After joining, the bot performs its behavior in each Tick(): walking around its spawn, flying in a straight line
+(to force chunk streaming), digging and placing blocks, or chatting. The behavior is deterministic given the seed.
+The bot measures the traffic, and the chunk latency: the time from the bot entering a chunk until the server sends
+each of the chunks within the view distance that the bot doesn't have yet. */
+class cBot
+{
+public:
+
+	enum eBehavior
+	{
+		bhWalker,
+		bhFlyer,
+		bhBuilder,
+		bhChatter,
+
+		bhNumBehaviors,
+	};
+
+	/** The measurements since the last ResetStats(). */
+	struct sStats
+	{
+		UInt64 m_BytesSent = 0;
+		UInt64 m_BytesReceived = 0;
+		size_t m_NumPacketsSent = 0;
+		size_t m_NumPacketsReceived = 0;
+		size_t m_NumChunksReceived = 0;
+		size_t m_NumChunksUnloaded = 0;
+		size_t m_NumTeleports = 0;
+		size_t m_NumChatsReceived = 0;
+
+		/** The latencies of the chunks that arrived, in milliseconds. */
+		std::vector<double> m_ChunkLatencies;
+	};
+
+
+	cBot(AString a_Name, eBehavior a_Behavior, UInt64 a_Seed, int a_ViewDistance);
+	~cBot();
+
+	static const char * GetBehaviorName(eBehavior a_Behavior);
+
+	/** Connects to the server and sends the handshake and login. Returns false and logs the reason on failure. */
+	bool Connect(const AString & a_Host, UInt16 a_Port);
+
+	/** Receives and processes the data available on the socket. Returns false if the connection is lost. */
+	bool OnReadable(void);
+
+	/** Sends the queued outgoing data that the socket accepts. Returns false if the connection is lost. */
+	bool OnWritable(void);
+
+	/** Performs the bot's behavior for one client tick (50 ms). Returns false if the connection is lost. */
+	bool Tick(void);
+
+	/** Starts a new measurement period. */
+	void ResetStats(void);
+
+	/** Returns the number of the chunks within the view distance that the bot is still waiting for. */
+	size_t GetNumChunksOutstanding(void) const { return m_PendingChunks.size(); }
+
+	/** Estimates the server's ticks per second from the world age in the time updates received since ResetStats().
+	Returns a negative number if there weren't enough time updates. */
+	double GetTPSEstimate(void) const;
+
+	int GetSocket(void) const { return m_Socket; }
+	bool HasOutgoingData(void) const { return !m_OutgoingData.empty(); }
+	bool IsInGame(void) const { return m_HasSpawned; }
+	bool IsConnected(void) const { return (m_Socket >= 0); }
+	const AString & GetName(void) const { return m_Name; }
+	eBehavior GetBehavior(void) const { return m_Behavior; }
+	const AString & GetDisconnectReason(void) const { return m_DisconnectReason; }
+	const sStats & GetStats(void) const { return m_Stats; }
+
+protected:
+
+	using cChunkCoords = std::pair<int, int>;
+	using cClock = std::chrono::steady_clock;
+
+	enum eState
+	{
+		stLogin,
+		stGame,
+	};
+
+	AString m_Name;
+	eBehavior m_Behavior;
+	cFastRandom m_Random;
+	int m_ViewDistance;
+
+	int m_Socket;
+	eState m_State;
+	bool m_IsCompressed;
+
+	/** The raw data received, not yet split into packets. */
+	cByteBuffer m_ReceivedData;
+
+	/** The data of a single received packet being parsed. */
+	cByteBuffer m_PacketData;
+
+	/** Reusable buffers for a received packet's data and a sent packet's framing. */
+	ContiguousByteBuffer m_CompressedPacket;
+	cByteBuffer m_OutPacket;
+
+	Compression::Extractor m_Extractor;
+
+	/** The data waiting to be sent, when the socket doesn't accept it all at once. */
+	ContiguousByteBuffer m_OutgoingData;
+
+	/** Set when the server sends the first player position. */
+	bool m_HasSpawned;
+	Vector3d m_SpawnPosition;
+	Vector3d m_Position;
+	float m_Yaw;
+
+	/** The direction of the walk or flight, in the XZ plane. */
+	Vector3d m_Direction;
+
+	/** The number of client ticks since spawning. */
+	int m_TickNum;
+
+	/** The chunk the bot is in. */
+	cChunkCoords m_CurrentChunk;
+
+	/** The chunks that the server has sent and not unloaded. */
+	std::set<cChunkCoords> m_LoadedChunks;
+
+	/** The chunks within the view distance that haven't arrived yet, with the time they came into view. */
+	std::map<cChunkCoords, cClock::time_point> m_PendingChunks;
+
+	/** The first and the last world age received in a time update since ResetStats(), with the times they were received. */
+	std::optional<std::pair<Int64, cClock::time_point>> m_FirstWorldAge, m_LastWorldAge;
+
+	sStats m_Stats;
+
+	AString m_DisconnectReason;
+
+
+	/** Closes the socket, remembering the reason. Returns false, for use in return statements. */
+	bool Disconnect(const AString & a_Reason);
+
+	/** Splits the received data into packets and handles them. Returns false on a protocol error. */
+	bool ProcessReceivedData(void);
+
+	/** Handles the packet in m_PacketData. Returns false on a protocol error or if the server disconnected the bot. */
+	bool HandlePacket(UInt32 a_PacketType);
+
+	bool HandleLoginPacket(UInt32 a_PacketType);
+	bool HandleGamePacket(UInt32 a_PacketType);
+	bool HandleChunkData(void);
+	bool HandlePlayerPosLook(void);
+	bool HandleTimeUpdate(void);
+
+	/** Sends the packet whose type and payload was written to m_OutPacket. */
+	bool SendPacket(void);
+
+	/** Sends the data, queueing what the socket doesn't accept right away. */
+	bool SendRaw(ContiguousByteBufferView a_Data);
+
+	/** Sends the bot's position, and updates the pending chunks if the bot has entered another chunk. */
+	bool SendPosition(void);
+
+	/** Sends the digging of the block and the placing of a block in its place. */
+	bool SendDigAndPlace(Vector3i a_BlockPos);
+
+	/** Sends the chat message. */
+	bool SendChat(const AString & a_Message);
+
+	/** Marks the chunks within the view distance that haven't been received yet as pending, if the bot has entered another chunk. */
+	void UpdatePendingChunks(bool a_Force);
+} ;
@@ -0,0 +1,515 @@
+
+// LoadTest.cpp
+
+// Implements the main app entrypoint: runs the simulated clients against the server and reports the measurements
+
+#include "Globals.h"
+#include "Bot.h"
+#include "ServerProcess.h"
+#include "../../src/Logger.h"
+#include "../../src/LoggerListeners.h"
+
+#include <poll.h>
+#include <signal.h>
+
+
+
+
+
+/** The length of the bots' tick. */
+static const std::chrono::milliseconds BOT_TICK(50);
+
+
+
+
+
+/** The settings of a single load test run. */
+struct sOptions
+{
+	int m_NumBots = 10;
+	std::chrono::seconds m_Duration = std::chrono::seconds(60);
+	std::chrono::seconds m_RampUp = std::chrono::seconds(10);
+	std::chrono::seconds m_StartupTimeout = std::chrono::seconds(120);
+	AString m_Host = "127.0.0.1";
+	UInt16 m_Port = 25565;
+	AString m_ServerExecutable;
+	AString m_ReportFile;
+	int m_ViewDistance = 4;
+	UInt64 m_Seed = 1;
+};
+
+
+
+
+
+/** The report of a run: key-value lines in a stable order, so that the reports of two runs can be diffed. */
+class cReport
+{
+public:
+
+	void Add(const AString & a_Key, const AString & a_Value)
+	{
+		m_Lines.push_back(fmt::format(FMT_STRING("{} = {}"), a_Key, a_Value));
+	}
+
+	void Add(const AString & a_Key, double a_Value)
+	{
+		Add(a_Key, fmt::format(FMT_STRING("{:.3f}"), a_Value));
+	}
+
+	void Add(const AString & a_Key, UInt64 a_Value)
+	{
+		Add(a_Key, std::to_string(a_Value));
+	}
+
+	/** Adds the percentiles of the latencies, in milliseconds. */
+	void AddLatencies(const AString & a_Key, std::vector<double> a_Latencies)
+	{
+		Add(a_Key + ".count", static_cast<UInt64>(a_Latencies.size()));
+		if (a_Latencies.empty())
+		{
+			return;
+		}
+		std::sort(a_Latencies.begin(), a_Latencies.end());
+		auto Percentile = [&a_Latencies](double a_Fraction)
+		{
+			return a_Latencies[std::min(a_Latencies.size() - 1, static_cast<size_t>(static_cast<double>(a_Latencies.size()) * a_Fraction))];
+		};
+		Add(a_Key + ".p50_ms", Percentile(0.5));
+		Add(a_Key + ".p95_ms", Percentile(0.95));
+		Add(a_Key + ".max_ms", a_Latencies.back());
+	}
+
+	/** Prints the report and writes it to the file, if given. */
+	void Output(const AString & a_FileName) const
+	{
+		std::unique_ptr<FILE, decltype(&fclose)> File(nullptr, &fclose);
+		if (!a_FileName.empty())
+		{
+			File.reset(fopen(a_FileName.c_str(), "w"));
+			if (File == nullptr)
+			{
+				LOGERROR("Cannot write the report to %s", a_FileName.c_str());
+			}
+		}
+		for (const auto & Line: m_Lines)
+		{
+			fmt::print(FMT_STRING("{}\n"), Line);
+			if (File != nullptr)
+			{
+				fmt::print(File.get(), FMT_STRING("{}\n"), Line);
+			}
+		}
+	}
+
+protected:
+
+	AStringVector m_Lines;
+};
+
+
+
+
+
+/** Converts a name from the server's output into a report key, e.g. "Client input" into "client_input". */
+static AString MakeKey(const AString & a_Name)
+{
+	AString Key;
+	for (auto Char: a_Name)
+	{
+		Key.push_back(((Char == ' ') || (Char == '.')) ? '_' : static_cast<char>(tolower(Char)));
+	}
+	return Key;
+}
+
+
+
+
+
+/** Adds the output of the server's "tickstats" console command to the report. */
+static void AddTickStats(cReport & a_Report, const AStringVector & a_Lines)
+{
+	AString World;
+	for (const auto & Line: a_Lines)
+	{
+		char Name[256];
+		unsigned long long NumTicks, NumChunks;
+		double TPS, Average, Max;
+		int Physical, Virtual;
+		if (sscanf(Line.c_str(), "World %255[^:]: %llu ticks, %lf TPS, tick %lf ms average, %lf ms max, %llu chunks loaded", Name, &NumTicks, &TPS, &Average, &Max, &NumChunks) == 6)
+		{
+			World = "server.world." + MakeKey(Name);
+			a_Report.Add(World + ".ticks", static_cast<UInt64>(NumTicks));
+			a_Report.Add(World + ".tps", TPS);
+			a_Report.Add(World + ".tick.avg_ms", Average);
+			a_Report.Add(World + ".tick.max_ms", Max);
+			a_Report.Add(World + ".chunks_loaded", static_cast<UInt64>(NumChunks));
+		}
+		else if (!World.empty() && (sscanf(Line.c_str(), "  %255[^:]: %lf ms average, %lf ms max", Name, &Average, &Max) == 3))
+		{
+			a_Report.Add(World + ".phase." + MakeKey(Name) + ".avg_ms", Average);
+			a_Report.Add(World + ".phase." + MakeKey(Name) + ".max_ms", Max);
+		}
+		else if (sscanf(Line.c_str(), "Memory: %d KiB physical, %d KiB virtual", &Physical, &Virtual) == 2)
+		{
+			a_Report.Add("server.memory.physical_kib", static_cast<UInt64>(Physical));
+			a_Report.Add("server.memory.virtual_kib", static_cast<UInt64>(Virtual));
+		}
+	}
+}
+
+
+
+
+
+/** Adds the bots' measurements to the report: the totals, per behavior and per bot. */
+static void AddBotStats(cReport & a_Report, const std::vector<std::unique_ptr<cBot>> & a_Bots, std::chrono::seconds a_Duration)
+{
+	const auto Seconds = static_cast<double>(std::max<std::chrono::seconds::rep>(a_Duration.count(), 1));
+	UInt64 NumConnected = 0, NumInGame = 0, BytesSent = 0, BytesReceived = 0, NumPacketsReceived = 0;
+	UInt64 NumChunksReceived = 0, NumChunksUnloaded = 0, NumChunksOutstanding = 0, NumTeleports = 0, NumChatsReceived = 0;
+	std::vector<double> Latencies, TPSEstimates;
+	std::array<std::vector<double>, cBot::bhNumBehaviors> BehaviorLatencies;
+	for (const auto & Bot: a_Bots)
+	{
+		const auto & Stats = Bot->GetStats();
+		NumConnected += Bot->IsConnected() ? 1 : 0;
+		NumInGame += (Bot->IsConnected() && Bot->IsInGame()) ? 1 : 0;
+		BytesSent += Stats.m_BytesSent;
+		BytesReceived += Stats.m_BytesReceived;
+		NumPacketsReceived += Stats.m_NumPacketsReceived;
+		NumChunksReceived += Stats.m_NumChunksReceived;
+		NumChunksUnloaded += Stats.m_NumChunksUnloaded;
+		NumChunksOutstanding += Bot->GetNumChunksOutstanding();
+		NumTeleports += Stats.m_NumTeleports;
+		NumChatsReceived += Stats.m_NumChatsReceived;
+		Latencies.insert(Latencies.end(), Stats.m_ChunkLatencies.begin(), Stats.m_ChunkLatencies.end());
+		auto & Behavior = BehaviorLatencies[Bot->GetBehavior()];
+		Behavior.insert(Behavior.end(), Stats.m_ChunkLatencies.begin(), Stats.m_ChunkLatencies.end());
+		auto TPS = Bot->GetTPSEstimate();
+		if (TPS >= 0)
+		{
+			TPSEstimates.push_back(TPS);
+		}
+	}
+
+	a_Report.Add("clients.connected", NumConnected);
+	a_Report.Add("clients.in_game", NumInGame);
+	if (!TPSEstimates.empty())
+	{
+		// The median of the bots' estimates, from the world age in the time updates:
+		std::sort(TPSEstimates.begin(), TPSEstimates.end());
+		a_Report.Add("clients.tps_estimate", TPSEstimates[TPSEstimates.size() / 2]);
+	}
+	a_Report.Add("clients.bytes_sent", BytesSent);
+	a_Report.Add("clients.bytes_received", BytesReceived);
+	a_Report.Add("clients.received_kib_per_s", static_cast<double>(BytesReceived) / 1024 / Seconds);
+	a_Report.Add("clients.packets_received", NumPacketsReceived);
+	a_Report.Add("clients.chunks_received", NumChunksReceived);
+	a_Report.Add("clients.chunks_unloaded", NumChunksUnloaded);
+	a_Report.Add("clients.chunks_outstanding", NumChunksOutstanding);
+	a_Report.Add("clients.teleports", NumTeleports);
+	a_Report.Add("clients.chats_received", NumChatsReceived);
+	a_Report.AddLatencies("clients.chunk_latency", Latencies);
+	for (int i = 0; i < cBot::bhNumBehaviors; i++)
+	{
+		a_Report.AddLatencies(fmt::format(FMT_STRING("clients.{}.chunk_latency"), cBot::GetBehaviorName(static_cast<cBot::eBehavior>(i))), BehaviorLatencies[static_cast<size_t>(i)]);
+	}
+
+	for (const auto & Bot: a_Bots)
+	{
+		const auto & Stats = Bot->GetStats();
+		auto Key = "client." + Bot->GetName();
+		a_Report.Add(Key + ".behavior", cBot::GetBehaviorName(Bot->GetBehavior()));
+		a_Report.Add(Key + ".bytes_sent", Stats.m_BytesSent);
+		a_Report.Add(Key + ".bytes_received", Stats.m_BytesReceived);
+		a_Report.Add(Key + ".chunks_received", static_cast<UInt64>(Stats.m_NumChunksReceived));
+		a_Report.AddLatencies(Key + ".chunk_latency", Stats.m_ChunkLatencies);
+		if (!Bot->IsConnected())
+		{
+			a_Report.Add(Key + ".disconnected", Bot->GetDisconnectReason());
+		}
+	}
+}
+
+
+
+
+
+static void PrintUsage(void)
+{
+	fmt::print(
+		"Usage: LoadTest [options]\n"
+		"  -bots <N>             Number of simulated clients (10)\n"
+		"  -duration <s>         Length of the measurement, after the ramp-up (60)\n"
+		"  -rampup <s>           Time over which the clients connect, evenly spaced (10)\n"
+		"  -host <host>          Server to connect to (127.0.0.1)\n"
+		"  -port <port>          Server port (25565)\n"
+		"  -server <executable>  Start this server executable, and report its tick statistics and memory\n"
+		"  -startup-timeout <s>  Time to wait for the started server to finish its startup (120)\n"
+		"  -view-distance <N>    View distance the clients request (4)\n"
+		"  -seed <N>             Seed for the clients' behavior (1)\n"
+		"  -report <file>        Also write the report to the file\n"
+	);
+}
+
+
+
+
+
+/** Parses the commandline into a_Options. Returns false if it is invalid. */
+static bool ParseOptions(int argc, char ** argv, sOptions & a_Options)
+{
+	for (int i = 1; i < argc; i += 2)
+	{
+		AString Option(argv[i]);
+		if (i + 1 >= argc)
+		{
+			LOGERROR("Missing the value for option %s", Option.c_str());
+			return false;
+		}
+		AString Value(argv[i + 1]);
+		int Seconds = 0;
+		bool IsValid = true;
+		if (Option == "-bots")
+		{
+			IsValid = StringToInteger(Value, a_Options.m_NumBots) && (a_Options.m_NumBots > 0);
+		}
+		else if (Option == "-duration")
+		{
+			IsValid = StringToInteger(Value, Seconds) && (Seconds > 0);
+			a_Options.m_Duration = std::chrono::seconds(Seconds);
+		}
+		else if (Option == "-rampup")
+		{
+			IsValid = StringToInteger(Value, Seconds) && (Seconds >= 0);
+			a_Options.m_RampUp = std::chrono::seconds(Seconds);
+		}
+		else if (Option == "-startup-timeout")
+		{
+			IsValid = StringToInteger(Value, Seconds) && (Seconds > 0);
+			a_Options.m_StartupTimeout = std::chrono::seconds(Seconds);
+		}
+		else if (Option == "-host")
+		{
+			a_Options.m_Host = Value;
+		}
+		else if (Option == "-port")
+		{
+			IsValid = StringToInteger(Value, a_Options.m_Port);
+		}
+		else if (Option == "-server")
+		{
+			a_Options.m_ServerExecutable = Value;
+		}
+		else if (Option == "-view-distance")
+		{
+			IsValid = StringToInteger(Value, a_Options.m_ViewDistance) && (a_Options.m_ViewDistance > 0);
+		}
+		else if (Option == "-seed")
+		{
+			IsValid = StringToInteger(Value, a_Options.m_Seed);
+		}
+		else if (Option == "-report")
+		{
+			a_Options.m_ReportFile = Value;
+		}
+		else
+		{
+			LOGERROR("Unknown option: %s", Option.c_str());
+			return false;
+		}
+		if (!IsValid)
+		{
+			LOGERROR("Invalid value for option %s: %s", Option.c_str(), Value.c_str());
+			return false;
+		}
+	}
+	return true;
+}
+
+
+
+
+
+/** Services the bots' sockets until a_Until. */
+static void PollBots(const std::vector<std::unique_ptr<cBot>> & a_Bots, std::chrono::steady_clock::time_point a_Until)
+{
+	std::vector<pollfd> Polls;
+	std::vector<cBot *> PolledBots;
+	for (;;)
+	{
+		Polls.clear();
+		PolledBots.clear();
+		for (const auto & Bot: a_Bots)
+		{
+			if (Bot->IsConnected())
+			{
+				Polls.push_back({ Bot->GetSocket(), static_cast<short>(POLLIN | (Bot->HasOutgoingData() ? POLLOUT : 0)), 0 });
+				PolledBots.push_back(Bot.get());
+			}
+		}
+
+		auto Timeout = std::chrono::duration_cast<std::chrono::milliseconds>(a_Until - std::chrono::steady_clock::now()).count();
+		if (Timeout <= 0)
+		{
+			return;
+		}
+		if (poll(Polls.data(), Polls.size(), static_cast<int>(Timeout)) <= 0)
+		{
+			continue;
+		}
+		for (size_t i = 0; i < Polls.size(); i++)
+		{
+			auto Bot = PolledBots[i];
+			if ((Polls[i].revents & (POLLIN | POLLERR | POLLHUP)) != 0)
+			{
+				Bot->OnReadable();
+			}
+			if (((Polls[i].revents & POLLOUT) != 0) && Bot->IsConnected())
+			{
+				Bot->OnWritable();
+			}
+			if (!Bot->IsConnected())
+			{
+				LOGWARNING("%s disconnected: %s", Bot->GetName().c_str(), Bot->GetDisconnectReason().c_str());
+			}
+		}
+	}
+}
+
+
+
+
+
+int main(int argc, char ** argv)
+{
+	auto consoleLogListener = MakeConsoleListener(false);
+	auto consoleAttachment = cLogger::GetInstance().AttachListener(std::move(consoleLogListener));
+
+	sOptions Options;
+	if (!ParseOptions(argc, argv, Options))
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	// A server that exits must not kill the load test by a write to its console:
+	signal(SIGPIPE, SIG_IGN);
+
+	cServerProcess Server;
+	if (!Options.m_ServerExecutable.empty())
+	{
+		LOG("Starting the server %s on port %u...", Options.m_ServerExecutable.c_str(), Options.m_Port);
+		if (!Server.Start(Options.m_ServerExecutable, Options.m_Port, Options.m_StartupTimeout))
+		{
+			return 2;
+		}
+	}
+
+	// The bots' behaviors and seeds depend only on the seed and their index, so that runs are comparable:
+	std::vector<std::unique_ptr<cBot>> Bots;
+	for (int i = 0; i < Options.m_NumBots; i++)
+	{
+		Bots.push_back(std::make_unique<cBot>(
+			fmt::format(FMT_STRING("LoadBot{:03d}"), i),
+			static_cast<cBot::eBehavior>(i % cBot::bhNumBehaviors),
+			(Options.m_Seed << 32) | static_cast<UInt32>(i),
+			Options.m_ViewDistance
+		));
+	}
+
+	// Connect the bots evenly spaced over the ramp-up, then measure for the duration:
+	LOG("Connecting %d bots over %d seconds...", Options.m_NumBots, static_cast<int>(Options.m_RampUp.count()));
+	const auto Start = std::chrono::steady_clock::now();
+	const auto MeasureStart = Start + Options.m_RampUp;
+	const auto End = MeasureStart + Options.m_Duration;
+	auto NextTick = Start;
+	size_t NumStarted = 0;
+	UInt64 NumLateTicks = 0;
+	bool IsMeasuring = false;
+	while (NextTick < End)
+	{
+		PollBots(Bots, NextTick);
+		auto Now = std::chrono::steady_clock::now();
+
+		while ((NumStarted < Bots.size()) && (Start + std::chrono::milliseconds(Options.m_RampUp) * static_cast<int>(NumStarted) / Options.m_NumBots <= Now))
+		{
+			auto & Bot = Bots[NumStarted++];
+			if (!Bot->Connect(Options.m_Host, Options.m_Port))
+			{
+				LOGWARNING("%s failed to connect: %s", Bot->GetName().c_str(), Bot->GetDisconnectReason().c_str());
+			}
+		}
+
+		if (!IsMeasuring && (Now >= MeasureStart))
+		{
+			LOG("Measuring for %d seconds...", static_cast<int>(Options.m_Duration.count()));
+			IsMeasuring = true;
+			NumLateTicks = 0;
+			for (auto & Bot: Bots)
+			{
+				Bot->ResetStats();
+			}
+			AStringVector Output;
+			if (Server.IsRunning() && !Server.ExecuteCommand("tickstats reset", "Tick statistics reset", std::chrono::seconds(10), Output))
+			{
+				LOGWARNING("The server didn't reset its tick statistics");
+			}
+		}
+
+		for (auto & Bot: Bots)
+		{
+			Bot->Tick();
+		}
+		if (Server.IsRunning())
+		{
+			Server.DrainOutput();
+		}
+
+		// Keep the tick rate; if the load test itself can't keep up, skip the ticks instead of bursting:
+		NextTick += BOT_TICK;
+		if (NextTick + BOT_TICK < std::chrono::steady_clock::now())
+		{
+			NumLateTicks += 1;
+			NextTick = std::chrono::steady_clock::now() + BOT_TICK;
+		}
+	}
+
+	cReport Report;
+	Report.Add("loadtest.bots", static_cast<UInt64>(Options.m_NumBots));
+	Report.Add("loadtest.duration_s", static_cast<UInt64>(Options.m_Duration.count()));
+	Report.Add("loadtest.view_distance", static_cast<UInt64>(Options.m_ViewDistance));
+	Report.Add("loadtest.seed", Options.m_Seed);
+	Report.Add("loadtest.late_ticks", NumLateTicks);
+	if (Server.IsRunning())
+	{
+		AStringVector Output;
+		if (Server.ExecuteCommand("tickstats", "Memory:", std::chrono::seconds(10), Output))
+		{
+			AddTickStats(Report, Output);
+		}
+		else
+		{
+			LOGWARNING("The server didn't report its tick statistics");
+		}
+		auto Memory = Server.GetMemory();
+		if (Memory.m_RSS >= 0)
+		{
+			Report.Add("server.memory.rss_kib", static_cast<UInt64>(Memory.m_RSS));
+			Report.Add("server.memory.peak_rss_kib", static_cast<UInt64>(Memory.m_PeakRSS));
+		}
+	}
+	AddBotStats(Report, Bots, Options.m_Duration);
+
+	// Disconnect the bots before stopping the server:
+	Bots.clear();
+	if (Server.IsRunning())
+	{
+		LOG("Stopping the server...");
+		Server.Stop(std::chrono::seconds(60));
+	}
+
+	Report.Output(Options.m_ReportFile);
+	return 0;
+}
@@ -0,0 +1,309 @@
+
+// ServerProcess.cpp
+
+// Implements the cServerProcess class that runs the server under test as a child process and talks to its console
+
+#include "Globals.h"
+#include "ServerProcess.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/wait.h>
+
+
+
+
+
+/** Removes the logger's "[HH:MM:SS] " prefix from the console line. */
+static AString StripTimePrefix(const AString & a_Line)
+{
+	if (!a_Line.empty() && (a_Line[0] == '['))
+	{
+		auto End = a_Line.find("] ");
+		if (End != AString::npos)
+		{
+			return a_Line.substr(End + 2);
+		}
+	}
+	return a_Line;
+}
+
+
+
+
+
+cServerProcess::cServerProcess(void):
+	m_PID(0),
+	m_Input(-1),
+	m_Output(-1)
+{
+}
+
+
+
+
+
+cServerProcess::~cServerProcess()
+{
+	if (IsRunning())
+	{
+		Stop(std::chrono::seconds(30));
+	}
+	if (m_Input >= 0)
+	{
+		close(m_Input);
+	}
+	if (m_Output >= 0)
+	{
+		close(m_Output);
+	}
+}
+
+
+
+
+
+bool cServerProcess::Start(const AString & a_Executable, UInt16 a_Port, std::chrono::seconds a_Timeout)
+{
+	int InputPipe[2], OutputPipe[2];
+	if ((pipe(InputPipe) != 0) || (pipe(OutputPipe) != 0))
+	{
+		LOGERROR("Cannot create the pipes for the server: %s", strerror(errno));
+		return false;
+	}
+
+	// The server finds its data files relative to the working folder, run it in the executable's folder:
+	auto Slash = a_Executable.rfind('/');
+	auto Folder = (Slash == AString::npos) ? AString(".") : a_Executable.substr(0, Slash);
+	auto Port = std::to_string(a_Port);
+
+	m_PID = fork();
+	if (m_PID < 0)
+	{
+		LOGERROR("Cannot start the server: %s", strerror(errno));
+		m_PID = 0;
+		return false;
+	}
+	if (m_PID == 0)
+	{
+		// The child process:
+		dup2(InputPipe[0], STDIN_FILENO);
+		dup2(OutputPipe[1], STDOUT_FILENO);
+		dup2(OutputPipe[1], STDERR_FILENO);
+		close(InputPipe[0]);
+		close(InputPipe[1]);
+		close(OutputPipe[0]);
+		close(OutputPipe[1]);
+		if (chdir(Folder.c_str()) != 0)
+		{
+			_exit(126);
+		}
+		execl(a_Executable.c_str(), a_Executable.c_str(), "--no-output-buffering", "--no-log-file", "-p", Port.c_str(), static_cast<char *>(nullptr));
+		_exit(127);
+	}
+
+	close(InputPipe[0]);
+	close(OutputPipe[1]);
+	m_Input = InputPipe[1];
+	m_Output = OutputPipe[0];
+	fcntl(m_Output, F_SETFL, fcntl(m_Output, F_GETFL) | O_NONBLOCK);
+
+	// Wait for the startup to finish:
+	auto Deadline = std::chrono::steady_clock::now() + a_Timeout;
+	while (std::chrono::steady_clock::now() < Deadline)
+	{
+		AStringVector Lines;
+		if (!ReadLines(std::chrono::milliseconds(100), Lines))
+		{
+			LOGERROR("The server exited during startup, exit code %d", WaitForExit(std::chrono::seconds(1)));
+			return false;
+		}
+		for (const auto & Line: Lines)
+		{
+			if (Line.rfind("Startup complete", 0) == 0)
+			{
+				return true;
+			}
+		}
+	}
+	LOGERROR("The server didn't finish its startup in %d seconds", static_cast<int>(a_Timeout.count()));
+	Stop(std::chrono::seconds(5));
+	return false;
+}
+
+
+
+
+
+bool cServerProcess::SendCommand(const AString & a_Command)
+{
+	auto Line = a_Command + '\n';
+	return (write(m_Input, Line.data(), Line.size()) == static_cast<ssize_t>(Line.size()));
+}
+
+
+
+
+
+bool cServerProcess::ExecuteCommand(const AString & a_Command, const AString & a_LastLinePrefix, std::chrono::seconds a_Timeout, AStringVector & a_Output)
+{
+	DrainOutput();
+	if (!SendCommand(a_Command))
+	{
+		return false;
+	}
+
+	// The command's output may be interleaved with other log messages, keep everything up to the last line:
+	a_Output.clear();
+	auto Deadline = std::chrono::steady_clock::now() + a_Timeout;
+	while (std::chrono::steady_clock::now() < Deadline)
+	{
+		AStringVector Lines;
+		if (!ReadLines(std::chrono::milliseconds(100), Lines))
+		{
+			return false;
+		}
+		for (auto & Line: Lines)
+		{
+			bool IsLast = (Line.rfind(a_LastLinePrefix, 0) == 0);
+			a_Output.push_back(std::move(Line));
+			if (IsLast)
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+
+
+
+
+void cServerProcess::DrainOutput(void)
+{
+	AStringVector Lines;
+	ReadLines(std::chrono::milliseconds(0), Lines);
+}
+
+
+
+
+
+cServerProcess::sMemory cServerProcess::GetMemory(void) const
+{
+	sMemory Memory;
+	std::ifstream StatusFile(fmt::format(FMT_STRING("/proc/{}/status"), m_PID));
+	AString Line;
+	while (std::getline(StatusFile, Line))
+	{
+		int Value;
+		if (sscanf(Line.c_str(), "VmRSS: %d kB", &Value) == 1)
+		{
+			Memory.m_RSS = Value;
+		}
+		else if (sscanf(Line.c_str(), "VmHWM: %d kB", &Value) == 1)
+		{
+			Memory.m_PeakRSS = Value;
+		}
+	}
+	return Memory;
+}
+
+
+
+
+
+int cServerProcess::Stop(std::chrono::seconds a_Timeout)
+{
+	if (!IsRunning())
+	{
+		return -1;
+	}
+	SendCommand("stop");
+
+	// Keep reading the output, so that the server doesn't block on logging while shutting down:
+	auto Deadline = std::chrono::steady_clock::now() + a_Timeout;
+	while (std::chrono::steady_clock::now() < Deadline)
+	{
+		AStringVector Lines;
+		ReadLines(std::chrono::milliseconds(100), Lines);
+		auto ExitCode = WaitForExit(std::chrono::milliseconds(0));
+		if (!IsRunning())
+		{
+			return ExitCode;
+		}
+	}
+
+	LOGWARNING("The server didn't stop in %d seconds, killing it", static_cast<int>(a_Timeout.count()));
+	kill(m_PID, SIGKILL);
+	WaitForExit(std::chrono::seconds(5));
+	return -1;
+}
+
+
+
+
+
+bool cServerProcess::ReadLines(std::chrono::milliseconds a_Timeout, AStringVector & a_Lines)
+{
+	pollfd Poll = { m_Output, POLLIN, 0 };
+	if (poll(&Poll, 1, static_cast<int>(a_Timeout.count())) <= 0)
+	{
+		return true;
+	}
+
+	char Buffer[16 KiB];
+	for (;;)
+	{
+		auto NumRead = read(m_Output, Buffer, sizeof(Buffer));
+		if (NumRead == 0)
+		{
+			return false;
+		}
+		if (NumRead < 0)
+		{
+			// EAGAIN, all available data has been read
+			break;
+		}
+		m_OutputBuffer.append(Buffer, static_cast<size_t>(NumRead));
+	}
+
+	size_t Start = 0;
+	for (auto End = m_OutputBuffer.find('\n'); End != AString::npos; End = m_OutputBuffer.find('\n', Start))
+	{
+		auto Line = m_OutputBuffer.substr(Start, End - Start);
+		if (!Line.empty() && (Line.back() == '\r'))
+		{
+			Line.pop_back();
+		}
+		a_Lines.push_back(StripTimePrefix(Line));
+		Start = End + 1;
+	}
+	m_OutputBuffer.erase(0, Start);
+	return true;
+}
+
+
+
+
+
+int cServerProcess::WaitForExit(std::chrono::milliseconds a_Timeout)
+{
+	auto Deadline = std::chrono::steady_clock::now() + a_Timeout;
+	for (;;)
+	{
+		int Status;
+		if (waitpid(m_PID, &Status, WNOHANG) == m_PID)
+		{
+			m_PID = 0;
+			return WIFEXITED(Status) ? WEXITSTATUS(Status) : -1;
+		}
+		if (std::chrono::steady_clock::now() >= Deadline)
+		{
+			return -1;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+}
@@ -0,0 +1,75 @@
+
+// ServerProcess.h
+
+// Declares the cServerProcess class that runs the server under test as a child process and talks to its console
+
+
+
+
+
+#pragma once
+
+
+
+
+
+/** The server under test, running as a child process with its console connected to pipes.
+The server's console output is read line by line, with the logger's time prefix removed. */
+class cServerProcess
+{
+public:
+
+	/** The memory usage of the server process, in KiB, as reported by the OS. */
+	struct sMemory
+	{
+		int m_RSS = -1;
+		int m_PeakRSS = -1;
+	};
+
+
+	cServerProcess(void);
+	~cServerProcess();
+
+	/** Starts the server executable in its own folder, listening on the specified port.
+	Waits until the server reports the end of its startup, or the timeout.
+	Returns false and logs the reason if the server couldn't be started. */
+	bool Start(const AString & a_Executable, UInt16 a_Port, std::chrono::seconds a_Timeout);
+
+	/** Sends the command to the server's console. */
+	bool SendCommand(const AString & a_Command);
+
+	/** Sends the command and collects the output lines up to and including the first line starting with a_LastLinePrefix.
+	Other server output received meanwhile is dropped. Returns false on timeout or if the server has exited. */
+	bool ExecuteCommand(const AString & a_Command, const AString & a_LastLinePrefix, std::chrono::seconds a_Timeout, AStringVector & a_Output);
+
+	/** Drops the console output received so far, so that the server doesn't block on a full pipe. */
+	void DrainOutput(void);
+
+	/** Returns the server's current and peak resident memory, read from /proc. */
+	sMemory GetMemory(void) const;
+
+	/** Stops the server using the "stop" command; kills it if it doesn't exit within the timeout.
+	Returns the server's exit code, or -1 if it had to be killed. */
+	int Stop(std::chrono::seconds a_Timeout);
+
+	bool IsRunning(void) const { return (m_PID > 0); }
+
+protected:
+
+	int m_PID;
+
+	/** The write end of the server's stdin and the read end of its stdout. */
+	int m_Input;
+	int m_Output;
+
+	/** Console output that doesn't form a complete line yet. */
+	AString m_OutputBuffer;
+
+
+	/** Reads the console output available within the timeout, and appends the complete lines to a_Lines.
+	Returns false if the server closed its output. */
+	bool ReadLines(std::chrono::milliseconds a_Timeout, AStringVector & a_Lines);
+
+	/** Waits for the server process to exit, up to the timeout. Returns the exit code, or -1 on timeout. */
+	int WaitForExit(std::chrono::milliseconds a_Timeout);
+} ;
@@ -372,7 +372,7 @@ static int tolua_get_cItem_m_Lore(lua_State * tolua_S)
 	const cItem * Self = nullptr;
 	L.GetStackValue(1, Self);
 
-	AString LoreString = StringJoin(Self->m_LoreTable, "`");
+	AString LoreString = StringJoin(Self->GetLoreTable(), "`");
 
 	L.Push(LoreString);
 
@@ -401,7 +401,7 @@ static int tolua_set_cItem_m_Lore(lua_State * tolua_S)
 	AString LoreString;
 	L.GetStackValues(1, Self, LoreString);
 
-	Self->m_LoreTable = StringSplit(LoreString, "`");
+	Self->ModifyLoreTable() = StringSplit(LoreString, "`");
 
 	LOGWARNING("cItem.m_Lore is deprecated, use cItem.m_LoreTable instead");
 	L.LogStackTrace(0);
@@ -2755,6 +2755,117 @@ static int tolua_cMojangAPI_MakeUUIDShort(lua_State * L)
 
 
 
+/** Key of the registry table that links the component copies returned by cItem.m_Enchantments and cItem.m_ItemColor
+to the items they were read from. The table has weak keys, a link goes away together with its copy. */
+static const char * ITEM_COMPONENT_OWNERS = "Cuberite_ItemComponentOwners";
+
+
+
+
+
+/** Pushes the table linking the item component copies to their items, creating it on the first use. */
+static void PushItemComponentOwners(lua_State * a_LuaState)
+{
+	lua_getfield(a_LuaState, LUA_REGISTRYINDEX, ITEM_COMPONENT_OWNERS);
+	if (lua_istable(a_LuaState, -1))
+	{
+		return;
+	}
+	lua_pop(a_LuaState, 1);
+	lua_newtable(a_LuaState);                                   // Stack: Owners
+	lua_newtable(a_LuaState);                                   // Stack: Owners, Meta
+	lua_pushliteral(a_LuaState, "k");
+	lua_setfield(a_LuaState, -2, "__mode");
+	lua_setmetatable(a_LuaState, -2);                           // Stack: Owners
+	lua_pushvalue(a_LuaState, -1);
+	lua_setfield(a_LuaState, LUA_REGISTRYINDEX, ITEM_COMPONENT_OWNERS);
+}
+
+
+
+
+
+/** Pushes a Lua-owned copy of an item component for the cItem getters.
+The item shares its components with its copies, so Lua mustn't get a pointer into them. Instead, the copy of a non-const item
+is linked to the item, and the methods changing the copy write it back to the item (see BindItemComponentWriteBack()),
+so that the plugins can change the component in place, such as "Item.m_Enchantments:SetLevel(...)". */
+template <typename ComponentType>
+static void PushItemComponent(lua_State * a_LuaState, const ComponentType & a_Component, const char * a_TypeName)
+{
+	tolua_pushusertype(a_LuaState, Mtolua_new(ComponentType(a_Component)), a_TypeName);
+	tolua_register_gc(a_LuaState, lua_gettop(a_LuaState));  // Make Lua own the object
+
+	tolua_Error Err;
+	if (!tolua_isusertype(a_LuaState, 1, "cItem", 0, &Err))
+	{
+		// A const item, the copy is read-only for the item:
+		return;
+	}
+	PushItemComponentOwners(a_LuaState);                        // Stack: Copy, Owners
+	lua_pushvalue(a_LuaState, -2);                              // Stack: Copy, Owners, Copy
+	lua_pushvalue(a_LuaState, 1);                               // Stack: Copy, Owners, Copy, Item
+	lua_rawset(a_LuaState, -3);                                 // Stack: Copy, Owners
+	lua_pop(a_LuaState, 1);                                     // Stack: Copy
+}
+
+
+
+
+
+/** Replacement for a method of an item component class that changes the object.
+Calls the original method, kept in the upvalue, and then, if the object is a component copy returned by a cItem getter,
+writes the changed object back into the item. */
+template <typename ComponentType, ComponentType & (cItem::*ModifyComponent)(void)>
+static int tolua_ItemComponentWriteBack(lua_State * tolua_S)
+{
+	// Call the original method with all the params:
+	const int NumParams = lua_gettop(tolua_S);
+	lua_pushvalue(tolua_S, lua_upvalueindex(1));
+	for (int i = 1; i <= NumParams; i++)
+	{
+		lua_pushvalue(tolua_S, i);
+	}
+	lua_call(tolua_S, NumParams, LUA_MULTRET);
+	const int NumResults = lua_gettop(tolua_S) - NumParams;
+
+	// Write the changed copy back into its item, if it has one:
+	PushItemComponentOwners(tolua_S);
+	lua_pushvalue(tolua_S, 1);
+	lua_rawget(tolua_S, -2);                                    // Stack: Params, Results, Owners, Item
+	if (!lua_isnil(tolua_S, -1))
+	{
+		auto Item = static_cast<cItem *>(tolua_tousertype(tolua_S, -1, nullptr));
+		auto Component = static_cast<const ComponentType *>(tolua_tousertype(tolua_S, 1, nullptr));
+		if ((Item != nullptr) && (Component != nullptr))
+		{
+			(Item->*ModifyComponent)() = *Component;
+		}
+	}
+	lua_pop(tolua_S, 2);                                        // Stack: Params, Results
+	return NumResults;
+}
+
+
+
+
+
+/** Replaces the specified methods of the item component class whose module is on the top of the stack with tolua_ItemComponentWriteBack(). */
+template <typename ComponentType, ComponentType & (cItem::*ModifyComponent)(void)>
+static void BindItemComponentWriteBack(lua_State * tolua_S, std::initializer_list<const char *> a_MethodNames)
+{
+	for (const auto MethodName: a_MethodNames)
+	{
+		lua_getfield(tolua_S, -1, MethodName);
+		ASSERT(lua_iscfunction(tolua_S, -1));
+		lua_pushcclosure(tolua_S, tolua_ItemComponentWriteBack<ComponentType, ModifyComponent>, 1);
+		lua_setfield(tolua_S, -2, MethodName);
+	}
+}
+
+
+
+
+
 static int tolua_get_cItem_m_LoreTable(lua_State * tolua_S)
 {
 	// Check params:
@@ -2769,7 +2880,7 @@ static int tolua_get_cItem_m_LoreTable(lua_State * tolua_S)
 	L.GetStackValue(1, Self);
 
 	// Push the result:
-	L.Push(Self->m_LoreTable);
+	L.Push(Self->GetLoreTable());
 	return 1;
 }
 
@@ -2821,11 +2932,204 @@ static int tolua_set_cItem_m_LoreTable(lua_State * tolua_S)
 	L.GetStackValue(1, Self);
 
 	// Set the value:
-	Self->m_LoreTable.clear();
-	if (!L.GetStackValue(2, Self->m_LoreTable))
+	AStringVector LoreTable;
+	if (!L.GetStackValue(2, LoreTable))
 	{
 		return L.ApiParamError("cItem.m_LoreTable: Could not read value as an array of strings");
 	}
+	Self->ModifyLoreTable() = std::move(LoreTable);
+	return 0;
+}
+
+
+
+
+
+static int tolua_get_cItem_m_CustomName(lua_State * tolua_S)
+{
+	// Check params:
+	cLuaState L(tolua_S);
+	if (!L.CheckParamSelf("const cItem"))
+	{
+		return 0;
+	}
+
+	// Get the params:
+	const cItem * Self = nullptr;
+	L.GetStackValue(1, Self);
+
+	// Push the result:
+	L.Push(Self->GetCustomName());
+	return 1;
+}
+
+
+
+
+
+static int tolua_set_cItem_m_CustomName(lua_State * tolua_S)
+{
+	// Check params:
+	cLuaState L(tolua_S);
+	if (
+		!L.CheckParamSelf("cItem") ||
+		!L.CheckParamString(2)
+	)
+	{
+		return 0;
+	}
+
+	// Get the params:
+	cItem * Self = nullptr;
+	AString CustomName;
+	L.GetStackValues(1, Self, CustomName);
+
+	// Set the value:
+	Self->SetCustomName(CustomName);
+	return 0;
+}
+
+
+
+
+
+static int tolua_get_cItem_m_Enchantments(lua_State * tolua_S)
+{
+	// Check params:
+	cLuaState L(tolua_S);
+	if (!L.CheckParamSelf("const cItem"))
+	{
+		return 0;
+	}
+
+	// Get the params:
+	const cItem * Self = nullptr;
+	L.GetStackValue(1, Self);
+
+	// Push the copy linked to the item:
+	PushItemComponent(L, Self->GetEnchantments(), "cEnchantments");
+	return 1;
+}
+
+
+
+
+
+static int tolua_set_cItem_m_Enchantments(lua_State * tolua_S)
+{
+	// Check params:
+	cLuaState L(tolua_S);
+	if (
+		!L.CheckParamSelf("cItem") ||
+		!L.CheckParamUserType(2, "const cEnchantments")
+	)
+	{
+		return 0;
+	}
+
+	// Get the params:
+	cItem * Self = nullptr;
+	L.GetStackValue(1, Self);
+	const auto Enchantments = static_cast<const cEnchantments *>(tolua_tousertype(tolua_S, 2, nullptr));
+
+	// Set the value:
+	Self->SetEnchantments(*Enchantments);
+	return 0;
+}
+
+
+
+
+
+static int tolua_get_cItem_m_ItemColor(lua_State * tolua_S)
+{
+	// Check params:
+	cLuaState L(tolua_S);
+	if (!L.CheckParamSelf("const cItem"))
+	{
+		return 0;
+	}
+
+	// Get the params:
+	const cItem * Self = nullptr;
+	L.GetStackValue(1, Self);
+
+	// Push the copy linked to the item:
+	PushItemComponent(L, Self->GetItemColor(), "cColor");
+	return 1;
+}
+
+
+
+
+
+static int tolua_set_cItem_m_ItemColor(lua_State * tolua_S)
+{
+	// Check params:
+	cLuaState L(tolua_S);
+	if (
+		!L.CheckParamSelf("cItem") ||
+		!L.CheckParamUserType(2, "const cColor")
+	)
+	{
+		return 0;
+	}
+
+	// Get the params:
+	cItem * Self = nullptr;
+	L.GetStackValue(1, Self);
+	const auto ItemColor = static_cast<const cColor *>(tolua_tousertype(tolua_S, 2, nullptr));
+
+	// Set the value:
+	Self->SetItemColor(*ItemColor);
+	return 0;
+}
+
+
+
+
+
+static int tolua_get_cItem_m_RepairCost(lua_State * tolua_S)
+{
+	// Check params:
+	cLuaState L(tolua_S);
+	if (!L.CheckParamSelf("const cItem"))
+	{
+		return 0;
+	}
+
+	// Get the params:
+	const cItem * Self = nullptr;
+	L.GetStackValue(1, Self);
+
+	// Push the result:
+	L.Push(Self->GetRepairCost());
+	return 1;
+}
+
+
+
+
+
+static int tolua_set_cItem_m_RepairCost(lua_State * tolua_S)
+{
+	// Check params:
+	cLuaState L(tolua_S);
+	if (
+		!L.CheckParamSelf("cItem") ||
+		!L.CheckParamNumber(2)
+	)
+	{
+		return 0;
+	}
+
+	// Get the params:
+	cItem * Self = nullptr;
+	int RepairCost;
+	L.GetStackValues(1, Self, RepairCost);
+
+	// Set the value:
+	Self->SetRepairCost(RepairCost);
 	return 0;
 }
 
@@ -4558,6 +4862,7 @@ void cManualBindings::Bind(lua_State * tolua_S)
 
 		tolua_beginmodule(tolua_S, "cColor");
 			tolua_function(tolua_S, "GetColor", tolua_cColor_GetColor);
+			BindItemComponentWriteBack<cColor, &cItem::ModifyItemColor>(tolua_S, {"Clear", "SetBlue", "SetColor", "SetGreen", "SetRed"});
 		tolua_endmodule(tolua_S);
 
 		tolua_beginmodule(tolua_S, "cCompositeChat");
@@ -4588,6 +4893,10 @@ void cManualBindings::Bind(lua_State * tolua_S)
 			tolua_function(tolua_S, "Move",     tolua_cCuboid_Move);
 		tolua_endmodule(tolua_S);
 
+		tolua_beginmodule(tolua_S, "cEnchantments");
+			BindItemComponentWriteBack<cEnchantments, &cItem::ModifyEnchantments>(tolua_S, {"Add", "AddFromString", "Clear", "SetLevel"});
+		tolua_endmodule(tolua_S);
+
 		tolua_beginmodule(tolua_S, "cEntity");
 			tolua_constant(tolua_S, "INVALID_ID", cEntity::INVALID_ID);
 			tolua_function(tolua_S, "Destroy", tolua_cEntity_Destroy);
@@ -4622,7 +4931,11 @@ void cManualBindings::Bind(lua_State * tolua_S)
 
 		tolua_beginmodule(tolua_S, "cItem");
 			tolua_function(tolua_S, "EnchantByXPLevels", tolua_cItem_EnchantByXPLevels);
-			tolua_variable(tolua_S, "m_LoreTable",       tolua_get_cItem_m_LoreTable, tolua_set_cItem_m_LoreTable);
+			tolua_variable(tolua_S, "m_CustomName",      tolua_get_cItem_m_CustomName,   tolua_set_cItem_m_CustomName);
+			tolua_variable(tolua_S, "m_Enchantments",    tolua_get_cItem_m_Enchantments, tolua_set_cItem_m_Enchantments);
+			tolua_variable(tolua_S, "m_ItemColor",       tolua_get_cItem_m_ItemColor,    tolua_set_cItem_m_ItemColor);
+			tolua_variable(tolua_S, "m_LoreTable",       tolua_get_cItem_m_LoreTable,    tolua_set_cItem_m_LoreTable);
+			tolua_variable(tolua_S, "m_RepairCost",      tolua_get_cItem_m_RepairCost,   tolua_set_cItem_m_RepairCost);
 		tolua_endmodule(tolua_S);
 
 		tolua_beginmodule(tolua_S, "cItemGrid");
@@ -11,7 +11,8 @@ cPlugin::cPlugin(const AString & a_FolderName) :
 	m_Status(cPluginManager::psDisabled),
 	m_Name(a_FolderName),
 	m_Version(0),
-	m_FolderName(a_FolderName)
+	m_FolderName(a_FolderName),
+	m_HookStats(nullptr)
 {
 }
 
@@ -138,6 +138,9 @@ public:
 	// Needed for ManualBindings' tolua_ForEach<>
 	static const char * GetClassStatic(void) { return "cPlugin"; }
 
+	/** Returns the cumulative call statistics of this plugin's handlers for the specified hook. */
+	cPluginManager::sHookStats & GetHookStats(cPluginManager::PluginHook a_Hook) { return (*m_HookStats)[a_Hook]; }
+
 protected:
 	friend class cPluginManager;
 
@@ -155,6 +158,10 @@ protected:
 	Only valid if m_Status == psError. */
 	AString m_LoadError;
 
+	/** Call statistics for each hook, collected only while cPluginManager::IsHookStatsEnabled().
+	Owned by cPluginManager, which assigns it when creating the plugin. */
+	cPluginManager::cHookStatsArray * m_HookStats;
+
 
 	/** Sets m_LoadError to the specified string and m_Status to psError. */
 	void SetLoadError(const AString & a_LoadError);
@@ -63,7 +63,7 @@ void cPluginLua::Close(void)
 	// If already closed, bail out:
 	if (!op().IsValid())
 	{
-		ASSERT(m_HookMap.empty());
+		ASSERT(std::all_of(m_HookMap.begin(), m_HookMap.end(), [](const cLuaCallbacks & a_Callbacks) { return a_Callbacks.empty(); }));
 		return;
 	}
 
@@ -71,7 +71,10 @@ void cPluginLua::Close(void)
 	ClearWebTabs();
 
 	// Release all the references in the hook map:
-	m_HookMap.clear();
+	for (auto & Callbacks : m_HookMap)
+	{
+		Callbacks.clear();
+	}
 
 	// Close the Lua engine:
 	op().Close();
@@ -1159,7 +1162,11 @@ const char * cPluginLua::GetHookFnName(int a_HookType)
 
 bool cPluginLua::AddHookCallback(int a_HookType, cLuaState::cCallbackPtr && a_Callback)
 {
-	m_HookMap[a_HookType].push_back(std::move(a_Callback));
+	if (!cPluginManager::IsValidHookType(a_HookType))
+	{
+		return false;
+	}
+	m_HookMap[static_cast<size_t>(a_HookType)].push_back(std::move(a_Callback));
 	return true;
 }
 
@@ -166,8 +166,8 @@ protected:
 	/** Provides an array of Lua function references */
 	typedef std::vector<cLuaState::cCallbackPtr> cLuaCallbacks;
 
-	/** Maps hook types into arrays of Lua function references to call for each hook type */
-	typedef std::map<int, cLuaCallbacks> cHookMap;
+	/** Arrays of Lua function references to call for each hook type, indexed by the hook type */
+	typedef std::array<cLuaCallbacks, cPluginManager::HOOK_NUM_HOOKS> cHookMap;
 
 
 	/** The plugin's Lua state. */
@@ -193,7 +193,7 @@ protected:
 	bool CallSimpleHooks(int a_HookType, Args && ... a_Args)
 	{
 		cOperation op(*this);
-		auto & hooks = m_HookMap[a_HookType];
+		auto & hooks = m_HookMap[static_cast<size_t>(a_HookType)];
 		bool res = false;
 		for (auto & hook: hooks)
 		{
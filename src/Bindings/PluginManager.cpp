@@ -26,6 +26,7 @@ cPluginManager * cPluginManager::Get(void)
 
 cPluginManager::cPluginManager(cDeadlockDetect & a_DeadlockDetect) :
 	m_bReloadPlugins(false),
+	m_IsHookStatsEnabled(false),
 	m_DeadlockDetect(a_DeadlockDetect)
 {
 }
@@ -91,7 +92,12 @@ void cPluginManager::RefreshPluginList(void)
 		}  // for plugin - m_Plugins[]
 		if (!hasFound)
 		{
-			m_Plugins.push_back(std::make_shared<cPluginLua>(folder, m_DeadlockDetect));
+			auto Plugin = std::make_shared<cPluginLua>(folder, m_DeadlockDetect);
+			{
+				cCSLock Lock(m_CSHookStats);
+				Plugin->m_HookStats = &m_HookStats[folder];
+			}
+			m_Plugins.push_back(std::move(Plugin));
 		}
 	}  // for folder - Folders[]
 }
@@ -221,16 +227,12 @@ void cPluginManager::Tick(float a_Dt)
 		ReloadPluginsNow();
 	}
 
-	auto Plugins = m_Hooks.find(HOOK_TICK);
-	if (Plugins == m_Hooks.end())
-	{
-		return;
-	}
-
-	for (auto * Plugin : Plugins->second)
-	{
-		Plugin->Tick(a_Dt);
-	}
+	GenericCallHook(HOOK_TICK, [&](cPlugin * a_Plugin)
+		{
+			a_Plugin->Tick(a_Dt);
+			return false;
+		}
+	);
 }
 
 
@@ -240,13 +242,42 @@ void cPluginManager::Tick(float a_Dt)
 template <typename HookFunction>
 bool cPluginManager::GenericCallHook(PluginHook a_HookName, HookFunction a_HookFunction)
 {
-	auto Plugins = m_Hooks.find(a_HookName);
-	if (Plugins == m_Hooks.end())
+	const auto & Plugins = m_Hooks[a_HookName];
+	if (Plugins.empty())
 	{
+		// The common case for most hooks, nobody is listening:
 		return false;
 	}
 
-	return std::any_of(Plugins->second.begin(), Plugins->second.end(), a_HookFunction);
+	// Both loops go by index, because a handler may add a hook (cPluginManager:AddHook()), reallocating the list:
+	if (!m_IsHookStatsEnabled.load(std::memory_order_relaxed))
+	{
+		for (size_t i = 0; i < Plugins.size(); ++i)
+		{
+			if (a_HookFunction(Plugins[i]))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Measure the time spent in each plugin's handler:
+	for (size_t i = 0; i < Plugins.size(); ++i)
+	{
+		auto * Plugin = Plugins[i];
+		auto Start = std::chrono::steady_clock::now();
+		bool ShouldAbort = a_HookFunction(Plugin);
+		auto Duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Start);
+		auto & Stats = Plugin->GetHookStats(a_HookName);
+		Stats.m_NumCalls.fetch_add(1, std::memory_order_relaxed);
+		Stats.m_TotalNSec.fetch_add(static_cast<UInt64>(Duration.count()), std::memory_order_relaxed);
+		if (ShouldAbort)
+		{
+			return true;
+		}
+	}
+	return false;
 }
 
 
@@ -1023,20 +1054,17 @@ bool cPluginManager::CallHookPluginMessage(cClientHandle & a_Client, const AStri
 
 bool cPluginManager::CallHookPluginsLoaded(void)
 {
-	auto Plugins = m_Hooks.find(HOOK_PLUGINS_LOADED);
-	if (Plugins == m_Hooks.end())
-	{
-		return false;
-	}
-
+	// All plugins are notified, regardless of what the previous ones returned:
 	bool res = false;
-	for (auto * Plugin : Plugins->second)
-	{
-		if (!Plugin->OnPluginsLoaded())
+	GenericCallHook(HOOK_PLUGINS_LOADED, [&](cPlugin * a_Plugin)
 		{
-			res = true;
+			if (!a_Plugin->OnPluginsLoaded())
+			{
+				res = true;
+			}
+			return false;
 		}
-	}
+	);
 	return res;
 }
 
@@ -1334,7 +1362,10 @@ cPluginManager::CommandResult cPluginManager::HandleCommand(cPlayer & a_Player,
 void cPluginManager::UnloadPluginsNow()
 {
 	// Remove all bindings:
-	m_Hooks.clear();
+	for (auto & Plugins : m_Hooks)
+	{
+		Plugins.clear();
+	}
 	m_Commands.clear();
 	m_ConsoleCommands.clear();
 
@@ -1400,9 +1431,9 @@ bool cPluginManager::LoadPlugin(const AString & a_FolderName)
 
 void cPluginManager::RemoveHooks(cPlugin * a_Plugin)
 {
-	for (auto & Hook : m_Hooks)
+	for (auto & Plugins : m_Hooks)
 	{
-		Hook.second.remove(a_Plugin);
+		Plugins.erase(std::remove(Plugins.begin(), Plugins.end(), a_Plugin), Plugins.end());
 	}
 }
 
@@ -1831,7 +1862,12 @@ void cPluginManager::AddHook(cPlugin * a_Plugin, int a_Hook)
 		LOGWARN("Called cPluginManager::AddHook() with a_Plugin == nullptr");
 		return;
 	}
-	PluginList & Plugins = m_Hooks[a_Hook];
+	if (!IsValidHookType(a_Hook))
+	{
+		LOGWARN("Called cPluginManager::AddHook() with an invalid hook type %d", a_Hook);
+		return;
+	}
+	PluginList & Plugins = m_Hooks[static_cast<size_t>(a_Hook)];
 	if (std::find(Plugins.cbegin(), Plugins.cend(), a_Plugin) == Plugins.cend())
 	{
 		Plugins.push_back(a_Plugin);
@@ -1868,6 +1904,87 @@ size_t cPluginManager::GetNumLoadedPlugins(void) const
 
 
 
+void cPluginManager::ResetHookStats(void)
+{
+	cCSLock Lock(m_CSHookStats);
+	for (auto & PluginStats : m_HookStats)
+	{
+		for (auto & Stats : PluginStats.second)
+		{
+			Stats.m_NumCalls.store(0);
+			Stats.m_TotalNSec.store(0);
+		}
+	}
+}
+
+
+
+
+
+cPluginManager::cHookStatsReports cPluginManager::GetHookStats(void)
+{
+	cHookStatsReports res;
+	cCSLock Lock(m_CSHookStats);
+	for (const auto & PluginStats : m_HookStats)
+	{
+		for (int Hook = 0; Hook < HOOK_NUM_HOOKS; ++Hook)
+		{
+			const auto & Stats = PluginStats.second[static_cast<size_t>(Hook)];
+			auto NumCalls = Stats.m_NumCalls.load(std::memory_order_relaxed);
+			if (NumCalls == 0)
+			{
+				continue;
+			}
+			const char * HookName = cPluginLua::GetHookFnName(Hook);
+			res.push_back({
+				PluginStats.first,
+				(HookName == nullptr) ? fmt::format(FMT_STRING("Hook {}"), Hook) : AString(HookName),
+				NumCalls,
+				Stats.m_TotalNSec.load(std::memory_order_relaxed)
+			});
+		}
+	}
+	std::sort(res.begin(), res.end(), [](const sHookStatsReport & a_First, const sHookStatsReport & a_Second)
+		{
+			return (a_First.m_TotalNSec > a_Second.m_TotalNSec);
+		}
+	);
+	return res;
+}
+
+
+
+
+
+void cPluginManager::LogHookStats(cCommandOutputCallback & a_Output)
+{
+	if (!IsHookStatsEnabled())
+	{
+		a_Output.OutLn("Hook statistics are disabled, use \"hookstats on\" to start measuring.");
+		return;
+	}
+	auto Stats = GetHookStats();
+	if (Stats.empty())
+	{
+		a_Output.OutLn("No plugin hooks have been measured.");
+		return;
+	}
+	a_Output.OutLn(fmt::format(FMT_STRING("{:<24} {:<32} {:>12} {:>12} {:>10}"), "Plugin", "Hook", "Calls", "Total [ms]", "Avg [us]"));
+	for (const auto & Row : Stats)
+	{
+		a_Output.OutLn(fmt::format(
+			FMT_STRING("{:<24} {:<32} {:>12} {:>12.3f} {:>10.3f}"),
+			Row.m_PluginName, Row.m_HookName, Row.m_NumCalls,
+			static_cast<double>(Row.m_TotalNSec) / 1e6,
+			static_cast<double>(Row.m_TotalNSec) / 1e3 / static_cast<double>(Row.m_NumCalls)
+		));
+	}
+}
+
+
+
+
+
 AStringVector cPluginManager::GetFoldersToLoad(cSettingsRepositoryInterface & a_Settings)
 {
 	// Check if the Plugins section exists.
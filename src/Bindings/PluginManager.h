@@ -210,7 +210,30 @@ public:
 	/** The interface used for enumerating and extern-calling plugins */
 	using cPluginCallback = cFunctionRef<bool(cPlugin &)>;
 
-	typedef std::list<cPlugin *> PluginList;
+	/** The plugins registered for a single hook. Hook handlers may register further hooks, so the dispatch iterates by index. */
+	typedef std::vector<cPlugin *> PluginList;
+
+
+	/** Cumulative statistics of a single plugin's handlers for a single hook.
+	Updated from whichever thread calls the hook, hence the atomics. */
+	struct sHookStats
+	{
+		std::atomic<UInt64> m_NumCalls{0};
+		std::atomic<UInt64> m_TotalNSec{0};
+	};
+
+	/** Statistics for all hooks of a single plugin, indexed by PluginHook. */
+	typedef std::array<sHookStats, HOOK_NUM_HOOKS> cHookStatsArray;
+
+	/** A single row of the hook statistics report, as returned by GetHookStats(). */
+	struct sHookStatsReport
+	{
+		AString m_PluginName;
+		AString m_HookName;
+		UInt64 m_NumCalls;
+		UInt64 m_TotalNSec;
+	};
+	typedef std::vector<sHookStatsReport> cHookStatsReports;
 
 
 	/** Called each tick, calls the plugins' OnTick hook, as well as processes plugin events (addition, removal) */
@@ -230,6 +253,10 @@ public:
 	If a plugin adds multiple handlers for a single hook, it is added only once (ignore-duplicates). */
 	void AddHook(cPlugin * a_Plugin, int a_HookType);
 
+	/** Returns true if at least one plugin has registered a handler for the specified hook.
+	Callers that need to do extra work to prepare the hook parameters can use this to skip it. */
+	bool HasHookListeners(PluginHook a_Hook) const { return !m_Hooks[a_Hook].empty(); }
+
 	/** Returns the number of all plugins in m_Plugins (includes disabled, unloaded and errored plugins). */
 	size_t GetNumPlugins() const;  // tolua_export
 
@@ -405,6 +432,23 @@ public:
 	The path doesn't end in a slash. */
 	static AString GetPluginsPath(void) { return "Plugins"; }  // tolua_export
 
+	/** Enables or disables measuring the per-plugin, per-hook call counts and durations. */
+	void SetHookStatsEnabled(bool a_Enabled) { m_IsHookStatsEnabled.store(a_Enabled); }  // tolua_export
+
+	/** Returns true if the per-plugin, per-hook call counts and durations are being measured. */
+	bool IsHookStatsEnabled(void) const { return m_IsHookStatsEnabled.load(); }  // tolua_export
+
+	/** Zeroes the hook statistics of all plugins. Can be called from any thread. */
+	void ResetHookStats(void);  // tolua_export
+
+	/** Returns a snapshot of the hook statistics of all plugins, for hooks that have been called at least once.
+	The plugins are identified by their folder name. The rows are sorted by the total time spent, the most expensive first.
+	Can be called from any thread, doesn't touch the plugins themselves. */
+	cHookStatsReports GetHookStats(void);
+
+	/** Outputs the hook statistics of all plugins as a text table into a_Output. */
+	void LogHookStats(cCommandOutputCallback & a_Output);
+
 	void SetupNewCommands(void);
 
 	cCommandManager::cCommandNode * GetRootCommandNode() { return &m_RootCommandNode; }
@@ -421,7 +465,8 @@ private:
 		cCommandHandlerPtr m_Handler;
 	} ;
 
-	typedef std::map<int, cPluginManager::PluginList> HookMap;
+	/** The plugins registered for each hook, indexed by PluginHook. */
+	typedef std::array<cPluginManager::PluginList, HOOK_NUM_HOOKS> HookMap;
 	typedef std::map<AString, cCommandReg> CommandMap;
 
 
@@ -444,6 +489,18 @@ private:
 	/** If set to true, all the plugins will be reloaded within the next call to Tick(). */
 	bool m_bReloadPlugins;
 
+	/** If set to true, each hook call is timed and accounted to the plugin's cHookStatsArray. */
+	std::atomic<bool> m_IsHookStatsEnabled;
+
+	/** The hook statistics of each plugin, keyed by the plugin folder name.
+	Kept separate from the plugins so that they can be read from any thread without racing plugin (re)loads;
+	the entries are never removed, so each plugin keeps a pointer to its own array (cPlugin::m_HookStats).
+	The map itself is protected by m_CSHookStats, the counters in it are atomic. */
+	std::map<AString, cHookStatsArray> m_HookStats;
+
+	/** Protects m_HookStats against multithreaded access. */
+	mutable cCriticalSection m_CSHookStats;
+
 	/** The deadlock detect in which all plugins should track their CSs. */
 	cDeadlockDetect & m_DeadlockDetect;
 
@@ -32,11 +32,109 @@
 
 
 
+namespace
+{
+	/** Areas with at least this many blocks are transformed and merged by multiple threads. */
+	constexpr size_t PARALLEL_MIN_BLOCKS = 1 << 21;
+
+	/** The edge of the square tiles in which the rotations transpose each layer,
+	so that both the rows being read and the rows being written stay in the cache. */
+	constexpr int ROTATE_TILE_SIZE = 32;
+
+
+
+
+
+	/** Calls a_Fn(a_Begin, a_End) for consecutive ranges covering [0, a_NumLayers).
+	If the area has at least PARALLEL_MIN_BLOCKS blocks, the ranges are processed by multiple threads at once,
+	so a_Fn must only touch the data of its own layers. */
+	template <typename Fn>
+	void ForEachLayerRange(int a_NumLayers, size_t a_NumBlocks, Fn a_Fn)
+	{
+		const auto NumThreads = std::min<int>(static_cast<int>(std::thread::hardware_concurrency()), a_NumLayers);
+		if ((a_NumBlocks < PARALLEL_MIN_BLOCKS) || (NumThreads < 2))
+		{
+			a_Fn(0, a_NumLayers);
+			return;
+		}
+
+		std::vector<std::thread> Threads;
+		Threads.reserve(static_cast<size_t>(NumThreads - 1));
+		for (int i = 1; i < NumThreads; i++)
+		{
+			Threads.emplace_back(a_Fn, a_NumLayers * i / NumThreads, a_NumLayers * (i + 1) / NumThreads);
+		}
+		a_Fn(0, a_NumLayers / NumThreads);
+		for (auto & Thread : Threads)
+		{
+			Thread.join();
+		}
+	}
+
+
+
+
+
+	/** Maps block states through one of the block handler transformations (rotations, mirroring).
+	The transformations depend on nothing but the state, so each distinct state is transformed only once per server run.
+	The results are kept in a table indexed by the state ID, one table per transformation, shared by all areas and threads.
+	The table is filled lazily; threads racing on an entry compute and store the same value, so relaxed atomics suffice. */
+	template <BlockState (cBlockHandler::*Transform)(BlockState) const>
+	class cBlockStateRemap
+	{
+	public:
+
+		BlockState operator () (BlockState a_Block) const
+		{
+			// The table holds the transformed ID + 1, so that its zero-initialization marks the states not transformed yet:
+			auto & Entry = m_Table[a_Block.ID];
+			auto Mapped = Entry.load(std::memory_order_relaxed);
+			if (Mapped == 0)
+			{
+				Mapped = static_cast<BlockState::DataType>((cBlockHandler::For(a_Block.Type()).*Transform)(a_Block).ID + 1);
+				Entry.store(Mapped, std::memory_order_relaxed);
+			}
+			return BlockState(static_cast<BlockState::DataType>(Mapped - 1));
+		}
+
+	private:
+
+		static std::atomic<BlockState::DataType> m_Table[std::numeric_limits<BlockState::DataType>::max() + 1];
+	};
+
+	template <BlockState (cBlockHandler::*Transform)(BlockState) const>
+	std::atomic<BlockState::DataType> cBlockStateRemap<Transform>::m_Table[std::numeric_limits<BlockState::DataType>::max() + 1];
+
+
+
+
+
+	/** Returns true if the block state is one of the air blocks.
+	Each air block type has a single state, so this is a plain comparison that the compiler can vectorize,
+	unlike cBlockAirHandler::IsBlockAir() that needs the block type. */
+	inline bool IsAirState(BlockState::DataType a_ID)
+	{
+		return (
+			(a_ID == Block::Air::Air().ID) |
+			(a_ID == Block::CaveAir::CaveAir().ID) |
+			(a_ID == Block::VoidAir::VoidAir().ID)
+		);
+	}
+}
+
+
+
+
+
 typedef void (CombinatorFunc)(BlockState & a_DstBlock, BlockState a_SrcBlock);
 
-/** Merges two blocktypes and blockmetas of the specified sizes and offsets using the specified combinator function
-This wild construct allows us to pass a function argument and still have it inlined by the compiler. */
-template <CombinatorFunc Combinator>
+/** Merges a row of a_Count blocks from a_SrcBlocks into a_DstBlocks. */
+typedef void (RowCombinatorFunc)(BlockState * a_DstBlocks, const BlockState * a_SrcBlocks, int a_Count);
+
+/** Merges two blocktypes and blockmetas of the specified sizes and offsets using the specified row combinator function
+This wild construct allows us to pass a function argument and still have it inlined by the compiler.
+Large areas are merged by multiple threads, each taking a range of the layers. */
+template <RowCombinatorFunc RowCombinator>
 void InternalMergeBlocks(
 	BlockState * a_DstBlocks, const BlockState * a_SrcBlocks,
 	int a_SizeX, int a_SizeY, int a_SizeZ,
@@ -48,62 +146,107 @@ void InternalMergeBlocks(
 {
 	UNUSED(a_SrcSizeY);
 	UNUSED(a_DstSizeY);
-	for (int y = 0; y < a_SizeY; y++)
+	if ((a_SizeX <= 0) || (a_SizeY <= 0) || (a_SizeZ <= 0))
 	{
-		int SrcBaseY = (y + a_SrcOffY) * a_SrcSizeX * a_SrcSizeZ;
-		int DstBaseY = (y + a_DstOffY) * a_DstSizeX * a_DstSizeZ;
-		for (int z = 0; z < a_SizeZ; z++)
+		return;
+	}
+	const auto NumBlocks = static_cast<size_t>(a_SizeX) * static_cast<size_t>(a_SizeY) * static_cast<size_t>(a_SizeZ);
+	ForEachLayerRange(a_SizeY, NumBlocks, [=](int a_MinY, int a_MaxY)
+	{
+		for (int y = a_MinY; y < a_MaxY; y++)
 		{
-			int SrcBaseZ = SrcBaseY + (z + a_SrcOffZ) * a_SrcSizeX;
-			int DstBaseZ = DstBaseY + (z + a_DstOffZ) * a_DstSizeX;
-			int SrcIdx = SrcBaseZ + a_SrcOffX;
-			int DstIdx = DstBaseZ + a_DstOffX;
-			for (int x = 0; x < a_SizeX; x++)
+			size_t SrcBaseY = static_cast<size_t>(y + a_SrcOffY) * static_cast<size_t>(a_SrcSizeX * a_SrcSizeZ);
+			size_t DstBaseY = static_cast<size_t>(y + a_DstOffY) * static_cast<size_t>(a_DstSizeX * a_DstSizeZ);
+			for (int z = 0; z < a_SizeZ; z++)
 			{
-				Combinator(a_DstBlocks[DstIdx], a_SrcBlocks[SrcIdx]);
-				++DstIdx;
-				++SrcIdx;
-			}  // for x
-		}  // for z
-	}  // for y
+				size_t SrcIdx = SrcBaseY + static_cast<size_t>((z + a_SrcOffZ) * a_SrcSizeX + a_SrcOffX);
+				size_t DstIdx = DstBaseY + static_cast<size_t>((z + a_DstOffZ) * a_DstSizeX + a_DstOffX);
+				RowCombinator(a_DstBlocks + DstIdx, a_SrcBlocks + SrcIdx, a_SizeX);
+			}  // for z
+		}  // for y
+	});
+}
+
+
+
+
+
+/** Applies the per-block combinator to a whole row, for the strategies that need the block types. */
+template <CombinatorFunc Combinator>
+void MergeRow(BlockState * a_DstBlocks, const BlockState * a_SrcBlocks, int a_Count)
+{
+	for (int x = 0; x < a_Count; x++)
+	{
+		Combinator(a_DstBlocks[x], a_SrcBlocks[x]);
+	}
 }
 
 
 
 
 
-/** Combinator used for cBlockArea::msOverwrite merging */
-static inline void MergeCombinatorOverwrite(BlockState & a_DstBlock, BlockState a_SrcBlock)
+/** Row combinator used for cBlockArea::msOverwrite merging */
+static void MergeRowOverwrite(BlockState * a_DstBlocks, const BlockState * a_SrcBlocks, int a_Count)
 {
-	a_DstBlock = a_SrcBlock;
+	std::copy_n(a_SrcBlocks, a_Count, a_DstBlocks);
 }
 
 
 
 
 
-/** Combinator used for cBlockArea::msFillAir merging */
-static inline void MergeCombinatorFillAir(BlockState & a_DstBlock, BlockState a_SrcBlock)
+// The following row combinators are written as branchless selects on the state IDs, so that the compiler can vectorize them.
+
+/** Row combinator used for cBlockArea::msFillAir merging */
+static void MergeRowFillAir(BlockState * a_DstBlocks, const BlockState * a_SrcBlocks, int a_Count)
 {
-	if (cBlockAirHandler::IsBlockAir(a_DstBlock))
+	for (int x = 0; x < a_Count; x++)
 	{
-		a_DstBlock = a_SrcBlock;
+		const auto Dst = a_DstBlocks[x].ID;
+		a_DstBlocks[x].ID = IsAirState(Dst) ? a_SrcBlocks[x].ID : Dst;
 	}
-	// "else" is the default, already in place
 }
 
 
 
 
 
-/** Combinator used for cBlockArea::msImprint merging */
-static inline void MergeCombinatorImprint(BlockState & a_DstBlock, BlockState a_SrcBlock)
+/** Row combinator used for cBlockArea::msImprint merging */
+static void MergeRowImprint(BlockState * a_DstBlocks, const BlockState * a_SrcBlocks, int a_Count)
 {
-	if (!cBlockAirHandler::IsBlockAir(a_SrcBlock))
+	for (int x = 0; x < a_Count; x++)
 	{
-		a_DstBlock = a_SrcBlock;
+		const auto Src = a_SrcBlocks[x].ID;
+		a_DstBlocks[x].ID = IsAirState(Src) ? a_DstBlocks[x].ID : Src;
+	}
+}
+
+
+
+
+
+/** Row combinator used for cBlockArea::msSpongePrint merging */
+static void MergeRowSpongePrint(BlockState * a_DstBlocks, const BlockState * a_SrcBlocks, int a_Count)
+{
+	// Sponge has a single state, so comparing the state is the same as comparing the type:
+	for (int x = 0; x < a_Count; x++)
+	{
+		const auto Src = a_SrcBlocks[x].ID;
+		a_DstBlocks[x].ID = (Src == Block::Sponge::Sponge().ID) ? a_DstBlocks[x].ID : Src;
+	}
+}
+
+
+
+
+
+/** Row combinator used for cBlockArea::msSimpleCompare merging */
+static void MergeRowSimpleCompare(BlockState * a_DstBlocks, const BlockState * a_SrcBlocks, int a_Count)
+{
+	for (int x = 0; x < a_Count; x++)
+	{
+		a_DstBlocks[x].ID = (a_DstBlocks[x].ID == a_SrcBlocks[x].ID) ? Block::Air::Air().ID : Block::Stone::Stone().ID;
 	}
-	// "else" is the default, already in place
 }
 
 
@@ -170,20 +313,6 @@ static inline void MergeCombinatorLake(BlockState & a_DstBlock, BlockState a_Src
 
 
 
-/** Combinator used for cBlockArea::msSpongePrint merging */
-static inline void MergeCombinatorSpongePrint(BlockState & a_DstBlock, BlockState a_SrcBlock)
-{
-	// Sponge overwrites nothing, everything else overwrites anything
-	if (a_SrcBlock != BlockType::Sponge)
-	{
-		a_DstBlock = a_SrcBlock;
-	}
-}
-
-
-
-
-
 /** Combinator used for cBlockArea::msDifference merging */
 static inline void MergeCombinatorDifference(BlockState & a_DstBlock, BlockState a_SrcBlock)
 {
@@ -201,25 +330,6 @@ static inline void MergeCombinatorDifference(BlockState & a_DstBlock, BlockState
 
 
 
-/** Combinator used for cBlockArea::msSimpleCompare merging */
-static inline void MergeCombinatorSimpleCompare(BlockState & a_DstBlock, BlockState a_SrcBlock)
-{
-	if (a_DstBlock == a_SrcBlock)
-	{
-		// The blocktypes are the same, and the blockmetas are not present or are the same
-		a_DstBlock = Block::Air::Air();
-	}
-	else
-	{
-		// The blocktypes or blockmetas differ
-		a_DstBlock = Block::Stone::Stone();
-	}
-}
-
-
-
-
-
 /** Combinator used for cBlockArea::msMask merging */
 static inline void MergeCombinatorMask(BlockState & a_DstBlock, BlockState a_SrcBlock)
 {
@@ -401,6 +511,7 @@ bool cBlockArea::Read(cForEachChunkProvider & a_ForEachChunkProvider, int a_MinB
 		Clear();
 		return false;
 	}
+	Reader.CopySnapshots();
 
 	return true;
 }
@@ -918,23 +1029,8 @@ void cBlockArea::RotateCCW(void)
 		return;
 	}
 
-	// We are guaranteed that both blocktypes and blockmetas exist; rotate both at the same time:
-	BLOCKARRAY NewBlocks{ new BlockState[GetBlockCount()] };
-	for (int x = 0; x < m_Size.x; x++)
-	{
-		int NewZ = m_Size.x - x - 1;
-		for (int z = 0; z < m_Size.z; z++)
-		{
-			int NewX = z;
-			for (int y = 0; y < m_Size.y; y++)
-			{
-				auto NewIdx = MakeIndexForSize({ NewX, y, NewZ }, { m_Size.z, m_Size.y, m_Size.x });
-				auto OldIdx = MakeIndex(x, y, z);
-				NewBlocks[NewIdx] = m_Blocks[OldIdx];
-			}  // for y
-		}  // for z
-	}  // for x
-	m_Blocks = std::move(NewBlocks);
+	RemapBlocks<&cBlockHandler::RotateCCW>();
+	RotateBlocks(false);
 
 	// Rotate the BlockEntities:
 	if (HasBlockEntities())
@@ -968,23 +1064,8 @@ void cBlockArea::RotateCW(void)
 		return;
 	}
 
-	// We are guaranteed that both blocktypes and blockmetas exist; rotate both at the same time:
-	BLOCKARRAY NewBlocks{ new BlockState[GetBlockCount()] };
-	for (int x = 0; x < m_Size.x; x++)
-	{
-		int NewZ = x;
-		for (int z = 0; z < m_Size.z; z++)
-		{
-			int NewX = m_Size.z - z - 1;
-			for (int y = 0; y < m_Size.y; y++)
-			{
-				auto NewIdx = MakeIndexForSize({ NewX, y, NewZ }, { m_Size.z, m_Size.y, m_Size.x });
-				auto OldIdx = MakeIndex(x, y, z);
-				NewBlocks[NewIdx] = m_Blocks[OldIdx];
-			}  // for y
-		}  // for z
-	}  // for x
-	m_Blocks = std::move(NewBlocks);
+	RemapBlocks<&cBlockHandler::RotateCW>();
+	RotateBlocks(true);
 
 	// Rotate the BlockEntities:
 	if (HasBlockEntities())
@@ -1018,24 +1099,23 @@ void cBlockArea::MirrorXY(void)
 		return;
 	}
 
-	// We are guaranteed that both blocktypes and blockmetas exist; mirror both at the same time:
+	RemapBlocks<&cBlockHandler::MirrorXY>();
+
+	// Swap whole rows:
 	int HalfZ = m_Size.z / 2;
 	int MaxZ = m_Size.z - 1;
-	for (int y = 0; y < m_Size.y; y++)
+	ForEachLayerRange(m_Size.y, GetBlockCount(), [this, HalfZ, MaxZ](int a_MinY, int a_MaxY)
 	{
-		for (int z = 0; z < HalfZ; z++)
+		for (int y = a_MinY; y < a_MaxY; y++)
 		{
-			for (int x = 0; x < m_Size.x; x++)
+			for (int z = 0; z < HalfZ; z++)
 			{
-				auto Idx1 = MakeIndex(x, y, z);
-				auto Idx2 = MakeIndex(x, y, MaxZ - z);
-				auto Block2 = cBlockHandler::For(m_Blocks[Idx2].Type()).MirrorXY(m_Blocks[Idx2]);
-				auto Block1 = cBlockHandler::For(m_Blocks[Idx1].Type()).MirrorXY(m_Blocks[Idx1]);
-				m_Blocks[Idx1] = Block2;
-				m_Blocks[Idx2] = Block1;
-			}  // for x
-		}  // for z
-	}  // for y
+				auto Row1 = m_Blocks.get() + MakeIndex(0, y, z);
+				auto Row2 = m_Blocks.get() + MakeIndex(0, y, MaxZ - z);
+				std::swap_ranges(Row1, Row1 + m_Size.x, Row2);
+			}  // for z
+		}  // for y
+	});
 
 	// Mirror the BlockEntities:
 	if (HasBlockEntities())
@@ -1067,24 +1147,21 @@ void cBlockArea::MirrorXZ(void)
 		return;
 	}
 
-	// We are guaranteed that both blocktypes and blockmetas exist; mirror both at the same time:
+	RemapBlocks<&cBlockHandler::MirrorXZ>();
+
+	// Swap whole layers:
 	int HalfY = m_Size.y / 2;
 	int MaxY = m_Size.y - 1;
-	for (int y = 0; y < HalfY; y++)
+	const auto LayerSize = static_cast<size_t>(m_Size.x * m_Size.z);
+	ForEachLayerRange(HalfY, GetBlockCount(), [this, MaxY, LayerSize](int a_MinY, int a_MaxY)
 	{
-		for (int z = 0; z < m_Size.z; z++)
+		for (int y = a_MinY; y < a_MaxY; y++)
 		{
-			for (int x = 0; x < m_Size.x; x++)
-			{
-				auto Idx1 = MakeIndex(x, y, z);
-				auto Idx2 = MakeIndex(x, MaxY - y, z);
-				auto Block2 = cBlockHandler::For(m_Blocks[Idx2].Type()).MirrorXZ(m_Blocks[Idx2]);
-				auto Block1 = cBlockHandler::For(m_Blocks[Idx1].Type()).MirrorXZ(m_Blocks[Idx1]);
-				m_Blocks[Idx1] = Block2;
-				m_Blocks[Idx2] = Block1;
-			}  // for x
-		}  // for z
-	}  // for y
+			auto Layer1 = m_Blocks.get() + MakeIndex(0, y, 0);
+			auto Layer2 = m_Blocks.get() + MakeIndex(0, MaxY - y, 0);
+			std::swap_ranges(Layer1, Layer1 + LayerSize, Layer2);
+		}  // for y
+	});
 
 	// Mirror the BlockEntities:
 	if (HasBlockEntities())
@@ -1116,24 +1193,21 @@ void cBlockArea::MirrorYZ(void)
 		return;
 	}
 
-	// We are guaranteed that both blocktypes and blockmetas exist; mirror both at the same time:
-	int HalfX = m_Size.x / 2;
+	RemapBlocks<&cBlockHandler::MirrorYZ>();
+
+	// Reverse each row:
 	int MaxX = m_Size.x - 1;
-	for (int y = 0; y < m_Size.y; y++)
+	ForEachLayerRange(m_Size.y, GetBlockCount(), [this](int a_MinY, int a_MaxY)
 	{
-		for (int z = 0; z < m_Size.z; z++)
+		for (int y = a_MinY; y < a_MaxY; y++)
 		{
-			for (int x = 0; x < HalfX; x++)
+			for (int z = 0; z < m_Size.z; z++)
 			{
-				auto Idx1 = MakeIndex(x, y, z);
-				auto Idx2 = MakeIndex(MaxX - x, y, z);
-				auto Block2 = cBlockHandler::For(m_Blocks[Idx2].Type()).MirrorXZ(m_Blocks[Idx2]);
-				auto Block1 = cBlockHandler::For(m_Blocks[Idx1].Type()).MirrorXZ(m_Blocks[Idx1]);
-				m_Blocks[Idx1] = Block2;
-				m_Blocks[Idx2] = Block1;
-			}  // for x
-		}  // for z
-	}  // for y
+				auto Row = m_Blocks.get() + MakeIndex(0, y, z);
+				std::reverse(Row, Row + m_Size.x);
+			}  // for z
+		}  // for y
+	});
 
 	// Mirror the BlockEntities:
 	if (HasBlockEntities())
@@ -1157,6 +1231,79 @@ void cBlockArea::MirrorYZ(void)
 
 
 
+template <BlockState (cBlockHandler::*Transform)(BlockState) const>
+void cBlockArea::RemapBlocks(void)
+{
+	ASSERT(HasBlocks());
+
+	const auto LayerSize = static_cast<size_t>(m_Size.x * m_Size.z);
+	ForEachLayerRange(m_Size.y, GetBlockCount(), [this, LayerSize](int a_MinY, int a_MaxY)
+	{
+		const auto Begin = m_Blocks.get() + static_cast<size_t>(a_MinY) * LayerSize;
+		const auto End = m_Blocks.get() + static_cast<size_t>(a_MaxY) * LayerSize;
+		std::transform(Begin, End, Begin, cBlockStateRemap<Transform>());
+	});
+}
+
+
+
+
+
+void cBlockArea::RotateBlocks(bool a_IsClockwise)
+{
+	ASSERT(HasBlocks());
+
+	// Each layer is transposed separately, in square tiles, so that the writes don't stride across the whole layer.
+	// The new area has the X and Z sizes swapped; rows along the new X are the old columns along Z.
+	const int SizeX = m_Size.x;
+	const int SizeZ = m_Size.z;
+	const auto LayerSize = static_cast<size_t>(SizeX * SizeZ);
+	BLOCKARRAY NewBlocks{ new BlockState[GetBlockCount()] };
+	const auto Src = m_Blocks.get();
+	const auto Dst = NewBlocks.get();
+	ForEachLayerRange(m_Size.y, GetBlockCount(), [=](int a_MinY, int a_MaxY)
+	{
+		for (int y = a_MinY; y < a_MaxY; y++)
+		{
+			const auto SrcLayer = Src + static_cast<size_t>(y) * LayerSize;
+			const auto DstLayer = Dst + static_cast<size_t>(y) * LayerSize;
+			for (int TileX = 0; TileX < SizeX; TileX += ROTATE_TILE_SIZE)
+			{
+				const int EndX = std::min(TileX + ROTATE_TILE_SIZE, SizeX);
+				for (int TileZ = 0; TileZ < SizeZ; TileZ += ROTATE_TILE_SIZE)
+				{
+					const int EndZ = std::min(TileZ + ROTATE_TILE_SIZE, SizeZ);
+					for (int x = TileX; x < EndX; x++)
+					{
+						// CCW: NewX = z, NewZ = SizeX - x - 1; CW: NewX = SizeZ - z - 1, NewZ = x
+						if (a_IsClockwise)
+						{
+							const auto DstRow = DstLayer + x * SizeZ + (SizeZ - 1);
+							for (int z = TileZ; z < EndZ; z++)
+							{
+								DstRow[-z] = SrcLayer[x + z * SizeX];
+							}
+						}
+						else
+						{
+							const auto DstRow = DstLayer + (SizeX - x - 1) * SizeZ;
+							for (int z = TileZ; z < EndZ; z++)
+							{
+								DstRow[z] = SrcLayer[x + z * SizeX];
+							}
+						}
+					}  // for x
+				}  // for TileZ
+			}  // for TileX
+		}  // for y
+	});
+	m_Blocks = std::move(NewBlocks);
+}
+
+
+
+
+
 void cBlockArea::SetRelBlock(Vector3i a_RelPos, BlockState a_Block)
 {
 	ASSERT(m_Blocks != nullptr);
@@ -1806,7 +1953,7 @@ void cBlockArea::MergeByStrategy(const cBlockArea & a_Src, Vector3i a_RelPos, eM
 		{
 			case cBlockArea::msOverwrite:
 			{
-				InternalMergeBlocks<MergeCombinatorOverwrite>(
+				InternalMergeBlocks<MergeRowOverwrite>(
 					GetBlocks(), a_Src.GetBlocks(),
 					SizeX, SizeY, SizeZ,
 					SrcOffX, SrcOffY, SrcOffZ,
@@ -1819,7 +1966,7 @@ void cBlockArea::MergeByStrategy(const cBlockArea & a_Src, Vector3i a_RelPos, eM
 
 			case cBlockArea::msFillAir:
 			{
-				InternalMergeBlocks<MergeCombinatorFillAir>(
+				InternalMergeBlocks<MergeRowFillAir>(
 					GetBlocks(), a_Src.GetBlocks(),
 					SizeX, SizeY, SizeZ,
 					SrcOffX, SrcOffY, SrcOffZ,
@@ -1832,7 +1979,7 @@ void cBlockArea::MergeByStrategy(const cBlockArea & a_Src, Vector3i a_RelPos, eM
 
 			case cBlockArea::msImprint:
 			{
-				InternalMergeBlocks<MergeCombinatorImprint>(
+				InternalMergeBlocks<MergeRowImprint>(
 					GetBlocks(), a_Src.GetBlocks(),
 					SizeX, SizeY, SizeZ,
 					SrcOffX, SrcOffY, SrcOffZ,
@@ -1845,7 +1992,7 @@ void cBlockArea::MergeByStrategy(const cBlockArea & a_Src, Vector3i a_RelPos, eM
 
 			case cBlockArea::msLake:
 			{
-				InternalMergeBlocks<MergeCombinatorLake>(
+				InternalMergeBlocks<MergeRow<MergeCombinatorLake>>(
 					GetBlocks(), a_Src.GetBlocks(),
 					SizeX, SizeY, SizeZ,
 					SrcOffX, SrcOffY, SrcOffZ,
@@ -1858,7 +2005,7 @@ void cBlockArea::MergeByStrategy(const cBlockArea & a_Src, Vector3i a_RelPos, eM
 
 			case cBlockArea::msSpongePrint:
 			{
-				InternalMergeBlocks<MergeCombinatorSpongePrint>(
+				InternalMergeBlocks<MergeRowSpongePrint>(
 					GetBlocks(), a_Src.GetBlocks(),
 					SizeX, SizeY, SizeZ,
 					SrcOffX, SrcOffY, SrcOffZ,
@@ -1871,7 +2018,7 @@ void cBlockArea::MergeByStrategy(const cBlockArea & a_Src, Vector3i a_RelPos, eM
 
 			case cBlockArea::msDifference:
 			{
-				InternalMergeBlocks<MergeCombinatorDifference>(
+				InternalMergeBlocks<MergeRow<MergeCombinatorDifference>>(
 					GetBlocks(), a_Src.GetBlocks(),
 					SizeX, SizeY, SizeZ,
 					SrcOffX, SrcOffY, SrcOffZ,
@@ -1884,7 +2031,7 @@ void cBlockArea::MergeByStrategy(const cBlockArea & a_Src, Vector3i a_RelPos, eM
 
 			case cBlockArea::msSimpleCompare:
 			{
-				InternalMergeBlocks<MergeCombinatorSimpleCompare>(
+				InternalMergeBlocks<MergeRowSimpleCompare>(
 					GetBlocks(), a_Src.GetBlocks(),
 					SizeX, SizeY, SizeZ,
 					SrcOffX, SrcOffY, SrcOffZ,
@@ -1897,7 +2044,7 @@ void cBlockArea::MergeByStrategy(const cBlockArea & a_Src, Vector3i a_RelPos, eM
 
 			case cBlockArea::msMask:
 			{
-				InternalMergeBlocks<MergeCombinatorMask>(
+				InternalMergeBlocks<MergeRow<MergeCombinatorMask>>(
 					GetBlocks(), a_Src.GetBlocks(),
 					SizeX, SizeY, SizeZ,
 					SrcOffX, SrcOffY, SrcOffZ,
@@ -2078,7 +2225,42 @@ bool cBlockArea::cChunkReader::Coords(int a_ChunkX, int a_ChunkZ)
 
 
 
+void cBlockArea::cChunkReader::CopySnapshots(void)
+{
+	for (const auto & Snapshot : m_Snapshots)
+	{
+		m_CurrentChunkX = Snapshot.m_ChunkX;
+		m_CurrentChunkZ = Snapshot.m_ChunkZ;
+		CopyChunkData(Snapshot.m_BlockData, Snapshot.m_LightData);
+	}
+	m_Snapshots.clear();
+}
+
+
+
+
+
 void cBlockArea::cChunkReader::ChunkData(const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData)
+{
+	// Only take a snapshot of the data types needed while the chunkmap is locked, CopySnapshots() copies them into the area later:
+	auto & Snapshot = m_Snapshots.emplace_back();
+	Snapshot.m_ChunkX = m_CurrentChunkX;
+	Snapshot.m_ChunkZ = m_CurrentChunkZ;
+	if (m_Area.m_Blocks != nullptr)
+	{
+		Snapshot.m_BlockData.Assign(a_BlockData);
+	}
+	if ((m_Area.m_BlockLight != nullptr) || (m_Area.m_BlockSkyLight != nullptr))
+	{
+		Snapshot.m_LightData.Assign(a_LightData);
+	}
+}
+
+
+
+
+
+void cBlockArea::cChunkReader::CopyChunkData(const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData)
 {
 	int SizeY = m_Area.m_Size.y;
 	int MinY = m_Origin.y;
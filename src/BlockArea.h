@@ -26,6 +26,7 @@
 
 
 // fwd:
+class cBlockHandler;
 class cCuboid;
 class cItem;
 class cItems;
@@ -428,12 +429,30 @@ protected:
 	public:
 		cChunkReader(cBlockArea & a_Area);
 
+		/** Copies the data of all the chunks read into the area, and releases their snapshots.
+		To be called after the chunks have been read, once the chunkmap is unlocked. */
+		void CopySnapshots(void);
+
 	protected:
+
+		/** Copy-on-write snapshot of the data of a single chunk, taken while the chunkmap is locked. */
+		struct sSnapshot
+		{
+			int m_ChunkX;
+			int m_ChunkZ;
+			ChunkBlockData m_BlockData;
+			ChunkLightData m_LightData;
+		};
+
 		cBlockArea & m_Area;
 		cCuboid m_AreaBounds;  ///< Bounds of the whole area being read, in world coords
 		Vector3i m_Origin;
 		int m_CurrentChunkX;
 		int m_CurrentChunkZ;
+		std::vector<sSnapshot> m_Snapshots;
+
+		/** Copies the data of the current chunk into the area. */
+		void CopyChunkData(const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData);
 
 		// cChunkDataCallback overrides:
 		virtual bool Coords(int a_ChunkX, int a_ChunkZ) override;
@@ -478,6 +497,15 @@ protected:
 
 	void MergeByStrategy(const cBlockArea & a_Src, Vector3i a_RelPos, eMergeStrategy a_Strategy);
 
+	/** Replaces each block with its transformed state (rotated or mirrored facing), as returned by Transform of its block handler.
+	Each distinct state is transformed only once per server run. Defined and instantiated in BlockArea.cpp only. */
+	template <BlockState (cBlockHandler::*Transform)(BlockState) const>
+	void RemapBlocks(void);
+
+	/** Rotates the blocks around the Y axis (without changing their states) and swaps the X and Z sizes of the block array.
+	Doesn't update m_Size. */
+	void RotateBlocks(bool a_IsClockwise);
+
 	/** Updates m_BlockEntities to remove BEs that no longer match the blocktype at their coords, and clones from a_Src the BEs that are missing.
 	a_RelX, a_RelY and a_RelZ are relative coords that should be added to all BEs from a_Src before checking them.
 	If a block should have a BE but one cannot be found in either this or a_Src, a new one is created. */
@@ -297,11 +297,15 @@ bool cBeaconEntity::Tick(std::chrono::milliseconds a_Dt, cChunk & a_Chunk)
 	using namespace std::chrono_literals;
 
 	// Update the beacon every 4 seconds:
-	if ((GetWorld()->GetWorldTickAge() % 4s) == 0s)
+	const auto SinceUpdate = GetWorld()->GetWorldTickAge() % 4s;
+	if (SinceUpdate == 0s)
 	{
 		UpdateBeacon();
 		GiveEffects();
 	}
+
+	// Sleep until the next update:
+	SleepFor(4s - SinceUpdate);
 	return false;
 }
 
@@ -24,6 +24,8 @@
 #include "JukeboxEntity.h"
 #include "NoteEntity.h"
 #include "SignEntity.h"
+#include "../Chunk.h"
+#include "../World.h"
 
 
 
@@ -34,7 +36,11 @@ cBlockEntity::cBlockEntity(BlockState a_Block, const Vector3i a_Pos, cWorld * co
 	m_RelX(a_Pos.x - cChunkDef::Width * FAST_FLOOR_DIV(a_Pos.x, cChunkDef::Width)),
 	m_RelZ(a_Pos.z - cChunkDef::Width * FAST_FLOOR_DIV(a_Pos.z, cChunkDef::Width)),
 	m_Block(a_Block),
-	m_World(a_World)
+	m_World(a_World),
+	m_Chunk(nullptr),
+	m_IsAwake(true),
+	m_IsInTickList(false),
+	m_WakeUpTick(cTickTimeLong::max())
 {
 }
 
@@ -387,6 +393,7 @@ bool cBlockEntity::IsBlockEntityBlockType(const BlockState a_Block)
 void cBlockEntity::OnAddToWorld(cWorld & a_World, cChunk & a_Chunk)
 {
 	m_World = &a_World;
+	m_Chunk = &a_Chunk;
 }
 
 
@@ -423,5 +430,84 @@ void cBlockEntity::SetWorld(cWorld * const a_World)
 bool cBlockEntity::Tick(const std::chrono::milliseconds a_Dt, cChunk & a_Chunk)
 {
 	UNUSED(a_Dt);
+
+	// Nothing to do until something changes:
+	Sleep();
 	return false;
 }
+
+
+
+
+
+void cBlockEntity::WakeUp()
+{
+	m_IsAwake = true;
+	m_WakeUpTick = cTickTimeLong::max();
+	if ((m_Chunk != nullptr) && !m_IsInTickList)
+	{
+		m_Chunk->AddTickingBlockEntity(*this);
+	}
+}
+
+
+
+
+
+void cBlockEntity::WakeUpNeighbors()
+{
+	if (m_Chunk == nullptr)
+	{
+		return;
+	}
+
+	static const Vector3i Offsets[] =
+	{
+		{ 1, 0,  0},
+		{-1, 0,  0},
+		{ 0, 1,  0},
+		{ 0, -1, 0},
+		{ 0, 0,  1},
+		{ 0, 0, -1},
+	};
+	for (const auto & Offset: Offsets)
+	{
+		auto RelPos = GetRelPos() + Offset;
+		if (!cChunkDef::IsValidHeight(RelPos))
+		{
+			continue;
+		}
+		const auto Chunk = m_Chunk->GetRelNeighborChunkAdjustCoords(RelPos);
+		if ((Chunk == nullptr) || !Chunk->IsValid())
+		{
+			continue;
+		}
+		if (const auto Neighbor = Chunk->GetBlockEntityRel(RelPos); Neighbor != nullptr)
+		{
+			Neighbor->WakeUp();
+		}
+	}
+}
+
+
+
+
+
+void cBlockEntity::Sleep()
+{
+	m_IsAwake = false;
+	m_WakeUpTick = cTickTimeLong::max();
+}
+
+
+
+
+
+void cBlockEntity::SleepFor(const cTickTimeLong a_Ticks)
+{
+	ASSERT(m_Chunk != nullptr);
+
+	m_IsAwake = false;
+	m_WakeUpTick = m_World->GetWorldTickAge() + a_Ticks;
+	m_Chunk->ScheduleBlockEntityWakeUp(*this, m_WakeUpTick);
+}
@@ -77,9 +77,22 @@ public:
 
 	void SetWorld(cWorld * a_World);
 
-	/** Ticks the entity; returns true if the chunk should be marked as dirty as a result of this ticking. By default does nothing. */
+	/** Ticks the entity; returns true if the chunk should be marked as dirty as a result of this ticking.
+	Only called while the entity is awake; an entity with nothing to do should call Sleep() or SleepFor().
+	By default puts the entity to sleep. */
 	virtual bool Tick(std::chrono::milliseconds a_Dt, cChunk & a_Chunk);
 
+	/** Makes the entity ticked again, starting with its chunk's next tick.
+	Called on the events that may give a sleeping entity some work: changes to its contents or its neighbours' contents,
+	pickups moving above it, redstone activation, or a DoWithBlockEntityAt() callback. */
+	void WakeUp();
+
+	/** Wakes up the block entities in the six blocks adjacent to this one, such as the hoppers moving items from or to it. */
+	void WakeUpNeighbors();
+
+	/** Returns true if the entity is being ticked, false if it is sleeping until woken up. */
+	bool IsAwake() const { return m_IsAwake; }
+
 	/** Called when a player uses this entity; should open the UI window.
 	returns true if the use was successful, return false to use the block as a "normal" block */
 	virtual bool UsedBy(cPlayer * a_Player) = 0;
@@ -110,6 +123,8 @@ public:
 
 protected:
 
+	friend class cChunk;
+
 	/** Position in absolute block coordinates */
 	Vector3i m_Pos;
 
@@ -119,4 +134,23 @@ protected:
 	BlockState m_Block;
 
 	cWorld * m_World;
+
+	/** The chunk containing the entity, set in OnAddToWorld(). */
+	cChunk * m_Chunk;
+
+	/** False while the entity is sleeping, i.e. its Tick() isn't called. */
+	bool m_IsAwake;
+
+	/** True while the entity is in its chunk's list of ticked block entities. Maintained by cChunk. */
+	bool m_IsInTickList;
+
+	/** The world tick age at which SleepFor() scheduled the entity to wake up, used by cChunk to recognize stale wake-ups. */
+	cTickTimeLong m_WakeUpTick;
+
+
+	/** Stops ticking the entity until something calls WakeUp(). */
+	void Sleep();
+
+	/** Stops ticking the entity for the specified number of ticks, or until something calls WakeUp(). */
+	void SleepFor(cTickTimeLong a_Ticks);
 } ;  // tolua_export
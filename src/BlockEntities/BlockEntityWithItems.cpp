@@ -66,4 +66,8 @@ void cBlockEntityWithItems::OnSlotChanged(cItemGrid * a_Grid, int a_SlotNum)
 
 	// Notify comparators:
 	m_World->WakeUpSimulators(m_Pos);
+
+	// Wake up this entity (a furnace may have got its fuel) and the hoppers around it that may now move the items:
+	WakeUp();
+	WakeUpNeighbors();
 }
@@ -70,6 +70,8 @@ bool cBrewingstandEntity::Tick(std::chrono::milliseconds a_Dt, cChunk & a_Chunk)
 
 	if (!m_IsBrewing)
 	{
+		// Sleep until the contents change:
+		Sleep();
 		return false;
 	}
 
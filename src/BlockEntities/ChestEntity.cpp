@@ -256,4 +256,10 @@ void cChestEntity::OnSlotChanged(cItemGrid * a_Grid, int a_SlotNum)
 	{
 		Window->BroadcastWholeWindow();
 	}
+
+	// The hoppers next to the other half of a double chest also move items from and to this half:
+	if (m_Neighbour != nullptr)
+	{
+		m_Neighbour->WakeUpNeighbors();
+	}
 }
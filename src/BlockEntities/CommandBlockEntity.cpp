@@ -97,6 +97,7 @@ unsigned char cCommandBlockEntity::GetResult(void) const
 void cCommandBlockEntity::Activate(void)
 {
 	m_ShouldExecute = true;
+	WakeUp();
 }
 
 
@@ -123,6 +124,8 @@ bool cCommandBlockEntity::Tick(std::chrono::milliseconds a_Dt, cChunk & a_Chunk)
 	UNUSED(a_Chunk);
 	if (!m_ShouldExecute)
 	{
+		// Sleep until activated:
+		Sleep();
 		return false;
 	}
 
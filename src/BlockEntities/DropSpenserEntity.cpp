@@ -92,6 +92,7 @@ void cDropSpenserEntity::DropSpense(cChunk & a_Chunk)
 void cDropSpenserEntity::Activate(void)
 {
 	m_ShouldDropSpense = true;
+	WakeUp();
 }
 
 
@@ -129,6 +130,8 @@ bool cDropSpenserEntity::Tick(std::chrono::milliseconds a_Dt, cChunk & a_Chunk)
 	UNUSED(a_Dt);
 	if (!m_ShouldDropSpense)
 	{
+		// Sleep until activated:
+		Sleep();
 		return false;
 	}
 
@@ -21,9 +21,7 @@ cEnchantingTableEntity::cEnchantingTableEntity(BlockState a_Block, Vector3i a_Po
 
 cItems cEnchantingTableEntity::ConvertToPickups() const
 {
-	cItem Item(Item::EnchantingTable);
-	Item.m_CustomName = m_CustomName;
-	return Item;
+	return cItem(Item::EnchantingTable, 1, 0, "", m_CustomName);
 }
 
 
@@ -94,6 +94,15 @@ bool cFurnaceEntity::Tick(std::chrono::milliseconds a_Dt, cChunk & a_Chunk)
 
 		// Reset progressbars, block type, and bail out
 		a_Chunk.FastSetBlock(GetRelPos(), Block::Furnace::Furnace(Block::Furnace::Facing(a_Chunk.GetBlock(GetRelPos())), false));
+
+		// Once the progress bar is back at zero, there's nothing to do until the contents change:
+		if (m_TimeCooked == 0)
+		{
+			UpdateProgressBars(true);
+			Sleep();
+			return false;
+		}
+
 		UpdateProgressBars();
 		return false;
 	}
@@ -9,6 +9,7 @@
 #include "../Entities/Player.h"
 #include "../Entities/Pickup.h"
 #include "../Bindings/PluginManager.h"
+#include "../BoundingBox.h"
 #include "../UI/HopperWindow.h"
 #include "ChestEntity.h"
 #include "FurnaceEntity.h"
@@ -28,6 +29,8 @@ cHopperEntity::cHopperEntity(BlockState a_Block, Vector3i a_Pos, cWorld * a_Worl
 	Super(a_Block, a_Pos, ContentsWidth, ContentsHeight, a_World),
 	m_LastMoveItemsInTick(0),
 	m_LastMoveItemsOutTick(0),
+	m_HasPickupsAbove(false),
+	m_ShouldCollectPickups(true),
 	m_Locked(false)
 {
 	ASSERT(a_Block.Type() == BlockType::Hopper);
@@ -40,6 +43,39 @@ cHopperEntity::cHopperEntity(BlockState a_Block, Vector3i a_Pos, cWorld * a_Worl
 void cHopperEntity::SetLocked(bool a_Value)
 {
 	m_Locked = a_Value;
+	if (!m_Locked)
+	{
+		m_ShouldCollectPickups = m_ShouldCollectPickups || m_HasPickupsAbove;
+		WakeUp();
+	}
+}
+
+
+
+
+
+void cHopperEntity::OnPickupEntered(cPickup & a_Pickup)
+{
+	if (!IsPickupAbove(a_Pickup))
+	{
+		return;
+	}
+	if (m_Locked)
+	{
+		// Collect the pickup once unlocked:
+		m_HasPickupsAbove = true;
+		return;
+	}
+
+	while (a_Pickup.IsTicking() && TrySuckPickupIn(a_Pickup))
+	{
+		// Keep filling the slots until the pickup is all in or the hopper is full
+	}
+	if (a_Pickup.IsTicking())
+	{
+		// The rest is collected once there's space in the hopper:
+		m_HasPickupsAbove = true;
+	}
 }
 
 
@@ -84,13 +120,42 @@ bool cHopperEntity::Tick(std::chrono::milliseconds a_Dt, cChunk & a_Chunk)
 {
 	UNUSED(a_Dt);
 
+	if (m_Locked)
+	{
+		// Sleep until unlocked:
+		Sleep();
+		return false;
+	}
+
 	bool isDirty = false;
-	if (!m_Locked)
+	const auto CurrentTick = a_Chunk.GetWorld()->GetWorldAge();
+	isDirty = MoveItemsIn(a_Chunk, CurrentTick) || isDirty;
+	if (m_ShouldCollectPickups)
 	{
-		const auto CurrentTick = a_Chunk.GetWorld()->GetWorldAge();
-		isDirty = MoveItemsIn(a_Chunk, CurrentTick) || isDirty;
+		// The pickups entering the space above are sucked in by OnPickupEntered(); this only collects the ones that were left there:
+		m_ShouldCollectPickups = false;
 		isDirty = MovePickupsIn(a_Chunk) || isDirty;
-		isDirty = MoveItemsOut(a_Chunk, CurrentTick) || isDirty;
+	}
+	isDirty = MoveItemsOut(a_Chunk, CurrentTick) || isDirty;
+
+	// Sleep until the earliest transfer that is waiting for its cooldown.
+	// The transfers that weren't possible wait for a change in the containers around or a pickup above, which wake the hopper up:
+	auto NextTransfer = cTickTimeLong::max();
+	for (const auto LastMove: { m_LastMoveItemsInTick, m_LastMoveItemsOutTick })
+	{
+		const auto Cooldown = LastMove + TICKS_PER_TRANSFER - CurrentTick;
+		if (Cooldown > 0_tick)
+		{
+			NextTransfer = std::min(NextTransfer, Cooldown);
+		}
+	}
+	if (NextTransfer == cTickTimeLong::max())
+	{
+		Sleep();
+	}
+	else
+	{
+		SleepFor(NextTransfer);
 	}
 	return isDirty;
 }
@@ -206,85 +271,91 @@ bool cHopperEntity::MoveItemsIn(cChunk & a_Chunk, const cTickTimeLong a_CurrentT
 
 bool cHopperEntity::MovePickupsIn(cChunk & a_Chunk)
 {
-	class cHopperPickupSearchCallback
+	// Only look at the space where IsPickupAbove() may hold:
+	const cBoundingBox Box(Vector3d(m_Pos.x, m_Pos.y + 0.5, m_Pos.z), Vector3d(m_Pos.x + 1, m_Pos.y + 1.5, m_Pos.z + 1));
+
+	bool HasMovedPickups = false;
+	m_HasPickupsAbove = false;
+	a_Chunk.ForEachEntityInBox(Box, [this, &HasMovedPickups](cEntity & a_Entity)
 	{
-	public:
-		cHopperPickupSearchCallback(Vector3i a_Pos, cItemGrid & a_Contents) :
-			m_Pos(a_Pos),
-			m_bFoundPickupsAbove(false),
-			m_Contents(a_Contents)
+		if (!a_Entity.IsPickup() || !a_Entity.IsTicking())
 		{
+			return false;
 		}
 
-		bool operator () (cEntity & a_Entity)
+		auto & Pickup = static_cast<cPickup &>(a_Entity);
+		if (Pickup.IsCollected() || !IsPickupAbove(Pickup))
 		{
-			if (!a_Entity.IsPickup())
-			{
-				return false;
-			}
-
-			Vector3f EntityPos = a_Entity.GetPosition();
-			Vector3f BlockPos(m_Pos.x + 0.5f, static_cast<float>(m_Pos.y) + 1, m_Pos.z + 0.5f);  // One block above hopper, and search from center outwards
-			double Distance = (EntityPos - BlockPos).Length();
-
-			if (Distance < 0.5)
-			{
-				if (TrySuckPickupIn(static_cast<cPickup &>(a_Entity)))
-				{
-					return false;
-				}
-			}
-
 			return false;
 		}
 
-		bool TrySuckPickupIn(cPickup & a_Pickup)
+		while (Pickup.IsTicking() && TrySuckPickupIn(Pickup))
+		{
+			HasMovedPickups = true;
+		}
+		if (Pickup.IsTicking())
 		{
-			cItem & Item = a_Pickup.GetItem();
+			m_HasPickupsAbove = true;
+		}
+		return false;
+	});
 
-			for (int i = 0; i < ContentsWidth * ContentsHeight; i++)
-			{
-				if (m_Contents.IsSlotEmpty(i))
-				{
-					m_bFoundPickupsAbove = true;
-					m_Contents.SetSlot(i, Item);
-					a_Pickup.Destroy();  // Kill pickup
+	return HasMovedPickups;
+}
+
+
+
+
+
+bool cHopperEntity::IsPickupAbove(const cPickup & a_Pickup) const
+{
+	// One block above the hopper, measured from the center:
+	const Vector3d Center(m_Pos.x + 0.5, m_Pos.y + 1, m_Pos.z + 0.5);
+	return ((a_Pickup.GetPosition() - Center).Length() < 0.5);
+}
 
-					return true;
-				}
-				else if (m_Contents.GetSlot(i).IsEqual(Item) && !m_Contents.GetSlot(i).IsFullStack())
-				{
-					m_bFoundPickupsAbove = true;
 
-					auto PreviousCount = m_Contents.GetSlot(i).m_ItemCount;
 
-					Item.m_ItemCount -= m_Contents.ChangeSlotCount(i, Item.m_ItemCount) - PreviousCount;  // Set count to however many items were added
 
-					if (Item.IsEmpty())
-					{
-						a_Pickup.Destroy();  // Kill pickup if all items were added
-					}
-					return true;
-				}
-			}
-			return false;
-		}
 
-		bool FoundPickupsAbove(void) const
+bool cHopperEntity::TrySuckPickupIn(cPickup & a_Pickup)
+{
+	cItem & Item = a_Pickup.GetItem();
+
+	for (int i = 0; i < ContentsWidth * ContentsHeight; i++)
+	{
+		if (m_Contents.IsSlotEmpty(i))
 		{
-			return m_bFoundPickupsAbove;
+			m_Contents.SetSlot(i, Item);
+			a_Pickup.Destroy();  // Kill pickup
+			return true;
 		}
+		else if (m_Contents.GetSlot(i).IsEqual(Item) && !m_Contents.GetSlot(i).IsFullStack())
+		{
+			auto PreviousCount = m_Contents.GetSlot(i).m_ItemCount;
 
-	protected:
-		Vector3i m_Pos;
-		bool m_bFoundPickupsAbove;
-		cItemGrid & m_Contents;
-	};
+			Item.m_ItemCount -= m_Contents.ChangeSlotCount(i, Item.m_ItemCount) - PreviousCount;  // Set count to however many items were added
 
-	cHopperPickupSearchCallback HopperPickupSearchCallback(Vector3i(GetPosX(), GetPosY(), GetPosZ()), m_Contents);
-	a_Chunk.ForEachEntity(HopperPickupSearchCallback);
+			if (Item.IsEmpty())
+			{
+				a_Pickup.Destroy();  // Kill pickup if all items were added
+			}
+			return true;
+		}
+	}
+	return false;
+}
+
+
+
+
+
+void cHopperEntity::OnSlotChanged(cItemGrid * a_Grid, int a_SlotNum)
+{
+	Super::OnSlotChanged(a_Grid, a_SlotNum);
 
-	return HopperPickupSearchCallback.FoundPickupsAbove();
+	// There may be space now for the pickups waiting above:
+	m_ShouldCollectPickups = m_ShouldCollectPickups || m_HasPickupsAbove;
 }
 
 
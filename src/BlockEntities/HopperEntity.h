@@ -15,6 +15,13 @@
 
 
 
+// fwd:
+class cPickup;
+
+
+
+
+
 // tolua_begin
 class cHopperEntity :
 	public cBlockEntityWithItems
@@ -45,11 +52,20 @@ public:
 
 	void SetLocked(bool a_Value);
 
+	/** Called by a pickup that has moved into the block above this hopper; sucks it in if it is close enough and there's space. */
+	void OnPickupEntered(cPickup & a_Pickup);
+
 protected:
 
 	cTickTimeLong m_LastMoveItemsInTick;
 	cTickTimeLong m_LastMoveItemsOutTick;
 
+	/** True if some pickups above the hopper didn't fit in, they are collected once there's space. */
+	bool m_HasPickupsAbove;
+
+	/** True if MovePickupsIn() should look for the pickups above in the next tick. */
+	bool m_ShouldCollectPickups;
+
 	// cBlockEntity overrides:
 	virtual void CopyFrom(const cBlockEntity & a_Src) override;
 	virtual bool Tick(std::chrono::milliseconds a_Dt, cChunk & a_Chunk) override;
@@ -65,6 +81,12 @@ protected:
 	/** Moves pickups from above this hopper into it. Returns true if the contents have changed. */
 	bool MovePickupsIn(cChunk & a_Chunk);
 
+	/** Returns true if the pickup is close enough to be sucked into this hopper. */
+	bool IsPickupAbove(const cPickup & a_Pickup) const;
+
+	/** Moves the pickup's items into the first slot that can take some of them, destroying the pickup if it's all in. Returns true if any items were moved. */
+	bool TrySuckPickupIn(cPickup & a_Pickup);
+
 	/** Moves items out from this hopper into the destination. Returns true if the contents have changed. */
 	bool MoveItemsOut(cChunk & a_Chunk, cTickTimeLong a_CurrentTick);
 
@@ -92,6 +114,9 @@ protected:
 	/** Moves one piece to the specified entity's contents' slot. Returns true if contents have changed. */
 	bool MoveItemsToSlot(cBlockEntityWithItems & a_Entity, int a_DstSlotNum);
 
+	// cItemGrid::cListener overrides:
+	virtual void OnSlotChanged(cItemGrid * a_Grid, int a_SlotNum) override;
+
 private:
 
 	bool m_Locked;
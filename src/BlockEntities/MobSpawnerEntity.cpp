@@ -125,13 +125,16 @@ bool cMobSpawnerEntity::Tick(std::chrono::milliseconds a_Dt, cChunk & a_Chunk)
 	using namespace std::chrono_literals;
 
 	// Update the active flag every 5 seconds:
-	if ((m_World->GetWorldTickAge() % 5s) == 0s)
+	const auto SinceUpdate = m_World->GetWorldTickAge() % 5s;
+	if (SinceUpdate == 0s)
 	{
 		UpdateActiveState();
 	}
 
 	if (!m_IsActive)
 	{
+		// Sleep until the next update:
+		SleepFor(5s - SinceUpdate);
 		return false;
 	}
 
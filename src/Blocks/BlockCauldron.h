@@ -187,7 +187,7 @@ private:
 				case Item::LeatherChestplate:
 				{
 					// Resets any color to default:
-					if ((FillState > 0) && ((EquippedItem.m_ItemColor.GetRed() != 255) || (EquippedItem.m_ItemColor.GetBlue() != 255) || (EquippedItem.m_ItemColor.GetGreen() != 255)))
+					if ((FillState > 0) && ((EquippedItem.GetItemColor().GetRed() != 255) || (EquippedItem.GetItemColor().GetBlue() != 255) || (EquippedItem.GetItemColor().GetGreen() != 255)))
 					{
 						FillState--;
 						if (FillState > 0)
@@ -199,7 +199,7 @@ private:
 							a_ChunkInterface.FastSetBlock(a_BlockPos, Block::Cauldron::Cauldron());
 						}
 						auto NewItem = cItem(EquippedItem);
-						NewItem.m_ItemColor.Clear();
+						NewItem.ModifyItemColor().Clear();
 						a_Player.ReplaceOneEquippedItemTossRest(NewItem);
 					}
 					break;
@@ -391,11 +391,11 @@ private:
 			case Item::LeatherChestplate:
 			{
 				// Resets any color to default:
-				if ((FillState > 0) && ((EquippedItem.m_ItemColor.GetRed() != 255) || (EquippedItem.m_ItemColor.GetBlue() != 255) || (EquippedItem.m_ItemColor.GetGreen() != 255)))
+				if ((FillState > 0) && ((EquippedItem.GetItemColor().GetRed() != 255) || (EquippedItem.GetItemColor().GetBlue() != 255) || (EquippedItem.GetItemColor().GetGreen() != 255)))
 				{
 					a_ChunkInterface.FastSetBlock(a_BlockPos, Block::Cauldron::Cauldron(--FillState));
 					auto NewItem = cItem(EquippedItem);
-					NewItem.m_ItemColor.Clear();
+					NewItem.ModifyItemColor().Clear();
 					a_Player.ReplaceOneEquippedItemTossRest(NewItem);
 				}
 				break;
@@ -26,7 +26,7 @@ private:
 		)
 		{
 			// Only drop self when mined with a silk-touch pickaxe:
-			if (a_Tool->m_Enchantments.GetLevel(cEnchantments::enchSilkTouch) > 0)
+			if (a_Tool->GetEnchantments().GetLevel(cEnchantments::enchSilkTouch) > 0)
 			{
 				return cItem(Item::EnderChest);
 			}
@@ -1438,7 +1438,7 @@ ColourID cBlockHandler::GetMapBaseColourID() const
 
 bool cBlockHandler::ToolHasSilkTouch(const cItem * a_Tool)
 {
-	return ((a_Tool != nullptr) && (a_Tool->m_Enchantments.GetLevel(cEnchantments::enchSilkTouch) > 0));
+	return ((a_Tool != nullptr) && (a_Tool->GetEnchantments().GetLevel(cEnchantments::enchSilkTouch) > 0));
 }
 
 
@@ -1450,7 +1450,7 @@ unsigned char cBlockHandler::ToolFortuneLevel(const cItem * a_Tool)
 	if ((a_Tool != nullptr) && ItemCategory::IsTool(a_Tool->m_ItemType))
 	{
 		// Return enchantment level, limited to avoid spawning excessive pickups (crashing the server) when modified items are used:
-		return static_cast<unsigned char>(std::min(8U, a_Tool->m_Enchantments.GetLevel(cEnchantments::enchFortune)));
+		return static_cast<unsigned char>(std::min(8U, a_Tool->GetEnchantments().GetLevel(cEnchantments::enchFortune)));
 	}
 
 	// Not a tool:
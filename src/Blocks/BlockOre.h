@@ -94,7 +94,7 @@ private:
 			return;
 		}
 
-		if (Player->GetEquippedItem().m_Enchantments.GetLevel(cEnchantments::enchSilkTouch) != 0)
+		if (Player->GetEquippedItem().GetEnchantments().GetLevel(cEnchantments::enchSilkTouch) != 0)
 		{
 			// Don't drop XP when the ore is mined with the Silk Touch enchantment
 			return;
@@ -7,6 +7,7 @@
 #include "Chunk.h"
 #include "ClientHandle.h"
 #include "Entities/Entity.h"
+#include "Entities/EntityTracking.h"
 #include "Entities/Player.h"
 #include "BlockEntities/BlockEntity.h"
 
@@ -501,6 +502,117 @@ void cWorld::BroadcastPlayerListUpdatePing()
 
 
 
+void cWorld::BroadcastQueuedEntityMovements(void)
+{
+	cLock Lock(*this);
+
+	// Pick the updates that each client gets, depending on its distance from the entity:
+	const auto UpdateIndex = m_WorldTickAge.count() / 2;
+	for (const auto Entity : m_EntityMovementQueue)
+	{
+		const auto Chunk = Entity->GetParentChunk();
+		if (!Entity->IsTicking() || (Chunk == nullptr))
+		{
+			continue;
+		}
+
+		const auto Update = Entity->GetQueuedMovementUpdate();
+		const auto Position = Entity->GetPosition();
+		const auto LastSentPosition = Entity->GetLastSentPosition();
+		const auto TrackingRange = GetEntityTrackingRange(*Entity);
+
+		// Spread the updates of the entities over the ticks, for the clients that don't get each of them:
+		const auto EntityUpdateIndex = UpdateIndex + Entity->GetUniqueID();
+
+		for (const auto Client : Chunk->GetAllClients())
+		{
+			const auto Player = Client->GetPlayer();
+			if ((Client == Entity->GetMovementUpdateExclude()) || (Player == nullptr))
+			{
+				continue;
+			}
+
+			auto & Batch = m_EntityMovementBatches[Player->GetUniqueID()];
+			auto ClientUpdate = Update;
+			if ((Update & cEntity::muRest) != 0)
+			{
+				// The entity has stopped, every client needs its final position, even out of the tracking range:
+				ClientUpdate = (Update & (cEntity::muVelocity | cEntity::muHeadLook)) | cEntity::muTeleport;
+			}
+			else
+			{
+				const auto SqrDistance = (Player->GetPosition() - Position).SqrLength();
+				const auto LastSqrDistance = (Batch.m_LastViewerPosition - LastSentPosition).SqrLength();
+				switch (EntityTracking::GetClientUpdate(SqrDistance, LastSqrDistance, TrackingRange, EntityUpdateIndex))
+				{
+					case EntityTracking::eClientUpdate::None:
+					{
+						continue;
+					}
+					case EntityTracking::eClientUpdate::Relative:
+					{
+						break;
+					}
+					case EntityTracking::eClientUpdate::Absolute:
+					{
+						if ((Update & (cEntity::muPosition | cEntity::muLook)) != 0)
+						{
+							ClientUpdate = (Update & ~(cEntity::muPosition | cEntity::muLook)) | cEntity::muTeleport;
+						}
+						break;
+					}
+				}
+			}
+			Batch.m_Client = Client;
+			Batch.m_Updates.emplace_back(Entity, static_cast<UInt8>(ClientUpdate));
+		}
+	}
+
+	// Send each client's updates in one go:
+	for (auto & Entry : m_EntityMovementBatches)
+	{
+		auto & Batch = Entry.second;
+		if (!Batch.m_Updates.empty())
+		{
+			Batch.m_Client->SendEntityMovements(Batch.m_Updates);
+			Batch.m_Updates.clear();
+		}
+		Batch.m_Client = nullptr;
+	}
+
+	// The protocols have used the last sent positions for the relative moves, update them now:
+	for (const auto Entity : m_EntityMovementQueue)
+	{
+		Entity->OnMovementUpdateSent();
+	}
+	m_EntityMovementQueue.clear();
+
+	// Remember where the clients were at the time of the updates, to tell which tier they were in:
+	if ((m_WorldTickAge % 2_tick) == 0_tick)
+	{
+		for (const auto Player : m_Players)
+		{
+			m_EntityMovementBatches[Player->GetUniqueID()].m_LastViewerPosition = Player->GetPosition();
+		}
+
+		// Drop the batches of the players that have left the world:
+		for (auto itr = m_EntityMovementBatches.begin(); itr != m_EntityMovementBatches.end();)
+		{
+			const auto PlayerID = itr->first;
+			const auto IsInWorld = std::any_of(m_Players.begin(), m_Players.end(), [PlayerID](const cPlayer * a_Player)
+				{
+					return (a_Player->GetUniqueID() == PlayerID);
+				}
+			);
+			itr = IsInWorld ? std::next(itr) : m_EntityMovementBatches.erase(itr);
+		}
+	}
+}
+
+
+
+
+
 void cWorld::BroadcastRemoveEntityEffect(const cEntity & a_Entity, int a_EffectID, const cClientHandle * a_Exclude)
 {
 	ForClientsWithEntity(a_Entity, *this, a_Exclude, [&](cClientHandle & a_Client)
@@ -24,6 +24,7 @@
 #include "Simulator/RedstoneSimulator.h"
 #include "MobCensus.h"
 #include "MobSpawner.h"
+#include "Physics/SimpleBodyBatch.h"
 #include "BlockInServerPluginInterface.h"
 #include "SetChunkData.h"
 #include "BoundingBox.h"
@@ -51,6 +52,7 @@ cChunk::cChunk(
 	m_IsLightValid(false),
 	m_IsDirty(false),
 	m_IsSaving(false),
+	m_ShouldResendChunk(false),
 	m_StayCount(0),
 	m_PosX(a_ChunkX),
 	m_PosZ(a_ChunkZ),
@@ -124,7 +126,7 @@ cChunk::~cChunk()
 
 void cChunk::BroadcastPendingChanges(void)
 {
-	if (const auto PendingBlocksCount = m_PendingSendBlocks.size(); PendingBlocksCount >= 10240)
+	if (const auto PendingBlocksCount = m_PendingSendBlocks.size(); m_ShouldResendChunk || (PendingBlocksCount >= MAX_PENDING_SEND_BLOCKS))
 	{
 		// Resend the full chunk:
 		for (const auto ClientHandle : m_LoadedByClient)
@@ -159,6 +161,7 @@ void cChunk::BroadcastPendingChanges(void)
 
 	m_PendingSendBlocks.clear();
 	m_PendingSendBlockEntities.clear();
+	m_ShouldResendChunk = false;
 }
 
 
@@ -315,6 +318,13 @@ void cChunk::GetAllData(cChunkDataCallback & a_Callback) const
 
 	a_Callback.LightIsValid(m_IsLightValid);
 	a_Callback.ChunkData(m_BlockData, m_LightData);
+	for (size_t SectionY = 0; SectionY < cChunkDef::NumSections; SectionY++)
+	{
+		if (m_SectionLayers[SectionY] != nullptr)
+		{
+			a_Callback.SectionLayers(SectionY, *m_SectionLayers[SectionY]);
+		}
+	}
 	a_Callback.HeightMap(m_HeightMap);
 	a_Callback.BiomeMap(m_BiomeMap);
 
@@ -340,6 +350,10 @@ void cChunk::SetAllData(SetChunkData && a_SetChunkData)
 
 	m_BlockData = std::move(a_SetChunkData.BlockData);
 	m_LightData = std::move(a_SetChunkData.LightData);
+	for (size_t SectionY = 0; SectionY < cChunkDef::NumSections; SectionY++)
+	{
+		UpdateSectionLayers(SectionY);
+	}
 	m_IsLightValid = a_SetChunkData.IsLightValid;
 
 	m_PendingSendBlocks.clear();
@@ -357,11 +371,16 @@ void cChunk::SetAllData(SetChunkData && a_SetChunkData)
 	m_Entities = std::move(a_SetChunkData.Entities);
 
 	// Set all the entity variables again:
+	m_PickupBuckets.clear();
 	for (const auto & Entity : m_Entities)
 	{
 		Entity->SetWorld(m_World);
 		Entity->SetParentChunk(this);
 		Entity->SetIsTicking(true);
+		if (Entity->IsPickup())
+		{
+			AddPickupToBucket(static_cast<cPickup &>(*Entity));
+		}
 	}
 
 	// Remove the block entities present - either the loader / saver has better, or we'll create empty ones:
@@ -373,6 +392,8 @@ void cChunk::SetAllData(SetChunkData && a_SetChunkData)
 
 	// Clear the old ones:
 	m_BlockEntities = std::move(a_SetChunkData.BlockEntities);
+	m_TickingBlockEntities.clear();
+	m_BlockEntityWakeUps = {};
 
 	// Check that all block entities have a valid blocktype at their respective coords (DEBUG-mode only):
 
@@ -404,6 +425,7 @@ void cChunk::SetAllData(SetChunkData && a_SetChunkData)
 	for (auto & KeyPair : m_BlockEntities)
 	{
 		KeyPair.second->OnAddToWorld(*m_World, *this);
+		KeyPair.second->WakeUp();
 	}
 
 	// Wake up all simulators for their respective blocks:
@@ -456,25 +478,33 @@ void cChunk::WriteBlockArea(cBlockArea & a_Area, int a_MinBlockX, int a_MinBlock
 	int BaseX = BlockStartX - a_MinBlockX;  // Offset within the area where the union starts
 	int BaseZ = BlockStartZ - a_MinBlockZ;
 
-	// Copy blocktype and blockmeta:
-	auto Blocks = a_Area.GetBlocks();
-	for (int y = 0; y < SizeY; y++)
+	// Copy the blocks, a section at a time:
+	bool IsChanged = false;
+	const int EndY = a_MinBlockY + SizeY;
+	for (int SectionY = a_MinBlockY / cChunkDef::SectionHeight; SectionY * cChunkDef::SectionHeight < EndY; SectionY++)
+	{
+		const int StartY = std::max(a_MinBlockY, SectionY * cChunkDef::SectionHeight);
+		const int StopY = std::min(EndY, (SectionY + 1) * cChunkDef::SectionHeight);
+		IsChanged |= WriteBlockAreaSection(
+			a_Area,
+			{ BaseX, StartY - a_MinBlockY, BaseZ },
+			{ OffX, StartY, OffZ },
+			{ SizeX, StopY - StartY, SizeZ }
+		);
+	}
+
+	if (IsChanged)
 	{
-		int ChunkY = a_MinBlockY + y;
-		int AreaY = y;
-		for (int z = 0; z < SizeZ; z++)
+		MarkDirty();
+		m_IsLightValid = false;
+		for (int z = OffZ; z < OffZ + SizeZ; z++)
 		{
-			int ChunkZ = OffZ + z;
-			int AreaZ = BaseZ + z;
-			for (int x = 0; x < SizeX; x++)
+			for (int x = OffX; x < OffX + SizeX; x++)
 			{
-				int ChunkX = OffX + x;
-				int AreaX = BaseX + x;
-				auto idx = a_Area.MakeIndex(AreaX, AreaY, AreaZ);
-				FastSetBlock(ChunkX, ChunkY, ChunkZ, Blocks[idx]);
-			}  // for x
-		}  // for z
-	}  // for y
+				UpdateHeightMapColumn(x, z);
+			}
+		}
+	}
 
 	// Erase all affected block entities:
 	{
@@ -495,6 +525,10 @@ void cChunk::WriteBlockArea(cBlockArea & a_Area, int a_MinBlockX, int a_MinBlock
 				itr->second->OnRemoveFromWorld();
 
 				PendingRemove = std::remove(m_PendingSendBlockEntities.begin(), PendingRemove, itr->second.get());  // Search the remaining valid pending sends.
+				if (itr->second->m_IsInTickList)
+				{
+					std::replace(m_TickingBlockEntities.begin(), m_TickingBlockEntities.end(), itr->second.get(), static_cast<cBlockEntity *>(nullptr));
+				}
 				itr = m_BlockEntities.erase(itr);
 			}
 			else
@@ -538,6 +572,133 @@ void cChunk::WriteBlockArea(cBlockArea & a_Area, int a_MinBlockX, int a_MinBlock
 
 
 
+bool cChunk::WriteBlockAreaSection(const cBlockArea & a_Area, const Vector3i a_AreaStart, const Vector3i a_RelStart, const Vector3i a_Size)
+{
+	ASSERT(a_RelStart.y / cChunkDef::SectionHeight == (a_RelStart.y + a_Size.y - 1) / cChunkDef::SectionHeight);
+
+	const auto AreaBlocks = a_Area.GetBlocks();
+	const auto SectionY = static_cast<size_t>(a_RelStart.y / cChunkDef::SectionHeight);
+	const auto RowStart = [&](int a_Y, int a_Z)
+	{
+		return AreaBlocks + a_Area.MakeIndex(a_AreaStart.x, a_AreaStart.y + a_Y, a_AreaStart.z + a_Z);
+	};
+
+	// Don't allocate a missing section only to write air into it:
+	if (m_BlockData.GetSection(SectionY) == nullptr)
+	{
+		bool IsAllAir = true;
+		for (int y = 0; (y < a_Size.y) && IsAllAir; y++)
+		{
+			for (int z = 0; (z < a_Size.z) && IsAllAir; z++)
+			{
+				const auto Row = RowStart(y, z);
+				IsAllAir = std::all_of(Row, Row + a_Size.x, [](BlockState a_Block) { return (a_Block == ChunkBlockData::DefaultValue); });
+			}
+		}
+		if (IsAllAir)
+		{
+			return false;
+		}
+		auto & NewSection = m_BlockData.GetSectionForOverwrite(SectionY);
+		std::fill(NewSection.begin(), NewSection.end(), ChunkBlockData::DefaultValue);
+	}
+
+	auto & Section = m_BlockData.GetSectionForOverwrite(SectionY);
+	bool IsChanged = false;
+	for (int y = 0; y < a_Size.y; y++)
+	{
+		const int RelY = a_RelStart.y + y;
+		for (int z = 0; z < a_Size.z; z++)
+		{
+			const int RelZ = a_RelStart.z + z;
+			const auto Src = RowStart(y, z);
+			const auto Dst = Section.data() + cChunkDef::MakeIndex(a_RelStart.x, RelY % cChunkDef::SectionHeight, RelZ);
+			if (std::equal(Src, Src + a_Size.x, Dst))
+			{
+				continue;
+			}
+			IsChanged = true;
+
+			if (m_ShouldResendChunk)
+			{
+				// The clients get the whole chunk anyway, no need to look for the individual changes:
+				std::copy_n(Src, a_Size.x, Dst);
+				continue;
+			}
+
+			for (int x = 0; x < a_Size.x; x++)
+			{
+				if (Dst[x] != Src[x])
+				{
+					Dst[x] = Src[x];
+					m_PendingSendBlocks.emplace_back(m_PosX, m_PosZ, a_RelStart.x + x, RelY, RelZ, Src[x]);
+				}
+			}
+			if (m_PendingSendBlocks.size() >= MAX_PENDING_SEND_BLOCKS)
+			{
+				m_ShouldResendChunk = true;
+				m_PendingSendBlocks.clear();
+			}
+		}
+	}
+
+	if (IsChanged || (m_SectionLayers[SectionY] == nullptr))
+	{
+		UpdateSectionLayers(SectionY);
+	}
+	return IsChanged;
+}
+
+
+
+
+
+void cChunk::UpdateSectionLayers(const size_t a_SectionY)
+{
+	const auto Section = m_BlockData.GetSection(a_SectionY);
+	if (Section == nullptr)
+	{
+		m_SectionLayers[a_SectionY].reset();
+		return;
+	}
+
+	if (m_SectionLayers[a_SectionY] == nullptr)
+	{
+		m_SectionLayers[a_SectionY] = std::make_unique<cSectionLayers>();
+	}
+	m_SectionLayers[a_SectionY]->Compute(*Section);
+}
+
+
+
+
+
+void cChunk::UpdateHeightMapColumn(const int a_RelX, const int a_RelZ)
+{
+	HEIGHTTYPE Height = 0;
+	for (int SectionY = static_cast<int>(cChunkDef::NumSections) - 1; (SectionY >= 0) && (Height == 0); SectionY--)
+	{
+		const auto Section = m_BlockData.GetSection(static_cast<size_t>(SectionY));
+		if (Section == nullptr)
+		{
+			continue;
+		}
+		for (int y = cChunkDef::SectionHeight - 1; y >= 0; y--)
+		{
+			if (!cBlockAirHandler::IsBlockAir((*Section)[cChunkDef::MakeIndex(a_RelX, y, a_RelZ)]))
+			{
+				Height = static_cast<HEIGHTTYPE>(SectionY * cChunkDef::SectionHeight + y);
+				break;
+			}
+		}
+	}
+	m_HeightMap[static_cast<size_t>(a_RelX + a_RelZ * cChunkDef::Width)] = Height;
+}
+
+
+
+
+
 void cChunk::Stay(bool a_Stay)
 {
 	if (a_Stay)
@@ -677,7 +838,7 @@ void cChunk::SpawnMobs(cMobSpawner & a_MobSpawner)
 			continue;
 		}
 
-		auto newMob = a_MobSpawner.TryToSpawnHere(this, Try, GetBiomeAt(Try.x, Try.z), MaxNbOfSuccess);
+		auto newMob = a_MobSpawner.TryToSpawnHere(Chunk, Try, Chunk->GetBiomeAt(Try.x, Try.z), MaxNbOfSuccess);
 		if (newMob == nullptr)
 		{
 			continue;
@@ -698,11 +859,9 @@ void cChunk::Tick(std::chrono::milliseconds a_Dt)
 {
 	TickBlocks();
 
-	// Tick all block entities in this Chunk:
-	for (auto & KeyPair : m_BlockEntities)
-	{
-		m_IsDirty = KeyPair.second->Tick(a_Dt, *this) | m_IsDirty;
-	}
+	TickBlockEntities(a_Dt);
+
+	TickSimpleBodies(a_Dt);
 
 	for (auto itr = m_Entities.begin(); itr != m_Entities.end();)
 	{
@@ -742,6 +901,10 @@ void cChunk::Tick(std::chrono::milliseconds a_Dt)
 
 			// This block is very similar to RemoveEntity, except it uses an iterator to avoid scanning the whole m_Entities
 			// The entity moved out of the Chunk, move it to the neighbor
+			if ((*itr)->IsPickup())
+			{
+				RemovePickupFromBucket(static_cast<cPickup &>(**itr));
+			}
 			(*itr)->SetParentChunk(nullptr);
 			MoveEntityToNewChunk(std::move(*itr));
 
@@ -753,6 +916,8 @@ void cChunk::Tick(std::chrono::milliseconds a_Dt)
 		}
 	}  // for itr - m_Entitites[]
 
+	CombinePickups();
+
 	ApplyWeatherToTop();
 
 	// Tick simulators:
@@ -766,6 +931,214 @@ void cChunk::Tick(std::chrono::milliseconds a_Dt)
 
 
 
+void cChunk::TickBlockEntities(const std::chrono::milliseconds a_Dt)
+{
+	// Wake up the block entities whose sleep has run out:
+	const auto TickAge = m_World->GetWorldTickAge();
+	while (!m_BlockEntityWakeUps.empty() && (m_BlockEntityWakeUps.top().first <= TickAge))
+	{
+		const auto [WakeUpTick, Index] = m_BlockEntityWakeUps.top();
+		m_BlockEntityWakeUps.pop();
+
+		const auto itr = m_BlockEntities.find(Index);
+		if ((itr != m_BlockEntities.end()) && !itr->second->m_IsAwake && (itr->second->m_WakeUpTick == WakeUpTick))
+		{
+			itr->second->WakeUp();
+		}
+	}
+
+	// Tick the awake block entities. The list may grow while ticking, the ones added are first ticked in the next tick:
+	for (size_t i = 0, Count = m_TickingBlockEntities.size(); i < Count; i++)
+	{
+		const auto BlockEntity = m_TickingBlockEntities[i];
+		if ((BlockEntity != nullptr) && BlockEntity->m_IsAwake)
+		{
+			m_IsDirty = BlockEntity->Tick(a_Dt, *this) | m_IsDirty;
+		}
+	}
+
+	// Drop the destroyed and the sleeping block entities from the list:
+	m_TickingBlockEntities.erase(
+		std::remove_if(m_TickingBlockEntities.begin(), m_TickingBlockEntities.end(), [](cBlockEntity * a_BlockEntity)
+		{
+			if (a_BlockEntity == nullptr)
+			{
+				return true;
+			}
+			if (a_BlockEntity->m_IsAwake)
+			{
+				return false;
+			}
+			a_BlockEntity->m_IsInTickList = false;
+			return true;
+		}),
+		m_TickingBlockEntities.end()
+	);
+}
+
+
+
+
+
+void cChunk::TickSimpleBodies(const std::chrono::milliseconds a_Dt)
+{
+	// The batch is reused by all the chunks ticked by the thread, to keep the memory of its arrays:
+	thread_local cSimpleBodyBatch Batch;
+	thread_local std::vector<cEntity *> Bodies;
+	Batch.Clear();
+	Bodies.clear();
+
+	for (const auto & Entity : m_Entities)
+	{
+		if (Entity->IsTicking() && Entity->AddToPhysicsBatch(Batch, *this))
+		{
+			Bodies.push_back(Entity.get());
+		}
+	}
+	if (Bodies.empty())
+	{
+		return;
+	}
+
+	Batch.Simulate(a_Dt, [this](int a_ChunkX, int a_ChunkZ, size_t a_SectionY, const ChunkBlockData::SectionBitmap *& a_Bitmap)
+	{
+		const auto Chunk = GetNeighborChunk(a_ChunkX * cChunkDef::Width, a_ChunkZ * cChunkDef::Width);
+		if (Chunk == nullptr)
+		{
+			return false;
+		}
+
+		// A chunk without data is empty for the trace, same as for cLineBlockTracer:
+		if (!Chunk->IsValid())
+		{
+			a_Bitmap = nullptr;
+			return true;
+		}
+		a_Bitmap = &Chunk->GetSectionLayers(a_SectionY).GetLayer(eBlockLayer::Solid);
+		return true;
+	});
+
+	for (size_t i = 0; i < Bodies.size(); i++)
+	{
+		Bodies[i]->ApplyPhysicsBatch(Batch, i);
+	}
+}
+
+
+
+
+
+void cChunk::AddPickupToBucket(cPickup & a_Pickup)
+{
+	m_PickupBuckets[a_Pickup.GetItem().m_ItemType].push_back(&a_Pickup);
+}
+
+
+
+
+
+void cChunk::RemovePickupFromBucket(cPickup & a_Pickup)
+{
+	const auto RemoveFrom = [&a_Pickup](std::vector<cPickup *> & a_Bucket)
+	{
+		const auto itr = std::find(a_Bucket.begin(), a_Bucket.end(), &a_Pickup);
+		if (itr == a_Bucket.end())
+		{
+			return false;
+		}
+		*itr = a_Bucket.back();
+		a_Bucket.pop_back();
+		return true;
+	};
+
+	// The pickup is normally in the bucket of its item type:
+	const auto Bucket = m_PickupBuckets.find(a_Pickup.GetItem().m_ItemType);
+	if ((Bucket != m_PickupBuckets.end()) && RemoveFrom(Bucket->second))
+	{
+		return;
+	}
+
+	// A plugin has changed the item type since the pickup was bucketed:
+	for (auto & OtherBucket : m_PickupBuckets)
+	{
+		if (RemoveFrom(OtherBucket.second))
+		{
+			return;
+		}
+	}
+	ASSERT(!"Pickup not found in the chunk's buckets");
+}
+
+
+
+
+
+void cChunk::CombinePickups(void)
+{
+	std::vector<cPickup *> Rebucketed;
+	for (auto & [ItemType, Bucket] : m_PickupBuckets)
+	{
+		// Move out the pickups whose item type has been changed by a plugin:
+		for (size_t i = 0; i < Bucket.size();)
+		{
+			if (Bucket[i]->GetItem().m_ItemType != ItemType)
+			{
+				Rebucketed.push_back(Bucket[i]);
+				Bucket[i] = Bucket.back();
+				Bucket.pop_back();
+			}
+			else
+			{
+				i++;
+			}
+		}
+
+		if (Bucket.size() < 2)
+		{
+			// Nothing to combine with; a lone pickup will be compared with the next one to come:
+			for (const auto Pickup : Bucket)
+			{
+				Pickup->StopTryingCombining();
+			}
+			continue;
+		}
+
+		// Compare the pickups that have moved or changed with all the others in the bucket; the one with the lower ID receives the items:
+		for (const auto Pickup : Bucket)
+		{
+			if (!Pickup->ShouldTryCombining())
+			{
+				continue;
+			}
+			Pickup->StopTryingCombining();
+			for (const auto Other : Bucket)
+			{
+				if (Other == Pickup)
+				{
+					continue;
+				}
+				if (Pickup->GetUniqueID() < Other->GetUniqueID())
+				{
+					Pickup->TryCombineWith(*Other);
+				}
+				else
+				{
+					Other->TryCombineWith(*Pickup);
+				}
+			}
+		}
+	}
+
+	for (const auto Pickup : Rebucketed)
+	{
+		AddPickupToBucket(*Pickup);
+	}
+}
+
+
+
+
+
 void cChunk::TickBlock(const Vector3i a_RelPos)
 {
 	cChunkInterface ChunkInterface(this->GetWorld()->GetChunkMap());
@@ -1249,8 +1622,12 @@ void cChunk::SetBlock(Vector3i a_RelPos, BlockState a_Block)
 		BlockEntity.Destroy();
 		BlockEntity.OnRemoveFromWorld();
 
-		m_BlockEntities.erase(FindResult);
+		if (BlockEntity.m_IsInTickList)
+		{
+			std::replace(m_TickingBlockEntities.begin(), m_TickingBlockEntities.end(), &BlockEntity, static_cast<cBlockEntity *>(nullptr));
+		}
 		m_PendingSendBlockEntities.erase(std::remove(m_PendingSendBlockEntities.begin(), m_PendingSendBlockEntities.end(), &BlockEntity), m_PendingSendBlockEntities.end());
+		m_BlockEntities.erase(FindResult);
 	}
 
 	// If the new block is a block entity, create the entity object:
@@ -1287,6 +1664,17 @@ void cChunk::FastSetBlock(int a_RelX, int a_RelY, int a_RelZ, BlockState a_Block
 
 	m_BlockData.SetBlock({ a_RelX, a_RelY, a_RelZ }, a_Block);
 
+	// Keep the section's layers in sync; a section allocated just now gets all of its layers computed:
+	const auto SectionY = static_cast<size_t>(a_RelY / cChunkDef::SectionHeight);
+	if (m_SectionLayers[SectionY] != nullptr)
+	{
+		m_SectionLayers[SectionY]->SetBlock(cChunkDef::MakeIndex(a_RelX, a_RelY % cChunkDef::SectionHeight, a_RelZ), a_Block);
+	}
+	else
+	{
+		UpdateSectionLayers(SectionY);
+	}
+
 	// Queue block to be sent only if ...
 	if (
 		!(cBlockLeavesHandler::IsBlockLeaves(OldBlock) && cBlockLeavesHandler::IsBlockLeaves(a_Block)) &&  // ... the old and new blocktypes AREN'T leaves (because the client doesn't need meta updates)
@@ -1371,6 +1759,10 @@ void cChunk::AddBlockEntity(OwnedBlockEntity a_BlockEntity)
 
 	ASSERT(Result.second);  // No block entity already at this position.
 	BlockEntityPtr->OnAddToWorld(*m_World, *this);
+
+	// Let the new block entity look around, and the hoppers around it see the new container:
+	BlockEntityPtr->WakeUp();
+	BlockEntityPtr->WakeUpNeighbors();
 }
 
 
@@ -1406,6 +1798,27 @@ cBlockEntity * cChunk::GetBlockEntityRel(Vector3i a_RelPos)
 
 
 
+void cChunk::AddTickingBlockEntity(cBlockEntity & a_BlockEntity)
+{
+	ASSERT(!a_BlockEntity.m_IsInTickList);
+
+	a_BlockEntity.m_IsInTickList = true;
+	m_TickingBlockEntities.push_back(&a_BlockEntity);
+}
+
+
+
+
+
+void cChunk::ScheduleBlockEntityWakeUp(cBlockEntity & a_BlockEntity, const cTickTimeLong a_WakeUpTick)
+{
+	m_BlockEntityWakeUps.emplace(a_WakeUpTick, cChunkDef::MakeIndex(a_BlockEntity.GetRelPos()));
+}
+
+
+
+
+
 bool cChunk::ShouldBeTicked(void) const
 {
 	return IsValid() && (HasAnyClients() || (m_AlwaysTicked > 0));
@@ -1555,6 +1968,11 @@ void cChunk::AddEntity(OwnedEntity a_Entity)
 
 	ASSERT(EntityPtr->GetParentChunk() == nullptr);
 	EntityPtr->SetParentChunk(this);
+
+	if (EntityPtr->IsPickup())
+	{
+		AddPickupToBucket(static_cast<cPickup &>(*EntityPtr));
+	}
 }
 
 
@@ -1573,6 +1991,11 @@ OwnedEntity cChunk::RemoveEntity(cEntity & a_Entity)
 		MarkDirty();
 	}
 
+	if (a_Entity.IsPickup())
+	{
+		RemovePickupFromBucket(static_cast<cPickup &>(a_Entity));
+	}
+
 	OwnedEntity Removed;
 	m_Entities.erase(
 		std::remove_if(
@@ -1708,6 +2131,9 @@ bool cChunk::DoWithBlockEntityAt(Vector3i a_Position, cBlockEntityCallback a_Cal
 
 	const bool Result = a_Callback(*BlockEntity);
 	m_PendingSendBlockEntities.push_back(BlockEntity);
+
+	// The callback may have given the block entity some work:
+	BlockEntity->WakeUp();
 	MarkDirty();
 	return Result;
 }
@@ -3,6 +3,7 @@
 
 #include "BlockEntities/BlockEntity.h"
 #include "ChunkData.h"
+#include "ChunkLayers.h"
 
 #include "Simulator/FireSimulator.h"
 #include "Simulator/SandSimulator.h"
@@ -24,6 +25,7 @@ class cBlockArea;
 class cFluidSimulatorData;
 class cMobCensus;
 class cMobSpawner;
+class cPickup;
 class cRedstoneSimulatorChunkData;
 
 struct SetChunkData;
@@ -109,7 +111,9 @@ public:
 		const cChunkDef::LightNibbles & a_SkyLight
 	);
 
-	/** Writes the specified cBlockArea at the coords specified. Note that the coords may extend beyond the chunk! */
+	/** Writes the specified cBlockArea at the coords specified. Note that the coords may extend beyond the chunk!
+	The blocks are copied row by row into whole sections, the heightmap is updated once per column
+	and a large change resends the whole chunk to the clients instead of the individual blocks. */
 	void WriteBlockArea(cBlockArea & a_Area, int a_MinBlockX, int a_MinBlockY, int a_MinBlockZ, int a_DataTypes);
 
 	/** Sets or resets the internal flag that prevents chunk from being unloaded.
@@ -387,6 +391,16 @@ public:
 	Asserts that the position is a valid relative position. */
 	cBlockEntity * GetBlockEntityRel(Vector3i a_RelPos);
 
+	/** Adds the (awake) block entity to the list of block entities ticked in each Tick(). Used by cBlockEntity::WakeUp(). */
+	void AddTickingBlockEntity(cBlockEntity & a_BlockEntity);
+
+	/** Schedules the (sleeping) block entity to be woken up once the world's tick age reaches a_WakeUpTick.
+	Used by cBlockEntity::SleepFor(). */
+	void ScheduleBlockEntityWakeUp(cBlockEntity & a_BlockEntity, cTickTimeLong a_WakeUpTick);
+
+	/** Returns the number of block entities that are awake, i.e. ticked in each Tick(). */
+	size_t GetNumTickingBlockEntities(void) const { return m_TickingBlockEntities.size(); }
+
 	/** Returns true if the chunk should be ticked in the tick-thread.
 	Checks if there are any clients and if the always-tick flag is set */
 	bool ShouldBeTicked(void) const;
@@ -413,6 +427,22 @@ public:
 	/** Returns true if slimes should spawn in the chunk. */
 	bool IsSlimeChunk() const;
 
+	/** Returns the derived block layers of the specified section, kept in sync with its blocks.
+	A section without any blocks reports the layers of all air. */
+	const cSectionLayers & GetSectionLayers(size_t a_SectionY) const
+	{
+		const auto & Layers = m_SectionLayers[a_SectionY];
+		return (Layers == nullptr) ? cSectionLayers::AllAir() : *Layers;
+	}
+
+	/** Returns true if the block at the specified relative coords is in the layer.
+	Doesn't check relative coord validity. */
+	bool IsBlockInLayer(Vector3i a_RelPos, eBlockLayer a_Layer) const
+	{
+		const auto SectionY = static_cast<size_t>(a_RelPos.y / cChunkDef::SectionHeight);
+		return GetSectionLayers(SectionY).Test(a_Layer, cChunkDef::MakeIndex(a_RelPos.x, a_RelPos.y % cChunkDef::SectionHeight, a_RelPos.z));
+	}
+
 private:
 
 	friend class cChunkMap;
@@ -439,6 +469,10 @@ private:
 	bool m_IsLightValid;   // True if the blocklight and skylight are calculated
 	bool m_IsDirty;        // True if the chunk has changed since it was last saved
 	bool m_IsSaving;       // True if the chunk is being saved
+	bool m_ShouldResendChunk;  // True if the whole chunk is to be resent to the clients in BroadcastPendingChanges(), instead of m_PendingSendBlocks
+
+	/** The number of pending block changes above which the whole chunk is resent instead. */
+	static constexpr size_t MAX_PENDING_SEND_BLOCKS = 10240;
 
 	/** Blocks that have changed and need to be sent to all clients.
 	The protocol has a provision for coalescing block changes, and this is the buffer.
@@ -450,6 +484,18 @@ private:
 	Pointers to block entities that were destroyed are guaranteed to be removed from this array by SetAllData, SetBlock, WriteBlockArea. */
 	std::vector<cBlockEntity *> m_PendingSendBlockEntities;
 
+	/** The awake block entities, ticked in each Tick(); the sleeping ones are dropped from the list at the end of the tick.
+	Pointers to block entities that were destroyed are replaced with nullptr by SetBlock and WriteBlockArea, and cleared by SetAllData. */
+	std::vector<cBlockEntity *> m_TickingBlockEntities;
+
+	/** The block entities sleeping for a set time, as (wake-up tick age, block index) pairs, the earliest on top.
+	An entry is stale, and ignored, if its block entity has been destroyed, woken up, or rescheduled since. */
+	std::priority_queue<
+		std::pair<cTickTimeLong, size_t>,
+		std::vector<std::pair<cTickTimeLong, size_t>>,
+		std::greater<std::pair<cTickTimeLong, size_t>>
+	> m_BlockEntityWakeUps;
+
 	/** A queue of relative positions to call cBlockHandler::Check on.
 	Processed at the end of each tick by CheckBlocks. */
 	std::queue<Vector3i> m_BlocksToCheck;
@@ -459,6 +505,10 @@ private:
 	std::vector<OwnedEntity> m_Entities;
 	cBlockEntities m_BlockEntities;
 
+	/** The pickups among m_Entities, in buckets by their item type.
+	The combining pass in each tick only compares the pickups within a bucket, since only those may combine. */
+	std::unordered_map<Item, std::vector<cPickup *>> m_PickupBuckets;
+
 	/** Number of times the chunk has been requested to stay (by various cChunkStay objects); if zero, the chunk can be unloaded */
 	unsigned m_StayCount;
 
@@ -469,6 +519,10 @@ private:
 	ChunkBlockData m_BlockData;
 	ChunkLightData m_LightData;
 
+	/** The derived block layers of each section of m_BlockData, nullptr for the sections that aren't allocated.
+	Recomputed whenever a whole section is written, updated block by block in FastSetBlock(). */
+	std::unique_ptr<cSectionLayers> m_SectionLayers[cChunkDef::NumSections];
+
 	cChunkDef::HeightMap m_HeightMap;
 	cChunkDef::BiomeMap  m_BiomeMap;
 
@@ -503,6 +557,35 @@ private:
 	/** Wakes up each simulator for its specific blocks; through all the blocks in the chunk */
 	void WakeUpSimulators(void);
 
+	/** Wakes up the block entities whose sleep has run out, and ticks the awake ones. */
+	void TickBlockEntities(std::chrono::milliseconds a_Dt);
+
+	/** Moves all the simple bodies among the entities - pickups, experience orbs, primed TNT and falling blocks - at once,
+	before the entities are ticked. See cSimpleBodyBatch. */
+	void TickSimpleBodies(std::chrono::milliseconds a_Dt);
+
+	/** Adds the pickup to m_PickupBuckets, under its current item type. */
+	void AddPickupToBucket(cPickup & a_Pickup);
+
+	/** Removes the pickup from m_PickupBuckets. */
+	void RemovePickupFromBucket(cPickup & a_Pickup);
+
+	/** Combines the pickups that have moved or changed since the last tick with the close same-item pickups.
+	Pickups at rest are not compared with each other, they have already been. */
+	void CombinePickups(void);
+
+	/** Copies the blocks of a box that lies within a single section from a_Area into m_BlockData, a row at a time.
+	a_AreaStart is the box's start in a_Area, a_RelStart is its start in the chunk.
+	Queues the changed blocks for sending, switching to resending the whole chunk when there are too many of them.
+	Returns true if any block has changed. */
+	bool WriteBlockAreaSection(const cBlockArea & a_Area, Vector3i a_AreaStart, Vector3i a_RelStart, Vector3i a_Size);
+
+	/** Recomputes m_SectionLayers of the specified section from its blocks. */
+	void UpdateSectionLayers(size_t a_SectionY);
+
+	/** Sets the heightmap of the specified column to its topmost non-air block. */
+	void UpdateHeightMapColumn(int a_RelX, int a_RelZ);
+
 	/** Checks the block scheduled for checking in m_ToTickBlocks[] */
 	void CheckBlocks();
 
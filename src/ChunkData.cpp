@@ -45,6 +45,9 @@ namespace
 
 		return DefaultValue;
 	}
+
+	/** The source of the section revisions handed out by ChunkBlockData::Assign(). */
+	std::atomic<UInt64> g_NextSectionRevision{1};
 }  // namespace (anonymous)
 
 
@@ -54,14 +57,19 @@ namespace
 template<class ElementType, size_t ElementCount>
 void ChunkDataStore<ElementType, ElementCount>::Assign(const ChunkDataStore<ElementType, ElementCount> & a_Other)
 {
-	for (size_t Y = 0; Y != cChunkDef::NumSections; Y++)
-	{
-		Store[Y].reset();
+	std::copy(std::begin(a_Other.Store), std::end(a_Other.Store), std::begin(Store));
+}
 
-		if (const auto & Other = a_Other.Store[Y]; Other != nullptr)
-		{
-			Store[Y] = std::make_unique<Type>(*Other);
-		}
+
+
+
+
+template<class ElementType, size_t ElementCount>
+void ChunkDataStore<ElementType, ElementCount>::Clear(void)
+{
+	for (auto & Section : Store)
+	{
+		Section.reset();
 	}
 }
 
@@ -95,7 +103,7 @@ ElementType ChunkDataStore<ElementType, ElementCount>::Get(const Vector3i a_Posi
 
 
 template<class ElementType, size_t ElementCount>
-typename ChunkDataStore<ElementType, ElementCount>::Type * ChunkDataStore<ElementType, ElementCount>::GetSection(const size_t a_Y) const
+const typename ChunkDataStore<ElementType, ElementCount>::Type * ChunkDataStore<ElementType, ElementCount>::GetSection(const size_t a_Y) const
 {
 	return Store[a_Y].get();
 }
@@ -104,6 +112,25 @@ typename ChunkDataStore<ElementType, ElementCount>::Type * ChunkDataStore<Elemen
 
 
 
+template<class ElementType, size_t ElementCount>
+typename ChunkDataStore<ElementType, ElementCount>::Type & ChunkDataStore<ElementType, ElementCount>::GetSectionForOverwrite(const size_t a_Y)
+{
+	auto & Section = Store[a_Y];
+	if (Section == nullptr)
+	{
+		Section = cpp20::make_unique_for_overwrite<Type>();
+	}
+	else
+	{
+		Unshare(Section);
+	}
+	return *Section;
+}
+
+
+
+
+
 template<class ElementType, size_t ElementCount>
 void ChunkDataStore<ElementType, ElementCount>::Set(const Vector3i a_Position, const ElementType a_Value)
 {
@@ -120,6 +147,10 @@ void ChunkDataStore<ElementType, ElementCount>::Set(const Vector3i a_Position, c
 		Section = cpp20::make_unique_for_overwrite<Type>();
 		std::fill(Section->begin(), Section->end(), DefaultValue);
 	}
+	else
+	{
+		Unshare(Section);
+	}
 
 	if (IsCompressed(ElementCount))
 	{
@@ -143,6 +174,11 @@ void ChunkDataStore<ElementType, ElementCount>::SetSection(const ElementType (&
 
 	if (Section != nullptr)
 	{
+		// The whole section is overwritten, a shared one is replaced rather than cloned:
+		if (IsShared(Section))
+		{
+			Section = cpp20::make_unique_for_overwrite<Type>();
+		}
 		std::copy(a_Source, SourceEnd, Section->begin());
 	}
 	else if (std::any_of(a_Source, SourceEnd, [&](const auto Value) { return Value != DefaultValue; }))
@@ -169,8 +205,48 @@ void ChunkDataStore<ElementType, ElementCount>::SetAll(const ElementType (& a_So
 
 
 
+template<class ElementType, size_t ElementCount>
+bool ChunkDataStore<ElementType, ElementCount>::IsShared(const std::shared_ptr<Type> & a_Section)
+{
+	// Sections are only shared by Assign(), which reads the source under the same lock as the writes into it,
+	// so no new sharer can appear here. A sharer may drop its reference meanwhile, then the section is cloned needlessly:
+	if (a_Section.use_count() > 1)
+	{
+		return true;
+	}
+
+	// Make sure the reads of the last sharer, who has released the section, are done before the writes that follow:
+	std::atomic_thread_fence(std::memory_order_acquire);
+	return false;
+}
+
+
+
+
+
+template<class ElementType, size_t ElementCount>
+void ChunkDataStore<ElementType, ElementCount>::Unshare(std::shared_ptr<Type> & a_Section)
+{
+	if (IsShared(a_Section))
+	{
+		a_Section = std::make_shared<Type>(*a_Section);
+	}
+}
+
+
+
+
+
 void ChunkBlockData::Assign(const ChunkBlockData & a_Other)
 {
+	for (auto & Revision : a_Other.m_Revisions)
+	{
+		if (Revision == 0)
+		{
+			Revision = g_NextSectionRevision++;
+		}
+	}
+	m_Revisions = a_Other.m_Revisions;
 	m_Blocks.Assign(a_Other.m_Blocks);
 }
 
@@ -178,8 +254,19 @@ void ChunkBlockData::Assign(const ChunkBlockData & a_Other)
 
 
 
+void ChunkBlockData::Clear(void)
+{
+	m_Revisions.fill(0);
+	m_Blocks.Clear();
+}
+
+
+
+
+
 void ChunkBlockData::SetAll(const cChunkDef::BlockStates & a_BlockSource)
 {
+	m_Revisions.fill(0);
 	m_Blocks.SetAll(a_BlockSource);
 }
 
@@ -189,6 +276,7 @@ void ChunkBlockData::SetAll(const cChunkDef::BlockStates & a_BlockSource)
 
 void ChunkBlockData::SetSection(const SectionType & a_BlockSource, const size_t a_Y)
 {
+	m_Revisions[a_Y] = 0;
 	m_Blocks.SetSection(a_BlockSource, a_Y);
 }
 
@@ -206,6 +294,16 @@ void ChunkLightData::Assign(const ChunkLightData & a_Other)
 
 
 
+void ChunkLightData::Clear(void)
+{
+	m_BlockLights.Clear();
+	m_SkyLights.Clear();
+}
+
+
+
+
+
 void ChunkLightData::SetAll(const cChunkDef::LightNibbles & a_BlockLightSource, const cChunkDef::LightNibbles & a_SkyLightSource)
 {
 	m_BlockLights.SetAll(a_BlockLightSource);
@@ -16,6 +16,10 @@
 
 
 
+/** The storage of one kind of per-block data of a chunk, in separately allocated sections.
+The sections are reference-counted and copy-on-write: Assign() only shares the sections of the source,
+and whichever store then writes into a shared section clones it first. A copy is therefore a snapshot
+that costs a pointer copy per section and never changes, no matter what is written into the source later. */
 template <class ElementType, size_t ElementCount>
 struct ChunkDataStore
 {
@@ -23,16 +27,24 @@ struct ChunkDataStore
 
 	ChunkDataStore(ElementType a_DefaultValue) : DefaultValue(a_DefaultValue) {}
 
-	/** Copy assign from another ChunkDataStore. */
+	/** Copy assign from another ChunkDataStore, sharing its sections. */
 	void Assign(const ChunkDataStore<ElementType, ElementCount> & a_Other);
 
+	/** Releases all sections, as if none were allocated. */
+	void Clear(void);
+
 	/** Gets one value at the given position.
 	Returns DefaultValue if the section is not allocated. */
 	ElementType Get(Vector3i a_Position) const;
 
 	/** Returns a raw pointer to the internal representation of the specified section.
-	Will be nullptr if the section is not allocated. */
-	Type * GetSection(size_t a_Y) const;
+	Will be nullptr if the section is not allocated. The section may be shared with other stores, so it is read-only. */
+	const Type * GetSection(size_t a_Y) const;
+
+	/** Returns the specified section so that the caller can write its values directly.
+	Allocates the section if needed; the contents of a newly allocated section are unspecified.
+	Clones the section first if it is shared with another store. */
+	Type & GetSectionForOverwrite(size_t a_Y);
 
 	/** Sets one value at the given position.
 	Allocates a section if needed for the operation. */
@@ -46,9 +58,17 @@ struct ChunkDataStore
 	Allocates sections that are needed for the operation. */
 	void SetAll(const ElementType (& a_Source)[cChunkDef::NumSections * ElementCount]);
 
-	/** Contains all the sections this ChunkDataStore manages. */
-	std::unique_ptr<Type> Store[cChunkDef::NumSections];
+	/** Contains all the sections this ChunkDataStore manages, possibly shared with other stores. */
+	std::shared_ptr<Type> Store[cChunkDef::NumSections];
 	ElementType DefaultValue;
+
+private:
+
+	/** Returns true if the section is shared with another store; if not, it can be written into. */
+	static bool IsShared(const std::shared_ptr<Type> & a_Section);
+
+	/** Clones the section if it is shared with another store, so that it can be written into. */
+	void Unshare(std::shared_ptr<Type> & a_Section);
 };
 
 
@@ -69,6 +89,9 @@ public:
 	using SectionType = BlockState[SectionBlockCount];
 	using SectionMetaType = unsigned char[SectionMetaCount];
 
+	/** One bit per block of a section, in the same order as the blocks: each word holds four consecutive rows of 16 blocks along X. */
+	using SectionBitmap = std::array<UInt64, SectionBlockCount / 64>;
+
 private:
 
 	ChunkDataStore<BlockState, SectionBlockCount> m_Blocks;
@@ -77,16 +100,43 @@ public:
 
 	using BlockArray = decltype(m_Blocks)::Type;
 
+	/** Assigns a snapshot of the other data: only shares its sections, see ChunkDataStore. */
 	void Assign(const ChunkBlockData & a_Other);
 
+	/** Releases all sections, dropping the snapshot's references. */
+	void Clear(void);
+
 	BlockState GetBlock(Vector3i a_Position) const { return m_Blocks.Get(a_Position); }
 
-	BlockArray * GetSection(size_t a_Y) const { return m_Blocks.GetSection(a_Y); }
+	const BlockArray * GetSection(size_t a_Y) const { return m_Blocks.GetSection(a_Y); }
+
+	/** Returns the specified section for the caller to overwrite completely, allocating it if needed.
+	Used by decoders that produce a whole section at once, to avoid an intermediate copy. */
+	BlockArray & GetSectionForOverwrite(size_t a_Y)
+	{
+		m_Revisions[a_Y] = 0;
+		return m_Blocks.GetSectionForOverwrite(a_Y);
+	}
 
-	void SetBlock(Vector3i a_Position, BlockState a_Block) { m_Blocks.Set(a_Position, a_Block); }
+	/** Returns a number identifying the current contents of the specified section, or 0 if the section has been modified since it was last copied.
+	Assign() gives each modified section of the source a new, globally unique revision and copies the revisions along with the data,
+	so that whatever is computed from a copied section can be cached by its revision. */
+	UInt64 GetSectionRevision(size_t a_Y) const { return m_Revisions[a_Y]; }
+
+	void SetBlock(Vector3i a_Position, BlockState a_Block)
+	{
+		m_Revisions[static_cast<size_t>(a_Position.y) / cChunkDef::SectionHeight] = 0;
+		m_Blocks.Set(a_Position, a_Block);
+	}
 
 	void SetAll(const cChunkDef::BlockStates & a_BlockSource);
 	void SetSection(const SectionType & a_BlockSource, size_t a_Y);
+
+private:
+
+	/** The revision of each section, as returned by GetSectionRevision().
+	Mutable because Assign() assigns the revisions of the source it copies from. */
+	mutable std::array<UInt64, cChunkDef::NumSections> m_Revisions{};
 };
 
 
@@ -115,13 +165,17 @@ public:
 
 	using LightArray = decltype(m_BlockLights)::Type;
 
+	/** Assigns a snapshot of the other data: only shares its sections, see ChunkDataStore. */
 	void Assign(const ChunkLightData & a_Other);
 
+	/** Releases all sections, dropping the snapshot's references. */
+	void Clear(void);
+
 	LIGHTTYPE GetBlockLight(Vector3i a_Position) const { return m_BlockLights.Get(a_Position); }
 	LIGHTTYPE GetSkyLight(Vector3i a_Position) const { return m_SkyLights.Get(a_Position); }
 
-	LightArray * GetBlockLightSection(size_t a_Y) const { return m_BlockLights.GetSection(a_Y); }
-	LightArray * GetSkyLightSection(size_t a_Y) const { return m_SkyLights.GetSection(a_Y); }
+	const LightArray * GetBlockLightSection(size_t a_Y) const { return m_BlockLights.GetSection(a_Y); }
+	const LightArray * GetSkyLightSection(size_t a_Y) const { return m_SkyLights.GetSection(a_Y); }
 
 	void SetAll(const cChunkDef::LightNibbles & a_BlockLightSource, const cChunkDef::LightNibbles & a_SkyLightSource);
 	void SetSection(const SectionType & a_BlockLightSource, const SectionType & a_SkyLightSource, size_t a_Y);
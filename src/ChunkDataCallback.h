@@ -15,6 +15,13 @@
 
 
 
+// fwd: ChunkLayers.h
+class cSectionLayers;
+
+
+
+
+
 /** Interface class used for getting data out of a chunk using the GetAllData() function.
 Implementation must use the pointers immediately and NOT store any of them for later use
 The virtual methods are called in the same order as they're declared here. */
@@ -35,6 +42,9 @@ public:
 	/** Called once to export block data. */
 	virtual void ChunkData(const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData) { UNUSED(a_BlockData); UNUSED(a_LightData); }
 
+	/** Called for each section that has blocks, to export its derived block layers (cSectionLayers). */
+	virtual void SectionLayers(size_t a_SectionY, const cSectionLayers & a_Layers) { UNUSED(a_SectionY); UNUSED(a_Layers); }
+
 	/** Called once to provide heightmap data. */
 	virtual void HeightMap(const cChunkDef::HeightMap & a_HeightMap) { UNUSED(a_HeightMap); }
 
@@ -51,7 +61,9 @@ public:
 
 
 
-/** A simple implementation of the cChunkDataCallback interface that just copies the cChunkData */
+/** A simple implementation of the cChunkDataCallback interface that just copies the cChunkData.
+The copy is a copy-on-write snapshot that only shares the chunk's sections, so it is cheap to take while the chunk is locked,
+and can be read without the lock afterwards. Holding it makes the chunk clone each section it writes into, so it is to be released soon. */
 class cChunkDataCopyCollector :
 	public cChunkDataCallback
 {
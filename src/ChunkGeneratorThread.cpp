@@ -2,6 +2,7 @@
 #include "ChunkGeneratorThread.h"
 #include "Generating/ChunkGenerator.h"
 #include "Generating/ChunkDesc.h"
+#include "IniFile.h"
 
 
 
@@ -13,13 +14,89 @@ const size_t QUEUE_WARNING_LIMIT = 1000;
 /** If the generation queue size exceeds this number, chunks with no clients will be skipped */
 const size_t QUEUE_SKIP_LIMIT = 500;
 
+/** The maximum number of generator threads allowed in the [Generator] NumThreads setting. */
+const int MAX_GENERATOR_THREADS = 32;
 
+/** Chunks are assigned to the generator threads in square regions of (1 << REGION_SHIFT) chunks per side. */
+const int REGION_SHIFT = 3;
 
+/** How many queue items a worker checks for a chunk in its own regions, before taking the front item instead. */
+const size_t REGION_SEARCH_LIMIT = 64;
 
+/** How long the generator threads sleep when the queue is empty, before checking whether they should terminate. */
+const unsigned IDLE_WAIT_MSEC = 100;
+
+
+
+
+
+/** Returns the index of the generator thread that prefers the specified chunk. */
+static size_t GetRegionWorker(cChunkCoords a_Coords, size_t a_NumThreads)
+{
+	auto RegionX = static_cast<UInt32>(a_Coords.m_ChunkX >> REGION_SHIFT);
+	auto RegionZ = static_cast<UInt32>(a_Coords.m_ChunkZ >> REGION_SHIFT);
+	return ((RegionX * 0x9e3779b1u) ^ (RegionZ * 0x85ebca77u)) % a_NumThreads;
+}
+
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// cChunkGeneratorThread::cWorker:
+
+/** An additional generator thread, processing the parent's queue with its own generator instance. */
+class cChunkGeneratorThread::cWorker :
+	public cIsThread
+{
+	using Super = cIsThread;
+
+public:
+
+	cWorker(cChunkGeneratorThread & a_Parent, std::unique_ptr<cChunkGenerator> a_Generator, size_t a_Index) :
+		Super(fmt::format(FMT_STRING("Chunk Generator #{}"), a_Index)),
+		m_Parent(a_Parent),
+		m_Generator(std::move(a_Generator)),
+		m_Index(a_Index)
+	{
+	}
+
+	const cChunkGenerator & GetGenerator(void) const { return *m_Generator; }
+
+	void Stop(void)
+	{
+		m_ShouldTerminate = true;
+		m_Parent.m_Event.SetAll();
+		Super::Stop();
+	}
+
+protected:
+
+	cChunkGeneratorThread & m_Parent;
+
+	std::unique_ptr<cChunkGenerator> m_Generator;
+
+	size_t m_Index;
+
+
+	// cIsThread override:
+	virtual void Execute(void) override
+	{
+		m_Parent.ProcessQueue(*m_Generator, m_Index, m_ShouldTerminate);
+	}
+} ;
+
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// cChunkGeneratorThread:
 
 cChunkGeneratorThread::cChunkGeneratorThread(void) :
 	Super("Chunk Generator"),
 	m_Generator(nullptr),
+	m_NumChunksGenerated(0),
 	m_PluginInterface(nullptr),
 	m_ChunkSink(nullptr)
 {
@@ -49,6 +126,24 @@ bool cChunkGeneratorThread::Initialize(cPluginInterface & a_PluginInterface, cCh
 		LOGERROR("Generator could not start, aborting the server");
 		return false;
 	}
+
+	// Each additional thread gets a generator of its own, so that the generator caches need no locking:
+	int NumThreads = Clamp(a_IniFile.GetValueSetI("Generator", "NumThreads", 1), 1, MAX_GENERATOR_THREADS);
+	m_Workers.clear();
+	for (int i = 1; i < NumThreads; i++)
+	{
+		auto Generator = cChunkGenerator::CreateFromIniFile(a_IniFile);
+		if (Generator == nullptr)
+		{
+			LOGERROR("Generator could not start, aborting the server");
+			return false;
+		}
+		m_Workers.push_back(std::make_unique<cWorker>(*this, std::move(Generator), static_cast<size_t>(i)));
+	}
+	if (NumThreads > 1)
+	{
+		LOGD("Using %d chunk generator threads", NumThreads);
+	}
 	return true;
 }
 
@@ -59,9 +154,16 @@ bool cChunkGeneratorThread::Initialize(cPluginInterface & a_PluginInterface, cCh
 void cChunkGeneratorThread::Stop(void)
 {
 	m_ShouldTerminate = true;
-	m_Event.Set();
+	m_Event.SetAll();
 	m_evtRemoved.Set();  // Wake up anybody waiting for empty queue
 	Super::Stop();
+
+	// The workers are started by this thread, so now that it has finished, no new ones can be started:
+	for (auto & Worker : m_Workers)
+	{
+		Worker->Stop();
+	}
+	m_Workers.clear();
 	m_Generator.reset();
 }
 
@@ -140,6 +242,25 @@ int cChunkGeneratorThread::GetSeed() const
 
 
 
+cGenCacheStatsMap cChunkGeneratorThread::GetCacheStats(void) const
+{
+	cGenCacheStatsMap Res;
+	if (m_Generator == nullptr)
+	{
+		return Res;
+	}
+	m_Generator->GetCacheStats(Res);
+	for (const auto & Worker : m_Workers)
+	{
+		Worker->GetGenerator().GetCacheStats(Res);
+	}
+	return Res;
+}
+
+
+
+
+
 EMCSBiome cChunkGeneratorThread::GetBiomeAt(int a_BlockX, int a_BlockZ)
 {
 	ASSERT(m_Generator != nullptr);
@@ -151,51 +272,64 @@ EMCSBiome cChunkGeneratorThread::GetBiomeAt(int a_BlockX, int a_BlockZ)
 
 
 void cChunkGeneratorThread::Execute(void)
+{
+	// Start the additional workers, they share the queue with this thread:
+	for (auto & Worker : m_Workers)
+	{
+		Worker->Start();
+	}
+
+	ProcessQueue(*m_Generator, 0, m_ShouldTerminate);
+}
+
+
+
+
+
+void cChunkGeneratorThread::ProcessQueue(cChunkGenerator & a_Generator, size_t a_WorkerIndex, const std::atomic<bool> & a_ShouldTerminate)
 {
 	// To be able to display performance information, the generator counts the chunks generated.
 	// When the queue gets empty, the count is reset, so that waiting for the queue is not counted into the total time.
-	int NumChunksGenerated = 0;  // Number of chunks generated since the queue was last empty
+	// Only the first thread reports, the count includes the chunks generated by all the threads.
+	bool ShouldReport = (a_WorkerIndex == 0);
 	clock_t GenerationStart = clock();  // Clock tick when the queue started to fill
 	clock_t LastReportTick = clock();  // Clock tick of the last report made (so that performance isn't reported too often)
 
-	while (!m_ShouldTerminate)
+	while (!a_ShouldTerminate)
 	{
 		cCSLock Lock(m_CS);
 		while (m_Queue.empty())
 		{
-			if ((NumChunksGenerated > 16) && (clock() - LastReportTick > CLOCKS_PER_SEC))
-			{
-				/* LOG("Chunk generator performance: %.2f ch / sec (%d ch total)",
-					static_cast<double>(NumChunksGenerated) * CLOCKS_PER_SEC/ (clock() - GenerationStart),
-					NumChunksGenerated
-				); */
-			}
 			cCSUnlock Unlock(Lock);
-			m_Event.Wait();
-			if (m_ShouldTerminate)
+			m_Event.Wait(IDLE_WAIT_MSEC);
+			if (a_ShouldTerminate)
 			{
 				return;
 			}
-			NumChunksGenerated = 0;
-			GenerationStart = clock();
-			LastReportTick = clock();
-		}
-
-		if (m_Queue.empty())
-		{
-			// Sometimes the queue remains empty
-			// If so, we can't do any front() operations on it!
-			continue;
+			if (ShouldReport)
+			{
+				m_NumChunksGenerated = 0;
+				GenerationStart = clock();
+				LastReportTick = clock();
+			}
 		}
 
-		auto item = m_Queue.front();  // Get next chunk from the queue
+		auto itr = PickNextItem(a_WorkerIndex);
+		auto item = *itr;
 		bool SkipEnabled = (m_Queue.size() > QUEUE_SKIP_LIMIT);
-		m_Queue.erase(m_Queue.begin());  // Remove the item from the queue
+		m_Queue.erase(itr);  // Remove the item from the queue
+		bool HasMore = !m_Queue.empty();
 		Lock.Unlock();  // Unlock ASAP
 		m_evtRemoved.Set();
+		if (HasMore && !m_Workers.empty())
+		{
+			// Wake up another thread for the rest of the queue, in case multiple wakeups coalesced in m_Event:
+			m_Event.Set();
+		}
 
 		// Display perf info once in a while:
-		if ((NumChunksGenerated > 512) && (clock() - LastReportTick > 2 * CLOCKS_PER_SEC))
+		int NumChunksGenerated = m_NumChunksGenerated;
+		if (ShouldReport && (NumChunksGenerated > 512) && (clock() - LastReportTick > 2 * CLOCKS_PER_SEC))
 		{
 			LOG("Chunk generator performance: %.2f ch / sec (%d ch total)",
 				static_cast<double>(NumChunksGenerated) * CLOCKS_PER_SEC / (clock() - GenerationStart),
@@ -227,12 +361,12 @@ void cChunkGeneratorThread::Execute(void)
 		}
 
 		// Generate the chunk:
-		DoGenerate(item.m_Coords);
+		DoGenerate(a_Generator, item.m_Coords);
 		if (item.m_Callback != nullptr)
 		{
 			item.m_Callback->Call(item.m_Coords, true);
 		}
-		NumChunksGenerated++;
+		m_NumChunksGenerated++;
 	}  // while (!bStop)
 }
 
@@ -240,14 +374,40 @@ void cChunkGeneratorThread::Execute(void)
 
 
 
-void cChunkGeneratorThread::DoGenerate(cChunkCoords a_Coords)
+cChunkGeneratorThread::Queue::iterator cChunkGeneratorThread::PickNextItem(size_t a_WorkerIndex)
+{
+	ASSERT(!m_Queue.empty());
+	if (m_Workers.empty())
+	{
+		return m_Queue.begin();
+	}
+
+	size_t NumThreads = m_Workers.size() + 1;
+	size_t NumChecked = 0;
+	for (auto itr = m_Queue.begin(), end = m_Queue.end(); (itr != end) && (NumChecked < REGION_SEARCH_LIMIT); ++itr, ++NumChecked)
+	{
+		if (GetRegionWorker(itr->m_Coords, NumThreads) == a_WorkerIndex)
+		{
+			return itr;
+		}
+	}
+
+	// Nothing from our regions near the front of the queue, help the other threads instead of idling:
+	return m_Queue.begin();
+}
+
+
+
+
+
+void cChunkGeneratorThread::DoGenerate(cChunkGenerator & a_Generator, cChunkCoords a_Coords)
 {
 	ASSERT(m_PluginInterface != nullptr);
 	ASSERT(m_ChunkSink != nullptr);
 
 	cChunkDesc ChunkDesc(a_Coords);
 	m_PluginInterface->CallHookChunkGenerating(ChunkDesc);
-	m_Generator->Generate(ChunkDesc);
+	a_Generator.Generate(ChunkDesc);
 	m_PluginInterface->CallHookChunkGenerated(ChunkDesc);
 
 	#ifndef NDEBUG
@@ -2,6 +2,7 @@
 
 #include "OSSupport/IsThread.h"
 #include "ChunkDef.h"
+#include "Generating/GenCache.h"
 
 
 
@@ -18,8 +19,10 @@ class cChunkGenerator;
 /** Takes requests for generating chunks and processes them in a separate thread one by one.
 The requests are not added to the queue if there is already a request with the same coords.
 Before generating, the thread checks if the chunk hasn't been already generated.
-It is theoretically possible to have multiple generator threads by having multiple instances of this object,
-but then it MAY happen that the chunk is generated twice.
+The [Generator] NumThreads setting adds more worker threads that share the queue. Each worker has its own
+instance of the entire generator, so that none of the generator caches need locking. To keep the structure
+caches effective, each worker prefers the chunks from its own regions of the world, so that chunks spanned by
+a single structure are mostly generated by the same worker, and the structure is built only once.
 If the generator queue is overloaded, the generator skips chunks with no clients in them. */
 class cChunkGeneratorThread :
 	public cIsThread
@@ -100,9 +103,17 @@ public:
 	/** Returns the biome at the specified coords. Used by ChunkMap if an invalid chunk is queried for biome */
 	EMCSBiome GetBiomeAt(int a_BlockX, int a_BlockZ);
 
+	/** Returns the statistics of the generator caches, summed over all the generator threads. */
+	cGenCacheStatsMap GetCacheStats(void) const;
+
+	/** Returns the number of threads generating chunks, including this one. */
+	size_t GetNumThreads(void) const { return m_Workers.size() + 1; }
+
 
 private:
 
+	class cWorker;
+
 	struct QueueItem
 	{
 		/** The chunk coords */
@@ -137,9 +148,17 @@ private:
 	/** Set when an item is removed from the queue. */
 	cEvent m_evtRemoved;
 
-	/** The actual chunk generator engine used. */
+	/** The actual chunk generator engine used by this thread.
+	Also used for the biome queries from other threads. */
 	std::unique_ptr<cChunkGenerator> m_Generator;
 
+	/** The additional generator threads, each with its own generator instance.
+	Started by this thread, so that they run only while this thread runs. */
+	std::vector<std::unique_ptr<cWorker>> m_Workers;
+
+	/** Number of chunks generated by all the threads since the queue was last empty, used for the performance reports. */
+	std::atomic<int> m_NumChunksGenerated;
+
 	/** The plugin interface that may modify the generated chunks */
 	cPluginInterface * m_PluginInterface;
 
@@ -150,8 +169,17 @@ private:
 	// cIsThread override:
 	virtual void Execute(void) override;
 
-	/** Generates the specified chunk and sets it into the chunksink. */
-	void DoGenerate(cChunkCoords a_Coords);
+	/** Generates the queued chunks using a_Generator until a_ShouldTerminate is set.
+	Run by this thread (with a_WorkerIndex 0) and by each of the workers. */
+	void ProcessQueue(cChunkGenerator & a_Generator, size_t a_WorkerIndex, const std::atomic<bool> & a_ShouldTerminate);
+
+	/** Returns the iterator to the queue item that the specified worker should generate next.
+	That is the first item in the worker's regions, if there's one close enough to the front of the queue, or the front item.
+	Assumes m_CS is locked and the queue is not empty. */
+	Queue::iterator PickNextItem(size_t a_WorkerIndex);
+
+	/** Generates the specified chunk using a_Generator and sets it into the chunksink. */
+	void DoGenerate(cChunkGenerator & a_Generator, cChunkCoords a_Coords);
 };
 
 
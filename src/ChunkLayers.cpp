@@ -0,0 +1,153 @@
+
+// ChunkLayers.cpp
+
+// Implements the cSectionLayers class that keeps per-block properties of a chunk section as bitmaps, 64 blocks per word
+
+#include "Globals.h"
+#include "ChunkLayers.h"
+#include "BlockInfo.h"
+
+
+
+
+
+namespace
+{
+	/** Marks the table entries that have been computed, so that a zero entry means "not known yet". */
+	const UInt8 KNOWN_MASK = 0x80;
+
+	/** The layer masks of the block states, indexed by the state ID, computed on first use of each state.
+	Atomic, since the lighting thread and all the world tick threads use it; the relaxed accesses compile to plain loads and stores. */
+	std::array<std::atomic<UInt8>, std::numeric_limits<BlockState::DataType>::max() + 1> g_LayerMasks;
+}
+
+
+
+
+
+UInt8 cSectionLayers::GetLayerMask(const BlockState a_Block)
+{
+	auto & Entry = g_LayerMasks[a_Block.ID];
+	const auto Known = Entry.load(std::memory_order_relaxed);
+	if (Known != 0)
+	{
+		return static_cast<UInt8>(Known & ~KNOWN_MASK);
+	}
+
+	UInt8 Mask = 0;
+	if (cBlockInfo::IsSolid(a_Block))
+	{
+		Mask |= LayerBit(eBlockLayer::Solid);
+	}
+	if (cBlockInfo::IsTransparent(a_Block))
+	{
+		Mask |= LayerBit(eBlockLayer::Transparent);
+	}
+	const auto Type = a_Block.Type();
+	if ((Type == BlockType::Water) || (Type == BlockType::Lava))
+	{
+		Mask |= LayerBit(eBlockLayer::Fluid);
+	}
+	if (cBlockInfo::GetLightValue(a_Block) > 0)
+	{
+		Mask |= LayerBit(eBlockLayer::LightEmitting);
+	}
+	if (!IsBlockAir(a_Block) && (Type != BlockType::Water))
+	{
+		Mask |= LayerBit(eBlockLayer::SpawnBlocking);
+	}
+	if (Type != BlockType::Air)
+	{
+		Mask |= LayerBit(eBlockLayer::NonAir);
+	}
+
+	// Racing threads store the same value:
+	Entry.store(Mask | KNOWN_MASK, std::memory_order_relaxed);
+	return Mask;
+}
+
+
+
+
+
+const cSectionLayers & cSectionLayers::AllAir(void)
+{
+	static const cSectionLayers Air = []
+	{
+		cSectionLayers Res;
+		for (size_t Layer = 0; Layer < NumLayers; Layer++)
+		{
+			const bool IsSet = ((GetLayerMask(ChunkBlockData::DefaultValue) & (1 << Layer)) != 0);
+			Res.m_Layers[Layer].fill(IsSet ? ~static_cast<UInt64>(0) : 0);
+		}
+		return Res;
+	}();
+	return Air;
+}
+
+
+
+
+
+void cSectionLayers::Compute(const ChunkBlockData::BlockArray & a_Blocks)
+{
+	// Sections are mostly long runs of the same block, remember the last mask instead of looking up each block:
+	BlockState LastBlock = a_Blocks[0];
+	UInt8 LastMask = GetLayerMask(LastBlock);
+
+	for (size_t Word = 0; Word < NumWords; Word++)
+	{
+		std::array<UInt64, NumLayers> Bits{};
+		const auto Blocks = a_Blocks.data() + Word * 64;
+		for (size_t Bit = 0; Bit < 64; Bit++)
+		{
+			if (Blocks[Bit] != LastBlock)
+			{
+				LastBlock = Blocks[Bit];
+				LastMask = GetLayerMask(LastBlock);
+			}
+			for (size_t Layer = 0; Layer < NumLayers; Layer++)
+			{
+				Bits[Layer] |= static_cast<UInt64>((LastMask >> Layer) & 1) << Bit;
+			}
+		}
+		for (size_t Layer = 0; Layer < NumLayers; Layer++)
+		{
+			m_Layers[Layer][Word] = Bits[Layer];
+		}
+	}
+}
+
+
+
+
+
+void cSectionLayers::SetBlock(const size_t a_Index, const BlockState a_Block)
+{
+	ASSERT(a_Index < ChunkBlockData::SectionBlockCount);
+
+	const auto Mask = GetLayerMask(a_Block);
+	const auto Word = a_Index / 64;
+	const auto Bit = static_cast<UInt64>(1) << (a_Index % 64);
+	for (size_t Layer = 0; Layer < NumLayers; Layer++)
+	{
+		if (((Mask >> Layer) & 1) != 0)
+		{
+			m_Layers[Layer][Word] |= Bit;
+		}
+		else
+		{
+			m_Layers[Layer][Word] &= ~Bit;
+		}
+	}
+}
+
+
+
+
+
+bool cSectionLayers::IsAny(const eBlockLayer a_Layer) const
+{
+	const auto & Layer = GetLayer(a_Layer);
+	return std::any_of(Layer.begin(), Layer.end(), [](UInt64 a_Word) { return (a_Word != 0); });
+}
@@ -0,0 +1,135 @@
+
+// ChunkLayers.h
+
+// Declares the cSectionLayers class that keeps per-block properties of a chunk section as bitmaps, 64 blocks per word
+
+
+
+
+
+#pragma once
+
+#include "ChunkData.h"
+
+#ifdef _MSC_VER
+	#include <intrin.h>
+#endif
+
+
+
+
+
+/** The per-block properties that each chunk section keeps a bitmap of. */
+enum class eBlockLayer
+{
+	/** cBlockInfo::IsSolid(): entities collide with the block, line traces hit it. */
+	Solid,
+
+	/** cBlockInfo::IsTransparent(). */
+	Transparent,
+
+	/** Water or lava. */
+	Fluid,
+
+	/** cBlockInfo::GetLightValue() is non-zero. */
+	LightEmitting,
+
+	/** No mob can spawn with its feet in the block: anything but air and water. */
+	SpawnBlocking,
+
+	/** Anything but plain air (BlockType::Air); cave air and void air are included. */
+	NonAir,
+};
+
+
+
+
+
+/** Bitmaps of the blocks of a chunk section that have each of the eBlockLayer properties.
+The bits are in the same order as the blocks in the section (ChunkBlockData::SectionBitmap),
+so a single word answers a question for 64 blocks: four rows of 16 blocks along X.
+The chunk keeps the layers in sync with its blocks, the whole section is computed when the section is loaded
+and single bits are updated as blocks are set. */
+class cSectionLayers
+{
+public:
+
+	using Bitmap = ChunkBlockData::SectionBitmap;
+
+	static constexpr size_t NumLayers = static_cast<size_t>(eBlockLayer::NonAir) + 1;
+	static constexpr size_t NumWords = std::tuple_size<Bitmap>::value;
+
+
+	/** Returns the layers that the block state is in, as a bitmask with bit N set for layer N.
+	The properties of each block state are queried from cBlockInfo only once and then kept in a table. */
+	static UInt8 GetLayerMask(BlockState a_Block);
+
+	/** Returns true if the block state is in the specified layer, without looking at any section. */
+	static bool IsInLayer(BlockState a_Block, eBlockLayer a_Layer)
+	{
+		return ((GetLayerMask(a_Block) & LayerBit(a_Layer)) != 0);
+	}
+
+	/** Returns the layers of a section that contains only air, as reported for sections that aren't allocated. */
+	static const cSectionLayers & AllAir(void);
+
+	/** Returns the index of the lowest set bit of a non-zero word, for walking the blocks set in a layer word. */
+	static size_t LowestSetBit(UInt64 a_Word)
+	{
+		ASSERT(a_Word != 0);
+		#ifdef _MSC_VER
+			unsigned long Index;
+			_BitScanForward64(&Index, a_Word);
+			return Index;
+		#else
+			return static_cast<size_t>(__builtin_ctzll(a_Word));
+		#endif
+	}
+
+
+	/** Computes all layers from the blocks of the section. */
+	void Compute(const ChunkBlockData::BlockArray & a_Blocks);
+
+	/** Updates the bits of the block at the specified index within the section. */
+	void SetBlock(size_t a_Index, BlockState a_Block);
+
+	/** Returns the whole bitmap of the specified layer. */
+	const Bitmap & GetLayer(eBlockLayer a_Layer) const { return m_Layers[static_cast<size_t>(a_Layer)]; }
+
+	/** Returns the word of the specified layer that holds the blocks from a_WordIndex * 64 to a_WordIndex * 64 + 63. */
+	UInt64 GetWord(eBlockLayer a_Layer, size_t a_WordIndex) const { return m_Layers[static_cast<size_t>(a_Layer)][a_WordIndex]; }
+
+	/** Returns true if the block at the specified index within the section is in the layer. */
+	bool Test(eBlockLayer a_Layer, size_t a_Index) const
+	{
+		return (((GetWord(a_Layer, a_Index / 64) >> (a_Index % 64)) & 1) != 0);
+	}
+
+	/** Returns true if any block of the section is in the layer. */
+	bool IsAny(eBlockLayer a_Layer) const;
+
+	/** Calls a_Callback with the index within the section of each block that is in the layer, in increasing order,
+	skipping 64 blocks at a time where none is. If the callback returns true, the iteration stops. */
+	template <typename CallbackType>
+	void ForEachInLayer(eBlockLayer a_Layer, CallbackType a_Callback) const
+	{
+		const auto & Layer = GetLayer(a_Layer);
+		for (size_t Word = 0; Word < NumWords; Word++)
+		{
+			for (auto Bits = Layer[Word]; Bits != 0; Bits &= Bits - 1)
+			{
+				if (a_Callback(Word * 64 + LowestSetBit(Bits)))
+				{
+					return;
+				}
+			}
+		}
+	}
+
+private:
+
+	std::array<Bitmap, NumLayers> m_Layers;
+
+
+	static constexpr UInt8 LayerBit(eBlockLayer a_Layer) { return static_cast<UInt8>(1 << static_cast<int>(a_Layer)); }
+};
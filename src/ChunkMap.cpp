@@ -41,10 +41,7 @@ cChunkMap::cChunkMap(cWorld * a_World) :
 cChunk & cChunkMap::ConstructChunk(int a_ChunkX, int a_ChunkZ)
 {
 	// If not exists insert. Then, return the chunk at these coordinates:
-	return m_Chunks.try_emplace(
-		{ a_ChunkX, a_ChunkZ },
-		a_ChunkX, a_ChunkZ, this, m_World
-	).first->second;
+	return m_Chunks.FindOrEmplace({ a_ChunkX, a_ChunkZ }, a_ChunkX, a_ChunkZ, this, m_World);
 }
 
 
@@ -72,8 +69,7 @@ cChunk * cChunkMap::FindChunk(int a_ChunkX, int a_ChunkZ)
 {
 	ASSERT(m_CSChunks.IsLockedByCurrentThread());
 
-	const auto Chunk = m_Chunks.find({ a_ChunkX, a_ChunkZ });
-	return (Chunk == m_Chunks.end()) ? nullptr : &Chunk->second;
+	return m_Chunks.Find({ a_ChunkX, a_ChunkZ });
 }
 
 
@@ -84,8 +80,7 @@ const cChunk * cChunkMap::FindChunk(int a_ChunkX, int a_ChunkZ) const
 {
 	ASSERT(m_CSChunks.IsLockedByCurrentThread());
 
-	const auto Chunk = m_Chunks.find({ a_ChunkX, a_ChunkZ });
-	return (Chunk == m_Chunks.end()) ? nullptr : &Chunk->second;
+	return m_Chunks.Find({ a_ChunkX, a_ChunkZ });
 }
 
 
@@ -864,7 +859,7 @@ void cChunkMap::RemoveClientFromChunks(cClientHandle * a_Client)
 	cCSLock Lock(m_CSChunks);
 	for (auto & Chunk : m_Chunks)
 	{
-		Chunk.second.RemoveClient(a_Client);
+		Chunk.second->RemoveClient(a_Client);
 	}
 }
 
@@ -916,7 +911,7 @@ bool cChunkMap::HasEntity(UInt32 a_UniqueID) const
 	cCSLock Lock(m_CSChunks);
 	for (const auto & Chunk : m_Chunks)
 	{
-		if (Chunk.second.IsValid() && Chunk.second.HasEntity(a_UniqueID))
+		if (Chunk.second->IsValid() && Chunk.second->HasEntity(a_UniqueID))
 		{
 			return true;
 		}
@@ -951,7 +946,7 @@ bool cChunkMap::ForEachEntity(cEntityCallback a_Callback) const
 	cCSLock Lock(m_CSChunks);
 	for (const auto & Chunk : m_Chunks)
 	{
-		if (Chunk.second.IsValid() && !Chunk.second.ForEachEntity(a_Callback))
+		if (Chunk.second->IsValid() && !Chunk.second->ForEachEntity(a_Callback))
 		{
 			return false;
 		}
@@ -1016,7 +1011,7 @@ bool cChunkMap::DoWithEntityByID(UInt32 a_UniqueID, cEntityCallback a_Callback)
 	bool res = false;
 	for (const auto & Chunk : m_Chunks)
 	{
-		if (Chunk.second.IsValid() && Chunk.second.DoWithEntityByID(a_UniqueID, a_Callback, res))
+		if (Chunk.second->IsValid() && Chunk.second->DoWithEntityByID(a_UniqueID, a_Callback, res))
 		{
 			return res;
 		}
@@ -1165,7 +1160,7 @@ bool cChunkMap::ForEachLoadedChunk(cFunctionRef<bool(int, int)> a_Callback) cons
 	cCSLock Lock(m_CSChunks);
 	for (const auto & Chunk : m_Chunks)
 	{
-		if (Chunk.second.IsValid())
+		if (Chunk.second->IsValid())
 		{
 			if (a_Callback(Chunk.first.m_ChunkX, Chunk.first.m_ChunkZ))
 			{
@@ -1218,6 +1213,22 @@ bool cChunkMap::WriteBlockArea(cBlockArea & a_Area, int a_MinBlockX, int a_MinBl
 
 
 
+bool cChunkMap::WriteBlockArea(cBlockArea & a_Area, int a_MinBlockX, int a_MinBlockY, int a_MinBlockZ, int a_DataTypes, cChunkCoords a_Chunk)
+{
+	cCSLock Lock(m_CSChunks);
+	const auto Chunk = FindChunk(a_Chunk.m_ChunkX, a_Chunk.m_ChunkZ);
+	if ((Chunk == nullptr) || !Chunk->IsValid())
+	{
+		return false;
+	}
+	Chunk->WriteBlockArea(a_Area, a_MinBlockX, a_MinBlockY, a_MinBlockZ, a_DataTypes);
+	return true;
+}
+
+
+
+
+
 void cChunkMap::GetChunkStats(int & a_NumChunksValid, int & a_NumChunksDirty) const
 {
 	a_NumChunksValid = 0;
@@ -1226,7 +1237,7 @@ void cChunkMap::GetChunkStats(int & a_NumChunksValid, int & a_NumChunksDirty) co
 	for (const auto & Chunk : m_Chunks)
 	{
 		a_NumChunksValid++;
-		if (Chunk.second.IsDirty())
+		if (Chunk.second->IsDirty())
 		{
 			a_NumChunksDirty++;
 		}
@@ -1279,9 +1290,9 @@ void cChunkMap::CollectMobCensus(cMobCensus & a_ToFill)
 		// We do count every Mobs in the world. But we are assuming that every chunk not loaded by any client
 		// doesn't affect us. Normally they should not have mobs because every "too far" mobs despawn
 		// If they have (f.i. when player disconnect) we assume we don't have to make them live or despawn
-		if (Chunk.second.IsValid() && Chunk.second.HasAnyClients())
+		if (Chunk.second->IsValid() && Chunk.second->HasAnyClients())
 		{
-			Chunk.second.CollectMobCensus(a_ToFill);
+			Chunk.second->CollectMobCensus(a_ToFill);
 		}
 	}
 }
@@ -1296,9 +1307,9 @@ void cChunkMap::SpawnMobs(cMobSpawner & a_MobSpawner)
 	for (auto & Chunk : m_Chunks)
 	{
 		// We only spawn close to players
-		if (Chunk.second.IsValid() && Chunk.second.HasAnyClients())
+		if (Chunk.second->IsValid() && Chunk.second->HasAnyClients())
 		{
-			Chunk.second.SpawnMobs(a_MobSpawner);
+			Chunk.second->SpawnMobs(a_MobSpawner);
 		}
 	}
 }
@@ -1314,16 +1325,16 @@ void cChunkMap::Tick(std::chrono::milliseconds a_Dt)
 	// Do the magic of updating the world:
 	for (auto & Chunk : m_Chunks)
 	{
-		if (Chunk.second.ShouldBeTicked())
+		if (Chunk.second->ShouldBeTicked())
 		{
-			Chunk.second.Tick(a_Dt);
+			Chunk.second->Tick(a_Dt);
 		}
 	}
 
 	// Finally, only after all chunks are ticked, tell the client about all aggregated changes:
 	for (auto & Chunk : m_Chunks)
 	{
-		Chunk.second.BroadcastPendingChanges();
+		Chunk.second->BroadcastPendingChanges();
 	}
 }
 
@@ -1335,7 +1346,7 @@ void cChunkMap::FlushPendingBlockChanges()
 {
 	for (auto & Chunk : m_Chunks)
 	{
-		Chunk.second.BroadcastPendingChanges();
+		Chunk.second->BroadcastPendingChanges();
 	}
 }
 
@@ -1363,25 +1374,27 @@ void cChunkMap::TickBlock(const Vector3i a_BlockPos)
 void cChunkMap::UnloadUnusedChunks(void)
 {
 	cCSLock Lock(m_CSChunks);
-	for (auto itr = m_Chunks.begin(); itr != m_Chunks.end();)
+	for (size_t i = 0; i < m_Chunks.GetCount();)
 	{
+		const auto Coords = m_Chunks.GetEntry(i).first;
+		auto & Chunk = *m_Chunks.GetEntry(i).second;
 		if (
-			itr->second.CanUnload() &&  // Can unload
-			!cPluginManager::Get()->CallHookChunkUnloading(*GetWorld(), itr->first.m_ChunkX, itr->first.m_ChunkZ)  // Plugins agree
+			Chunk.CanUnload() &&  // Can unload
+			!cPluginManager::Get()->CallHookChunkUnloading(*GetWorld(), Coords.m_ChunkX, Coords.m_ChunkZ)  // Plugins agree
 		)
 		{
 			// First notify plugins:
-			cPluginManager::Get()->CallHookChunkUnloaded(*m_World, itr->first.m_ChunkX, itr->first.m_ChunkZ);
+			cPluginManager::Get()->CallHookChunkUnloaded(*m_World, Coords.m_ChunkX, Coords.m_ChunkZ);
 
 			// Notify entities within the chunk, while everything's still valid:
-			itr->second.OnUnload();
+			Chunk.OnUnload();
 
-			// Kill the chunk:
-			itr = m_Chunks.erase(itr);
+			// Kill the chunk; the last chunk moves into its place and is to be checked next:
+			m_Chunks.RemoveAt(i);
 		}
 		else
 		{
-			++itr;
+			++i;
 		}
 	}
 }
@@ -1395,7 +1408,7 @@ void cChunkMap::SaveAllChunks(void) const
 	cCSLock Lock(m_CSChunks);
 	for (const auto & Chunk : m_Chunks)
 	{
-		if (Chunk.second.IsValid() && Chunk.second.IsDirty())
+		if (Chunk.second->IsValid() && Chunk.second->IsDirty())
 		{
 			GetWorld()->GetStorage().QueueSaveChunk(Chunk.first.m_ChunkX, Chunk.first.m_ChunkZ);
 		}
@@ -1409,7 +1422,7 @@ void cChunkMap::SaveAllChunks(void) const
 size_t cChunkMap::GetNumChunks(void) const
 {
 	cCSLock Lock(m_CSChunks);
-	return m_Chunks.size();
+	return m_Chunks.GetCount();
 }
 
 
@@ -1422,7 +1435,7 @@ size_t cChunkMap::GetNumUnusedDirtyChunks(void) const
 	size_t res = 0;
 	for (const auto & Chunk : m_Chunks)
 	{
-		if (Chunk.second.IsValid() && Chunk.second.CanUnloadAfterSaving())
+		if (Chunk.second->IsValid() && Chunk.second->CanUnloadAfterSaving())
 		{
 			res += 1;
 		}
@@ -8,6 +8,7 @@
 #include <optional>
 
 #include "ChunkDataCallback.h"
+#include "ChunkTable.h"
 #include "EffectID.h"
 #include "FunctionRef.h"
 
@@ -235,6 +236,10 @@ public:
 	/** Writes the block area into the specified coords. Returns true if all chunks have been processed. Prefer cBlockArea::Write() instead. */
 	bool WriteBlockArea(cBlockArea & a_Area, int a_MinBlockX, int a_MinBlockY, int a_MinBlockZ, int a_DataTypes);
 
+	/** Writes the part of the block area that falls into the specified chunk.
+	Returns false if the chunk is not loaded or not valid. */
+	bool WriteBlockArea(cBlockArea & a_Area, int a_MinBlockX, int a_MinBlockY, int a_MinBlockZ, int a_DataTypes, cChunkCoords a_Chunk);
+
 	/** Returns the number of valid chunks and the number of dirty chunks */
 	void GetChunkStats(int & a_NumChunksValid, int & a_NumChunksDirty) const;
 
@@ -299,9 +304,9 @@ private:
 
 	mutable cCriticalSection m_CSChunks;
 
-	/** A map of chunk coordinates to chunks.
-	Uses a map (as opposed to unordered_map) because sorted maps are apparently faster. */
-	std::map<cChunkCoords, cChunk> m_Chunks;
+	/** The chunks, keyed by their coordinates.
+	A flat hash table, so that the lookups done by nearly every operation while holding m_CSChunks are cheap. */
+	cChunkTable<cChunk> m_Chunks;
 
 	cEvent m_evtChunkValid;  // Set whenever any chunk becomes valid, via ChunkValidated()
 
@@ -240,6 +240,10 @@ void cChunkSender::SendChunk(int a_ChunkX, int a_ChunkZ, const WeakClients & a_C
 	// Send:
 	m_Serializer.SendToClients(a_ChunkX, a_ChunkZ, m_BlockData, m_LightData, m_BiomeMap, m_BlockEntities, m_HeightMap, Clients);
 
+	// Release the snapshot, so that the chunk doesn't need to clone the sections it writes into next:
+	m_BlockData.Clear();
+	m_LightData.Clear();
+
 	for (const auto & Client : Clients)
 	{
 		/*
@@ -115,7 +115,8 @@ protected:
 	cEvent m_evtQueue;  // Set when anything is added to m_ChunksReady
 
 	// Data about the chunk that is being sent:
-	// NOTE that m_BlockData[] is inherited from the cChunkDataCollector
+	// NOTE that m_BlockData and m_LightData are inherited from the cChunkDataCopyCollector,
+	// they are a copy-on-write snapshot of the chunk, taken under the ChunkMap's CS and serialized without it
 	unsigned char m_BiomeMap[cChunkDef::Width * cChunkDef::Width];
 	std::vector<cBlockEntity *> m_BlockEntities;  // Coords of the block entities to send
 	std::vector<UInt32> m_EntityIDs;        // Entity-IDs of the entities to send
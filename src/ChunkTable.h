@@ -0,0 +1,241 @@
+
+// ChunkTable.h
+
+// Declares the cChunkTable class template that stores objects keyed by chunk coords in a flat open-addressing hash table
+
+/*
+The objects themselves are allocated separately and kept in a dense array, so their addresses never change
+(chunks link to their neighbors by pointers) and iterating over them is a plain walk over the array.
+The hash table only maps the coords to the index in the dense array; each slot holds the coords as well,
+so that a lookup touches a single cache line in the common case and never dereferences the objects.
+The table uses linear probing and is kept at most half full; removal shifts the following slots back
+instead of leaving tombstones, so that lookups don't degrade over time as chunks are loaded and unloaded.
+*/
+
+
+
+
+
+#pragma once
+
+#include "ChunkDef.h"
+
+
+
+
+
+template <typename T>
+class cChunkTable
+{
+public:
+
+	/** An entry of the dense array, the coords and the object stored for them. */
+	using cEntry = std::pair<cChunkCoords, std::unique_ptr<T>>;
+
+
+	/** Marks the end of the iteration, see cIterator. */
+	class cSentinel {};
+
+
+	/** Iterates over the entries in the order of the dense array.
+	The iterator holds an index rather than a pointer and compares against the current size of the table,
+	so objects added while iterating are visited as well and the iteration stays valid when the array reallocates.
+	Removing objects while iterating isn't supported, use GetCount(), GetEntry() and RemoveAt() for that. */
+	template <typename TableType, typename EntryType>
+	class cIterator
+	{
+	public:
+
+		cIterator(TableType & a_Table, size_t a_Index):
+			m_Table(a_Table),
+			m_Index(a_Index)
+		{
+		}
+
+		EntryType & operator * (void) const { return m_Table.m_Entries[m_Index]; }
+		EntryType * operator -> (void) const { return &m_Table.m_Entries[m_Index]; }
+		cIterator & operator ++ (void) { ++m_Index; return *this; }
+		bool operator != (cSentinel) const { return (m_Index < m_Table.m_Entries.size()); }
+
+	private:
+
+		TableType & m_Table;
+		size_t m_Index;
+	};
+
+	using iterator = cIterator<cChunkTable, cEntry>;
+	using const_iterator = cIterator<const cChunkTable, const cEntry>;
+
+
+	cChunkTable(void):
+		m_Slots(MIN_NUM_SLOTS),
+		m_SlotMask(MIN_NUM_SLOTS - 1)
+	{
+	}
+
+
+	/** Returns the object stored for the specified coords, or nullptr if there's none. */
+	T * Find(cChunkCoords a_Coords) const
+	{
+		const auto Index = FindIndex(a_Coords);
+		return (Index == NO_INDEX) ? nullptr : m_Entries[Index].second.get();
+	}
+
+
+	/** Returns the object stored for the specified coords.
+	If there's none, constructs one from a_Args first; the constructor may already look up other objects in the table. */
+	template <typename... Args>
+	T & FindOrEmplace(cChunkCoords a_Coords, Args &&... a_Args)
+	{
+		if (const auto Existing = Find(a_Coords); Existing != nullptr)
+		{
+			return *Existing;
+		}
+
+		auto Object = std::make_unique<T>(std::forward<Args>(a_Args)...);
+		auto & Res = *Object;
+		if (m_Entries.size() + 1 > m_Slots.size() / 2)
+		{
+			Rehash(m_Slots.size() * 2);
+		}
+		m_Slots[FindFreeSlot(a_Coords)] = {a_Coords.m_ChunkX, a_Coords.m_ChunkZ, static_cast<UInt32>(m_Entries.size())};
+		m_Entries.emplace_back(a_Coords, std::move(Object));
+		return Res;
+	}
+
+
+	/** Removes the entry at the specified index of the dense array and destroys its object.
+	The last entry is moved into its place, so when removing while iterating by index, the same index is to be visited again. */
+	void RemoveAt(size_t a_Index)
+	{
+		ASSERT(a_Index < m_Entries.size());
+
+		// Take the object out first, so that the table is consistent by the time its destructor runs:
+		auto Object = std::move(m_Entries[a_Index].second);
+		RemoveSlot(FindSlot(m_Entries[a_Index].first));
+
+		const auto LastIndex = m_Entries.size() - 1;
+		if (a_Index != LastIndex)
+		{
+			m_Slots[FindSlot(m_Entries[LastIndex].first)].m_Index = static_cast<UInt32>(a_Index);
+			m_Entries[a_Index] = std::move(m_Entries[LastIndex]);
+		}
+		m_Entries.pop_back();
+	}
+
+
+	/** Returns the number of objects stored. */
+	size_t GetCount(void) const { return m_Entries.size(); }
+
+	/** Returns the entry at the specified index of the dense array. */
+	cEntry & GetEntry(size_t a_Index) { return m_Entries[a_Index]; }
+	const cEntry & GetEntry(size_t a_Index) const { return m_Entries[a_Index]; }
+
+	iterator begin(void) { return {*this, 0}; }
+	const_iterator begin(void) const { return {*this, 0}; }
+	cSentinel end(void) const { return {}; }
+
+private:
+
+	/** A slot of the hash table. */
+	struct sSlot
+	{
+		int m_ChunkX;
+		int m_ChunkZ;
+
+		/** Index into m_Entries, NO_INDEX for an empty slot. */
+		UInt32 m_Index = NO_INDEX;
+	};
+
+	static constexpr UInt32 NO_INDEX = std::numeric_limits<UInt32>::max();
+	static constexpr size_t MIN_NUM_SLOTS = 256;
+
+	/** The hash table; the size is a power of two. */
+	std::vector<sSlot> m_Slots;
+
+	/** m_Slots.size() - 1, for wrapping the slot indices. */
+	size_t m_SlotMask;
+
+	/** The stored objects, in no particular order. */
+	std::vector<cEntry> m_Entries;
+
+
+	/** Returns the slot where the probing for the coords starts. */
+	size_t GetHomeSlot(int a_ChunkX, int a_ChunkZ) const
+	{
+		// Fibonacci hashing of both coords; the high bits are the best mixed:
+		const auto Key = (static_cast<UInt64>(static_cast<UInt32>(a_ChunkX)) << 32) | static_cast<UInt32>(a_ChunkZ);
+		return static_cast<size_t>((Key * 0x9e3779b97f4a7c15ULL) >> 32) & m_SlotMask;
+	}
+
+
+	/** Returns the index of the slot holding the coords, or NO_INDEX if not stored. */
+	size_t FindSlot(cChunkCoords a_Coords) const
+	{
+		for (auto Slot = GetHomeSlot(a_Coords.m_ChunkX, a_Coords.m_ChunkZ);; Slot = (Slot + 1) & m_SlotMask)
+		{
+			const auto & Probe = m_Slots[Slot];
+			if (Probe.m_Index == NO_INDEX)
+			{
+				return NO_INDEX;
+			}
+			if ((Probe.m_ChunkX == a_Coords.m_ChunkX) && (Probe.m_ChunkZ == a_Coords.m_ChunkZ))
+			{
+				return Slot;
+			}
+		}
+	}
+
+
+	/** Returns the index in m_Entries of the coords, or NO_INDEX if not stored. */
+	size_t FindIndex(cChunkCoords a_Coords) const
+	{
+		const auto Slot = FindSlot(a_Coords);
+		return (Slot == NO_INDEX) ? NO_INDEX : m_Slots[Slot].m_Index;
+	}
+
+
+	/** Returns the first empty slot at or after the home slot of the coords. */
+	size_t FindFreeSlot(cChunkCoords a_Coords) const
+	{
+		auto Slot = GetHomeSlot(a_Coords.m_ChunkX, a_Coords.m_ChunkZ);
+		while (m_Slots[Slot].m_Index != NO_INDEX)
+		{
+			Slot = (Slot + 1) & m_SlotMask;
+		}
+		return Slot;
+	}
+
+
+	/** Empties the slot and shifts back the slots that follow it in the same probe run. */
+	void RemoveSlot(size_t a_Slot)
+	{
+		ASSERT(a_Slot != NO_INDEX);
+
+		auto Hole = a_Slot;
+		for (auto Slot = (Hole + 1) & m_SlotMask; m_Slots[Slot].m_Index != NO_INDEX; Slot = (Slot + 1) & m_SlotMask)
+		{
+			// The slot can move into the hole unless its home slot lies cyclically within (Hole, Slot]:
+			const auto Home = GetHomeSlot(m_Slots[Slot].m_ChunkX, m_Slots[Slot].m_ChunkZ);
+			if (((Slot - Home) & m_SlotMask) >= ((Slot - Hole) & m_SlotMask))
+			{
+				m_Slots[Hole] = m_Slots[Slot];
+				Hole = Slot;
+			}
+		}
+		m_Slots[Hole].m_Index = NO_INDEX;
+	}
+
+
+	/** Rebuilds the hash table with the specified number of slots, a power of two. */
+	void Rehash(size_t a_NumSlots)
+	{
+		m_Slots.assign(a_NumSlots, sSlot());
+		m_SlotMask = a_NumSlots - 1;
+		for (size_t i = 0; i < m_Entries.size(); i++)
+		{
+			const auto & Coords = m_Entries[i].first;
+			m_Slots[FindFreeSlot(Coords)] = {Coords.m_ChunkX, Coords.m_ChunkZ, static_cast<UInt32>(i)};
+		}
+	}
+};
@@ -52,6 +52,14 @@
 /** Maximum number of chunks to stream per tick. */
 #define MAX_CHUNKS_STREAMED_PER_TICK 4
 
+/** Maximum number of packets that a client can send in a second, after merging the movements - exceeding this causes a kick.
+The limits are counted per cInboundCommandQueue::LIMIT_WINDOW of the time the packets arrive, independently of the ticks. */
+#define MAX_INBOUND_COMMANDS_PER_SECOND 4096
+
+/** Maximum number of (decompressed) packet bytes that a client can send in a second - exceeding this causes a kick.
+The packet that reaches the limit is still accepted, whatever its size. */
+#define MAX_INBOUND_BYTES_PER_SECOND (4 MiB)
+
 
 
 
@@ -72,6 +80,9 @@ cClientHandle::cClientHandle(const AString & a_IPString, int a_ViewDistance) :
 	m_CurrentViewDistance(a_ViewDistance),
 	m_RequestedViewDistance(a_ViewDistance),
 	m_IPString(a_IPString),
+	m_InboundCommands(MAX_INBOUND_COMMANDS_PER_SECOND, MAX_INBOUND_BYTES_PER_SECOND),
+	m_InboundCommandsToApply(MAX_INBOUND_COMMANDS_PER_SECOND, MAX_INBOUND_BYTES_PER_SECOND),
+	m_ShouldDecodeOffTick(false),
 	m_Player(nullptr),
 	m_CachedSentChunk(std::numeric_limits<decltype(m_CachedSentChunk.m_ChunkX)>::max(), std::numeric_limits<decltype(m_CachedSentChunk.m_ChunkZ)>::max()),
 	m_ProxyConnection(false),
@@ -246,28 +257,52 @@ void cClientHandle::ProxyInit(const AString & a_IPString, const cUUID & a_UUID,
 
 void cClientHandle::ProcessProtocolIn(void)
 {
-	// Process received network data:
+	// Take the packets decoded in the network thread, and the data received after them:
 	decltype(m_IncomingData) IncomingData;
 	{
 		cCSLock Lock(m_CSIncomingData);
 
 		// Bail out when nothing was received:
-		if (m_IncomingData.empty())
+		if (m_IncomingData.empty() && m_InboundCommands.IsEmpty())
 		{
 			return;
 		}
 
 		std::swap(IncomingData, m_IncomingData);
+		m_InboundCommands.Swap(m_InboundCommandsToApply);
+
+		// The protocol is decoding in this thread now, any data received meanwhile must wait for the next tick:
+		if (!IncomingData.empty())
+		{
+			m_ShouldDecodeOffTick = false;
+		}
 	}
 
 	try
 	{
-		m_Protocol.HandleIncomingData(*this, IncomingData);
+		if (!m_InboundCommandsToApply.IsEmpty())
+		{
+			m_Protocol->HandleInboundCommands(m_InboundCommandsToApply);
+			if (m_InboundCommandsToApply.HasError())
+			{
+				Kick(m_InboundCommandsToApply.GetError());
+			}
+		}
+		if (!IncomingData.empty())
+		{
+			m_Protocol.HandleIncomingData(*this, IncomingData);
+		}
 	}
 	catch (const std::exception & Oops)
 	{
 		Kick(Oops.what());
 	}
+	m_InboundCommandsToApply.Clear();
+
+	// Everything received so far has been handled, the network thread may decode the following data if the protocol allows:
+	const bool CanDecodeOffTick = m_Protocol.CanDecodeOffTick();
+	cCSLock Lock(m_CSIncomingData);
+	m_ShouldDecodeOffTick = CanDecodeOffTick && m_IncomingData.empty();
 }
 
 
@@ -2709,6 +2744,49 @@ void cClientHandle::SendEntityProperties(const cEntity & a_Entity)
 
 
 
+void cClientHandle::SendEntityTeleport(const cEntity & a_Entity)
+{
+	m_Protocol->SendEntityTeleport(a_Entity);
+}
+
+
+
+
+
+void cClientHandle::SendEntityMovements(const std::vector<std::pair<const cEntity *, UInt8>> & a_Updates)
+{
+	for (const auto & [Entity, Update] : a_Updates)
+	{
+		if ((Update & cEntity::muVelocity) != 0)
+		{
+			m_Protocol->SendEntityVelocity(*Entity);
+		}
+
+		// The position packets carry the look too:
+		if ((Update & cEntity::muTeleport) != 0)
+		{
+			m_Protocol->SendEntityTeleport(*Entity);
+		}
+		else if ((Update & cEntity::muPosition) != 0)
+		{
+			m_Protocol->SendEntityPosition(*Entity);
+		}
+		else if ((Update & cEntity::muLook) != 0)
+		{
+			m_Protocol->SendEntityLook(*Entity);
+		}
+
+		if ((Update & cEntity::muHeadLook) != 0)
+		{
+			m_Protocol->SendEntityHeadLook(*Entity);
+		}
+	}
+}
+
+
+
+
+
 void cClientHandle::SendEntityVelocity(const cEntity & a_Entity)
 {
 	m_Protocol->SendEntityVelocity(a_Entity);
@@ -3534,9 +3612,32 @@ void cClientHandle::OnReceivedData(const char * a_Data, size_t a_Length)
 	// Reset the timeout:
 	m_TicksSinceLastPacket = 0;
 
-	// Queue the incoming data to be processed in the tick thread:
 	cCSLock Lock(m_CSIncomingData);
-	m_IncomingData.append(reinterpret_cast<const std::byte *>(a_Data), a_Length);
+	if (!m_ShouldDecodeOffTick)
+	{
+		// Queue the incoming data to be processed in the tick thread:
+		m_IncomingData.append(reinterpret_cast<const std::byte *>(a_Data), a_Length);
+		return;
+	}
+	ASSERT(m_IncomingData.empty());
+
+	// The client is going to be kicked, don't bother with the rest of its data:
+	if (m_InboundCommands.HasError())
+	{
+		return;
+	}
+
+	// Decode the packets in this thread, leaving the tick thread only to apply them:
+	ContiguousByteBuffer Data(reinterpret_cast<const std::byte *>(a_Data), a_Length);
+	m_InboundCommands.UpdateLimitWindow(std::chrono::steady_clock::now());
+	try
+	{
+		m_Protocol.DecodeIncomingData(Data, m_InboundCommands);
+	}
+	catch (const std::exception & Oops)
+	{
+		m_InboundCommands.SetError(Oops.what());
+	}
 }
 
 
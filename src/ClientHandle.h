@@ -17,6 +17,7 @@
 #include "ChunkSender.h"
 #include "EffectID.h"
 #include "Protocol/ForgeHandshake.h"
+#include "Protocol/InboundCommandQueue.h"
 #include "Protocol/ProtocolRecognizer.h"
 #include "UUID.h"
 
@@ -184,6 +185,11 @@ public:  // tolua_export
 	void SendEntityMetadata             (const cEntity & a_Entity);
 	void SendEntityPosition             (const cEntity & a_Entity);
 	void SendEntityProperties           (const cEntity & a_Entity);
+	void SendEntityTeleport             (const cEntity & a_Entity);
+
+	/** Sends the entities' movement updates collected by cWorld over the tick, back to back.
+	Each update is the entity with a combination of cEntity::eMovementUpdate flags. */
+	void SendEntityMovements            (const std::vector<std::pair<const cEntity *, UInt8>> & a_Updates);
 	void SendEntityVelocity             (const cEntity & a_Entity);
 	void SendExperience                 (void);
 	void SendExperienceOrb              (const cExpOrb & a_ExpOrb);
@@ -517,13 +523,28 @@ private:
 
 	cMultiVersionProtocol m_Protocol;
 
-	/** Protects m_IncomingData against multithreaded access. */
+	/** Protects m_IncomingData, m_InboundCommands and m_ShouldDecodeOffTick against multithreaded access. */
 	cCriticalSection m_CSIncomingData;
 
 	/** Queue for the incoming data received on the link until it is processed in ProcessProtocolIn().
+	Everything in here was received after the packets in m_InboundCommands.
 	Protected by m_CSIncomingData. */
 	ContiguousByteBuffer m_IncomingData;
 
+	/** The packets decoded in the network thread, until they are applied in ProcessProtocolIn().
+	Protected by m_CSIncomingData. */
+	cInboundCommandQueue m_InboundCommands;
+
+	/** The packets being applied in ProcessProtocolIn(), swapped with m_InboundCommands to keep both allocations.
+	Only used in the tick thread. */
+	cInboundCommandQueue m_InboundCommandsToApply;
+
+	/** If true, the network thread decodes the received data into m_InboundCommands, instead of queueing it into m_IncomingData.
+	Set by the tick thread once all the data received so far has been handled and the protocol allows decoding off the tick thread;
+	while it is set, m_IncomingData stays empty and the protocol's decoding state belongs to the network thread.
+	Protected by m_CSIncomingData. */
+	bool m_ShouldDecodeOffTick;
+
 	/** Protects m_OutgoingData against multithreaded access. */
 	cCriticalSection m_CSOutgoingData;
 
@@ -356,8 +356,31 @@ void cCraftingRecipes::GetRecipe(cPlayer & a_Player, cCraftingGrid & a_CraftingG
 		return;
 	}
 
-	// Built-in recipes:
-	std::unique_ptr<cRecipe> Recipe(FindRecipe(a_CraftingGrid.GetItems(), a_CraftingGrid.GetWidth(), a_CraftingGrid.GetHeight()));
+	// Built-in recipes. Reuse the last match if only the item counts have changed since, such as when shift-crafting:
+	std::unique_ptr<cRecipe> Recipe;
+	bool IsReused = false;
+	{
+		cCSLock Lock(m_CSLastMatch);
+		if (IsSameAsLastMatch(a_CraftingGrid.GetItems(), a_CraftingGrid.GetWidth(), a_CraftingGrid.GetHeight()))
+		{
+			IsReused = true;
+			if (m_LastMatch.m_Recipe != nullptr)
+			{
+				Recipe = std::make_unique<cRecipe>(*m_LastMatch.m_Recipe);
+			}
+		}
+	}
+	if (!IsReused)
+	{
+		Recipe.reset(FindRecipe(a_CraftingGrid.GetItems(), a_CraftingGrid.GetWidth(), a_CraftingGrid.GetHeight()));
+
+		cCSLock Lock(m_CSLastMatch);
+		const cItem * Items = a_CraftingGrid.GetItems();
+		m_LastMatch.m_Grid.assign(Items, Items + a_CraftingGrid.GetWidth() * a_CraftingGrid.GetHeight());
+		m_LastMatch.m_GridWidth = a_CraftingGrid.GetWidth();
+		m_LastMatch.m_GridHeight = a_CraftingGrid.GetHeight();
+		m_LastMatch.m_Recipe.reset((Recipe == nullptr) ? nullptr : new cRecipe(*Recipe));
+	}
 	a_Recipe.Clear();
 	if (Recipe.get() == nullptr)
 	{
@@ -413,7 +436,12 @@ void cCraftingRecipes::LoadRecipes(void)
 		}
 		AddRecipeLine(LineNum, Recipe);
 	}  // for itr - Split[]
-	LOG("Loaded %zu crafting recipes", m_Recipes.size());
+
+	for (UInt32 i = 0; i < m_Recipes.size(); i++)
+	{
+		IndexRecipe(i);
+	}
+	LOG("Loaded %zu crafting recipes (%zu index buckets)", m_Recipes.size(), m_Index.size());
 }
 
 
@@ -442,6 +470,85 @@ void cCraftingRecipes::ClearRecipes(void)
 		delete *itr;
 	}
 	m_Recipes.clear();
+	m_Index.clear();
+
+	cCSLock Lock(m_CSLastMatch);
+	m_LastMatch = sLastMatch();
+}
+
+
+
+
+
+void cCraftingRecipes::IndexRecipe(UInt32 a_RecipeIdx)
+{
+	cRecipe * Recipe = m_Recipes[a_RecipeIdx];
+	std::vector<Item> ItemTypes;
+	for (const auto & Slot : Recipe->m_Ingredients)
+	{
+		ItemTypes.push_back(Slot.m_Item.m_ItemType);
+		if ((Slot.x < 0) || (Slot.y < 0))
+		{
+			Recipe->m_HasAnywhere = true;
+		}
+	}
+	std::sort(ItemTypes.begin(), ItemTypes.end());
+	ItemTypes.erase(std::unique(ItemTypes.begin(), ItemTypes.end()), ItemTypes.end());
+
+	// A grid cropped to its non-empty cells has exactly the size of a matching recipe, unless the recipe has "anywhere" items:
+	if (Recipe->m_HasAnywhere)
+	{
+		m_Index[GetSignature(ItemTypes, 0, 0)].push_back(a_RecipeIdx);
+	}
+	else
+	{
+		m_Index[GetSignature(ItemTypes, Recipe->m_Width, Recipe->m_Height)].push_back(a_RecipeIdx);
+	}
+}
+
+
+
+
+
+UInt64 cCraftingRecipes::GetSignature(const std::vector<Item> & a_ItemTypes, int a_Width, int a_Height)
+{
+	// FNV-1a over the item types, with the size mixed in at the end; collisions only cost an extra MatchRecipe() call:
+	UInt64 Hash = 14695981039346656037ULL;
+	for (auto ItemType : a_ItemTypes)
+	{
+		Hash = (Hash ^ static_cast<UInt64>(ItemType)) * 1099511628211ULL;
+	}
+	Hash = (Hash ^ static_cast<UInt64>(a_Width * (MAX_GRID_HEIGHT + 1) + a_Height)) * 1099511628211ULL;
+	return Hash;
+}
+
+
+
+
+
+bool cCraftingRecipes::IsSameAsLastMatch(const cItem * a_CraftingGrid, int a_GridWidth, int a_GridHeight) const
+{
+	if ((a_GridWidth != m_LastMatch.m_GridWidth) || (a_GridHeight != m_LastMatch.m_GridHeight))
+	{
+		return false;
+	}
+	for (size_t i = 0; i < m_LastMatch.m_Grid.size(); i++)
+	{
+		const cItem & Old = m_LastMatch.m_Grid[i];
+		const cItem & New = a_CraftingGrid[i];
+		if (Old.IsEmpty() != New.IsEmpty())
+		{
+			return false;
+		}
+		if (
+			!New.IsEmpty() &&
+			(!Old.IsEqual(New) || (Old.GetItemColor().m_Color != New.GetItemColor().m_Color))
+		)
+		{
+			return false;
+		}
+	}
+	return true;
 }
 
 
@@ -672,6 +779,24 @@ void cCraftingRecipes::NormalizeIngredients(cCraftingRecipes::cRecipe * a_Recipe
 
 
 cCraftingRecipes::cRecipe * cCraftingRecipes::FindRecipe(const cItem * a_CraftingGrid, int a_GridWidth, int a_GridHeight)
+{
+	return FindRecipe(a_CraftingGrid, a_GridWidth, a_GridHeight, true);
+}
+
+
+
+
+
+cCraftingRecipes::cRecipe * cCraftingRecipes::FindRecipeLinear(const cItem * a_CraftingGrid, int a_GridWidth, int a_GridHeight)
+{
+	return FindRecipe(a_CraftingGrid, a_GridWidth, a_GridHeight, false);
+}
+
+
+
+
+
+cCraftingRecipes::cRecipe * cCraftingRecipes::FindRecipe(const cItem * a_CraftingGrid, int a_GridWidth, int a_GridHeight, bool a_UseIndex)
 {
 	ASSERT(a_GridWidth <= MAX_GRID_WIDTH);
 	ASSERT(a_GridHeight <= MAX_GRID_HEIGHT);
@@ -689,12 +814,19 @@ cCraftingRecipes::cRecipe * cCraftingRecipes::FindRecipe(const cItem * a_Craftin
 			GridTop    = std::min(y, GridTop);
 		}
 	}
+	if ((GridRight < GridLeft) || (GridBottom < GridTop))
+	{
+		// Empty grid
+		return nullptr;
+	}
 	int GridWidth = GridRight - GridLeft + 1;
 	int GridHeight = GridBottom - GridTop + 1;
 
 	// Search in the possibly minimized grid, but keep the stride:
 	const cItem * Grid = a_CraftingGrid + GridLeft + (a_GridWidth * GridTop);
-	cRecipe * Recipe = FindRecipeCropped(Grid, GridWidth, GridHeight, a_GridWidth);
+	cRecipe * Recipe = a_UseIndex ?
+		FindRecipeCropped(Grid, GridWidth, GridHeight, a_GridWidth) :
+		FindRecipeCroppedLinear(Grid, GridWidth, GridHeight, a_GridWidth);
 	if (Recipe == nullptr)
 	{
 		return nullptr;
@@ -715,25 +847,67 @@ cCraftingRecipes::cRecipe * cCraftingRecipes::FindRecipe(const cItem * a_Craftin
 
 
 cCraftingRecipes::cRecipe * cCraftingRecipes::FindRecipeCropped(const cItem * a_CraftingGrid, int a_GridWidth, int a_GridHeight, int a_GridStride)
+{
+	// Collect the distinct item types in the grid:
+	std::vector<Item> ItemTypes;
+	ItemTypes.reserve(MAX_GRID_WIDTH * MAX_GRID_HEIGHT);
+	for (int y = 0; y < a_GridHeight; y++) for (int x = 0; x < a_GridWidth; x++)
+	{
+		const cItem & GridItem = a_CraftingGrid[x + a_GridStride * y];
+		if (!GridItem.IsEmpty())
+		{
+			ItemTypes.push_back(GridItem.m_ItemType);
+		}
+	}
+	std::sort(ItemTypes.begin(), ItemTypes.end());
+	ItemTypes.erase(std::unique(ItemTypes.begin(), ItemTypes.end()), ItemTypes.end());
+
+	// Every cell of the grid has to be matched by an ingredient and vice versa, so a matching recipe has the very same set of item types.
+	// The candidates are the recipes of the exact grid size plus the recipes with "anywhere" items that fit any size:
+	static const cRecipeIndices NoRecipes;
+	auto Exact = m_Index.find(GetSignature(ItemTypes, a_GridWidth, a_GridHeight));
+	auto Anywhere = m_Index.find(GetSignature(ItemTypes, 0, 0));
+	const cRecipeIndices & ExactIndices = (Exact == m_Index.end()) ? NoRecipes : Exact->second;
+	const cRecipeIndices & AnywhereIndices = (Anywhere == m_Index.end()) ? NoRecipes : Anywhere->second;
+
+	// Walk both candidate lists in file order, so that the first matching recipe is the same as in a linear scan:
+	auto itrE = ExactIndices.begin(), endE = ExactIndices.end();
+	auto itrA = AnywhereIndices.begin(), endA = AnywhereIndices.end();
+	while ((itrE != endE) || (itrA != endA))
+	{
+		UInt32 RecipeIdx;
+		if ((itrA == endA) || ((itrE != endE) && (*itrE < *itrA)))
+		{
+			RecipeIdx = *itrE++;
+		}
+		else
+		{
+			RecipeIdx = *itrA++;
+		}
+		cRecipe * Recipe = MatchRecipeAnyOffset(a_CraftingGrid, a_GridWidth, a_GridHeight, a_GridStride, m_Recipes[RecipeIdx]);
+		if (Recipe != nullptr)
+		{
+			return Recipe;
+		}
+	}
+
+	// No matching recipe found
+	return nullptr;
+}
+
+
+
+
+
+cCraftingRecipes::cRecipe * cCraftingRecipes::FindRecipeCroppedLinear(const cItem * a_CraftingGrid, int a_GridWidth, int a_GridHeight, int a_GridStride)
 {
 	for (cRecipes::const_iterator itr = m_Recipes.begin(); itr != m_Recipes.end(); ++itr)
 	{
-		// Both the crafting grid and the recipes are normalized. The only variable possible is the "anywhere" items.
-		// This still means that the "anywhere" item may be the one that is offsetting the grid contents to the right or downwards, so we need to check all possible positions.
-		// E. g. recipe "A, * | B, 1:1 | ..." still needs to check grid for B at 2:2 (in case A was in grid's 1:1)
-		// Calculate the maximum offsets for this recipe relative to the grid size, and iterate through all combinations of offsets.
-		// Also, this calculation automatically filters out recipes that are too large for the current grid - the loop won't be entered at all.
-
-		int MaxOfsX = a_GridWidth  - (*itr)->m_Width;
-		int MaxOfsY = a_GridHeight - (*itr)->m_Height;
-		for (int x = 0; x <= MaxOfsX; x++) for (int y = 0; y <= MaxOfsY; y++)
+		cRecipe * Recipe = MatchRecipeAnyOffset(a_CraftingGrid, a_GridWidth, a_GridHeight, a_GridStride, *itr);
+		if (Recipe != nullptr)
 		{
-			cRecipe * Recipe = MatchRecipe(a_CraftingGrid, a_GridWidth, a_GridHeight, a_GridStride, *itr, x, y);
-			if (Recipe != nullptr)
-			{
-				return Recipe;
-			}
-		}  // for y, for x
+			return Recipe;
+		}
 	}  // for itr - m_Recipes[]
 
 	// No matching recipe found
@@ -744,6 +918,31 @@ cCraftingRecipes::cRecipe * cCraftingRecipes::FindRecipeCropped(const cItem * a_
 
 
 
+cCraftingRecipes::cRecipe * cCraftingRecipes::MatchRecipeAnyOffset(const cItem * a_CraftingGrid, int a_GridWidth, int a_GridHeight, int a_GridStride, const cRecipe * a_Recipe)
+{
+	// Both the crafting grid and the recipes are normalized. The only variable possible is the "anywhere" items.
+	// This still means that the "anywhere" item may be the one that is offsetting the grid contents to the right or downwards, so we need to check all possible positions.
+	// E. g. recipe "A, * | B, 1:1 | ..." still needs to check grid for B at 2:2 (in case A was in grid's 1:1)
+	// Calculate the maximum offsets for this recipe relative to the grid size, and iterate through all combinations of offsets.
+	// Also, this calculation automatically filters out recipes that are too large for the current grid - the loop won't be entered at all.
+
+	int MaxOfsX = a_GridWidth  - a_Recipe->m_Width;
+	int MaxOfsY = a_GridHeight - a_Recipe->m_Height;
+	for (int x = 0; x <= MaxOfsX; x++) for (int y = 0; y <= MaxOfsY; y++)
+	{
+		cRecipe * Recipe = MatchRecipe(a_CraftingGrid, a_GridWidth, a_GridHeight, a_GridStride, a_Recipe, x, y);
+		if (Recipe != nullptr)
+		{
+			return Recipe;
+		}
+	}  // for y, for x
+	return nullptr;
+}
+
+
+
+
+
 cCraftingRecipes::cRecipe * cCraftingRecipes::MatchRecipe(const cItem * a_CraftingGrid, int a_GridWidth, int a_GridHeight, int a_GridStride, const cRecipe * a_Recipe, int a_OffsetX, int a_OffsetY)
 {
 	// Check the regular items first:
@@ -896,13 +1095,13 @@ void cCraftingRecipes::HandleFireworks(const cItem * a_CraftingGrid, cCraftingRe
 				{
 					// Result was a rocket, found a star - copy star data to rocket data
 					int GridID = (itr->x + a_OffsetX) + a_GridStride * (itr->y + a_OffsetY);
-					a_Recipe->m_Result.m_FireworkItem.CopyFrom(a_CraftingGrid[GridID].m_FireworkItem);
+					a_Recipe->m_Result.ModifyFireworkItem().CopyFrom(a_CraftingGrid[GridID].GetFireworkItem());
 					break;
 				}
 				case Item::Gunpowder:
 				{
 					// Gunpowder - increase flight time
-					a_Recipe->m_Result.m_FireworkItem.m_FlightTimeInTicks += 20;
+					a_Recipe->m_Result.ModifyFireworkItem().m_FlightTimeInTicks += 20;
 					break;
 				}
 				case Item::Paper: break;
@@ -924,7 +1123,7 @@ void cCraftingRecipes::HandleFireworks(const cItem * a_CraftingGrid, cCraftingRe
 					// Result was star, found another star - probably adding fade colours, but copy data over anyhow
 					FoundStar = true;
 					int GridID = (itr->x + a_OffsetX) + a_GridStride * (itr->y + a_OffsetY);
-					a_Recipe->m_Result.m_FireworkItem.CopyFrom(a_CraftingGrid[GridID].m_FireworkItem);
+					a_Recipe->m_Result.ModifyFireworkItem().CopyFrom(a_CraftingGrid[GridID].GetFireworkItem());
 					break;
 				}
 				case Item::BlackDye:
@@ -950,13 +1149,13 @@ void cCraftingRecipes::HandleFireworks(const cItem * a_CraftingGrid, cCraftingRe
 					break;
 				}
 				case Item::Gunpowder: break;
-				case Item::Diamond: a_Recipe->m_Result.m_FireworkItem.m_HasTrail = true; break;
-				case Item::GlowstoneDust: a_Recipe->m_Result.m_FireworkItem.m_HasFlicker = true; break;
+				case Item::Diamond: a_Recipe->m_Result.ModifyFireworkItem().m_HasTrail = true; break;
+				case Item::GlowstoneDust: a_Recipe->m_Result.ModifyFireworkItem().m_HasFlicker = true; break;
 
-				case Item::FireCharge:  a_Recipe->m_Result.m_FireworkItem.m_Type = 1; break;
-				case Item::GoldNugget:  a_Recipe->m_Result.m_FireworkItem.m_Type = 2; break;
-				case Item::Feather:     a_Recipe->m_Result.m_FireworkItem.m_Type = 4; break;
-				case Item::CreeperHead: a_Recipe->m_Result.m_FireworkItem.m_Type = 3; break;
+				case Item::FireCharge:  a_Recipe->m_Result.ModifyFireworkItem().m_Type = 1; break;
+				case Item::GoldNugget:  a_Recipe->m_Result.ModifyFireworkItem().m_Type = 2; break;
+				case Item::Feather:     a_Recipe->m_Result.ModifyFireworkItem().m_Type = 4; break;
+				case Item::CreeperHead: a_Recipe->m_Result.ModifyFireworkItem().m_Type = 3; break;
 				default: LOG("Unexpected item in firework star recipe, was the crafting file's fireworks section changed?"); break;  // ermahgerd BARD ardmins
 			}
 		}
@@ -964,12 +1163,12 @@ void cCraftingRecipes::HandleFireworks(const cItem * a_CraftingGrid, cCraftingRe
 		if (FoundStar && (!DyeColours.empty()))
 		{
 			// Found a star and a dye? Fade colours.
-			a_Recipe->m_Result.m_FireworkItem.m_FadeColours = DyeColours;
+			a_Recipe->m_Result.ModifyFireworkItem().m_FadeColours = DyeColours;
 		}
 		else if (!DyeColours.empty())
 		{
 			// Only dye? Normal colours.
-			a_Recipe->m_Result.m_FireworkItem.m_Colours = DyeColours;
+			a_Recipe->m_Result.ModifyFireworkItem().m_Colours = DyeColours;
 		}
 	}
 }
@@ -1001,11 +1200,11 @@ void cCraftingRecipes::HandleDyedLeather(const cItem * a_CraftingGrid, cCrafting
 					found = true;
 					temp = a_CraftingGrid[GridIdx].CopyOne();
 					// The original color of the item affects the result
-					if (temp.m_ItemColor.IsValid())
+					if (temp.GetItemColor().IsValid())
 					{
-						red += temp.m_ItemColor.GetRed();
-						green += temp.m_ItemColor.GetGreen();
-						blue += temp.m_ItemColor.GetBlue();
+						red += temp.GetItemColor().GetRed();
+						green += temp.GetItemColor().GetGreen();
+						blue += temp.GetItemColor().GetBlue();
 						++DyeCount;
 					}
 				}
@@ -1172,6 +1371,6 @@ void cCraftingRecipes::HandleDyedLeather(const cItem * a_CraftingGrid, cCrafting
 
 		// Set the results values
 		a_Recipe->m_Result = temp;
-		a_Recipe->m_Result.m_ItemColor.SetColor(result_red, result_green, result_blue);
+		a_Recipe->m_Result.ModifyItemColor().SetColor(result_red, result_green, result_blue);
 	}
 }
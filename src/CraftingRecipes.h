@@ -9,6 +9,7 @@
 #pragma once
 
 #include "Item.h"
+#include "OSSupport/CriticalSection.h"
 
 // fwd: cPlayer.h
 class cPlayer;
@@ -147,6 +148,9 @@ public:
 		// Size of the regular items in the recipe; "anywhere" items are excluded:
 		int m_Width;
 		int m_Height;
+
+		/** True if the recipe contains at least one "anywhere" ingredient (one of its coords is -1). */
+		bool m_HasAnywhere = false;
 	} ;
 
 	/** Returns the recipe by id */
@@ -155,15 +159,60 @@ public:
 	/** Gets a map of all recipes with name and recipe id */
 	const std::map<AString, UInt32> & GetRecipeNameMap();
 
+	/** Finds a recipe matching the crafting grid, using the recipe index.
+	Returns a newly allocated recipe (with all its coords set) or nullptr if not found. Caller must delete return value!
+	Exported mainly for the benchmark in tests/CraftingRecipes. */
+	cRecipe * FindRecipe(const cItem * a_CraftingGrid, int a_GridWidth, int a_GridHeight);
+
+	/** Same as FindRecipe(), but tries every recipe in file order without using the index.
+	Used to verify the index; the result is always the same as FindRecipe()'s. */
+	cRecipe * FindRecipeLinear(const cItem * a_CraftingGrid, int a_GridWidth, int a_GridHeight);
+
+	/** Returns the number of loaded recipes. */
+	size_t GetNumRecipes(void) const { return m_Recipes.size(); }
+
 protected:
 
 	typedef std::vector<cRecipe *> cRecipes;
 
+	/** Recipe indices into m_Recipes, in file order. */
+	typedef std::vector<UInt32> cRecipeIndices;
+
+	/** The last successful match, reused while the grid only changes in item counts (e.g. shift-click crafting). */
+	struct sLastMatch
+	{
+		std::vector<cItem> m_Grid;
+		int m_GridWidth = 0;
+		int m_GridHeight = 0;
+		std::unique_ptr<cRecipe> m_Recipe;
+	} ;
+
 	cRecipes m_Recipes;
 
+	/** Maps the grid signature (see GetSignature()) to the recipes that may match such a grid.
+	Recipes without "anywhere" ingredients are stored under the signature with their exact size,
+	recipes with "anywhere" ingredients are stored under the signature with zero size and need to be tried for all grid sizes. */
+	std::unordered_map<UInt64, cRecipeIndices> m_Index;
+
+	/** Protects m_LastMatch, GetRecipe() is called from all world tick threads. */
+	cCriticalSection m_CSLastMatch;
+
+	sLastMatch m_LastMatch;
+
 	void LoadRecipes(void);
 	void ClearRecipes(void);
 
+	/** Adds the recipe at the specified index in m_Recipes into m_Index. */
+	void IndexRecipe(UInt32 a_RecipeIdx);
+
+	/** Returns the index signature for the specified set of ingredient item types and the cropped grid size.
+	a_ItemTypes must be sorted and without duplicates. Damage values are not part of the signature so that
+	meta-agnostic ingredients (damage -1) land in the same bucket as any specific damage value. */
+	static UInt64 GetSignature(const std::vector<Item> & a_ItemTypes, int a_Width, int a_Height);
+
+	/** Returns true if the grid has the same items as the grid stored in m_LastMatch, ignoring the item counts. */
+	bool IsSameAsLastMatch(const cItem * a_CraftingGrid, int a_GridWidth, int a_GridHeight) const;
+
 	/** Parses the recipe line and adds it into m_Recipes. a_LineNum is used for diagnostic warnings only */
 	void AddRecipeLine(int a_LineNum, const AString & a_RecipeLine);
 
@@ -176,12 +225,19 @@ protected:
 	/** Moves the recipe to top-left corner, sets its MinWidth / MinHeight */
 	void NormalizeIngredients(cRecipe * a_Recipe);
 
-	/** Finds a recipe matching the crafting grid. Returns a newly allocated recipe (with all its coords set) or nullptr if not found. Caller must delete return value! */
-	cRecipe * FindRecipe(const cItem * a_CraftingGrid, int a_GridWidth, int a_GridHeight);
+	/** Crops the grid to its non-empty bounds, finds a matching recipe using a_UseIndex and moves the result back to the grid coords. */
+	cRecipe * FindRecipe(const cItem * a_CraftingGrid, int a_GridWidth, int a_GridHeight, bool a_UseIndex);
 
-	/** Same as FindRecipe, but the grid is guaranteed to be of minimal dimensions needed */
+	/** Same as FindRecipe, but the grid is guaranteed to be of minimal dimensions needed.
+	Only the recipes from m_Index that share the grid's signature are tried, in file order. */
 	cRecipe * FindRecipeCropped(const cItem * a_CraftingGrid, int a_GridWidth, int a_GridHeight, int a_GridStride);
 
+	/** Same as FindRecipeCropped, but tries all recipes. */
+	cRecipe * FindRecipeCroppedLinear(const cItem * a_CraftingGrid, int a_GridWidth, int a_GridHeight, int a_GridStride);
+
+	/** Tries all offsets of a single recipe against the cropped grid. Returns the matched recipe or nullptr. Caller must delete the return value! */
+	cRecipe * MatchRecipeAnyOffset(const cItem * a_CraftingGrid, int a_GridWidth, int a_GridHeight, int a_GridStride, const cRecipe * a_Recipe);
+
 	/** Checks if the grid matches the specified recipe, offset by the specified offsets. Returns a matched cRecipe * if so, or nullptr if not matching. Caller must delete the return value! */
 	cRecipe * MatchRecipe(const cItem * a_CraftingGrid, int a_GridWidth, int a_GridHeight, int a_GridStride, const cRecipe * a_Recipe, int a_OffsetX, int a_OffsetY);
 
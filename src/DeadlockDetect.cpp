@@ -5,6 +5,7 @@
 
 #include "Globals.h"
 #include "DeadlockDetect.h"
+#include "Logger.h"
 #include "Root.h"
 #include "World.h"
 #include <cstdlib>
@@ -86,6 +87,7 @@ void cDeadlockDetect::UntrackCriticalSection(cCriticalSection & a_CS)
 	{
 		if (itr->first == &a_CS)
 		{
+			LogContention(*itr);
 			m_TrackedCriticalSections.erase(itr);
 			return;
 		}
@@ -162,6 +164,7 @@ void cDeadlockDetect::DeadlockDetected(const AString & a_WorldName, const cTickT
 		a_WorldName.c_str(), static_cast<long long>(a_WorldAge.count())
 	);
 	ListTrackedCSs();
+	cLogger::GetInstance().Flush();
 	ASSERT(!"Deadlock detected");
 	std::abort();
 }
@@ -179,5 +182,24 @@ void cDeadlockDetect::ListTrackedCSs(void)
 			static_cast<void *>(cs.first), cs.second.c_str(),
 			cs.first->m_RecursionCount, static_cast<UInt64>(std::hash<std::thread::id>()(cs.first->m_OwningThreadID))
 		);
+		LogContention(cs);
 	}
 }
+
+
+
+
+
+void cDeadlockDetect::LogContention(const std::pair<cCriticalSection *, AString> & a_TrackedCS)
+{
+	const auto Contention = a_TrackedCS.first->GetContention();
+	const auto WaitMsec = std::chrono::duration<double, std::milli>(Contention.m_WaitTime).count();
+	LOG("CS %s: %llu locks, %llu contended (%.2f %%), %.1f ms waited in total, %.3f ms per contended lock",
+		a_TrackedCS.second.c_str(),
+		static_cast<unsigned long long>(Contention.m_NumLocks),
+		static_cast<unsigned long long>(Contention.m_NumContended),
+		(Contention.m_NumLocks > 0) ? 100.0 * static_cast<double>(Contention.m_NumContended) / static_cast<double>(Contention.m_NumLocks) : 0.0,
+		WaitMsec,
+		(Contention.m_NumContended > 0) ? WaitMsec / static_cast<double>(Contention.m_NumContended) : 0.0
+	);
+}
@@ -35,6 +35,7 @@ public:
 
 	/** Adds the critical section for tracking.
 	Tracked CSs are listed, together with ownership details, when a deadlock is detected.
+	Their lock-contention statistics are logged along, and when the CS is untracked.
 	A tracked CS must be untracked before it is destroyed.
 	a_Name is an arbitrary name that is listed along with the CS in the output. */
 	void TrackCriticalSection(cCriticalSection & a_CS, const AString & a_Name);
@@ -84,6 +85,9 @@ protected:
 
 	/** Outputs a listing of the tracked CSs, together with their name and state. */
 	void ListTrackedCSs();
+
+	/** Outputs the lock-contention statistics of the tracked CS: how often it was locked and how long threads waited for it. */
+	static void LogContention(const std::pair<cCriticalSection *, AString> & a_TrackedCS);
 } ;
 
 
@@ -10,6 +10,7 @@
 #include "../ClientHandle.h"
 #include "../Chunk.h"
 #include "../Simulator/FluidSimulator.h"
+#include "../Physics/SimpleBodyBatch.h"
 #include "../Bindings/PluginManager.h"
 #include "../LineBlockTracer.h"
 #include "../Items/ItemHandler.h"
@@ -44,10 +45,13 @@ cEntity::cEntity(eEntityType a_EntityType, Vector3d a_Pos, float a_Width, float
 	m_bDirtyOrientation(false),
 	m_bHasSentNoSpeed(true),
 	m_bOnGround(false),
+	m_IsPhysicsBatched(false),
 	m_Gravity(-9.81f),
 	m_AirDrag(0.02f),
 	m_LastSentPosition(a_Pos),
 	m_LastPosition(a_Pos),
+	m_QueuedMovementUpdate(0),
+	m_MovementUpdateExclude(nullptr),
 	m_EntityType(a_EntityType),
 	m_World(nullptr),
 	m_IsFireproof(false),
@@ -234,6 +238,9 @@ void cEntity::WrapSpeed(void)
 void cEntity::SetParentChunk(cChunk * a_Chunk)
 {
 	m_ParentChunk = a_Chunk;
+
+	// A batch move that hasn't been consumed by HandlePhysics() yet belongs to the chunk that we're leaving:
+	m_IsPhysicsBatched = false;
 }
 
 
@@ -452,7 +459,7 @@ bool cEntity::DoTakeDamage(TakeDamageInfo & a_TDI)
 			}
 		}
 
-		const cEnchantments & Enchantments = Player->GetEquippedItem().m_Enchantments;
+		const cEnchantments & Enchantments = Player->GetEquippedItem().GetEnchantments();
 
 		int SharpnessLevel = static_cast<int>(Enchantments.GetLevel(cEnchantments::enchSharpness));
 		int SmiteLevel = static_cast<int>(Enchantments.GetLevel(cEnchantments::enchSmite));
@@ -556,7 +563,7 @@ bool cEntity::DoTakeDamage(TakeDamageInfo & a_TDI)
 		for (size_t i = 0; i < ARRAYCOUNT(ArmorItems); i++)
 		{
 			const cItem & Item = ArmorItems[i];
-			ThornsLevel = std::max(ThornsLevel, Item.m_Enchantments.GetLevel(cEnchantments::enchThorns));
+			ThornsLevel = std::max(ThornsLevel, Item.GetEnchantments().GetLevel(cEnchantments::enchThorns));
 		}
 
 		if (ThornsLevel > 0)
@@ -712,28 +719,28 @@ float cEntity::GetEnchantmentCoverAgainst(const cEntity * a_Attacker, eDamageTyp
 
 		if ((a_DamageType != dtInVoid) && (a_DamageType != dtAdmin) && (a_DamageType != dtStarving))
 		{
-			TotalEPF += static_cast<int>(Item.m_Enchantments.GetLevel(cEnchantments::enchProtection)) * 1;
+			TotalEPF += static_cast<int>(Item.GetEnchantments().GetLevel(cEnchantments::enchProtection)) * 1;
 		}
 
 		if ((a_DamageType == dtBurning) || (a_DamageType == dtFireContact) || (a_DamageType == dtLavaContact) || (a_DamageType == dtMagmaContact))
 		{
-			TotalEPF += static_cast<int>(Item.m_Enchantments.GetLevel(cEnchantments::enchFireProtection)) * 2;
+			TotalEPF += static_cast<int>(Item.GetEnchantments().GetLevel(cEnchantments::enchFireProtection)) * 2;
 		}
 
 		if ((a_DamageType == dtFalling) || (a_DamageType == dtEnderPearl))
 		{
-			TotalEPF += static_cast<int>(Item.m_Enchantments.GetLevel(cEnchantments::enchFeatherFalling)) * 3;
+			TotalEPF += static_cast<int>(Item.GetEnchantments().GetLevel(cEnchantments::enchFeatherFalling)) * 3;
 		}
 
 		if (a_DamageType == dtExplosion)
 		{
-			TotalEPF += static_cast<int>(Item.m_Enchantments.GetLevel(cEnchantments::enchBlastProtection)) * 2;
+			TotalEPF += static_cast<int>(Item.GetEnchantments().GetLevel(cEnchantments::enchBlastProtection)) * 2;
 		}
 
 		// Note: Also blocks against fire charges, etc.
 		if (a_DamageType == dtProjectile)
 		{
-			TotalEPF += static_cast<int>(Item.m_Enchantments.GetLevel(cEnchantments::enchProjectileProtection)) * 2;
+			TotalEPF += static_cast<int>(Item.GetEnchantments().GetLevel(cEnchantments::enchProjectileProtection)) * 2;
 		}
 	}
 	int CappedEPF = std::min(20, TotalEPF);
@@ -752,7 +759,7 @@ float cEntity::GetEnchantmentBlastKnockbackReduction()
 
 	for (auto & Item : ArmorItems)
 	{
-		UInt32 Level = Item.m_Enchantments.GetLevel(cEnchantments::enchBlastProtection);
+		UInt32 Level = Item.GetEnchantments().GetLevel(cEnchantments::enchBlastProtection);
 		if (Level > MaxLevel)
 		{
 			// Get max blast protection
@@ -863,7 +870,7 @@ double cEntity::GetKnockbackAmountAgainst(const cEntity & a_Receiver)
 	}
 
 	// Check for knockback enchantments (punch only applies to shot arrows)
-	unsigned int KnockbackLevel = GetEquippedWeapon().m_Enchantments.GetLevel(cEnchantments::enchKnockback);
+	unsigned int KnockbackLevel = GetEquippedWeapon().GetEnchantments().GetLevel(cEnchantments::enchKnockback);
 	unsigned int KnockbackLevelMultiplier = 8;
 
 	Knockback += KnockbackLevelMultiplier * KnockbackLevel;
@@ -1027,6 +1034,13 @@ void cEntity::Tick(std::chrono::milliseconds a_Dt, cChunk & a_Chunk)
 
 void cEntity::HandlePhysics(std::chrono::milliseconds a_Dt, cChunk & a_Chunk)
 {
+	if (m_IsPhysicsBatched)
+	{
+		// The chunk has already moved us in this tick
+		m_IsPhysicsBatched = false;
+		return;
+	}
+
 	int BlockX = POSX_TOINT;
 	int BlockY = POSY_TOINT;
 	int BlockZ = POSZ_TOINT;
@@ -1050,12 +1064,11 @@ void cEntity::HandlePhysics(std::chrono::milliseconds a_Dt, cChunk & a_Chunk)
 	int RelBlockX = BlockX - (NextChunk->GetPosX() * cChunkDef::Width);
 	int RelBlockZ = BlockZ - (NextChunk->GetPosZ() * cChunkDef::Width);
 	auto BlockIn = NextChunk->GetBlock( RelBlockX, BlockY, RelBlockZ);
-	auto BlockBelow = (BlockY > 0) ? NextChunk->GetBlock(RelBlockX, BlockY - 1, RelBlockZ) : Block::Air::Air();
-	if (!cBlockInfo::IsSolid(BlockIn))  // Making sure we are not inside a solid block
+	if (!NextChunk->IsBlockInLayer({RelBlockX, BlockY, RelBlockZ}, eBlockLayer::Solid))  // Making sure we are not inside a solid block
 	{
 		if (m_bOnGround)  // check if it's still on the ground
 		{
-			if (!cBlockInfo::IsSolid(BlockBelow))  // Check if block below is air or water.
+			if ((BlockY == 0) || !NextChunk->IsBlockInLayer({RelBlockX, BlockY - 1, RelBlockZ}, eBlockLayer::Solid))  // Check if block below is air or water.
 			{
 				m_bOnGround = false;
 			}
@@ -1251,6 +1264,90 @@ void cEntity::HandlePhysics(std::chrono::milliseconds a_Dt, cChunk & a_Chunk)
 
 
 
+bool cEntity::AddToPhysicsBatch(cSimpleBodyBatch & a_Batch, cChunk & a_Chunk)
+{
+	// Drop the previous tick's move, in case our Tick() returned before reaching HandlePhysics():
+	m_IsPhysicsBatched = false;
+
+	if (!(IsPickup() || IsExpOrb() || IsTNT() || IsFallingBlock()) || (m_AttachedTo != nullptr))
+	{
+		return false;
+	}
+
+	cSimpleBodyBatch::sBody Body{m_Position, m_Speed, m_WaterSpeed, {}, m_Gravity, m_AirDrag, m_Width, m_Height, 0};
+	const int BlockX = POSX_TOINT;
+	const int BlockY = POSY_TOINT;
+	const int BlockZ = POSZ_TOINT;
+
+	// Falling blocks check their landing themselves, bodies outside of the world have nothing to collide with:
+	if (IsFallingBlock() || (BlockY >= cChunkDef::Height) || (BlockY < 0))
+	{
+		Body.m_Flags = cSimpleBodyBatch::bfFreeFall;
+		a_Batch.Add(Body);
+		return true;
+	}
+
+	const auto Chunk = a_Chunk.GetNeighborChunk(BlockX, BlockZ);
+	if ((Chunk == nullptr) || !Chunk->IsValid())
+	{
+		return false;
+	}
+
+	// Look at the surroundings the same way HandlePhysics() does:
+	const int RelBlockX = BlockX - (Chunk->GetPosX() * cChunkDef::Width);
+	const int RelBlockZ = BlockZ - (Chunk->GetPosZ() * cChunkDef::Width);
+	const auto BlockIn = Chunk->GetBlock(RelBlockX, BlockY, RelBlockZ);
+	if (!Chunk->IsBlockInLayer({RelBlockX, BlockY, RelBlockZ}, eBlockLayer::Solid))
+	{
+		if (m_bOnGround && ((BlockY == 0) || !Chunk->IsBlockInLayer({RelBlockX, BlockY - 1, RelBlockZ}, eBlockLayer::Solid)))
+		{
+			m_bOnGround = false;
+		}
+	}
+	else if (!(IsTNT() || (IsPickup() && (m_TicksAlive < 15))))
+	{
+		// Inside a solid block, leave the pushing out to HandlePhysics():
+		return false;
+	}
+
+	if (m_bOnGround)
+	{
+		Body.m_Flags |= cSimpleBodyBatch::bfOnGround;
+	}
+	if (BlockIn.Type() == BlockType::Water)
+	{
+		Body.m_Flags |= cSimpleBodyBatch::bfInWater;
+		Body.m_WaterDirection = m_World->GetWaterSimulator()->GetFlowingDirection({BlockX, BlockY, BlockZ});
+	}
+	else if (BlockIn.Type() == BlockType::Cobweb)
+	{
+		Body.m_Flags |= cSimpleBodyBatch::bfInCobweb;
+	}
+
+	a_Batch.Add(Body);
+	return true;
+}
+
+
+
+
+
+void cEntity::ApplyPhysicsBatch(const cSimpleBodyBatch & a_Batch, size_t a_Index)
+{
+	SetPosition(a_Batch.GetPosition(a_Index));
+	SetSpeed(a_Batch.GetSpeed(a_Index));
+	m_WaterSpeed = a_Batch.GetWaterSpeed(a_Index);
+	if (!IsFallingBlock())
+	{
+		m_bOnGround = a_Batch.IsOnGround(a_Index);
+	}
+	m_IsPhysicsBatched = true;
+}
+
+
+
+
+
 void cEntity::ApplyFriction(Vector3d & a_Speed, double a_SlowdownMultiplier, float a_Dt)
 {
 	if (a_Speed.SqrLength() > 0.0004f)
@@ -1825,7 +1922,7 @@ void cEntity::HandleAir(void)
 	// See if the entity is /submerged/ water (head is in water)
 	// Get the type of block the entity is standing in:
 
-	int RespirationLevel = static_cast<int>(GetEquippedHelmet().m_Enchantments.GetLevel(cEnchantments::enchRespiration));
+	int RespirationLevel = static_cast<int>(GetEquippedHelmet().GetEnchantments().GetLevel(cEnchantments::enchRespiration));
 
 	if (IsHeadInWater())
 	{
@@ -1995,44 +2092,72 @@ void cEntity::BroadcastMovementUpdate(const cClientHandle * a_Exclude)
 		return;
 	}
 
+	UInt8 Update = 0;
 	if (m_Speed.HasNonZeroLength())
 	{
 		// Movin'
-		m_World->BroadcastEntityVelocity(*this, a_Exclude);
+		Update |= muVelocity;
 		m_bHasSentNoSpeed = false;
 	}
 	else if (!m_bHasSentNoSpeed)
 	{
 		// Speed is zero, send this to clients once only as well as an absolute position
-		m_World->BroadcastEntityVelocity(*this, a_Exclude);
-		m_World->BroadcastEntityPosition(*this, a_Exclude);
-		m_LastSentPosition = GetPosition();
-		m_bDirtyOrientation = false;
+		Update |= muVelocity | muRest;
 		m_bHasSentNoSpeed = true;
 	}
 
 	if ((m_Position - m_LastSentPosition).HasNonZeroLength())  // Have we moved?
 	{
-		m_World->BroadcastEntityPosition(*this, a_Exclude);
+		Update |= muPosition;
+	}
+
+	if (m_bDirtyHead)
+	{
+		Update |= muHeadLook;
+	}
+
+	if (m_bDirtyOrientation)
+	{
+		Update |= muLook;
+	}
+
+	if (Update == 0)
+	{
+		// Nothing has changed, don't bother the world
+		return;
+	}
+
+	if (m_QueuedMovementUpdate == 0)
+	{
+		m_World->QueueEntityMovementUpdate(*this);
+	}
+	m_QueuedMovementUpdate |= Update;
+	m_MovementUpdateExclude = a_Exclude;
+}
 
+
+
+
+
+void cEntity::OnMovementUpdateSent(void)
+{
+	if ((m_QueuedMovementUpdate & (muPosition | muRest)) != 0)
+	{
 		// Clients seem to store two positions, one for the velocity packet and one for the teleport / relmove packet
 		// The latter is only changed with a relmove / teleport, and m_LastSentPosition stores this position
 		m_LastSentPosition = GetPosition();
 		m_bDirtyOrientation = false;
 	}
-
-	if (m_bDirtyHead)
+	if ((m_QueuedMovementUpdate & muHeadLook) != 0)
 	{
-		m_World->BroadcastEntityHeadLook(*this, a_Exclude);
 		m_bDirtyHead = false;
 	}
-
-	if (m_bDirtyOrientation)
+	if ((m_QueuedMovementUpdate & muLook) != 0)
 	{
-		// Send individual update in case above (sending with rel-move packet) wasn't done
-		GetWorld()->BroadcastEntityLook(*this, a_Exclude);
 		m_bDirtyOrientation = false;
 	}
+	m_QueuedMovementUpdate = 0;
+	m_MovementUpdateExclude = nullptr;
 }
 
 
@@ -50,6 +50,7 @@ class cClientHandle;
 class cPlayer;
 class cChunk;
 class cMonster;
+class cSimpleBodyBatch;
 
 
 
@@ -376,6 +377,15 @@ public:
 	/** Handles the physics of the entity - updates position based on speed, updates speed based on environment */
 	virtual void HandlePhysics(std::chrono::milliseconds a_Dt, cChunk & a_Chunk);
 
+	/** Adds the entity to the batch in which a_Chunk moves all of its simple bodies at once, if the entity is one of them:
+	a pickup, experience orb, primed TNT or falling block that isn't attached to anything.
+	Returns false if the entity hasn't been added, its HandlePhysics() then moves it as usual. */
+	bool AddToPhysicsBatch(cSimpleBodyBatch & a_Batch, cChunk & a_Chunk);
+
+	/** Takes over the entity's results from the simulated batch.
+	The entity's next HandlePhysics() call is skipped, since it has already been moved for this tick. */
+	void ApplyPhysicsBatch(const cSimpleBodyBatch & a_Batch, size_t a_Index);
+
 	/** Updates the state related to this entity being on fire */
 	virtual void TickBurning(cChunk & a_Chunk);
 
@@ -452,9 +462,30 @@ public:
 		return (m_WorldChangeInfo.m_NewWorld != nullptr);
 	}
 
-	/** Updates clients of changes in the entity. */
+	/** The parts of the entity's state that a movement update sends to the clients. */
+	enum eMovementUpdate : UInt8
+	{
+		muVelocity = 0x01,
+		muPosition = 0x02,  ///< Relative move where possible, with the look if it is dirty
+		muLook     = 0x04,
+		muHeadLook = 0x08,
+		muRest     = 0x10,  ///< The entity has stopped, all the clients get its final position
+		muTeleport = 0x20,  ///< Absolute position with the look, for the clients that don't get each update
+	};
+
+	/** Updates clients of changes in the entity.
+	The update is queued in the world and sent at the end of the tick, see cWorld::BroadcastQueuedEntityMovements(). */
 	virtual void BroadcastMovementUpdate(const cClientHandle * a_Exclude = nullptr);
 
+	/** Returns the movement update waiting to be sent, a combination of eMovementUpdate flags; 0 if none. */
+	UInt8 GetQueuedMovementUpdate(void) const { return m_QueuedMovementUpdate; }
+
+	/** Returns the client that shouldn't get the queued movement update (the player's own client). */
+	const cClientHandle * GetMovementUpdateExclude(void) const { return m_MovementUpdateExclude; }
+
+	/** Called by the world once it has sent the queued movement update; remembers what the clients have got. */
+	void OnMovementUpdateSent(void);
+
 	/** Gets entity (vehicle) attached to this entity */
 	cEntity * GetAttached();
 
@@ -603,6 +634,10 @@ protected:
 	/** Stores if the entity is on the ground */
 	bool m_bOnGround;
 
+	/** Set when the chunk has moved the entity in its batch of simple bodies, cleared by the HandlePhysics() call that is skipped because of it.
+	Also cleared when the entity leaves the chunk and when the next batch is built, so that a move that wasn't consumed never skips a later tick. */
+	bool m_IsPhysicsBatched;
+
 	/** Stores gravity that is applied to an entity every tick
 	For realistic effects, this should be negative. For spaaaaaaace, this can be zero or even positive */
 	float m_Gravity;
@@ -619,6 +654,12 @@ protected:
 
 	Vector3d m_LastPosition;
 
+	/** The movement update waiting in the world's queue, a combination of eMovementUpdate flags. */
+	UInt8 m_QueuedMovementUpdate;
+
+	/** The client excluded from the queued movement update. */
+	const cClientHandle * m_MovementUpdateExclude;
+
 	eEntityType m_EntityType;
 
 	cWorld * m_World;
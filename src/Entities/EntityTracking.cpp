@@ -0,0 +1,48 @@
+// EntityTracking.cpp
+
+// Implements the EntityTracking namespace that decides which movement updates of an entity each client gets, by its distance
+
+#include "Globals.h"
+#include "EntityTracking.h"
+
+
+
+
+
+namespace EntityTracking
+{
+	int GetTier(const double a_SqrDistance, const double a_TrackingRange)
+	{
+		for (int Tier = 0; Tier < NUM_TIERS; Tier++)
+		{
+			const auto TierRange = a_TrackingRange / (1 << (NUM_TIERS - 1 - Tier));
+			if (a_SqrDistance < TierRange * TierRange)
+			{
+				return Tier;
+			}
+		}
+		return NUM_TIERS;
+	}
+
+
+
+
+
+	eClientUpdate GetClientUpdate(const double a_SqrDistance, const double a_LastSqrDistance, const double a_TrackingRange, const Int64 a_UpdateIndex)
+	{
+		const auto Tier = GetTier(a_SqrDistance, a_TrackingRange);
+		if (Tier >= NUM_TIERS)
+		{
+			return eClientUpdate::None;
+		}
+		if ((Tier == 0) && (GetTier(a_LastSqrDistance, a_TrackingRange) == 0) && ((a_UpdateIndex % RESYNC_INTERVAL) != 0))
+		{
+			return eClientUpdate::Relative;
+		}
+		if ((a_UpdateIndex % (1 << Tier)) == 0)
+		{
+			return eClientUpdate::Absolute;
+		}
+		return eClientUpdate::None;
+	}
+}
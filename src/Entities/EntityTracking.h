@@ -0,0 +1,41 @@
+// EntityTracking.h
+
+// Declares the EntityTracking namespace that decides which movement updates of an entity each client gets, by its distance
+
+#pragma once
+
+
+
+
+
+namespace EntityTracking
+{
+	/** The number of distance tiers of the clients within an entity's tracking range.
+	Tier 0 gets each movement update of the entity, each next tier every other update of the previous one. */
+	constexpr int NUM_TIERS = 3;
+
+	/** Each this many updates, even the clients that get each update get the entity's absolute position, to fix any drift. */
+	constexpr Int64 RESYNC_INTERVAL = 64;
+
+	/** How a client gets a single movement update of an entity. */
+	enum class eClientUpdate
+	{
+		/** Not this client's turn, or the client is out of the tracking range. */
+		None,
+
+		/** The client has got the previous update, a move relative to the last sent position will do. */
+		Relative,
+
+		/** The client may have missed some updates, it needs the absolute position. */
+		Absolute,
+	};
+
+	/** Returns the distance tier of a client at the specified square distance from the entity, NUM_TIERS if out of the tracking range.
+	The tiers end at a quarter, a half and the whole of the range. */
+	int GetTier(double a_SqrDistance, double a_TrackingRange);
+
+	/** Returns how a client gets the entity's update number a_UpdateIndex.
+	a_SqrDistance is the client's current square distance from the entity, a_LastSqrDistance the one at the previous update.
+	The update indices are expected to be offset per entity, so that the updates of the entities are spread over the ticks. */
+	eClientUpdate GetClientUpdate(double a_SqrDistance, double a_LastSqrDistance, double a_TrackingRange, Int64 a_UpdateIndex);
+}
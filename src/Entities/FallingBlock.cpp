@@ -17,7 +17,7 @@ cFallingBlock::cFallingBlock(Vector3d a_Position, BlockState a_Block):
 	Super(etFallingBlock, a_Position, 0.98f, 0.98f),
 	m_Block(a_Block)
 {
-	SetGravity(-16.0f);
+	SetGravity(-9.8f);
 	SetAirDrag(0.02f);
 }
 
@@ -38,6 +38,9 @@ void cFallingBlock::Tick(std::chrono::milliseconds a_Dt, cChunk & a_Chunk)
 {
 	// GetWorld()->BroadcastTeleportEntity(*this);  // Test position
 
+	// The chunk moves the falling blocks in its batch of simple bodies, before ticking them:
+	const bool IsMoved = std::exchange(m_IsPhysicsBatched, false);
+
 	int BlockX = POSX_TOINT;
 	int BlockY = static_cast<int>(GetPosY() - 0.5);
 	int BlockZ = POSZ_TOINT;
@@ -94,9 +97,12 @@ void cFallingBlock::Tick(std::chrono::milliseconds a_Dt, cChunk & a_Chunk)
 		return;
 	}
 
-	float MilliDt = a_Dt.count() * 0.001f;
-	AddSpeedY(MilliDt * -9.8f);
-	AddPosition(GetSpeed() * MilliDt);
+	if (!IsMoved)
+	{
+		float MilliDt = a_Dt.count() * 0.001f;
+		AddSpeedY(MilliDt * GetGravity());
+		AddPosition(GetSpeed() * MilliDt);
+	}
 
 	// If not static (one billionth precision) broadcast movement
 	if ((fabs(GetSpeedX()) > std::numeric_limits<double>::epsilon()) || (fabs(GetSpeedZ()) > std::numeric_limits<double>::epsilon()))
@@ -11,7 +11,7 @@
 
 cFireworkEntity::cFireworkEntity(cEntity * a_Creator, Vector3d a_Pos, const cItem & a_Item) :
 	Super(pkFirework, a_Creator, a_Pos, 0.25f, 0.25f),
-	m_TicksToExplosion(a_Item.m_FireworkItem.m_FlightTimeInTicks),
+	m_TicksToExplosion(a_Item.GetFireworkItem().m_FlightTimeInTicks),
 	m_FireworkItem(a_Item)
 {
 	SetGravity(0);
@@ -15,78 +15,7 @@
 #include "../Registries/Items.h"
 #include "../Root.h"
 #include "../Chunk.h"
-
-
-
-
-class cPickupCombiningCallback
-{
-public:
-	cPickupCombiningCallback(Vector3d a_Position, cPickup * a_Pickup) :
-		m_FoundMatchingPickup(false),
-		m_Position(a_Position),
-		m_Pickup(a_Pickup)
-	{
-	}
-
-	bool operator () (cEntity & a_Entity)
-	{
-		ASSERT(a_Entity.IsTicking());
-		if (!a_Entity.IsPickup() || (a_Entity.GetUniqueID() <= m_Pickup->GetUniqueID()) || !a_Entity.IsOnGround())
-		{
-			return false;
-		}
-
-
-		Vector3d EntityPos = a_Entity.GetPosition();
-		double Distance = (EntityPos - m_Position).Length();
-
-		auto & OtherPickup = static_cast<cPickup &>(a_Entity);
-		cItem & Item = OtherPickup.GetItem();
-		if ((Distance < 1.2) && Item.IsEqual(m_Pickup->GetItem()) && OtherPickup.CanCombine())
-		{
-			short CombineCount = static_cast<short>(Item.m_ItemCount);
-			if ((CombineCount + static_cast<short>(m_Pickup->GetItem().m_ItemCount)) > static_cast<short>(Item.GetMaxStackSize()))
-			{
-				CombineCount = Item.GetMaxStackSize() - m_Pickup->GetItem().m_ItemCount;
-			}
-
-			if (CombineCount <= 0)
-			{
-				return false;
-			}
-
-			m_Pickup->GetItem().AddCount(static_cast<char>(CombineCount));
-			Item.m_ItemCount -= static_cast<char>(CombineCount);
-
-			if (Item.m_ItemCount <= 0)
-			{
-				// a_Entity.GetWorld()->BroadcastCollectEntity(a_Entity, *m_Pickup, static_cast<unsigned>(CombineCount));  // Disabled because it crashes new clients
-				a_Entity.Destroy();
-
-				// Reset the timer
-				m_Pickup->SetAge(0);
-			}
-			else
-			{
-				a_Entity.GetWorld()->BroadcastEntityMetadata(a_Entity);
-			}
-			m_FoundMatchingPickup = true;
-		}
-		return false;
-	}
-
-	inline bool FoundMatchingPickup()
-	{
-		return m_FoundMatchingPickup;
-	}
-
-protected:
-	bool m_FoundMatchingPickup;
-
-	Vector3d m_Position;
-	cPickup * m_Pickup;
-};
+#include "../BlockEntities/HopperEntity.h"
 
 
 
@@ -102,6 +31,7 @@ cPickup::cPickup(Vector3d a_Pos, const cItem & a_Item, bool IsPlayerCreated, Vec
 	m_bCollected(false),
 	m_bIsPlayerCreated(IsPlayerCreated),
 	m_bCanCombine(a_CanCombine),
+	m_bShouldTryCombining(true),
 	m_Lifetime(cTickTime(a_LifetimeTicks))
 {
 	SetGravity(-16.0f);
@@ -148,6 +78,30 @@ void cPickup::Tick(std::chrono::milliseconds a_Dt, cChunk & a_Chunk)
 			// Position might have changed due to physics. So we have to make sure we have the correct chunk.
 			GET_AND_VERIFY_CURRENT_CHUNK(CurrentChunk, BlockX, BlockZ);
 
+			if (m_LastPosition != GetPosition())
+			{
+				m_LastPosition = GetPosition();
+
+				// Moved, look for pickups to combine with again:
+				m_bShouldTryCombining = true;
+
+				// Let the hopper below suck the pickup in:
+				if (BlockY > 0)
+				{
+					const auto RelPos = cChunkDef::AbsoluteToRelative({BlockX, BlockY - 1, BlockZ});
+					const auto BlockEntity = CurrentChunk->GetBlockEntityRel(RelPos);
+					if ((BlockEntity != nullptr) && (BlockEntity->GetBlockType() == BlockType::Hopper))
+					{
+						static_cast<cHopperEntity *>(BlockEntity)->OnPickupEntered(*this);
+						if (!IsTicking())
+						{
+							// All of the pickup went into the hopper
+							return;
+						}
+					}
+				}
+			}
+
 			// Destroy the pickup if it is on fire:
 			if (IsOnFire())
 			{
@@ -160,20 +114,6 @@ void cPickup::Tick(std::chrono::milliseconds a_Dt, cChunk & a_Chunk)
 					return;
 				}
 			}
-
-			// Try to combine the pickup with adjacent same-item pickups:
-			if ((m_Item.m_ItemCount < m_Item.GetMaxStackSize()) && IsOnGround() && CanCombine())  // Don't combine if already full or not on ground
-			{
-				// By using a_Chunk's ForEachEntity() instead of cWorld's, pickups don't combine across chunk boundaries.
-				// That is a small price to pay for not having to traverse the entire world for each entity.
-				// The speedup in the tick thread is quite considerable.
-				cPickupCombiningCallback PickupCombiningCallback(GetPosition(), this);
-				a_Chunk.ForEachEntity(PickupCombiningCallback);
-				if (PickupCombiningCallback.FoundMatchingPickup())
-				{
-					m_World->BroadcastEntityMetadata(*this);
-				}
-			}
 		}
 	}
 	else
@@ -196,6 +136,58 @@ void cPickup::Tick(std::chrono::milliseconds a_Dt, cChunk & a_Chunk)
 
 
 
+bool cPickup::TryCombineWith(cPickup & a_Other)
+{
+	ASSERT(&a_Other != this);
+	ASSERT(a_Other.GetUniqueID() > GetUniqueID());
+
+	if (
+		!IsTicking() || !a_Other.IsTicking() ||
+		m_bCollected || a_Other.m_bCollected ||
+		!CanCombine() || !a_Other.CanCombine() ||
+		!IsOnGround() || !a_Other.IsOnGround() ||
+		(m_Item.m_ItemCount >= m_Item.GetMaxStackSize())
+	)
+	{
+		return false;
+	}
+
+	if (((a_Other.GetPosition() - GetPosition()).SqrLength() >= 1.2 * 1.2) || !a_Other.m_Item.IsEqual(m_Item))
+	{
+		return false;
+	}
+
+	auto CombineCount = std::min(static_cast<short>(a_Other.m_Item.m_ItemCount), static_cast<short>(m_Item.GetMaxStackSize() - m_Item.m_ItemCount));
+	if (CombineCount <= 0)
+	{
+		return false;
+	}
+
+	m_Item.AddCount(static_cast<char>(CombineCount));
+	a_Other.m_Item.m_ItemCount -= static_cast<char>(CombineCount);
+
+	if (a_Other.m_Item.m_ItemCount <= 0)
+	{
+		// m_World->BroadcastCollectEntity(a_Other, *this, static_cast<unsigned>(CombineCount));  // Disabled because it crashes new clients
+		a_Other.Destroy();
+
+		// Reset the timer
+		SetAge(0);
+	}
+	else
+	{
+		// The other pickup may now combine with more pickups:
+		a_Other.m_bShouldTryCombining = true;
+		m_World->BroadcastEntityMetadata(a_Other);
+	}
+	m_World->BroadcastEntityMetadata(*this);
+	return true;
+}
+
+
+
+
+
 bool cPickup::DoTakeDamage(TakeDamageInfo & a_TDI)
 {
 	if (a_TDI.DamageType == dtCactusContact)
@@ -1,6 +1,8 @@
 
 #pragma once
 
+#include <optional>
+
 #include "Entity.h"
 #include "../Item.h"
 
@@ -45,7 +47,7 @@ public:  // tolua_export
 	bool CanCombine(void) const { return m_bCanCombine; }  // tolua_export
 
 	/** Sets whether this pickup is allowed to combine with other similar pickups */
-	void SetCanCombine(bool a_CanCombine) { m_bCanCombine = a_CanCombine; }  // tolua_export
+	void SetCanCombine(bool a_CanCombine) { m_bCanCombine = a_CanCombine; m_bShouldTryCombining = true; }  // tolua_export
 
 	/** Returns the number of ticks that this entity has existed */
 	int GetAge(void) const { return std::chrono::duration_cast<cTickTime>(m_Timer).count(); }     // tolua_export
@@ -65,6 +67,18 @@ public:  // tolua_export
 	/** Returns true if created by player (i.e. vomiting), used for determining picking-up delay time */
 	bool IsPlayerCreated(void) const { return m_bIsPlayerCreated; }  // tolua_export
 
+	/** Returns true if the pickup has moved or changed since its chunk last looked for pickups to combine it with.
+	Pickups at rest don't look for others, they are only combined when another pickup comes close to them. */
+	bool ShouldTryCombining(void) const { return m_bShouldTryCombining; }
+
+	/** Puts the pickup to rest, until it moves or changes again. Called by the chunk once it has tried combining the pickup. */
+	void StopTryingCombining(void) { m_bShouldTryCombining = false; }
+
+	/** Moves as many items from a_Other into this pickup as fit, if the two pickups can combine and are close enough.
+	The pickup with the lower ID always receives the items, so a_Other must have a higher ID.
+	Destroys a_Other if it gets empty. Returns true if any items were moved. */
+	bool TryCombineWith(cPickup & a_Other);
+
 private:
 
 	/** The number of ticks that the entity has existed / timer between collect and destroy; in msec */
@@ -78,5 +92,11 @@ private:
 
 	bool m_bCanCombine;
 
+	/** Set when the pickup moves or changes, cleared by the chunk's combining pass. */
+	bool m_bShouldTryCombining;
+
 	std::chrono::milliseconds m_Lifetime;
+
+	/** The position in the previous tick, to detect the pickup moving into the space above a hopper and coming to rest. */
+	std::optional<Vector3d> m_LastPosition;
 };  // tolua_export
@@ -1620,25 +1620,17 @@ bool cPlayer::HasPermission(const AString & a_Permission) const
 		return true;
 	}
 
-	AStringVector Split = StringSplit(a_Permission, ".");
-
-	// Iterate over all restrictions; if any matches, then return failure:
-	for (auto & Restriction: m_SplitRestrictions)
+	// If any restriction matches, then return failure:
+	if (m_RestrictionTrie.Matches(a_Permission))
 	{
-		if (PermissionMatches(Split, Restriction))
-		{
-			return false;
-		}
-	}  // for Restriction - m_SplitRestrictions[]
+		return false;
+	}
 
-	// Iterate over all granted permissions; if any matches, then return success:
-	for (auto & Permission: m_SplitPermissions)
+	// If any granted permission matches, then return success:
+	if (m_PermissionTrie.Matches(a_Permission))
 	{
-		if (PermissionMatches(Split, Permission))
-		{
-			return true;
-		}
-	}  // for Permission - m_SplitPermissions[]
+		return true;
+	}
 
 	// No granted permission matches
 	return false;
@@ -2099,7 +2091,7 @@ void cPlayer::UseItem(int a_SlotNumber, short a_Damage)
 	}
 
 	// Ref: https://minecraft.wiki/w/Enchanting#Unbreaking
-	unsigned int UnbreakingLevel = Item.m_Enchantments.GetLevel(cEnchantments::enchUnbreaking);
+	unsigned int UnbreakingLevel = Item.GetEnchantments().GetLevel(cEnchantments::enchUnbreaking);
 	double chance = ItemCategory::IsArmor(Item.m_ItemType)
 		? (0.6 + (0.4 / (UnbreakingLevel + 1))) : (1.0 / (UnbreakingLevel + 1));
 
@@ -2648,7 +2640,7 @@ float cPlayer::GetDigSpeed(BlockState a_Block)
 	{
 		if (MiningSpeed > 1.0f)  // If the base multiplier for this block is greater than 1, now we can check enchantments
 		{
-			unsigned int EfficiencyModifier = GetEquippedItem().m_Enchantments.GetLevel(cEnchantments::eEnchantment::enchEfficiency);
+			unsigned int EfficiencyModifier = GetEquippedItem().GetEnchantments().GetLevel(cEnchantments::eEnchantment::enchEfficiency);
 			if (EfficiencyModifier > 0)  // If an efficiency enchantment is present, apply formula as on wiki
 			{
 				MiningSpeed += (EfficiencyModifier * EfficiencyModifier) + 1;
@@ -2684,7 +2676,7 @@ float cPlayer::GetDigSpeed(BlockState a_Block)
 	}
 
 	// 5x speed loss for being in water
-	if (IsInsideWater() && GetEquippedItem().m_Enchantments.GetLevel(cEnchantments::eEnchantment::enchAquaAffinity) <= 0)
+	if (IsInsideWater() && GetEquippedItem().GetEnchantments().GetLevel(cEnchantments::eEnchantment::enchAquaAffinity) <= 0)
 	{
 		MiningSpeed /= 5.0f;
 	}
@@ -2851,21 +2843,9 @@ void cPlayer::RefreshRank()
 	m_Restrictions = RankMgr->GetPlayerRestrictions(UUID);
 	RankMgr->GetRankVisuals(m_Rank, m_MsgPrefix, m_MsgSuffix, m_MsgNameColorCode);
 
-	// Break up the individual permissions on each dot, into m_SplitPermissions:
-	m_SplitPermissions.clear();
-	m_SplitPermissions.reserve(m_Permissions.size());
-	for (auto & Permission : m_Permissions)
-	{
-		m_SplitPermissions.push_back(StringSplit(Permission, "."));
-	}
-
-	// Break up the individual restrictions on each dot, into m_SplitRestrictions:
-	m_SplitRestrictions.clear();
-	m_SplitRestrictions.reserve(m_Restrictions.size());
-	for (auto & Restriction : m_Restrictions)
-	{
-		m_SplitRestrictions.push_back(StringSplit(Restriction, "."));
-	}
+	// Compile the permissions and restrictions for HasPermission():
+	m_PermissionTrie.Assign(m_Permissions);
+	m_RestrictionTrie.Assign(m_Restrictions);
 }
 
 
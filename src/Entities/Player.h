@@ -6,6 +6,7 @@
 #include "../Defines.h"
 #include "../World.h"
 #include "../Items/ItemHandler.h"
+#include "../PermissionTrie.h"
 
 #include "../StatisticsManager.h"
 
@@ -613,8 +614,6 @@ public:
 
 private:
 
-	typedef std::vector<std::vector<AString> > AStringVectorVector;
-
 	/** The current body stance the player has adopted. */
 	std::variant<BodyStanceCrouching, BodyStanceSleeping, BodyStanceSprinting, BodyStanceStanding, BodyStanceGliding> m_BodyStance;
 
@@ -627,13 +626,13 @@ private:
 	/** All the restrictions that this player has, based on their rank. */
 	AStringVector m_Restrictions;
 
-	/** All the permissions that this player has, based on their rank, split into individual dot-delimited parts.
-	This is used mainly by the HasPermission() function to optimize the lookup. */
-	AStringVectorVector m_SplitPermissions;
+	/** All the permissions that this player has, based on their rank, compiled into a trie.
+	This is used by the HasPermission() function to optimize the lookup. */
+	cPermissionTrie m_PermissionTrie;
 
-	/** All the restrictions that this player has, based on their rank, split into individual dot-delimited parts.
-	This is used mainly by the HasPermission() function to optimize the lookup. */
-	AStringVectorVector m_SplitRestrictions;
+	/** All the restrictions that this player has, based on their rank, compiled into a trie.
+	This is used by the HasPermission() function to optimize the lookup. */
+	cPermissionTrie m_RestrictionTrie;
 
 	// Message visuals:
 	AString m_MsgPrefix, m_MsgSuffix;
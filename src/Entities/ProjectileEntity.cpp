@@ -224,7 +224,7 @@ cProjectileEntity::cProjectileEntity(eKind a_Kind, cEntity * a_Creator, Vector3d
 	m_CreatorData(
 		((a_Creator != nullptr) ? a_Creator->GetUniqueID() : cEntity::INVALID_ID),
 		((a_Creator != nullptr) ? (a_Creator->IsPlayer() ? static_cast<cPlayer *>(a_Creator)->GetName() : "") : ""),
-		((a_Creator != nullptr) ? a_Creator->GetEquippedWeapon().m_Enchantments : cEnchantments())
+		((a_Creator != nullptr) ? a_Creator->GetEquippedWeapon().GetEnchantments() : cEnchantments())
 	),
 	m_IsInGround(false)
 {
@@ -276,7 +276,7 @@ std::unique_ptr<cProjectileEntity> cProjectileEntity::Create(
 		case pkFirework:
 		{
 			ASSERT(a_Item != nullptr);
-			if (a_Item->m_FireworkItem.m_Colours.empty())
+			if (a_Item->GetFireworkItem().m_Colours.empty())
 			{
 				return nullptr;
 			}
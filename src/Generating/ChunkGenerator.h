@@ -2,6 +2,7 @@
 
 #include "../Defines.h"
 #include "ChunkDef.h"
+#include "GenCache.h"
 
 
 
@@ -42,6 +43,10 @@ public:
 	/** Returns the seed that was read from the INI file. */
 	int GetSeed(void) const { return m_Seed; }
 
+	/** Adds the statistics of the generator's caches to a_Stats, under the caches' names.
+	May be called from any thread while the generator is running. The default implementation has no caches. */
+	virtual void GetCacheStats(cGenCacheStatsMap & a_Stats) const {}
+
 	/** Creates and initializes the entire generator based on the settings in the INI file.
 	Initializes the generator, so that it can be used immediately after this call returns. */
 	static std::unique_ptr<cChunkGenerator> CreateFromIniFile(cIniFile & a_IniFile);
@@ -345,31 +345,8 @@ void cCompoGenNether::InitializeCompoGen(cIniFile & a_IniFile)
 
 cCompoGenCache::cCompoGenCache(std::unique_ptr<cTerrainCompositionGen> a_Underlying, int a_CacheSize) :
 	m_Underlying(std::move(a_Underlying)),
-	m_CacheSize(a_CacheSize),
-	m_CacheOrder(new int[ToUnsigned(a_CacheSize)]),
-	m_CacheData(new sCacheData[ToUnsigned(a_CacheSize)]),
-	m_NumHits(0),
-	m_NumMisses(0),
-	m_TotalChain(0)
+	m_Cache(static_cast<size_t>(std::max(a_CacheSize, 1)))
 {
-	for (int i = 0; i < m_CacheSize; i++)
-	{
-		m_CacheOrder[i] = i;
-		m_CacheData[i].m_ChunkX = 0x7fffffff;
-		m_CacheData[i].m_ChunkZ = 0x7fffffff;
-	}
-}
-
-
-
-
-
-cCompoGenCache::~cCompoGenCache()
-{
-	delete[] m_CacheData;
-	m_CacheData = nullptr;
-	delete[] m_CacheOrder;
-	m_CacheOrder = nullptr;
 }
 
 
@@ -378,60 +355,26 @@ cCompoGenCache::~cCompoGenCache()
 
 void cCompoGenCache::ComposeTerrain(cChunkDesc & a_ChunkDesc, const cChunkDesc::Shape & a_Shape)
 {
-	#ifndef NDEBUG
-	if (((m_NumHits + m_NumMisses) % 1024) == 10)
-	{
-		// LOGD("CompoGenCache: %d hits, %d misses, saved %.2f %%", m_NumHits, m_NumMisses, 100.0 * m_NumHits / (m_NumHits + m_NumMisses));
-		// LOGD("CompoGenCache: Avg cache chain length: %.2f", static_cast<float>(m_TotalChain) / m_NumHits);
-	}
-	#endif  // !NDEBUG
-
-	int ChunkX = a_ChunkDesc.GetChunkX();
-	int ChunkZ = a_ChunkDesc.GetChunkZ();
-
-	for (int i = 0; i < m_CacheSize; i++)
-	{
-		if (
-			(m_CacheData[m_CacheOrder[i]].m_ChunkX != ChunkX) ||
-			(m_CacheData[m_CacheOrder[i]].m_ChunkZ != ChunkZ)
-		)
-		{
-			continue;
-		}
-		// Found it in the cache
-		int Idx = m_CacheOrder[i];
-
-		// Move to front:
-		for (int j = i; j > 0; j--)
+	const cChunkCoords Coords(a_ChunkDesc.GetChunkX(), a_ChunkDesc.GetChunkZ());
+	const bool IsCached = m_Cache.Find(Coords, [&a_ChunkDesc](const sCacheData & a_Cached)
 		{
-			m_CacheOrder[j] = m_CacheOrder[j - 1];
+			memcpy(a_ChunkDesc.GetBlocks(),           a_Cached.m_BlockTypes,        sizeof(a_ChunkDesc.GetBlocks()));
+			memcpy(a_ChunkDesc.GetHeightMap().data(), a_Cached.m_HeightMap.data(),  sizeof(a_ChunkDesc.GetHeightMap()));
 		}
-		m_CacheOrder[0] = Idx;
-
-		// Use the cached data:
-		memcpy(a_ChunkDesc.GetBlocks(),             m_CacheData[Idx].m_BlockTypes,        sizeof(a_ChunkDesc.GetBlocks()));
-		memcpy(a_ChunkDesc.GetHeightMap().data(),   m_CacheData[Idx].m_HeightMap.data(),  sizeof(a_ChunkDesc.GetHeightMap()));
-
-		m_NumHits++;
-		m_TotalChain += i;
+	);
+	if (IsCached)
+	{
 		return;
-	}  // for i - cache
+	}
 
 	// Not in the cache:
-	m_NumMisses++;
 	m_Underlying->ComposeTerrain(a_ChunkDesc, a_Shape);
-
-	// Insert it as the first item in the MRU order:
-	int Idx = m_CacheOrder[m_CacheSize - 1];
-	for (int i = m_CacheSize - 1; i > 0; i--)
-	{
-		m_CacheOrder[i] = m_CacheOrder[i - 1];
-	}  // for i - m_CacheOrder[]
-	m_CacheOrder[0] = Idx;
-	memcpy(m_CacheData[Idx].m_BlockTypes,        a_ChunkDesc.GetBlocks(),           sizeof(a_ChunkDesc.GetBlocks()));
-	memcpy(m_CacheData[Idx].m_HeightMap.data(),  a_ChunkDesc.GetHeightMap().data(), sizeof(a_ChunkDesc.GetHeightMap()));
-	m_CacheData[Idx].m_ChunkX = ChunkX;
-	m_CacheData[Idx].m_ChunkZ = ChunkZ;
+	m_Cache.Insert(Coords, [&a_ChunkDesc](sCacheData & a_Cached)
+		{
+			memcpy(a_Cached.m_BlockTypes,        a_ChunkDesc.GetBlocks(),           sizeof(a_ChunkDesc.GetBlocks()));
+			memcpy(a_Cached.m_HeightMap.data(),  a_ChunkDesc.GetHeightMap().data(), sizeof(a_ChunkDesc.GetHeightMap()));
+		}
+	);
 }
 
 
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "ComposableGenerator.h"
+#include "GenCache.h"
 #include "../Noise/Noise.h"
 
 
@@ -110,37 +111,28 @@ protected:
 
 
 
-/** Caches most-recently-used chunk composition of another composition generator. Caches only the types and metas */
+/** Caches the recently used chunk compositions of another composition generator. Caches only the blocks and the heightmap. */
 class cCompoGenCache :
 	public cTerrainCompositionGen
 {
 public:
 	cCompoGenCache(std::unique_ptr<cTerrainCompositionGen> a_Underlying, int a_CacheSize);
-	virtual ~cCompoGenCache() override;
 
 	// cTerrainCompositionGen override:
 	virtual void ComposeTerrain(cChunkDesc & a_ChunkDesc, const cChunkDesc::Shape & a_Shape) override;
 	virtual void InitializeCompoGen(cIniFile & a_IniFile) override;
 
+	sGenCacheStats GetCacheStats(void) const { return m_Cache.GetStats(); }
+
 protected:
 
 	std::unique_ptr<cTerrainCompositionGen> m_Underlying;
 
 	struct sCacheData
 	{
-		int m_ChunkX;
-		int m_ChunkZ;
 		cChunkDef::BlockStates       m_BlockTypes;
 		cChunkDef::HeightMap         m_HeightMap;
 	} ;
 
-	// To avoid moving large amounts of data for the MRU behavior, we MRU-ize indices to an array of the actual data
-	int          m_CacheSize;
-	int *        m_CacheOrder;  // MRU-ized order, indices into m_CacheData array
-	sCacheData * m_CacheData;   // m_CacheData[m_CacheOrder[0]] is the most recently used
-
-	// Cache statistics
-	int m_NumHits;
-	int m_NumMisses;
-	int m_TotalChain;  // Number of cache items walked to get to a hit (only added for hits)
+	cGenCache<sCacheData> m_Cache;
 } ;
@@ -118,7 +118,10 @@ std::unique_ptr<cTerrainCompositionGen> cTerrainCompositionGen::CreateCompositio
 cComposableGenerator::cComposableGenerator():
 	m_BiomeGen(),
 	m_ShapeGen(),
-	m_CompositionGen()
+	m_CompositionGen(),
+	m_BiomeGenCache(nullptr),
+	m_CompositionGenCache(nullptr),
+	m_CompositedHeightMultiCache(nullptr)
 {
 }
 
@@ -155,6 +158,26 @@ void cComposableGenerator::GenerateBiomes(cChunkCoords a_ChunkCoords, cChunkDef:
 
 
 
+void cComposableGenerator::GetCacheStats(cGenCacheStatsMap & a_Stats) const
+{
+	if (m_BiomeGenCache != nullptr)
+	{
+		a_Stats["Biomes"] += m_BiomeGenCache->GetCacheStats();
+	}
+	if (m_CompositionGenCache != nullptr)
+	{
+		a_Stats["Composition"] += m_CompositionGenCache->GetCacheStats();
+	}
+	if (m_CompositedHeightMultiCache != nullptr)
+	{
+		a_Stats["Composited heights"] += m_CompositedHeightMultiCache->GetCacheStats();
+	}
+}
+
+
+
+
+
 void cComposableGenerator::Generate(cChunkDesc & a_ChunkDesc)
 {
 	if (a_ChunkDesc.IsUsingDefaultBiomes())
@@ -304,12 +327,10 @@ void cComposableGenerator::InitBiomeGen(cIniFile & a_IniFile)
 	if (MultiCacheLength > 0)
 	{
 		LOGD("Enabling multicache for biomegen of length %d.", MultiCacheLength);
-		m_BiomeGen = std::make_unique<cBioGenMulticache>(std::move(m_BiomeGen), static_cast<size_t>(CacheSize), static_cast<size_t>(MultiCacheLength));
-	}
-	else
-	{
-		m_BiomeGen = std::make_unique<cBioGenMulticache>(std::move(m_BiomeGen), static_cast<size_t>(CacheSize), 1);
 	}
+	auto Cache = std::make_unique<cBioGenMulticache>(std::move(m_BiomeGen), static_cast<size_t>(CacheSize), static_cast<size_t>(std::max(MultiCacheLength, 1)));
+	m_BiomeGenCache = Cache.get();
+	m_BiomeGen = std::move(Cache);
 }
 
 
@@ -363,12 +384,16 @@ void cComposableGenerator::InitCompositionGen(cIniFile & a_IniFile)
 	int CompoGenCacheSize = a_IniFile.GetValueSetI("Generator", "CompositionGenCacheSize", 64);
 	if (CompoGenCacheSize > 0)
 	{
-		m_CompositionGen = std::make_unique<cCompoGenCache>(std::move(m_CompositionGen), CompoGenCacheSize);
+		auto Cache = std::make_unique<cCompoGenCache>(std::move(m_CompositionGen), CompoGenCacheSize);
+		m_CompositionGenCache = Cache.get();
+		m_CompositionGen = std::move(Cache);
 	}
 
 	// Create a cache of the composited heightmaps, so that finishers may use it:
-	m_CompositedHeightCache = std::make_unique<cHeiGenMultiCache>(std::make_unique<cCompositedHeiGen>(*m_BiomeGen, *m_ShapeGen, *m_CompositionGen), 16, 128);
+	auto HeightCache = std::make_unique<cHeiGenMultiCache>(std::make_unique<cCompositedHeiGen>(*m_BiomeGen, *m_ShapeGen, *m_CompositionGen), 16, 128);
 	// 128 subcaches of depth 16 each = 0.5 MiB of RAM. Acceptable, for the amount of work this saves.
+	m_CompositedHeightMultiCache = HeightCache.get();
+	m_CompositedHeightCache = std::move(HeightCache);
 }
 
 
@@ -30,6 +30,9 @@ class cTerrainShapeGen;
 class cTerrainHeightGen;
 class cTerrainCompositionGen;
 class cFinishGen;
+class cBioGenMulticache;
+class cCompoGenCache;
+class cHeiGenMultiCache;
 
 
 
@@ -206,6 +209,7 @@ public:
 	virtual void Initialize(cIniFile & a_IniFile) override;
 	virtual void GenerateBiomes(cChunkCoords a_ChunkCoords, cChunkDef::BiomeMap & a_BiomeMap) override;
 	virtual void Generate(cChunkDesc & a_ChunkDesc) override;
+	virtual void GetCacheStats(cGenCacheStatsMap & a_Stats) const override;
 
 	/** If there's no particular sub-generator set in the INI file,
 	adds the default one, based on the dimension. */
@@ -230,6 +234,11 @@ protected:
 	/** The finisher generators, in the order in which they are applied. */
 	std::vector<std::unique_ptr<cFinishGen>> m_FinishGens;
 
+	// The caches within the generators above, for their statistics; nullptr if not used:
+	const cBioGenMulticache * m_BiomeGenCache;
+	const cCompoGenCache * m_CompositionGenCache;
+	const cHeiGenMultiCache * m_CompositedHeightMultiCache;
+
 
 	/** Reads the BiomeGen settings from the ini and initializes m_BiomeGen accordingly */
 	void InitBiomeGen(cIniFile & a_IniFile);
@@ -98,7 +98,6 @@ void cEndGen::PrepareState(cChunkCoords a_ChunkCoords)
 void cEndGen::GenerateNoiseArray(void)
 {
 	NOISE_DATATYPE NoiseData[DIM_X * DIM_Y * DIM_Z];  // [x + DIM_X * z + DIM_X * DIM_Z * y]
-	NOISE_DATATYPE Workspace[DIM_X * DIM_Y * DIM_Z];  // [x + DIM_X * z + DIM_X * DIM_Z * y]
 
 	// Choose the frequency to use depending on the distance from spawn.
 	auto distanceFromSpawn = cChunkDef::RelativeToAbsolute({ cChunkDef::Width / 2, 0, cChunkDef::Width / 2 }, m_LastChunkCoords).Length();
@@ -113,7 +112,7 @@ void cEndGen::GenerateNoiseArray(void)
 	auto EndZ   = static_cast<NOISE_DATATYPE>((m_LastChunkCoords.m_ChunkZ + 1) * cChunkDef::Width) / frequencyZ;
 	auto StartY = 0.0f;
 	auto EndY   = static_cast<NOISE_DATATYPE>(cChunkDef::Height) / frequencyY;
-	m_Perlin.Generate3D(NoiseData, DIM_X, DIM_Z, DIM_Y, StartX, EndX, StartZ, EndZ, StartY, EndY, Workspace);
+	m_Perlin.Generate3D(NoiseData, DIM_X, DIM_Z, DIM_Y, StartX, EndX, StartZ, EndZ, StartY, EndY);
 
 	// Add distance:
 	for (int y = 0; y < DIM_Y; y++)
@@ -0,0 +1,378 @@
+
+// GenCache.h
+
+// Declares the cGenCache and cGenCacheConcurrent class templates, the per-chunk caches used by the generators
+
+/*
+The cache maps chunk coords to a fixed-size value (a biome map, a heightmap, ...). It has a fixed capacity,
+all the entries are allocated upfront. The entries are found through an open-addressing (linear probing) index
+of twice the capacity, so a lookup is a hash and usually one or two probes, regardless of the cache size.
+When the cache is full, the CLOCK algorithm picks the entry to evict: a hit only sets the entry's "referenced" flag,
+the clock hand sweeps over the entries, clearing the flags, and evicts the first entry that hasn't been referenced
+since the last sweep. This approximates LRU without reordering anything on hits.
+*/
+
+
+
+
+
+#pragma once
+
+#include "../ChunkDef.h"
+
+
+
+
+
+/** The statistics of a single generator cache, or a sum of several. */
+struct sGenCacheStats
+{
+	UInt64 m_NumHits = 0;
+	UInt64 m_NumMisses = 0;
+	UInt64 m_NumEvictions = 0;
+
+	sGenCacheStats & operator += (const sGenCacheStats & a_Other)
+	{
+		m_NumHits += a_Other.m_NumHits;
+		m_NumMisses += a_Other.m_NumMisses;
+		m_NumEvictions += a_Other.m_NumEvictions;
+		return *this;
+	}
+
+	/** Returns the percentage of the lookups that were hits. */
+	double GetHitRate(void) const
+	{
+		const auto NumLookups = m_NumHits + m_NumMisses;
+		return (NumLookups == 0) ? 0 : (100.0 * static_cast<double>(m_NumHits) / static_cast<double>(NumLookups));
+	}
+};
+
+/** The named statistics of the caches of a generator, summed over all its instances. */
+using cGenCacheStatsMap = std::map<AString, sGenCacheStats>;
+
+
+
+
+
+/** A fixed-capacity cache of per-chunk values with hash lookups and CLOCK eviction.
+Not thread-safe, use cGenCacheConcurrent for caches shared between threads.
+The statistics may be read from any thread. */
+template <typename T>
+class cGenCache
+{
+public:
+
+	cGenCache(size_t a_Capacity) :
+		m_Entries(std::max<size_t>(a_Capacity, 1)),
+		m_SlotBits(1),
+		m_ClockHand(0),
+		m_NumUsed(0),
+		m_NumHits(0),
+		m_NumMisses(0),
+		m_NumEvictions(0)
+	{
+		// Keep the index at most half full, so that the probe chains stay short:
+		while ((static_cast<size_t>(1) << m_SlotBits) < m_Entries.size() * 2)
+		{
+			m_SlotBits++;
+		}
+		m_SlotMask = (static_cast<size_t>(1) << m_SlotBits) - 1;
+		m_Slots.assign(m_SlotMask + 1, EMPTY_SLOT);
+	}
+
+
+	/** If the value for the chunk is cached, calls a_Callback(const T &) with it and returns true.
+	Returns false if not cached. Counts the hit or miss. */
+	template <typename Fn>
+	bool Find(cChunkCoords a_Coords, Fn && a_Callback)
+	{
+		const auto Idx = m_Slots[FindSlot(a_Coords)];
+		if (Idx == EMPTY_SLOT)
+		{
+			Increment(m_NumMisses);
+			return false;
+		}
+		Increment(m_NumHits);
+		m_Entries[Idx].m_IsReferenced = true;
+		a_Callback(static_cast<const T &>(m_Entries[Idx].m_Value));
+		return true;
+	}
+
+
+	/** Same as Find(), but doesn't count towards the statistics.
+	Used for the queries that don't generate the value if it isn't cached. */
+	template <typename Fn>
+	bool Peek(cChunkCoords a_Coords, Fn && a_Callback)
+	{
+		const auto Idx = m_Slots[FindSlot(a_Coords)];
+		if (Idx == EMPTY_SLOT)
+		{
+			return false;
+		}
+		m_Entries[Idx].m_IsReferenced = true;
+		a_Callback(static_cast<const T &>(m_Entries[Idx].m_Value));
+		return true;
+	}
+
+
+	/** Stores the value for the chunk, calls a_Fill(T &) to write it into the cache.
+	Evicts another chunk's value if the cache is full. If the chunk is already cached, its value is overwritten. */
+	template <typename Fn>
+	void Insert(cChunkCoords a_Coords, Fn && a_Fill)
+	{
+		auto Slot = FindSlot(a_Coords);
+		if (m_Slots[Slot] == EMPTY_SLOT)
+		{
+			UInt32 Idx;
+			if (m_NumUsed < m_Entries.size())
+			{
+				Idx = static_cast<UInt32>(m_NumUsed++);
+			}
+			else
+			{
+				// Removing the victim may move other chunks in the index, look the slot up again:
+				Idx = Evict();
+				Slot = FindSlot(a_Coords);
+			}
+			m_Slots[Slot] = Idx;
+			m_Entries[Idx].m_Coords = a_Coords;
+		}
+		auto & Entry = m_Entries[m_Slots[Slot]];
+		Entry.m_IsReferenced = false;
+		a_Fill(Entry.m_Value);
+	}
+
+
+	/** Copies the cached value for the chunk into a_Value; on a miss, calls a_Generate(T &) to generate a_Value and caches it. */
+	template <typename Fn>
+	void GetOrGenerate(cChunkCoords a_Coords, T & a_Value, Fn && a_Generate)
+	{
+		if (Find(a_Coords, [&a_Value](const T & a_Cached) { a_Value = a_Cached; }))
+		{
+			return;
+		}
+		a_Generate(a_Value);
+		Insert(a_Coords, [&a_Value](T & a_Cached) { a_Cached = a_Value; });
+	}
+
+
+	/** Returns the number of chunks that the cache can hold. */
+	size_t GetCapacity(void) const { return m_Entries.size(); }
+
+
+	sGenCacheStats GetStats(void) const
+	{
+		sGenCacheStats Res;
+		Res.m_NumHits = m_NumHits.load(std::memory_order_relaxed);
+		Res.m_NumMisses = m_NumMisses.load(std::memory_order_relaxed);
+		Res.m_NumEvictions = m_NumEvictions.load(std::memory_order_relaxed);
+		return Res;
+	}
+
+
+	/** Returns the hash of the chunk coords; the top bits are the best distributed ones. */
+	static UInt64 HashCoords(cChunkCoords a_Coords)
+	{
+		const auto Key = (static_cast<UInt64>(static_cast<UInt32>(a_Coords.m_ChunkX)) << 32) | static_cast<UInt32>(a_Coords.m_ChunkZ);
+		return (Key ^ (Key >> 29)) * 0x9e3779b97f4a7c15ULL;
+	}
+
+protected:
+
+	struct sEntry
+	{
+		cChunkCoords m_Coords;
+
+		/** Set on each hit, cleared by the clock hand. */
+		bool m_IsReferenced;
+
+		T m_Value;
+
+		sEntry(void) :
+			m_Coords(0x7fffffff, 0x7fffffff),
+			m_IsReferenced(false)
+		{
+		}
+	};
+
+	/** The marker for an unused index slot. */
+	static constexpr UInt32 EMPTY_SLOT = std::numeric_limits<UInt32>::max();
+
+	/** The entries, allocated upfront; only the first m_NumUsed are valid. */
+	std::vector<sEntry> m_Entries;
+
+	/** The open-addressing index, each slot is either EMPTY_SLOT or an index into m_Entries. */
+	std::vector<UInt32> m_Slots;
+
+	/** Log2 of the number of slots. */
+	unsigned m_SlotBits;
+
+	size_t m_SlotMask;
+
+	/** The entry to be considered for eviction next. */
+	size_t m_ClockHand;
+
+	/** Number of entries that have been filled in. */
+	size_t m_NumUsed;
+
+	// Statistics; written only by the thread owning the cache (or holding its lock), readable from any thread:
+	std::atomic<UInt64> m_NumHits;
+	std::atomic<UInt64> m_NumMisses;
+	std::atomic<UInt64> m_NumEvictions;
+
+
+	/** Increments the counter; only a single thread writes it, so it needs no locked instruction. */
+	static void Increment(std::atomic<UInt64> & a_Counter)
+	{
+		a_Counter.store(a_Counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+
+
+	/** Returns the slot where the chunk should be in the index. */
+	size_t GetHomeSlot(cChunkCoords a_Coords) const
+	{
+		return static_cast<size_t>(HashCoords(a_Coords) >> (64 - m_SlotBits));
+	}
+
+
+	/** Returns the index slot that holds the chunk, or the empty slot where it would be inserted. */
+	size_t FindSlot(cChunkCoords a_Coords) const
+	{
+		auto Slot = GetHomeSlot(a_Coords);
+		while ((m_Slots[Slot] != EMPTY_SLOT) && (m_Entries[m_Slots[Slot]].m_Coords != a_Coords))
+		{
+			Slot = (Slot + 1) & m_SlotMask;
+		}
+		return Slot;
+	}
+
+
+	/** Picks an entry using the CLOCK algorithm, removes it from the index and returns its index. */
+	UInt32 Evict(void)
+	{
+		while (m_Entries[m_ClockHand].m_IsReferenced)
+		{
+			m_Entries[m_ClockHand].m_IsReferenced = false;
+			m_ClockHand = (m_ClockHand + 1) % m_Entries.size();
+		}
+		const auto Victim = static_cast<UInt32>(m_ClockHand);
+		m_ClockHand = (m_ClockHand + 1) % m_Entries.size();
+		Increment(m_NumEvictions);
+
+		// Remove from the index, shifting back the following chunks in the probe chain so that no tombstones are needed:
+		auto Hole = FindSlot(m_Entries[Victim].m_Coords);
+		ASSERT(m_Slots[Hole] == Victim);
+		for (auto Slot = (Hole + 1) & m_SlotMask; m_Slots[Slot] != EMPTY_SLOT; Slot = (Slot + 1) & m_SlotMask)
+		{
+			// The chunk may fill the hole only if the hole is between its home slot and its current slot:
+			const auto Home = GetHomeSlot(m_Entries[m_Slots[Slot]].m_Coords);
+			if (((Slot - Home) & m_SlotMask) >= ((Slot - Hole) & m_SlotMask))
+			{
+				m_Slots[Hole] = m_Slots[Slot];
+				Hole = Slot;
+			}
+		}
+		m_Slots[Hole] = EMPTY_SLOT;
+		return Victim;
+	}
+};
+
+
+
+
+
+/** A cGenCache split into shards, each guarded by its own lock, so that it can be shared by multiple threads.
+The callbacks are called while holding the shard's lock, so they should only copy the data.
+The value is generated outside the lock, so two threads missing the same chunk at the same time both generate it. */
+template <typename T>
+class cGenCacheConcurrent
+{
+public:
+
+	cGenCacheConcurrent(size_t a_ShardCapacity, size_t a_NumShards)
+	{
+		m_Shards.reserve(std::max<size_t>(a_NumShards, 1));
+		for (size_t i = 0; i < std::max<size_t>(a_NumShards, 1); i++)
+		{
+			m_Shards.push_back(std::make_unique<sShard>(a_ShardCapacity));
+		}
+	}
+
+
+	/** Same as cGenCache::Find(). */
+	template <typename Fn>
+	bool Find(cChunkCoords a_Coords, Fn && a_Callback)
+	{
+		auto & Shard = GetShard(a_Coords);
+		cCSLock Lock(Shard.m_CS);
+		return Shard.m_Cache.Find(a_Coords, std::forward<Fn>(a_Callback));
+	}
+
+
+	/** Same as cGenCache::Peek(). */
+	template <typename Fn>
+	bool Peek(cChunkCoords a_Coords, Fn && a_Callback)
+	{
+		auto & Shard = GetShard(a_Coords);
+		cCSLock Lock(Shard.m_CS);
+		return Shard.m_Cache.Peek(a_Coords, std::forward<Fn>(a_Callback));
+	}
+
+
+	/** Same as cGenCache::Insert(). */
+	template <typename Fn>
+	void Insert(cChunkCoords a_Coords, Fn && a_Fill)
+	{
+		auto & Shard = GetShard(a_Coords);
+		cCSLock Lock(Shard.m_CS);
+		Shard.m_Cache.Insert(a_Coords, std::forward<Fn>(a_Fill));
+	}
+
+
+	/** Same as cGenCache::GetOrGenerate(); a_Generate is called without holding any lock. */
+	template <typename Fn>
+	void GetOrGenerate(cChunkCoords a_Coords, T & a_Value, Fn && a_Generate)
+	{
+		if (Find(a_Coords, [&a_Value](const T & a_Cached) { a_Value = a_Cached; }))
+		{
+			return;
+		}
+		a_Generate(a_Value);
+		Insert(a_Coords, [&a_Value](T & a_Cached) { a_Cached = a_Value; });
+	}
+
+
+	/** Returns the statistics summed over all the shards. */
+	sGenCacheStats GetStats(void) const
+	{
+		sGenCacheStats Res;
+		for (const auto & Shard: m_Shards)
+		{
+			Res += Shard->m_Cache.GetStats();
+		}
+		return Res;
+	}
+
+protected:
+
+	struct sShard
+	{
+		cCriticalSection m_CS;
+		cGenCache<T> m_Cache;
+
+		sShard(size_t a_Capacity) :
+			m_Cache(a_Capacity)
+		{
+		}
+	};
+
+	std::vector<std::unique_ptr<sShard>> m_Shards;
+
+
+	/** Returns the shard responsible for the chunk.
+	Uses the middle bits of the hash, the top ones select the slot within the shard. */
+	sShard & GetShard(cChunkCoords a_Coords)
+	{
+		return *m_Shards[static_cast<size_t>(cGenCache<T>::HashCoords(a_Coords) >> 24) % m_Shards.size()];
+	}
+};
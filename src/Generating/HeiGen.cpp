@@ -108,17 +108,8 @@ void cHeiGenFlat::InitializeHeightGen(cIniFile & a_IniFile)
 
 cHeiGenCache::cHeiGenCache(cTerrainHeightGen & a_HeiGenToCache, size_t a_CacheSize) :
 	m_HeiGenToCache(a_HeiGenToCache),
-	m_CacheSize(a_CacheSize),
-	m_NumHits(0),
-	m_NumMisses(0),
-	m_TotalChain(0)
+	m_Cache(a_CacheSize)
 {
-	m_CacheOrder.resize(a_CacheSize);
-	m_CacheData.resize(a_CacheSize);
-	for (size_t i = 0; i < m_CacheSize; i++)
-	{
-		m_CacheOrder[i] = i;
-	}
 }
 
 
@@ -127,51 +118,11 @@ cHeiGenCache::cHeiGenCache(cTerrainHeightGen & a_HeiGenToCache, size_t a_CacheSi
 
 void cHeiGenCache::GenHeightMap(cChunkCoords a_ChunkCoords, cChunkDef::HeightMap & a_HeightMap)
 {
-	/*
-	if (((m_NumHits + m_NumMisses) % 1024) == 10)
-	{
-		LOGD("HeiGenCache: %d hits, %d misses, saved %.2f %%", m_NumHits, m_NumMisses, 100.0 * m_NumHits / (m_NumHits + m_NumMisses));
-		LOGD("HeiGenCache: Avg cache chain length: %.2f", static_cast<double>(m_TotalChain) / m_NumHits);
-	}
-	//*/
-
-	for (size_t i = 0; i < m_CacheSize; i++)
-	{
-		if (m_CacheData[m_CacheOrder[i]].m_Coords != a_ChunkCoords)
+	m_Cache.GetOrGenerate(a_ChunkCoords, a_HeightMap, [this, a_ChunkCoords](cChunkDef::HeightMap & a_Generated)
 		{
-			continue;
+			m_HeiGenToCache.GenHeightMap(a_ChunkCoords, a_Generated);
 		}
-		// Found it in the cache
-		auto Idx = m_CacheOrder[i];
-
-		// Move to front:
-		for (size_t j = i; j > 0; j--)
-		{
-			m_CacheOrder[j] = m_CacheOrder[j - 1];
-		}
-		m_CacheOrder[0] = Idx;
-
-		// Use the cached data:
-		memcpy(a_HeightMap.data(), m_CacheData[Idx].m_HeightMap.data(), sizeof(a_HeightMap));
-
-		m_NumHits++;
-		m_TotalChain += i;
-		return;
-	}  // for i - cache
-
-	// Not in the cache:
-	m_NumMisses++;
-	m_HeiGenToCache.GenHeightMap(a_ChunkCoords, a_HeightMap);
-
-	// Insert it as the first item in the MRU order:
-	auto Idx = m_CacheOrder[m_CacheSize - 1];
-	for (auto i = m_CacheSize - 1; i > 0; i--)
-	{
-		m_CacheOrder[i] = m_CacheOrder[i - 1];
-	}  // for i - m_CacheOrder[]
-	m_CacheOrder[0] = Idx;
-	memcpy(m_CacheData[Idx].m_HeightMap.data(), a_HeightMap.data(), sizeof(a_HeightMap));
-	m_CacheData[Idx].m_Coords = a_ChunkCoords;
+	);
 }
 
 
@@ -201,15 +152,11 @@ HEIGHTTYPE cHeiGenCache::GetHeightAt(int a_BlockX, int a_BlockZ)
 
 bool cHeiGenCache::GetHeightAt(int a_ChunkX, int a_ChunkZ, int a_RelX, int a_RelZ, HEIGHTTYPE & a_Height)
 {
-	for (size_t i = 0; i < m_CacheSize; i++)
-	{
-		if ((m_CacheData[i].m_Coords.m_ChunkX == a_ChunkX) && (m_CacheData[i].m_Coords.m_ChunkZ == a_ChunkZ))
+	return m_Cache.Peek({a_ChunkX, a_ChunkZ}, [&a_Height, a_RelX, a_RelZ](const cChunkDef::HeightMap & a_HeightMap)
 		{
-			a_Height = cChunkDef::GetHeight(m_CacheData[i].m_HeightMap, a_RelX, a_RelZ);
-			return true;
+			a_Height = cChunkDef::GetHeight(a_HeightMap, a_RelX, a_RelZ);
 		}
-	}  // for i - m_CacheData[]
-	return false;
+	);
 }
 
 
@@ -220,15 +167,9 @@ bool cHeiGenCache::GetHeightAt(int a_ChunkX, int a_ChunkZ, int a_RelX, int a_Rel
 // cHeiGenMultiCache:
 
 cHeiGenMultiCache::cHeiGenMultiCache(std::unique_ptr<cTerrainHeightGen> a_HeiGenToCache, size_t a_SubCacheSize, size_t a_NumSubCaches):
-	m_NumSubCaches(a_NumSubCaches),
-	m_Underlying(std::move(a_HeiGenToCache))
+	m_Underlying(std::move(a_HeiGenToCache)),
+	m_Cache(a_SubCacheSize, a_NumSubCaches)
 {
-	// Create the individual sub-caches:
-	m_SubCaches.reserve(a_NumSubCaches);
-	for (size_t i = 0; i < a_NumSubCaches; i++)
-	{
-		m_SubCaches.push_back(std::make_unique<cHeiGenCache>(*m_Underlying, a_SubCacheSize));
-	}
 }
 
 
@@ -237,11 +178,11 @@ cHeiGenMultiCache::cHeiGenMultiCache(std::unique_ptr<cTerrainHeightGen> a_HeiGen
 
 void cHeiGenMultiCache::GenHeightMap(cChunkCoords a_ChunkCoords, cChunkDef::HeightMap & a_HeightMap)
 {
-	// Get the subcache responsible for this chunk:
-	const size_t cacheIdx = (static_cast<size_t>(a_ChunkCoords.m_ChunkX) + m_CoeffZ * static_cast<size_t>(a_ChunkCoords.m_ChunkZ)) % m_NumSubCaches;
-
-	// Ask the subcache:
-	m_SubCaches[cacheIdx]->GenHeightMap(a_ChunkCoords, a_HeightMap);
+	m_Cache.GetOrGenerate(a_ChunkCoords, a_HeightMap, [this, a_ChunkCoords](cChunkDef::HeightMap & a_Generated)
+		{
+			m_Underlying->GenHeightMap(a_ChunkCoords, a_Generated);
+		}
+	);
 }
 
 
@@ -271,11 +212,11 @@ HEIGHTTYPE cHeiGenMultiCache::GetHeightAt(int a_BlockX, int a_BlockZ)
 
 bool cHeiGenMultiCache::GetHeightAt(int a_ChunkX, int a_ChunkZ, int a_RelX, int a_RelZ, HEIGHTTYPE & a_Height)
 {
-	// Get the subcache responsible for this chunk:
-	const size_t cacheIdx = (static_cast<size_t>(a_ChunkX) + m_CoeffZ * static_cast<size_t>(a_ChunkZ)) % m_NumSubCaches;
-
-	// Ask the subcache:
-	return m_SubCaches[cacheIdx]->GetHeightAt(a_ChunkX, a_ChunkZ, a_RelX, a_RelZ, a_Height);
+	return m_Cache.Peek({a_ChunkX, a_ChunkZ}, [&a_Height, a_RelX, a_RelZ](const cChunkDef::HeightMap & a_HeightMap)
+		{
+			a_Height = cChunkDef::GetHeight(a_HeightMap, a_RelX, a_RelZ);
+		}
+	);
 }
 
 
@@ -373,13 +314,12 @@ void cHeiGenMountains::GenHeightMap(cChunkCoords a_ChunkCoords, cChunkDef::Heigh
 	NOISE_DATATYPE EndX   = static_cast<NOISE_DATATYPE>(a_ChunkCoords.m_ChunkX * cChunkDef::Width + cChunkDef::Width - 1);
 	NOISE_DATATYPE StartZ = static_cast<NOISE_DATATYPE>(a_ChunkCoords.m_ChunkZ * cChunkDef::Width);
 	NOISE_DATATYPE EndZ   = static_cast<NOISE_DATATYPE>(a_ChunkCoords.m_ChunkZ * cChunkDef::Width + cChunkDef::Width - 1);
-	NOISE_DATATYPE Workspace[16 * 16];
 	NOISE_DATATYPE MountainNoise[16 * 16];
 	NOISE_DATATYPE DitchNoise[16 * 16];
 	NOISE_DATATYPE PerlinNoise[16 * 16];
-	m_MountainNoise.Generate2D(MountainNoise, 16, 16, StartX, EndX, StartZ, EndZ, Workspace);
-	m_DitchNoise.Generate2D(DitchNoise, 16, 16, StartX, EndX, StartZ, EndZ, Workspace);
-	m_Perlin.Generate2D(PerlinNoise, 16, 16, StartX, EndX, StartZ, EndZ, Workspace);
+	m_MountainNoise.Generate2D(MountainNoise, 16, 16, StartX, EndX, StartZ, EndZ);
+	m_DitchNoise.Generate2D(DitchNoise, 16, 16, StartX, EndX, StartZ, EndZ);
+	m_Perlin.Generate2D(PerlinNoise, 16, 16, StartX, EndX, StartZ, EndZ);
 	for (int z = 0; z < cChunkDef::Width; z++)
 	{
 		int IdxZ = z * cChunkDef::Width;
@@ -704,12 +644,11 @@ public:
 
 		// Generate the base noise:
 		NOISE_DATATYPE noise[cChunkDef::Width * cChunkDef::Width];
-		NOISE_DATATYPE workspace[cChunkDef::Width * cChunkDef::Width];
 		NOISE_DATATYPE startX = static_cast<float>(a_ChunkCoords.m_ChunkX * cChunkDef::Width);
 		NOISE_DATATYPE endX = startX + cChunkDef::Width - 1;
 		NOISE_DATATYPE startZ = static_cast<float>(a_ChunkCoords.m_ChunkZ * cChunkDef::Width);
 		NOISE_DATATYPE endZ = startZ + cChunkDef::Width - 1;
-		m_Perlin.Generate2D(noise, 16, 16, startX, endX, startZ, endZ, workspace);
+		m_Perlin.Generate2D(noise, 16, 16, startX, endX, startZ, endZ);
 
 		// Make the height by ranging the noise between min and max:
 		for (int z = 0; z < cChunkDef::Width; z++)
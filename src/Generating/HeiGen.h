@@ -17,13 +17,15 @@ Also implements the heightmap cache
 #pragma once
 
 #include "ComposableGenerator.h"
+#include "GenCache.h"
 #include "../Noise/Noise.h"
 
 
 
 
 
-/** A simple cache that stores N most recently generated chunks' heightmaps; N being settable upon creation */
+/** A cache that stores the heightmaps of up to N recently generated chunks; N being settable upon creation.
+Not thread-safe, use cHeiGenMultiCache for a cache shared between threads. */
 class cHeiGenCache :
 	public cTerrainHeightGen
 {
@@ -37,37 +39,21 @@ public:
 	/** Retrieves height at the specified point in the cache, returns true if found, false if not found */
 	bool GetHeightAt(int a_ChunkX, int a_ChunkZ, int a_RelX, int a_RelZ, HEIGHTTYPE & a_Height);
 
-protected:
-	struct sCacheData
-	{
-		cChunkCoords m_Coords;
-		cChunkDef::HeightMap m_HeightMap;
+	sGenCacheStats GetCacheStats(void) const { return m_Cache.GetStats(); }
 
-		/** Default constructor: Fill in bogus coords, so that the item is not used until properly calculated. */
-		sCacheData():
-			m_Coords(0x7fffffff, 0x7fffffff)
-		{}
-	} ;
+protected:
 
 	/** The terrain height generator that is being cached. */
 	cTerrainHeightGen & m_HeiGenToCache;
 
-	// To avoid moving large amounts of data for the MRU behavior, we MRU-ize indices to an array of the actual data
-	size_t                  m_CacheSize;
-	std::vector<size_t>     m_CacheOrder;  // MRU-ized order, indices into m_CacheData array
-	std::vector<sCacheData> m_CacheData;   // m_CacheData[m_CacheOrder[0]] is the most recently used
-
-	// Cache statistics
-	size_t m_NumHits;
-	size_t m_NumMisses;
-	size_t m_TotalChain;  // Number of cache items walked to get to a hit (only added for hits)
+	cGenCache<cChunkDef::HeightMap> m_Cache;
 } ;
 
 
 
 
 
-/** Caches heightmaps in multiple underlying caches to improve the distribution and lower the chain length. */
+/** Caches heightmaps in multiple underlying caches, each with its own lock, so that the cache may be used from multiple threads at once. */
 class cHeiGenMultiCache:
 	public cTerrainHeightGen
 {
@@ -81,19 +67,15 @@ public:
 	/** Retrieves height at the specified point in the cache, returns true if found, false if not found */
 	bool GetHeightAt(int a_ChunkX, int a_ChunkZ, int a_RelX, int a_RelZ, HEIGHTTYPE & a_Height);
 
-protected:
-
-	/** The coefficient used to turn Z coords into index (x + Coeff * z). */
-	static const size_t m_CoeffZ = 5;
-
-	/** Number of sub-caches, pulled out of m_SubCaches.size() for performance reasons. */
-	size_t m_NumSubCaches;
+	sGenCacheStats GetCacheStats(void) const { return m_Cache.GetStats(); }
 
-	/** The individual sub-caches. */
-	std::vector<std::unique_ptr<cHeiGenCache>> m_SubCaches;
+protected:
 
 	/** The underlying height generator. */
 	std::unique_ptr<cTerrainHeightGen> m_Underlying;
+
+	/** The cached heightmaps, in individually locked sub-caches. */
+	cGenCacheConcurrent<cChunkDef::HeightMap> m_Cache;
 };
 
 
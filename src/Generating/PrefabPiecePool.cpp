@@ -17,21 +17,21 @@
 
 
 /** Returns the map of string => eMergeStrategy used when translating cubeset file merge strategies. */
-static std::map<AString, cBlockArea::eMergeStrategy> & GetMergeStrategyMap(void)
+static const std::map<AString, cBlockArea::eMergeStrategy> & GetMergeStrategyMap(void)
 {
-	static std::map<AString, cBlockArea::eMergeStrategy> msmap;
-	if (msmap.empty())
-	{
-		// This is the first use, initialize the map:
-		msmap["msOverwrite"]     = cBlockArea::msOverwrite;
-		msmap["msFillAir"]       = cBlockArea::msFillAir;
-		msmap["msImprint"]       = cBlockArea::msImprint;
-		msmap["msLake"]          = cBlockArea::msLake;
-		msmap["msSpongePrint"]   = cBlockArea::msSpongePrint;
-		msmap["msDifference"]    = cBlockArea::msDifference;
-		msmap["msSimpleCompare"] = cBlockArea::msSimpleCompare;
-		msmap["msMask"]          = cBlockArea::msMask;
-	}
+	// The local static is constructed once, on the first call, even if several generator threads make that call at once.
+	// It's const afterwards, so the concurrent lookups need no locking:
+	static const std::map<AString, cBlockArea::eMergeStrategy> msmap =
+	{
+		{"msOverwrite",     cBlockArea::msOverwrite},
+		{"msFillAir",       cBlockArea::msFillAir},
+		{"msImprint",       cBlockArea::msImprint},
+		{"msLake",          cBlockArea::msLake},
+		{"msSpongePrint",   cBlockArea::msSpongePrint},
+		{"msDifference",    cBlockArea::msDifference},
+		{"msSimpleCompare", cBlockArea::msSimpleCompare},
+		{"msMask",          cBlockArea::msMask},
+	};
 	return msmap;
 }
 
@@ -543,7 +543,7 @@ bool cPrefabPiecePool::ReadPieceMetadataCubesetVer1(
 	a_Prefab->SetAddWeightIfSame(AddWeightIfSame);
 	a_Prefab->SetDefaultWeight(DefaultWeight);
 	a_Prefab->ParseDepthWeight(DepthWeight.c_str());
-	auto msmap = GetMergeStrategyMap();
+	const auto & msmap = GetMergeStrategyMap();
 	auto strategy = msmap.find(MergeStrategy);
 	if (strategy == msmap.end())
 	{
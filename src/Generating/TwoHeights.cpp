@@ -41,14 +41,13 @@ public:
 
 		// Generate the choice noise:
 		NOISE_DATATYPE smallChoice[33 * 5 * 5];
-		NOISE_DATATYPE workspace[33 * 5 * 5];
 		NOISE_DATATYPE startX = 0;
 		NOISE_DATATYPE endX = 256 * m_FrequencyY;
 		NOISE_DATATYPE startY =  a_ChunkCoords.m_ChunkX * cChunkDef::Width * m_FrequencyX;
 		NOISE_DATATYPE endY   = (a_ChunkCoords.m_ChunkX * cChunkDef::Width + cChunkDef::Width + 1) * m_FrequencyX;
 		NOISE_DATATYPE startZ =  a_ChunkCoords.m_ChunkZ * cChunkDef::Width * m_FrequencyZ;
 		NOISE_DATATYPE endZ   = (a_ChunkCoords.m_ChunkZ * cChunkDef::Width + cChunkDef::Width + 1) * m_FrequencyZ;
-		m_Choice.Generate3D(smallChoice, 33, 5, 5, startX, endX, startY, endY, startZ, endZ, workspace);
+		m_Choice.Generate3D(smallChoice, 33, 5, 5, startX, endX, startY, endY, startZ, endZ);
 		NOISE_DATATYPE choice[257 * 17 * 17];
 		LinearUpscale3DArray(smallChoice, 33, 5, 5, choice, 8, 4, 4);
 
@@ -0,0 +1,286 @@
+
+// HTTPFileCache.cpp
+
+// Implements the cHTTPFileCache class that keeps the static files served over HTTP in memory, together with their gzipped variants
+
+#include "Globals.h"
+#include "HTTPFileCache.h"
+#include "HTTPMessage.h"
+#include "StringCompression.h"
+
+
+
+
+
+/** The compression level used for the gzipped variants; they are only compressed once per file change. */
+static const int GZIP_COMPRESSION_LEVEL = 9;
+
+
+
+
+
+/** Returns the number of bytes the entry takes in the cache. */
+static size_t GetEntrySize(const cHTTPFileCache::sEntry & a_Entry)
+{
+	return a_Entry.m_Content.size() + a_Entry.m_GZipContent.size();
+}
+
+
+
+
+
+/** Returns the 64-bit FNV-1a hash of the data, used for the ETags. */
+static UInt64 HashContent(const AString & a_Data)
+{
+	UInt64 Hash = 0xcbf29ce484222325ULL;
+	for (auto ch: a_Data)
+	{
+		Hash = (Hash ^ static_cast<unsigned char>(ch)) * 0x100000001b3ULL;
+	}
+	return Hash;
+}
+
+
+
+
+
+/** Returns true if the q-value of an Accept-Encoding item allows the encoding (anything but zero). */
+static bool IsAcceptedQValue(const AString & a_Params)
+{
+	auto idxQ = a_Params.find("q=");
+	if (idxQ == AString::npos)
+	{
+		return true;
+	}
+	float Q;
+	if (!StringToFloat(TrimString(a_Params.substr(idxQ + 2)), Q))
+	{
+		return true;
+	}
+	return (Q > 0);
+}
+
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// cHTTPFileCache:
+
+cHTTPFileCache::cHTTPFileCache(std::chrono::milliseconds a_RevalidateInterval, size_t a_MaxFileSize, size_t a_MaxTotalSize):
+	m_RevalidateInterval(a_RevalidateInterval),
+	m_MaxFileSize(a_MaxFileSize),
+	m_MaxTotalSize(a_MaxTotalSize),
+	m_CachedBytes(0),
+	m_NumHits(0),
+	m_NumRevalidations(0),
+	m_NumLoads(0)
+{
+}
+
+
+
+
+
+cHTTPFileCache::sEntryPtr cHTTPFileCache::Get(const AString & a_FileName)
+{
+	const auto Now = std::chrono::steady_clock::now();
+
+	// Serve from the cache if the file was checked recently enough:
+	sEntryPtr Cached;
+	{
+		cCSLock Lock(m_CS);
+		auto itr = m_Slots.find(a_FileName);
+		if (itr != m_Slots.end())
+		{
+			if (Now - itr->second.m_LastChecked < m_RevalidateInterval)
+			{
+				m_NumHits += 1;
+				return itr->second.m_Entry;
+			}
+			Cached = itr->second.m_Entry;
+		}
+	}
+
+	// Check the file on disk, outside of the lock:
+	const bool IsFile = cFile::IsFile(a_FileName);
+	const auto FileSize = IsFile ? cFile::GetSize(a_FileName) : -1;
+	const auto ModificationTime = IsFile ? cFile::GetLastModificationTime(a_FileName) : 0;
+	if (
+		(Cached != nullptr) &&
+		(Cached->m_FileSize == FileSize) &&
+		(Cached->m_ModificationTime == ModificationTime)
+	)
+	{
+		cCSLock Lock(m_CS);
+		auto itr = m_Slots.find(a_FileName);
+		if ((itr != m_Slots.end()) && (itr->second.m_Entry == Cached))
+		{
+			itr->second.m_LastChecked = Now;
+		}
+		m_NumRevalidations += 1;
+		return Cached;
+	}
+
+	// The file is new or has changed, read it; large files that won't be kept aren't worth compressing:
+	const bool ShouldKeep = (FileSize >= 0) && (static_cast<size_t>(FileSize) <= m_MaxFileSize);
+	auto Entry = IsFile ? Load(a_FileName, FileSize, ModificationTime, ShouldKeep) : nullptr;
+
+	// Replace the old entry with the new one:
+	cCSLock Lock(m_CS);
+	m_NumLoads += 1;
+	auto itr = m_Slots.find(a_FileName);
+	if (itr != m_Slots.end())
+	{
+		m_CachedBytes -= GetEntrySize(*itr->second.m_Entry);
+		m_Slots.erase(itr);
+	}
+	if ((Entry != nullptr) && ShouldKeep && (m_CachedBytes + GetEntrySize(*Entry) <= m_MaxTotalSize))
+	{
+		m_CachedBytes += GetEntrySize(*Entry);
+		m_Slots[a_FileName] = { Entry, Now };
+	}
+	return Entry;
+}
+
+
+
+
+
+void cHTTPFileCache::Clear(void)
+{
+	cCSLock Lock(m_CS);
+	m_Slots.clear();
+	m_CachedBytes = 0;
+}
+
+
+
+
+
+cHTTPFileCache::sStats cHTTPFileCache::GetStats(void) const
+{
+	cCSLock Lock(m_CS);
+	return { m_NumHits, m_NumRevalidations, m_NumLoads, m_CachedBytes };
+}
+
+
+
+
+
+void cHTTPFileCache::SetResponseHeaders(const sEntry & a_Entry, bool a_UseGZip, cHTTPOutgoingResponse & a_Response)
+{
+	// "no-cache" makes the clients revalidate each time, so that the file changes show up immediately; the revalidation is a cheap 304:
+	a_Response.AddHeader("ETag", a_UseGZip ? a_Entry.m_GZipETag : a_Entry.m_ETag);
+	a_Response.AddHeader("Last-Modified", a_Entry.m_LastModified);
+	a_Response.AddHeader("Cache-Control", "no-cache");
+	a_Response.AddHeader("Vary", "Accept-Encoding");
+	if (a_UseGZip)
+	{
+		a_Response.AddHeader("Content-Encoding", "gzip");
+	}
+}
+
+
+
+
+
+bool cHTTPFileCache::IsNotModified(const sEntry & a_Entry, const cHTTPIncomingRequest & a_Request)
+{
+	auto IfNoneMatch = a_Request.GetHeader("If-None-Match");
+	if (!IfNoneMatch.empty())
+	{
+		for (auto & Tag: StringSplitAndTrim(IfNoneMatch, ","))
+		{
+			// Weak comparison is fine for the conditional GET (RFC 7232 @ 3.2):
+			if (Tag.compare(0, 2, "W/") == 0)
+			{
+				Tag.erase(0, 2);
+			}
+			if ((Tag == "*") || (Tag == a_Entry.m_ETag) || (Tag == a_Entry.m_GZipETag))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	auto IfModifiedSince = a_Request.GetHeader("If-Modified-Since");
+	return (!IfModifiedSince.empty() && (TrimString(IfModifiedSince) == a_Entry.m_LastModified));
+}
+
+
+
+
+
+bool cHTTPFileCache::AcceptsGZip(const cHTTPIncomingRequest & a_Request)
+{
+	for (const auto & Item: StringSplitAndTrim(a_Request.GetHeader("Accept-Encoding"), ","))
+	{
+		auto idxParams = Item.find(';');
+		auto Coding = TrimString(Item.substr(0, idxParams));
+		if ((NoCaseCompare(Coding, "gzip") == 0) || (Coding == "*"))
+		{
+			return (idxParams == AString::npos) || IsAcceptedQValue(Item.substr(idxParams + 1));
+		}
+	}
+	return false;
+}
+
+
+
+
+
+AString cHTTPFileCache::FormatHTTPDate(time_t a_Time)
+{
+	// Not using strftime(), the names must not be localized:
+	static const char * DayNames[] = { "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat" };
+	static const char * MonthNames[] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+
+	struct tm Time;
+#ifdef _MSC_VER
+	gmtime_s(&Time, &a_Time);
+#else
+	gmtime_r(&a_Time, &Time);
+#endif
+
+	return fmt::format(
+		FMT_STRING("{}, {:02d} {} {:04d} {:02d}:{:02d}:{:02d} GMT"),
+		DayNames[Time.tm_wday], Time.tm_mday, MonthNames[Time.tm_mon], Time.tm_year + 1900,
+		Time.tm_hour, Time.tm_min, Time.tm_sec
+	);
+}
+
+
+
+
+
+cHTTPFileCache::sEntryPtr cHTTPFileCache::Load(const AString & a_FileName, long a_FileSize, unsigned a_ModificationTime, bool a_ShouldCompress)
+{
+	cFile File(a_FileName, cFile::fmRead);
+	auto Entry = std::make_shared<sEntry>();
+	if (!File.IsOpen() || (File.ReadRestOfFile(Entry->m_Content) == -1))
+	{
+		return nullptr;
+	}
+	Entry->m_FileSize = a_FileSize;
+	Entry->m_ModificationTime = a_ModificationTime;
+	Entry->m_LastModified = FormatHTTPDate(static_cast<time_t>(a_ModificationTime));
+
+	const auto Hash = HashContent(Entry->m_Content);
+	Entry->m_ETag = fmt::format(FMT_STRING("\"{:016x}\""), Hash);
+	Entry->m_GZipETag = fmt::format(FMT_STRING("\"{:016x}-gz\""), Hash);
+
+	// Keep the gzipped variant only if it saves something:
+	if (a_ShouldCompress)
+	{
+		const auto Compressed = Compression::Compressor(GZIP_COMPRESSION_LEVEL).CompressGZip(
+			{ reinterpret_cast<const std::byte *>(Entry->m_Content.data()), Entry->m_Content.size() }
+		).GetStringView();
+		if (Compressed.size() < Entry->m_Content.size())
+		{
+			Entry->m_GZipContent.assign(Compressed.data(), Compressed.size());
+		}
+	}
+	return Entry;
+}
@@ -0,0 +1,139 @@
+
+// HTTPFileCache.h
+
+// Declares the cHTTPFileCache class that keeps the static files served over HTTP in memory, together with their gzipped variants
+
+
+
+
+
+#pragma once
+
+
+
+
+
+// fwd:
+class cHTTPIncomingRequest;
+class cHTTPOutgoingResponse;
+
+
+
+
+
+/** Keeps the contents of static files served over HTTP in memory, so that they don't need reading for each request.
+Each file is gzipped once when loaded, and gets an ETag and Last-Modified value for the conditional requests.
+The files are checked for changes on disk (size and modification time) at most once per the revalidation interval,
+and reloaded when changed. Files that are too large, or would push the cache over its total size limit, are served
+without being kept.
+Thread-safe, the entries are immutable and shared with the callers. */
+class cHTTPFileCache
+{
+public:
+
+	/** A single cached file. Never changed once created, a changed file gets a new entry. */
+	struct sEntry
+	{
+		/** The raw file contents. */
+		AString m_Content;
+
+		/** The gzipped file contents. Empty if gzipping doesn't make the file smaller. */
+		AString m_GZipContent;
+
+		/** The ETag of the raw and gzipped contents, including the quotes. */
+		AString m_ETag;
+		AString m_GZipETag;
+
+		/** The file's modification time formatted as an HTTP date. */
+		AString m_LastModified;
+
+		/** The file size and modification time, as seen when loading; used for detecting changes on disk. */
+		long m_FileSize;
+		unsigned m_ModificationTime;
+	};
+	using sEntryPtr = std::shared_ptr<const sEntry>;
+
+	/** The statistics of the cache usage. */
+	struct sStats
+	{
+		/** The number of Get() calls served from the cache without touching the disk. */
+		size_t m_NumHits;
+
+		/** The number of Get() calls that checked the file for changes on disk, and it had none. */
+		size_t m_NumRevalidations;
+
+		/** The number of Get() calls that had to read the file. */
+		size_t m_NumLoads;
+
+		/** The total size of the cached contents, raw and gzipped. */
+		size_t m_CachedBytes;
+	};
+
+
+	cHTTPFileCache(
+		std::chrono::milliseconds a_RevalidateInterval = std::chrono::seconds(1),
+		size_t a_MaxFileSize = 4 MiB,
+		size_t a_MaxTotalSize = 32 MiB
+	);
+
+	/** Returns the entry for the specified file, reading it if it isn't cached yet or has changed on disk.
+	Returns nullptr if the file cannot be read. */
+	sEntryPtr Get(const AString & a_FileName);
+
+	/** Drops all the cached files, so that they are read again on the next request. */
+	void Clear(void);
+
+	/** Returns the statistics of the cache usage. */
+	sStats GetStats(void) const;
+
+	/** Sets the ETag, Last-Modified and caching headers of a_Response for serving the specified entry,
+	and the Content-Encoding if the gzipped variant is to be sent. */
+	static void SetResponseHeaders(const sEntry & a_Entry, bool a_UseGZip, cHTTPOutgoingResponse & a_Response);
+
+	/** Returns true if the client's conditional headers show that it already has the current file,
+	so that "304 Not Modified" can be sent instead of the contents.
+	If-None-Match takes precedence; If-Modified-Since only matches the exact date previously sent by us. */
+	static bool IsNotModified(const sEntry & a_Entry, const cHTTPIncomingRequest & a_Request);
+
+	/** Returns true if the request's Accept-Encoding header allows a gzipped response. */
+	static bool AcceptsGZip(const cHTTPIncomingRequest & a_Request);
+
+	/** Formats the time (seconds since the epoch) as an HTTP date ("Sun, 06 Nov 1994 08:49:37 GMT"). */
+	static AString FormatHTTPDate(time_t a_Time);
+
+protected:
+
+	/** A cached file and the time it was last checked for changes on disk. */
+	struct sSlot
+	{
+		sEntryPtr m_Entry;
+		std::chrono::steady_clock::time_point m_LastChecked;
+	};
+
+	/** Protects all the members against multithreaded access. */
+	mutable cCriticalSection m_CS;
+
+	/** The cached files, keyed by the filename. */
+	std::unordered_map<AString, sSlot> m_Slots;
+
+	/** How long an entry is served without checking the file for changes on disk. */
+	std::chrono::milliseconds m_RevalidateInterval;
+
+	/** The largest file that is kept in the cache. */
+	size_t m_MaxFileSize;
+
+	/** The limit on the total size of the cached contents. */
+	size_t m_MaxTotalSize;
+
+	/** The total size of the cached contents, raw and gzipped. */
+	size_t m_CachedBytes;
+
+	size_t m_NumHits;
+	size_t m_NumRevalidations;
+	size_t m_NumLoads;
+
+
+	/** Reads the file and creates its entry, including the gzipped contents if a_ShouldCompress is true.
+	Returns nullptr if the file cannot be read. */
+	static sEntryPtr Load(const AString & a_FileName, long a_FileSize, unsigned a_ModificationTime, bool a_ShouldCompress);
+} ;
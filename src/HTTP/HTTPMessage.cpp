@@ -66,11 +66,27 @@ void cHTTPMessage::AddHeader(const AString & a_Key, const AString & a_Value)
 
 
 
+AString cHTTPMessage::GetHeader(const AString & a_Key) const
+{
+	auto itr = m_Headers.find(StrToLower(a_Key));
+	if (itr == m_Headers.end())
+	{
+		return AString();
+	}
+	return itr->second;
+}
+
+
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 // cHTTPOutgoingResponse:
 
 cHTTPOutgoingResponse::cHTTPOutgoingResponse(void) :
-	Super(mkResponse)
+	Super(mkResponse),
+	m_StatusCode(HTTP_OK),
+	m_Reason("OK")
 {
 }
 
@@ -80,9 +96,13 @@ cHTTPOutgoingResponse::cHTTPOutgoingResponse(void) :
 
 void cHTTPOutgoingResponse::AppendToData(AString & a_DataStream) const
 {
-	a_DataStream.append("HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\nContent-Type: ");
-	a_DataStream.append(m_ContentType);
-	a_DataStream.append("\r\n");
+	a_DataStream.append(fmt::format(FMT_STRING("HTTP/1.1 {} {}\r\n"), m_StatusCode, m_Reason));
+	if (HasBody())
+	{
+		a_DataStream.append("Transfer-Encoding: chunked\r\nContent-Type: ");
+		a_DataStream.append(m_ContentType);
+		a_DataStream.append("\r\n");
+	}
 	for (auto itr = m_Headers.cbegin(), end = m_Headers.cend(); itr != end; ++itr)
 	{
 		if ((itr->first == "Content-Type") || (itr->first == "Content-Length"))
@@ -42,6 +42,9 @@ public:
 	const AString & GetContentType  (void) const { return m_ContentType; }
 	size_t          GetContentLength(void) const { return m_ContentLength; }
 
+	/** Returns the value of the specified header (the key is case-insensitive), or an empty string if the header is not present. */
+	AString GetHeader(const AString & a_Key) const;
+
 protected:
 
 	using cNameValueMap = std::map<AString, AString>;
@@ -75,9 +78,32 @@ public:
 
 	cHTTPOutgoingResponse(void);
 
+	/** Sets the status code and reason sent in the response line. Defaults to "200 OK". */
+	void SetStatus(int a_StatusCode, const AString & a_Reason)
+	{
+		m_StatusCode = a_StatusCode;
+		m_Reason = a_Reason;
+	}
+
+	int GetStatusCode(void) const { return m_StatusCode; }
+
+	/** Returns true if the response status allows a body (all except 1xx, 204 and 304). */
+	bool HasBody(void) const
+	{
+		return ((m_StatusCode >= 200) && (m_StatusCode != 204) && (m_StatusCode != 304));
+	}
+
 	/** Appends the response to the specified datastream - response line and headers.
 	The body will be sent later directly through cConnection::Send() */
 	void AppendToData(AString & a_DataStream) const;
+
+protected:
+
+	/** The status code sent in the response line. */
+	int m_StatusCode;
+
+	/** The reason phrase sent in the response line. */
+	AString m_Reason;
 } ;
 
 
@@ -64,6 +64,21 @@ void cHTTPServerConnection::Send(const cHTTPOutgoingResponse & a_Response)
 
 
 
+void cHTTPServerConnection::SendWithoutBody(const cHTTPOutgoingResponse & a_Response)
+{
+	ASSERT(m_CurrentRequest != nullptr);
+	ASSERT(!a_Response.HasBody());
+	AString toSend;
+	a_Response.AppendToData(toSend);
+	SendData(toSend);
+	m_CurrentRequest.reset();
+	m_Parser.Reset();
+}
+
+
+
+
+
 void cHTTPServerConnection::Send(const void * a_Data, size_t a_Size)
 {
 	ASSERT(m_CurrentRequest != nullptr);
@@ -47,6 +47,10 @@ public:
 	/** Sends the headers contained in a_Response */
 	void Send(const cHTTPOutgoingResponse & a_Response);
 
+	/** Sends the headers contained in a_Response as a complete response without a body (such as "304 Not Modified").
+	Clears the current request (since it's finished by this call). */
+	void SendWithoutBody(const cHTTPOutgoingResponse & a_Response);
+
 	/** Sends the data as the response (may be called multiple times) */
 	void Send(const void * a_Data, size_t a_Size);
 
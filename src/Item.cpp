@@ -16,11 +16,7 @@
 cItem::cItem():
 	m_ItemType(Item::Air),
 	m_ItemCount(0),
-	m_ItemDamage(0),
-	m_CustomName(),
-	m_RepairCost(0),
-	m_FireworkItem(),
-	m_ItemColor()
+	m_ItemDamage(0)
 {
 }
 
@@ -36,16 +32,23 @@ cItem::cItem(
 	const AString & a_CustomName,
 	const AStringVector & a_LoreTable
 ):
-	m_ItemType    (a_ItemType),
-	m_ItemCount   (a_ItemCount),
-	m_ItemDamage  (a_ItemDamage),
-	m_Enchantments(a_Enchantments),
-	m_CustomName  (a_CustomName),
-	m_LoreTable   (a_LoreTable),
-	m_RepairCost  (0),
-	m_FireworkItem(),
-	m_ItemColor()
+	m_ItemType  (a_ItemType),
+	m_ItemCount (a_ItemCount),
+	m_ItemDamage(a_ItemDamage)
 {
+	// Only allocate the components if there are any:
+	if (!a_Enchantments.empty())
+	{
+		ModifyEnchantments().AddFromString(a_Enchantments);
+	}
+	if (!a_CustomName.empty())
+	{
+		SetCustomName(a_CustomName);
+	}
+	if (!a_LoreTable.empty())
+	{
+		ModifyLoreTable() = a_LoreTable;
+	}
 }
 
 
@@ -57,12 +60,7 @@ void cItem::Empty()
 	m_ItemType = Item::Air;
 	m_ItemCount = 0;
 	m_ItemDamage = 0;
-	m_Enchantments.Clear();
-	m_CustomName = "";
-	m_LoreTable.clear();
-	m_RepairCost = 0;
-	m_FireworkItem.EmptyData();
-	m_ItemColor.Clear();
+	m_Components.reset();
 }
 
 
@@ -208,43 +206,45 @@ void cItem::GetJson(Json::Value & a_OutValue) const
 	{
 		a_OutValue["Count"] = m_ItemCount;
 		a_OutValue["Health"] = m_ItemDamage + NumericItem.second;
-		AString Enchantments(m_Enchantments.ToString());
+		AString Enchantments(GetEnchantments().ToString());
 		if (!Enchantments.empty())
 		{
 			a_OutValue["ench"] = Enchantments;
 		}
 		if (!IsCustomNameEmpty())
 		{
-			a_OutValue["Name"] = m_CustomName;
+			a_OutValue["Name"] = GetCustomName();
 		}
 		if (!IsLoreEmpty())
 		{
 			auto & LoreArray = (a_OutValue["Lore"] = Json::Value(Json::arrayValue));
 
-			for (const auto & Line : m_LoreTable)
+			for (const auto & Line : GetLoreTable())
 			{
 				LoreArray.append(Line);
 			}
 		}
 
-		if (m_ItemColor.IsValid())
+		const auto & ItemColor = GetItemColor();
+		if (ItemColor.IsValid())
 		{
-			a_OutValue["Color_Red"] = m_ItemColor.GetRed();
-			a_OutValue["Color_Green"] = m_ItemColor.GetGreen();
-			a_OutValue["Color_Blue"] = m_ItemColor.GetBlue();
+			a_OutValue["Color_Red"] = ItemColor.GetRed();
+			a_OutValue["Color_Green"] = ItemColor.GetGreen();
+			a_OutValue["Color_Blue"] = ItemColor.GetBlue();
 		}
 
 		if ((m_ItemType == Item::FireworkRocket) || (m_ItemType == Item::FireworkStar))
 		{
-			a_OutValue["Flicker"] = m_FireworkItem.m_HasFlicker;
-			a_OutValue["Trail"] = m_FireworkItem.m_HasTrail;
-			a_OutValue["Type"] = m_FireworkItem.m_Type;
-			a_OutValue["FlightTimeInTicks"] = m_FireworkItem.m_FlightTimeInTicks;
-			a_OutValue["Colours"] = m_FireworkItem.ColoursToString(m_FireworkItem);
-			a_OutValue["FadeColours"] = m_FireworkItem.FadeColoursToString(m_FireworkItem);
+			const auto & FireworkItem = GetFireworkItem();
+			a_OutValue["Flicker"] = FireworkItem.m_HasFlicker;
+			a_OutValue["Trail"] = FireworkItem.m_HasTrail;
+			a_OutValue["Type"] = FireworkItem.m_Type;
+			a_OutValue["FlightTimeInTicks"] = FireworkItem.m_FlightTimeInTicks;
+			a_OutValue["Colours"] = cFireworkItem::ColoursToString(FireworkItem);
+			a_OutValue["FadeColours"] = cFireworkItem::FadeColoursToString(FireworkItem);
 		}
 
-		a_OutValue["RepairCost"] = m_RepairCost;
+		a_OutValue["RepairCost"] = GetRepairCost();
 	}
 }
 
@@ -259,13 +259,21 @@ void cItem::FromJson(const Json::Value & a_Value)
 	{
 		m_ItemDamage = static_cast<short>(a_Value.get("Health", -1).asInt());
 		m_ItemCount = static_cast<char>(a_Value.get("Count", -1).asInt());
-		m_Enchantments.Clear();
-		m_Enchantments.AddFromString(a_Value.get("ench", "").asString());
-		m_CustomName = a_Value.get("Name", "").asString();
+		m_Components.reset();
+		const auto Enchantments = a_Value.get("ench", "").asString();
+		if (!Enchantments.empty())
+		{
+			ModifyEnchantments().AddFromString(Enchantments);
+		}
+		const auto CustomName = a_Value.get("Name", "").asString();
+		if (!CustomName.empty())
+		{
+			SetCustomName(CustomName);
+		}
 		auto Lore = a_Value.get("Lore", Json::arrayValue);
 		for (auto & Line : Lore)
 		{
-			m_LoreTable.push_back(Line.asString());
+			ModifyLoreTable().push_back(Line.asString());
 		}
 
 		int red = a_Value.get("Color_Red", -1).asInt();
@@ -273,7 +281,7 @@ void cItem::FromJson(const Json::Value & a_Value)
 		int blue = a_Value.get("Color_Blue", -1).asInt();
 		if ((red > -1) && (red < static_cast<int>(cColor::COLOR_LIMIT)) && (green > -1) && (green < static_cast<int>(cColor::COLOR_LIMIT)) && (blue > -1) && (blue < static_cast<int>(cColor::COLOR_LIMIT)))
 		{
-			m_ItemColor.SetColor(static_cast<unsigned char>(red), static_cast<unsigned char>(green), static_cast<unsigned char>(blue));
+			ModifyItemColor().SetColor(static_cast<unsigned char>(red), static_cast<unsigned char>(green), static_cast<unsigned char>(blue));
 		}
 		else if ((red != -1) || (blue != -1) || (green != -1))
 		{
@@ -282,15 +290,20 @@ void cItem::FromJson(const Json::Value & a_Value)
 
 		if ((m_ItemType == Item::FireworkRocket) || (m_ItemType == Item::FireworkStar))
 		{
-			m_FireworkItem.m_HasFlicker = a_Value.get("Flicker", false).asBool();
-			m_FireworkItem.m_HasTrail = a_Value.get("Trail", false).asBool();
-			m_FireworkItem.m_Type = static_cast<unsigned char>(a_Value.get("Type", 0).asInt());
-			m_FireworkItem.m_FlightTimeInTicks = static_cast<short>(a_Value.get("FlightTimeInTicks", 0).asInt());
-			m_FireworkItem.ColoursFromString(a_Value.get("Colours", "").asString(), m_FireworkItem);
-			m_FireworkItem.FadeColoursFromString(a_Value.get("FadeColours", "").asString(), m_FireworkItem);
+			auto & FireworkItem = ModifyFireworkItem();
+			FireworkItem.m_HasFlicker = a_Value.get("Flicker", false).asBool();
+			FireworkItem.m_HasTrail = a_Value.get("Trail", false).asBool();
+			FireworkItem.m_Type = static_cast<unsigned char>(a_Value.get("Type", 0).asInt());
+			FireworkItem.m_FlightTimeInTicks = static_cast<short>(a_Value.get("FlightTimeInTicks", 0).asInt());
+			cFireworkItem::ColoursFromString(a_Value.get("Colours", "").asString(), FireworkItem);
+			cFireworkItem::FadeColoursFromString(a_Value.get("FadeColours", "").asString(), FireworkItem);
 		}
 
-		m_RepairCost = a_Value.get("RepairCost", 0).asInt();
+		const auto RepairCost = a_Value.get("RepairCost", 0).asInt();
+		if (RepairCost != 0)
+		{
+			SetRepairCost(RepairCost);
+		}
 	}
 }
 
@@ -431,7 +444,7 @@ bool cItem::EnchantByXPLevels(unsigned a_NumXPLevels, MTRand & a_Random)
 	}
 
 	cEnchantments Enchantment1 = cEnchantments::GetRandomEnchantmentFromVector(Enchantments, a_Random);
-	m_Enchantments.AddFromString(Enchantment1.ToString());
+	ModifyEnchantments().AddFromString(Enchantment1.ToString());
 	cEnchantments::RemoveEnchantmentWeightFromVector(Enchantments, Enchantment1);
 
 	// Checking for conflicting enchantments
@@ -446,7 +459,7 @@ bool cItem::EnchantByXPLevels(unsigned a_NumXPLevels, MTRand & a_Random)
 	}
 
 	cEnchantments Enchantment2 = cEnchantments::GetRandomEnchantmentFromVector(Enchantments, a_Random);
-	m_Enchantments.AddFromString(Enchantment2.ToString());
+	ModifyEnchantments().AddFromString(Enchantment2.ToString());
 	cEnchantments::RemoveEnchantmentWeightFromVector(Enchantments, Enchantment2);
 
 	// Checking for conflicting enchantments
@@ -461,7 +474,7 @@ bool cItem::EnchantByXPLevels(unsigned a_NumXPLevels, MTRand & a_Random)
 	}
 
 	cEnchantments Enchantment3 = cEnchantments::GetRandomEnchantmentFromVector(Enchantments, a_Random);
-	m_Enchantments.AddFromString(Enchantment3.ToString());
+	ModifyEnchantments().AddFromString(Enchantment3.ToString());
 	cEnchantments::RemoveEnchantmentWeightFromVector(Enchantments, Enchantment3);
 
 	// Checking for conflicting enchantments
@@ -475,7 +488,7 @@ bool cItem::EnchantByXPLevels(unsigned a_NumXPLevels, MTRand & a_Random)
 		return true;
 	}
 	cEnchantments Enchantment4 = cEnchantments::GetRandomEnchantmentFromVector(Enchantments, a_Random);
-	m_Enchantments.AddFromString(Enchantment4.ToString());
+	ModifyEnchantments().AddFromString(Enchantment4.ToString());
 
 	return true;
 }
@@ -486,7 +499,7 @@ bool cItem::EnchantByXPLevels(unsigned a_NumXPLevels, MTRand & a_Random)
 
 int cItem::AddEnchantment(int a_EnchantmentID, unsigned int a_Level, bool a_FromBook)
 {
-	unsigned int OurLevel = m_Enchantments.GetLevel(a_EnchantmentID);
+	unsigned int OurLevel = GetEnchantments().GetLevel(a_EnchantmentID);
 	int Multiplier = cEnchantments::GetXPCostMultiplier(a_EnchantmentID, a_FromBook);
 	unsigned int NewLevel = 0;
 	if (OurLevel > a_Level)
@@ -510,7 +523,7 @@ int cItem::AddEnchantment(int a_EnchantmentID, unsigned int a_Level, bool a_From
 		NewLevel = LevelCap;
 	}
 
-	m_Enchantments.SetLevel(a_EnchantmentID, NewLevel);
+	ModifyEnchantments().SetLevel(a_EnchantmentID, NewLevel);
 	return static_cast<int>(NewLevel) * Multiplier;
 }
 
@@ -655,11 +668,11 @@ int cItem::AddEnchantmentsFromItem(const cItem & a_Other)
 
 	// Consider each enchantment seperately
 	int EnchantingCost = 0;
-	for (auto & Enchantment : a_Other.m_Enchantments)
+	for (auto & Enchantment : a_Other.GetEnchantments())
 	{
 		if (CanHaveEnchantment(Enchantment.first))
 		{
-			if (!m_Enchantments.CanAddEnchantment(Enchantment.first))
+			if (!GetEnchantments().CanAddEnchantment(Enchantment.first))
 			{
 				// Cost of incompatible enchantments
 				EnchantingCost += 1;
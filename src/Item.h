@@ -80,10 +80,7 @@ public:
 		return (
 			IsSameType(a_Item) &&
 			(m_ItemDamage == a_Item.m_ItemDamage) &&
-			(m_Enchantments == a_Item.m_Enchantments) &&
-			(m_CustomName == a_Item.m_CustomName) &&
-			(m_LoreTable == a_Item.m_LoreTable) &&
-			m_FireworkItem.IsEqualTo(a_Item.m_FireworkItem)
+			((m_Components == a_Item.m_Components) || AreComponentsEqual(a_Item))  // Plain items and copies share the same (null) components
 		);
 	}
 
@@ -96,12 +93,12 @@ public:
 
 	bool IsBothNameAndLoreEmpty(void) const
 	{
-		return (m_CustomName.empty() && m_LoreTable.empty());
+		return (GetCustomName().empty() && GetLoreTable().empty());
 	}
 
 
-	bool IsCustomNameEmpty(void) const { return (m_CustomName.empty()); }
-	bool IsLoreEmpty(void) const { return (m_LoreTable.empty()); }
+	bool IsCustomNameEmpty(void) const { return (GetCustomName().empty()); }
+	bool IsLoreEmpty(void) const { return (GetLoreTable().empty()); }
 
 	/** Returns a copy of this item with m_ItemCount set to 1. Useful to preserve enchantments etc. on stacked items */
 	cItem CopyOne(void) const;
@@ -160,18 +157,50 @@ public:
 	/** Returns whether or not this item is allowed to have the given enchantment. Note: Does not check whether the enchantment is exclusive with the current enchantments on the item. */
 	bool CanHaveEnchantment(int a_EnchantmentID);
 
+	/** The rarely used parts of an item, stored out of line so that plain items stay small and cheap to copy. */
+	struct sComponents
+	{
+		cEnchantments  m_Enchantments;
+		AString        m_CustomName;
+		AStringVector  m_LoreTable;
+		int            m_RepairCost = 0;
+		cFireworkItem  m_FireworkItem;
+		cColor         m_ItemColor;
+	};
+
+	// The components are exported in ManualBindings.cpp as the m_Enchantments, m_CustomName, m_LoreTable, m_RepairCost
+	// and m_ItemColor variables
+
+	const cEnchantments & GetEnchantments(void) const { return GetComponents().m_Enchantments; }
+	const AString & GetCustomName(void) const { return GetComponents().m_CustomName; }
+	const AStringVector & GetLoreTable(void) const { return GetComponents().m_LoreTable; }
+	int GetRepairCost(void) const { return GetComponents().m_RepairCost; }
+	const cFireworkItem & GetFireworkItem(void) const { return GetComponents().m_FireworkItem; }
+	const cColor & GetItemColor(void) const { return GetComponents().m_ItemColor; }
+
+	/** The Modify...() functions return the component for changing it in place.
+	They unshare the components from the item's copies, allocating them for a plain item, so they shouldn't be used only for reading. */
+	cEnchantments & ModifyEnchantments(void) { return ModifyComponents().m_Enchantments; }
+	AStringVector & ModifyLoreTable(void) { return ModifyComponents().m_LoreTable; }
+	cFireworkItem & ModifyFireworkItem(void) { return ModifyComponents().m_FireworkItem; }
+	cColor & ModifyItemColor(void) { return ModifyComponents().m_ItemColor; }
+
+	void SetCustomName(const AString & a_CustomName) { ModifyComponents().m_CustomName = a_CustomName; }
+	void SetRepairCost(int a_RepairCost) { ModifyComponents().m_RepairCost = a_RepairCost; }
+	void SetEnchantments(const cEnchantments & a_Enchantments) { ModifyComponents().m_Enchantments = a_Enchantments; }
+	void SetItemColor(const cColor & a_ItemColor) { ModifyComponents().m_ItemColor = a_ItemColor; }
+
+	/** Returns true if the item has its own components, false for a plain item that uses the defaults. */
+	bool HasComponents(void) const { return (m_Components != nullptr); }
+
 	// tolua_begin
 
 	Item           m_ItemType;
 	char           m_ItemCount;
 	short          m_ItemDamage;
-	cEnchantments  m_Enchantments;
-	AString        m_CustomName;
 
 	// tolua_end
 
-	AStringVector  m_LoreTable;  // Exported in ManualBindings.cpp
-
 	/**
 	Compares two items for the same type or category. Type of item is defined
 	via `m_ItemType` and `m_ItemDamage`. Some items (e.g. planks) have the same
@@ -197,13 +226,57 @@ public:
 		}
 	};
 
-	// tolua_begin
+private:
 
-	int            m_RepairCost;
-	cFireworkItem  m_FireworkItem;
-	cColor         m_ItemColor;
-};
-// tolua_end
+	/** The item's enchantments, name, lore, repair cost, firework and colour; nullptr for a plain item.
+	Copies of the item share the components until one of them is modified through ModifyComponents() (copy-on-write). */
+	std::shared_ptr<sComponents> m_Components;
+
+
+	/** Returns the components with the default values, used by plain items. */
+	static const sComponents & GetDefaultComponents(void)
+	{
+		static const sComponents Defaults;
+		return Defaults;
+	}
+
+	const sComponents & GetComponents(void) const
+	{
+		return (m_Components == nullptr) ? GetDefaultComponents() : *m_Components;
+	}
+
+	/** Returns the components for modification, allocating them for a plain item, or copying them if shared with other items. */
+	sComponents & ModifyComponents(void)
+	{
+		if (m_Components == nullptr)
+		{
+			m_Components = std::make_shared<sComponents>();
+		}
+		else if (m_Components.use_count() > 1)
+		{
+			m_Components = std::make_shared<sComponents>(*m_Components);
+		}
+		else
+		{
+			// The last copy sharing the components may have just released them on another thread, see its writes before ours:
+			std::atomic_thread_fence(std::memory_order_acquire);
+		}
+		return *m_Components;
+	}
+
+	/** Returns true if the components that affect stacking (all but the repair cost and colour) are equal. */
+	bool AreComponentsEqual(const cItem & a_Item) const
+	{
+		const auto & Components = GetComponents();
+		const auto & Other = a_Item.GetComponents();
+		return (
+			(Components.m_Enchantments == Other.m_Enchantments) &&
+			(Components.m_CustomName == Other.m_CustomName) &&
+			(Components.m_LoreTable == Other.m_LoreTable) &&
+			Components.m_FireworkItem.IsEqualTo(Other.m_FireworkItem)
+		);
+	}
+} ;  // tolua_export
 
 
 
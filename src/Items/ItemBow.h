@@ -81,7 +81,7 @@ public:
 		);
 		if (!a_Player->IsGameModeCreative())
 		{
-			if (a_Player->GetEquippedItem().m_Enchantments.GetLevel(cEnchantments::enchInfinity) == 0)
+			if (a_Player->GetEquippedItem().GetEnchantments().GetLevel(cEnchantments::enchInfinity) == 0)
 			{
 				a_Player->GetInventory().RemoveItem(cItem(Item::Arrow));
 			}
@@ -92,7 +92,7 @@ public:
 
 			a_Player->UseEquippedItem();
 		}
-		if (a_Player->GetEquippedItem().m_Enchantments.GetLevel(cEnchantments::enchFlame) > 0)
+		if (a_Player->GetEquippedItem().GetEnchantments().GetLevel(cEnchantments::enchFlame) > 0)
 		{
 			ArrowPtr->StartBurning(100);
 		}
@@ -36,7 +36,7 @@ private:
 		{
 			ASSERT(a_BlockEntity.GetBlockType() == BlockType::EnchantingTable);
 
-			static_cast<cEnchantingTableEntity &>(a_BlockEntity).SetCustomName(a_HeldItem.m_CustomName);
+			static_cast<cEnchantingTableEntity &>(a_BlockEntity).SetCustomName(a_HeldItem.GetCustomName());
 			return false;
 		});
 
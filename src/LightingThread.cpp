@@ -8,6 +8,7 @@
 #include "ChunkMap.h"
 #include "World.h"
 #include "BlockInfo.h"
+#include "ChunkLayers.h"
 
 
 
@@ -19,33 +20,16 @@ class cReader :
 {
 	virtual void ChunkData(const ChunkBlockData & a_BlockData, const ChunkLightData &) override
 	{
-		BlockState * OutputRows = m_Blocks;
-		int OutputIdx = m_ReadingChunkX + m_ReadingChunkZ * cChunkDef::Width * 3;
-		for (size_t i = 0; i != cChunkDef::NumSections; ++i)
-		{
-			const auto & Section = a_BlockData.GetSection(i);
-			if (Section == nullptr)
-			{
-				// Skip to the next section
-				OutputIdx += 9 * cChunkDef::SectionHeight * cChunkDef::Width;
-				continue;
-			}
+		// Only take a snapshot while the chunkmap is locked, UnpackBlocks() copies the blocks out afterwards:
+		m_Snapshot.Assign(a_BlockData);
+	}
 
-			for (size_t OffsetY = 0; OffsetY != cChunkDef::SectionHeight; ++OffsetY)
-			{
-				for (size_t Z = 0; Z != cChunkDef::Width; ++Z)
-				{
-					auto InPtr = Section->data() + Z * cChunkDef::Width + OffsetY * cChunkDef::Width * cChunkDef::Width;
-					std::copy_n(InPtr, cChunkDef::Width, OutputRows + OutputIdx * cChunkDef::Width);
 
-					OutputIdx += 3;
-				}
-				// Skip into the next y-level in the 3x3 chunk blob; each level has cChunkDef::Width * 9 rows
-				// We've already walked cChunkDef::Width * 3 in the "for z" cycle, that makes cChunkDef::Width * 6 rows left to skip
-				OutputIdx += cChunkDef::Width * 6;
-			}
-		}
-	}  // BlockTypes()
+
+	virtual void SectionLayers(size_t a_SectionY, const cSectionLayers & a_Layers) override
+	{
+		m_LightEmitters[m_ReadingChunkX + m_ReadingChunkZ * 3][a_SectionY] = a_Layers.GetLayer(eBlockLayer::LightEmitting);
+	}
 
 
 	virtual void HeightMap(const cChunkDef::HeightMap & a_Heightmap) override
@@ -75,20 +59,63 @@ class cReader :
 	}
 
 public:
+
+	/** Copies the blocks of the chunk last read into the 3x3 chunk blob, and releases its snapshot. */
+	void UnpackBlocks(void)
+	{
+		BlockState * OutputRows = m_Blocks;
+		int OutputIdx = m_ReadingChunkX + m_ReadingChunkZ * cChunkDef::Width * 3;
+		for (size_t i = 0; i != cChunkDef::NumSections; ++i)
+		{
+			const auto & Section = m_Snapshot.GetSection(i);
+			if (Section == nullptr)
+			{
+				// Skip to the next section
+				OutputIdx += 9 * cChunkDef::SectionHeight * cChunkDef::Width;
+				continue;
+			}
+
+			for (size_t OffsetY = 0; OffsetY != cChunkDef::SectionHeight; ++OffsetY)
+			{
+				for (size_t Z = 0; Z != cChunkDef::Width; ++Z)
+				{
+					auto InPtr = Section->data() + Z * cChunkDef::Width + OffsetY * cChunkDef::Width * cChunkDef::Width;
+					std::copy_n(InPtr, cChunkDef::Width, OutputRows + OutputIdx * cChunkDef::Width);
+
+					OutputIdx += 3;
+				}
+				// Skip into the next y-level in the 3x3 chunk blob; each level has cChunkDef::Width * 9 rows
+				// We've already walked cChunkDef::Width * 3 in the "for z" cycle, that makes cChunkDef::Width * 6 rows left to skip
+				OutputIdx += cChunkDef::Width * 6;
+			}
+		}
+		m_Snapshot.Clear();
+	}
+
 	int m_ReadingChunkX;  // 0, 1 or 2; x-offset of the chunk we're reading from the BlockTypes start
 	int m_ReadingChunkZ;  // 0, 1 or 2; z-offset of the chunk we're reading from the BlockTypes start
 	HEIGHTTYPE m_MaxHeight;  // Maximum value in this chunk's heightmap
 	BlockState * m_Blocks;  // 3x3 chunks of block types, organized as a single XZY blob of data (instead of 3x3 XZY blobs)
 	HEIGHTTYPE * m_HeightMap;  // 3x3 chunks of height map,  organized as a single XZY blob of data (instead of 3x3 XZY blobs)
+	ChunkBlockData::SectionBitmap (* m_LightEmitters)[cChunkDef::NumSections];  // Light-emitting layer of each section of the 3x3 chunks, [ChunkZ * 3 + ChunkX][SectionY]
+	ChunkBlockData m_Snapshot;  // Copy-on-write snapshot of the blocks of the chunk being read, until UnpackBlocks()
 
-	cReader(BlockState * a_Blocks, HEIGHTTYPE * a_HeightMap) :
+	cReader(BlockState * a_Blocks, HEIGHTTYPE * a_HeightMap, ChunkBlockData::SectionBitmap (* a_LightEmitters)[cChunkDef::NumSections]) :
 		m_ReadingChunkX(0),
 		m_ReadingChunkZ(0),
 		m_MaxHeight(0),
 		m_Blocks(a_Blocks),
-		m_HeightMap(a_HeightMap)
+		m_HeightMap(a_HeightMap),
+		m_LightEmitters(a_LightEmitters)
 	{
 		std::fill_n(m_Blocks, cChunkDef::NumBlocks * 9, Block::Air::Air());
+		for (size_t i = 0; i < 9; i++)
+		{
+			for (auto & Bitmap : m_LightEmitters[i])
+			{
+				Bitmap.fill(0);
+			}
+		}
 	}
 } ;
 
@@ -329,7 +356,7 @@ void cLightingThread::LightChunk(cLightingChunkStay & a_Item)
 
 void cLightingThread::ReadChunks(int a_ChunkX, int a_ChunkZ)
 {
-	cReader Reader(m_Blocks, m_HeightMap);
+	cReader Reader(m_Blocks, m_HeightMap, m_LightEmitters);
 
 	for (int z = 0; z < 3; z++)
 	{
@@ -338,6 +365,7 @@ void cLightingThread::ReadChunks(int a_ChunkX, int a_ChunkZ)
 		{
 			Reader.m_ReadingChunkX = x;
 			VERIFY(m_World.GetChunkData({a_ChunkX + x - 1, a_ChunkZ + z - 1}, Reader));
+			Reader.UnpackBlocks();
 		}  // for z
 	}  // for x
 
@@ -423,21 +451,38 @@ void cLightingThread::PrepareBlockLight()
 	memset(m_IsSeed2, 0, sizeof(m_IsSeed2));
 	m_NumSeeds = 0;
 
-	// Add each emissive block into the seeds:
-	for (int Idx = 0; Idx < (m_MaxHeight * BlocksPerYLayer); ++Idx)
+	// Add each emissive block into the seeds, walking only the set bits of the sections' light-emitting layers:
+	for (int ChunkIdx = 0; ChunkIdx < 9; ChunkIdx++)
 	{
-		if (cBlockInfo::GetLightValue(m_Blocks[Idx]) == 0)
+		const int BaseX = (ChunkIdx % 3) * cChunkDef::Width;
+		const int BaseZ = (ChunkIdx / 3) * cChunkDef::Width;
+		for (size_t SectionY = 0; (SectionY < cChunkDef::NumSections) && (static_cast<int>(SectionY) * cChunkDef::SectionHeight < m_MaxHeight); SectionY++)
 		{
-			// Not a light-emissive block
-			continue;
-		}
+			const auto & Emitters = m_LightEmitters[ChunkIdx][SectionY];
+			for (size_t Word = 0; Word < Emitters.size(); Word++)
+			{
+				for (auto Bits = Emitters[Word]; Bits != 0; Bits &= Bits - 1)
+				{
+					// Convert the bit's section index into the 3x3 blob index:
+					const auto SectionIdx = static_cast<int>(Word * 64 + cSectionLayers::LowestSetBit(Bits));
+					const int y = static_cast<int>(SectionY) * cChunkDef::SectionHeight + SectionIdx / (cChunkDef::Width * cChunkDef::Width);
+					if (y >= m_MaxHeight)
+					{
+						break;
+					}
+					const int z = BaseZ + (SectionIdx / cChunkDef::Width) % cChunkDef::Width;
+					const int x = BaseX + SectionIdx % cChunkDef::Width;
+					const int Idx = y * BlocksPerYLayer + z * cChunkDef::Width * 3 + x;
 
-		// Add current block as a seed:
-		m_IsSeed1[Idx] = true;
-		m_SeedIdx1[m_NumSeeds++] = static_cast<UInt32>(Idx);
+					// Add current block as a seed:
+					m_IsSeed1[Idx] = true;
+					m_SeedIdx1[m_NumSeeds++] = static_cast<UInt32>(Idx);
 
-		// Light it up:
-		m_BlockLight[Idx] = cBlockInfo::GetLightValue(m_Blocks[Idx]);
+					// Light it up:
+					m_BlockLight[Idx] = cBlockInfo::GetLightValue(m_Blocks[Idx]);
+				}
+			}
+		}
 	}
 }
 
@@ -33,6 +33,7 @@ Chunks from m_PostponedQueue are moved back into m_Queue when their neighbors ge
 
 #include "OSSupport/IsThread.h"
 #include "ChunkStay.h"
+#include "ChunkData.h"
 
 
 
@@ -121,6 +122,10 @@ protected:
 	LIGHTTYPE  m_SkyLight  [BlocksPerYLayer * cChunkDef::Height];
 	HEIGHTTYPE m_HeightMap [BlocksPerYLayer];
 
+	/** The light-emitting layer (cSectionLayers) of each section of the 3x3 chunks, indexed by [ChunkZ * 3 + ChunkX][SectionY].
+	All zero for sections without blocks. PrepareBlockLight() seeds only the blocks with their bit set. */
+	ChunkBlockData::SectionBitmap m_LightEmitters[9][cChunkDef::NumSections];
+
 	// Seed management (5.7 MiB)
 	// Two buffers, in each calc step one is set as input and the other as output, then in the next step they're swapped
 	// Each seed is represented twice in this structure - both as a "list" and as a "position".
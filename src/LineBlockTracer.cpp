@@ -5,7 +5,6 @@
 
 #include "Globals.h"
 #include "LineBlockTracer.h"
-#include "BlockInfo.h"
 #include "World.h"
 #include "Chunk.h"
 #include "BoundingBox.h"
@@ -21,7 +20,8 @@ cLineBlockTracer::cLineBlockTracer(cWorld & a_World, cCallbacks & a_Callbacks) :
 	m_Diff(),
 	m_Dir(),
 	m_Current(),
-	m_CurrentFace(BLOCK_FACE_NONE)
+	m_CurrentFace(BLOCK_FACE_NONE),
+	m_LayerFilter()
 {
 }
 
@@ -100,11 +100,7 @@ bool cLineBlockTracer::FirstSolidHitTrace(
 
 		virtual bool OnNextBlock(Vector3i a_BlockPos, BlockState a_Block, eBlockFace a_EntryFace) override
 		{
-			if (!cBlockInfo::IsSolid(a_Block))
-			{
-				return false;
-			}
-
+			// Only solid blocks are reported (see the layer filter below).
 			// We hit a solid block, calculate the exact hit coords and abort trace:
 			m_HitBlockCoords = a_BlockPos;
 			m_HitBlockFace = a_EntryFace;
@@ -127,7 +123,10 @@ bool cLineBlockTracer::FirstSolidHitTrace(
 		Vector3i & m_HitBlockCoords;
 		eBlockFace & m_HitBlockFace;
 	} callbacks(a_Start, a_End, a_HitCoords, a_HitBlockCoords, a_HitBlockFace);
-	return !Trace(a_World, callbacks, a_Start, a_End);
+
+	cLineBlockTracer Tracer(a_World, callbacks);
+	Tracer.SetLayerFilter(eBlockLayer::Solid);
+	return !Tracer.Trace(a_Start, a_End);
 }
 
 
@@ -325,6 +324,10 @@ bool cLineBlockTracer::ChunkCallback(cChunk * a_Chunk)
 		{
 			int RelX = m_Current.x - a_Chunk->GetPosX() * cChunkDef::Width;
 			int RelZ = m_Current.z - a_Chunk->GetPosZ() * cChunkDef::Width;
+			if (m_LayerFilter.has_value() && !a_Chunk->IsBlockInLayer({RelX, m_Current.y, RelZ}, *m_LayerFilter))
+			{
+				continue;
+			}
 			auto BlockToCheck = a_Chunk->GetBlock({RelX, m_Current.y, RelZ});
 			if (m_Callbacks->OnNextBlock(m_Current, BlockToCheck, m_CurrentFace))
 			{
@@ -9,7 +9,10 @@
 
 #pragma once
 
+#include <optional>
+
 #include "BlockTracer.h"
+#include "ChunkLayers.h"
 
 
 
@@ -47,6 +50,10 @@ public:
 	/** Traces one line between Start and End; returns true if the entire line was traced (until OnNoMoreHits()) */
 	bool Trace(Vector3d a_Start, Vector3d a_End);
 
+	/** Reports to OnNextBlock() only the blocks in the specified layer, the other blocks are passed by testing the chunk's layer bits, without reading them.
+	For traces that stop only at blocks of a single kind, such as the first solid block. */
+	void SetLayerFilter(eBlockLayer a_Layer) { m_LayerFilter = a_Layer; }
+
 
 	// Utility functions for simple one-line usage:
 
@@ -90,6 +97,9 @@ protected:
 	/** The face through which the current block has been entered */
 	eBlockFace m_CurrentFace;
 
+	/** The layer of the blocks reported to OnNextBlock(), set by SetLayerFilter(); all blocks are reported if not set. */
+	std::optional<eBlockLayer> m_LayerFilter;
+
 
 	/** Adjusts the start point above the world to just at the world's top */
 	void FixStartAboveWorld(void);
@@ -40,6 +40,255 @@ static void WriteLogOpener(fmt::memory_buffer & Buffer)
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+// cLogger::cQueue:
+
+/** Bounded lock-free multi-producer queue of preformatted messages.
+Each cell carries a sequence number that tells the producers and the consumer whose turn it is (D. Vyukov's design).
+The cells' strings are swapped out, rather than freed, by the consumer, so their buffers get reused. */
+class cLogger::cQueue
+{
+public:
+
+	cQueue(size_t a_Size):
+		m_Mask(RoundUpToPowerOfTwo(a_Size) - 1),
+		m_Cells(new sCell[m_Mask + 1]),
+		m_EnqueuePos(0),
+		m_DequeuePos(0),
+		m_IsConsumerClaimed(false)
+	{
+		for (size_t i = 0; i <= m_Mask; i++)
+		{
+			m_Cells[i].m_Sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+
+	/** Copies the message into the queue. Returns false if the queue is full. Safe to call from any thread. */
+	bool TryPush(std::string_view a_Message, eLogLevel a_LogLevel)
+	{
+		auto Pos = m_EnqueuePos.load(std::memory_order_relaxed);
+		sCell * Cell;
+		for (;;)
+		{
+			Cell = &m_Cells[Pos & m_Mask];
+			auto Sequence = Cell->m_Sequence.load(std::memory_order_acquire);
+			auto Diff = static_cast<std::ptrdiff_t>(Sequence) - static_cast<std::ptrdiff_t>(Pos);
+			if (Diff == 0)
+			{
+				if (m_EnqueuePos.compare_exchange_weak(Pos, Pos + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if (Diff < 0)
+			{
+				// The consumer hasn't freed this cell yet, the queue is full:
+				return false;
+			}
+			else
+			{
+				Pos = m_EnqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+		Cell->m_Message.assign(a_Message.data(), a_Message.size());
+		Cell->m_LogLevel = a_LogLevel;
+		Cell->m_Sequence.store(Pos + 1, std::memory_order_release);
+		return true;
+	}
+
+
+	/** Claims the consumer side of the queue for the caller. Returns false if another consumer holds it. */
+	bool TryClaimConsumer(void)
+	{
+		return !m_IsConsumerClaimed.exchange(true, std::memory_order_acquire);
+	}
+
+
+	/** Releases the consumer side claimed by TryClaimConsumer(). */
+	void ReleaseConsumer(void)
+	{
+		m_IsConsumerClaimed.store(false, std::memory_order_release);
+	}
+
+
+	/** Moves the oldest message out of the queue into a_Message. Returns false if the queue is empty.
+	The caller must have claimed the consumer side. */
+	bool TryPop(AString & a_Message, eLogLevel & a_LogLevel)
+	{
+		auto & Cell = m_Cells[m_DequeuePos & m_Mask];
+		if (Cell.m_Sequence.load(std::memory_order_acquire) != m_DequeuePos + 1)
+		{
+			return false;
+		}
+		std::swap(a_Message, Cell.m_Message);
+		a_LogLevel = Cell.m_LogLevel;
+		Cell.m_Sequence.store(m_DequeuePos + m_Mask + 1, std::memory_order_release);
+		m_DequeuePos += 1;
+		return true;
+	}
+
+
+	/** Passes each queued message to a_Callback straight from its cell and frees the cells,
+	without allocating or freeing any memory. The caller must have claimed the consumer side. */
+	template <typename Callback>
+	void PopAllInPlace(Callback && a_Callback)
+	{
+		for (;;)
+		{
+			auto & Cell = m_Cells[m_DequeuePos & m_Mask];
+			if (Cell.m_Sequence.load(std::memory_order_acquire) != m_DequeuePos + 1)
+			{
+				return;
+			}
+			a_Callback(std::string_view(Cell.m_Message), Cell.m_LogLevel);
+			Cell.m_Sequence.store(m_DequeuePos + m_Mask + 1, std::memory_order_release);
+			m_DequeuePos += 1;
+		}
+	}
+
+private:
+
+	struct sCell
+	{
+		std::atomic<size_t> m_Sequence;
+		AString m_Message;
+		eLogLevel m_LogLevel;
+	};
+
+	const size_t m_Mask;
+	std::unique_ptr<sCell[]> m_Cells;
+
+	/** Position of the next push; kept on a separate cache line from the consumer's position. */
+	alignas(64) std::atomic<size_t> m_EnqueuePos;
+
+	/** Position of the next pop. Only accessed by the consumer holding m_IsConsumerClaimed. */
+	alignas(64) size_t m_DequeuePos;
+
+	/** Set while a consumer is popping. The writers are serialized by the logger lock already,
+	this lets the crash handler, which can't take that lock, tell whether it may pop. */
+	std::atomic<bool> m_IsConsumerClaimed;
+
+
+	static size_t RoundUpToPowerOfTwo(size_t a_Value)
+	{
+		size_t res = 2;
+		while (res < a_Value)
+		{
+			res *= 2;
+		}
+		return res;
+	}
+};
+
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// cLogger::cWriterThread:
+
+/** The thread that writes out the messages queued in the asynchronous mode. */
+class cLogger::cWriterThread:
+	public cIsThread
+{
+	using Super = cIsThread;
+
+public:
+
+	cWriterThread(cLogger & a_Logger):
+		Super("Logger"),
+		m_Logger(a_Logger),
+		m_IsSleeping(false)
+	{
+	}
+
+
+	virtual ~cWriterThread() override
+	{
+		Stop();
+	}
+
+
+	/** Wakes the thread up, if it is waiting for new messages. Called by the producers after queueing. */
+	void Wake(void)
+	{
+		if (m_IsSleeping.load(std::memory_order_acquire))
+		{
+			m_Event.Set();
+		}
+	}
+
+
+	void Stop(void)
+	{
+		m_ShouldTerminate = true;
+		m_Event.Set();
+		Super::Stop();
+	}
+
+private:
+
+	/** Maximum number of messages passed to the listeners before they are flushed. */
+	static const size_t BATCH_SIZE = 256;
+
+	cLogger & m_Logger;
+
+	/** Set while the thread waits for m_Event; the producers only signal the event then. */
+	std::atomic<bool> m_IsSleeping;
+
+	cEvent m_Event;
+
+
+	virtual void Execute(void) override
+	{
+		while (!m_ShouldTerminate)
+		{
+			if (m_Logger.WriteQueued(BATCH_SIZE) > 0)
+			{
+				continue;
+			}
+
+			// Nothing to write, sleep until a producer wakes us up.
+			// The timeout covers the race between the last check and setting the flag:
+			m_IsSleeping.store(true, std::memory_order_release);
+			if (m_Logger.WriteQueued(BATCH_SIZE) == 0)
+			{
+				m_Event.Wait(50);
+			}
+			m_IsSleeping.store(false, std::memory_order_release);
+		}
+	}
+};
+
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// cLogger:
+
+cLogger::cLogger():
+	m_IsAsync(false),
+	m_OverflowPolicy(eOverflowPolicy::Block),
+	m_NumQueued(0),
+	m_NumDropped(0)
+{
+}
+
+
+
+
+
+cLogger::~cLogger()
+{
+	StopAsync();
+}
+
+
+
+
+
 cLogger & cLogger::GetInstance(void)
 {
 	static cLogger Instance;
@@ -73,11 +322,173 @@ void cLogger::LogSimple(std::string_view a_Message, eLogLevel a_LogLevel)
 
 void cLogger::LogLine(std::string_view a_Line, eLogLevel a_LogLevel)
 {
+	if (!m_IsAsync.load(std::memory_order_acquire))
+	{
+		cCSLock Lock(m_CriticalSection);
+		DispatchLine(a_Line, a_LogLevel);
+		return;
+	}
+
+	while (!m_Queue->TryPush(a_Line, a_LogLevel))
+	{
+		if (
+			(m_OverflowPolicy == eOverflowPolicy::Drop) ||
+			m_WriterThread->IsCurrentThread()  // A listener logging from the writer thread would wait forever
+		)
+		{
+			m_NumDropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		m_WriterThread->Wake();
+		std::this_thread::yield();
+	}
+	m_NumQueued.fetch_add(1, std::memory_order_relaxed);
+
+	if (m_IsAsync.load(std::memory_order_acquire))
+	{
+		m_WriterThread->Wake();
+	}
+	else
+	{
+		// StopAsync() has been called while we were queueing, make sure the message doesn't get stuck in the queue:
+		Flush();
+	}
+}
+
+
+
+
+
+void cLogger::DispatchLine(std::string_view a_Line, eLogLevel a_LogLevel)
+{
+	for (auto & Listener : m_LogListeners)
+	{
+		Listener->Log(a_Line, a_LogLevel);
+	}
+	for (auto & Listener : m_LogListeners)
+	{
+		Listener->Flush();
+	}
+}
+
+
+
+
+
+size_t cLogger::WriteQueued(size_t a_MaxCount)
+{
+	if (m_Queue == nullptr)
+	{
+		return 0;
+	}
+
 	cCSLock Lock(m_CriticalSection);
-	for (size_t i = 0; i < m_LogListeners.size(); i++)
+	if (!m_Queue->TryClaimConsumer())
 	{
-		m_LogListeners[i]->Log(a_Line, a_LogLevel);
+		// The crash handler is writing the queue out
+		return 0;
 	}
+	AString Message;
+	eLogLevel LogLevel;
+	size_t NumWritten = 0;
+	while ((NumWritten < a_MaxCount) && m_Queue->TryPop(Message, LogLevel))
+	{
+		for (auto & Listener : m_LogListeners)
+		{
+			Listener->Log(Message, LogLevel);
+		}
+		NumWritten += 1;
+	}
+	m_Queue->ReleaseConsumer();
+	if (NumWritten > 0)
+	{
+		for (auto & Listener : m_LogListeners)
+		{
+			Listener->Flush();
+		}
+	}
+	return NumWritten;
+}
+
+
+
+
+
+void cLogger::StartAsync(size_t a_QueueSize, eOverflowPolicy a_OverflowPolicy)
+{
+	cCSLock Lock(m_CriticalSection);
+	if (m_IsAsync)
+	{
+		return;
+	}
+	if (m_Queue == nullptr)
+	{
+		m_Queue = std::make_unique<cQueue>(a_QueueSize);
+	}
+	if (m_WriterThread == nullptr)
+	{
+		m_WriterThread = std::make_unique<cWriterThread>(*this);
+	}
+	m_OverflowPolicy = a_OverflowPolicy;
+	m_WriterThread->Start();
+	m_IsAsync.store(true, std::memory_order_release);
+}
+
+
+
+
+
+void cLogger::StopAsync(void)
+{
+	{
+		cCSLock Lock(m_CriticalSection);
+		if (!m_IsAsync)
+		{
+			return;
+		}
+		m_IsAsync.store(false, std::memory_order_release);
+	}
+
+	// Stop the thread outside the lock, it may be waiting for it in WriteQueued().
+	// The thread object is kept, producers that still saw the async mode may be waking it up:
+	m_WriterThread->Stop();
+	Flush();
+}
+
+
+
+
+
+void cLogger::Flush(void)
+{
+	while (WriteQueued(std::numeric_limits<size_t>::max()) > 0)
+	{
+		// Repeat until the producers that raced with us are written out, too
+	}
+}
+
+
+
+
+
+void cLogger::FlushFromSignalHandler(void)
+{
+	// The crashed thread may hold m_CriticalSection, so the listeners are walked without it.
+	// They are only attached and detached at startup and shutdown:
+	if ((m_Queue == nullptr) || !m_Queue->TryClaimConsumer())
+	{
+		return;
+	}
+	m_Queue->PopAllInPlace([this](std::string_view a_Message, eLogLevel a_LogLevel)
+		{
+			for (auto & Listener : m_LogListeners)
+			{
+				Listener->LogFromSignalHandler(a_Message, a_LogLevel);
+			}
+		}
+	);
+
+	// Keep the claim, the process is going down and nobody else may touch the cells anymore
 }
 
 
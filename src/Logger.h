@@ -11,9 +11,31 @@ public:
 		public:
 		virtual void Log(std::string_view a_Message, eLogLevel a_LogLevel) = 0;
 
+		/** Called after a message, or a batch of messages in the asynchronous mode, has been passed to Log().
+		Listeners that buffer their output should write it out here. */
+		virtual void Flush() {}
+
+		/** Writes the message straight into the underlying OS file descriptor, bypassing any buffering and locking.
+		Called only from the crash signal handlers, so it may use only async-signal-safe functions, such as write(2). */
+		virtual void LogFromSignalHandler(std::string_view a_Message, eLogLevel a_LogLevel)
+		{
+			UNUSED(a_Message);
+			UNUSED(a_LogLevel);
+		}
+
 		virtual ~cListener(){}
 	};
 
+	/** Specifies what happens to a message logged in the asynchronous mode while the queue is full. */
+	enum class eOverflowPolicy
+	{
+		/** The message is discarded and counted in GetNumDropped(). */
+		Drop,
+
+		/** The logging thread waits until the writer thread makes space in the queue. */
+		Block,
+	};
+
 	class cAttachment
 	{
 		public:
@@ -60,6 +82,30 @@ public:
 
 	cAttachment AttachListener(std::unique_ptr<cListener> a_Listener);
 
+	/** Switches to the asynchronous mode: logging only pushes the formatted message into a lock-free queue
+	and a dedicated writer thread passes the messages to the listeners in batches.
+	a_QueueSize is the number of messages the queue can hold, rounded up to a power of two.
+	The queue is allocated on the first call only, subsequent calls reuse it and ignore a_QueueSize. */
+	void StartAsync(size_t a_QueueSize, eOverflowPolicy a_OverflowPolicy);
+
+	/** Writes out all the queued messages, stops the writer thread and switches back to the synchronous mode. */
+	void StopAsync(void);
+
+	/** Synchronously writes out all the messages queued so far and flushes all listeners.
+	Takes the logger lock, so it mustn't be called from signal handlers; use FlushFromSignalHandler() there. */
+	void Flush(void);
+
+	/** Writes out the messages queued so far through the listeners' LogFromSignalHandler(), without taking any locks
+	or allocating memory, so that the messages leading up to a crash are not lost.
+	If another thread is in the middle of writing out the queue, the queued messages are skipped rather than waited for. */
+	void FlushFromSignalHandler(void);
+
+	/** Returns the total number of messages that went through the asynchronous queue. */
+	UInt64 GetNumQueued(void) const { return m_NumQueued.load(std::memory_order_relaxed); }
+
+	/** Returns the total number of messages that were discarded because the asynchronous queue was full. */
+	UInt64 GetNumDropped(void) const { return m_NumDropped.load(std::memory_order_relaxed); }
+
 	static cLogger & GetInstance(void);
 
 	// Must be called before calling GetInstance in a multithreaded context
@@ -67,9 +113,38 @@ public:
 
 private:
 
+	class cQueue;
+	class cWriterThread;
+
+	/** Protects m_LogListeners and serializes the consumer side of m_Queue. */
 	cCriticalSection m_CriticalSection;
 	std::vector<std::unique_ptr<cListener>> m_LogListeners;
 
+	/** The queue of messages waiting for the writer thread. Allocated on the first StartAsync() call. */
+	std::unique_ptr<cQueue> m_Queue;
+
+	/** The thread dispatching the queued messages to the listeners, valid only in the asynchronous mode. */
+	std::unique_ptr<cWriterThread> m_WriterThread;
+
+	/** Set while LogLine() should queue the messages instead of dispatching them directly. */
+	std::atomic<bool> m_IsAsync;
+
+	eOverflowPolicy m_OverflowPolicy;
+
+	std::atomic<UInt64> m_NumQueued;
+	std::atomic<UInt64> m_NumDropped;
+
+
+	cLogger();
+	~cLogger();
+
 	void DetachListener(cListener * a_Listener);
 	void LogLine(std::string_view a_Line, eLogLevel a_LogLevel);
+
+	/** Passes a single message to all listeners and flushes them. Assumes m_CriticalSection is held. */
+	void DispatchLine(std::string_view a_Line, eLogLevel a_LogLevel);
+
+	/** Passes up to a_MaxCount queued messages to the listeners, then flushes them.
+	Returns the number of messages written. */
+	size_t WriteQueued(size_t a_MaxCount);
 };
@@ -9,6 +9,39 @@
 #endif
 
 
+/** The descriptor of the standard output, the same on all platforms. */
+static const int STDOUT_DESCRIPTOR = 1;
+
+
+
+
+
+/** Writes the data into the OS file descriptor, using only async-signal-safe calls. Used for writing from the crash handlers. */
+static void WriteToDescriptor(int a_Descriptor, std::string_view a_Data)
+{
+	while (!a_Data.empty())
+	{
+		#ifdef _WIN32
+			const auto NumWritten = _write(a_Descriptor, a_Data.data(), static_cast<unsigned>(a_Data.size()));
+		#else
+			const auto NumWritten = write(a_Descriptor, a_Data.data(), a_Data.size());
+			if ((NumWritten < 0) && (errno == EINTR))
+			{
+				continue;
+			}
+		#endif
+		if (NumWritten <= 0)
+		{
+			return;
+		}
+		a_Data.remove_prefix(static_cast<size_t>(NumWritten));
+	}
+}
+
+
+
+
+
 #if defined(_WIN32) || defined (__linux) || defined (__APPLE__)
 	class cColouredConsoleListener
 		: public cLogger::cListener
@@ -24,6 +57,18 @@
 			fwrite(a_Message.data(), sizeof(char), a_Message.size(), stdout);
 			SetDefaultLogColour();
 		}
+
+		virtual void Flush() override
+		{
+			fflush(stdout);
+		}
+
+		virtual void LogFromSignalHandler(std::string_view a_Message, eLogLevel a_LogLevel) override
+		{
+			// No colours, setting them goes through stdio:
+			UNUSED(a_LogLevel);
+			WriteToDescriptor(STDOUT_DESCRIPTOR, a_Message);
+		}
 	};
 #endif
 
@@ -147,7 +192,6 @@
 		{
 			// Whatever the console default is
 			printf("\x1b[0m");
-			fflush(stdout);
 		}
 	};
 
@@ -188,6 +232,12 @@ public:
 		}
 		fwrite(a_Message.data(), sizeof(char), a_Message.size(), stdout);
 	}
+
+	virtual void LogFromSignalHandler(std::string_view a_Message, eLogLevel a_LogLevel) override
+	{
+		UNUSED(a_LogLevel);
+		WriteToDescriptor(STDOUT_DESCRIPTOR, a_Message);
+	}
 };
 
 
@@ -271,50 +321,64 @@ public:
 			),
 			cFile::fmAppend
 		);
+		if (success)
+		{
+			m_Descriptor = m_File.GetDescriptor();
+		}
 		return success;
 	}
 
 	virtual void Log(std::string_view a_Message, eLogLevel a_LogLevel) override
 	{
-		std::string_view LogLevelPrefix = "Unkn ";
-		bool ShouldFlush = false;
-		switch (a_LogLevel)
-		{
-			case eLogLevel::Regular:
-			{
-				LogLevelPrefix = "     ";
-				break;
-			}
-			case eLogLevel::Info:
-			{
-				LogLevelPrefix = "Info ";
-				break;
-			}
-			case eLogLevel::Warning:
-			{
-				LogLevelPrefix = "Warn ";
-				ShouldFlush = true;
-				break;
-			}
-			case eLogLevel::Error:
-			{
-				LogLevelPrefix = "Err  ";
-				ShouldFlush = true;
-				break;
-			}
-		}
-		m_File.Write(LogLevelPrefix);
+		m_File.Write(GetLogLevelPrefix(a_LogLevel));
 		m_File.Write(a_Message);
 
-		if (ShouldFlush)
+		m_ShouldFlush = m_ShouldFlush || (a_LogLevel == eLogLevel::Warning) || (a_LogLevel == eLogLevel::Error);
+	}
+
+	virtual void Flush() override
+	{
+		// Only warnings and errors are flushed immediately, the rest is left to the stdio buffering:
+		if (m_ShouldFlush)
 		{
 			m_File.Flush();
+			m_ShouldFlush = false;
+		}
+	}
+
+	virtual void LogFromSignalHandler(std::string_view a_Message, eLogLevel a_LogLevel) override
+	{
+		// Whatever is still in the stdio buffer gets lost, there's no signal-safe way of flushing it:
+		if (m_Descriptor != -1)
+		{
+			WriteToDescriptor(m_Descriptor, GetLogLevelPrefix(a_LogLevel));
+			WriteToDescriptor(m_Descriptor, a_Message);
 		}
 	}
 
 private:
 
 	cFile m_File;
+
+	/** The OS descriptor of m_File, for writing from the crash handlers; -1 if not open. */
+	int m_Descriptor = -1;
+
+	/** Set when a message that should be flushed immediately has been written since the last Flush(). */
+	bool m_ShouldFlush = false;
+
+
+	/** Returns the prefix that marks the log level of the messages in the file. */
+	static std::string_view GetLogLevelPrefix(eLogLevel a_LogLevel)
+	{
+		switch (a_LogLevel)
+		{
+			case eLogLevel::Regular: return "     ";
+			case eLogLevel::Info:    return "Info ";
+			case eLogLevel::Warning: return "Warn ";
+			case eLogLevel::Error:   return "Err  ";
+		}
+		return "Unkn ";
+	}
 };
 
 
@@ -80,6 +80,13 @@ bool cMobSpawner::CanSpawnHere(cChunk * a_Chunk, Vector3i a_RelPos, eMonsterType
 		return false;
 	}
 
+	// Every mob but the wolf, which spawns in the grass block, needs air or water at its feet;
+	// the chunk's layers tell without looking at the block:
+	if ((a_MobType != mtWolf) && a_Chunk->IsBlockInLayer(a_RelPos, eBlockLayer::SpawnBlocking))
+	{
+		return false;
+	}
+
 	if (cChunkDef::IsValidHeight(a_RelPos.addedY(-1)) && (a_Chunk->GetBlock(a_RelPos.addedY(-1)).Type() == BlockType::Bedrock))
 	{
 		return false;   // Make sure mobs do not spawn on bedrock.
@@ -92,6 +99,7 @@ bool cMobSpawner::CanSpawnHere(cChunk * a_Chunk, Vector3i a_RelPos, eMonsterType
 	auto SkyLight = a_Chunk->GetSkyLight(a_RelPos);
 	auto BlockAbove = a_Chunk->GetBlock(a_RelPos.addedY(1));
 	auto BlockBelow = a_Chunk->GetBlock(a_RelPos.addedY(-1));
+	const bool IsBlockBelowTransparent = a_Chunk->IsBlockInLayer(a_RelPos.addedY(-1), eBlockLayer::Transparent);
 
 	SkyLight = a_Chunk->GetTimeAlteredLight(SkyLight);
 
@@ -105,7 +113,7 @@ bool cMobSpawner::CanSpawnHere(cChunk * a_Chunk, Vector3i a_RelPos, eMonsterType
 				(BlockLight <= 4) &&
 				(SkyLight <= 4) &&
 				IsBlockAir(TargetBlock) &&
-				(!cBlockInfo::IsTransparent(BlockAbove))
+				(!a_Chunk->IsBlockInLayer(a_RelPos.addedY(1), eBlockLayer::Transparent))
 			);
 		}
 
@@ -115,7 +123,7 @@ bool cMobSpawner::CanSpawnHere(cChunk * a_Chunk, Vector3i a_RelPos, eMonsterType
 			(
 				IsBlockAir(TargetBlock) &&
 				IsBlockAir(BlockAbove) &&
-				((!cBlockInfo::IsTransparent(BlockBelow)) || (a_DisableSolidBelowCheck)) &&
+				((!IsBlockBelowTransparent) || (a_DisableSolidBelowCheck)) &&
 				(Random.RandBool())
 			);
 		}
@@ -125,7 +133,7 @@ bool cMobSpawner::CanSpawnHere(cChunk * a_Chunk, Vector3i a_RelPos, eMonsterType
 			return
 			(
 				IsBlockAir(TargetBlock) &&
-				((!cBlockInfo::IsTransparent(BlockBelow)) || (a_DisableSolidBelowCheck)) &&
+				((!IsBlockBelowTransparent) || (a_DisableSolidBelowCheck)) &&
 				(SkyLight <= 7) &&
 				(BlockLight <= 7) &&
 				(Random.RandBool())
@@ -141,9 +149,8 @@ bool cMobSpawner::CanSpawnHere(cChunk * a_Chunk, Vector3i a_RelPos, eMonsterType
 		{
 			return
 			(
-				IsBlockAir(TargetBlock) &&
+				(TargetBlock.Type() == BlockType::GrassBlock) &&
 				IsBlockAir(BlockAbove) &&
-				(BlockBelow.Type() == BlockType::GrassBlock) &&
 				(SkyLight >= 9)
 			);
 		}
@@ -156,7 +163,7 @@ bool cMobSpawner::CanSpawnHere(cChunk * a_Chunk, Vector3i a_RelPos, eMonsterType
 			(
 				IsBlockAir(TargetBlock) &&
 				IsBlockAir(BlockAbove) &&
-				((!cBlockInfo::IsTransparent(BlockBelow)) || (a_DisableSolidBelowCheck)) &&
+				((!IsBlockBelowTransparent) || (a_DisableSolidBelowCheck)) &&
 				(SkyLight <= 7) &&
 				(BlockLight <= 7) &&
 				(Random.RandBool())
@@ -176,7 +183,7 @@ bool cMobSpawner::CanSpawnHere(cChunk * a_Chunk, Vector3i a_RelPos, eMonsterType
 						IsBlockAir(TargetBlock) &&
 						IsBlockAir(BlockAbove) &&
 						IsBlockAir(BlockTop) &&
-						((!cBlockInfo::IsTransparent(BlockBelow)) || (a_DisableSolidBelowCheck)) &&
+						((!IsBlockBelowTransparent) || (a_DisableSolidBelowCheck)) &&
 						(SkyLight <= 7) &&
 						(BlockLight <= 7)
 					);
@@ -218,7 +225,7 @@ bool cMobSpawner::CanSpawnHere(cChunk * a_Chunk, Vector3i a_RelPos, eMonsterType
 				IsBlockAir(TargetBlock) &&
 				IsBlockAir(BlockAbove) &&
 				(
-					(!cBlockInfo::IsTransparent(BlockBelow)) ||
+					(!IsBlockBelowTransparent) ||
 					(a_DisableSolidBelowCheck)) &&
 				(
 					(
@@ -305,7 +312,7 @@ bool cMobSpawner::CanSpawnHere(cChunk * a_Chunk, Vector3i a_RelPos, eMonsterType
 			return (
 				IsBlockAir(TargetBlock) &&
 				IsBlockAir(BlockAbove) &&
-				((!cBlockInfo::IsTransparent(BlockBelow)) || (a_DisableSolidBelowCheck)) &&
+				((!IsBlockBelowTransparent) || (a_DisableSolidBelowCheck)) &&
 				(SkyLight <= 7) &&
 				(BlockLight <= 7) &&
 				(Random.RandBool(0.6))
@@ -336,7 +343,7 @@ bool cMobSpawner::CanSpawnHere(cChunk * a_Chunk, Vector3i a_RelPos, eMonsterType
 			return (
 				IsBlockAir(TargetBlock) &&
 				IsBlockAir(BlockAbove) &&
-				((!cBlockInfo::IsTransparent(BlockBelow)) || (a_DisableSolidBelowCheck))
+				((!IsBlockBelowTransparent) || (a_DisableSolidBelowCheck))
 			);
 		}
 
@@ -39,7 +39,7 @@ void cBlaze::GetDrops(cItems & a_Drops, cEntity * a_Killer)
 {
 	if ((a_Killer != nullptr) && (a_Killer->IsPlayer() || a_Killer->IsA("cWolf")))
 	{
-		unsigned int LootingLevel = a_Killer->GetEquippedWeapon().m_Enchantments.GetLevel(cEnchantments::enchLooting);
+		unsigned int LootingLevel = a_Killer->GetEquippedWeapon().GetEnchantments().GetLevel(cEnchantments::enchLooting);
 		AddRandomDropItem(a_Drops, 0, 1 + LootingLevel, Item::BlazeRod);
 	}
 }
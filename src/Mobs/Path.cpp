@@ -508,6 +508,7 @@ void cPath::FillCellAttributes(cPathCell & a_Cell)
 
 	auto BlockToCheck = m_Chunk->GetBlock(RelX, Location.y, RelZ);
 	a_Cell.m_Block = BlockToCheck;
+	const bool IsSolid = m_Chunk->IsBlockInLayer({RelX, Location.y, RelZ}, eBlockLayer::Solid);
 
 
 	if (BlockTypeIsSpecial(BlockToCheck))
@@ -515,7 +516,7 @@ void cPath::FillCellAttributes(cPathCell & a_Cell)
 		a_Cell.m_IsSpecial = true;
 		a_Cell.m_IsSolid = true;  // Specials are solids only from a certain direction. But their m_IsSolid is always true
 	}
-	else if ((!cBlockInfo::IsSolid(a_Cell.m_Block)) && cBlockFenceHandler::IsBlockFence(GetCell(Location + Vector3i(0, -1, 0))->m_Block))
+	else if (!IsSolid && cBlockFenceHandler::IsBlockFence(GetCell(Location + Vector3i(0, -1, 0))->m_Block))
 	{
 		// Nonsolid blocks with fences below them are consider Special Solids. That is, they sometimes behave as solids.
 		a_Cell.m_IsSpecial = true;
@@ -525,7 +526,7 @@ void cPath::FillCellAttributes(cPathCell & a_Cell)
 	{
 
 		a_Cell.m_IsSpecial = false;
-		a_Cell.m_IsSolid = cBlockInfo::IsSolid(BlockToCheck);
+		a_Cell.m_IsSolid = IsSolid;
 	}
 
 }
@@ -639,7 +640,7 @@ bool cPath::SpecialIsSolidFromThisDirection(BlockState a_Block, const Vector3i &
 
 
 	// If there is a nonsolid above a fence
-	if (!cBlockInfo::IsSolid(a_Block))
+	if (!cSectionLayers::IsInLayer(a_Block, eBlockLayer::Solid))
 	{
 		// Only treat as solid when we're coming from below
 		return (a_Direction.y > 0);
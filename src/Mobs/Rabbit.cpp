@@ -41,7 +41,7 @@ void cRabbit::GetDrops(cItems & a_Drops, cEntity * a_Killer)
 	unsigned int LootingLevel = 0;
 	if (a_Killer != nullptr)
 	{
-		LootingLevel = a_Killer->GetEquippedWeapon().m_Enchantments.GetLevel(cEnchantments::enchLooting);
+		LootingLevel = a_Killer->GetEquippedWeapon().GetEnchantments().GetLevel(cEnchantments::enchLooting);
 	}
 	AddRandomDropItem(a_Drops, 0, 1 + LootingLevel, IsOnFire() ? Item::CookedRabbit : Item::Rabbit);
 	AddRandomDropItem(a_Drops, 0, 1 + LootingLevel, Item::RabbitHide);
@@ -37,7 +37,7 @@ void cWitherSkeleton::GetDrops(cItems & a_Drops, cEntity * a_Killer)
 	unsigned int LootingLevel = 0;
 	if (a_Killer != nullptr)
 	{
-		LootingLevel = a_Killer->GetEquippedWeapon().m_Enchantments.GetLevel(cEnchantments::enchLooting);
+		LootingLevel = a_Killer->GetEquippedWeapon().GetEnchantments().GetLevel(cEnchantments::enchLooting);
 	}
 	AddRandomUncommonDropItem(a_Drops, 33.0f, Item::Coal);
 	AddRandomUncommonDropItem(a_Drops, 8.5f, Item::StoneSword);  // TODO(12xx12) readd this when move to new item enum is done;, GetRandomProvider().RandInt<short>(50));
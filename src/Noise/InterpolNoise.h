@@ -20,7 +20,6 @@
 ////////////////////////////////////////////////////////////////////////////////
 // cInterpolCell2D:
 
-template <typename T>
 class cInterpolCell2D
 {
 public:
@@ -28,8 +27,9 @@ public:
 		const cNoise & a_Noise,    ///< Noise to use for generating the random values
 		NOISE_DATATYPE * a_Array,  ///< Array to generate into [x + a_SizeX * y]
 		int a_SizeX, int a_SizeY,  ///< Count of the array, in each direction
-		const NOISE_DATATYPE * a_FracX,  ///< Pointer to the array that stores the X fractional values
-		const NOISE_DATATYPE * a_FracY   ///< Pointer to the attay that stores the Y fractional values
+		const NOISE_DATATYPE * a_RatioX,  ///< Pointer to the array that stores the X interpolation ratios
+		const NOISE_DATATYPE * a_RatioY,  ///< Pointer to the array that stores the Y interpolation ratios
+		const sNoiseOutput & a_Output     ///< How to write the values into the array
 	):
 		m_Noise(a_Noise),
 		m_WorkRnds(&m_Workspace1),
@@ -38,8 +38,9 @@ public:
 		m_Array(a_Array),
 		m_SizeX(a_SizeX),
 		m_SizeY(a_SizeY),
-		m_FracX(a_FracX),
-		m_FracY(a_FracY)
+		m_RatioX(a_RatioX),
+		m_RatioY(a_RatioY),
+		m_Output(a_Output)
 	{
 	}
 
@@ -53,14 +54,10 @@ public:
 		for (int y = a_FromY; y < a_ToY; y++)
 		{
 			NOISE_DATATYPE Interp[2];
-			NOISE_DATATYPE FracY = T::coeff(m_FracY[y]);
-			Interp[0] = Lerp((*m_WorkRnds)[0][0], (*m_WorkRnds)[0][1], FracY);
-			Interp[1] = Lerp((*m_WorkRnds)[1][0], (*m_WorkRnds)[1][1], FracY);
-			int idx = y * m_SizeX + a_FromX;
-			for (int x = a_FromX; x < a_ToX; x++)
-			{
-				m_Array[idx++] = Lerp(Interp[0], Interp[1], T::coeff(m_FracX[x]));
-			}  // for x
+			NOISE_DATATYPE RatioY = m_RatioY[y];
+			Interp[0] = Lerp((*m_WorkRnds)[0][0], (*m_WorkRnds)[0][1], RatioY);
+			Interp[1] = Lerp((*m_WorkRnds)[1][0], (*m_WorkRnds)[1][1], RatioY);
+			NoiseKernels::LerpRow(m_Array + y * m_SizeX + a_FromX, a_ToX - a_FromX, m_RatioX + a_FromX, Interp[0], Interp[1], m_Output);
 		}  // for y
 	}
 
@@ -136,9 +133,12 @@ protected:
 	/** Dimensions of the output array. */
 	int m_SizeX, m_SizeY;
 
-	/** Arrays holding the fractional values of the coords in each direction. */
-	const NOISE_DATATYPE * m_FracX;
-	const NOISE_DATATYPE * m_FracY;
+	/** Arrays holding the interpolation ratios of the coords in each direction. */
+	const NOISE_DATATYPE * m_RatioX;
+	const NOISE_DATATYPE * m_RatioY;
+
+	/** How to write the values into the output array. */
+	const sNoiseOutput & m_Output;
 } ;
 
 
@@ -152,7 +152,6 @@ protected:
 Provides a massive optimization for cInterpolNoise.
 Works by calculating multiple noise values (that have the same integral noise coords) at once. The underlying noise values
 needn't be recalculated for these values, only the interpolation is done within the unit cube. */
-template <typename T>
 class cInterpolCell3D
 {
 public:
@@ -160,9 +159,10 @@ public:
 		const cNoise & a_Noise,                 ///< Noise to use for generating the random values
 		NOISE_DATATYPE * a_Array,               ///< Array to generate into [x + a_SizeX * y]
 		int a_SizeX, int a_SizeY, int a_SizeZ,  ///< Count of the array, in each direction
-		const NOISE_DATATYPE * a_FracX,         ///< Pointer to the array that stores the X fractional values
-		const NOISE_DATATYPE * a_FracY,         ///< Pointer to the attay that stores the Y fractional values
-		const NOISE_DATATYPE * a_FracZ          ///< Pointer to the array that stores the Z fractional values
+		const NOISE_DATATYPE * a_RatioX,        ///< Pointer to the array that stores the X interpolation ratios
+		const NOISE_DATATYPE * a_RatioY,        ///< Pointer to the array that stores the Y interpolation ratios
+		const NOISE_DATATYPE * a_RatioZ,        ///< Pointer to the array that stores the Z interpolation ratios
+		const sNoiseOutput & a_Output           ///< How to write the values into the array
 	):
 		m_Noise(a_Noise),
 		m_WorkRnds(&m_Workspace1),
@@ -173,9 +173,10 @@ public:
 		m_SizeX(a_SizeX),
 		m_SizeY(a_SizeY),
 		m_SizeZ(a_SizeZ),
-		m_FracX(a_FracX),
-		m_FracY(a_FracY),
-		m_FracZ(a_FracZ)
+		m_RatioX(a_RatioX),
+		m_RatioY(a_RatioY),
+		m_RatioZ(a_RatioZ),
+		m_Output(a_Output)
 	{
 	}
 
@@ -191,25 +192,21 @@ public:
 		{
 			int idxZ = z * m_SizeX * m_SizeY;
 			NOISE_DATATYPE Interp2[2][2];
-			NOISE_DATATYPE FracZ = T::coeff(m_FracZ[z]);
+			NOISE_DATATYPE RatioZ = m_RatioZ[z];
 			for (int x = 0; x < 2; x++)
 			{
 				for (int y = 0; y < 2; y++)
 				{
-					Interp2[x][y] = Lerp((*m_WorkRnds)[x][y][0], (*m_WorkRnds)[x][y][1], FracZ);
+					Interp2[x][y] = Lerp((*m_WorkRnds)[x][y][0], (*m_WorkRnds)[x][y][1], RatioZ);
 				}
 			}
 			for (int y = a_FromY; y < a_ToY; y++)
 			{
 				NOISE_DATATYPE Interp[2];
-				NOISE_DATATYPE FracY = T::coeff(m_FracY[y]);
-				Interp[0] = Lerp(Interp2[0][0], Interp2[0][1], FracY);
-				Interp[1] = Lerp(Interp2[1][0], Interp2[1][1], FracY);
-				int idx = idxZ + y * m_SizeX + a_FromX;
-				for (int x = a_FromX; x < a_ToX; x++)
-				{
-					m_Array[idx++] = Lerp(Interp[0], Interp[1], T::coeff(m_FracX[x]));
-				}  // for x
+				NOISE_DATATYPE RatioY = m_RatioY[y];
+				Interp[0] = Lerp(Interp2[0][0], Interp2[0][1], RatioY);
+				Interp[1] = Lerp(Interp2[1][0], Interp2[1][1], RatioY);
+				NoiseKernels::LerpRow(m_Array + idxZ + y * m_SizeX + a_FromX, a_ToX - a_FromX, m_RatioX + a_FromX, Interp[0], Interp[1], m_Output);
 			}  // for y
 		}  // for z
 	}
@@ -299,10 +296,13 @@ protected:
 	/** Dimensions of the output array. */
 	int m_SizeX, m_SizeY, m_SizeZ;
 
-	/** Arrays holding the fractional values of the coords in each direction. */
-	const NOISE_DATATYPE * m_FracX;
-	const NOISE_DATATYPE * m_FracY;
-	const NOISE_DATATYPE * m_FracZ;
+	/** Arrays holding the interpolation ratios of the coords in each direction. */
+	const NOISE_DATATYPE * m_RatioX;
+	const NOISE_DATATYPE * m_RatioY;
+	const NOISE_DATATYPE * m_RatioZ;
+
+	/** How to write the values into the output array. */
+	const sNoiseOutput & m_Output;
 } ;
 
 
@@ -337,7 +337,8 @@ public:
 		NOISE_DATATYPE * a_Array,                        ///< Array to generate into [x + a_SizeX * y]
 		int a_SizeX, int a_SizeY,                        ///< Count of the array, in each direction
 		NOISE_DATATYPE a_StartX, NOISE_DATATYPE a_EndX,  ///< Noise-space coords of the array in the X direction
-		NOISE_DATATYPE a_StartY, NOISE_DATATYPE a_EndY   ///< Noise-space coords of the array in the Y direction
+		NOISE_DATATYPE a_StartY, NOISE_DATATYPE a_EndY,  ///< Noise-space coords of the array in the Y direction
+		const sNoiseOutput & a_Output = sNoiseOutput()   ///< How to write the values into the array
 	) const
 	{
 		ASSERT(a_SizeX > 0);
@@ -357,8 +358,10 @@ public:
 		int NumSameX, NumSameY;
 		CalcFloorFrac(a_SizeX, a_StartX, a_EndX, FloorX, FracX, SameX, NumSameX);
 		CalcFloorFrac(a_SizeY, a_StartY, a_EndY, FloorY, FracY, SameY, NumSameY);
+		CalcRatios(a_SizeX, FracX);
+		CalcRatios(a_SizeY, FracY);
 
-		cInterpolCell2D<T> Cell(m_Noise, a_Array, a_SizeX, a_SizeY, FracX, FracY);
+		cInterpolCell2D Cell(m_Noise, a_Array, a_SizeX, a_SizeY, FracX, FracY, a_Output);
 
 		Cell.InitWorkRnds(FloorX[0], FloorY[0]);
 
@@ -388,7 +391,8 @@ public:
 		int a_SizeX, int a_SizeY, int a_SizeZ,           ///< Count of the array, in each direction
 		NOISE_DATATYPE a_StartX, NOISE_DATATYPE a_EndX,  ///< Noise-space coords of the array in the X direction
 		NOISE_DATATYPE a_StartY, NOISE_DATATYPE a_EndY,  ///< Noise-space coords of the array in the Y direction
-		NOISE_DATATYPE a_StartZ, NOISE_DATATYPE a_EndZ   ///< Noise-space coords of the array in the Z direction
+		NOISE_DATATYPE a_StartZ, NOISE_DATATYPE a_EndZ,  ///< Noise-space coords of the array in the Z direction
+		const sNoiseOutput & a_Output = sNoiseOutput()   ///< How to write the values into the array
 	) const
 	{
 		// Check params:
@@ -416,11 +420,15 @@ public:
 		CalcFloorFrac(a_SizeX, a_StartX, a_EndX, FloorX, FracX, SameX, NumSameX);
 		CalcFloorFrac(a_SizeY, a_StartY, a_EndY, FloorY, FracY, SameY, NumSameY);
 		CalcFloorFrac(a_SizeZ, a_StartZ, a_EndZ, FloorZ, FracZ, SameZ, NumSameZ);
+		CalcRatios(a_SizeX, FracX);
+		CalcRatios(a_SizeY, FracY);
+		CalcRatios(a_SizeZ, FracZ);
 
-		cInterpolCell3D<T> Cell(
+		cInterpolCell3D Cell(
 			m_Noise, a_Array,
 			a_SizeX, a_SizeY, a_SizeZ,
-			FracX, FracY, FracZ
+			FracX, FracY, FracZ,
+			a_Output
 		);
 
 		Cell.InitWorkRnds(FloorX[0], FloorY[0], FloorZ[0]);
@@ -511,6 +519,16 @@ protected:
 			a_NumSame += 1;
 		}
 	}
+
+
+	/** Replaces the fractional values in a_Frac with the interpolation ratios, so that the cells needn't calculate them for each value. */
+	static void CalcRatios(int a_Size, NOISE_DATATYPE * a_Frac)
+	{
+		for (int i = 0; i < a_Size; i++)
+		{
+			a_Frac[i] = T::coeff(a_Frac[i]);
+		}
+	}
 };
 
 
@@ -201,7 +201,8 @@ public:
 		NOISE_DATATYPE * a_Array,  ///< Array to generate into [x + a_SizeX * y]
 		int a_SizeX, int a_SizeY,  ///< Count of the array, in each direction
 		const NOISE_DATATYPE * a_FracX,  ///< Pointer to the array that stores the X fractional values
-		const NOISE_DATATYPE * a_FracY   ///< Pointer to the attay that stores the Y fractional values
+		const NOISE_DATATYPE * a_FracY,  ///< Pointer to the attay that stores the Y fractional values
+		const sNoiseOutput & a_Output    ///< How to write the values into the array
 	);
 
 	/** Uses current m_WorkRnds[] to generate part of the array */
@@ -231,6 +232,7 @@ protected:
 	int m_SizeX, m_SizeY;
 	const NOISE_DATATYPE * m_FracX;
 	const NOISE_DATATYPE * m_FracY;
+	const sNoiseOutput & m_Output;
 } ;
 
 
@@ -242,7 +244,8 @@ cCubicCell2D::cCubicCell2D(
 	NOISE_DATATYPE * a_Array,  ///< Array to generate into [x + a_SizeX * y]
 	int a_SizeX, int a_SizeY,  ///< Count of the array, in each direction
 	const NOISE_DATATYPE * a_FracX,  ///< Pointer to the array that stores the X fractional values
-	const NOISE_DATATYPE * a_FracY   ///< Pointer to the attay that stores the Y fractional values
+	const NOISE_DATATYPE * a_FracY,  ///< Pointer to the attay that stores the Y fractional values
+	const sNoiseOutput & a_Output    ///< How to write the values into the array
 ) :
 	m_Noise(a_Noise),
 	m_WorkRnds(&m_Workspace1),
@@ -252,7 +255,8 @@ cCubicCell2D::cCubicCell2D(
 	m_SizeX(a_SizeX),
 	m_SizeY(a_SizeY),
 	m_FracX(a_FracX),
-	m_FracY(a_FracY)
+	m_FracY(a_FracY),
+	m_Output(a_Output)
 {
 }
 
@@ -273,11 +277,10 @@ void cCubicCell2D::Generate(
 		Interp[1] = cNoise::CubicInterpolate((*m_WorkRnds)[1][0], (*m_WorkRnds)[1][1], (*m_WorkRnds)[1][2], (*m_WorkRnds)[1][3], FracY);
 		Interp[2] = cNoise::CubicInterpolate((*m_WorkRnds)[2][0], (*m_WorkRnds)[2][1], (*m_WorkRnds)[2][2], (*m_WorkRnds)[2][3], FracY);
 		Interp[3] = cNoise::CubicInterpolate((*m_WorkRnds)[3][0], (*m_WorkRnds)[3][1], (*m_WorkRnds)[3][2], (*m_WorkRnds)[3][3], FracY);
-		int idx = y * m_SizeX + a_FromX;
-		for (int x = a_FromX; x < a_ToX; x++)
-		{
-			m_Array[idx++] = cNoise::CubicInterpolate(Interp[0], Interp[1], Interp[2], Interp[3], m_FracX[x]);
-		}  // for x
+		NoiseKernels::CubicRow(
+			m_Array + y * m_SizeX + a_FromX, a_ToX - a_FromX, m_FracX + a_FromX,
+			Interp[0], Interp[1], Interp[2], Interp[3], m_Output
+		);
 	}  // for y
 }
 
@@ -353,7 +356,8 @@ public:
 		int a_SizeX, int a_SizeY, int a_SizeZ,  ///< Count of the array, in each direction
 		const NOISE_DATATYPE * a_FracX,         ///< Pointer to the array that stores the X fractional values
 		const NOISE_DATATYPE * a_FracY,         ///< Pointer to the attay that stores the Y fractional values
-		const NOISE_DATATYPE * a_FracZ          ///< Pointer to the array that stores the Z fractional values
+		const NOISE_DATATYPE * a_FracZ,         ///< Pointer to the array that stores the Z fractional values
+		const sNoiseOutput & a_Output           ///< How to write the values into the array
 	);
 
 	/** Uses current m_WorkRnds[] to generate part of the array */
@@ -386,6 +390,7 @@ protected:
 	const NOISE_DATATYPE * m_FracX;
 	const NOISE_DATATYPE * m_FracY;
 	const NOISE_DATATYPE * m_FracZ;
+	const sNoiseOutput & m_Output;
 } ;
 
 
@@ -398,7 +403,8 @@ cCubicCell3D::cCubicCell3D(
 	int a_SizeX, int a_SizeY, int a_SizeZ,  ///< Count of the array, in each direction
 	const NOISE_DATATYPE * a_FracX,         ///< Pointer to the array that stores the X fractional values
 	const NOISE_DATATYPE * a_FracY,         ///< Pointer to the attay that stores the Y fractional values
-	const NOISE_DATATYPE * a_FracZ          ///< Pointer to the array that stores the Z fractional values
+	const NOISE_DATATYPE * a_FracZ,         ///< Pointer to the array that stores the Z fractional values
+	const sNoiseOutput & a_Output           ///< How to write the values into the array
 ) :
 	m_Noise(a_Noise),
 	m_WorkRnds(&m_Workspace1),
@@ -411,7 +417,8 @@ cCubicCell3D::cCubicCell3D(
 	m_SizeZ(a_SizeZ),
 	m_FracX(a_FracX),
 	m_FracY(a_FracY),
-	m_FracZ(a_FracZ)
+	m_FracZ(a_FracZ),
+	m_Output(a_Output)
 {
 }
 
@@ -445,11 +452,10 @@ void cCubicCell3D::Generate(
 			Interp[1] = cNoise::CubicInterpolate(Interp2[1][0], Interp2[1][1], Interp2[1][2], Interp2[1][3], FracY);
 			Interp[2] = cNoise::CubicInterpolate(Interp2[2][0], Interp2[2][1], Interp2[2][2], Interp2[2][3], FracY);
 			Interp[3] = cNoise::CubicInterpolate(Interp2[3][0], Interp2[3][1], Interp2[3][2], Interp2[3][3], FracY);
-			int idx = idxZ + y * m_SizeX + a_FromX;
-			for (int x = a_FromX; x < a_ToX; x++)
-			{
-				m_Array[idx++] = cNoise::CubicInterpolate(Interp[0], Interp[1], Interp[2], Interp[3], m_FracX[x]);
-			}  // for x
+			NoiseKernels::CubicRow(
+				m_Array + idxZ + y * m_SizeX + a_FromX, a_ToX - a_FromX, m_FracX + a_FromX,
+				Interp[0], Interp[1], Interp[2], Interp[3], m_Output
+			);
 		}  // for y
 	}  // for z
 }
@@ -707,7 +713,8 @@ void cCubicNoise::Generate2D(
 	NOISE_DATATYPE * a_Array,                        ///< Array to generate into [x + a_SizeX * y]
 	int a_SizeX, int a_SizeY,                        ///< Size of the array (num doubles), in each direction
 	NOISE_DATATYPE a_StartX, NOISE_DATATYPE a_EndX,  ///< Noise-space coords of the array in the X direction
-	NOISE_DATATYPE a_StartY, NOISE_DATATYPE a_EndY   ///< Noise-space coords of the array in the Y direction
+	NOISE_DATATYPE a_StartY, NOISE_DATATYPE a_EndY,  ///< Noise-space coords of the array in the Y direction
+	const sNoiseOutput & a_Output                    ///< How to write the values into the array
 ) const
 {
 	ASSERT(a_SizeX > 0);
@@ -728,7 +735,7 @@ void cCubicNoise::Generate2D(
 	CalcFloorFrac(a_SizeX, a_StartX, a_EndX, FloorX, FracX, SameX, NumSameX);
 	CalcFloorFrac(a_SizeY, a_StartY, a_EndY, FloorY, FracY, SameY, NumSameY);
 
-	cCubicCell2D Cell(m_Noise, a_Array, a_SizeX, a_SizeY, FracX, FracY);
+	cCubicCell2D Cell(m_Noise, a_Array, a_SizeX, a_SizeY, FracX, FracY, a_Output);
 
 	Cell.InitWorkRnds(FloorX[0], FloorY[0]);
 
@@ -766,7 +773,8 @@ void cCubicNoise::Generate3D(
 	int a_SizeX, int a_SizeY, int a_SizeZ,           ///< Size of the array (num doubles), in each direction
 	NOISE_DATATYPE a_StartX, NOISE_DATATYPE a_EndX,  ///< Noise-space coords of the array in the X direction
 	NOISE_DATATYPE a_StartY, NOISE_DATATYPE a_EndY,  ///< Noise-space coords of the array in the Y direction
-	NOISE_DATATYPE a_StartZ, NOISE_DATATYPE a_EndZ   ///< Noise-space coords of the array in the Y direction
+	NOISE_DATATYPE a_StartZ, NOISE_DATATYPE a_EndZ,  ///< Noise-space coords of the array in the Y direction
+	const sNoiseOutput & a_Output                    ///< How to write the values into the array
 ) const
 {
 	ASSERT(a_SizeX < MAX_SIZE);
@@ -794,7 +802,8 @@ void cCubicNoise::Generate3D(
 	cCubicCell3D Cell(
 		m_Noise, a_Array,
 		a_SizeX, a_SizeY, a_SizeZ,
-		FracX, FracY, FracZ
+		FracX, FracY, FracZ,
+		a_Output
 	);
 
 	Cell.InitWorkRnds(FloorX[0], FloorY[0], FloorZ[0]);
@@ -916,43 +925,36 @@ void cImprovedNoise::Generate2D(
 	NOISE_DATATYPE * a_Array,
 	int a_SizeX, int a_SizeY,
 	NOISE_DATATYPE a_StartX, NOISE_DATATYPE a_EndX,
-	NOISE_DATATYPE a_StartY, NOISE_DATATYPE a_EndY
+	NOISE_DATATYPE a_StartY, NOISE_DATATYPE a_EndY,
+	const sNoiseOutput & a_Output
 ) const
 {
-	size_t idx = 0;
-	for (int y = 0; y < a_SizeY; y++)
+	// The X coords are the same for all the rows, calculate them only once for each chunk of the rows:
+	int CoordX[X_CHUNK_SIZE];
+	NOISE_DATATYPE FracX[X_CHUNK_SIZE];
+	NOISE_DATATYPE FadeX[X_CHUNK_SIZE];
+	NoiseKernels::sImprovedRow Row;
+	Row.m_Perm = m_Perm;
+	Row.m_CoordX = CoordX;
+	Row.m_FracX = FracX;
+	Row.m_FadeX = FadeX;
+	Row.m_CoordZ = 0;
+	Row.m_FracZ = 0;
+	Row.m_FadeZ = 0;
+
+	for (int ChunkX = 0; ChunkX < a_SizeX; ChunkX += X_CHUNK_SIZE)
 	{
-		NOISE_DATATYPE ratioY = static_cast<NOISE_DATATYPE>(y) / (a_SizeY - 1);
-		NOISE_DATATYPE noiseY = Lerp(a_StartY, a_EndY, ratioY);
-		int noiseYInt = FAST_FLOOR(noiseY);
-		int yCoord = noiseYInt & 255;
-		NOISE_DATATYPE noiseYFrac = noiseY - noiseYInt;
-		NOISE_DATATYPE fadeY = Fade(noiseYFrac);
-		for (int x = 0; x < a_SizeX; x++)
+		const int ChunkSizeX = std::min(X_CHUNK_SIZE, a_SizeX - ChunkX);
+		for (int x = 0; x < ChunkSizeX; x++)
 		{
-			NOISE_DATATYPE ratioX = static_cast<NOISE_DATATYPE>(x) / (a_SizeX - 1);
-			NOISE_DATATYPE noiseX = Lerp(a_StartX, a_EndX, ratioX);
-			int noiseXInt = FAST_FLOOR(noiseX);
-			int xCoord = noiseXInt & 255;
-			NOISE_DATATYPE noiseXFrac = noiseX - noiseXInt;
-			NOISE_DATATYPE fadeX = Fade(noiseXFrac);
-
-			// Hash the coordinates:
-			int A  = m_Perm[xCoord] + yCoord;
-			int AA = m_Perm[A];
-			int AB = m_Perm[A + 1];
-			int B  = m_Perm[xCoord + 1] + yCoord;
-			int BA = m_Perm[B];
-			int BB = m_Perm[B + 1];
-
-			// Lerp the gradients:
-			a_Array[idx++] = Lerp(
-				Lerp(Grad(m_Perm[AA], noiseXFrac, noiseYFrac,     0), Grad(m_Perm[BA], noiseXFrac - 1, noiseYFrac,     0), fadeX),
-				Lerp(Grad(m_Perm[AB], noiseXFrac, noiseYFrac - 1, 0), Grad(m_Perm[BB], noiseXFrac - 1, noiseYFrac - 1, 0), fadeX),
-				fadeY
-			);
-		}  // for x
-	}  // for y
+			CalcCoord(ChunkX + x, a_SizeX, a_StartX, a_EndX, CoordX[x], FracX[x], FadeX[x]);
+		}
+		for (int y = 0; y < a_SizeY; y++)
+		{
+			CalcCoord(y, a_SizeY, a_StartY, a_EndY, Row.m_CoordY, Row.m_FracY, Row.m_FadeY);
+			NoiseKernels::ImprovedRow2D(a_Array + ChunkX + y * a_SizeX, ChunkSizeX, Row, a_Output);
+		}  // for y
+	}  // for ChunkX
 }
 
 
@@ -964,61 +966,57 @@ void cImprovedNoise::Generate3D(
 	int a_SizeX, int a_SizeY, int a_SizeZ,
 	NOISE_DATATYPE a_StartX, NOISE_DATATYPE a_EndX,
 	NOISE_DATATYPE a_StartY, NOISE_DATATYPE a_EndY,
-	NOISE_DATATYPE a_StartZ, NOISE_DATATYPE a_EndZ
+	NOISE_DATATYPE a_StartZ, NOISE_DATATYPE a_EndZ,
+	const sNoiseOutput & a_Output
 ) const
 {
-	size_t idx = 0;
-	for (int z = 0; z < a_SizeZ; z++)
+	// The X coords are the same for all the rows, calculate them only once for each chunk of the rows:
+	int CoordX[X_CHUNK_SIZE];
+	NOISE_DATATYPE FracX[X_CHUNK_SIZE];
+	NOISE_DATATYPE FadeX[X_CHUNK_SIZE];
+	NoiseKernels::sImprovedRow Row;
+	Row.m_Perm = m_Perm;
+	Row.m_CoordX = CoordX;
+	Row.m_FracX = FracX;
+	Row.m_FadeX = FadeX;
+
+	for (int ChunkX = 0; ChunkX < a_SizeX; ChunkX += X_CHUNK_SIZE)
 	{
-		NOISE_DATATYPE ratioZ = static_cast<NOISE_DATATYPE>(z) / (a_SizeZ - 1);
-		NOISE_DATATYPE noiseZ = Lerp(a_StartZ, a_EndZ, ratioZ);
-		int noiseZInt = FAST_FLOOR(noiseZ);
-		int zCoord = noiseZInt & 255;
-		NOISE_DATATYPE noiseZFrac = noiseZ - noiseZInt;
-		NOISE_DATATYPE fadeZ = Fade(noiseZFrac);
-		for (int y = 0; y < a_SizeY; y++)
+		const int ChunkSizeX = std::min(X_CHUNK_SIZE, a_SizeX - ChunkX);
+		for (int x = 0; x < ChunkSizeX; x++)
+		{
+			CalcCoord(ChunkX + x, a_SizeX, a_StartX, a_EndX, CoordX[x], FracX[x], FadeX[x]);
+		}
+		NOISE_DATATYPE * Out = a_Array + ChunkX;
+		for (int z = 0; z < a_SizeZ; z++)
 		{
-			NOISE_DATATYPE ratioY = static_cast<NOISE_DATATYPE>(y) / (a_SizeY - 1);
-			NOISE_DATATYPE noiseY = Lerp(a_StartY, a_EndY, ratioY);
-			int noiseYInt = FAST_FLOOR(noiseY);
-			int yCoord = noiseYInt & 255;
-			NOISE_DATATYPE noiseYFrac = noiseY - noiseYInt;
-			NOISE_DATATYPE fadeY = Fade(noiseYFrac);
-			for (int x = 0; x < a_SizeX; x++)
+			CalcCoord(z, a_SizeZ, a_StartZ, a_EndZ, Row.m_CoordZ, Row.m_FracZ, Row.m_FadeZ);
+			for (int y = 0; y < a_SizeY; y++)
 			{
-				NOISE_DATATYPE ratioX = static_cast<NOISE_DATATYPE>(x) / (a_SizeX - 1);
-				NOISE_DATATYPE noiseX = Lerp(a_StartX, a_EndX, ratioX);
-				int noiseXInt = FAST_FLOOR(noiseX);
-				int xCoord = noiseXInt & 255;
-				NOISE_DATATYPE noiseXFrac = noiseX - noiseXInt;
-				NOISE_DATATYPE fadeX = Fade(noiseXFrac);
-
-				// Hash the coordinates:
-				int A  = m_Perm[xCoord] + yCoord;
-				int AA = m_Perm[A] + zCoord;
-				int AB = m_Perm[A + 1] + zCoord;
-				int B  = m_Perm[xCoord + 1] + yCoord;
-				int BA = m_Perm[B] + zCoord;
-				int BB = m_Perm[B + 1] + zCoord;
-
-				// Lerp the gradients:
-				// TODO: This may be optimized by swapping the coords and recalculating most lerps only "once every x"
-				a_Array[idx++] = Lerp(
-					Lerp(
-						Lerp(Grad(m_Perm[AA], noiseXFrac, noiseYFrac,     noiseZFrac), Grad(m_Perm[BA], noiseXFrac - 1, noiseYFrac,     noiseZFrac), fadeX),
-						Lerp(Grad(m_Perm[AB], noiseXFrac, noiseYFrac - 1, noiseZFrac), Grad(m_Perm[BB], noiseXFrac - 1, noiseYFrac - 1, noiseZFrac), fadeX),
-						fadeY
-					),
-					Lerp(
-						Lerp(Grad(m_Perm[AA + 1], noiseXFrac, noiseYFrac,     noiseZFrac - 1), Grad(m_Perm[BA + 1], noiseXFrac - 1, noiseYFrac,     noiseZFrac - 1), fadeX),
-						Lerp(Grad(m_Perm[AB + 1], noiseXFrac, noiseYFrac - 1, noiseZFrac - 1), Grad(m_Perm[BB + 1], noiseXFrac - 1, noiseYFrac - 1, noiseZFrac - 1), fadeX),
-						fadeY
-					),
-					fadeZ
-				);
-			}  // for x
-		}  // for y
-	}  // for z
+				CalcCoord(y, a_SizeY, a_StartY, a_EndY, Row.m_CoordY, Row.m_FracY, Row.m_FadeY);
+				NoiseKernels::ImprovedRow3D(Out, ChunkSizeX, Row, a_Output);
+				Out += a_SizeX;
+			}  // for y
+		}  // for z
+	}  // for ChunkX
+}
+
+
+
+
+
+void cImprovedNoise::CalcCoord(
+	int a_Idx, int a_Size,
+	NOISE_DATATYPE a_Start, NOISE_DATATYPE a_End,
+	int & a_Coord, NOISE_DATATYPE & a_Frac, NOISE_DATATYPE & a_Fade
+)
+{
+	NOISE_DATATYPE ratio = static_cast<NOISE_DATATYPE>(a_Idx) / (a_Size - 1);
+	NOISE_DATATYPE noise = Lerp(a_Start, a_End, ratio);
+	int noiseInt = FAST_FLOOR(noise);
+	a_Coord = noiseInt & 255;
+	a_Frac = noise - noiseInt;
+	a_Fade = Fade(a_Frac);
 }
 
 
@@ -9,6 +9,7 @@
 typedef float NOISE_DATATYPE;
 
 #include "../Vector3.h"
+#include "NoiseKernels.h"
 #include "OctavedNoise.h"
 #include "RidgedNoise.h"
 
@@ -80,7 +81,8 @@ public:
 		NOISE_DATATYPE * a_Array,                        ///< Array to generate into [x + a_SizeX * y]
 		int a_SizeX, int a_SizeY,                        ///< Count of the array, in each direction
 		NOISE_DATATYPE a_StartX, NOISE_DATATYPE a_EndX,  ///< Noise-space coords of the array in the X direction
-		NOISE_DATATYPE a_StartY, NOISE_DATATYPE a_EndY   ///< Noise-space coords of the array in the Y direction
+		NOISE_DATATYPE a_StartY, NOISE_DATATYPE a_EndY,  ///< Noise-space coords of the array in the Y direction
+		const sNoiseOutput & a_Output = sNoiseOutput()   ///< How to write the values into the array
 	) const;
 
 
@@ -90,7 +92,8 @@ public:
 		int a_SizeX, int a_SizeY, int a_SizeZ,           ///< Count of the array, in each direction
 		NOISE_DATATYPE a_StartX, NOISE_DATATYPE a_EndX,  ///< Noise-space coords of the array in the X direction
 		NOISE_DATATYPE a_StartY, NOISE_DATATYPE a_EndY,  ///< Noise-space coords of the array in the Y direction
-		NOISE_DATATYPE a_StartZ, NOISE_DATATYPE a_EndZ   ///< Noise-space coords of the array in the Z direction
+		NOISE_DATATYPE a_StartZ, NOISE_DATATYPE a_EndZ,  ///< Noise-space coords of the array in the Z direction
+		const sNoiseOutput & a_Output = sNoiseOutput()   ///< How to write the values into the array
 	) const;
 
 protected:
@@ -131,7 +134,8 @@ public:
 		NOISE_DATATYPE * a_Array,                        ///< Array to generate into [x + a_SizeX * y]
 		int a_SizeX, int a_SizeY,                        ///< Count of the array, in each direction
 		NOISE_DATATYPE a_StartX, NOISE_DATATYPE a_EndX,  ///< Noise-space coords of the array in the X direction
-		NOISE_DATATYPE a_StartY, NOISE_DATATYPE a_EndY   ///< Noise-space coords of the array in the Y direction
+		NOISE_DATATYPE a_StartY, NOISE_DATATYPE a_EndY,  ///< Noise-space coords of the array in the Y direction
+		const sNoiseOutput & a_Output = sNoiseOutput()   ///< How to write the values into the array
 	) const;
 
 
@@ -141,7 +145,8 @@ public:
 		int a_SizeX, int a_SizeY, int a_SizeZ,           ///< Count of the array, in each direction
 		NOISE_DATATYPE a_StartX, NOISE_DATATYPE a_EndX,  ///< Noise-space coords of the array in the X direction
 		NOISE_DATATYPE a_StartY, NOISE_DATATYPE a_EndY,  ///< Noise-space coords of the array in the Y direction
-		NOISE_DATATYPE a_StartZ, NOISE_DATATYPE a_EndZ   ///< Noise-space coords of the array in the Z direction
+		NOISE_DATATYPE a_StartZ, NOISE_DATATYPE a_EndZ,  ///< Noise-space coords of the array in the Z direction
+		const sNoiseOutput & a_Output = sNoiseOutput()   ///< How to write the values into the array
 	) const;
 
 	/** Returns the value at the specified integral coords. Used for raw speed measurement. */
@@ -149,6 +154,10 @@ public:
 
 protected:
 
+	/** Number of the X values whose coords are precalculated at once, on the stack.
+	Queries larger in the X direction are generated in chunks of this many values. */
+	static constexpr int X_CHUNK_SIZE = 512;
+
 	/** The permutation table used by the noise function. Initialized using seed. */
 	int m_Perm[512];
 
@@ -167,6 +176,14 @@ protected:
 		NOISE_DATATYPE v = (hash < 4) ? a_Y : (((hash == 12) || (hash == 14)) ? a_X : a_Z);
 		return (((hash & 1) == 0) ? u : -u) + (((hash & 2) == 0) ? v : -v);
 	}
+
+	/** Calculates the noise-space coord of item a_Idx of an array of a_Size items spanning [a_Start, a_End].
+	a_Coord receives the integral part masked to the permutation table size, a_Frac the fractional part and a_Fade its fade curve value. */
+	static void CalcCoord(
+		int a_Idx, int a_Size,
+		NOISE_DATATYPE a_Start, NOISE_DATATYPE a_End,
+		int & a_Coord, NOISE_DATATYPE & a_Frac, NOISE_DATATYPE & a_Fade
+	);
 };
 
 
@@ -0,0 +1,975 @@
+
+// NoiseKernels.cpp
+
+// Implements the noise row kernels for each instruction set and the runtime selection between them
+
+// NOTE: The kernels must give bit-identical results with all the instruction sets. This file needs to be compiled
+// without floating-point contraction (-ffp-contract=off), so that the compiler doesn't fuse the multiplications
+// and additions into FMA instructions differently in the scalar and in the vector code.
+
+#include "Globals.h"
+
+#include "Noise.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+	#define NOISE_KERNELS_X86
+
+	#include <immintrin.h>
+
+	#if defined(_MSC_VER) && !defined(__clang__)
+		// MSVC allows all the intrinsics anywhere:
+		#include <intrin.h>
+		#define NOISE_TARGET_SSE41
+		#define NOISE_TARGET_AVX2
+	#else
+		// GCC and Clang need the functions using the intrinsics marked with the instruction set:
+		#define NOISE_TARGET_SSE41 __attribute__((target("sse4.1")))
+		#define NOISE_TARGET_AVX2 __attribute__((target("avx2")))
+	#endif
+#endif
+
+static_assert(std::is_same<NOISE_DATATYPE, float>::value, "The vector kernels expect NOISE_DATATYPE to be float");
+
+
+
+
+
+namespace
+{
+
+/** The coefficients of the cubic interpolation polynomial, ((P * t + Q) * t + R) * t + S. */
+struct sCubicCoeffs
+{
+	NOISE_DATATYPE m_P, m_Q, m_R, m_S;
+
+	/** Calculates the coefficients the same way as cNoise::CubicInterpolate(). */
+	sCubicCoeffs(NOISE_DATATYPE a_A, NOISE_DATATYPE a_B, NOISE_DATATYPE a_C, NOISE_DATATYPE a_D):
+		m_P((a_D - a_C) - (a_A - a_B)),
+		m_Q((a_A - a_B) - m_P),
+		m_R(a_C - a_A),
+		m_S(a_B)
+	{
+	}
+};
+
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Scalar kernels:
+
+/** Writes a single value into the output, as specified by the template params. */
+template <bool IsAccumulating, bool IsAbsolute>
+inline void StoreScalar(NOISE_DATATYPE * a_Out, NOISE_DATATYPE a_Value, NOISE_DATATYPE a_Amplitude)
+{
+	if (IsAbsolute)
+	{
+		a_Value = std::abs(a_Value);
+	}
+	a_Value = a_Value * a_Amplitude;
+	*a_Out = IsAccumulating ? (*a_Out + a_Value) : a_Value;
+}
+
+
+
+
+
+/** Returns the gradient value based on the hash, same as cImprovedNoise::Grad(). */
+inline NOISE_DATATYPE GradScalar(int a_Hash, NOISE_DATATYPE a_X, NOISE_DATATYPE a_Y, NOISE_DATATYPE a_Z)
+{
+	int hash = a_Hash % 16;
+	NOISE_DATATYPE u = (hash < 8) ? a_X : a_Y;
+	NOISE_DATATYPE v = (hash < 4) ? a_Y : (((hash == 12) || (hash == 14)) ? a_X : a_Z);
+	return (((hash & 1) == 0) ? u : -u) + (((hash & 2) == 0) ? v : -v);
+}
+
+
+
+
+
+template <bool IsAccumulating, bool IsAbsolute>
+void CubicRowScalar(NOISE_DATATYPE * a_Out, int a_Count, const NOISE_DATATYPE * a_Frac, const sCubicCoeffs & a_Coeffs, NOISE_DATATYPE a_Amplitude)
+{
+	for (int i = 0; i < a_Count; i++)
+	{
+		const NOISE_DATATYPE T = a_Frac[i];
+		StoreScalar<IsAccumulating, IsAbsolute>(a_Out + i, ((a_Coeffs.m_P * T + a_Coeffs.m_Q) * T + a_Coeffs.m_R) * T + a_Coeffs.m_S, a_Amplitude);
+	}
+}
+
+
+
+
+
+template <bool IsAccumulating, bool IsAbsolute>
+void LerpRowScalar(NOISE_DATATYPE * a_Out, int a_Count, const NOISE_DATATYPE * a_Ratio, NOISE_DATATYPE a_Val1, NOISE_DATATYPE a_Val2, NOISE_DATATYPE a_Amplitude)
+{
+	for (int i = 0; i < a_Count; i++)
+	{
+		StoreScalar<IsAccumulating, IsAbsolute>(a_Out + i, Lerp(a_Val1, a_Val2, a_Ratio[i]), a_Amplitude);
+	}
+}
+
+
+
+
+
+/** Generates the 2D improved noise for the items [a_From, a_To) of the row. */
+template <bool IsAccumulating, bool IsAbsolute>
+void ImprovedRow2DScalar(NOISE_DATATYPE * a_Out, int a_From, int a_To, const NoiseKernels::sImprovedRow & a_Row, NOISE_DATATYPE a_Amplitude)
+{
+	const int * Perm = a_Row.m_Perm;
+	const NOISE_DATATYPE FracY = a_Row.m_FracY;
+	for (int x = a_From; x < a_To; x++)
+	{
+		const int xCoord = a_Row.m_CoordX[x];
+		const NOISE_DATATYPE FracX = a_Row.m_FracX[x];
+		const NOISE_DATATYPE FadeX = a_Row.m_FadeX[x];
+
+		// Hash the coordinates:
+		int A  = Perm[xCoord] + a_Row.m_CoordY;
+		int AA = Perm[A];
+		int AB = Perm[A + 1];
+		int B  = Perm[xCoord + 1] + a_Row.m_CoordY;
+		int BA = Perm[B];
+		int BB = Perm[B + 1];
+
+		// Lerp the gradients:
+		StoreScalar<IsAccumulating, IsAbsolute>(a_Out + x, Lerp(
+			Lerp(GradScalar(Perm[AA], FracX, FracY,     0), GradScalar(Perm[BA], FracX - 1, FracY,     0), FadeX),
+			Lerp(GradScalar(Perm[AB], FracX, FracY - 1, 0), GradScalar(Perm[BB], FracX - 1, FracY - 1, 0), FadeX),
+			a_Row.m_FadeY
+		), a_Amplitude);
+	}
+}
+
+
+
+
+
+/** Generates the 3D improved noise for the items [a_From, a_To) of the row. */
+template <bool IsAccumulating, bool IsAbsolute>
+void ImprovedRow3DScalar(NOISE_DATATYPE * a_Out, int a_From, int a_To, const NoiseKernels::sImprovedRow & a_Row, NOISE_DATATYPE a_Amplitude)
+{
+	const int * Perm = a_Row.m_Perm;
+	const NOISE_DATATYPE FracY = a_Row.m_FracY;
+	const NOISE_DATATYPE FracZ = a_Row.m_FracZ;
+	for (int x = a_From; x < a_To; x++)
+	{
+		const int xCoord = a_Row.m_CoordX[x];
+		const NOISE_DATATYPE FracX = a_Row.m_FracX[x];
+		const NOISE_DATATYPE FadeX = a_Row.m_FadeX[x];
+
+		// Hash the coordinates:
+		int A  = Perm[xCoord] + a_Row.m_CoordY;
+		int AA = Perm[A] + a_Row.m_CoordZ;
+		int AB = Perm[A + 1] + a_Row.m_CoordZ;
+		int B  = Perm[xCoord + 1] + a_Row.m_CoordY;
+		int BA = Perm[B] + a_Row.m_CoordZ;
+		int BB = Perm[B + 1] + a_Row.m_CoordZ;
+
+		// Lerp the gradients:
+		StoreScalar<IsAccumulating, IsAbsolute>(a_Out + x, Lerp(
+			Lerp(
+				Lerp(GradScalar(Perm[AA], FracX, FracY,     FracZ), GradScalar(Perm[BA], FracX - 1, FracY,     FracZ), FadeX),
+				Lerp(GradScalar(Perm[AB], FracX, FracY - 1, FracZ), GradScalar(Perm[BB], FracX - 1, FracY - 1, FracZ), FadeX),
+				a_Row.m_FadeY
+			),
+			Lerp(
+				Lerp(GradScalar(Perm[AA + 1], FracX, FracY,     FracZ - 1), GradScalar(Perm[BA + 1], FracX - 1, FracY,     FracZ - 1), FadeX),
+				Lerp(GradScalar(Perm[AB + 1], FracX, FracY - 1, FracZ - 1), GradScalar(Perm[BB + 1], FracX - 1, FracY - 1, FracZ - 1), FadeX),
+				a_Row.m_FadeY
+			),
+			a_Row.m_FadeZ
+		), a_Amplitude);
+	}
+}
+
+
+
+
+
+template <bool IsAccumulating, bool IsAbsolute>
+void ImprovedRow2DScalar(NOISE_DATATYPE * a_Out, int a_Count, const NoiseKernels::sImprovedRow & a_Row, NOISE_DATATYPE a_Amplitude)
+{
+	ImprovedRow2DScalar<IsAccumulating, IsAbsolute>(a_Out, 0, a_Count, a_Row, a_Amplitude);
+}
+
+
+
+
+
+template <bool IsAccumulating, bool IsAbsolute>
+void ImprovedRow3DScalar(NOISE_DATATYPE * a_Out, int a_Count, const NoiseKernels::sImprovedRow & a_Row, NOISE_DATATYPE a_Amplitude)
+{
+	ImprovedRow3DScalar<IsAccumulating, IsAbsolute>(a_Out, 0, a_Count, a_Row, a_Amplitude);
+}
+
+
+
+
+
+#ifdef NOISE_KERNELS_X86
+
+////////////////////////////////////////////////////////////////////////////////
+// SSE4.1 kernels:
+
+template <bool IsAccumulating, bool IsAbsolute>
+NOISE_TARGET_SSE41 inline void StoreSSE41(NOISE_DATATYPE * a_Out, __m128 a_Value, __m128 a_Amplitude)
+{
+	if (IsAbsolute)
+	{
+		a_Value = _mm_andnot_ps(_mm_set1_ps(-0.0f), a_Value);
+	}
+	a_Value = _mm_mul_ps(a_Value, a_Amplitude);
+	if (IsAccumulating)
+	{
+		a_Value = _mm_add_ps(_mm_loadu_ps(a_Out), a_Value);
+	}
+	_mm_storeu_ps(a_Out, a_Value);
+}
+
+
+
+
+
+NOISE_TARGET_SSE41 inline __m128 LerpSSE41(__m128 a_Val1, __m128 a_Val2, __m128 a_Ratio)
+{
+	return _mm_add_ps(a_Val1, _mm_mul_ps(_mm_sub_ps(a_Val2, a_Val1), a_Ratio));
+}
+
+
+
+
+
+/** Returns a_Table[a_Index] for each of the four indices; SSE has no gather instruction. */
+NOISE_TARGET_SSE41 inline __m128i GatherSSE41(const int * a_Table, __m128i a_Index)
+{
+	return _mm_setr_epi32(
+		a_Table[_mm_cvtsi128_si32(a_Index)],
+		a_Table[_mm_extract_epi32(a_Index, 1)],
+		a_Table[_mm_extract_epi32(a_Index, 2)],
+		a_Table[_mm_extract_epi32(a_Index, 3)]
+	);
+}
+
+
+
+
+
+/** Vector version of GradScalar(). The hash is always non-negative, so the "% 16" is the same as "& 15". */
+NOISE_TARGET_SSE41 inline __m128 GradSSE41(__m128i a_Hash, __m128 a_X, __m128 a_Y, __m128 a_Z)
+{
+	const __m128i Hash = _mm_and_si128(a_Hash, _mm_set1_epi32(15));
+	const __m128 U = _mm_blendv_ps(a_Y, a_X, _mm_castsi128_ps(_mm_cmplt_epi32(Hash, _mm_set1_epi32(8))));
+	const __m128i Is12Or14 = _mm_or_si128(_mm_cmpeq_epi32(Hash, _mm_set1_epi32(12)), _mm_cmpeq_epi32(Hash, _mm_set1_epi32(14)));
+	const __m128 V = _mm_blendv_ps(
+		_mm_blendv_ps(a_Z, a_X, _mm_castsi128_ps(Is12Or14)),
+		a_Y,
+		_mm_castsi128_ps(_mm_cmplt_epi32(Hash, _mm_set1_epi32(4)))
+	);
+
+	// Negate by flipping the sign bits, moving the hash bits 0 and 1 into the sign bit position:
+	const __m128 SignU = _mm_castsi128_ps(_mm_slli_epi32(Hash, 31));
+	const __m128 SignV = _mm_castsi128_ps(_mm_slli_epi32(_mm_srli_epi32(Hash, 1), 31));
+	return _mm_add_ps(_mm_xor_ps(U, SignU), _mm_xor_ps(V, SignV));
+}
+
+
+
+
+
+template <bool IsAccumulating, bool IsAbsolute>
+NOISE_TARGET_SSE41 void CubicRowSSE41(NOISE_DATATYPE * a_Out, int a_Count, const NOISE_DATATYPE * a_Frac, const sCubicCoeffs & a_Coeffs, NOISE_DATATYPE a_Amplitude)
+{
+	const __m128 P = _mm_set1_ps(a_Coeffs.m_P);
+	const __m128 Q = _mm_set1_ps(a_Coeffs.m_Q);
+	const __m128 R = _mm_set1_ps(a_Coeffs.m_R);
+	const __m128 S = _mm_set1_ps(a_Coeffs.m_S);
+	const __m128 Amplitude = _mm_set1_ps(a_Amplitude);
+	int i = 0;
+	for (; i + 4 <= a_Count; i += 4)
+	{
+		const __m128 T = _mm_loadu_ps(a_Frac + i);
+		const __m128 Value = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(P, T), Q), T), R), T), S);
+		StoreSSE41<IsAccumulating, IsAbsolute>(a_Out + i, Value, Amplitude);
+	}
+	CubicRowScalar<IsAccumulating, IsAbsolute>(a_Out + i, a_Count - i, a_Frac + i, a_Coeffs, a_Amplitude);
+}
+
+
+
+
+
+template <bool IsAccumulating, bool IsAbsolute>
+NOISE_TARGET_SSE41 void LerpRowSSE41(NOISE_DATATYPE * a_Out, int a_Count, const NOISE_DATATYPE * a_Ratio, NOISE_DATATYPE a_Val1, NOISE_DATATYPE a_Val2, NOISE_DATATYPE a_Amplitude)
+{
+	const __m128 Val1 = _mm_set1_ps(a_Val1);
+	const __m128 Val2 = _mm_set1_ps(a_Val2);
+	const __m128 Amplitude = _mm_set1_ps(a_Amplitude);
+	int i = 0;
+	for (; i + 4 <= a_Count; i += 4)
+	{
+		StoreSSE41<IsAccumulating, IsAbsolute>(a_Out + i, LerpSSE41(Val1, Val2, _mm_loadu_ps(a_Ratio + i)), Amplitude);
+	}
+	LerpRowScalar<IsAccumulating, IsAbsolute>(a_Out + i, a_Count - i, a_Ratio + i, a_Val1, a_Val2, a_Amplitude);
+}
+
+
+
+
+
+template <bool IsAccumulating, bool IsAbsolute>
+NOISE_TARGET_SSE41 void ImprovedRow2DSSE41(NOISE_DATATYPE * a_Out, int a_Count, const NoiseKernels::sImprovedRow & a_Row, NOISE_DATATYPE a_Amplitude)
+{
+	const int * Perm = a_Row.m_Perm;
+	const __m128i One = _mm_set1_epi32(1);
+	const __m128i CoordY = _mm_set1_epi32(a_Row.m_CoordY);
+	const __m128 FracY = _mm_set1_ps(a_Row.m_FracY);
+	const __m128 FracY1 = _mm_set1_ps(a_Row.m_FracY - 1);
+	const __m128 FadeY = _mm_set1_ps(a_Row.m_FadeY);
+	const __m128 Zero = _mm_setzero_ps();
+	const __m128 Amplitude = _mm_set1_ps(a_Amplitude);
+	int x = 0;
+	for (; x + 4 <= a_Count; x += 4)
+	{
+		const __m128i CoordX = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a_Row.m_CoordX + x));
+		const __m128 FracX = _mm_loadu_ps(a_Row.m_FracX + x);
+		const __m128 FracX1 = _mm_sub_ps(FracX, _mm_set1_ps(1));
+		const __m128 FadeX = _mm_loadu_ps(a_Row.m_FadeX + x);
+
+		// Hash the coordinates:
+		const __m128i A  = _mm_add_epi32(GatherSSE41(Perm, CoordX), CoordY);
+		const __m128i AA = GatherSSE41(Perm, A);
+		const __m128i AB = GatherSSE41(Perm, _mm_add_epi32(A, One));
+		const __m128i B  = _mm_add_epi32(GatherSSE41(Perm, _mm_add_epi32(CoordX, One)), CoordY);
+		const __m128i BA = GatherSSE41(Perm, B);
+		const __m128i BB = GatherSSE41(Perm, _mm_add_epi32(B, One));
+
+		// Lerp the gradients:
+		StoreSSE41<IsAccumulating, IsAbsolute>(a_Out + x, LerpSSE41(
+			LerpSSE41(GradSSE41(GatherSSE41(Perm, AA), FracX, FracY,  Zero), GradSSE41(GatherSSE41(Perm, BA), FracX1, FracY,  Zero), FadeX),
+			LerpSSE41(GradSSE41(GatherSSE41(Perm, AB), FracX, FracY1, Zero), GradSSE41(GatherSSE41(Perm, BB), FracX1, FracY1, Zero), FadeX),
+			FadeY
+		), Amplitude);
+	}
+	ImprovedRow2DScalar<IsAccumulating, IsAbsolute>(a_Out, x, a_Count, a_Row, a_Amplitude);
+}
+
+
+
+
+
+template <bool IsAccumulating, bool IsAbsolute>
+NOISE_TARGET_SSE41 void ImprovedRow3DSSE41(NOISE_DATATYPE * a_Out, int a_Count, const NoiseKernels::sImprovedRow & a_Row, NOISE_DATATYPE a_Amplitude)
+{
+	const int * Perm = a_Row.m_Perm;
+	const __m128i One = _mm_set1_epi32(1);
+	const __m128i CoordY = _mm_set1_epi32(a_Row.m_CoordY);
+	const __m128i CoordZ = _mm_set1_epi32(a_Row.m_CoordZ);
+	const __m128 FracY = _mm_set1_ps(a_Row.m_FracY);
+	const __m128 FracY1 = _mm_set1_ps(a_Row.m_FracY - 1);
+	const __m128 FracZ = _mm_set1_ps(a_Row.m_FracZ);
+	const __m128 FracZ1 = _mm_set1_ps(a_Row.m_FracZ - 1);
+	const __m128 FadeY = _mm_set1_ps(a_Row.m_FadeY);
+	const __m128 FadeZ = _mm_set1_ps(a_Row.m_FadeZ);
+	const __m128 Amplitude = _mm_set1_ps(a_Amplitude);
+	int x = 0;
+	for (; x + 4 <= a_Count; x += 4)
+	{
+		const __m128i CoordX = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a_Row.m_CoordX + x));
+		const __m128 FracX = _mm_loadu_ps(a_Row.m_FracX + x);
+		const __m128 FracX1 = _mm_sub_ps(FracX, _mm_set1_ps(1));
+		const __m128 FadeX = _mm_loadu_ps(a_Row.m_FadeX + x);
+
+		// Hash the coordinates:
+		const __m128i A  = _mm_add_epi32(GatherSSE41(Perm, CoordX), CoordY);
+		const __m128i AA = _mm_add_epi32(GatherSSE41(Perm, A), CoordZ);
+		const __m128i AB = _mm_add_epi32(GatherSSE41(Perm, _mm_add_epi32(A, One)), CoordZ);
+		const __m128i B  = _mm_add_epi32(GatherSSE41(Perm, _mm_add_epi32(CoordX, One)), CoordY);
+		const __m128i BA = _mm_add_epi32(GatherSSE41(Perm, B), CoordZ);
+		const __m128i BB = _mm_add_epi32(GatherSSE41(Perm, _mm_add_epi32(B, One)), CoordZ);
+
+		// Lerp the gradients:
+		StoreSSE41<IsAccumulating, IsAbsolute>(a_Out + x, LerpSSE41(
+			LerpSSE41(
+				LerpSSE41(GradSSE41(GatherSSE41(Perm, AA), FracX, FracY,  FracZ), GradSSE41(GatherSSE41(Perm, BA), FracX1, FracY,  FracZ), FadeX),
+				LerpSSE41(GradSSE41(GatherSSE41(Perm, AB), FracX, FracY1, FracZ), GradSSE41(GatherSSE41(Perm, BB), FracX1, FracY1, FracZ), FadeX),
+				FadeY
+			),
+			LerpSSE41(
+				LerpSSE41(
+					GradSSE41(GatherSSE41(Perm, _mm_add_epi32(AA, One)), FracX,  FracY, FracZ1),
+					GradSSE41(GatherSSE41(Perm, _mm_add_epi32(BA, One)), FracX1, FracY, FracZ1),
+					FadeX
+				),
+				LerpSSE41(
+					GradSSE41(GatherSSE41(Perm, _mm_add_epi32(AB, One)), FracX,  FracY1, FracZ1),
+					GradSSE41(GatherSSE41(Perm, _mm_add_epi32(BB, One)), FracX1, FracY1, FracZ1),
+					FadeX
+				),
+				FadeY
+			),
+			FadeZ
+		), Amplitude);
+	}
+	ImprovedRow3DScalar<IsAccumulating, IsAbsolute>(a_Out, x, a_Count, a_Row, a_Amplitude);
+}
+
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// AVX2 kernels:
+
+// The AVX2 kernels handle the partial vector at the row end themselves, through masked loads and stores, and clear
+// the upper halves of the vector registers before returning. Calling into the non-VEX SSE4.1 code or returning
+// with dirty upper halves makes the following SSE code pay the AVX-SSE transition penalties.
+
+/** Returns the mask selecting the first a_Count lanes (a_Count in [0, 8]). */
+NOISE_TARGET_AVX2 inline __m256i TailMaskAVX2(int a_Count)
+{
+	return _mm256_cmpgt_epi32(_mm256_set1_epi32(a_Count), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+}
+
+
+
+
+
+template <bool IsAbsolute>
+NOISE_TARGET_AVX2 inline __m256 ScaleAVX2(__m256 a_Value, __m256 a_Amplitude)
+{
+	if (IsAbsolute)
+	{
+		a_Value = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a_Value);
+	}
+	return _mm256_mul_ps(a_Value, a_Amplitude);
+}
+
+
+
+
+
+template <bool IsAccumulating, bool IsAbsolute>
+NOISE_TARGET_AVX2 inline void StoreAVX2(NOISE_DATATYPE * a_Out, __m256 a_Value, __m256 a_Amplitude)
+{
+	a_Value = ScaleAVX2<IsAbsolute>(a_Value, a_Amplitude);
+	if (IsAccumulating)
+	{
+		a_Value = _mm256_add_ps(_mm256_loadu_ps(a_Out), a_Value);
+	}
+	_mm256_storeu_ps(a_Out, a_Value);
+}
+
+
+
+
+
+/** Same as StoreAVX2(), but touches only the lanes selected by a_Mask. */
+template <bool IsAccumulating, bool IsAbsolute>
+NOISE_TARGET_AVX2 inline void StoreMaskedAVX2(NOISE_DATATYPE * a_Out, __m256 a_Value, __m256 a_Amplitude, __m256i a_Mask)
+{
+	a_Value = ScaleAVX2<IsAbsolute>(a_Value, a_Amplitude);
+	if (IsAccumulating)
+	{
+		a_Value = _mm256_add_ps(_mm256_maskload_ps(a_Out, a_Mask), a_Value);
+	}
+	_mm256_maskstore_ps(a_Out, a_Mask, a_Value);
+}
+
+
+
+
+
+NOISE_TARGET_AVX2 inline __m256 LerpAVX2(__m256 a_Val1, __m256 a_Val2, __m256 a_Ratio)
+{
+	return _mm256_add_ps(a_Val1, _mm256_mul_ps(_mm256_sub_ps(a_Val2, a_Val1), a_Ratio));
+}
+
+
+
+
+
+NOISE_TARGET_AVX2 inline __m256i GatherAVX2(const int * a_Table, __m256i a_Index)
+{
+	return _mm256_i32gather_epi32(a_Table, a_Index, 4);
+}
+
+
+
+
+
+/** Vector version of GradScalar(). The hash is always non-negative, so the "% 16" is the same as "& 15". */
+NOISE_TARGET_AVX2 inline __m256 GradAVX2(__m256i a_Hash, __m256 a_X, __m256 a_Y, __m256 a_Z)
+{
+	const __m256i Hash = _mm256_and_si256(a_Hash, _mm256_set1_epi32(15));
+	const __m256 U = _mm256_blendv_ps(a_Y, a_X, _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(8), Hash)));
+	const __m256i Is12Or14 = _mm256_or_si256(_mm256_cmpeq_epi32(Hash, _mm256_set1_epi32(12)), _mm256_cmpeq_epi32(Hash, _mm256_set1_epi32(14)));
+	const __m256 V = _mm256_blendv_ps(
+		_mm256_blendv_ps(a_Z, a_X, _mm256_castsi256_ps(Is12Or14)),
+		a_Y,
+		_mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(4), Hash))
+	);
+
+	// Negate by flipping the sign bits, moving the hash bits 0 and 1 into the sign bit position:
+	const __m256 SignU = _mm256_castsi256_ps(_mm256_slli_epi32(Hash, 31));
+	const __m256 SignV = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_srli_epi32(Hash, 1), 31));
+	return _mm256_add_ps(_mm256_xor_ps(U, SignU), _mm256_xor_ps(V, SignV));
+}
+
+
+
+
+
+NOISE_TARGET_AVX2 inline __m256 CubicAVX2(const sCubicCoeffs & a_Coeffs, __m256 a_T)
+{
+	const __m256 P = _mm256_set1_ps(a_Coeffs.m_P);
+	const __m256 Q = _mm256_set1_ps(a_Coeffs.m_Q);
+	const __m256 R = _mm256_set1_ps(a_Coeffs.m_R);
+	const __m256 S = _mm256_set1_ps(a_Coeffs.m_S);
+	return _mm256_add_ps(_mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(P, a_T), Q), a_T), R), a_T), S);
+}
+
+
+
+
+
+template <bool IsAccumulating, bool IsAbsolute>
+NOISE_TARGET_AVX2 void CubicRowAVX2(NOISE_DATATYPE * a_Out, int a_Count, const NOISE_DATATYPE * a_Frac, const sCubicCoeffs & a_Coeffs, NOISE_DATATYPE a_Amplitude)
+{
+	const __m256 Amplitude = _mm256_set1_ps(a_Amplitude);
+	int i = 0;
+	for (; i + 8 <= a_Count; i += 8)
+	{
+		StoreAVX2<IsAccumulating, IsAbsolute>(a_Out + i, CubicAVX2(a_Coeffs, _mm256_loadu_ps(a_Frac + i)), Amplitude);
+	}
+	if (i < a_Count)
+	{
+		const __m256i Mask = TailMaskAVX2(a_Count - i);
+		StoreMaskedAVX2<IsAccumulating, IsAbsolute>(a_Out + i, CubicAVX2(a_Coeffs, _mm256_maskload_ps(a_Frac + i, Mask)), Amplitude, Mask);
+	}
+	_mm256_zeroupper();
+}
+
+
+
+
+
+template <bool IsAccumulating, bool IsAbsolute>
+NOISE_TARGET_AVX2 void LerpRowAVX2(NOISE_DATATYPE * a_Out, int a_Count, const NOISE_DATATYPE * a_Ratio, NOISE_DATATYPE a_Val1, NOISE_DATATYPE a_Val2, NOISE_DATATYPE a_Amplitude)
+{
+	const __m256 Val1 = _mm256_set1_ps(a_Val1);
+	const __m256 Val2 = _mm256_set1_ps(a_Val2);
+	const __m256 Amplitude = _mm256_set1_ps(a_Amplitude);
+	int i = 0;
+	for (; i + 8 <= a_Count; i += 8)
+	{
+		StoreAVX2<IsAccumulating, IsAbsolute>(a_Out + i, LerpAVX2(Val1, Val2, _mm256_loadu_ps(a_Ratio + i)), Amplitude);
+	}
+	if (i < a_Count)
+	{
+		const __m256i Mask = TailMaskAVX2(a_Count - i);
+		StoreMaskedAVX2<IsAccumulating, IsAbsolute>(a_Out + i, LerpAVX2(Val1, Val2, _mm256_maskload_ps(a_Ratio + i, Mask)), Amplitude, Mask);
+	}
+	_mm256_zeroupper();
+}
+
+
+
+
+
+/** The X-dependent inputs of the improved noise for 8 consecutive values of a row. */
+struct sImprovedLanesAVX2
+{
+	__m256i m_CoordX;
+	__m256 m_FracX;
+	__m256 m_FadeX;
+};
+
+
+
+
+
+/** Loads the 8 values of a_Row starting at a_X. */
+NOISE_TARGET_AVX2 inline sImprovedLanesAVX2 LoadImprovedLanesAVX2(const NoiseKernels::sImprovedRow & a_Row, int a_X)
+{
+	return
+	{
+		_mm256_loadu_si256(reinterpret_cast<const __m256i *>(a_Row.m_CoordX + a_X)),
+		_mm256_loadu_ps(a_Row.m_FracX + a_X),
+		_mm256_loadu_ps(a_Row.m_FadeX + a_X)
+	};
+}
+
+
+
+
+
+/** Loads the values of a_Row starting at a_X in the lanes selected by a_Mask, the rest are zero.
+Zero is a valid coord, so the table lookups of the unused lanes stay within the permutation table. */
+NOISE_TARGET_AVX2 inline sImprovedLanesAVX2 LoadImprovedLanesMaskedAVX2(const NoiseKernels::sImprovedRow & a_Row, int a_X, __m256i a_Mask)
+{
+	return
+	{
+		_mm256_maskload_epi32(a_Row.m_CoordX + a_X, a_Mask),
+		_mm256_maskload_ps(a_Row.m_FracX + a_X, a_Mask),
+		_mm256_maskload_ps(a_Row.m_FadeX + a_X, a_Mask)
+	};
+}
+
+
+
+
+
+NOISE_TARGET_AVX2 inline __m256 ImprovedValue2DAVX2(const sImprovedLanesAVX2 & a_Lanes, const NoiseKernels::sImprovedRow & a_Row)
+{
+	const int * Perm = a_Row.m_Perm;
+	const __m256i One = _mm256_set1_epi32(1);
+	const __m256i CoordY = _mm256_set1_epi32(a_Row.m_CoordY);
+	const __m256 FracY = _mm256_set1_ps(a_Row.m_FracY);
+	const __m256 FracY1 = _mm256_set1_ps(a_Row.m_FracY - 1);
+	const __m256 Zero = _mm256_setzero_ps();
+	const __m256i CoordX = a_Lanes.m_CoordX;
+	const __m256 FracX = a_Lanes.m_FracX;
+	const __m256 FracX1 = _mm256_sub_ps(FracX, _mm256_set1_ps(1));
+	const __m256 FadeX = a_Lanes.m_FadeX;
+
+	// Hash the coordinates:
+	const __m256i A  = _mm256_add_epi32(GatherAVX2(Perm, CoordX), CoordY);
+	const __m256i AA = GatherAVX2(Perm, A);
+	const __m256i AB = GatherAVX2(Perm, _mm256_add_epi32(A, One));
+	const __m256i B  = _mm256_add_epi32(GatherAVX2(Perm, _mm256_add_epi32(CoordX, One)), CoordY);
+	const __m256i BA = GatherAVX2(Perm, B);
+	const __m256i BB = GatherAVX2(Perm, _mm256_add_epi32(B, One));
+
+	// Lerp the gradients:
+	return LerpAVX2(
+		LerpAVX2(GradAVX2(GatherAVX2(Perm, AA), FracX, FracY,  Zero), GradAVX2(GatherAVX2(Perm, BA), FracX1, FracY,  Zero), FadeX),
+		LerpAVX2(GradAVX2(GatherAVX2(Perm, AB), FracX, FracY1, Zero), GradAVX2(GatherAVX2(Perm, BB), FracX1, FracY1, Zero), FadeX),
+		_mm256_set1_ps(a_Row.m_FadeY)
+	);
+}
+
+
+
+
+
+NOISE_TARGET_AVX2 inline __m256 ImprovedValue3DAVX2(const sImprovedLanesAVX2 & a_Lanes, const NoiseKernels::sImprovedRow & a_Row)
+{
+	const int * Perm = a_Row.m_Perm;
+	const __m256i One = _mm256_set1_epi32(1);
+	const __m256i CoordY = _mm256_set1_epi32(a_Row.m_CoordY);
+	const __m256i CoordZ = _mm256_set1_epi32(a_Row.m_CoordZ);
+	const __m256 FracY = _mm256_set1_ps(a_Row.m_FracY);
+	const __m256 FracY1 = _mm256_set1_ps(a_Row.m_FracY - 1);
+	const __m256 FracZ = _mm256_set1_ps(a_Row.m_FracZ);
+	const __m256 FracZ1 = _mm256_set1_ps(a_Row.m_FracZ - 1);
+	const __m256 FadeY = _mm256_set1_ps(a_Row.m_FadeY);
+	const __m256i CoordX = a_Lanes.m_CoordX;
+	const __m256 FracX = a_Lanes.m_FracX;
+	const __m256 FracX1 = _mm256_sub_ps(FracX, _mm256_set1_ps(1));
+	const __m256 FadeX = a_Lanes.m_FadeX;
+
+	// Hash the coordinates:
+	const __m256i A  = _mm256_add_epi32(GatherAVX2(Perm, CoordX), CoordY);
+	const __m256i AA = _mm256_add_epi32(GatherAVX2(Perm, A), CoordZ);
+	const __m256i AB = _mm256_add_epi32(GatherAVX2(Perm, _mm256_add_epi32(A, One)), CoordZ);
+	const __m256i B  = _mm256_add_epi32(GatherAVX2(Perm, _mm256_add_epi32(CoordX, One)), CoordY);
+	const __m256i BA = _mm256_add_epi32(GatherAVX2(Perm, B), CoordZ);
+	const __m256i BB = _mm256_add_epi32(GatherAVX2(Perm, _mm256_add_epi32(B, One)), CoordZ);
+
+	// Lerp the gradients:
+	return LerpAVX2(
+		LerpAVX2(
+			LerpAVX2(GradAVX2(GatherAVX2(Perm, AA), FracX, FracY,  FracZ), GradAVX2(GatherAVX2(Perm, BA), FracX1, FracY,  FracZ), FadeX),
+			LerpAVX2(GradAVX2(GatherAVX2(Perm, AB), FracX, FracY1, FracZ), GradAVX2(GatherAVX2(Perm, BB), FracX1, FracY1, FracZ), FadeX),
+			FadeY
+		),
+		LerpAVX2(
+			LerpAVX2(
+				GradAVX2(GatherAVX2(Perm, _mm256_add_epi32(AA, One)), FracX,  FracY, FracZ1),
+				GradAVX2(GatherAVX2(Perm, _mm256_add_epi32(BA, One)), FracX1, FracY, FracZ1),
+				FadeX
+			),
+			LerpAVX2(
+				GradAVX2(GatherAVX2(Perm, _mm256_add_epi32(AB, One)), FracX,  FracY1, FracZ1),
+				GradAVX2(GatherAVX2(Perm, _mm256_add_epi32(BB, One)), FracX1, FracY1, FracZ1),
+				FadeX
+			),
+			FadeY
+		),
+		_mm256_set1_ps(a_Row.m_FadeZ)
+	);
+}
+
+
+
+
+
+template <bool IsAccumulating, bool IsAbsolute>
+NOISE_TARGET_AVX2 void ImprovedRow2DAVX2(NOISE_DATATYPE * a_Out, int a_Count, const NoiseKernels::sImprovedRow & a_Row, NOISE_DATATYPE a_Amplitude)
+{
+	const __m256 Amplitude = _mm256_set1_ps(a_Amplitude);
+	int x = 0;
+	for (; x + 8 <= a_Count; x += 8)
+	{
+		StoreAVX2<IsAccumulating, IsAbsolute>(a_Out + x, ImprovedValue2DAVX2(LoadImprovedLanesAVX2(a_Row, x), a_Row), Amplitude);
+	}
+	if (x < a_Count)
+	{
+		const __m256i Mask = TailMaskAVX2(a_Count - x);
+		StoreMaskedAVX2<IsAccumulating, IsAbsolute>(a_Out + x, ImprovedValue2DAVX2(LoadImprovedLanesMaskedAVX2(a_Row, x, Mask), a_Row), Amplitude, Mask);
+	}
+	_mm256_zeroupper();
+}
+
+
+
+
+
+template <bool IsAccumulating, bool IsAbsolute>
+NOISE_TARGET_AVX2 void ImprovedRow3DAVX2(NOISE_DATATYPE * a_Out, int a_Count, const NoiseKernels::sImprovedRow & a_Row, NOISE_DATATYPE a_Amplitude)
+{
+	const __m256 Amplitude = _mm256_set1_ps(a_Amplitude);
+	int x = 0;
+	for (; x + 8 <= a_Count; x += 8)
+	{
+		StoreAVX2<IsAccumulating, IsAbsolute>(a_Out + x, ImprovedValue3DAVX2(LoadImprovedLanesAVX2(a_Row, x), a_Row), Amplitude);
+	}
+	if (x < a_Count)
+	{
+		const __m256i Mask = TailMaskAVX2(a_Count - x);
+		StoreMaskedAVX2<IsAccumulating, IsAbsolute>(a_Out + x, ImprovedValue3DAVX2(LoadImprovedLanesMaskedAVX2(a_Row, x, Mask), a_Row), Amplitude, Mask);
+	}
+	_mm256_zeroupper();
+}
+
+#endif  // NOISE_KERNELS_X86
+
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Kernel selection:
+
+/** The implementations of all the kernels for one instruction set.
+Each kernel is instantiated for all the combinations of the sNoiseOutput flags, indexed by GetVariant(). */
+struct sKernelSet
+{
+	NoiseKernels::eInstructionSet m_InstructionSet;
+	void (*m_CubicRow[4])(NOISE_DATATYPE *, int, const NOISE_DATATYPE *, const sCubicCoeffs &, NOISE_DATATYPE);
+	void (*m_LerpRow[4])(NOISE_DATATYPE *, int, const NOISE_DATATYPE *, NOISE_DATATYPE, NOISE_DATATYPE, NOISE_DATATYPE);
+	void (*m_ImprovedRow2D[4])(NOISE_DATATYPE *, int, const NoiseKernels::sImprovedRow &, NOISE_DATATYPE);
+	void (*m_ImprovedRow3D[4])(NOISE_DATATYPE *, int, const NoiseKernels::sImprovedRow &, NOISE_DATATYPE);
+};
+
+#define NOISE_KERNEL_VARIANTS(Kernel) { &Kernel<false, false>, &Kernel<false, true>, &Kernel<true, false>, &Kernel<true, true> }
+
+const sKernelSet g_ScalarKernels =
+{
+	NoiseKernels::eInstructionSet::Scalar,
+	NOISE_KERNEL_VARIANTS(CubicRowScalar),
+	NOISE_KERNEL_VARIANTS(LerpRowScalar),
+	NOISE_KERNEL_VARIANTS(ImprovedRow2DScalar),
+	NOISE_KERNEL_VARIANTS(ImprovedRow3DScalar),
+};
+
+#ifdef NOISE_KERNELS_X86
+	const sKernelSet g_SSE41Kernels =
+	{
+		NoiseKernels::eInstructionSet::SSE41,
+		NOISE_KERNEL_VARIANTS(CubicRowSSE41),
+		NOISE_KERNEL_VARIANTS(LerpRowSSE41),
+		NOISE_KERNEL_VARIANTS(ImprovedRow2DSSE41),
+		NOISE_KERNEL_VARIANTS(ImprovedRow3DSSE41),
+	};
+
+	const sKernelSet g_AVX2Kernels =
+	{
+		NoiseKernels::eInstructionSet::AVX2,
+		NOISE_KERNEL_VARIANTS(CubicRowAVX2),
+		NOISE_KERNEL_VARIANTS(LerpRowAVX2),
+		NOISE_KERNEL_VARIANTS(ImprovedRow2DAVX2),
+		NOISE_KERNEL_VARIANTS(ImprovedRow3DAVX2),
+	};
+#endif
+
+#undef NOISE_KERNEL_VARIANTS
+
+
+
+
+
+/** Returns the kernels for the specified instruction set, or nullptr if this build doesn't have them. */
+const sKernelSet * GetKernelSet(NoiseKernels::eInstructionSet a_InstructionSet)
+{
+	switch (a_InstructionSet)
+	{
+		case NoiseKernels::eInstructionSet::Scalar: return &g_ScalarKernels;
+		#ifdef NOISE_KERNELS_X86
+			case NoiseKernels::eInstructionSet::SSE41: return &g_SSE41Kernels;
+			case NoiseKernels::eInstructionSet::AVX2:  return &g_AVX2Kernels;
+		#else
+			case NoiseKernels::eInstructionSet::SSE41:
+			case NoiseKernels::eInstructionSet::AVX2:
+			{
+				return nullptr;
+			}
+		#endif
+	}
+	return nullptr;
+}
+
+
+
+
+
+/** Returns the kernels currently in use, initialized to the best ones for the CPU on first use. */
+std::atomic<const sKernelSet *> & CurrentKernels(void)
+{
+	static std::atomic<const sKernelSet *> Kernels(GetKernelSet(NoiseKernels::GetBestInstructionSet()));
+	return Kernels;
+}
+
+
+
+
+
+/** Returns the index of the kernel variant implementing the specified output. */
+inline int GetVariant(const sNoiseOutput & a_Output)
+{
+	return (a_Output.m_IsAccumulating ? 2 : 0) + (a_Output.m_IsAbsolute ? 1 : 0);
+}
+
+}  // namespace (anonymous)
+
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// NoiseKernels:
+
+NoiseKernels::eInstructionSet NoiseKernels::GetBestInstructionSet(void)
+{
+	#ifdef NOISE_KERNELS_X86
+		#if defined(_MSC_VER) && !defined(__clang__)
+			int Info[4];
+			__cpuid(Info, 0);
+			const int MaxLeaf = Info[0];
+			__cpuid(Info, 1);
+			const bool HasSSE41 = ((Info[2] & (1 << 19)) != 0);
+			const bool HasOSXSAVE = ((Info[2] & (1 << 27)) != 0);
+			const bool HasAVX = ((Info[2] & (1 << 28)) != 0);
+			bool HasAVX2 = false;
+			if (HasAVX && HasOSXSAVE && ((_xgetbv(0) & 6) == 6) && (MaxLeaf >= 7))  // The OS must save the YMM registers
+			{
+				__cpuidex(Info, 7, 0);
+				HasAVX2 = ((Info[1] & (1 << 5)) != 0);
+			}
+		#else
+			__builtin_cpu_init();
+			const bool HasSSE41 = __builtin_cpu_supports("sse4.1");
+			const bool HasAVX2 = __builtin_cpu_supports("avx2");
+		#endif
+		if (HasAVX2)
+		{
+			return eInstructionSet::AVX2;
+		}
+		if (HasSSE41)
+		{
+			return eInstructionSet::SSE41;
+		}
+	#endif
+	return eInstructionSet::Scalar;
+}
+
+
+
+
+
+NoiseKernels::eInstructionSet NoiseKernels::GetInstructionSet(void)
+{
+	return CurrentKernels().load(std::memory_order_relaxed)->m_InstructionSet;
+}
+
+
+
+
+
+bool NoiseKernels::SetInstructionSet(eInstructionSet a_InstructionSet)
+{
+	const auto Kernels = GetKernelSet(a_InstructionSet);
+	if ((Kernels == nullptr) || (a_InstructionSet > GetBestInstructionSet()))
+	{
+		return false;
+	}
+	CurrentKernels().store(Kernels);
+	return true;
+}
+
+
+
+
+
+const char * NoiseKernels::GetInstructionSetName(eInstructionSet a_InstructionSet)
+{
+	switch (a_InstructionSet)
+	{
+		case eInstructionSet::Scalar: return "scalar";
+		case eInstructionSet::SSE41:  return "SSE4.1";
+		case eInstructionSet::AVX2:   return "AVX2";
+	}
+	return "unknown";
+}
+
+
+
+
+
+void NoiseKernels::CubicRow(
+	NOISE_DATATYPE * a_Out, int a_Count, const NOISE_DATATYPE * a_Frac,
+	NOISE_DATATYPE a_V0, NOISE_DATATYPE a_V1, NOISE_DATATYPE a_V2, NOISE_DATATYPE a_V3,
+	const sNoiseOutput & a_Output
+)
+{
+	CurrentKernels().load(std::memory_order_relaxed)->m_CubicRow[GetVariant(a_Output)](
+		a_Out, a_Count, a_Frac, sCubicCoeffs(a_V0, a_V1, a_V2, a_V3), a_Output.m_Amplitude
+	);
+}
+
+
+
+
+
+void NoiseKernels::LerpRow(
+	NOISE_DATATYPE * a_Out, int a_Count, const NOISE_DATATYPE * a_Ratio,
+	NOISE_DATATYPE a_Val1, NOISE_DATATYPE a_Val2,
+	const sNoiseOutput & a_Output
+)
+{
+	CurrentKernels().load(std::memory_order_relaxed)->m_LerpRow[GetVariant(a_Output)](
+		a_Out, a_Count, a_Ratio, a_Val1, a_Val2, a_Output.m_Amplitude
+	);
+}
+
+
+
+
+
+void NoiseKernels::ImprovedRow2D(NOISE_DATATYPE * a_Out, int a_Count, const sImprovedRow & a_Row, const sNoiseOutput & a_Output)
+{
+	CurrentKernels().load(std::memory_order_relaxed)->m_ImprovedRow2D[GetVariant(a_Output)](a_Out, a_Count, a_Row, a_Output.m_Amplitude);
+}
+
+
+
+
+
+void NoiseKernels::ImprovedRow3D(NOISE_DATATYPE * a_Out, int a_Count, const sImprovedRow & a_Row, const sNoiseOutput & a_Output)
+{
+	CurrentKernels().load(std::memory_order_relaxed)->m_ImprovedRow3D[GetVariant(a_Output)](a_Out, a_Count, a_Row, a_Output.m_Amplitude);
+}
@@ -0,0 +1,124 @@
+
+// NoiseKernels.h
+
+// Declares the sNoiseOutput struct and the NoiseKernels namespace with the per-row kernels used by the noise generators
+
+
+
+
+
+#pragma once
+
+
+
+
+
+/** Specifies how a noise generator writes the generated values into the output array.
+Allows cOctavedNoise and cRidgedNoise to scale, accumulate and rectify each octave while it is being generated,
+instead of generating it into a workspace array and post-processing it from there.
+The operations are done in the same order as the post-processing used to, so the results are bit-identical. */
+struct sNoiseOutput
+{
+	/** Each generated value is multiplied by this before being written. */
+	NOISE_DATATYPE m_Amplitude;
+
+	/** If true, the values are added to the array contents, otherwise they overwrite them. */
+	bool m_IsAccumulating;
+
+	/** If true, the absolute value of each generated value is used (ridged noise). */
+	bool m_IsAbsolute;
+
+
+	sNoiseOutput(NOISE_DATATYPE a_Amplitude = 1, bool a_IsAccumulating = false, bool a_IsAbsolute = false):
+		m_Amplitude(a_Amplitude),
+		m_IsAccumulating(a_IsAccumulating),
+		m_IsAbsolute(a_IsAbsolute)
+	{
+	}
+
+
+	/** Returns the same output, but using the absolute values. */
+	sNoiseOutput Absolute(void) const
+	{
+		return sNoiseOutput(m_Amplitude, m_IsAccumulating, true);
+	}
+} ;
+
+
+
+
+
+/** The innermost loops of the noise generators, each producing one row of values along the X axis.
+Each kernel has a scalar implementation and, on x86, SSE4.1 and AVX2 implementations. The best one supported
+by the CPU is selected at runtime. All the implementations do the same floating-point operations in the same order,
+so they produce bit-identical results and a seed generates the same world on every machine. */
+namespace NoiseKernels
+{
+	/** The instruction sets that the kernels can be implemented with. */
+	enum class eInstructionSet
+	{
+		Scalar,
+		SSE41,
+		AVX2,
+	};
+
+
+	/** Returns the best instruction set supported both by this build and by the CPU. */
+	eInstructionSet GetBestInstructionSet(void);
+
+	/** Returns the instruction set currently used by the kernels. */
+	eInstructionSet GetInstructionSet(void);
+
+	/** Switches the kernels to the specified instruction set, used by the tests and benchmarks to compare the implementations.
+	Returns false and keeps the current implementation if the instruction set is not supported.
+	Must not be called while the noise is being generated in other threads. */
+	bool SetInstructionSet(eInstructionSet a_InstructionSet);
+
+	/** Returns the name of the instruction set, for logging. */
+	const char * GetInstructionSetName(eInstructionSet a_InstructionSet);
+
+
+	/** Writes the cubic interpolation between a_V0 .. a_V3 for each of the a_Count fractions in a_Frac into a_Out.
+	Gives the same values as cNoise::CubicInterpolate(). */
+	void CubicRow(
+		NOISE_DATATYPE * a_Out, int a_Count, const NOISE_DATATYPE * a_Frac,
+		NOISE_DATATYPE a_V0, NOISE_DATATYPE a_V1, NOISE_DATATYPE a_V2, NOISE_DATATYPE a_V3,
+		const sNoiseOutput & a_Output
+	);
+
+	/** Writes the linear interpolation between a_Val1 and a_Val2 for each of the a_Count ratios in a_Ratio into a_Out.
+	Gives the same values as Lerp(). */
+	void LerpRow(
+		NOISE_DATATYPE * a_Out, int a_Count, const NOISE_DATATYPE * a_Ratio,
+		NOISE_DATATYPE a_Val1, NOISE_DATATYPE a_Val2,
+		const sNoiseOutput & a_Output
+	);
+
+
+	/** The inputs for one row of cImprovedNoise.
+	The X values are arrays with one item per generated value, the Y and Z values are the same for the entire row. */
+	struct sImprovedRow
+	{
+		/** The permutation table of the noise, 512 items. */
+		const int * m_Perm;
+
+		/** The integral part of the noise-space X coord, masked to [0, 255]. */
+		const int * m_CoordX;
+
+		/** The fractional part of the noise-space X coord. */
+		const NOISE_DATATYPE * m_FracX;
+
+		/** The fade curve value of m_FracX. */
+		const NOISE_DATATYPE * m_FadeX;
+
+		int m_CoordY, m_CoordZ;
+		NOISE_DATATYPE m_FracY, m_FracZ;
+		NOISE_DATATYPE m_FadeY, m_FadeZ;
+	};
+
+	/** Writes a_Count values of the 2D improved noise into a_Out. The Z values of a_Row are ignored. */
+	void ImprovedRow2D(NOISE_DATATYPE * a_Out, int a_Count, const sImprovedRow & a_Row, const sNoiseOutput & a_Output);
+
+	/** Writes a_Count values of the 3D improved noise into a_Out. */
+	void ImprovedRow3D(NOISE_DATATYPE * a_Out, int a_Count, const sImprovedRow & a_Row, const sNoiseOutput & a_Output);
+}
@@ -41,13 +41,13 @@ public:
 	}
 
 
-	/** Fills a 2D array with the values of the noise. */
+	/** Fills a 2D array with the values of the noise.
+	Each octave is scaled and accumulated into a_Array directly while it is being generated. */
 	void Generate2D(
 		NOISE_DATATYPE * a_Array,                        ///< Array to generate into [x + a_SizeX * y]
 		int a_SizeX, int a_SizeY,                        ///< Count of the array, in each direction
 		NOISE_DATATYPE a_StartX, NOISE_DATATYPE a_EndX,  ///< Noise-space coords of the array in the X direction
-		NOISE_DATATYPE a_StartY, NOISE_DATATYPE a_EndY,  ///< Noise-space coords of the array in the Y direction
-		NOISE_DATATYPE * a_Workspace = nullptr           ///< Workspace that this function can use and trash.
+		NOISE_DATATYPE a_StartY, NOISE_DATATYPE a_EndY   ///< Noise-space coords of the array in the Y direction
 	) const
 	{
 		// Check that state is alright:
@@ -57,57 +57,29 @@ public:
 			return;
 		}
 
-		// Allocate the workspace on the heap, if it wasn't given:
-		std::unique_ptr<NOISE_DATATYPE[]> workspaceHeap;
-		if (a_Workspace == nullptr)
-		{
-			workspaceHeap.reset(new NOISE_DATATYPE[ToUnsigned(a_SizeX * a_SizeY)]);
-			a_Workspace = workspaceHeap.get();
-		}
-
-		// Generate the first octave directly into array:
-		int ArrayCount = a_SizeX * a_SizeY;
-		{
-			const cOctave & FirstOctave = m_Octaves.front();
-			FirstOctave.m_Noise.Generate2D(
-				a_Workspace, a_SizeX, a_SizeY,
-				a_StartX * FirstOctave.m_Frequency, a_EndX * FirstOctave.m_Frequency,
-				a_StartY * FirstOctave.m_Frequency, a_EndY * FirstOctave.m_Frequency
-			);
-			NOISE_DATATYPE Amplitude = FirstOctave.m_Amplitude;
-			for (int i = 0; i < ArrayCount; i++)
-			{
-				a_Array[i] = a_Workspace[i] * Amplitude;
-			}
-		}
-
-		// Add each octave:
-		for (auto itr = m_Octaves.cbegin() + 1, end = m_Octaves.cend(); itr != end; ++itr)
+		// The first octave overwrites the array, the others add to it:
+		bool IsAccumulating = false;
+		for (const auto & Octave: m_Octaves)
 		{
-			// Generate the noise for the octave:
-			itr->m_Noise.Generate2D(
-				a_Workspace, a_SizeX, a_SizeY,
-				a_StartX * itr->m_Frequency, a_EndX * itr->m_Frequency,
-				a_StartY * itr->m_Frequency, a_EndY * itr->m_Frequency
+			Octave.m_Noise.Generate2D(
+				a_Array, a_SizeX, a_SizeY,
+				a_StartX * Octave.m_Frequency, a_EndX * Octave.m_Frequency,
+				a_StartY * Octave.m_Frequency, a_EndY * Octave.m_Frequency,
+				sNoiseOutput(Octave.m_Amplitude, IsAccumulating)
 			);
-			// Add it into the output:
-			NOISE_DATATYPE Amplitude = itr->m_Amplitude;
-			for (int i = 0; i < ArrayCount; i++)
-			{
-				a_Array[i] += a_Workspace[i] * Amplitude;
-			}
-		}  // for itr - m_Octaves[]
+			IsAccumulating = true;
+		}  // for Octave - m_Octaves[]
 	}
 
 
-	/** Fills a 3D array with the values of the noise. */
+	/** Fills a 3D array with the values of the noise.
+	Each octave is scaled and accumulated into a_Array directly while it is being generated. */
 	void Generate3D(
 		NOISE_DATATYPE * a_Array,                        ///< Array to generate into [x + a_SizeX * y + a_SizeX * a_SizeY * z]
 		int a_SizeX, int a_SizeY, int a_SizeZ,           ///< Count of the array, in each direction
 		NOISE_DATATYPE a_StartX, NOISE_DATATYPE a_EndX,  ///< Noise-space coords of the array in the X direction
 		NOISE_DATATYPE a_StartY, NOISE_DATATYPE a_EndY,  ///< Noise-space coords of the array in the Y direction
-		NOISE_DATATYPE a_StartZ, NOISE_DATATYPE a_EndZ,  ///< Noise-space coords of the array in the Z direction
-		NOISE_DATATYPE * a_Workspace = nullptr           ///< Workspace that this function can use and trash, same size as a_Array
+		NOISE_DATATYPE a_StartZ, NOISE_DATATYPE a_EndZ   ///< Noise-space coords of the array in the Z direction
 	) const
 	{
 		// Check that state is alright:
@@ -117,48 +89,19 @@ public:
 			return;
 		}
 
-		// Allocate the workspace on the heap, if it wasn't given:
-		std::unique_ptr<NOISE_DATATYPE[]> workspaceHeap;
-		if (a_Workspace == nullptr)
-		{
-			workspaceHeap.reset(new NOISE_DATATYPE[ToUnsigned(a_SizeX * a_SizeY * a_SizeZ)]);
-			a_Workspace = workspaceHeap.get();
-		}
-
-		// Generate the first octave directly into array:
-		int ArrayCount = a_SizeX * a_SizeY * a_SizeZ;
-		{
-			const cOctave & FirstOctave = m_Octaves.front();
-			FirstOctave.m_Noise.Generate3D(
-				a_Workspace, a_SizeX, a_SizeY, a_SizeZ,
-				a_StartX * FirstOctave.m_Frequency, a_EndX * FirstOctave.m_Frequency,
-				a_StartY * FirstOctave.m_Frequency, a_EndY * FirstOctave.m_Frequency,
-				a_StartZ * FirstOctave.m_Frequency, a_EndZ * FirstOctave.m_Frequency
-			);
-			NOISE_DATATYPE Amplitude = FirstOctave.m_Amplitude;
-			for (int i = 0; i < ArrayCount; i++)
-			{
-				a_Array[i] = a_Workspace[i] * Amplitude;
-			}
-		}
-
-		// Add each octave:
-		for (auto itr = m_Octaves.cbegin() + 1, end = m_Octaves.cend(); itr != end; ++itr)
+		// The first octave overwrites the array, the others add to it:
+		bool IsAccumulating = false;
+		for (const auto & Octave: m_Octaves)
 		{
-			// Generate the noise for the octave:
-			itr->m_Noise.Generate3D(
-				a_Workspace, a_SizeX, a_SizeY, a_SizeZ,
-				a_StartX * itr->m_Frequency, a_EndX * itr->m_Frequency,
-				a_StartY * itr->m_Frequency, a_EndY * itr->m_Frequency,
-				a_StartZ * itr->m_Frequency, a_EndZ * itr->m_Frequency
+			Octave.m_Noise.Generate3D(
+				a_Array, a_SizeX, a_SizeY, a_SizeZ,
+				a_StartX * Octave.m_Frequency, a_EndX * Octave.m_Frequency,
+				a_StartY * Octave.m_Frequency, a_EndY * Octave.m_Frequency,
+				a_StartZ * Octave.m_Frequency, a_EndZ * Octave.m_Frequency,
+				sNoiseOutput(Octave.m_Amplitude, IsAccumulating)
 			);
-			// Add it into the output:
-			NOISE_DATATYPE Amplitude = itr->m_Amplitude;
-			for (int i = 0; i < ArrayCount; i++)
-			{
-				a_Array[i] += a_Workspace[i] * Amplitude;
-			}
-		}  // for itr - m_Octaves[]
+			IsAccumulating = true;
+		}  // for Octave - m_Octaves[]
 	}
 
 protected:
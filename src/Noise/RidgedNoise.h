@@ -43,19 +43,16 @@ public:
 		NOISE_DATATYPE * a_Array,                        ///< Array to generate into [x + a_SizeX * y]
 		int a_SizeX, int a_SizeY,                        ///< Count of the array, in each direction
 		NOISE_DATATYPE a_StartX, NOISE_DATATYPE a_EndX,  ///< Noise-space coords of the array in the X direction
-		NOISE_DATATYPE a_StartY, NOISE_DATATYPE a_EndY   ///< Noise-space coords of the array in the Y direction
+		NOISE_DATATYPE a_StartY, NOISE_DATATYPE a_EndY,  ///< Noise-space coords of the array in the Y direction
+		const sNoiseOutput & a_Output = sNoiseOutput()   ///< How to write the values into the array
 	) const
 	{
-		int ArrayCount = a_SizeX * a_SizeY;
 		m_Noise.Generate2D(
 			a_Array, a_SizeX, a_SizeY,
 			a_StartX, a_EndX,
-			a_StartY, a_EndY
+			a_StartY, a_EndY,
+			a_Output.Absolute()
 		);
-		for (int i = 0; i < ArrayCount; i++)
-		{
-			a_Array[i] = std::abs(a_Array[i]);
-		}
 	}
 
 
@@ -65,20 +62,17 @@ public:
 		int a_SizeX, int a_SizeY, int a_SizeZ,           ///< Count of the array, in each direction
 		NOISE_DATATYPE a_StartX, NOISE_DATATYPE a_EndX,  ///< Noise-space coords of the array in the X direction
 		NOISE_DATATYPE a_StartY, NOISE_DATATYPE a_EndY,  ///< Noise-space coords of the array in the Y direction
-		NOISE_DATATYPE a_StartZ, NOISE_DATATYPE a_EndZ   ///< Noise-space coords of the array in the Z direction
+		NOISE_DATATYPE a_StartZ, NOISE_DATATYPE a_EndZ,  ///< Noise-space coords of the array in the Z direction
+		const sNoiseOutput & a_Output = sNoiseOutput()   ///< How to write the values into the array
 	) const
 	{
-		int ArrayCount = a_SizeX * a_SizeY * a_SizeZ;
-		m_Noise.Generate2D(
+		m_Noise.Generate3D(
 			a_Array, a_SizeX, a_SizeY, a_SizeZ,
 			a_StartX, a_EndX,
 			a_StartY, a_EndY,
-			a_StartZ, a_EndZ
+			a_StartZ, a_EndZ,
+			a_Output.Absolute()
 		);
-		for (int i = 0; i < ArrayCount; i++)
-		{
-			a_Array[i] = std::abs(a_Array[i]);
-		}
 	}
 
 protected:
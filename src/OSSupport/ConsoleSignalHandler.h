@@ -44,6 +44,9 @@ static void NonCtrlHandler(int a_Signal)
 #endif
 			);
 
+			// Write out whatever the asynchronous logger still has queued:
+			cLogger::GetInstance().FlushFromSignalHandler();
+
 			std::signal(SIGSEGV, SIG_DFL);
 			return;
 		}
@@ -65,6 +68,9 @@ static void NonCtrlHandler(int a_Signal)
 #endif
 			);
 
+			// Write out whatever the asynchronous logger still has queued:
+			cLogger::GetInstance().FlushFromSignalHandler();
+
 			std::signal(SIGSEGV, SIG_DFL);
 			return;
 		}
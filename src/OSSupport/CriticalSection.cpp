@@ -10,7 +10,10 @@
 // cCriticalSection:
 
 cCriticalSection::cCriticalSection():
-	m_RecursionCount(0)
+	m_RecursionCount(0),
+	m_NumLocks(0),
+	m_NumContended(0),
+	m_WaitNanoseconds(0)
 {
 }
 
@@ -20,7 +23,16 @@ cCriticalSection::cCriticalSection():
 
 void cCriticalSection::Lock()
 {
-	m_Mutex.lock();
+	// Try the uncontended case first, only measure the wait if there is one:
+	if (!m_Mutex.try_lock())
+	{
+		const auto WaitStart = std::chrono::steady_clock::now();
+		m_Mutex.lock();
+		const auto Wait = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - WaitStart);
+		m_NumContended.store(m_NumContended.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		m_WaitNanoseconds.store(m_WaitNanoseconds.load(std::memory_order_relaxed) + Wait.count(), std::memory_order_relaxed);
+	}
+	m_NumLocks.store(m_NumLocks.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
 
 	m_RecursionCount += 1;
 	m_OwningThreadID = std::this_thread::get_id();
@@ -60,6 +72,20 @@ bool cCriticalSection::IsLockedByCurrentThread(void)
 
 
 
+cCriticalSection::sContention cCriticalSection::GetContention(void) const
+{
+	return
+	{
+		m_NumLocks.load(std::memory_order_relaxed),
+		m_NumContended.load(std::memory_order_relaxed),
+		std::chrono::nanoseconds(m_WaitNanoseconds.load(std::memory_order_relaxed))
+	};
+}
+
+
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 // cCSLock
 
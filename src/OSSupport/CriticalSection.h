@@ -27,6 +27,23 @@ public:
 	To be used in ASSERT(IsLockedByCurrentThread()) only. */
 	bool IsLockedByCurrentThread(void);
 
+	/** The lock-contention statistics of a CS. */
+	struct sContention
+	{
+		/** Number of times the CS has been locked, including recursive locks. */
+		UInt64 m_NumLocks;
+
+		/** Number of times a thread had to wait for the CS because another thread was holding it. */
+		UInt64 m_NumContended;
+
+		/** Total time that the threads have spent waiting for the CS. */
+		std::chrono::nanoseconds m_WaitTime;
+	};
+
+	/** Returns the lock-contention statistics gathered since the CS was created.
+	The values are read without the lock, so they may be a few locks behind. */
+	sContention GetContention(void) const;
+
 private:
 
 	/** Number of times that this CS is currently locked (levels of recursion). Zero if not locked.
@@ -42,6 +59,13 @@ private:
 	It is only ever read without the lock in the DeadlockDetect, where the server is terminating anyway. */
 	std::thread::id m_OwningThreadID;
 
+	/** The lock-contention statistics, see sContention.
+	Only ever written by the thread holding the CS, so a plain load and store suffice for the update;
+	atomic so that the DeadlockDetect can read them at any time. */
+	std::atomic<UInt64> m_NumLocks;
+	std::atomic<UInt64> m_NumContended;
+	std::atomic<Int64> m_WaitNanoseconds;
+
 	std::recursive_mutex m_Mutex;
 };
 
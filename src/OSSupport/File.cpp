@@ -701,6 +701,20 @@ void cFile::Flush()
 
 
 
+int cFile::GetDescriptor(void) const
+{
+	ASSERT(IsOpen());
+	#ifdef _WIN32
+		return _fileno(m_File);
+	#else
+		return fileno(m_File);
+	#endif
+}
+
+
+
+
+
 template <class StreamType>
 FileStream<StreamType>::FileStream(const std::string & Path)
 {
@@ -171,6 +171,9 @@ public:
 	/** Flushes all the bufferef output into the file (only when writing) */
 	void Flush();
 
+	/** Returns the OS file descriptor of the file, for writing past the stdio buffering; asserts if not open */
+	int GetDescriptor(void) const;
+
 private:
 	FILE * m_File;
 } ;  // tolua_export
@@ -0,0 +1,147 @@
+
+// PermissionTrie.cpp
+
+// Implements the cPermissionTrie class representing a set of dot-delimited permission templates, compiled for fast matching
+
+#include "Globals.h"
+#include "PermissionTrie.h"
+
+
+
+
+
+/** Calls a_Callback for each dot-delimited part of a_String.
+Splits the same way as StringSplit(a_String, "."), including dropping the empty part after a trailing dot.
+If the callback returns true, the iteration is aborted and the function returns true. */
+template <typename Callback>
+static bool ForEachPart(std::string_view a_String, Callback a_Callback)
+{
+	size_t Prev = 0;
+	size_t CutAt;
+	while ((CutAt = a_String.find('.', Prev)) != std::string_view::npos)
+	{
+		if (a_Callback(a_String.substr(Prev, CutAt - Prev)))
+		{
+			return true;
+		}
+		Prev = CutAt + 1;
+	}
+	if (Prev < a_String.size())
+	{
+		return a_Callback(a_String.substr(Prev));
+	}
+	return false;
+}
+
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// cPermissionTrie:
+
+cPermissionTrie::cPermissionTrie(void)
+{
+	Clear();
+}
+
+
+
+
+
+void cPermissionTrie::Assign(const AStringVector & a_Templates)
+{
+	Clear();
+	for (const auto & Template : a_Templates)
+	{
+		Add(Template);
+	}
+}
+
+
+
+
+
+void cPermissionTrie::Clear(void)
+{
+	m_Nodes.clear();
+	m_Nodes.emplace_back();
+	m_IsEmpty = true;
+}
+
+
+
+
+
+bool cPermissionTrie::Matches(std::string_view a_Permission) const
+{
+	if (m_IsEmpty)
+	{
+		return false;
+	}
+
+	// Walk the trie along the permission's parts. A wildcard at any node reached with a part remaining is a match:
+	size_t Node = 0;
+	bool HasFailed = false;
+	bool HasMatched = ForEachPart(a_Permission, [this, &Node, &HasFailed](std::string_view a_Part)
+		{
+			const auto & Current = m_Nodes[Node];
+			if (Current.m_HasWildcard)
+			{
+				return true;
+			}
+			auto itr = Current.m_Children.find(a_Part);
+			if (itr == Current.m_Children.end())
+			{
+				HasFailed = true;
+				return true;
+			}
+			Node = itr->second;
+			return false;
+		}
+	);
+	if (HasMatched)
+	{
+		return !HasFailed;
+	}
+
+	// All the parts have been consumed, the permission matches only a template of the exact same length:
+	return m_Nodes[Node].m_IsTerminal;
+}
+
+
+
+
+
+void cPermissionTrie::Add(const AString & a_Template)
+{
+	m_IsEmpty = false;
+	size_t Node = 0;
+	bool HasWildcard = ForEachPart(a_Template, [this, &Node](std::string_view a_Part)
+		{
+			if (a_Part == "*")
+			{
+				// Anything after the wildcard is irrelevant, the template matches as soon as the wildcard is reached
+				m_Nodes[Node].m_HasWildcard = true;
+				return true;
+			}
+			auto itr = m_Nodes[Node].m_Children.find(a_Part);
+			if (itr != m_Nodes[Node].m_Children.end())
+			{
+				Node = itr->second;
+				return false;
+			}
+
+			// Add a new node; m_Nodes may reallocate, so don't keep any references across the emplace_back():
+			size_t NewNode = m_Nodes.size();
+			m_Nodes.emplace_back();
+			m_Nodes[Node].m_Children.emplace(AString(a_Part), NewNode);
+			Node = NewNode;
+			return false;
+		}
+	);
+	if (!HasWildcard)
+	{
+		m_Nodes[Node].m_IsTerminal = true;
+	}
+}
@@ -0,0 +1,64 @@
+
+// PermissionTrie.h
+
+// Declares the cPermissionTrie class representing a set of dot-delimited permission templates, compiled for fast matching
+
+
+
+
+
+#pragma once
+
+
+
+
+
+/** A set of permission templates (such as "core.*" or "core.tp.other"), compiled into a trie of their dot-delimited parts.
+Matching a permission against the whole set walks the permission string in place, part by part, without any allocations.
+The result is the same as matching against each of the templates separately using cPlayer::PermissionMatches(). */
+class cPermissionTrie
+{
+public:
+
+	cPermissionTrie(void);
+
+	/** Replaces the contents with the specified templates. */
+	void Assign(const AStringVector & a_Templates);
+
+	/** Removes all templates. */
+	void Clear(void);
+
+	/** Returns true if any of the templates matches a_Permission. */
+	bool Matches(std::string_view a_Permission) const;
+
+	/** Returns true if there are no templates. */
+	bool IsEmpty(void) const { return m_IsEmpty; }
+
+protected:
+
+	/** A single node of the trie, representing one dot-delimited part of the templates. */
+	struct sNode
+	{
+		/** Indices of the child nodes in m_Nodes, by the next part of the template. */
+		std::map<AString, size_t, std::less<>> m_Children;
+
+		/** True if a template ends at this node. */
+		bool m_IsTerminal = false;
+
+		/** True if a template has a "*" right after this node, matching any (non-empty) remainder. */
+		bool m_HasWildcard = false;
+	} ;
+
+	/** All the nodes, m_Nodes[0] is the root. */
+	std::vector<sNode> m_Nodes;
+
+	/** True if no template has been added. */
+	bool m_IsEmpty;
+
+	/** Adds a single template into the trie. */
+	void Add(const AString & a_Template);
+} ;
+
+
+
+
@@ -314,7 +314,8 @@ namespace Explodinator
 		{
 			virtual bool OnNextBlock(Vector3i a_BlockPos, BlockState a_Block, eBlockFace a_EntryFace) override
 			{
-				return a_Block.Type() != BlockType::Air;
+				// Only the non-air blocks are reported, any of them obstructs the ray:
+				return true;
 			}
 		} Callback;
 
@@ -322,6 +323,7 @@ namespace Explodinator
 		unsigned Unobstructed = 0, Total = 0;
 		const auto Box = a_Entity.GetBoundingBox();
 		cLineBlockTracer Tracer(*a_Chunk.GetWorld(), Callback);
+		Tracer.SetLayerFilter(eBlockLayer::NonAir);
 
 		for (double X = Box.GetMinX(); X < Box.GetMaxX(); X += BoundingBoxStepUnit)
 		{
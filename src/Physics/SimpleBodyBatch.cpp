@@ -0,0 +1,387 @@
+
+// SimpleBodyBatch.cpp
+
+// Implements the cSimpleBodyBatch class that moves all the simple bodies of a chunk - pickups, experience orbs, primed TNT and falling blocks - at once
+
+#include "Globals.h"
+#include "SimpleBodyBatch.h"
+
+
+
+
+
+namespace
+{
+	/** Looks up the solidity of single blocks, keeping the bitmap of the last section used, since most lookups stay within a section. */
+	class cSolidityCache
+	{
+	public:
+
+		cSolidityCache(cSimpleBodyBatch::cSolidityProvider & a_Provider):
+			m_Provider(a_Provider)
+		{
+		}
+
+		/** Returns true if the block at the specified absolute coords is solid.
+		A block in an unavailable chunk is reported as solid, with a_IsAvailable set to false. */
+		bool IsSolid(const Vector3i a_BlockPos, bool & a_IsAvailable)
+		{
+			int ChunkX, ChunkZ;
+			cChunkDef::BlockToChunk(a_BlockPos.x, a_BlockPos.z, ChunkX, ChunkZ);
+			const auto SectionY = static_cast<size_t>(a_BlockPos.y / cChunkDef::SectionHeight);
+			if (!m_HasSection || (ChunkX != m_ChunkX) || (ChunkZ != m_ChunkZ) || (SectionY != m_SectionY))
+			{
+				m_ChunkX = ChunkX;
+				m_ChunkZ = ChunkZ;
+				m_SectionY = SectionY;
+				m_HasSection = true;
+				m_Bitmap = nullptr;
+				m_IsAvailable = m_Provider(ChunkX, ChunkZ, SectionY, m_Bitmap);
+			}
+
+			if (!m_IsAvailable)
+			{
+				a_IsAvailable = false;
+				return true;
+			}
+			if (m_Bitmap == nullptr)
+			{
+				return false;
+			}
+			const auto Index = cChunkDef::MakeIndex(
+				a_BlockPos.x - ChunkX * cChunkDef::Width,
+				a_BlockPos.y % cChunkDef::SectionHeight,
+				a_BlockPos.z - ChunkZ * cChunkDef::Width
+			);
+			return (((*m_Bitmap)[Index / 64] >> (Index % 64)) & 1) != 0;
+		}
+
+	private:
+
+		cSimpleBodyBatch::cSolidityProvider & m_Provider;
+
+		bool m_HasSection = false;
+		bool m_IsAvailable = false;
+		int m_ChunkX = 0;
+		int m_ChunkZ = 0;
+		size_t m_SectionY = 0;
+		const ChunkBlockData::SectionBitmap * m_Bitmap = nullptr;
+	};
+
+
+
+
+
+	/** Traces the line from a_Start to a_End through the blocks the same way cLineBlockTracer does, and returns true if it hits
+	a solid block, or an unavailable chunk (a_HitCoords is then a_Start and a_HitFace is BLOCK_FACE_NONE).
+	The block containing a_Start is not checked; a_Start must be within the world's height range. */
+	bool FirstSolidHit(
+		cSolidityCache & a_Solidity,
+		const Vector3d a_Start, const Vector3d a_End,
+		Vector3d & a_HitCoords, int & a_HitBlockY, eBlockFace & a_HitFace
+	)
+	{
+		static const double EPS = 0.00001;
+
+		const auto Diff = a_End - a_Start;
+		const Vector3i Dir(
+			(a_Start.x < a_End.x) ? 1 : -1,
+			(a_Start.y < a_End.y) ? 1 : -1,
+			(a_Start.z < a_End.z) ? 1 : -1
+		);
+		auto Current = a_Start.Floor();
+
+		for (;;)
+		{
+			// Find out which of the current block's walls gets hit by the line first:
+			enum
+			{
+				dirNONE,
+				dirX,
+				dirY,
+				dirZ,
+			} Direction = dirNONE;
+			double Coeff = 1;
+			if (std::abs(Diff.x) > EPS)
+			{
+				const double DestX = (Dir.x > 0) ? (Current.x + 1) : Current.x;
+				const double CoeffX = (DestX - a_Start.x) / Diff.x;
+				if (CoeffX <= 1)  // We need to include equality for the last block in the trace
+				{
+					Coeff = CoeffX;
+					Direction = dirX;
+				}
+			}
+			if (std::abs(Diff.y) > EPS)
+			{
+				const double DestY = (Dir.y > 0) ? (Current.y + 1) : Current.y;
+				const double CoeffY = (DestY - a_Start.y) / Diff.y;
+				if (CoeffY <= Coeff)
+				{
+					Coeff = CoeffY;
+					Direction = dirY;
+				}
+			}
+			if (std::abs(Diff.z) > EPS)
+			{
+				const double DestZ = (Dir.z > 0) ? (Current.z + 1) : Current.z;
+				const double CoeffZ = (DestZ - a_Start.z) / Diff.z;
+				if (CoeffZ <= Coeff)
+				{
+					Coeff = CoeffZ;
+					Direction = dirZ;
+				}
+			}
+
+			// Step into the neighbouring block through that wall:
+			eBlockFace Face;
+			switch (Direction)
+			{
+				case dirX: Current.x += Dir.x; Face = (Dir.x > 0) ? BLOCK_FACE_XM : BLOCK_FACE_XP; break;
+				case dirY: Current.y += Dir.y; Face = (Dir.y > 0) ? BLOCK_FACE_YM : BLOCK_FACE_YP; break;
+				case dirZ: Current.z += Dir.z; Face = (Dir.z > 0) ? BLOCK_FACE_ZM : BLOCK_FACE_ZP; break;
+				case dirNONE: return false;  // We've reached the end
+			}
+
+			if ((Current.y < 0) || (Current.y >= cChunkDef::Height))
+			{
+				// We've gone out of the world, there's nothing to hit
+				return false;
+			}
+
+			bool IsAvailable = true;
+			if (a_Solidity.IsSolid(Current, IsAvailable))
+			{
+				// Don't let the body move at all towards an unavailable chunk, it would end up outside the loaded world:
+				a_HitCoords = IsAvailable ? (a_Start + Diff * Coeff) : a_Start;
+				a_HitBlockY = Current.y;
+				a_HitFace = IsAvailable ? Face : BLOCK_FACE_NONE;
+				return true;
+			}
+		}
+	}
+}  // namespace (anonymous)
+
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// cSimpleBodyBatch:
+
+void cSimpleBodyBatch::Clear(void)
+{
+	m_PosX.clear();
+	m_PosY.clear();
+	m_PosZ.clear();
+	m_SpeedX.clear();
+	m_SpeedY.clear();
+	m_SpeedZ.clear();
+	m_WaterSpeedX.clear();
+	m_WaterSpeedY.clear();
+	m_WaterSpeedZ.clear();
+	m_WaterDirX.clear();
+	m_WaterDirZ.clear();
+	m_Gravity.clear();
+	m_AirDrag.clear();
+	m_HalfWidth.clear();
+	m_Height.clear();
+	m_Flags.clear();
+}
+
+
+
+
+
+size_t cSimpleBodyBatch::Add(const sBody & a_Body)
+{
+	m_PosX.push_back(a_Body.m_Position.x);
+	m_PosY.push_back(a_Body.m_Position.y);
+	m_PosZ.push_back(a_Body.m_Position.z);
+	m_SpeedX.push_back(a_Body.m_Speed.x);
+	m_SpeedY.push_back(a_Body.m_Speed.y);
+	m_SpeedZ.push_back(a_Body.m_Speed.z);
+	m_WaterSpeedX.push_back(a_Body.m_WaterSpeed.x);
+	m_WaterSpeedY.push_back(a_Body.m_WaterSpeed.y);
+	m_WaterSpeedZ.push_back(a_Body.m_WaterSpeed.z);
+	m_WaterDirX.push_back(a_Body.m_WaterDirection.x);
+	m_WaterDirZ.push_back(a_Body.m_WaterDirection.z);
+	m_Gravity.push_back(a_Body.m_Gravity);
+	m_AirDrag.push_back(a_Body.m_AirDrag);
+	m_HalfWidth.push_back(a_Body.m_Width / 2);
+	m_Height.push_back(a_Body.m_Height);
+	m_Flags.push_back(a_Body.m_Flags);
+	return m_Flags.size() - 1;
+}
+
+
+
+
+
+void cSimpleBodyBatch::Simulate(std::chrono::milliseconds a_Dt, cSolidityProvider a_Solidity)
+{
+	const auto DtSec = std::chrono::duration_cast<std::chrono::duration<double>>(a_Dt).count();
+	UpdateSpeeds(DtSec);
+	Move(DtSec, a_Solidity);
+}
+
+
+
+
+
+void cSimpleBodyBatch::UpdateSpeeds(const double a_Dt)
+{
+	// The same friction as cEntity::ApplyFriction() with the slowdown multiplier of 0.7:
+	const double FrictionMultiplier = 0.7 / (1 + static_cast<float>(a_Dt));
+	const auto ApplyFriction = [FrictionMultiplier](double & a_SpeedX, double a_SpeedY, double & a_SpeedZ)
+	{
+		if ((a_SpeedX * a_SpeedX + a_SpeedY * a_SpeedY + a_SpeedZ * a_SpeedZ) > 0.0004f)
+		{
+			a_SpeedX *= FrictionMultiplier;
+			if (std::abs(a_SpeedX) < 0.05)
+			{
+				a_SpeedX = 0;
+			}
+			a_SpeedZ *= FrictionMultiplier;
+			if (std::abs(a_SpeedZ) < 0.05)
+			{
+				a_SpeedZ = 0;
+			}
+		}
+	};
+
+	// The water current sets the speed it gives while strong enough, the speed fades out once it's gone:
+	const auto AdjustWaterSpeed = [](double & a_WaterSpeed, float a_WaterDir)
+	{
+		if (std::abs(a_WaterDir) > (0.05f / 0.4f))
+		{
+			a_WaterSpeed = 0.4 * a_WaterDir;
+		}
+		else if (std::abs(a_WaterSpeed) < 0.05)
+		{
+			a_WaterSpeed = 0.0;
+		}
+	};
+
+	const auto NumBodies = m_Flags.size();
+	for (size_t i = 0; i < NumBodies; i++)
+	{
+		const auto Flags = m_Flags[i];
+		double SpeedX = m_SpeedX[i];
+		double SpeedY = m_SpeedY[i];
+		double SpeedZ = m_SpeedZ[i];
+
+		if ((Flags & bfFreeFall) != 0)
+		{
+			m_SpeedY[i] = SpeedY + m_Gravity[i] * a_Dt;
+			continue;
+		}
+
+		if ((Flags & bfOnGround) != 0)
+		{
+			ApplyFriction(SpeedX, SpeedY, SpeedZ);
+		}
+		else
+		{
+			double FallSpeed;
+			if ((Flags & bfInWater) != 0)
+			{
+				FallSpeed = m_Gravity[i] * a_Dt / 3;  // Fall 3x slower in water
+				ApplyFriction(SpeedX, SpeedY, SpeedZ);
+			}
+			else if ((Flags & bfInCobweb) != 0)
+			{
+				SpeedY *= 0.05;  // Reduce overall falling speed
+				FallSpeed = 0;   // No falling
+			}
+			else
+			{
+				FallSpeed = m_Gravity[i] * a_Dt;
+				const double Drag = (m_AirDrag[i] * 20.0f) * a_Dt;
+				SpeedX -= SpeedX * Drag;
+				SpeedY -= SpeedY * Drag;
+				SpeedZ -= SpeedZ * Drag;
+			}
+			SpeedY += static_cast<float>(FallSpeed);
+		}
+
+		if ((Flags & bfInCobweb) != 0)
+		{
+			SpeedX *= 0.25;
+			SpeedZ *= 0.25;
+		}
+
+		double WaterSpeedX = m_WaterSpeedX[i] * 0.9;
+		double WaterSpeedZ = m_WaterSpeedZ[i] * 0.9;
+		m_WaterSpeedY[i] *= 0.9;
+		AdjustWaterSpeed(WaterSpeedX, m_WaterDirX[i]);
+		AdjustWaterSpeed(WaterSpeedZ, m_WaterDirZ[i]);
+		m_WaterSpeedX[i] = WaterSpeedX;
+		m_WaterSpeedZ[i] = WaterSpeedZ;
+
+		m_SpeedX[i] = SpeedX + WaterSpeedX;
+		m_SpeedY[i] = SpeedY + m_WaterSpeedY[i];
+		m_SpeedZ[i] = SpeedZ + WaterSpeedZ;
+	}
+}
+
+
+
+
+
+void cSimpleBodyBatch::Move(const double a_Dt, cSolidityProvider a_Solidity)
+{
+	cSolidityCache Solidity(a_Solidity);
+	const auto NumBodies = m_Flags.size();
+	for (size_t i = 0; i < NumBodies; i++)
+	{
+		const Vector3d Speed(m_SpeedX[i], m_SpeedY[i], m_SpeedZ[i]);
+		if ((m_Flags[i] & bfFreeFall) != 0)
+		{
+			m_PosX[i] += Speed.x * a_Dt;
+			m_PosY[i] += Speed.y * a_Dt;
+			m_PosZ[i] += Speed.z * a_Dt;
+			continue;
+		}
+		if (Speed.SqrLength() <= 0)
+		{
+			continue;
+		}
+
+		const Vector3d Start(m_PosX[i], m_PosY[i], m_PosZ[i]);
+		const auto End = Start + Speed * a_Dt;
+		Vector3d HitCoords;
+		int HitBlockY;
+		eBlockFace HitFace;
+		if (!FirstSolidHit(Solidity, Start, End, HitCoords, HitBlockY, HitFace))
+		{
+			// We didn't hit anything, so move:
+			m_PosX[i] = End.x;
+			m_PosY[i] = End.y;
+			m_PosZ[i] = End.z;
+			continue;
+		}
+
+		// Stop at the block that was hit, avoid movement in the direction of the face hit and correct for the collision box:
+		switch (HitFace)
+		{
+			case BLOCK_FACE_XM: m_SpeedX[i] = 0; HitCoords.x -= m_HalfWidth[i]; break;
+			case BLOCK_FACE_XP: m_SpeedX[i] = 0; HitCoords.x += m_HalfWidth[i]; break;
+			case BLOCK_FACE_YM: m_SpeedY[i] = 0; HitCoords.y -= m_Height[i]; break;
+			case BLOCK_FACE_ZM: m_SpeedZ[i] = 0; HitCoords.z -= m_HalfWidth[i]; break;
+			case BLOCK_FACE_ZP: m_SpeedZ[i] = 0; HitCoords.z += m_HalfWidth[i]; break;
+			case BLOCK_FACE_YP:
+			{
+				// We hit the ground, adjust the position to the top of the block:
+				m_SpeedY[i] = 0;
+				m_Flags[i] |= bfOnGround;
+				HitCoords.y = HitBlockY + 1;
+				break;
+			}
+			default: break;
+		}
+		m_PosX[i] = HitCoords.x;
+		m_PosY[i] = HitCoords.y;
+		m_PosZ[i] = HitCoords.z;
+	}
+}
@@ -0,0 +1,106 @@
+
+// SimpleBodyBatch.h
+
+// Declares the cSimpleBodyBatch class that moves all the simple bodies of a chunk - pickups, experience orbs, primed TNT and falling blocks - at once
+
+
+
+
+
+#pragma once
+
+#include "../ChunkData.h"
+#include "../FunctionRef.h"
+
+
+
+
+
+/** The physics of the entities that only fall, slide and stop at blocks, done for all such entities of a chunk at once.
+The chunk adds its bodies together with what they need to know of their surroundings at the start of its tick,
+Simulate() then updates the speeds of all bodies in plain loops over the arrays, and moves them, resolving the block
+collisions against the per-section solidity bitmaps; finally the chunk writes the results back into the entities.
+The speed update and the collisions match those of cEntity::HandlePhysics(). */
+class cSimpleBodyBatch
+{
+public:
+
+	/** Provides the solidity bitmap of the section at the specified chunk coords and section index.
+	May set a_Bitmap to nullptr for a section without any solid blocks.
+	Returns false if the chunk is not available, the bodies heading into it then don't move. */
+	using cSolidityProvider = cFunctionRef<bool(int a_ChunkX, int a_ChunkZ, size_t a_SectionY, const ChunkBlockData::SectionBitmap *& a_Bitmap)>;
+
+	/** The flags of a body, describing its surroundings going into the simulation and its contact with the ground coming out. */
+	enum eFlags : UInt8
+	{
+		/** The body rests on the ground, friction slows it down instead of gravity and drag.
+		When reading the results, the body has ended on the ground. */
+		bfOnGround = 0x01,
+
+		/** The body is in water; it falls slower, is slowed down by friction, and carried by the current. */
+		bfInWater = 0x02,
+
+		/** The body is in a cobweb; it hardly moves. */
+		bfInCobweb = 0x04,
+
+		/** Only gravity applies and the body doesn't collide with blocks: used for bodies outside the world's height range,
+		and for falling blocks, which check their landing themselves. */
+		bfFreeFall = 0x08,
+	};
+
+	/** A single body, as added to the batch. */
+	struct sBody
+	{
+		Vector3d m_Position;
+		Vector3d m_Speed;
+		Vector3d m_WaterSpeed;
+
+		/** The direction of the water flow at the body's position (cFluidSimulator::GetFlowingDirection()), zero outside water. */
+		Vector3f m_WaterDirection;
+
+		float m_Gravity;
+		float m_AirDrag;
+		float m_Width;
+		float m_Height;
+		UInt8 m_Flags;
+	};
+
+
+	/** Removes all bodies, keeping the allocated memory for the next use. */
+	void Clear(void);
+
+	/** Adds a body to the batch, returns its index for reading the results. */
+	size_t Add(const sBody & a_Body);
+
+	/** Returns the number of bodies in the batch. */
+	size_t GetNumBodies(void) const { return m_PosX.size(); }
+
+	/** Simulates a_Dt of movement of all the bodies in the batch. */
+	void Simulate(std::chrono::milliseconds a_Dt, cSolidityProvider a_Solidity);
+
+	/** Results of the simulation: */
+	Vector3d GetPosition(size_t a_Index) const { return {m_PosX[a_Index], m_PosY[a_Index], m_PosZ[a_Index]}; }
+	Vector3d GetSpeed(size_t a_Index) const { return {m_SpeedX[a_Index], m_SpeedY[a_Index], m_SpeedZ[a_Index]}; }
+	Vector3d GetWaterSpeed(size_t a_Index) const { return {m_WaterSpeedX[a_Index], m_WaterSpeedY[a_Index], m_WaterSpeedZ[a_Index]}; }
+	bool IsOnGround(size_t a_Index) const { return ((m_Flags[a_Index] & bfOnGround) != 0); }
+
+private:
+
+	// The bodies, each property in its own array:
+	std::vector<double> m_PosX, m_PosY, m_PosZ;
+	std::vector<double> m_SpeedX, m_SpeedY, m_SpeedZ;
+	std::vector<double> m_WaterSpeedX, m_WaterSpeedY, m_WaterSpeedZ;
+	std::vector<float> m_WaterDirX, m_WaterDirZ;
+	std::vector<float> m_Gravity;
+	std::vector<float> m_AirDrag;
+	std::vector<float> m_HalfWidth;
+	std::vector<float> m_Height;
+	std::vector<UInt8> m_Flags;
+
+
+	/** Applies gravity, drag, friction and the water current to the speeds of all bodies. */
+	void UpdateSpeeds(double a_Dt);
+
+	/** Moves all bodies by their speed, stopping those that hit a solid block at the block. */
+	void Move(double a_Dt, cSolidityProvider a_Solidity);
+};
@@ -5,6 +5,7 @@
 #include "../ClientHandle.h"
 #include "../WorldStorage/FastNBT.h"
 #include "BlockEntities/BlockEntity.h"
+#include "PalettedContainer.h"
 #include "Palettes/Upgrade.h"
 #include "Palettes/Palette_1_13.h"
 #include "Palettes/Palette_1_13_1.h"
@@ -145,6 +146,12 @@ namespace
 	{
 		return Palette_1_21_2::From(a_Block);
 	}
+
+	auto BiomePalette757(const UInt16 a_Biome)
+	{
+		// The 1.18+ clients only get minecraft:plains in their biome registry (see the dimension codecs sent on join):
+		return 0;
+	}
 }
 
 
@@ -156,6 +163,7 @@ namespace
 
 cChunkDataSerializer::cChunkDataSerializer(const eDimension a_Dimension) :
 	m_Packet(512 KiB),
+	m_AnalysedSections(0),
 	m_Dimension(a_Dimension)
 {
 }
@@ -309,6 +317,7 @@ void cChunkDataSerializer::SendToClients(const int a_ChunkX, const int a_ChunkZ,
 	{
 		Cache.Engaged = false;
 	}
+	m_AnalysedSections = 0;
 }
 
 
@@ -862,15 +871,6 @@ inline void cChunkDataSerializer::Serialize573(const int a_ChunkX, const int a_C
 
 inline void cChunkDataSerializer::Serialize735(const int a_ChunkX, const int a_ChunkZ, const ChunkBlockData & a_BlockData2, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap)
 {
-	// This function returns the fully compressed packet (including packet
-	// size), not the raw packet! Below variables tagged static because of
-	// https://developercommunity.visualstudio.com/content/problem/367326
-
-	static constexpr UInt8 BitsPerEntry = 15;
-	static constexpr UInt8 EntriesPerLong = 64 / BitsPerEntry;
-	// static int Longs = CeilC<int, float>(ChunkBlockData::SectionBlockCount / EntriesPerLong);
-	static size_t ChunkSectionDataArraySize = CeilC<size_t, float>(ChunkBlockData::SectionBlockCount / EntriesPerLong);  //  (ChunkBlockData::SectionBlockCount * BitsPerEntry) / 8 / 8;
-
 	const auto Bitmask = GetSectionBitmask2(a_BlockData2, a_LightData);
 
 	// Create the packet:
@@ -902,32 +902,7 @@ inline void cChunkDataSerializer::Serialize735(const int a_ChunkX, const int a_C
 		m_Packet.WriteBEInt32(a_BiomeMap[realx + realz * 16]);  //  Biome ???
 	}
 
-	const size_t ChunkSectionSize =
-		(2 +  // Block count, BEInt16, 2 bytes
-		1 +  // Bits per entry, BEUInt8, 1 byte
-		m_Packet.GetVarIntSize(static_cast<UInt32>(ChunkSectionDataArraySize)) +   // Field containing "size of whole section", VarInt32, variable size
-			ChunkSectionDataArraySize * 8   // Actual section data, lots of bytes (multiplier 1 long = 8 bytes)
-		);
-
-	const size_t ChunkSize = ChunkSectionSize * Bitmask.second;
-
-	// Write the chunk size in bytes:
-	m_Packet.WriteVarInt32(static_cast<UInt32>(ChunkSize));
-
-	// Write each chunk section...
-	for (size_t Y = 0; Y < cChunkDef::NumSections; ++Y)
-	{
-		const auto Blocks = a_BlockData2.GetSection(Y);
-		const auto BlockLights = a_LightData.GetBlockLightSection(Y);
-		const auto SkyLights = a_LightData.GetSkyLightSection(Y);
-		if ((Blocks != nullptr) ||  (BlockLights != nullptr) || (SkyLights != nullptr))
-		{
-			m_Packet.WriteBEInt16(4096);
-			m_Packet.WriteBEUInt8(BitsPerEntry);
-			m_Packet.WriteVarInt32(static_cast<UInt32>(ChunkSectionDataArraySize));
-			WriteBlockSectionSeamless2<&Palette754>(Blocks, BitsPerEntry, true);
-		}
-	}
+	WriteSections116<&Palette754>(a_BlockData2, a_LightData);
 
 	// Identify 1.9.4's tile entity list as empty
 	m_Packet.WriteVarInt32(0);
@@ -939,15 +914,6 @@ inline void cChunkDataSerializer::Serialize735(const int a_ChunkX, const int a_C
 
 inline void cChunkDataSerializer::Serialize751(const int a_ChunkX, const int a_ChunkZ, const ChunkBlockData & a_BlockData2, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap)
 {
-	// This function returns the fully compressed packet (including packet
-	// size), not the raw packet! Below variables tagged static because of
-	// https://developercommunity.visualstudio.com/content/problem/367326
-
-	static constexpr UInt8 BitsPerEntry = 15;
-	static constexpr UInt8 EntriesPerLong = 64 / BitsPerEntry;
-	// static int Longs = CeilC<int, float>(ChunkBlockData::SectionBlockCount / EntriesPerLong);
-	static size_t ChunkSectionDataArraySize = CeilC<size_t, float>(ChunkBlockData::SectionBlockCount / EntriesPerLong);  //  (ChunkBlockData::SectionBlockCount * BitsPerEntry) / 8 / 8;
-
 	const auto Bitmask = GetSectionBitmask2(a_BlockData2, a_LightData);
 
 	// Create the packet:
@@ -980,32 +946,7 @@ inline void cChunkDataSerializer::Serialize751(const int a_ChunkX, const int a_C
 		m_Packet.WriteVarInt32(a_BiomeMap[realx + realz * 16]);  //  Biome ???
 	}
 
-	const size_t ChunkSectionSize =
-		(2 +  // Block count, BEInt16, 2 bytes
-		1 +  // Bits per entry, BEUInt8, 1 byte
-		m_Packet.GetVarIntSize(static_cast<UInt32>(ChunkSectionDataArraySize)) +   // Field containing "size of whole section", VarInt32, variable size
-			ChunkSectionDataArraySize * 8   // Actual section data, lots of bytes (multiplier 1 long = 8 bytes)
-		);
-
-	const size_t ChunkSize = ChunkSectionSize * Bitmask.second;
-
-	// Write the chunk size in bytes:
-	m_Packet.WriteVarInt32(static_cast<UInt32>(ChunkSize));
-
-	// Write each chunk section...
-	for (size_t Y = 0; Y < cChunkDef::NumSections; ++Y)
-	{
-		const auto Blocks = a_BlockData2.GetSection(Y);
-		const auto BlockLights = a_LightData.GetBlockLightSection(Y);
-		const auto SkyLights = a_LightData.GetSkyLightSection(Y);
-		if ((Blocks != nullptr) ||  (BlockLights != nullptr) || (SkyLights != nullptr))
-		{
-			m_Packet.WriteBEInt16(4096);
-			m_Packet.WriteBEUInt8(BitsPerEntry);
-			m_Packet.WriteVarInt32(static_cast<UInt32>(ChunkSectionDataArraySize));
-			WriteBlockSectionSeamless2<&Palette754>(Blocks, BitsPerEntry, true);
-		}
-	}
+	WriteSections116<&Palette754>(a_BlockData2, a_LightData);
 
 	// Identify 1.9.4's tile entity list as empty
 	m_Packet.WriteVarInt32(0);
@@ -1017,15 +958,6 @@ inline void cChunkDataSerializer::Serialize751(const int a_ChunkX, const int a_C
 
 inline void cChunkDataSerializer::Serialize755(const int a_ChunkX, const int a_ChunkZ, const ChunkBlockData & a_BlockData2, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap)
 {
-		// This function returns the fully compressed packet (including packet
-	// size), not the raw packet! Below variables tagged static because of
-	// https://developercommunity.visualstudio.com/content/problem/367326
-
-	static constexpr UInt8 BitsPerEntry = 15;
-	static constexpr UInt8 EntriesPerLong = 64 / BitsPerEntry;
-	// static int Longs = CeilC<int, float>(ChunkBlockData::SectionBlockCount / EntriesPerLong);
-	static size_t ChunkSectionDataArraySize = CeilC<size_t, float>(ChunkBlockData::SectionBlockCount / EntriesPerLong);  //  (ChunkBlockData::SectionBlockCount * BitsPerEntry) / 8 / 8;
-
 	const auto Bitmask = GetSectionBitmask2(a_BlockData2, a_LightData);
 
 	// Create the packet:
@@ -1058,32 +990,7 @@ inline void cChunkDataSerializer::Serialize755(const int a_ChunkX, const int a_C
 		m_Packet.WriteVarInt32(a_BiomeMap[realx + realz * 16]);  //  Biome ???
 	}
 
-	const size_t ChunkSectionSize =
-		(2 +  // Block count, BEInt16, 2 bytes
-		1 +  // Bits per entry, BEUInt8, 1 byte
-		m_Packet.GetVarIntSize(static_cast<UInt32>(ChunkSectionDataArraySize)) +   // Field containing "size of whole section", VarInt32, variable size
-			ChunkSectionDataArraySize * 8   // Actual section data, lots of bytes (multiplier 1 long = 8 bytes)
-		);
-
-	const size_t ChunkSize = ChunkSectionSize * Bitmask.second;
-
-	// Write the chunk size in bytes:
-	m_Packet.WriteVarInt32(static_cast<UInt32>(ChunkSize));
-
-	// Write each chunk section...
-	for (size_t Y = 0; Y < cChunkDef::NumSections; ++Y)
-	{
-		const auto Blocks = a_BlockData2.GetSection(Y);
-		const auto BlockLights = a_LightData.GetBlockLightSection(Y);
-		const auto SkyLights = a_LightData.GetSkyLightSection(Y);
-		if ((Blocks != nullptr) ||  (BlockLights != nullptr) || (SkyLights != nullptr))
-		{
-			m_Packet.WriteBEInt16(4096);
-			m_Packet.WriteBEUInt8(BitsPerEntry);
-			m_Packet.WriteVarInt32(static_cast<UInt32>(ChunkSectionDataArraySize));
-			WriteBlockSectionSeamless2<&Palette754>(Blocks, BitsPerEntry, true);
-		}
-	}
+	WriteSections116<&Palette754>(a_BlockData2, a_LightData);
 
 	// Identify 1.9.4's tile entity list as empty
 	m_Packet.WriteVarInt32(0);
@@ -1096,15 +1003,6 @@ inline void cChunkDataSerializer::Serialize755(const int a_ChunkX, const int a_C
 template <auto Palette>
 inline void cChunkDataSerializer::Serialize757(const int a_ChunkX, const int a_ChunkZ, const ChunkBlockData & a_BlockData2, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, UInt32 a_packet_id)
 {
-	// This function returns the fully compressed packet (including packet
-	// size), not the raw packet! Below variables tagged static because of
-	// https://developercommunity.visualstudio.com/content/problem/367326
-
-	static constexpr UInt8 BitsPerEntry = 15;
-	static constexpr UInt8 EntriesPerLong = 64 / BitsPerEntry;
-	// static int Longs = CeilC<int, float>(ChunkBlockData::SectionBlockCount / EntriesPerLong);
-	static size_t ChunkSectionDataArraySize = CeilC<size_t, float>(ChunkBlockData::SectionBlockCount / EntriesPerLong);  //  (ChunkBlockData::SectionBlockCount * BitsPerEntry) / 8 / 8;
-
 	// const auto Bitmask = GetSectionBitmask2(a_BlockData2, a_LightData);
 
 	// Create the packet:
@@ -1123,31 +1021,7 @@ inline void cChunkDataSerializer::Serialize757(const int a_ChunkX, const int a_C
 	}
 
 
-	const size_t ChunkSectionSize =
-		(2 +  // Block count, BEInt16, 2 bytes
-		1 +  // Bits per entry, BEUInt8, 1 byte
-		m_Packet.GetVarIntSize(static_cast<UInt32>(ChunkSectionDataArraySize)) +   // Field containing "size of whole section", VarInt32, variable size
-			ChunkSectionDataArraySize * 8   // Actual section data, lots of bytes (multiplier 1 long = 8 bytes)
-		) + 3;	 // for biomes
-
-	const size_t ChunkSize = ChunkSectionSize * cChunkDef::NumSections;
-
-	// Write the chunk size in bytes:
-	m_Packet.WriteVarInt32(static_cast<UInt32>(ChunkSize));
-	// Write each chunk section...
-	for (size_t Y = 0; Y < cChunkDef::NumSections; ++Y)
-	{
-		const auto Blocks = a_BlockData2.GetSection(Y);
-		m_Packet.WriteBEInt16(4096);
-		m_Packet.WriteBEUInt8(BitsPerEntry);
-		m_Packet.WriteVarInt32(static_cast<UInt32>(ChunkSectionDataArraySize));
-		WriteBlockSectionSeamless2<Palette>(Blocks, BitsPerEntry, true);
-
-		// Biomes
-		m_Packet.WriteBEUInt8(0);
-		m_Packet.WriteVarInt32(0);
-		m_Packet.WriteVarInt32(0);
-	}
+	WriteSections118<Palette>(a_BlockData2, a_BiomeMap);
 
 
 	// Identify 1.9.4's tile entity list as empty
@@ -1172,15 +1046,6 @@ inline void cChunkDataSerializer::Serialize757(const int a_ChunkX, const int a_C
 template <auto Palette>
 inline void cChunkDataSerializer::Serialize763(const int a_ChunkX, const int a_ChunkZ, const ChunkBlockData & a_BlockData2, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, UInt32 a_packet_id)
 {
-	// This function returns the fully compressed packet (including packet
-	// size), not the raw packet! Below variables tagged static because of
-	// https://developercommunity.visualstudio.com/content/problem/367326
-
-	static constexpr UInt8 BitsPerEntry = 15;
-	static constexpr UInt8 EntriesPerLong = 64 / BitsPerEntry;
-	// static int Longs = CeilC<int, float>(ChunkBlockData::SectionBlockCount / EntriesPerLong);
-	static size_t ChunkSectionDataArraySize = CeilC<size_t, float>(ChunkBlockData::SectionBlockCount / EntriesPerLong);  //  (ChunkBlockData::SectionBlockCount * BitsPerEntry) / 8 / 8;
-
 	// const auto Bitmask = GetSectionBitmask2(a_BlockData2, a_LightData);
 
 	// Create the packet:
@@ -1199,31 +1064,7 @@ inline void cChunkDataSerializer::Serialize763(const int a_ChunkX, const int a_C
 	}
 
 
-	const size_t ChunkSectionSize =
-		(2 +  // Block count, BEInt16, 2 bytes
-		1 +  // Bits per entry, BEUInt8, 1 byte
-		m_Packet.GetVarIntSize(static_cast<UInt32>(ChunkSectionDataArraySize)) +   // Field containing "size of whole section", VarInt32, variable size
-			ChunkSectionDataArraySize * 8   // Actual section data, lots of bytes (multiplier 1 long = 8 bytes)
-		) + 3;	 // for biomes
-
-	const size_t ChunkSize = ChunkSectionSize * cChunkDef::NumSections;
-
-	// Write the chunk size in bytes:
-	m_Packet.WriteVarInt32(static_cast<UInt32>(ChunkSize));
-	// Write each chunk section...
-	for (size_t Y = 0; Y < cChunkDef::NumSections; ++Y)
-	{
-		const auto Blocks = a_BlockData2.GetSection(Y);
-		m_Packet.WriteBEInt16(4096);
-		m_Packet.WriteBEUInt8(BitsPerEntry);
-		m_Packet.WriteVarInt32(static_cast<UInt32>(ChunkSectionDataArraySize));
-		WriteBlockSectionSeamless2<Palette>(Blocks, BitsPerEntry, true);
-
-		// Biomes
-		m_Packet.WriteBEUInt8(0);
-		m_Packet.WriteVarInt32(0);
-		m_Packet.WriteVarInt32(0);
-	}
+	WriteSections118<Palette>(a_BlockData2, a_BiomeMap);
 
 	// Identify 1.9.4's tile entity list as empty
 	m_Packet.WriteVarInt32(0);
@@ -1245,14 +1086,6 @@ inline void cChunkDataSerializer::Serialize763(const int a_ChunkX, const int a_C
 template <auto Palette>
 inline void cChunkDataSerializer::Serialize764(const int a_ChunkX, const int a_ChunkZ, const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData, const unsigned char * a_BiomeMap, const std::vector<cBlockEntity *> & a_BlockEntities, const ClientHandles::value_type & a_Client, const cChunkDef::HeightMap & a_SurfaceHeightMap, UInt32 a_packet_id)
 {
-	// This function returns the fully compressed packet (including packet
-	// size), not the raw packet! Below variables tagged static because of
-	// https://developercommunity.visualstudio.com/content/problem/367326
-
-	static constexpr UInt8 BitsPerEntry = 15;
-	static constexpr UInt8 EntriesPerLong = 64 / BitsPerEntry;
-	static size_t ChunkSectionDataArraySize = CeilC<size_t, float>(ChunkBlockData::SectionBlockCount / static_cast<float>(EntriesPerLong));
-
 	// Create the packet:
 	m_Packet.WriteVarInt32(a_packet_id);
 	m_Packet.WriteBEInt32(a_ChunkX);
@@ -1276,31 +1109,7 @@ inline void cChunkDataSerializer::Serialize764(const int a_ChunkX, const int a_C
 	}
 
 
-	const size_t ChunkSectionSize =
-		(2 +  // Block count, BEInt16, 2 bytes
-		1 +  // Bits per entry, BEUInt8, 1 byte
-		m_Packet.GetVarIntSize(static_cast<UInt32>(ChunkSectionDataArraySize)) +   // Field containing "size of whole section", VarInt32, variable size
-			ChunkSectionDataArraySize * 8   // Actual section data, lots of bytes (multiplier 1 long = 8 bytes)
-		) + 3;	 // for biomes
-
-	const size_t ChunkSize = ChunkSectionSize * cChunkDef::NumSections;
-
-	// Write the chunk size in bytes:
-	m_Packet.WriteVarInt32(static_cast<UInt32>(ChunkSize));
-	// Write each chunk section...
-	for (size_t Y = 0; Y < cChunkDef::NumSections; ++Y)
-	{
-		const auto Blocks = a_BlockData.GetSection(Y);
-		m_Packet.WriteBEInt16(4096);
-		m_Packet.WriteBEUInt8(BitsPerEntry);
-		m_Packet.WriteVarInt32(static_cast<UInt32>(ChunkSectionDataArraySize));
-		WriteBlockSectionSeamless2<Palette>(Blocks, BitsPerEntry, true);
-
-		// Biomes
-		m_Packet.WriteBEUInt8(0);
-		m_Packet.WriteVarInt32(0);
-		m_Packet.WriteVarInt32(0);
-	}
+	WriteSections118<Palette>(a_BlockData, a_BiomeMap);
 
 	// Tile entity list
 	m_Packet.WriteVarInt32(static_cast<UInt32>(a_BlockEntities.size()));
@@ -1371,6 +1180,138 @@ inline void cChunkDataSerializer::Serialize764(const int a_ChunkX, const int a_C
 
 
 
+template <auto Palette>
+inline void cChunkDataSerializer::WriteSections116(const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData)
+{
+	const auto IsSectionPresent = [&a_BlockData, &a_LightData](size_t a_Y)
+	{
+		return (
+			(a_BlockData.GetSection(a_Y) != nullptr) ||
+			(a_LightData.GetBlockLightSection(a_Y) != nullptr) ||
+			(a_LightData.GetSkyLightSection(a_Y) != nullptr)
+		);
+	};
+
+	// The sections vary in size, add them up first:
+	size_t ChunkSize = 0;
+	for (size_t Y = 0; Y < cChunkDef::NumSections; ++Y)
+	{
+		if (IsSectionPresent(Y))
+		{
+			PrepareBlockContainer<Palette>(a_BlockData, Y, cPalettedContainer::BLOCK_RULES_1_16);
+			ChunkSize += 2 + m_BlockContainer.GetSize();  // Block count, BEInt16, followed by the container
+		}
+	}
+
+	// Write the chunk size in bytes:
+	m_Packet.WriteVarInt32(static_cast<UInt32>(ChunkSize));
+
+	// Write each chunk section...
+	for (size_t Y = 0; Y < cChunkDef::NumSections; ++Y)
+	{
+		if (IsSectionPresent(Y))
+		{
+			PrepareBlockContainer<Palette>(a_BlockData, Y, cPalettedContainer::BLOCK_RULES_1_16);
+			m_Packet.WriteBEInt16(4096);
+			m_BlockContainer.Write(m_Packet, a_BlockData.GetSection(Y));
+		}
+	}
+}
+
+
+
+
+
+template <auto Palette>
+inline void cChunkDataSerializer::WriteSections118(const ChunkBlockData & a_BlockData, const unsigned char * a_BiomeMap)
+{
+	// Biomes are stored per column, so all the sections share a single biome container:
+	for (size_t Index = 0; Index < m_SectionBiomes.size(); Index++)
+	{
+		const size_t X = (Index % 4) * 4;
+		const size_t Z = ((Index / 4) % 4) * 4;
+		m_SectionBiomes[Index] = a_BiomeMap[X + Z * cChunkDef::Width];
+	}
+	m_BiomeContainer.Analyse(m_SectionBiomes.data(), m_SectionBiomes.size());
+	m_BiomeContainer.Map(&BiomePalette757, cPalettedContainer::BIOME_RULES_1_18);
+	const size_t BiomesSize = m_BiomeContainer.GetSize();
+
+	// The sections vary in size, add them up first:
+	size_t ChunkSize = 0;
+	for (size_t Y = 0; Y < cChunkDef::NumSections; ++Y)
+	{
+		PrepareBlockContainer<Palette>(a_BlockData, Y, cPalettedContainer::BLOCK_RULES_1_18);
+		ChunkSize += 2 + m_BlockContainer.GetSize() + BiomesSize;  // Block count, BEInt16, followed by the containers
+	}
+
+	// Write the chunk size in bytes:
+	m_Packet.WriteVarInt32(static_cast<UInt32>(ChunkSize));
+
+	// Write each chunk section...
+	for (size_t Y = 0; Y < cChunkDef::NumSections; ++Y)
+	{
+		PrepareBlockContainer<Palette>(a_BlockData, Y, cPalettedContainer::BLOCK_RULES_1_18);
+		m_Packet.WriteBEInt16(4096);
+		m_BlockContainer.Write(m_Packet, a_BlockData.GetSection(Y));
+		m_BiomeContainer.Write(m_Packet, m_SectionBiomes.data());
+	}
+}
+
+
+
+
+
+template <auto Palette>
+inline void cChunkDataSerializer::PrepareBlockContainer(const ChunkBlockData & a_BlockData, const size_t a_Y, const cPalettedContainer::sRules & a_Rules)
+{
+	m_BlockContainer.Assign(GetSectionKeys(a_BlockData, a_Y), ChunkBlockData::SectionBlockCount);
+	m_BlockContainer.Map([](const UInt16 a_Key) { return Palette(BlockState(a_Key)); }, a_Rules);
+}
+
+
+
+
+
+const cPalettedContainer::cKeys & cChunkDataSerializer::GetSectionKeys(const ChunkBlockData & a_BlockData, const size_t a_Y)
+{
+	auto & Keys = m_SectionKeys[a_Y];
+	const UInt16 SectionBit = static_cast<UInt16>(1 << a_Y);
+	if ((m_AnalysedSections & SectionBit) != 0)
+	{
+		return Keys;
+	}
+	m_AnalysedSections |= SectionBit;
+
+	const auto Blocks = a_BlockData.GetSection(a_Y);
+	const auto Revision = a_BlockData.GetSectionRevision(a_Y);
+	if ((Blocks != nullptr) && (Revision != 0))
+	{
+		const auto Cached = m_KeysCache.find(Revision);
+		if (Cached != m_KeysCache.end())
+		{
+			Keys = Cached->second;
+			return Keys;
+		}
+	}
+
+	m_BlockContainer.Analyse(Blocks);
+	Keys = m_BlockContainer.GetKeys();
+
+	if ((Blocks != nullptr) && (Revision != 0))
+	{
+		if (m_KeysCache.size() >= MAX_CACHED_SECTIONS)
+		{
+			m_KeysCache.clear();
+		}
+		m_KeysCache.emplace(Revision, Keys);
+	}
+	return Keys;
+}
+
+
+
+
+
 template <auto Palette>
 inline void cChunkDataSerializer::WriteBlockSectionSeamless2(const ChunkBlockData::BlockArray * a_Blocks, const UInt8 a_BitsPerEntry, bool padding)
 {
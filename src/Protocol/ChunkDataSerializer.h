@@ -4,6 +4,7 @@
 #include "../ChunkData.h"
 #include "../Defines.h"
 #include "CircularBufferCompressor.h"
+#include "PalettedContainer.h"
 #include "StringCompression.h"
 
 
@@ -93,6 +94,23 @@ private:
 
 	template <auto Palettee>
 	inline void WriteBlockSectionSeamless2(const ChunkBlockData::BlockArray * a_Blocks, const UInt8 a_BitsPerEntry, bool padding);
+	/** Writes the sections of the 1.16 - 1.17 formats, prefixed by their total size.
+	Only the sections that have blocks or light are written, matching the bitmask sent in the packet. */
+	template <auto Palette>
+	inline void WriteSections116(const ChunkBlockData & a_BlockData, const ChunkLightData & a_LightData);
+
+	/** Writes the sections of the 1.18+ formats, each with its block states and biomes, prefixed by their total size. */
+	template <auto Palette>
+	inline void WriteSections118(const ChunkBlockData & a_BlockData, const unsigned char * a_BiomeMap);
+
+	/** Prepares m_BlockContainer for writing the block states of the specified section using the protocol's Palette. */
+	template <auto Palette>
+	inline void PrepareBlockContainer(const ChunkBlockData & a_BlockData, size_t a_Y, const cPalettedContainer::sRules & a_Rules);
+
+	/** Returns the distinct block states of the specified section.
+	The section is analysed at most once per SendToClients() call, and not at all if its revision is in m_KeysCache. */
+	const cPalettedContainer::cKeys & GetSectionKeys(const ChunkBlockData & a_BlockData, size_t a_Y);
+
 	/** Writes all blocks in a chunk section into a series of Int64.
 	Writes start from the bit directly subsequent to the previous write's end, possibly crossing over to the next Int64. */
 	template <auto Palette>
@@ -112,6 +130,29 @@ private:
 	/** A compressor used to compress the chunk data. */
 	CircularBufferCompressor m_Compressor;
 
+	/** Encodes the block state containers of the 1.16+ formats. */
+	cPalettedContainer m_BlockContainer;
+
+	/** Encodes the biome containers of the 1.18+ formats. */
+	cPalettedContainer m_BiomeContainer;
+
+	/** The biomes of each section of the chunk being sent, in the order of the 1.18+ biome containers.
+	Biomes are stored per column, so the 4 * 4 * 4 cells are the same for all sections. */
+	std::array<UInt16, 4 * 4 * 4> m_SectionBiomes;
+
+	/** The distinct block states of each section of the chunk being sent, for the sections that have their bit set in m_AnalysedSections. */
+	std::array<cPalettedContainer::cKeys, cChunkDef::NumSections> m_SectionKeys;
+
+	/** Bitmask of the sections in m_SectionKeys that are valid during the current SendToClients() call. */
+	UInt16 m_AnalysedSections;
+
+	/** The distinct block states of recently sent sections, keyed by the section revision (ChunkBlockData::GetSectionRevision()).
+	Cleared when it grows above MAX_CACHED_SECTIONS. */
+	std::unordered_map<UInt64, cPalettedContainer::cKeys> m_KeysCache;
+
+	/** The number of section analyses kept in m_KeysCache. */
+	static constexpr size_t MAX_CACHED_SECTIONS = 16384;
+
 	/** The dimension for the World this Serializer is tied to. */
 	const eDimension m_Dimension;
 
@@ -0,0 +1,124 @@
+
+// InboundCommandQueue.cpp
+
+// Implements the cInboundCommandQueue class that holds the packets decoded in the network thread until the tick thread applies them
+
+#include "Globals.h"
+#include "InboundCommandQueue.h"
+
+
+
+
+
+cInboundCommandQueue::cInboundCommandQueue(size_t a_MaxCommands, size_t a_MaxPacketBytes):
+	m_MaxCommands(a_MaxCommands),
+	m_MaxPacketBytes(a_MaxPacketBytes),
+	m_NumCoalesced(0),
+	m_NumWindowCommands(0),
+	m_NumWindowPacketBytes(0)
+{
+}
+
+
+
+
+
+void cInboundCommandQueue::UpdateLimitWindow(const std::chrono::steady_clock::time_point a_Now)
+{
+	if (a_Now - m_WindowStart < LIMIT_WINDOW)
+	{
+		return;
+	}
+	m_WindowStart = a_Now;
+	m_NumWindowCommands = 0;
+	m_NumWindowPacketBytes = 0;
+}
+
+
+
+
+
+bool cInboundCommandQueue::PushMovement(const sMovement & a_Movement)
+{
+	// Merge into the previous movement, if there's one right before:
+	if (!m_Commands.empty())
+	{
+		if (auto Last = std::get_if<sMovement>(&m_Commands.back()))
+		{
+			if (a_Movement.m_HasPosition)
+			{
+				Last->m_Position = a_Movement.m_Position;
+				Last->m_HasPosition = true;
+			}
+			if (a_Movement.m_HasLook)
+			{
+				Last->m_Yaw = a_Movement.m_Yaw;
+				Last->m_Pitch = a_Movement.m_Pitch;
+				Last->m_HasLook = true;
+			}
+			Last->m_IsOnGround = a_Movement.m_IsOnGround;
+			m_NumCoalesced += 1;
+			return true;
+		}
+	}
+
+	if (m_NumWindowCommands >= m_MaxCommands)
+	{
+		return false;
+	}
+	m_Commands.emplace_back(a_Movement);
+	m_NumWindowCommands += 1;
+	return true;
+}
+
+
+
+
+
+bool cInboundCommandQueue::PushPacket(const ContiguousByteBufferView a_Data)
+{
+	// A packet is accepted with any size while the window's bytes are below the limit, the protocol limits the packet size itself:
+	if ((m_NumWindowCommands >= m_MaxCommands) || (m_NumWindowPacketBytes >= m_MaxPacketBytes))
+	{
+		return false;
+	}
+	m_Commands.emplace_back(sPacket{ m_PacketData.size(), a_Data.size() });
+	m_PacketData.append(a_Data);
+	m_NumWindowCommands += 1;
+	m_NumWindowPacketBytes += a_Data.size();
+	return true;
+}
+
+
+
+
+
+void cInboundCommandQueue::SetError(const AString & a_Reason)
+{
+	if (m_Error.empty())
+	{
+		m_Error = a_Reason;
+	}
+}
+
+
+
+
+
+void cInboundCommandQueue::Clear(void)
+{
+	m_Commands.clear();
+	m_PacketData.clear();
+	m_Error.clear();
+}
+
+
+
+
+
+void cInboundCommandQueue::Swap(cInboundCommandQueue & a_Other)
+{
+	std::swap(m_Commands, a_Other.m_Commands);
+	std::swap(m_PacketData, a_Other.m_PacketData);
+	std::swap(m_Error, a_Other.m_Error);
+}
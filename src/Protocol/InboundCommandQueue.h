@@ -0,0 +1,122 @@
+
+// InboundCommandQueue.h
+
+// Declares the cInboundCommandQueue class that holds the packets decoded in the network thread until the tick thread applies them
+
+
+
+
+
+#pragma once
+
+
+
+
+
+/** The packets received from a single client, already decrypted, decompressed and split in the network thread,
+waiting to be applied in the tick thread.
+Movement packets are parsed into sMovement, and consecutive movements are merged into the latest state, so that the tick
+applies one position and look per burst instead of one per packet; a movement is never merged across another packet,
+so the order relative to digging, placing, teleport confirmations etc. is kept.
+All other packets are kept as their raw data (packet type and payload) in a single shared buffer, and parsed by the
+protocol in the tick thread, since their handlers touch the game state.
+The queue limits the rate of the commands and of the packet data bytes pushed into it (flood protection): the pushes fail
+once a limit is reached within the current LIMIT_WINDOW, regardless of how many commands the tick thread has taken out
+meanwhile, so that a stalled tick doesn't count against the client. A packet of any size is accepted while the window's
+bytes are below the limit, so that a single legal packet larger than the byte limit doesn't fail.
+Not thread-safe, the owner protects it. */
+class cInboundCommandQueue
+{
+public:
+
+	/** A player movement, merged from one or more position / look packets. */
+	struct sMovement
+	{
+		Vector3d m_Position;
+		float m_Yaw;
+		float m_Pitch;
+		bool m_HasPosition;
+		bool m_HasLook;
+		bool m_IsOnGround;
+	};
+
+	/** Any other packet, its data (type and payload) is stored in the queue's packet data buffer. */
+	struct sPacket
+	{
+		size_t m_Start;
+		size_t m_Size;
+	};
+
+	using cCommand = std::variant<sMovement, sPacket>;
+
+	/** The length of the window in which the limits on the number of commands and on the packet data bytes apply. */
+	static constexpr std::chrono::seconds LIMIT_WINDOW{1};
+
+
+	/** Creates a queue accepting up to a_MaxCommands commands and a_MaxPacketBytes bytes of packet data per LIMIT_WINDOW. */
+	cInboundCommandQueue(size_t a_MaxCommands, size_t a_MaxPacketBytes);
+
+	/** Starts a new limit window, if the current one has elapsed by a_Now.
+	The owner calls this with the current time before pushing the commands of newly received data. */
+	void UpdateLimitWindow(std::chrono::steady_clock::time_point a_Now);
+
+	/** Adds the movement, merging it into the last command if that is a movement as well.
+	Returns false if the queue is full. */
+	bool PushMovement(const sMovement & a_Movement);
+
+	/** Adds a copy of the packet data (type and payload).
+	Returns false if the queue is full. */
+	bool PushPacket(ContiguousByteBufferView a_Data);
+
+	/** Sets the reason for kicking the client, after the queued commands are applied. Only the first error is kept. */
+	void SetError(const AString & a_Reason);
+
+	/** Returns the queued commands, in the order they were received. */
+	const std::vector<cCommand> & GetCommands(void) const { return m_Commands; }
+
+	/** Returns the data (type and payload) of the specified queued packet. */
+	ContiguousByteBufferView GetPacketData(const sPacket & a_Packet) const
+	{
+		return ContiguousByteBufferView(m_PacketData).substr(a_Packet.m_Start, a_Packet.m_Size);
+	}
+
+	bool HasError(void) const { return !m_Error.empty(); }
+	const AString & GetError(void) const { return m_Error; }
+
+	/** Returns true if there are no commands and no error. */
+	bool IsEmpty(void) const { return m_Commands.empty() && m_Error.empty(); }
+
+	/** Returns the number of movements that were merged into an earlier one since the queue was created. */
+	size_t GetNumCoalesced(void) const { return m_NumCoalesced; }
+
+	/** Removes all the commands and the error, keeping the allocated memory for reuse.
+	The commands pushed in the current limit window still count towards the limits. */
+	void Clear(void);
+
+	/** Exchanges the contents with a_Other, so that the commands can be applied outside of the owner's lock.
+	The limit windows are not exchanged, they stay with the queue that is being pushed into. */
+	void Swap(cInboundCommandQueue & a_Other);
+
+protected:
+
+	std::vector<cCommand> m_Commands;
+
+	/** The data of all the queued sPacket commands, back to back. */
+	ContiguousByteBuffer m_PacketData;
+
+	/** The reason for kicking the client, empty if there was no error. */
+	AString m_Error;
+
+	/** The limits, per LIMIT_WINDOW. */
+	size_t m_MaxCommands;
+	size_t m_MaxPacketBytes;
+
+	size_t m_NumCoalesced;
+
+	/** The start of the current limit window. */
+	std::chrono::steady_clock::time_point m_WindowStart;
+
+	/** The number of the commands and of the packet data bytes pushed in the current limit window. */
+	size_t m_NumWindowCommands;
+	size_t m_NumWindowPacketBytes;
+} ;
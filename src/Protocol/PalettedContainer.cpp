@@ -0,0 +1,281 @@
+
+// PalettedContainer.cpp
+
+// Implements the cPalettedContainer class that analyses and encodes the paletted containers of the 1.16+ chunk data packets
+
+#include "Globals.h"
+#include "PalettedContainer.h"
+#include "../ByteBuffer.h"
+
+
+
+
+
+cPalettedContainer::cPalettedContainer(void) :
+	m_Lookup(std::make_unique<UInt16[]>(std::numeric_limits<UInt16>::max() + 1)),
+	m_Count(0),
+	m_Format(eFormat::Direct),
+	m_BitsPerEntry(0)
+{
+	std::fill_n(m_Lookup.get(), std::numeric_limits<UInt16>::max() + 1, NO_ENTRY);
+}
+
+
+
+
+
+void cPalettedContainer::Analyse(const ChunkBlockData::BlockArray * a_Section)
+{
+	Clear();
+	m_Count = ChunkBlockData::SectionBlockCount;
+	if (a_Section == nullptr)
+	{
+		AddKey(ChunkBlockData::DefaultValue.ID);
+		return;
+	}
+
+	// Neighbouring blocks are mostly the same, skip the lookup for runs:
+	auto Previous = (*a_Section)[0].ID;
+	AddKey(Previous);
+	for (const auto Block : *a_Section)
+	{
+		if (Block.ID != Previous)
+		{
+			Previous = Block.ID;
+			AddKey(Previous);
+		}
+	}
+}
+
+
+
+
+
+void cPalettedContainer::Analyse(const UInt16 * a_Values, size_t a_Count)
+{
+	ASSERT(a_Count > 0);
+
+	Clear();
+	m_Count = a_Count;
+	for (size_t i = 0; i < a_Count; i++)
+	{
+		AddKey(a_Values[i]);
+	}
+}
+
+
+
+
+
+void cPalettedContainer::Assign(const cKeys & a_Keys, size_t a_Count)
+{
+	ASSERT(!a_Keys.empty());
+
+	Clear();
+	m_Count = a_Count;
+	for (const auto Key : a_Keys)
+	{
+		AddKey(Key);
+	}
+}
+
+
+
+
+
+size_t cPalettedContainer::GetSize(void) const
+{
+	switch (m_Format)
+	{
+		case eFormat::SingleValued:
+		{
+			// Bits per entry, the value and the zero-length data array:
+			return 1 + cByteBuffer::GetVarIntSize(m_Palette[0]) + 1;
+		}
+		case eFormat::Indirect:
+		{
+			size_t Size = 1 + cByteBuffer::GetVarIntSize(static_cast<UInt32>(m_Palette.size()));
+			for (const auto ProtocolID : m_Palette)
+			{
+				Size += cByteBuffer::GetVarIntSize(ProtocolID);
+			}
+			const auto NumLongs = GetNumLongs(m_BitsPerEntry, m_Count);
+			return Size + cByteBuffer::GetVarIntSize(static_cast<UInt32>(NumLongs)) + NumLongs * 8;
+		}
+		case eFormat::Direct:
+		{
+			const auto NumLongs = GetNumLongs(m_BitsPerEntry, m_Count);
+			return 1 + cByteBuffer::GetVarIntSize(static_cast<UInt32>(NumLongs)) + NumLongs * 8;
+		}
+	}
+	UNREACHABLE("Unsupported paletted container format");
+}
+
+
+
+
+
+void cPalettedContainer::Write(cByteBuffer & a_Out, const ChunkBlockData::BlockArray * a_Section) const
+{
+	ASSERT(m_Count == ChunkBlockData::SectionBlockCount);
+
+	if (a_Section == nullptr)
+	{
+		WriteEntries(a_Out, [](size_t a_Index) { return ChunkBlockData::DefaultValue.ID; });
+	}
+	else
+	{
+		WriteEntries(a_Out, [a_Section](size_t a_Index) { return (*a_Section)[a_Index].ID; });
+	}
+}
+
+
+
+
+
+void cPalettedContainer::Write(cByteBuffer & a_Out, const UInt16 * a_Values) const
+{
+	WriteEntries(a_Out, [a_Values](size_t a_Index) { return a_Values[a_Index]; });
+}
+
+
+
+
+
+size_t cPalettedContainer::GetNumLongs(UInt8 a_BitsPerEntry, size_t a_Count)
+{
+	if (a_BitsPerEntry == 0)
+	{
+		return 0;
+	}
+	const size_t EntriesPerLong = 64 / a_BitsPerEntry;
+	return (a_Count + EntriesPerLong - 1) / EntriesPerLong;
+}
+
+
+
+
+
+void cPalettedContainer::Clear(void)
+{
+	for (const auto Key : m_Keys)
+	{
+		m_Lookup[Key] = NO_ENTRY;
+	}
+	m_Keys.clear();
+}
+
+
+
+
+
+void cPalettedContainer::ChooseFormat(const sRules & a_Rules)
+{
+	ASSERT(m_ProtocolIDs.size() == m_Keys.size());
+
+	// Build the local palette, sharing the entries of keys that map to the same protocol ID:
+	const size_t MaxPaletteSize = static_cast<size_t>(1) << a_Rules.m_MaxIndirectBits;
+	m_Palette.clear();
+	bool IsIndirect = true;
+	for (size_t i = 0; i < m_Keys.size(); i++)
+	{
+		const auto ProtocolID = m_ProtocolIDs[i];
+		auto Entry = std::find(m_Palette.begin(), m_Palette.end(), ProtocolID);
+		if (Entry == m_Palette.end())
+		{
+			if (m_Palette.size() == MaxPaletteSize)
+			{
+				IsIndirect = false;
+				break;
+			}
+			m_Palette.push_back(ProtocolID);
+			Entry = m_Palette.end() - 1;
+		}
+		m_Lookup[m_Keys[i]] = static_cast<UInt16>(Entry - m_Palette.begin());
+	}
+
+	if (!IsIndirect)
+	{
+		m_Format = eFormat::Direct;
+		m_BitsPerEntry = a_Rules.m_DirectBits;
+		m_Palette.clear();
+		for (size_t i = 0; i < m_Keys.size(); i++)
+		{
+			ASSERT(m_ProtocolIDs[i] < (1U << a_Rules.m_DirectBits));
+			m_Lookup[m_Keys[i]] = static_cast<UInt16>(m_ProtocolIDs[i]);
+		}
+		return;
+	}
+
+	if ((m_Palette.size() == 1) && a_Rules.m_AllowSingleValue)
+	{
+		m_Format = eFormat::SingleValued;
+		m_BitsPerEntry = 0;
+		return;
+	}
+
+	// The narrowest width that can index the whole palette:
+	UInt8 BitsPerEntry = a_Rules.m_MinBits;
+	while ((static_cast<size_t>(1) << BitsPerEntry) < m_Palette.size())
+	{
+		BitsPerEntry++;
+	}
+	m_Format = eFormat::Indirect;
+	m_BitsPerEntry = BitsPerEntry;
+}
+
+
+
+
+
+template <typename KeyOf>
+void cPalettedContainer::WriteEntries(cByteBuffer & a_Out, KeyOf a_KeyOf) const
+{
+	// https://wiki.vg/Chunk_Format#Paletted_Container_structure
+	a_Out.WriteBEUInt8(m_BitsPerEntry);
+	switch (m_Format)
+	{
+		case eFormat::SingleValued:
+		{
+			a_Out.WriteVarInt32(m_Palette[0]);
+			a_Out.WriteVarInt32(0);
+			return;
+		}
+		case eFormat::Indirect:
+		{
+			a_Out.WriteVarInt32(static_cast<UInt32>(m_Palette.size()));
+			for (const auto ProtocolID : m_Palette)
+			{
+				a_Out.WriteVarInt32(ProtocolID);
+			}
+			break;
+		}
+		case eFormat::Direct:
+		{
+			break;
+		}
+	}
+
+	a_Out.WriteVarInt32(static_cast<UInt32>(GetNumLongs(m_BitsPerEntry, m_Count)));
+
+	// Pack the entries, the ones that don't fit wholly into the current Int64 start the next one:
+	const size_t EntriesPerLong = 64 / m_BitsPerEntry;
+	UInt64 Buffer = 0;
+	size_t NumInBuffer = 0;
+	for (size_t i = 0; i < m_Count; i++)
+	{
+		const auto Value = m_Lookup[a_KeyOf(i)];
+		ASSERT(Value != NO_ENTRY);  // The data differs from the analysed one
+		Buffer |= static_cast<UInt64>(Value) << (NumInBuffer * m_BitsPerEntry);
+		if (++NumInBuffer == EntriesPerLong)
+		{
+			a_Out.WriteBEUInt64(Buffer);
+			Buffer = 0;
+			NumInBuffer = 0;
+		}
+	}
+	if (NumInBuffer > 0)
+	{
+		a_Out.WriteBEUInt64(Buffer);
+	}
+}
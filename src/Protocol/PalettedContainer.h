@@ -0,0 +1,157 @@
+
+// PalettedContainer.h
+
+// Declares the cPalettedContainer class that analyses and encodes the paletted containers of the 1.16+ chunk data packets
+
+
+
+
+
+#pragma once
+
+#include "../ChunkData.h"
+
+
+
+
+
+// fwd:
+class cByteBuffer;
+
+
+
+
+
+/** Encodes a single paletted container (the blocks or the biomes of a chunk section) in the most compact format the protocol allows:
+single-valued (1.18+), indirect with a local palette, or direct with the global palette.
+Usage: Analyse() the data (or Assign() the keys remembered from an earlier analysis), Map() the keys to protocol IDs, then GetSize() and Write().
+The keys are the values stored by the server (block state IDs, biomes), the protocol IDs are what the client expects for them.
+The instance keeps a 64K-entry lookup table, so it should be reused rather than created for each container. */
+class cPalettedContainer
+{
+public:
+
+	/** The distinct keys of a container, in the order of their first appearance. */
+	using cKeys = std::vector<UInt16>;
+
+	/** The encoding rules of a single kind of container in a protocol version. */
+	struct sRules
+	{
+		/** The narrowest index width of an indirect palette. */
+		UInt8 m_MinBits;
+
+		/** The widest index width of an indirect palette; containers that would need more use the direct palette. */
+		UInt8 m_MaxIndirectBits;
+
+		/** The width of the protocol IDs in the direct palette. */
+		UInt8 m_DirectBits;
+
+		/** Whether the protocol supports the single-valued format (1.18+). */
+		bool m_AllowSingleValue;
+	};
+
+	/** Block states in 1.16 - 1.17. */
+	static constexpr sRules BLOCK_RULES_1_16 = { 4, 8, 15, false };
+
+	/** Block states in 1.18+. */
+	static constexpr sRules BLOCK_RULES_1_18 = { 4, 8, 15, true };
+
+	/** Biomes in 1.18+. */
+	static constexpr sRules BIOME_RULES_1_18 = { 1, 3, 6, true };
+
+	enum class eFormat
+	{
+		SingleValued,  ///< All entries are the same, only the single protocol ID is written
+		Indirect,      ///< Entries are indices into the local palette that is written with the container
+		Direct,        ///< Entries are the protocol IDs themselves
+	};
+
+	cPalettedContainer(void);
+
+	/** Collects the distinct block states of the section. A nullptr section is all air. */
+	void Analyse(const ChunkBlockData::BlockArray * a_Section);
+
+	/** Collects the distinct values of the a_Count entries in a_Values. */
+	void Analyse(const UInt16 * a_Values, size_t a_Count);
+
+	/** Uses the keys collected by an earlier Analyse() of the same data, for a container of a_Count entries. */
+	void Assign(const cKeys & a_Keys, size_t a_Count);
+
+	/** Returns the distinct keys collected by the last Analyse() or Assign(). */
+	const cKeys & GetKeys(void) const { return m_Keys; }
+
+	/** Maps the keys to protocol IDs using a_ToProtocol (callable taking the UInt16 key) and chooses the format according to a_Rules.
+	Keys that map to the same protocol ID share their palette entry. */
+	template <typename ToProtocol>
+	void Map(ToProtocol a_ToProtocol, const sRules & a_Rules)
+	{
+		m_ProtocolIDs.clear();
+		for (const auto Key : m_Keys)
+		{
+			m_ProtocolIDs.push_back(static_cast<UInt32>(a_ToProtocol(Key)));
+		}
+		ChooseFormat(a_Rules);
+	}
+
+	eFormat GetFormat(void) const { return m_Format; }
+
+	/** Returns the number of bits per entry written to the packet (0 for single-valued containers). */
+	UInt8 GetBitsPerEntry(void) const { return m_BitsPerEntry; }
+
+	/** Returns the number of bytes Write() produces. */
+	size_t GetSize(void) const;
+
+	/** Writes the mapped container of the section; it must be the same data that was analysed. */
+	void Write(cByteBuffer & a_Out, const ChunkBlockData::BlockArray * a_Section) const;
+
+	/** Writes the mapped container of the values; they must be the same data that was analysed. */
+	void Write(cByteBuffer & a_Out, const UInt16 * a_Values) const;
+
+	/** Returns the number of Int64s that store a_Count entries of the specified width, without entries spanning two Int64s. */
+	static size_t GetNumLongs(UInt8 a_BitsPerEntry, size_t a_Count);
+
+protected:
+
+	/** Marks the keys not present in the data in m_Lookup. */
+	static constexpr UInt16 NO_ENTRY = 0xffff;
+
+	/** The distinct keys, in the order of their first appearance. */
+	cKeys m_Keys;
+
+	/** The protocol ID of each key in m_Keys. */
+	std::vector<UInt32> m_ProtocolIDs;
+
+	/** The local palette written for indirect containers, or the single value of single-valued ones. */
+	std::vector<UInt32> m_Palette;
+
+	/** For each key present in the data, the value written for it: the index into m_Palette, or the protocol ID for direct containers.
+	All other entries are NO_ENTRY. */
+	std::unique_ptr<UInt16[]> m_Lookup;
+
+	/** The number of entries of the container. */
+	size_t m_Count;
+
+	eFormat m_Format;
+	UInt8 m_BitsPerEntry;
+
+
+	/** Resets m_Lookup entries of the previous keys and clears the keys. */
+	void Clear(void);
+
+	/** Adds the key to m_Keys, if not already present. */
+	void AddKey(UInt16 a_Key)
+	{
+		if (m_Lookup[a_Key] == NO_ENTRY)
+		{
+			m_Lookup[a_Key] = 0;
+			m_Keys.push_back(a_Key);
+		}
+	}
+
+	/** Builds the palette from m_ProtocolIDs, chooses the format and fills m_Lookup with the values to write. */
+	void ChooseFormat(const sRules & a_Rules);
+
+	/** Writes the header and the palette, followed by the entries, each looked up by its key returned from a_KeyOf(Index). */
+	template <typename KeyOf>
+	void WriteEntries(cByteBuffer & a_Out, KeyOf a_KeyOf) const;
+} ;
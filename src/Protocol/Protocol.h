@@ -32,6 +32,7 @@ class cWorld;
 class cMonster;
 class cCompositeChat;
 class cPacketizer;
+class cInboundCommandQueue;
 
 struct StatisticsManager;
 
@@ -439,6 +440,19 @@ public:
 	The protocol uses the provided buffers for storage and processing, and must have exclusive access to them. */
 	virtual void DataReceived(cByteBuffer & a_Buffer, ContiguousByteBuffer & a_Data) = 0;
 
+	/** Returns true if the received data can be decoded in the network thread by DecodeReceivedData() instead of DataReceived().
+	Called in the tick thread, after handling the received data. */
+	virtual bool CanDecodeOffTick(void) const = 0;
+
+	/** Called by cClientHandle in the network thread instead of DataReceived(), while CanDecodeOffTick() is true.
+	Decrypts and decompresses the data and splits it into packets, queueing them into a_Commands instead of handling them.
+	Decoding errors are queued as well, for the tick thread to kick the client.
+	The protocol uses the provided buffer for storage, and must have exclusive access to it. */
+	virtual void DecodeReceivedData(cByteBuffer & a_Buffer, ContiguousByteBuffer & a_Data, cInboundCommandQueue & a_Commands) = 0;
+
+	/** Handles the commands queued by DecodeReceivedData(), in the tick thread. The queue's error is left to the caller. */
+	virtual void HandleInboundCommands(const cInboundCommandQueue & a_Commands) = 0;
+
 	/** Called by cClientHandle to finalise a buffer of prepared data before they are sent to the client.
 	Descendants may for example, encrypt the data if needed.
 	The protocol modifies the provided buffer in-place. */
@@ -477,6 +491,7 @@ public:
 	virtual void SendEntityMetadata             (const cEntity & a_Entity) = 0;
 	virtual void SendEntityPosition             (const cEntity & a_Entity) = 0;
 	virtual void SendEntityProperties           (const cEntity & a_Entity) = 0;
+	virtual void SendEntityTeleport             (const cEntity & a_Entity) = 0;  ///< Sends the absolute position, regardless of the last sent one
 	virtual void SendEntityVelocity             (const cEntity & a_Entity) = 0;
 	virtual void SendExplosion                  (Vector3f a_Position, float a_Power) = 0;
 	virtual void SendFinishConfiguration        (void) = 0;
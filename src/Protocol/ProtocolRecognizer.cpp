@@ -236,6 +236,25 @@ void cMultiVersionProtocol::HandleIncomingData(cClientHandle & a_Client, Contigu
 
 
 
+bool cMultiVersionProtocol::CanDecodeOffTick(void) const
+{
+	return !m_WaitingForData && (m_Protocol != nullptr) && m_Protocol->CanDecodeOffTick();
+}
+
+
+
+
+
+void cMultiVersionProtocol::DecodeIncomingData(ContiguousByteBuffer & a_Data, cInboundCommandQueue & a_Commands)
+{
+	ASSERT(!m_WaitingForData && (m_Protocol != nullptr));
+	m_Protocol->DecodeReceivedData(m_Buffer, a_Data, a_Commands);
+}
+
+
+
+
+
 void cMultiVersionProtocol::HandleOutgoingData(ContiguousByteBuffer & a_Data)
 {
 	// Normally only the protocol sends data, so outgoing data are only present when m_Protocol != nullptr.
@@ -47,6 +47,14 @@ public:
 	The protocol modifies the provided buffer in-place. */
 	void HandleIncomingData(cClientHandle & a_Client, ContiguousByteBuffer & a_Data);
 
+	/** Returns true if the version has been recognized and its protocol can decode the incoming data in the network thread.
+	Called in the tick thread. */
+	bool CanDecodeOffTick(void) const;
+
+	/** Decodes the incoming data in the network thread, queueing the packets into a_Commands.
+	Only valid while CanDecodeOffTick() is true; the caller ensures that HandleIncomingData() doesn't run at the same time. */
+	void DecodeIncomingData(ContiguousByteBuffer & a_Data, cInboundCommandQueue & a_Commands);
+
 	/** Allows the protocol (if any) to do a final pass on outgiong data, possibly modifying the provided buffer in-place. */
 	void HandleOutgoingData(ContiguousByteBuffer & a_Data);
 
@@ -1173,6 +1173,22 @@ bool cProtocol_1_12::HandlePacket(cByteBuffer & a_ByteBuffer, UInt32 a_PacketTyp
 
 
 
+cProtocol_1_12::MovementPacket cProtocol_1_12::GetMovementPacket(UInt32 a_PacketType) const
+{
+	switch (a_PacketType)
+	{
+		case 0x0d: return MovementPacket::Player;
+		case 0x0e: return MovementPacket::PlayerPos;
+		case 0x0f: return MovementPacket::PlayerPosLook;
+		case 0x10: return MovementPacket::PlayerLook;
+		default:   return MovementPacket::None;
+	}
+}
+
+
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 // cProtocol_1_12_1:
 
@@ -1302,6 +1318,22 @@ bool cProtocol_1_12_1::HandlePacket(cByteBuffer & a_ByteBuffer, UInt32 a_PacketT
 
 
 
+
+cProtocol_1_12_1::MovementPacket cProtocol_1_12_1::GetMovementPacket(UInt32 a_PacketType) const
+{
+	switch (a_PacketType)
+	{
+		case 0x0c: return MovementPacket::Player;
+		case 0x0d: return MovementPacket::PlayerPos;
+		case 0x0e: return MovementPacket::PlayerPosLook;
+		case 0x0f: return MovementPacket::PlayerLook;
+		default:   return MovementPacket::None;
+	}
+}
+
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 // cProtocol_1_12_2::
 
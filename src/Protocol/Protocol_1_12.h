@@ -40,6 +40,7 @@ protected:
 	virtual Version GetProtocolVersion() const override;
 
 	virtual bool HandlePacket(cByteBuffer & a_ByteBuffer, UInt32 a_PacketType) override;
+	virtual MovementPacket GetMovementPacket(UInt32 a_PacketType) const override;
 	virtual void HandlePacketAdvancementTab(cByteBuffer & a_ByteBuffer);
 	virtual void HandleCraftRecipe(cByteBuffer & a_ByteBuffer);
 	virtual void HandlePacketCraftingBookData(cByteBuffer & a_ByteBuffer);
@@ -67,6 +68,7 @@ protected:
 	virtual Version GetProtocolVersion() const override;
 
 	virtual bool HandlePacket(cByteBuffer & a_ByteBuffer, UInt32 a_PacketType) override;
+	virtual MovementPacket GetMovementPacket(UInt32 a_PacketType) const override;
 };
 
 
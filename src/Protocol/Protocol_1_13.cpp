@@ -961,6 +961,22 @@ bool cProtocol_1_13::HandlePacket(cByteBuffer & a_ByteBuffer, UInt32 a_PacketTyp
 
 
 
+cProtocol_1_13::MovementPacket cProtocol_1_13::GetMovementPacket(UInt32 a_PacketType) const
+{
+	switch (a_PacketType)
+	{
+		case 0x0f: return MovementPacket::Player;
+		case 0x10: return MovementPacket::PlayerPos;
+		case 0x11: return MovementPacket::PlayerPosLook;
+		case 0x12: return MovementPacket::PlayerLook;
+		default:   return MovementPacket::None;
+	}
+}
+
+
+
+
+
 void cProtocol_1_13::HandlePacketNameItem(cByteBuffer & a_ByteBuffer)
 {
 	HANDLE_READ(a_ByteBuffer, ReadVarUTF8String, AString, NewItemName);
@@ -1961,37 +1977,37 @@ void cProtocol_1_13_2::WriteItem(cPacketizer & a_Pkt, const cItem & a_Item) cons
 		finalname += potionname;
 		Writer.AddString("Potion", finalname);
 	}
-	if (a_Item.m_RepairCost != 0)
+	if (a_Item.GetRepairCost() != 0)
 	{
-		Writer.AddInt("RepairCost", a_Item.m_RepairCost);
+		Writer.AddInt("RepairCost", a_Item.GetRepairCost());
 	}
-	if (!a_Item.m_Enchantments.IsEmpty())
+	if (!a_Item.GetEnchantments().IsEmpty())
 	{
 		const char * TagName = (a_Item.m_ItemType == Item::EnchantedBook) ? "StoredEnchantments" : "Enchantments";
-		EnchantmentSerializer::WriteToNBTCompound(a_Item.m_Enchantments, Writer, TagName, true);
+		EnchantmentSerializer::WriteToNBTCompound(a_Item.GetEnchantments(), Writer, TagName, true);
 	}
 	if ((a_Item.m_ItemType == Item::FireworkRocket) || (a_Item.m_ItemType == Item::FireworkStar))
 	{
-		cFireworkItem::WriteToNBTCompound(a_Item.m_FireworkItem, Writer, a_Item.m_ItemType);
+		cFireworkItem::WriteToNBTCompound(a_Item.GetFireworkItem(), Writer, a_Item.m_ItemType);
 	}
 
-	if (!a_Item.IsBothNameAndLoreEmpty() || a_Item.m_ItemColor.IsValid())
+	if (!a_Item.IsBothNameAndLoreEmpty() || a_Item.GetItemColor().IsValid())
 	{
 		Writer.BeginCompound("display");
-		if (a_Item.m_ItemColor.IsValid())
+		if (a_Item.GetItemColor().IsValid())
 		{
-			Writer.AddInt("color", static_cast<Int32>(a_Item.m_ItemColor.m_Color));
+			Writer.AddInt("color", static_cast<Int32>(a_Item.GetItemColor().m_Color));
 		}
 
 		if (!a_Item.IsCustomNameEmpty())
 		{
-			Writer.AddString("Name", a_Item.m_CustomName);
+			Writer.AddString("Name", a_Item.GetCustomName());
 		}
 		if (!a_Item.IsLoreEmpty())
 		{
 			Writer.BeginList("Lore", TAG_String);
 
-			for (const auto & Line : a_Item.m_LoreTable)
+			for (const auto & Line : a_Item.GetLoreTable())
 			{
 				Writer.AddString("", Line);
 			}
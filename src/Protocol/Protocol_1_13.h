@@ -59,6 +59,7 @@ protected:
 	virtual Version GetProtocolVersion() const override;
 
 	virtual bool HandlePacket(cByteBuffer & a_ByteBuffer, UInt32 a_PacketType) override;
+	virtual MovementPacket GetMovementPacket(UInt32 a_PacketType) const override;
 	virtual void HandlePacketNameItem(cByteBuffer & a_ByteBuffer);
 	virtual void HandlePacketPluginMessage(cByteBuffer & a_ByteBuffer) override;
 	virtual void HandlePacketSetBeaconEffect(cByteBuffer & a_ByteBuffer);
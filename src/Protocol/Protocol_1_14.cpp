@@ -1014,6 +1014,22 @@ bool cProtocol_1_14::HandlePacket(cByteBuffer & a_ByteBuffer, UInt32 a_PacketTyp
 
 
 
+cProtocol_1_14::MovementPacket cProtocol_1_14::GetMovementPacket(UInt32 a_PacketType) const
+{
+	switch (a_PacketType)
+	{
+		case 0x11: return MovementPacket::PlayerPos;
+		case 0x12: return MovementPacket::PlayerPosLook;
+		case 0x13: return MovementPacket::PlayerLook;
+		case 0x14: return MovementPacket::Player;
+		default:   return MovementPacket::None;
+	}
+}
+
+
+
+
+
 void cProtocol_1_14::HandlePacketBlockDig(cByteBuffer & a_ByteBuffer)
 {
 	HANDLE_READ(a_ByteBuffer, ReadBEUInt8, UInt8, Status);
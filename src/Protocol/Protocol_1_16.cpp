@@ -193,6 +193,22 @@ bool cProtocol_1_16::HandlePacket(cByteBuffer & a_ByteBuffer, UInt32 a_PacketTyp
 
 
 
+cProtocol_1_16::MovementPacket cProtocol_1_16::GetMovementPacket(UInt32 a_PacketType) const
+{
+	switch (a_PacketType)
+	{
+		case 0x12: return MovementPacket::PlayerPos;
+		case 0x13: return MovementPacket::PlayerPosLook;
+		case 0x14: return MovementPacket::PlayerLook;
+		case 0x15: return MovementPacket::Player;
+		default:   return MovementPacket::None;
+	}
+}
+
+
+
+
+
 void cProtocol_1_16::SendLoginSuccess(void)
 {
 	ASSERT(m_State == 2);  // State: login?
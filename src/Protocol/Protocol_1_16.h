@@ -16,6 +16,7 @@ protected:
 
 	virtual UInt32 GetPacketID(ePacketType a_PacketType) const override;
 	virtual bool HandlePacket(cByteBuffer & a_ByteBuffer, UInt32 a_PacketType) override;
+	virtual MovementPacket GetMovementPacket(UInt32 a_PacketType) const override;
 
 	virtual void SendLoginSuccess(void) override;
 	virtual void SendLogin(const cPlayer & a_Player, const cWorld & a_World) override;
@@ -365,6 +365,22 @@ bool cProtocol_1_17::HandlePacket(cByteBuffer & a_ByteBuffer, UInt32 a_PacketTyp
 
 
 
+cProtocol_1_17::MovementPacket cProtocol_1_17::GetMovementPacket(UInt32 a_PacketType) const
+{
+	switch (a_PacketType)
+	{
+		case 0x11: return MovementPacket::PlayerPos;
+		case 0x12: return MovementPacket::PlayerPosLook;
+		case 0x13: return MovementPacket::PlayerLook;
+		case 0x14: return MovementPacket::Player;
+		default:   return MovementPacket::None;
+	}
+}
+
+
+
+
+
 void cProtocol_1_17::SendLogin(const cPlayer & a_Player, const cWorld & a_World)
 {
 	// Send the Join Game packet:
@@ -16,6 +16,7 @@ public:
 protected:
 	virtual UInt32    GetPacketID(ePacketType a_PacketType) const override;
 	virtual bool      HandlePacket(cByteBuffer & a_ByteBuffer, UInt32 a_PacketType) override;
+	virtual MovementPacket GetMovementPacket(UInt32 a_PacketType) const override;
 	virtual void      HandlePacketClientSettings(cByteBuffer & a_ByteBuffer) override;
 	virtual void      HandlePacketWindowClick(cByteBuffer & a_ByteBuffer) override;
 
@@ -229,6 +229,22 @@ bool cProtocol_1_19::HandlePacket(cByteBuffer & a_ByteBuffer, UInt32 a_PacketTyp
 
 
 
+cProtocol_1_19::MovementPacket cProtocol_1_19::GetMovementPacket(UInt32 a_PacketType) const
+{
+	switch (a_PacketType)
+	{
+		case 0x13: return MovementPacket::PlayerPos;
+		case 0x14: return MovementPacket::PlayerPosLook;
+		case 0x15: return MovementPacket::PlayerLook;
+		case 0x16: return MovementPacket::Player;
+		default:   return MovementPacket::None;
+	}
+}
+
+
+
+
+
 UInt32 cProtocol_1_19::GetProtocolBlockType(BlockState a_Block) const
 {
 	// return Palette_1_19::From(a_Block);
@@ -1796,6 +1812,22 @@ bool cProtocol_1_19_1::HandlePacket(cByteBuffer & a_ByteBuffer, UInt32 a_PacketT
 
 
 
+cProtocol_1_19_1::MovementPacket cProtocol_1_19_1::GetMovementPacket(UInt32 a_PacketType) const
+{
+	switch (a_PacketType)
+	{
+		case 0x14: return MovementPacket::PlayerPos;
+		case 0x15: return MovementPacket::PlayerPosLook;
+		case 0x16: return MovementPacket::PlayerLook;
+		case 0x17: return MovementPacket::Player;
+		default:   return MovementPacket::None;
+	}
+}
+
+
+
+
+
 void cProtocol_1_19_1::HandlePacketCommandExecution(cByteBuffer & a_ByteBuffer)
 {
 	ContiguousByteBuffer sigdata;
@@ -2106,6 +2138,22 @@ bool cProtocol_1_19_3::HandlePacket(cByteBuffer & a_ByteBuffer, UInt32 a_PacketT
 
 
 
+cProtocol_1_19_3::MovementPacket cProtocol_1_19_3::GetMovementPacket(UInt32 a_PacketType) const
+{
+	switch (a_PacketType)
+	{
+		case 0x13: return MovementPacket::PlayerPos;
+		case 0x14: return MovementPacket::PlayerPosLook;
+		case 0x15: return MovementPacket::PlayerLook;
+		case 0x16: return MovementPacket::Player;
+		default:   return MovementPacket::None;
+	}
+}
+
+
+
+
+
 void cProtocol_1_19_3::SendChatRaw(const AString & a_MessageRaw, eChatType a_Type)
 {
 	ASSERT(m_State == 3);  // In game mode?
@@ -2819,6 +2867,22 @@ bool cProtocol_1_19_4::HandlePacket(cByteBuffer & a_ByteBuffer, UInt32 a_PacketT
 
 
 
+cProtocol_1_19_4::MovementPacket cProtocol_1_19_4::GetMovementPacket(UInt32 a_PacketType) const
+{
+	switch (a_PacketType)
+	{
+		case 0x14: return MovementPacket::PlayerPos;
+		case 0x15: return MovementPacket::PlayerPosLook;
+		case 0x16: return MovementPacket::PlayerLook;
+		case 0x17: return MovementPacket::Player;
+		default:   return MovementPacket::None;
+	}
+}
+
+
+
+
+
 void cProtocol_1_19_4::HandlePacketPlayerSession(cByteBuffer & a_ByteBuffer)
 {
 	ContiguousByteBuffer pubkey;
@@ -31,6 +31,7 @@ protected:
 
 	virtual void    HandlePacketLoginEncryptionResponse(cByteBuffer & a_ByteBuffer) override;
 	virtual bool    HandlePacket(cByteBuffer & a_ByteBuffer, UInt32 a_PacketType) override;
+	virtual MovementPacket GetMovementPacket(UInt32 a_PacketType) const override;
 	virtual void    HandlePacketLoginStart(cByteBuffer & a_ByteBuffer) override;
 	virtual void    HandlePacketChatMessage(cByteBuffer & a_ByteBuffer) override;
 	virtual void    HandlePacketCommandExecution(cByteBuffer & a_ByteBuffer) override;
@@ -72,6 +73,7 @@ protected:
 
 	virtual void    HandlePacketLoginStart(cByteBuffer & a_ByteBuffer) override;
 	virtual bool    HandlePacket(cByteBuffer & a_ByteBuffer, UInt32 a_PacketType) override;
+	virtual MovementPacket GetMovementPacket(UInt32 a_PacketType) const override;
 	virtual void    HandlePacketCommandExecution(cByteBuffer & a_ByteBuffer) override;
 
 	virtual Version GetProtocolVersion() const override;
@@ -105,6 +107,7 @@ protected:
 	virtual void    HandlePacketLoginEncryptionResponse(cByteBuffer & a_ByteBuffer) override;
 	virtual void    HandlePacketLoginStart(cByteBuffer & a_ByteBuffer) override;
 	virtual bool    HandlePacket(cByteBuffer & a_ByteBuffer, UInt32 a_PacketType) override;
+	virtual MovementPacket GetMovementPacket(UInt32 a_PacketType) const override;
 	virtual void    HandlePacketCommandExecution(cByteBuffer & a_ByteBuffer) override;
 	virtual void    HandlePacketChatMessage(cByteBuffer & a_ByteBuffer) override;
 
@@ -133,6 +136,7 @@ protected:
 	virtual void    SendRespawn(eDimension a_Dimension) override;
 
 	virtual bool    HandlePacket(cByteBuffer & a_ByteBuffer, UInt32 a_PacketType) override;
+	virtual MovementPacket GetMovementPacket(UInt32 a_PacketType) const override;
 	virtual void    HandlePacketPlayerSession(cByteBuffer & a_ByteBuffer) override;
 
 	virtual UInt32  GetProtocolMobType(eMonsterType a_MobType) const override;
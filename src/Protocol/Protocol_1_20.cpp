@@ -829,6 +829,22 @@ bool cProtocol_1_20_2::HandlePacket(cByteBuffer & a_ByteBuffer, UInt32 a_PacketT
 
 
 
+cProtocol_1_20_2::MovementPacket cProtocol_1_20_2::GetMovementPacket(UInt32 a_PacketType) const
+{
+	switch (a_PacketType)
+	{
+		case 0x16: return MovementPacket::PlayerPos;
+		case 0x17: return MovementPacket::PlayerPosLook;
+		case 0x18: return MovementPacket::PlayerLook;
+		case 0x19: return MovementPacket::Player;
+		default:   return MovementPacket::None;
+	}
+}
+
+
+
+
+
 void cProtocol_1_20_2::HandlePacketEnterConfiguration(cByteBuffer & a_ByteBuffer)
 {
 	m_State = State::Configuration;
@@ -1209,37 +1225,37 @@ void cProtocol_1_20_2::WriteItem(cPacketizer & a_Pkt, const cItem & a_Item) cons
 		finalname += potionname;
 		Writer.AddString("Potion", finalname);
 	}
-	if (a_Item.m_RepairCost != 0)
+	if (a_Item.GetRepairCost() != 0)
 	{
-		Writer.AddInt("RepairCost", a_Item.m_RepairCost);
+		Writer.AddInt("RepairCost", a_Item.GetRepairCost());
 	}
-	if (!a_Item.m_Enchantments.IsEmpty())
+	if (!a_Item.GetEnchantments().IsEmpty())
 	{
 		const char * TagName = (a_Item.m_ItemType == Item::EnchantedBook) ? "StoredEnchantments" : "Enchantments";
-		EnchantmentSerializer::WriteToNBTCompound(a_Item.m_Enchantments, Writer, TagName, true);
+		EnchantmentSerializer::WriteToNBTCompound(a_Item.GetEnchantments(), Writer, TagName, true);
 	}
 	if ((a_Item.m_ItemType == Item::FireworkRocket) || (a_Item.m_ItemType == Item::FireworkStar))
 	{
-		cFireworkItem::WriteToNBTCompound(a_Item.m_FireworkItem, Writer, a_Item.m_ItemType);
+		cFireworkItem::WriteToNBTCompound(a_Item.GetFireworkItem(), Writer, a_Item.m_ItemType);
 	}
 
-	if (!a_Item.IsBothNameAndLoreEmpty() || a_Item.m_ItemColor.IsValid())
+	if (!a_Item.IsBothNameAndLoreEmpty() || a_Item.GetItemColor().IsValid())
 	{
 		Writer.BeginCompound("display");
-		if (a_Item.m_ItemColor.IsValid())
+		if (a_Item.GetItemColor().IsValid())
 		{
-			Writer.AddInt("color", static_cast<Int32>(a_Item.m_ItemColor.m_Color));
+			Writer.AddInt("color", static_cast<Int32>(a_Item.GetItemColor().m_Color));
 		}
 
 		if (!a_Item.IsCustomNameEmpty())
 		{
-			Writer.AddString("Name", a_Item.m_CustomName);
+			Writer.AddString("Name", a_Item.GetCustomName());
 		}
 		if (!a_Item.IsLoreEmpty())
 		{
 			Writer.BeginList("Lore", TAG_String);
 
-			for (const auto & Line : a_Item.m_LoreTable)
+			for (const auto & Line : a_Item.GetLoreTable())
 			{
 				Writer.AddString("", Line);
 			}
@@ -1495,6 +1511,22 @@ bool cProtocol_1_20_3::HandlePacket(cByteBuffer & a_ByteBuffer, UInt32 a_PacketT
 
 
 
+cProtocol_1_20_3::MovementPacket cProtocol_1_20_3::GetMovementPacket(UInt32 a_PacketType) const
+{
+	switch (a_PacketType)
+	{
+		case 0x17: return MovementPacket::PlayerPos;
+		case 0x18: return MovementPacket::PlayerPosLook;
+		case 0x19: return MovementPacket::PlayerLook;
+		case 0x1A: return MovementPacket::Player;
+		default:   return MovementPacket::None;
+	}
+}
+
+
+
+
+
 void cProtocol_1_20_3::SendChatRaw(const AString & a_MessageRaw, eChatType a_Type)
 {
 	ASSERT(m_State == 3);  // In game mode?
@@ -2016,6 +2048,22 @@ bool cProtocol_1_20_5::HandlePacket(cByteBuffer & a_ByteBuffer, UInt32 a_PacketT
 
 
 
+cProtocol_1_20_5::MovementPacket cProtocol_1_20_5::GetMovementPacket(UInt32 a_PacketType) const
+{
+	switch (a_PacketType)
+	{
+		case 0x1A: return MovementPacket::PlayerPos;
+		case 0x1B: return MovementPacket::PlayerPosLook;
+		case 0x1C: return MovementPacket::PlayerLook;
+		case 0x1D: return MovementPacket::Player;
+		default:   return MovementPacket::None;
+	}
+}
+
+
+
+
+
 UInt32 cProtocol_1_20_5::GetPacketID(ePacketType a_PacketType) const
 {
 	switch (a_PacketType)
@@ -56,6 +56,7 @@ protected:
 	virtual void    SendDynamicRegistries() override;
 
 	virtual bool    HandlePacket(cByteBuffer & a_ByteBuffer, UInt32 a_PacketType) override;
+	virtual MovementPacket GetMovementPacket(UInt32 a_PacketType) const override;
 	virtual void    HandlePacketEnterConfiguration(cByteBuffer & a_ByteBuffer) override;
 	virtual void    HandlePacketReady(cByteBuffer & a_ByteBuffer) override;
 	virtual void    HandlePacketLoginStart(cByteBuffer & a_ByteBuffer) override;
@@ -80,6 +81,7 @@ protected:
 	virtual UInt32 GetPacketID(ePacketType a_PacketType) const override;
 
 	virtual bool HandlePacket(cByteBuffer & a_ByteBuffer, UInt32 a_PacketType) override;
+	virtual MovementPacket GetMovementPacket(UInt32 a_PacketType) const override;
 
 	virtual void SendDisconnect(const AString & a_Reason) override;
 	virtual void SendChat(const AString & a_Message, eChatType a_Type) override;
@@ -120,6 +122,7 @@ protected:
 	virtual void HandlePacketLoginStart(cByteBuffer & a_ByteBuffer) override;
 	virtual void HandlePacketEnterConfiguration(cByteBuffer & a_ByteBuffer) override;
 	virtual bool HandlePacket(cByteBuffer & a_ByteBuffer, UInt32 a_PacketType) override;
+	virtual MovementPacket GetMovementPacket(UInt32 a_PacketType) const override;
 
 	virtual void WriteEntityProperties(cPacketizer & a_Pkt, const cEntity & a_Entity) const override;
 	virtual void WriteItem(cPacketizer & a_Pkt, const cItem & a_Item) const override;
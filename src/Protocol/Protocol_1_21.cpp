@@ -916,6 +916,22 @@ bool cProtocol_1_21_2::HandlePacket(cByteBuffer & a_ByteBuffer, UInt32 a_PacketT
 
 
 
+cProtocol_1_21_2::MovementPacket cProtocol_1_21_2::GetMovementPacket(UInt32 a_PacketType) const
+{
+	switch (a_PacketType)
+	{
+		case 0x1C: return MovementPacket::PlayerPos;
+		case 0x1D: return MovementPacket::PlayerPosLook;
+		case 0x1E: return MovementPacket::PlayerLook;
+		case 0x1F: return MovementPacket::Player;
+		default:   return MovementPacket::None;
+	}
+}
+
+
+
+
+
 void cProtocol_1_21_2::SendLogin(const cPlayer & a_Player, const cWorld & a_World)
 {
 	// Send the Join Game packet:
@@ -1445,7 +1461,17 @@ void cProtocol_1_21_2::SendEntityPosition(const cEntity & a_Entity)
 		return;
 	}
 
-	// Too big or small a movement, do a teleport.
+	// Too big or small a movement, do a teleport:
+	SendEntityTeleport(a_Entity);
+}
+
+
+
+
+
+void cProtocol_1_21_2::SendEntityTeleport(const cEntity & a_Entity)
+{
+	ASSERT(m_State == 3);  // In game mode?
 
 	cPacketizer Pkt(*this, pktTeleportEntity);
 	Pkt.WriteVarInt32(a_Entity.GetUniqueID());
@@ -50,6 +50,7 @@ protected:
 	virtual void SendLogin(const cPlayer & a_Player, const cWorld & a_World) override;
 	virtual void SendPlayerMoveLook(const Vector3d a_Pos, const float a_Yaw, const float a_Pitch, const bool a_IsRelative) override;
 	virtual void SendEntityPosition(const cEntity & a_Entity) override;
+	virtual void SendEntityTeleport(const cEntity & a_Entity) override;
 	virtual void SendDynamicRegistries() override;
 	virtual void SendInventorySlot(char a_WindowID, short a_SlotNum, const cItem & a_Item) override;
 	virtual void SendRespawn(eDimension a_Dimension) override;
@@ -59,6 +60,7 @@ protected:
 	virtual void HandlePacketClientSettings(cByteBuffer & a_ByteBuffer) override;
 	virtual void HandlePacketSteerVehicle(cByteBuffer & a_ByteBuffer) override;
 	virtual bool HandlePacket(cByteBuffer & a_ByteBuffer, UInt32 a_PacketType) override;
+	virtual MovementPacket GetMovementPacket(UInt32 a_PacketType) const override;
 
 	virtual UInt32 GetProtocolBlockType(BlockState a_Block) const override;
 	virtual UInt32 GetProtocolItemType(Item a_ItemID) const override;
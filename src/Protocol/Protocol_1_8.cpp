@@ -167,6 +167,61 @@ void cProtocol_1_8_0::DataPrepared(ContiguousByteBuffer & a_Data)
 
 
 
+bool cProtocol_1_8_0::CanDecodeOffTick(void) const
+{
+	// The comm log is written in the order the packets are handled, so it needs everything in the tick thread:
+	return (m_State == State::Game) && !g_ShouldLogCommIn;
+}
+
+
+
+
+
+void cProtocol_1_8_0::DecodeReceivedData(cByteBuffer & a_Buffer, ContiguousByteBuffer & a_Data, cInboundCommandQueue & a_Commands)
+{
+	if (m_IsEncrypted)
+	{
+		m_Decryptor.ProcessData(a_Data.data(), a_Data.size());
+	}
+
+	if (!a_Buffer.Write(a_Data.data(), a_Data.size()))
+	{
+		a_Commands.SetError("The server is busy; please try again later.");
+		return;
+	}
+
+	m_PacketSplitter.DecodeInto(a_Buffer, a_Commands, [this](const ContiguousByteBufferView a_Packet, cInboundCommandQueue::sMovement & a_Movement)
+	{
+		cByteBuffer bb(a_Packet.size());
+		VERIFY(bb.Write(a_Packet.data(), a_Packet.size()));
+		UInt32 PacketType;
+		return bb.ReadVarInt(PacketType) && ReadMovementPacket(bb, GetMovementPacket(PacketType), a_Movement);
+	});
+}
+
+
+
+
+
+void cProtocol_1_8_0::HandleInboundCommands(const cInboundCommandQueue & a_Commands)
+{
+	for (const auto & Command: a_Commands.GetCommands())
+	{
+		if (const auto Movement = std::get_if<cInboundCommandQueue::sMovement>(&Command))
+		{
+			HandleInboundMovement(*Movement);
+		}
+		else
+		{
+			HandlePacket(a_Commands.GetPacketData(std::get<cInboundCommandQueue::sPacket>(Command)));
+		}
+	}
+}
+
+
+
+
+
 void cProtocol_1_8_0::SendAcknowledgeBlockChange(int a_SequenceId)
 {
 	// used in 1.19+
@@ -675,7 +730,17 @@ void cProtocol_1_8_0::SendEntityPosition(const cEntity & a_Entity)
 		return;
 	}
 
-	// Too big or small a movement, do a teleport.
+	// Too big or small a movement, do a teleport:
+	SendEntityTeleport(a_Entity);
+}
+
+
+
+
+
+void cProtocol_1_8_0::SendEntityTeleport(const cEntity & a_Entity)
+{
+	ASSERT(m_State == 3);  // In game mode?
 
 	cPacketizer Pkt(*this, pktTeleportEntity);
 	Pkt.WriteVarInt32(a_Entity.GetUniqueID());
@@ -2146,6 +2211,22 @@ UInt32 cProtocol_1_8_0::GetPacketID(ePacketType a_PacketType) const
 
 
 
+cProtocol_1_8_0::MovementPacket cProtocol_1_8_0::GetMovementPacket(UInt32 a_PacketType) const
+{
+	switch (a_PacketType)
+	{
+		case 0x03: return MovementPacket::Player;
+		case 0x04: return MovementPacket::PlayerPos;
+		case 0x05: return MovementPacket::PlayerLook;
+		case 0x06: return MovementPacket::PlayerPosLook;
+		default:   return MovementPacket::None;
+	}
+}
+
+
+
+
+
 unsigned char cProtocol_1_8_0::GetProtocolEntityAnimation(const EntityAnimation a_Animation) const
 {
 	switch (a_Animation)
@@ -2815,6 +2896,26 @@ void cProtocol_1_8_0::HandlePacketPlayerPosLook(cByteBuffer & a_ByteBuffer)
 
 
 
+void cProtocol_1_8_0::HandleInboundMovement(const cInboundCommandQueue::sMovement & a_Movement)
+{
+	if (a_Movement.m_HasPosition && a_Movement.m_HasLook)
+	{
+		m_Client->HandlePlayerMoveLook(a_Movement.m_Position, a_Movement.m_Yaw, a_Movement.m_Pitch, a_Movement.m_IsOnGround);
+	}
+	else if (a_Movement.m_HasPosition)
+	{
+		m_Client->HandlePlayerMove(a_Movement.m_Position, a_Movement.m_IsOnGround);
+	}
+	else if (a_Movement.m_HasLook)
+	{
+		m_Client->HandlePlayerLook(a_Movement.m_Yaw, a_Movement.m_Pitch, a_Movement.m_IsOnGround);
+	}
+}
+
+
+
+
+
 void cProtocol_1_8_0::HandlePacketPluginMessage(cByteBuffer & a_ByteBuffer)
 {
 	// https://wiki.vg/index.php?title=Plugin_channels&oldid=14089#MC.7CAdvCmd
@@ -3184,7 +3285,7 @@ void cProtocol_1_8_0::ParseItemMetadata(cItem & a_Item, const ContiguousByteBuff
 			{
 				if ((TagName == "ench") || (TagName == "StoredEnchantments"))  // Enchantments tags
 				{
-					EnchantmentSerializer::ParseFromNBT(a_Item.m_Enchantments, NBT, tag);
+					EnchantmentSerializer::ParseFromNBT(a_Item.ModifyEnchantments(), NBT, tag);
 				}
 				break;
 			}
@@ -3196,24 +3297,24 @@ void cProtocol_1_8_0::ParseItemMetadata(cItem & a_Item, const ContiguousByteBuff
 					{
 						if ((NBT.GetType(displaytag) == TAG_String) && (NBT.GetName(displaytag) == "Name"))  // Custon name tag
 						{
-							a_Item.m_CustomName = NBT.GetString(displaytag);
+							a_Item.SetCustomName(NBT.GetString(displaytag));
 						}
 						else if ((NBT.GetType(displaytag) == TAG_List) && (NBT.GetName(displaytag) == "Lore"))  // Lore tag
 						{
 							for (int loretag = NBT.GetFirstChild(displaytag); loretag >= 0; loretag = NBT.GetNextSibling(loretag))  // Loop through array of strings
 							{
-								a_Item.m_LoreTable.push_back(NBT.GetString(loretag));
+								a_Item.ModifyLoreTable().push_back(NBT.GetString(loretag));
 							}
 						}
 						else if ((NBT.GetType(displaytag) == TAG_Int) && (NBT.GetName(displaytag) == "color"))
 						{
-							a_Item.m_ItemColor.m_Color = static_cast<unsigned int>(NBT.GetInt(displaytag));
+							a_Item.ModifyItemColor().m_Color = static_cast<unsigned int>(NBT.GetInt(displaytag));
 						}
 					}
 				}
 				else if ((TagName == "Fireworks") || (TagName == "Explosion"))
 				{
-					cFireworkItem::ParseFromNBT(a_Item.m_FireworkItem, NBT, tag, a_Item.m_ItemType);
+					cFireworkItem::ParseFromNBT(a_Item.ModifyFireworkItem(), NBT, tag, a_Item.m_ItemType);
 				}
 				break;
 			}
@@ -3221,7 +3322,7 @@ void cProtocol_1_8_0::ParseItemMetadata(cItem & a_Item, const ContiguousByteBuff
 			{
 				if (TagName == "RepairCost")
 				{
-					a_Item.m_RepairCost = NBT.GetInt(tag);
+					a_Item.SetRepairCost(NBT.GetInt(tag));
 				}
 				break;
 			}
@@ -3734,7 +3835,7 @@ void cProtocol_1_8_0::WriteItem(cPacketizer & a_Pkt, const cItem & a_Item) const
 	a_Pkt.WriteBEInt8(a_Item.m_ItemCount);
 	a_Pkt.WriteBEInt16(a_Item.m_ItemDamage);
 
-	if (a_Item.m_Enchantments.IsEmpty() && a_Item.IsBothNameAndLoreEmpty() && (a_Item.m_ItemType != Item::FireworkRocket) && (a_Item.m_ItemType != Item::FireworkStar) && !a_Item.m_ItemColor.IsValid())
+	if (a_Item.GetEnchantments().IsEmpty() && a_Item.IsBothNameAndLoreEmpty() && (a_Item.m_ItemType != Item::FireworkRocket) && (a_Item.m_ItemType != Item::FireworkStar) && !a_Item.GetItemColor().IsValid())
 	{
 		a_Pkt.WriteBEInt8(0);
 		return;
@@ -3743,32 +3844,32 @@ void cProtocol_1_8_0::WriteItem(cPacketizer & a_Pkt, const cItem & a_Item) const
 
 	// Send the enchantments and custom names:
 	cFastNBTWriter Writer;
-	if (a_Item.m_RepairCost != 0)
+	if (a_Item.GetRepairCost() != 0)
 	{
-		Writer.AddInt("RepairCost", a_Item.m_RepairCost);
+		Writer.AddInt("RepairCost", a_Item.GetRepairCost());
 	}
-	if (!a_Item.m_Enchantments.IsEmpty())
+	if (!a_Item.GetEnchantments().IsEmpty())
 	{
 		const char * TagName = (a_Item.m_ItemType == Item::EnchantedBook) ? "StoredEnchantments" : "ench";
-		EnchantmentSerializer::WriteToNBTCompound(a_Item.m_Enchantments, Writer, TagName, false);
+		EnchantmentSerializer::WriteToNBTCompound(a_Item.GetEnchantments(), Writer, TagName, false);
 	}
-	if (!a_Item.IsBothNameAndLoreEmpty() || a_Item.m_ItemColor.IsValid())
+	if (!a_Item.IsBothNameAndLoreEmpty() || a_Item.GetItemColor().IsValid())
 	{
 		Writer.BeginCompound("display");
-		if (a_Item.m_ItemColor.IsValid())
+		if (a_Item.GetItemColor().IsValid())
 		{
-			Writer.AddInt("color", static_cast<Int32>(a_Item.m_ItemColor.m_Color));
+			Writer.AddInt("color", static_cast<Int32>(a_Item.GetItemColor().m_Color));
 		}
 
 		if (!a_Item.IsCustomNameEmpty())
 		{
-			Writer.AddString("Name", a_Item.m_CustomName);
+			Writer.AddString("Name", a_Item.GetCustomName());
 		}
 		if (!a_Item.IsLoreEmpty())
 		{
 			Writer.BeginList("Lore", TAG_String);
 
-			for (const auto & Line : a_Item.m_LoreTable)
+			for (const auto & Line : a_Item.GetLoreTable())
 			{
 				Writer.AddString("", Line);
 			}
@@ -3779,7 +3880,7 @@ void cProtocol_1_8_0::WriteItem(cPacketizer & a_Pkt, const cItem & a_Item) const
 	}
 	if ((a_Item.m_ItemType == Item::FireworkRocket) || (a_Item.m_ItemType == Item::FireworkStar))
 	{
-		cFireworkItem::WriteToNBTCompound(a_Item.m_FireworkItem, Writer, a_Item.m_ItemType);
+		cFireworkItem::WriteToNBTCompound(a_Item.GetFireworkItem(), Writer, a_Item.m_ItemType);
 	}
 	Writer.Finish();
 
@@ -4160,65 +4261,11 @@ void cProtocol_1_8_0::AddReceivedData(cByteBuffer & a_Buffer, const ContiguousBy
 	}
 
 	// Handle all complete packets:
-	for (;;)
+	if (!m_PacketSplitter.Split(a_Buffer, (m_State == 3) || m_CompressionEnabled, [this](const ContiguousByteBufferView a_Packet) { HandlePacket(a_Packet); }))
 	{
-		UInt32 PacketLen;
-		if (!a_Buffer.ReadVarInt(PacketLen))
-		{
-			// Not enough data
-			a_Buffer.ResetRead();
-			break;
-		}
-		if (!a_Buffer.CanReadBytes(PacketLen))
-		{
-			// The full packet hasn't been received yet
-			a_Buffer.ResetRead();
-			break;
-		}
-
-		// Check packet for compression:
-		if ((m_State == 3) || m_CompressionEnabled)
-		{
-			UInt32 NumBytesRead = static_cast<UInt32>(a_Buffer.GetReadableSpace());
-
-			UInt32 UncompressedSize;
-			if (!a_Buffer.ReadVarInt(UncompressedSize))
-			{
-				m_Client->Kick("Compression packet incomplete");
-				return;
-			}
-
-			NumBytesRead -= static_cast<UInt32>(a_Buffer.GetReadableSpace());  // How many bytes has the UncompressedSize taken up?
-			ASSERT(PacketLen > NumBytesRead);
-			PacketLen -= NumBytesRead;
-
-			if (UncompressedSize > 0)
-			{
-				// Decompress the data:
-				m_Extractor.ReadFrom(a_Buffer, PacketLen);
-				a_Buffer.CommitRead();
-
-				const auto UncompressedData = m_Extractor.Extract(UncompressedSize);
-				const auto Uncompressed = UncompressedData.GetView();
-				cByteBuffer bb(Uncompressed.size());
-
-				// Compression was used, move the uncompressed data:
-				VERIFY(bb.Write(Uncompressed.data(), Uncompressed.size()));
-
-				HandlePacket(bb);
-				continue;
-			}
-		}
-
-		// Move the packet payload to a separate cByteBuffer, bb:
-		cByteBuffer bb(PacketLen);
-
-		// No compression was used, move directly:
-		VERIFY(a_Buffer.ReadToByteBuffer(bb, static_cast<size_t>(PacketLen)));
-		a_Buffer.CommitRead();
-
-		HandlePacket(bb);
-	}  // for (ever)
+		m_Client->Kick("Compression packet incomplete");
+		return;
+	}
 
 	// Log any leftover bytes into the logfile:
 	if (g_ShouldLogCommIn && (a_Buffer.GetReadableSpace() > 0) && m_CommLogFile.IsOpen())
@@ -4243,6 +4290,42 @@ void cProtocol_1_8_0::AddReceivedData(cByteBuffer & a_Buffer, const ContiguousBy
 
 
 
+bool cProtocol_1_8_0::ReadMovementPacket(cByteBuffer & a_Buffer, const MovementPacket a_Kind, cInboundCommandQueue::sMovement & a_Movement)
+{
+	a_Movement.m_HasPosition = ((a_Kind == MovementPacket::PlayerPos) || (a_Kind == MovementPacket::PlayerPosLook));
+	a_Movement.m_HasLook = ((a_Kind == MovementPacket::PlayerLook) || (a_Kind == MovementPacket::PlayerPosLook));
+	if (a_Kind == MovementPacket::None)
+	{
+		return false;
+	}
+	if (
+		a_Movement.m_HasPosition && (
+			!a_Buffer.ReadBEDouble(a_Movement.m_Position.x) ||
+			!a_Buffer.ReadBEDouble(a_Movement.m_Position.y) ||
+			!a_Buffer.ReadBEDouble(a_Movement.m_Position.z)
+		)
+	)
+	{
+		return false;
+	}
+	if (
+		a_Movement.m_HasLook && (
+			!a_Buffer.ReadBEFloat(a_Movement.m_Yaw) ||
+			!a_Buffer.ReadBEFloat(a_Movement.m_Pitch)
+		)
+	)
+	{
+		return false;
+	}
+
+	// Anything malformed is left for the regular handlers to report:
+	return a_Buffer.ReadBool(a_Movement.m_IsOnGround) && (a_Buffer.GetReadableSpace() == 0);
+}
+
+
+
+
+
 UInt8 cProtocol_1_8_0::GetProtocolEntityType(const cEntity & a_Entity) const
 {
 	using Type = cEntity::eEntityType;
@@ -4466,6 +4549,17 @@ const char * cProtocol_1_8_0::GetProtocolStatisticName(const CustomStatistic a_S
 
 
 
+void cProtocol_1_8_0::HandlePacket(const ContiguousByteBufferView a_Packet)
+{
+	cByteBuffer bb(a_Packet.size());
+	VERIFY(bb.Write(a_Packet.data(), a_Packet.size()));
+	HandlePacket(bb);
+}
+
+
+
+
+
 void cProtocol_1_8_0::HandlePacket(cByteBuffer & a_Buffer)
 {
 	UInt32 PacketType;
@@ -14,6 +14,8 @@ Declares the 1.8 protocol classes:
 #pragma once
 
 #include "Protocol.h"
+#include "InboundCommandQueue.h"
+#include "ReceivedPacketSplitter.h"
 #include "../ByteBuffer.h"
 #include "../Registries/CustomStatistics.h"
 
@@ -38,6 +40,9 @@ public:
 
 	virtual void DataReceived(cByteBuffer & a_Buffer, ContiguousByteBuffer & a_Data) override;
 	virtual void DataPrepared(ContiguousByteBuffer & a_Data) override;
+	virtual bool CanDecodeOffTick(void) const override;
+	virtual void DecodeReceivedData(cByteBuffer & a_Buffer, ContiguousByteBuffer & a_Data, cInboundCommandQueue & a_Commands) override;
+	virtual void HandleInboundCommands(const cInboundCommandQueue & a_Commands) override;
 
 	// Sending stuff to clients (alphabetically sorted):
 	virtual void SendAcknowledgeBlockChange     (int a_SequenceId) override;
@@ -73,6 +78,7 @@ public:
 	virtual void SendEntityMetadata             (const cEntity & a_Entity) override;
 	virtual void SendEntityPosition             (const cEntity & a_Entity) override;
 	virtual void SendEntityProperties           (const cEntity & a_Entity) override;
+	virtual void SendEntityTeleport             (const cEntity & a_Entity) override;
 	virtual void SendEntityVelocity             (const cEntity & a_Entity) override;
 	virtual void SendExperience                 (void) override;
 	virtual void SendExperienceOrb              (const cExpOrb & a_ExpOrb) override;
@@ -155,6 +161,16 @@ protected:
 	/** State of the protocol. */
 	State m_State;
 
+	/** The movement packets in the Game state, parsed in the network thread so that they can be merged. */
+	enum class MovementPacket
+	{
+		None,           // Not a movement packet
+		Player,         // On-ground flag only
+		PlayerPos,
+		PlayerLook,
+		PlayerPosLook,
+	};
+
 	/** Converts the BlockFace received by the protocol into eBlockFace constants.
 	If the received value doesn't match any of our eBlockFace constants, BLOCK_FACE_NONE is returned. */
 	static eBlockFace FaceIntToBlockFace(Int32 a_FaceInt);
@@ -162,6 +178,10 @@ protected:
 	/** Get the packet ID for a given packet. */
 	virtual UInt32 GetPacketID(ePacketType a_Packet) const override;
 
+	/** Returns which movement packet the protocol-specific packet ID in the Game state is, MovementPacket::None for other packets.
+	Called in the network thread, so it must not depend on anything but the ID. */
+	virtual MovementPacket GetMovementPacket(UInt32 a_PacketType) const;
+
 	/** Converts an animation into an ID suitable for use with the Entity Animation packet.
 	Returns (uchar)-1 if the protocol version doesn't support this animation. */
 	virtual unsigned char GetProtocolEntityAnimation(EntityAnimation a_Animation) const;
@@ -229,6 +249,10 @@ protected:
 	virtual void HandlePacketWindowClose            (cByteBuffer & a_ByteBuffer);
 	virtual void HandlePacketBookUpdate             (cByteBuffer & a_ByteBuffer);
 	virtual void HandlePacketCommandExecution       (cByteBuffer & a_ByteBuffer);
+
+	/** Applies the (possibly merged) movement packets that were parsed in the network thread. */
+	virtual void HandleInboundMovement(const cInboundCommandQueue::sMovement & a_Movement);
+
 	/** Parses Vanilla plugin messages into specific ClientHandle calls.
 	The message payload is still in the bytebuffer, the handler reads it specifically for each handled channel. */
 	virtual void HandleVanillaPluginMessage(cByteBuffer & a_ByteBuffer, std::string_view a_Channel);
@@ -276,14 +300,19 @@ private:
 	cAesCfb128Encryptor m_Encryptor;
 
 	CircularBufferCompressor m_Compressor;
-	CircularBufferExtractor m_Extractor;
 
 	/** The logfile where the comm is logged, when g_ShouldLogComm is true */
 	cFile m_CommLogFile;
 
+	/** Splits the received data into packets, both in the tick thread and off-tick. */
+	cReceivedPacketSplitter m_PacketSplitter;
+
 	/** Adds the received (unencrypted) data to m_ReceivedData, parses complete packets */
 	void AddReceivedData(cByteBuffer & a_Buffer, ContiguousByteBufferView a_Data);
 
+	/** Parses the movement packet, without the type, into a_Movement. Returns false if the packet has a different length. */
+	static bool ReadMovementPacket(cByteBuffer & a_Buffer, MovementPacket a_Kind, cInboundCommandQueue::sMovement & a_Movement);
+
 	/** Converts a statistic to a protocol-specific string.
 	Protocols <= 1.12 use strings, hence this is a static as the string-mapping was append-only for the versions that used it.
 	Returns an empty string, handled correctly by the client, for newer, unsupported statistics. */
@@ -291,4 +320,7 @@ private:
 
 	/** Handle a complete packet stored in the given buffer. */
 	void HandlePacket(cByteBuffer & a_Buffer);
+
+	/** Handle a complete packet, given its data (type and payload). */
+	void HandlePacket(ContiguousByteBufferView a_Packet);
 } ;
@@ -345,7 +345,17 @@ void cProtocol_1_9_0::SendEntityPosition(const cEntity & a_Entity)
 		return;
 	}
 
-	// Too big or small a movement, do a teleport.
+	// Too big or small a movement, do a teleport:
+	SendEntityTeleport(a_Entity);
+}
+
+
+
+
+
+void cProtocol_1_9_0::SendEntityTeleport(const cEntity & a_Entity)
+{
+	ASSERT(m_State == 3);  // In game mode?
 
 	cPacketizer Pkt(*this, pktTeleportEntity);
 	Pkt.WriteVarInt32(a_Entity.GetUniqueID());
@@ -872,6 +882,22 @@ bool cProtocol_1_9_0::HandlePacket(cByteBuffer & a_ByteBuffer, UInt32 a_PacketTy
 
 
 
+cProtocol_1_9_0::MovementPacket cProtocol_1_9_0::GetMovementPacket(UInt32 a_PacketType) const
+{
+	switch (a_PacketType)
+	{
+		case 0x0c: return MovementPacket::PlayerPos;
+		case 0x0d: return MovementPacket::PlayerPosLook;
+		case 0x0e: return MovementPacket::PlayerLook;
+		case 0x0f: return MovementPacket::Player;
+		default:   return MovementPacket::None;
+	}
+}
+
+
+
+
+
 void cProtocol_1_9_0::HandlePacketAnimation(cByteBuffer & a_ByteBuffer)
 {
 	HANDLE_READ(a_ByteBuffer, ReadVarInt, Int32, Hand);
@@ -1044,6 +1070,25 @@ void cProtocol_1_9_0::HandlePacketPlayerPosLook(cByteBuffer & a_ByteBuffer)
 
 
 
+void cProtocol_1_9_0::HandleInboundMovement(const cInboundCommandQueue::sMovement & a_Movement)
+{
+	// Until the client confirms the last teleport, the packets with a position are ignored as a whole, same as in
+	// HandlePacketPlayerPos() and HandlePacketPlayerPosLook(). The merged movement doesn't tell which of its packets had the look,
+	// so its look is dropped together with the position, and only the look-only movements are applied:
+	if (m_IsTeleportIdConfirmed)
+	{
+		Super::HandleInboundMovement(a_Movement);
+	}
+	else if (a_Movement.m_HasLook && !a_Movement.m_HasPosition)
+	{
+		m_Client->HandlePlayerLook(a_Movement.m_Yaw, a_Movement.m_Pitch, a_Movement.m_IsOnGround);
+	}
+}
+
+
+
+
+
 void cProtocol_1_9_0::HandlePacketSteerVehicle(cByteBuffer & a_ByteBuffer)
 {
 	HANDLE_READ(a_ByteBuffer, ReadBEFloat, float, Sideways);
@@ -1323,7 +1368,7 @@ void cProtocol_1_9_0::ParseItemMetadata(cItem & a_Item, const ContiguousByteBuff
 			{
 				if ((TagName == "ench") || (TagName == "StoredEnchantments") || (TagName == "Enchantments"))  // Enchantments tags
 				{
-					EnchantmentSerializer::ParseFromNBT(a_Item.m_Enchantments, NBT, tag);
+					EnchantmentSerializer::ParseFromNBT(a_Item.ModifyEnchantments(), NBT, tag);
 				}
 				break;
 			}
@@ -1335,25 +1380,25 @@ void cProtocol_1_9_0::ParseItemMetadata(cItem & a_Item, const ContiguousByteBuff
 					{
 						if ((NBT.GetType(displaytag) == TAG_String) && (NBT.GetName(displaytag) == "Name"))  // Custon name tag
 						{
-							a_Item.m_CustomName = NBT.GetString(displaytag);
+							a_Item.SetCustomName(NBT.GetString(displaytag));
 						}
 						else if ((NBT.GetType(displaytag) == TAG_List) && (NBT.GetName(displaytag) == "Lore"))  // Lore tag
 						{
-							a_Item.m_LoreTable.clear();
+							a_Item.ModifyLoreTable().clear();
 							for (int loretag = NBT.GetFirstChild(displaytag); loretag >= 0; loretag = NBT.GetNextSibling(loretag))  // Loop through array of strings
 							{
-								a_Item.m_LoreTable.push_back(NBT.GetString(loretag));
+								a_Item.ModifyLoreTable().push_back(NBT.GetString(loretag));
 							}
 						}
 						else if ((NBT.GetType(displaytag) == TAG_Int) && (NBT.GetName(displaytag) == "color"))
 						{
-							a_Item.m_ItemColor.m_Color = static_cast<unsigned int>(NBT.GetInt(displaytag));
+							a_Item.ModifyItemColor().m_Color = static_cast<unsigned int>(NBT.GetInt(displaytag));
 						}
 					}
 				}
 				else if ((TagName == "Fireworks") || (TagName == "Explosion"))
 				{
-					cFireworkItem::ParseFromNBT(a_Item.m_FireworkItem, NBT, tag, a_Item.m_ItemType);
+					cFireworkItem::ParseFromNBT(a_Item.ModifyFireworkItem(), NBT, tag, a_Item.m_ItemType);
 				}
 				else if (TagName == "EntityTag")
 				{
@@ -1375,7 +1420,7 @@ void cProtocol_1_9_0::ParseItemMetadata(cItem & a_Item, const ContiguousByteBuff
 			{
 				if (TagName == "RepairCost")
 				{
-					a_Item.m_RepairCost = NBT.GetInt(tag);
+					a_Item.SetRepairCost(NBT.GetInt(tag));
 				}
 				break;
 			}
@@ -1824,11 +1869,11 @@ void cProtocol_1_9_0::WriteItem(cPacketizer & a_Pkt, const cItem & a_Item) const
 	}
 
 	if (
-		a_Item.m_Enchantments.IsEmpty() &&
+		a_Item.GetEnchantments().IsEmpty() &&
 		a_Item.IsBothNameAndLoreEmpty() &&
 		(a_Item.m_ItemType != Item::FireworkRocket) &&
 		(a_Item.m_ItemType != Item::FireworkStar) &&
-		!a_Item.m_ItemColor.IsValid() &&
+		!a_Item.GetItemColor().IsValid() &&
 		(a_Item.m_ItemType != Item::Potion) &&
 		(cItemSpawnEggHandler::IsSpawnEgg(a_Item.m_ItemType)))
 	{
@@ -1839,32 +1884,32 @@ void cProtocol_1_9_0::WriteItem(cPacketizer & a_Pkt, const cItem & a_Item) const
 
 	// Send the enchantments and custom names:
 	cFastNBTWriter Writer;
-	if (a_Item.m_RepairCost != 0)
+	if (a_Item.GetRepairCost() != 0)
 	{
-		Writer.AddInt("RepairCost", a_Item.m_RepairCost);
+		Writer.AddInt("RepairCost", a_Item.GetRepairCost());
 	}
-	if (!a_Item.m_Enchantments.IsEmpty())
+	if (!a_Item.GetEnchantments().IsEmpty())
 	{
 		const char * TagName = (a_Item.m_ItemType == Item::EnchantedBook) ? "StoredEnchantments" : "ench";
-		EnchantmentSerializer::WriteToNBTCompound(a_Item.m_Enchantments, Writer, TagName, false);
+		EnchantmentSerializer::WriteToNBTCompound(a_Item.GetEnchantments(), Writer, TagName, false);
 	}
-	if (!a_Item.IsBothNameAndLoreEmpty() || a_Item.m_ItemColor.IsValid())
+	if (!a_Item.IsBothNameAndLoreEmpty() || a_Item.GetItemColor().IsValid())
 	{
 		Writer.BeginCompound("display");
-		if (a_Item.m_ItemColor.IsValid())
+		if (a_Item.GetItemColor().IsValid())
 		{
-			Writer.AddInt("color", static_cast<Int32>(a_Item.m_ItemColor.m_Color));
+			Writer.AddInt("color", static_cast<Int32>(a_Item.GetItemColor().m_Color));
 		}
 
 		if (!a_Item.IsCustomNameEmpty())
 		{
-			Writer.AddString("Name", a_Item.m_CustomName);
+			Writer.AddString("Name", a_Item.GetCustomName());
 		}
 		if (!a_Item.IsLoreEmpty())
 		{
 			Writer.BeginList("Lore", TAG_String);
 
-			for (const auto & Line : a_Item.m_LoreTable)
+			for (const auto & Line : a_Item.GetLoreTable())
 			{
 				Writer.AddString("", Line);
 			}
@@ -1875,7 +1920,7 @@ void cProtocol_1_9_0::WriteItem(cPacketizer & a_Pkt, const cItem & a_Item) const
 	}
 	if ((a_Item.m_ItemType == Item::FireworkRocket) || (a_Item.m_ItemType == Item::FireworkStar))
 	{
-		cFireworkItem::WriteToNBTCompound(a_Item.m_FireworkItem, Writer, a_Item.m_ItemType);
+		cFireworkItem::WriteToNBTCompound(a_Item.GetFireworkItem(), Writer, a_Item.m_ItemType);
 	}
 
 	switch (a_Item.m_ItemType)
@@ -46,6 +46,7 @@ public:
 	virtual void SendEntityEquipment      (const cEntity & a_Entity, short a_SlotNum, const cItem & a_Item) override;
 	virtual void SendEntityMetadata       (const cEntity & a_Entity) override;
 	virtual void SendEntityPosition       (const cEntity & a_Entity) override;
+	virtual void SendEntityTeleport       (const cEntity & a_Entity) override;
 	virtual void SendExperienceOrb        (const cExpOrb & a_ExpOrb) override;
 	virtual void SendKeepAlive            (UInt32 a_PingID) override;
 	virtual void SendLeashEntity          (const cEntity & a_Entity, const cEntity & a_EntityLeashedTo) override;
@@ -70,6 +71,7 @@ protected:
 	UInt32 m_OutstandingTeleportId;
 
 	virtual UInt32 GetPacketID(ePacketType a_Packet) const override;
+	virtual MovementPacket GetMovementPacket(UInt32 a_PacketType) const override;
 	virtual unsigned char GetProtocolEntityAnimation(EntityAnimation a_Animation) const override;
 	virtual signed char GetProtocolEntityStatus(EntityAnimation a_Animation) const override;
 	virtual UInt32 GetProtocolMobType(eMonsterType a_MobType) const override;
@@ -93,6 +95,7 @@ protected:
 	virtual void HandlePacketVehicleMove            (cByteBuffer & a_ByteBuffer);
 	virtual void HandlePacketWindowClick            (cByteBuffer & a_ByteBuffer) override;
 	virtual void HandleVanillaPluginMessage         (cByteBuffer & a_ByteBuffer, std::string_view a_Channel) override;
+	virtual void HandleInboundMovement              (const cInboundCommandQueue::sMovement & a_Movement) override;
 
 	virtual void ParseItemMetadata(cItem & a_Item, ContiguousByteBufferView a_Metadata) const override;
 	virtual void SendEntitySpawn(const cEntity & a_Entity, const UInt8 a_ObjectType, const Int32 a_ObjectData) override;
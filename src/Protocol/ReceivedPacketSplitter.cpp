@@ -0,0 +1,101 @@
+// ReceivedPacketSplitter.cpp
+
+// Implements the cReceivedPacketSplitter class that splits the received data into packets and decompresses them
+
+#include "Globals.h"
+#include "ReceivedPacketSplitter.h"
+#include "../ByteBuffer.h"
+
+
+
+
+
+bool cReceivedPacketSplitter::Split(cByteBuffer & a_Buffer, const bool a_IsCompressed, cFunctionRef<void(ContiguousByteBufferView)> a_OnPacket)
+{
+	for (;;)
+	{
+		UInt32 PacketLen;
+		if (!a_Buffer.ReadVarInt(PacketLen))
+		{
+			// Not enough data
+			a_Buffer.ResetRead();
+			return true;
+		}
+		if (!a_Buffer.CanReadBytes(PacketLen))
+		{
+			// The full packet hasn't been received yet
+			a_Buffer.ResetRead();
+			return true;
+		}
+
+		// Check packet for compression:
+		if (a_IsCompressed)
+		{
+			UInt32 NumBytesRead = static_cast<UInt32>(a_Buffer.GetReadableSpace());
+
+			UInt32 UncompressedSize;
+			if (!a_Buffer.ReadVarInt(UncompressedSize))
+			{
+				return false;
+			}
+
+			NumBytesRead -= static_cast<UInt32>(a_Buffer.GetReadableSpace());  // How many bytes has the UncompressedSize taken up?
+			ASSERT(PacketLen > NumBytesRead);
+			PacketLen -= NumBytesRead;
+
+			if (UncompressedSize > 0)
+			{
+				// Decompress the data:
+				m_Extractor.ReadFrom(a_Buffer, PacketLen);
+				a_Buffer.CommitRead();
+
+				const auto UncompressedData = m_Extractor.Extract(UncompressedSize);
+				a_OnPacket(UncompressedData.GetView());
+				continue;
+			}
+		}
+
+		// No compression was used, move the packet out of the ringbuffer:
+		VERIFY(a_Buffer.ReadSome(m_ReceivedPacket, static_cast<size_t>(PacketLen)));
+		a_Buffer.CommitRead();
+
+		a_OnPacket(m_ReceivedPacket);
+	}  // for (ever)
+}
+
+
+
+
+
+void cReceivedPacketSplitter::DecodeInto(cByteBuffer & a_Buffer, cInboundCommandQueue & a_Commands, cParseMovement a_ParseMovement)
+{
+	const bool IsValid = Split(a_Buffer, true, [&a_Commands, &a_ParseMovement](const ContiguousByteBufferView a_Packet)
+	{
+		if (a_Commands.HasError())
+		{
+			return;
+		}
+
+		// Parse the movement packets, so that they can be merged:
+		cInboundCommandQueue::sMovement Movement;
+		if (a_ParseMovement(a_Packet, Movement))
+		{
+			// The on-ground-only packets are not used for anything, drop them right here:
+			if ((Movement.m_HasPosition || Movement.m_HasLook) && !a_Commands.PushMovement(Movement))
+			{
+				a_Commands.SetError("Too many packets");
+			}
+			return;
+		}
+
+		// Everything else is parsed in the tick thread:
+		if (!a_Commands.PushPacket(a_Packet))
+		{
+			a_Commands.SetError("Too many packets");
+		}
+	});
+	if (!IsValid)
+	{
+		a_Commands.SetError("Compression packet incomplete");
+	}
+}
@@ -0,0 +1,52 @@
+// ReceivedPacketSplitter.h
+
+// Declares the cReceivedPacketSplitter class that splits the received data into packets and decompresses them
+
+
+
+
+
+#pragma once
+
+#include "InboundCommandQueue.h"
+#include "../CircularBufferCompressor.h"
+#include "../FunctionRef.h"
+
+
+
+
+
+class cByteBuffer;
+
+
+
+
+
+/** Splits the received (decrypted) data into the individual packets, decompressing them as needed.
+Keeps the decompressor and the last uncompressed packet between the calls, to reuse their allocations.
+Used by the protocol both in the tick thread and, through DecodeInto(), in the network thread. */
+class cReceivedPacketSplitter
+{
+public:
+
+	/** Returns true and fills a_Movement if the packet data (type and payload) is a movement packet. */
+	using cParseMovement = cFunctionRef<bool(ContiguousByteBufferView, cInboundCommandQueue::sMovement &)>;
+
+
+	/** Splits the complete packets off a_Buffer and calls a_OnPacket with the data (type and payload) of each one.
+	a_IsCompressed specifies that the packets have the compressed format (the uncompressed size before the data, 0 if not compressed).
+	Returns false if a packet is malformed, the rest of the data is left unprocessed. */
+	bool Split(cByteBuffer & a_Buffer, bool a_IsCompressed, cFunctionRef<void(ContiguousByteBufferView)> a_OnPacket);
+
+	/** Splits the complete compressed-format packets off a_Buffer into a_Commands.
+	The movement packets, recognized by a_ParseMovement, are pushed as movements so that they can be merged, the on-ground-only
+	ones are dropped. Sets the queue's error if a packet is malformed or the queue's limits are reached. */
+	void DecodeInto(cByteBuffer & a_Buffer, cInboundCommandQueue & a_Commands, cParseMovement a_ParseMovement);
+
+protected:
+
+	CircularBufferExtractor m_Extractor;
+
+	/** The packet last split off the received data, when it wasn't compressed. Kept to reuse the allocation. */
+	ContiguousByteBuffer m_ReceivedPacket;
+} ;
@@ -175,6 +175,15 @@ bool cRoot::Run(cSettingsRepositoryInterface & a_OverridesRepo)
 
 	auto settingsRepo = std::make_unique<cOverridesSettingsRepository>(std::move(IniFile), a_OverridesRepo);
 
+	if (settingsRepo->GetValueSetB("Logging", "Async", false))
+	{
+		auto QueueSize = settingsRepo->GetValueSetI("Logging", "QueueSize", 8192);
+		auto OverflowPolicy = (NoCaseCompare(settingsRepo->GetValueSet("Logging", "OverflowPolicy", "Block"), "Drop") == 0) ?
+			cLogger::eOverflowPolicy::Drop :
+			cLogger::eOverflowPolicy::Block;
+		cLogger::GetInstance().StartAsync(static_cast<size_t>(std::max(QueueSize, 16)), OverflowPolicy);
+	}
+
 	LOG("Starting server...");
 
 	// cClientHandle::FASTBREAK_PERCENTAGE = settingsRepo->GetValueSetI("AntiCheat", "FastBreakPercentage", 97) / 100.0f;
@@ -277,8 +286,15 @@ bool cRoot::Run(cSettingsRepositoryInterface & a_OverridesRepo)
 	delete m_Server; m_Server = nullptr;
 
 	LOG("Shutdown successful!");
+	if (cLogger::GetInstance().GetNumDropped() > 0)
+	{
+		LOGWARNING("The asynchronous logger has dropped %llu messages because its queue was full.", cLogger::GetInstance().GetNumDropped());
+	}
 	LOG("--- Stopped Log ---");
 
+	// Write out the queued messages before the listeners get detached:
+	cLogger::GetInstance().StopAsync();
+
 	return s_NextState == NextState::Restart;
 }
 
@@ -4,6 +4,7 @@
 
 #include "Server.h"
 #include "ClientHandle.h"
+#include "Logger.h"
 #include "LoggerSimple.h"
 #include "Mobs/Monster.h"
 #include "Root.h"
@@ -571,6 +572,120 @@ void cServer::ExecuteConsoleCommand(const AString & a_Cmd, cCommandOutputCallbac
 		return;
 	}
 
+	else if (split[0] == "hookstats")
+	{
+		auto PluginManager = cPluginManager::Get();
+		if ((split.size() > 1) && (split[1] == "on"))
+		{
+			PluginManager->SetHookStatsEnabled(true);
+			a_Output.OutLn("Plugin hook statistics enabled");
+		}
+		else if ((split.size() > 1) && (split[1] == "off"))
+		{
+			PluginManager->SetHookStatsEnabled(false);
+			a_Output.OutLn("Plugin hook statistics disabled");
+		}
+		else
+		{
+			if ((split.size() > 1) && (split[1] == "reset"))
+			{
+				PluginManager->ResetHookStats();
+				a_Output.OutLn("Plugin hook statistics reset");
+			}
+			else
+			{
+				PluginManager->LogHookStats(a_Output);
+			}
+		}
+		a_Output.Finished();
+		return;
+	}
+
+	else if (split[0] == "logstats")
+	{
+		a_Output.OutLn(fmt::format(FMT_STRING("Asynchronous log messages queued: {}"), cLogger::GetInstance().GetNumQueued()));
+		a_Output.OutLn(fmt::format(FMT_STRING("Asynchronous log messages dropped: {}"), cLogger::GetInstance().GetNumDropped()));
+		a_Output.Finished();
+		return;
+	}
+
+	else if (split[0] == "genstats")
+	{
+		cRoot::Get()->ForEachWorld([&a_Output](cWorld & a_World)
+			{
+				a_Output.OutLn(fmt::format(FMT_STRING("World {}:"), a_World.GetName()));
+				for (const auto & Entry : a_World.GetGenerator().GetCacheStats())
+				{
+					const auto & Stats = Entry.second;
+					a_Output.OutLn(fmt::format(FMT_STRING("  {} cache: {} hits, {} misses, {} evictions, hit rate {:.1f} %"),
+						Entry.first, Stats.m_NumHits, Stats.m_NumMisses, Stats.m_NumEvictions, Stats.GetHitRate()
+					));
+				}
+				return false;
+			}
+		);
+		a_Output.Finished();
+		return;
+	}
+
+	else if (split[0] == "savestats")
+	{
+		cRoot::Get()->ForEachWorld([&a_Output](cWorld & a_World)
+			{
+				const auto Stats = a_World.GetStorage().GetSaveStats();
+				const auto NumChunks = static_cast<double>(std::max<size_t>(Stats.m_NumChunks, 1));
+				a_Output.OutLn(fmt::format(FMT_STRING("World {}: {} chunks saved"), a_World.GetName(), Stats.m_NumChunks));
+				a_Output.OutLn(fmt::format(FMT_STRING("  Per chunk: {:.2f} buffer allocations, {:.0f} bytes copied, {:.0f} bytes of NBT, {:.0f} bytes compressed"),
+					static_cast<double>(Stats.m_NumAllocations) / NumChunks, static_cast<double>(Stats.m_NumBytesCopied) / NumChunks,
+					static_cast<double>(Stats.m_NumBytesSerialized) / NumChunks, static_cast<double>(Stats.m_NumBytesCompressed) / NumChunks
+				));
+				return false;
+			}
+		);
+		a_Output.Finished();
+		return;
+	}
+
+	else if (split[0] == "tickstats")
+	{
+		if ((split.size() > 1) && (split[1] == "reset"))
+		{
+			cRoot::Get()->ForEachWorld([](cWorld & a_World)
+				{
+					a_World.GetTickStats().Reset();
+					return false;
+				}
+			);
+			a_Output.OutLn("Tick statistics reset");
+			a_Output.Finished();
+			return;
+		}
+		cRoot::Get()->ForEachWorld([&a_Output](cWorld & a_World)
+			{
+				using cMilliseconds = std::chrono::duration<double, std::milli>;
+				const auto Stats = a_World.GetTickStats().GetStats();
+				const auto NumTicks = static_cast<double>(std::max<size_t>(Stats.m_NumTicks, 1));
+				a_Output.OutLn(fmt::format(FMT_STRING("World {}: {} ticks, {:.2f} TPS, tick {:.3f} ms average, {:.3f} ms max, {} chunks loaded"),
+					a_World.GetName(), Stats.m_NumTicks, Stats.GetTPS(),
+					cMilliseconds(Stats.m_Ticks.m_Total).count() / NumTicks, cMilliseconds(Stats.m_Ticks.m_Max).count(),
+					a_World.GetNumChunks()
+				));
+				for (size_t i = 0; i < Stats.m_Phases.size(); i++)
+				{
+					const auto & Phase = Stats.m_Phases[i];
+					a_Output.OutLn(fmt::format(FMT_STRING("  {}: {:.3f} ms average, {:.3f} ms max"),
+						cTickStats::GetPhaseName(static_cast<cTickStats::ePhase>(i)),
+						cMilliseconds(Phase.m_Total).count() / NumTicks, cMilliseconds(Phase.m_Max).count()
+					));
+				}
+				return false;
+			}
+		);
+		a_Output.OutLn(fmt::format(FMT_STRING("Memory: {} KiB physical, {} KiB virtual"), cRoot::GetPhysicalRAMUsage(), cRoot::GetVirtualRAMUsage()));
+		a_Output.Finished();
+		return;
+	}
+
 	else if (split[0].compare("luastats") == 0)
 	{
 		a_Output.OutLn(cLuaStateTracker::GetStats());
@@ -661,6 +776,11 @@ void cServer::BindBuiltInConsoleCommands(void)
 	PlgMgr->BindConsoleCommand("restart",         nullptr, handler, "Restarts the server cleanly");
 	PlgMgr->BindConsoleCommand("stop",            nullptr, handler, "Stops the server cleanly");
 	PlgMgr->BindConsoleCommand("chunkstats",      nullptr, handler, "Displays detailed chunk memory statistics");
+	PlgMgr->BindConsoleCommand("hookstats",       nullptr, handler, "Displays per-plugin hook timings; \"hookstats on|off|reset\" controls the measurement");
+	PlgMgr->BindConsoleCommand("logstats",        nullptr, handler, "Displays the asynchronous logger's queue statistics");
+	PlgMgr->BindConsoleCommand("genstats",        nullptr, handler, "Displays the hit rates of the world generators' caches");
+	PlgMgr->BindConsoleCommand("savestats",       nullptr, handler, "Displays the buffer allocations and copies per saved chunk");
+	PlgMgr->BindConsoleCommand("tickstats",       nullptr, handler, "Displays the tick rate and the time spent in each tick phase; \"tickstats reset\" restarts the measurement");
 	PlgMgr->BindConsoleCommand("load",            nullptr, handler, "Adds and enables the specified plugin");
 	PlgMgr->BindConsoleCommand("unload",          nullptr, handler, "Disables the specified plugin");
 	PlgMgr->BindConsoleCommand("destroyentities", nullptr, handler, "Destroys all entities in all worlds");
@@ -134,6 +134,24 @@ Compression::Result Compression::Compressor::CompressZLib(const void * const Inp
 
 
 
+ContiguousByteBufferView Compression::Compressor::CompressZLib(const ContiguousByteBufferView Input, ContiguousByteBuffer & Output)
+{
+	// Make the output large enough for any data, so that the compression cannot fail for lack of space:
+	const auto Bound = libdeflate_zlib_compress_bound(m_Handle, Input.size());
+	if (Output.size() < Bound)
+	{
+		Output.resize(Bound);
+	}
+
+	const auto BytesWrittenOut = libdeflate_zlib_compress(m_Handle, Input.data(), Input.size(), Output.data(), Output.size());
+	ASSERT(BytesWrittenOut != 0);
+	return { Output.data(), BytesWrittenOut };
+}
+
+
+
+
+
 Compression::Extractor::Extractor()
 {
 	m_Handle = libdeflate_alloc_decompressor();
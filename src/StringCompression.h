@@ -52,6 +52,11 @@ namespace Compression
 		Result CompressZLib(ContiguousByteBufferView Input);
 		Result CompressZLib(const void * Input, size_t Size);
 
+		/** Compresses the input into Output, reusing its storage, and returns the view of the compressed data within Output.
+		Output is only reallocated if it is smaller than the worst-case compressed size of the input, so callers
+		compressing many similar inputs can keep the same buffer and avoid both the allocations and copying the result. */
+		ContiguousByteBufferView CompressZLib(ContiguousByteBufferView Input, ContiguousByteBuffer & Output);
+
 	private:
 
 		template <auto Algorithm>
@@ -0,0 +1,130 @@
+
+// TickStats.cpp
+
+// Implements the cTickStats class that measures the time spent in the phases of a world's tick
+
+#include "Globals.h"
+#include "TickStats.h"
+
+
+
+
+
+/** Adds the time to the phase totals. */
+static void AddTime(cTickStats::sPhase & a_Phase, cTickStats::Duration a_Time)
+{
+	a_Phase.m_Total += a_Time;
+	a_Phase.m_Max = std::max(a_Phase.m_Max, a_Time);
+}
+
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// cTickStats::sStats:
+
+double cTickStats::sStats::GetTPS(void) const
+{
+	const auto Seconds = std::chrono::duration<double>(m_Elapsed).count();
+	return (Seconds > 0) ? (static_cast<double>(m_NumTicks) / Seconds) : 0;
+}
+
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// cTickStats:
+
+cTickStats::cTickStats(void):
+	m_Stats(),
+	m_StatsStart(std::chrono::steady_clock::now()),
+	m_TickPhases()
+{
+}
+
+
+
+
+
+const char * cTickStats::GetPhaseName(ePhase a_Phase)
+{
+	switch (a_Phase)
+	{
+		case tpPlugins:       return "Plugins";
+		case tpClientInput:   return "Client input";
+		case tpClients:       return "Clients";
+		case tpQueuedBlocks:  return "Queued chunks and blocks";
+		case tpChunks:        return "Chunks and entities";
+		case tpMobs:          return "Mob spawning";
+		case tpTasks:         return "Tasks, maps and weather";
+		case tpSimulators:    return "Simulators";
+		case tpClientOutput:  return "Client output";
+		case tpUnloadAndSave: return "Unloading and saving";
+		case tpNumPhases:     break;
+	}
+	UNREACHABLE("Unknown tick phase");
+}
+
+
+
+
+
+void cTickStats::StartTick(void)
+{
+	m_TickStart = std::chrono::steady_clock::now();
+	m_PhaseStart = m_TickStart;
+}
+
+
+
+
+
+void cTickStats::EndPhase(ePhase a_Phase)
+{
+	const auto Now = std::chrono::steady_clock::now();
+	m_TickPhases[a_Phase] += Now - m_PhaseStart;
+	m_PhaseStart = Now;
+}
+
+
+
+
+
+void cTickStats::EndTick(void)
+{
+	const auto TickTime = std::chrono::steady_clock::now() - m_TickStart;
+
+	cCSLock Lock(m_CS);
+	m_Stats.m_NumTicks += 1;
+	AddTime(m_Stats.m_Ticks, TickTime);
+	for (size_t i = 0; i < m_TickPhases.size(); i++)
+	{
+		AddTime(m_Stats.m_Phases[i], m_TickPhases[i]);
+		m_TickPhases[i] = Duration::zero();
+	}
+}
+
+
+
+
+
+cTickStats::sStats cTickStats::GetStats(void) const
+{
+	cCSLock Lock(m_CS);
+	auto Stats = m_Stats;
+	Stats.m_Elapsed = std::chrono::steady_clock::now() - m_StatsStart;
+	return Stats;
+}
+
+
+
+
+
+void cTickStats::Reset(void)
+{
+	cCSLock Lock(m_CS);
+	m_Stats = sStats();
+	m_StatsStart = std::chrono::steady_clock::now();
+}
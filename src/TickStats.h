@@ -0,0 +1,103 @@
+
+// TickStats.h
+
+// Declares the cTickStats class that measures the time spent in the phases of a world's tick
+
+
+
+
+
+#pragma once
+
+
+
+
+
+/** Measures the tick rate of a world and the time its ticks spend in each phase, for the "tickstats" console command.
+The tick thread marks the phases with StartTick(), EndPhase() and EndTick(); any thread may read or reset the statistics. */
+class cTickStats
+{
+public:
+
+	/** The phases of cWorld::Tick(), in the order they run. */
+	enum ePhase
+	{
+		tpPlugins,
+		tpClientInput,
+		tpClients,
+		tpQueuedBlocks,
+		tpChunks,
+		tpMobs,
+		tpTasks,
+		tpSimulators,
+		tpClientOutput,
+		tpUnloadAndSave,
+
+		tpNumPhases,
+	};
+
+	using Duration = std::chrono::steady_clock::duration;
+
+	/** The time spent in a single phase. */
+	struct sPhase
+	{
+		Duration m_Total;
+		Duration m_Max;
+	};
+
+	/** The statistics since the last reset. */
+	struct sStats
+	{
+		/** The number of ticks measured. */
+		size_t m_NumTicks;
+
+		/** The wallclock time since the last reset. */
+		Duration m_Elapsed;
+
+		/** The whole ticks, excluding the sleep between them. */
+		sPhase m_Ticks;
+
+		std::array<sPhase, tpNumPhases> m_Phases;
+
+		/** Returns the number of ticks per second since the last reset. */
+		double GetTPS(void) const;
+	};
+
+
+	cTickStats(void);
+
+	/** Returns the user-visible name of the phase. */
+	static const char * GetPhaseName(ePhase a_Phase);
+
+	/** Marks the start of a tick. Called in the tick thread. */
+	void StartTick(void);
+
+	/** Marks the end of the phase, which started at the end of the previous phase or the tick start. Called in the tick thread. */
+	void EndPhase(ePhase a_Phase);
+
+	/** Marks the end of the tick and adds its times to the statistics. Called in the tick thread. */
+	void EndTick(void);
+
+	/** Returns the statistics since the last reset. */
+	sStats GetStats(void) const;
+
+	/** Restarts the measurement. */
+	void Reset(void);
+
+protected:
+
+	/** Protects m_Stats and m_StatsStart. */
+	mutable cCriticalSection m_CS;
+
+	sStats m_Stats;
+
+	/** The time of the last reset. */
+	std::chrono::steady_clock::time_point m_StatsStart;
+
+	/** The start of the current tick and the end of its last phase. Only used in the tick thread. */
+	std::chrono::steady_clock::time_point m_TickStart;
+	std::chrono::steady_clock::time_point m_PhaseStart;
+
+	/** The phase times of the current tick. Only used in the tick thread. */
+	std::array<Duration, tpNumPhases> m_TickPhases;
+} ;
@@ -1155,11 +1155,11 @@ void cSlotAreaAnvil::UpdateResult(cPlayer & a_Player)
 
 	m_MaximumCost = 0;
 	m_StackSizeToBeUsedInRepair = 0;
-	int RepairCost = Target.m_RepairCost;
+	int RepairCost = Target.GetRepairCost();
 	int NeedExp = 0;
 	if (!Sacrifice.IsEmpty())
 	{
-		RepairCost += Sacrifice.m_RepairCost;
+		RepairCost += Sacrifice.GetRepairCost();
 
 		// Can we repair with sacrifce material?
 		if (Target.IsDamageable() && Target.GetHandler().CanRepairWithRawMaterial(Sacrifice.m_ItemType))
@@ -1182,7 +1182,7 @@ void cSlotAreaAnvil::UpdateResult(cPlayer & a_Player)
 			while ((DamageDiff > 0) && (NumItemsConsumed < Sacrifice.m_ItemCount))
 			{
 				Output.m_ItemDamage -= static_cast<char>(DamageDiff);
-				NeedExp += std::max(1, DamageDiff / 100) + static_cast<int>(Target.m_Enchantments.Count());
+				NeedExp += std::max(1, DamageDiff / 100) + static_cast<int>(Target.GetEnchantments().Count());
 				DamageDiff = static_cast<char>(std::min(static_cast<int>(Output.m_ItemDamage), static_cast<int>(Target.GetMaxDamage()) / 4));
 
 				++NumItemsConsumed;
@@ -1235,25 +1235,25 @@ void cSlotAreaAnvil::UpdateResult(cPlayer & a_Player)
 	if (RepairedItemName.empty())
 	{
 		// Remove custom name
-		if (!Target.m_CustomName.empty())
+		if (!Target.GetCustomName().empty())
 		{
 			NameChangeExp = (Target.IsDamageable()) ? 7 : (Target.m_ItemCount * 5);
 			NeedExp += NameChangeExp;
-			Output.m_CustomName = "";
+			Output.SetCustomName("");
 		}
 	}
-	else if (RepairedItemName != Target.m_CustomName)
+	else if (RepairedItemName != Target.GetCustomName())
 	{
 		// Change custom name
 		NameChangeExp = (Target.IsDamageable()) ? 7 : (Target.m_ItemCount * 5);
 		NeedExp += NameChangeExp;
 
-		if (!Target.m_CustomName.empty())
+		if (!Target.GetCustomName().empty())
 		{
 			RepairCost += NameChangeExp / 2;
 		}
 
-		Output.m_CustomName = RepairedItemName;
+		Output.SetCustomName(RepairedItemName);
 	}
 
 	m_MaximumCost = RepairCost + NeedExp;
@@ -1274,14 +1274,14 @@ void cSlotAreaAnvil::UpdateResult(cPlayer & a_Player)
 
 	if (!Output.IsEmpty())
 	{
-		RepairCost = std::max(Target.m_RepairCost, Sacrifice.m_RepairCost);
-		if (!Output.m_CustomName.empty())
+		RepairCost = std::max(Target.GetRepairCost(), Sacrifice.GetRepairCost());
+		if (!Output.GetCustomName().empty())
 		{
 			RepairCost -= 9;
 		}
 		RepairCost = std::max(RepairCost, 0);
 		RepairCost += 2;
-		Output.m_RepairCost = RepairCost;
+		Output.SetRepairCost(RepairCost);
 	}
 
 	// If after everything, output will be the same then no point enchanting:
@@ -1701,7 +1701,7 @@ void cSlotAreaEnchanting::UpdateResult(cPlayer & a_Player)
 {
 	cItem Item = *GetSlot(0, a_Player);
 
-	if (!cItem::IsEnchantable(Item.m_ItemType) || !Item.m_Enchantments.IsEmpty())
+	if (!cItem::IsEnchantable(Item.m_ItemType) || !Item.GetEnchantments().IsEmpty())
 	{
 		return;
 	}
@@ -1734,19 +1734,19 @@ void cSlotAreaEnchanting::UpdateResult(cPlayer & a_Player)
 		// Enchant based on the number of levels:
 		EnchantedItem.EnchantByXPLevels(OptionLevels[i], Random);
 
-		LOGD("Generated enchanted item %d with enchantments: %s", i, EnchantedItem.m_Enchantments.ToString());
+		LOGD("Generated enchanted item %d with enchantments: %s", i, EnchantedItem.GetEnchantments().ToString());
 
 		// Send the level requirement for the enchantment option:
 		m_ParentWindow.SetProperty(i, static_cast<short>(OptionLevels[i]));
 
 		// Get the first enchantment ID, which must exist:
-		ASSERT(EnchantedItem.m_Enchantments.begin() != EnchantedItem.m_Enchantments.end());
-		const auto EnchantmentID = static_cast<short>(EnchantedItem.m_Enchantments.begin()->first);
+		ASSERT(EnchantedItem.GetEnchantments().begin() != EnchantedItem.GetEnchantments().end());
+		const auto EnchantmentID = static_cast<short>(EnchantedItem.GetEnchantments().begin()->first);
 
 		// Send the enchantment ID of the first enchantment on our item:
 		m_ParentWindow.SetProperty(4 + i, EnchantmentID);
 
-		const auto EnchantmentLevel = static_cast<short>(EnchantedItem.m_Enchantments.GetLevel(EnchantmentID));
+		const auto EnchantmentLevel = static_cast<short>(EnchantedItem.GetEnchantments().GetLevel(EnchantmentID));
 		ASSERT(EnchantmentLevel > 0);
 
 		// Send the level for the first enchantment on our item:
@@ -7,6 +7,7 @@
 #include "Entities/Player.h"
 #include "Server.h"
 #include "Root.h"
+#include "Bindings/PluginManager.h"
 
 #include "HTTP/HTTPServerConnection.h"
 #include "HTTP/HTTPFormParser.h"
@@ -55,13 +56,80 @@ public:
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+// cHookStatsWebTab
+
+/** The built-in WebTab that displays the per-plugin hook statistics collected by cPluginManager.
+The "action" form parameter can be used to turn the measurement on or off, or to reset the stats. */
+class cHookStatsWebTab :
+	public cWebAdmin::cWebTabCallback
+{
+public:
+
+	virtual bool Call(
+		const HTTPRequest & a_Request,
+		const AString & a_UrlPath,
+		AString & a_Content,
+		AString & a_ContentType
+	) override
+	{
+		UNUSED(a_UrlPath);
+		UNUSED(a_ContentType);
+
+		auto PluginManager = cPluginManager::Get();
+		auto Action = a_Request.PostParams.find("action");
+		if (Action != a_Request.PostParams.end())
+		{
+			if (Action->second == "on")
+			{
+				PluginManager->SetHookStatsEnabled(true);
+			}
+			else if (Action->second == "off")
+			{
+				PluginManager->SetHookStatsEnabled(false);
+			}
+			else if (Action->second == "reset")
+			{
+				// The statistics are kept apart from the plugins, so the HTTP thread may reset and read them directly:
+				PluginManager->ResetHookStats();
+			}
+		}
+
+		a_Content = fmt::format(
+			FMT_STRING("<p>Measurement is <b>{}</b>.</p><form method='POST'>"
+			"<button type='submit' name='action' value='{}'>{}</button> "
+			"<button type='submit' name='action' value='reset'>Reset</button></form>"),
+			PluginManager->IsHookStatsEnabled() ? "enabled" : "disabled",
+			PluginManager->IsHookStatsEnabled() ? "off" : "on",
+			PluginManager->IsHookStatsEnabled() ? "Disable" : "Enable"
+		);
+		a_Content.append("<table><tr><th>Plugin</th><th>Hook</th><th>Calls</th><th>Total [ms]</th><th>Average [us]</th></tr>");
+		for (const auto & Row : PluginManager->GetHookStats())
+		{
+			a_Content.append(fmt::format(
+				FMT_STRING("<tr><td>{}</td><td>{}</td><td>{}</td><td>{:.3f}</td><td>{:.3f}</td></tr>"),
+				cWebAdmin::GetHTMLEscapedString(Row.m_PluginName), Row.m_HookName, Row.m_NumCalls,
+				static_cast<double>(Row.m_TotalNSec) / 1e6,
+				static_cast<double>(Row.m_TotalNSec) / 1e3 / static_cast<double>(Row.m_NumCalls)
+			));
+		}
+		a_Content.append("</table>");
+		return true;
+	}
+};
+
+
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 // cWebAdmin:
 
 cWebAdmin::cWebAdmin(void) :
 	m_TemplateScript("<webadmin_template>"),
 	m_IsInitialized(false),
-	m_IsRunning(false)
+	m_IsRunning(false),
+	m_PageCacheTTL(0)
 {
 }
 
@@ -90,6 +158,9 @@ bool cWebAdmin::Init(void)
 
 	Reload();
 
+	// Add the built-in tabs:
+	AddWebTab("Plugin hook stats", "hookstats", "Server", std::make_shared<cHookStatsWebTab>());
+
 	// Read the ports to be used:
 	// Note that historically the ports were stored in the "Port" and "PortsIPv6" values
 	m_Ports = ReadUpgradeIniPorts(m_IniFile, "WebAdmin", "Ports", "Port", "PortsIPv6", DEFAULT_WEBADMIN_PORTS);
@@ -173,6 +244,7 @@ void cWebAdmin::RemoveAllPluginWebTabs(const AString & a_PluginName)
 		}),
 		m_WebTabs.end()
 	);
+	m_PageCache.clear();
 }
 
 
@@ -198,6 +270,11 @@ void cWebAdmin::Reload(void)
 		);
 	}
 
+	// Drop everything cached, the files and templates may have been changed:
+	m_PageCacheTTL = std::chrono::milliseconds(m_IniFile.GetValueSetI("WebAdmin", "PageCacheTTLMsec", 0));
+	m_PageCache.clear();
+	m_FileCache.Clear();
+
 	// Initialize the WebAdmin template script and reload the file:
 	if (m_TemplateScript.IsValid())
 	{
@@ -342,17 +419,38 @@ void cWebAdmin::HandleWebadminRequest(cHTTPServerConnection & a_Connection, cHTT
 	if (ShouldWrapInTemplate)
 	{
 		cCSLock LockSelf(m_CS);
-		cLuaState::cLock LockTemplate(m_TemplateScript);
-		if (m_TemplateScript.Call("ShowPage", this, &TemplateRequest, cLuaState::Return, Template))
+
+		// Only the plain page views are cached; anything with parameters may be an action with side effects,
+		// and any such action may change what the other pages show:
+		const bool IsCacheable = (
+			(m_PageCacheTTL.count() > 0) &&
+			(a_Request.GetMethod() == "GET") &&
+			TemplateRequest.Request.Params.empty() &&
+			TemplateRequest.Request.PostParams.empty()
+		);
+		if (!IsCacheable)
 		{
-			cHTTPOutgoingResponse Resp;
-			Resp.SetContentType("text/html");
-			a_Connection.Send(Resp);
-			a_Connection.Send(Template.c_str(), Template.length());
-			a_Connection.FinishResponse();
-			return;
+			m_PageCache.clear();
 		}
-		a_Connection.SendStatusAndReason(500, "m_TemplateScript failed");
+		const auto CacheKey = a_Request.GetAuthUsername() + '\n' + a_Request.GetURL();
+		if (!IsCacheable || !GetCachedPage(CacheKey, Template))
+		{
+			cLuaState::cLock LockTemplate(m_TemplateScript);
+			if (!m_TemplateScript.Call("ShowPage", this, &TemplateRequest, cLuaState::Return, Template))
+			{
+				a_Connection.SendStatusAndReason(500, "m_TemplateScript failed");
+				return;
+			}
+			if (IsCacheable)
+			{
+				SetCachedPage(CacheKey, Template);
+			}
+		}
+		cHTTPOutgoingResponse Resp;
+		Resp.SetContentType("text/html");
+		a_Connection.Send(Resp);
+		a_Connection.Send(Template.c_str(), Template.length());
+		a_Connection.FinishResponse();
 		return;
 	}
 
@@ -386,7 +484,7 @@ void cWebAdmin::HandleRootRequest(cHTTPServerConnection & a_Connection, cHTTPInc
 
 void cWebAdmin::HandleFileRequest(cHTTPServerConnection & a_Connection, cHTTPIncomingRequest & a_Request)
 {
-	AString FileURL = a_Request.GetURL();
+	AString FileURL = a_Request.GetURLPath();
 	std::replace(FileURL.begin(), FileURL.end(), '\\', '/');
 
 	// Remove all leading backslashes:
@@ -399,36 +497,45 @@ void cWebAdmin::HandleFileRequest(cHTTPServerConnection & a_Connection, cHTTPInc
 		}
 	}
 
-	// Read the file contents and guess its mime-type, based on the extension:
-	AString Content = "<h2>404 Not Found</h2>";
-	AString ContentType = "text/html";
+	// Return 404 if the file is not found, or the URL contains '../' (for security reasons)
 	AString Path = "webadmin/files/" + FileURL;
+	auto Entry = (FileURL.find("../") == AString::npos) ? m_FileCache.Get(Path) : nullptr;
+	if (Entry == nullptr)
+	{
+		cHTTPOutgoingResponse Resp;
+		Resp.SetStatus(404, "Not Found");
+		Resp.SetContentType("text/html");
+		a_Connection.Send(Resp);
+		a_Connection.Send("<h2>404 Not Found</h2>");
+		a_Connection.FinishResponse();
+		return;
+	}
 
-	// Return 404 if the file is not found, or the URL contains '../' (for security reasons)
-	if ((FileURL.find("../") == AString::npos) && cFile::IsFile(Path))
+	// Guess the mime-type, based on the extension:
+	AString ContentType;
+	size_t LastPointPosition = Path.find_last_of('.');
+	if (LastPointPosition != AString::npos)
 	{
-		cFile File(Path, cFile::fmRead);
-		AString FileContent;
-		if (File.IsOpen() && (File.ReadRestOfFile(FileContent) != -1))
-		{
-			std::swap(Content, FileContent);
-			size_t LastPointPosition = Path.find_last_of('.');
-			if (LastPointPosition != AString::npos)
-			{
-				ContentType = GetContentTypeFromFileExt(Path.substr(LastPointPosition + 1));
-			}
-		}
-		if (ContentType.empty())
-		{
-			ContentType = "application/unknown";
-		}
+		ContentType = GetContentTypeFromFileExt(Path.substr(LastPointPosition + 1));
+	}
+	if (ContentType.empty())
+	{
+		ContentType = "application/unknown";
 	}
 
-	// Send the response:
+	// Send only the headers if the client already has the file, otherwise send the contents, gzipped if the client allows:
+	const bool UseGZip = (!Entry->m_GZipContent.empty() && cHTTPFileCache::AcceptsGZip(a_Request));
 	cHTTPOutgoingResponse Resp;
 	Resp.SetContentType(ContentType);
+	cHTTPFileCache::SetResponseHeaders(*Entry, UseGZip, Resp);
+	if (cHTTPFileCache::IsNotModified(*Entry, a_Request))
+	{
+		Resp.SetStatus(304, "Not Modified");
+		a_Connection.SendWithoutBody(Resp);
+		return;
+	}
 	a_Connection.Send(Resp);
-	a_Connection.Send(Content);
+	a_Connection.Send(UseGZip ? Entry->m_GZipContent : Entry->m_Content);
 	a_Connection.FinishResponse();
 }
 
@@ -436,13 +543,48 @@ void cWebAdmin::HandleFileRequest(cHTTPServerConnection & a_Connection, cHTTPInc
 
 
 
+bool cWebAdmin::GetCachedPage(const AString & a_Key, AString & a_Content)
+{
+	auto itr = m_PageCache.find(a_Key);
+	if ((itr == m_PageCache.end()) || (itr->second.m_Expiry <= std::chrono::steady_clock::now()))
+	{
+		return false;
+	}
+	a_Content = itr->second.m_Content;
+	return true;
+}
+
+
+
+
+
+void cWebAdmin::SetCachedPage(const AString & a_Key, const AString & a_Content)
+{
+	const auto Now = std::chrono::steady_clock::now();
+	if (m_PageCache.size() >= MAX_CACHED_PAGES)
+	{
+		for (auto itr = m_PageCache.begin(); itr != m_PageCache.end();)
+		{
+			itr = (itr->second.m_Expiry <= Now) ? m_PageCache.erase(itr) : std::next(itr);
+		}
+		if (m_PageCache.size() >= MAX_CACHED_PAGES)
+		{
+			m_PageCache.clear();
+		}
+	}
+	m_PageCache[a_Key] = { a_Content, Now + m_PageCacheTTL };
+}
+
+
+
+
+
 AString cWebAdmin::GetContentTypeFromFileExt(const AString & a_FileExtension)
 {
-	static bool IsInitialized = false;
-	static AStringMap ContentTypeMap;
-	if (!IsInitialized)
+	// Initialized only once, thread-safe (the HTTP requests are served from multiple threads):
+	static const AStringMap ContentTypeMap = []()
 	{
-		// Initialize the ContentTypeMap:
+		AStringMap ContentTypeMap;
 		ContentTypeMap["png"]   = "image/png";
 		ContentTypeMap["fif"]   = "image/fif";
 		ContentTypeMap["gif"]   = "image/gif";
@@ -461,7 +603,8 @@ AString cWebAdmin::GetContentTypeFromFileExt(const AString & a_FileExtension)
 		ContentTypeMap["html"]  = "text/html";
 		ContentTypeMap["htm"]   = "text/html";
 		ContentTypeMap["xhtml"] = "application/xhtml+xml";  // Not recomended for IE6, but no-one uses that anymore
-	}
+		return ContentTypeMap;
+	}();
 
 	auto itr = ContentTypeMap.find(StrToLower(a_FileExtension));
 	if (itr == ContentTypeMap.end())
@@ -544,6 +687,7 @@ void cWebAdmin::AddWebTab(
 {
 	cCSLock lock(m_CS);
 	m_WebTabs.emplace_back(std::make_shared<cWebTab>(a_Title, a_UrlPath, a_PluginName, std::move(a_Callback)));
+	m_PageCache.clear();
 }
 
 
@@ -558,6 +702,7 @@ bool cWebAdmin::DelWebTab(const AString & a_UrlPath)
 		if ((*itr)->m_UrlPath == a_UrlPath)
 		{
 			m_WebTabs.erase(itr);
+			m_PageCache.clear();
 			return true;
 		}
 	}  // for itr - m_WebTabs[]
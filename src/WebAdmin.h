@@ -9,6 +9,7 @@
 #include "IniFile.h"
 #include "HTTP/HTTPServer.h"
 #include "HTTP/HTTPMessage.h"
+#include "HTTP/HTTPFileCache.h"
 
 
 
@@ -223,7 +224,17 @@ public:
 
 protected:
 
-	/** Protects m_WebTabs, m_TemplateScript, m_LoginTemplate and m_IniFile against multithreaded access. */
+	/** A templated page kept for a short time, so that the polling clients don't run the template script for each request. */
+	struct sCachedPage
+	{
+		AString m_Content;
+		std::chrono::steady_clock::time_point m_Expiry;
+	};
+
+	/** The maximum number of templated pages kept in m_PageCache. */
+	static const size_t MAX_CACHED_PAGES = 64;
+
+	/** Protects m_WebTabs, m_TemplateScript, m_LoginTemplate, m_IniFile and the page cache against multithreaded access. */
 	cCriticalSection m_CS;
 
 	/** All registered WebTab handlers.
@@ -254,6 +265,17 @@ protected:
 	/** The HTTP server which provides the underlying HTTP parsing, serialization and events */
 	cHTTPServer m_HTTPServer;
 
+	/** The static files served from the webadmin/files folder. */
+	cHTTPFileCache m_FileCache;
+
+	/** How long the templated pages are cached; zero disables the page cache.
+	Read from the PageCacheTTLMsec value in webadmin.ini. Protected against multithreaded access by m_CS. */
+	std::chrono::milliseconds m_PageCacheTTL;
+
+	/** The cached templated pages, keyed by the username and URL.
+	Protected against multithreaded access by m_CS. */
+	std::unordered_map<AString, sCachedPage> m_PageCache;
+
 
 	/** Loads webadmin.ini into m_IniFile.
 	Creates a default file if it doesn't exist.
@@ -272,6 +294,14 @@ protected:
 	/** Handles requests for a file */
 	void HandleFileRequest(cHTTPServerConnection & a_Connection, cHTTPIncomingRequest & a_Request);
 
+	/** Returns the templated page for the request from the page cache into a_Content.
+	Returns false if the page is not cached, or the cached one has expired. Assumes m_CS is locked. */
+	bool GetCachedPage(const AString & a_Key, AString & a_Content);
+
+	/** Stores the templated page in the page cache, dropping the expired pages if the cache is full.
+	Assumes m_CS is locked. */
+	void SetCachedPage(const AString & a_Key, const AString & a_Content);
+
 	// cHTTPServer::cCallbacks overrides:
 	virtual void OnRequestBegun   (cHTTPServerConnection & a_Connection, cHTTPIncomingRequest & a_Request) override;
 	virtual void OnRequestBody    (cHTTPServerConnection & a_Connection, cHTTPIncomingRequest & a_Request, const char * a_Data, size_t a_Size) override;
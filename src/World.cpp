@@ -15,6 +15,7 @@
 #include "LineBlockTracer.h"
 #include "UUID.h"
 #include "BlockInServerPluginInterface.h"
+#include "BlockArea.h"
 
 // Serializers
 #include "WorldStorage/ScoreboardSerializer.h"
@@ -90,6 +91,26 @@ namespace World
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+// sQueuedBlockAreaWrite:
+
+/** A block area write queued by cWorld::QueueWriteBlockArea(), in progress. */
+struct sQueuedBlockAreaWrite
+{
+	/** The copy of the area being written. */
+	cBlockArea m_Area;
+
+	Vector3i m_MinCoords;
+	int m_DataTypes;
+
+	/** The chunks yet to be written, the next one at the back. */
+	std::vector<cChunkCoords> m_Chunks;
+};
+
+
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 // cWorld::cLock:
 
@@ -219,6 +240,11 @@ cWorld::cWorld(
 	m_bUseChatPrefixes(false),
 	m_TNTShrapnelLevel(slNone),
 	m_MaxViewDistance(12),
+	m_PlayerTrackingRange(128),
+	m_AnimalTrackingRange(64),
+	m_MonsterTrackingRange(64),
+	m_MiscTrackingRange(32),
+	m_OtherTrackingRange(64),
 	m_Scoreboard(this),
 	m_MapManager(this),
 	m_GeneratorCallbacks(*this),
@@ -260,12 +286,19 @@ cWorld::cWorld(
 		IniFile.SetValueI("General", "UnusedChunkCap", UnusedDirtyChunksCap);
 	}
 	m_UnusedDirtyChunksCap = static_cast<size_t>(UnusedDirtyChunksCap);
+	m_BlockAreaWriteBudget = std::max(IniFile.GetValueSetI("General", "BlockAreaWriteBudget", 262144), 1);
 
 	m_BroadcastDeathMessages = IniFile.GetValueSetB("Broadcasting", "BroadcastDeathMessages", true);
 	m_BroadcastAchievementMessages = IniFile.GetValueSetB("Broadcasting", "BroadcastAchievementMessages", true);
 
 	SetMaxViewDistance(IniFile.GetValueSetI("SpawnPosition", "MaxViewDistance", cClientHandle::DEFAULT_VIEW_DISTANCE));
 
+	m_PlayerTrackingRange  = std::max(IniFile.GetValueSetI("EntityTracking", "Players",  128), 1);
+	m_AnimalTrackingRange  = std::max(IniFile.GetValueSetI("EntityTracking", "Animals",  64), 1);
+	m_MonsterTrackingRange = std::max(IniFile.GetValueSetI("EntityTracking", "Monsters", 64), 1);
+	m_MiscTrackingRange    = std::max(IniFile.GetValueSetI("EntityTracking", "Misc",     32), 1);
+	m_OtherTrackingRange   = std::max(IniFile.GetValueSetI("EntityTracking", "Other",    64), 1);
+
 	// Try to find the "SpawnPosition" key and coord values in the world configuration, set the flag if found
 	int KeyNum = IniFile.FindKey("SpawnPosition");
 	m_IsSpawnExplicitlySet =
@@ -1064,8 +1097,11 @@ void cWorld::Stop(cDeadlockDetect & a_DeadlockDetect)
 
 void cWorld::Tick(std::chrono::milliseconds a_Dt, std::chrono::milliseconds a_LastTickDurationMSec)
 {
+	m_TickStats.StartTick();
+
 	// Notify the plugins:
 	cPluginManager::Get()->CallHookWorldTick(*this, a_Dt, a_LastTickDurationMSec);
+	m_TickStats.EndPhase(cTickStats::tpPlugins);
 
 	m_WorldAge += a_Dt;
 	m_WorldTickAge++;
@@ -1095,24 +1131,33 @@ void cWorld::Tick(std::chrono::milliseconds a_Dt, std::chrono::milliseconds a_La
 	{
 		Player->GetClientHandle()->ProcessProtocolIn();
 	}
+	m_TickStats.EndPhase(cTickStats::tpClientInput);
 
 	TickClients(a_Dt);
+	m_TickStats.EndPhase(cTickStats::tpClients);
 	TickQueuedChunkDataSets();
 	TickQueuedBlocks();
+	m_TickStats.EndPhase(cTickStats::tpQueuedBlocks);
 	m_ChunkMap.Tick(a_Dt);
+	m_TickStats.EndPhase(cTickStats::tpChunks);
 	TickMobs(a_Dt);
+	m_TickStats.EndPhase(cTickStats::tpMobs);
 	TickQueuedEntityAdditions();
 	m_MapManager.TickMaps();
 	TickQueuedTasks();
 	TickWeather(static_cast<float>(a_Dt.count()));
+	m_TickStats.EndPhase(cTickStats::tpTasks);
 
 	GetSimulatorManager()->Simulate(static_cast<float>(a_Dt.count()));
+	m_TickStats.EndPhase(cTickStats::tpSimulators);
 
 	// Flush out all clients' buffered data:
+	BroadcastQueuedEntityMovements();
 	for (const auto Player : m_Players)
 	{
 		Player->GetClientHandle()->ProcessProtocolOut();
 	}
+	m_TickStats.EndPhase(cTickStats::tpClientOutput);
 
 	if (m_WorldAge - m_LastChunkCheck > std::chrono::seconds(10))
 	{
@@ -1130,6 +1175,8 @@ void cWorld::Tick(std::chrono::milliseconds a_Dt, std::chrono::milliseconds a_La
 			SaveAllChunks();
 		}
 	}
+	m_TickStats.EndPhase(cTickStats::tpUnloadAndSave);
+	m_TickStats.EndTick();
 }
 
 
@@ -1469,6 +1516,72 @@ void cWorld::WakeUpSimulatorsInArea(const cCuboid & a_Area)
 
 
 
+void cWorld::QueueWriteBlockArea(const cBlockArea & a_Area, Vector3i a_MinCoords, int a_DataTypes)
+{
+	ASSERT((a_DataTypes & a_Area.GetDataTypes()) == a_DataTypes);
+	ASSERT(cChunkDef::IsValidHeight(a_MinCoords));
+	ASSERT(cChunkDef::IsValidHeight(a_MinCoords.addedY(a_Area.GetSizeY() - 1)));
+
+	auto Write = std::make_shared<sQueuedBlockAreaWrite>();
+	a_Area.CopyTo(Write->m_Area);
+	Write->m_MinCoords = a_MinCoords;
+	Write->m_DataTypes = a_DataTypes;
+
+	// Queue the chunks in reverse, so that they are written in the usual order when popped from the back:
+	const auto MinChunk = cChunkDef::BlockToChunk(a_MinCoords);
+	const auto MaxChunk = cChunkDef::BlockToChunk(a_MinCoords + a_Area.GetSize() - Vector3i(1, 1, 1));
+	for (int z = MaxChunk.m_ChunkZ; z >= MinChunk.m_ChunkZ; z--)
+	{
+		for (int x = MaxChunk.m_ChunkX; x >= MinChunk.m_ChunkX; x--)
+		{
+			Write->m_Chunks.emplace_back(x, z);
+		}
+	}
+
+	QueueTask([Write](cWorld & a_World)
+	{
+		a_World.WriteQueuedBlockArea(Write);
+	});
+}
+
+
+
+
+
+void cWorld::WriteQueuedBlockArea(std::shared_ptr<sQueuedBlockAreaWrite> a_Write)
+{
+	auto & Area = a_Write->m_Area;
+	const auto & MinCoords = a_Write->m_MinCoords;
+	int Budget = m_BlockAreaWriteBudget;
+	while (!a_Write->m_Chunks.empty() && (Budget > 0))
+	{
+		const auto Coords = a_Write->m_Chunks.back();
+		a_Write->m_Chunks.pop_back();
+		m_ChunkMap.WriteBlockArea(Area, MinCoords.x, MinCoords.y, MinCoords.z, a_Write->m_DataTypes, Coords);
+
+		// Charge the budget with the part of the area that falls into the chunk:
+		const int ChunkMinX = Coords.m_ChunkX * cChunkDef::Width;
+		const int ChunkMinZ = Coords.m_ChunkZ * cChunkDef::Width;
+		const int SizeX = std::min(MinCoords.x + Area.GetSizeX(), ChunkMinX + cChunkDef::Width) - std::max(MinCoords.x, ChunkMinX);
+		const int SizeZ = std::min(MinCoords.z + Area.GetSizeZ(), ChunkMinZ + cChunkDef::Width) - std::max(MinCoords.z, ChunkMinZ);
+		Budget -= SizeX * SizeZ * Area.GetSizeY();
+	}
+
+	if (a_Write->m_Chunks.empty())
+	{
+		WakeUpSimulatorsInArea(cCuboid(MinCoords, MinCoords + Area.GetSize() - Vector3i(1, 1, 1)));
+		return;
+	}
+	ScheduleTask(cTickTime(1), [a_Write](cWorld & a_World)
+	{
+		a_World.WriteQueuedBlockArea(a_Write);
+	});
+}
+
+
+
+
+
 bool cWorld::ForEachBlockEntityInChunk(int a_ChunkX, int a_ChunkZ, cBlockEntityCallback a_Callback)
 {
 	return m_ChunkMap.ForEachBlockEntityInChunk(a_ChunkX, a_ChunkZ, a_Callback);
@@ -2872,6 +2985,15 @@ OwnedEntity cWorld::RemoveEntity(cEntity & a_Entity)
 		const auto Player = static_cast<cPlayer *>(&a_Entity);
 		LOGD("Removing player %s from world \"%s\"", Player->GetName().c_str(), m_WorldName.c_str());
 		m_Players.erase(std::remove(m_Players.begin(), m_Players.end(), Player), m_Players.end());
+		m_EntityMovementBatches.erase(Player->GetUniqueID());
+	}
+
+	// Drop the entity's movement update, the entity may be gone before it would be sent:
+	if (a_Entity.GetQueuedMovementUpdate() != 0)
+	{
+		cLock Lock(*this);
+		m_EntityMovementQueue.erase(std::remove(m_EntityMovementQueue.begin(), m_EntityMovementQueue.end(), &a_Entity), m_EntityMovementQueue.end());
+		a_Entity.OnMovementUpdateSent();
 	}
 
 	// Check if the entity is in the chunkmap:
@@ -2904,6 +3026,37 @@ OwnedEntity cWorld::RemoveEntity(cEntity & a_Entity)
 
 
 
+void cWorld::QueueEntityMovementUpdate(cEntity & a_Entity)
+{
+	cLock Lock(*this);
+	m_EntityMovementQueue.push_back(&a_Entity);
+}
+
+
+
+
+
+double cWorld::GetEntityTrackingRange(const cEntity & a_Entity) const
+{
+	if (a_Entity.IsPlayer())
+	{
+		return m_PlayerTrackingRange;
+	}
+	if (a_Entity.IsMob())
+	{
+		return (static_cast<const cMonster &>(a_Entity).GetMobFamily() == cMonster::mfHostile) ? m_MonsterTrackingRange : m_AnimalTrackingRange;
+	}
+	if (a_Entity.IsPickup() || a_Entity.IsExpOrb() || a_Entity.IsItemFrame() || a_Entity.IsPainting() || a_Entity.IsLeashKnot())
+	{
+		return m_MiscTrackingRange;
+	}
+	return m_OtherTrackingRange;
+}
+
+
+
+
+
 size_t cWorld::GetNumChunks(void) const
 {
 	return m_ChunkMap.GetNumChunks();
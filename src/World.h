@@ -18,6 +18,7 @@
 #include "ForEachChunkProvider.h"
 #include "Scoreboard.h"
 #include "MapManager.h"
+#include "TickStats.h"
 #include "Blocks/WorldInterface.h"
 #include "Blocks/BroadcastInterface.h"
 #include "EffectID.h"
@@ -41,6 +42,7 @@ class cDeadlockDetect;
 class cUUID;
 
 struct SetChunkData;
+struct sQueuedBlockAreaWrite;
 
 
 
@@ -268,6 +270,12 @@ public:
 	Returns an owning reference to the found entity. */
 	OwnedEntity RemoveEntity(cEntity & a_Entity);
 
+	/** Queues the entity's movement update, to be sent at the end of the tick. Called by cEntity::BroadcastMovementUpdate(). */
+	void QueueEntityMovementUpdate(cEntity & a_Entity);
+
+	/** Returns the distance, in blocks, within which the clients get the movement updates of the entity, based on its class. */
+	double GetEntityTrackingRange(const cEntity & a_Entity) const;
+
 	/** Calls the callback for each entity in the entire world; returns true if all entities processed, false if the callback aborted by returning true */
 	bool ForEachEntity(cEntityCallback a_Callback);  // Exported in ManualBindings.cpp
 
@@ -582,6 +590,12 @@ public:
 	/** Wakes up the simulators for the specified area of blocks */
 	void WakeUpSimulatorsInArea(const cCuboid & a_Area);
 
+	/** Writes a copy of the block area into the specified coords over multiple ticks, a few chunks at a time.
+	Each tick writes at most as many blocks as set by [General] BlockAreaWriteBudget in world.ini, but at least a single chunk.
+	Chunks that aren't loaded when their turn comes are skipped.
+	The simulators in the area are woken up once all the chunks are written. */
+	void QueueWriteBlockArea(const cBlockArea & a_Area, Vector3i a_MinCoords, int a_DataTypes);
+
 	// tolua_end
 
 	inline cSimulatorManager * GetSimulatorManager(void) { return m_SimulatorManager.get(); }
@@ -692,6 +706,9 @@ public:
 	/** Returns the associated map manager instance. */
 	cMapManager & GetMapManager(void) { return m_MapManager; }
 
+	/** Returns the tick rate and tick phase statistics of this world. */
+	cTickStats & GetTickStats(void) { return m_TickStats; }
+
 	bool AreCommandBlocksEnabled(void) const { return m_bCommandBlocksEnabled; }
 	void SetCommandBlocksEnabled(bool a_Flag) { m_bCommandBlocksEnabled = a_Flag; }
 
@@ -931,6 +948,9 @@ private:
 	if this was exceeded. */
 	size_t m_UnusedDirtyChunksCap;
 
+	/** The maximum number of blocks written by QueueWriteBlockArea() in a single tick. Loaded from config. */
+	int m_BlockAreaWriteBudget;
+
 	AString m_WorldName;
 
 	/** The path to the root directory for the world files. Does not including trailing path specifier. */
@@ -1059,6 +1079,34 @@ private:
 	/** The maximum view distance that a player can have in this world. */
 	int m_MaxViewDistance;
 
+	/** The distances, in blocks, within which the clients get the movement updates of the entities, by the entity class.
+	Misc are the pickups, XP orbs and hanging entities; Other is everything that isn't a player, mob or misc. Loaded from config. */
+	int m_PlayerTrackingRange;
+	int m_AnimalTrackingRange;
+	int m_MonsterTrackingRange;
+	int m_MiscTrackingRange;
+	int m_OtherTrackingRange;
+
+	/** The entities whose movement update waits to be sent by BroadcastQueuedEntityMovements(). Protected by the chunk map CS. */
+	std::vector<cEntity *> m_EntityMovementQueue;
+
+	/** The movement updates that a single client gets in a tick. */
+	struct sEntityMovementBatch
+	{
+		/** The client to send the updates to, set while they are collected in a tick. */
+		cClientHandle * m_Client = nullptr;
+
+		/** The client's player position at the previous batch, to tell whether the client got the previous updates. */
+		Vector3d m_LastViewerPosition;
+
+		/** The entities and the eMovementUpdate flags to send for them. */
+		std::vector<std::pair<const cEntity *, UInt8>> m_Updates;
+	};
+
+	/** The movement update batches, per client, keyed by the unique ID of the client's player, which is never reused,
+	unlike the client's address. Kept between the ticks so that the memory is reused. */
+	std::unordered_map<UInt32, sEntityMovementBatch> m_EntityMovementBatches;
+
 	/** Name of the nether world - where Nether portals should teleport.
 	Only used when this world is an Overworld. */
 	AString m_LinkedNetherWorldName;
@@ -1073,6 +1121,9 @@ private:
 	cScoreboard      m_Scoreboard;
 	cMapManager      m_MapManager;
 
+	/** The time spent in the phases of Tick(), for the "tickstats" console command. */
+	cTickStats       m_TickStats;
+
 	/** The callbacks that the ChunkGenerator uses to store new chunks and interface to plugins */
 	cChunkGeneratorCallbacks m_GeneratorCallbacks;
 
@@ -1103,6 +1154,10 @@ private:
 	/** Ticks all clients that are in this world. */
 	void TickClients(std::chrono::milliseconds a_Dt);
 
+	/** Sends the queued entity movement updates. Each client gets its updates in a single batch,
+	at a rate that drops with the distance from the entity, and none beyond the entity's tracking range. */
+	void BroadcastQueuedEntityMovements(void);
+
 	/** Handles the weather in each tick */
 	void TickWeather(float a_Dt);
 
@@ -1119,6 +1174,10 @@ private:
 	/** Executes all tasks queued onto the tick thread */
 	void TickQueuedTasks(void);
 
+	/** Writes the next chunks of a block area queued by QueueWriteBlockArea(), within the per-tick budget.
+	Schedules itself for the next tick if there are chunks left. */
+	void WriteQueuedBlockArea(std::shared_ptr<sQueuedBlockAreaWrite> a_Write);
+
 	/** Unloads all chunks immediately. */
 	void UnloadUnusedChunks(void);
 
@@ -0,0 +1,387 @@
+
+// AnvilSectionDecoder.cpp
+
+// Implements the cAnvilSectionDecoder class that decodes the paletted block data of 1.13+ Anvil chunk sections
+
+#include "Globals.h"
+#include "AnvilSectionDecoder.h"
+#include "FastNBT.h"
+#include "NamespaceSerializer.h"
+#include "PerfectHashTable.h"
+#include "../BlockState.h"
+
+
+
+
+
+namespace
+{
+	/** The namespace that all the palette entries must have. */
+	const std::string_view VanillaNamespace = "minecraft:";
+
+
+
+
+
+	/** Continues the FNV-1a hash a_Hash with the bytes of a_Name. */
+	inline UInt64 HashBytes(UInt64 a_Hash, std::string_view a_Name)
+	{
+		for (auto Ch: a_Name)
+		{
+			a_Hash = (a_Hash ^ static_cast<unsigned char>(Ch)) * 0x100000001b3ULL;
+		}
+		return a_Hash;
+	}
+
+
+
+
+
+	/** The FNV-1a offset basis. */
+	const UInt64 HASH_BASIS = 0xcbf29ce484222325ULL;
+
+
+
+
+
+	/** Returns the perfect hash table of all the known block names (without the namespace), mapping to their default block state.
+	The table is built on first use. */
+	const cPerfectHashTable<BlockState> & GetBlockNameTable(void)
+	{
+		static const cPerfectHashTable<BlockState> Table([]
+			{
+				std::vector<cPerfectHashTable<BlockState>::cEntry> Entries;
+				for (auto Type = static_cast<int>(BlockType::AcaciaButton); Type <= static_cast<int>(BlockType::ZombieWallHead); Type++)
+				{
+					auto Name = NamespaceSerializer::From(static_cast<BlockType>(Type));
+					if (!Name.empty())
+					{
+						Entries.emplace_back(Name, BlockState(static_cast<BlockType>(Type)));
+					}
+				}
+				return Entries;
+			}()
+		);
+		return Table;
+	}
+
+
+
+
+
+	/** Unpacks the indices stored with padding (1.16+): each long holds as many whole indices as fit, starting at the low bits. */
+	template <int BitsPerEntry>
+	void UnpackPadded(const std::byte * a_Data, const BlockState * a_Lookup, BlockState * a_Dest)
+	{
+		constexpr size_t EntriesPerLong = 64 / BitsPerEntry;
+		constexpr size_t NumFullLongs = ChunkBlockData::SectionBlockCount / EntriesPerLong;
+		constexpr size_t NumRemaining = ChunkBlockData::SectionBlockCount - NumFullLongs * EntriesPerLong;
+		constexpr UInt64 Mask = (static_cast<UInt64>(1) << BitsPerEntry) - 1;
+
+		for (size_t i = 0; i < NumFullLongs; i++)
+		{
+			auto Value = NetworkBufToHost<UInt64>(a_Data + i * 8);
+			for (size_t j = 0; j < EntriesPerLong; j++)
+			{
+				a_Dest[j] = a_Lookup[Value & Mask];
+				Value >>= BitsPerEntry;
+			}
+			a_Dest += EntriesPerLong;
+		}
+		if constexpr (NumRemaining > 0)
+		{
+			auto Value = NetworkBufToHost<UInt64>(a_Data + NumFullLongs * 8);
+			for (size_t j = 0; j < NumRemaining; j++)
+			{
+				a_Dest[j] = a_Lookup[Value & Mask];
+				Value >>= BitsPerEntry;
+			}
+		}
+	}
+
+
+
+
+
+	/** Unpacks the indices stored without padding (pre-1.16): the indices form a continuous bit stream that spans across longs.
+	Each group of 64 indices takes exactly BitsPerEntry longs, so the bit positions within a group are compile-time constants. */
+	template <int BitsPerEntry>
+	void UnpackCompact(const std::byte * a_Data, const BlockState * a_Lookup, BlockState * a_Dest)
+	{
+		constexpr UInt64 Mask = (static_cast<UInt64>(1) << BitsPerEntry) - 1;
+
+		for (size_t Group = 0; Group < ChunkBlockData::SectionBlockCount / 64; Group++)
+		{
+			UInt64 Longs[BitsPerEntry];
+			for (size_t i = 0; i < BitsPerEntry; i++)
+			{
+				Longs[i] = NetworkBufToHost<UInt64>(a_Data + i * 8);
+			}
+			for (size_t j = 0; j < 64; j++)
+			{
+				const size_t FirstBit = j * BitsPerEntry;
+				const size_t LongIdx = FirstBit / 64;
+				const size_t Shift = FirstBit % 64;
+				auto Value = Longs[LongIdx] >> Shift;
+				if (Shift + BitsPerEntry > 64)
+				{
+					Value |= Longs[LongIdx + 1] << (64 - Shift);
+				}
+				a_Dest[j] = a_Lookup[Value & Mask];
+			}
+			a_Data += BitsPerEntry * 8;
+			a_Dest += 64;
+		}
+	}
+
+
+
+
+
+	/** Calls the unpacking kernel specialized for the index width. */
+	void Unpack(int a_BitsPerEntry, bool a_UsePadding, const std::byte * a_Data, const BlockState * a_Lookup, BlockState * a_Dest)
+	{
+		// Widths that divide 64 are stored the same way with and without padding:
+		#define UNPACK_WIDTH(Bits) \
+			case Bits: \
+			{ \
+				if (a_UsePadding || ((64 % Bits) == 0)) \
+				{ \
+					UnpackPadded<Bits>(a_Data, a_Lookup, a_Dest); \
+				} \
+				else \
+				{ \
+					UnpackCompact<Bits>(a_Data, a_Lookup, a_Dest); \
+				} \
+				return; \
+			}
+
+		switch (a_BitsPerEntry)
+		{
+			UNPACK_WIDTH(4)
+			UNPACK_WIDTH(5)
+			UNPACK_WIDTH(6)
+			UNPACK_WIDTH(7)
+			UNPACK_WIDTH(8)
+			UNPACK_WIDTH(9)
+			UNPACK_WIDTH(10)
+			UNPACK_WIDTH(11)
+			UNPACK_WIDTH(12)
+		}
+		#undef UNPACK_WIDTH
+		UNREACHABLE("Unsupported number of bits per palette index");
+	}
+
+
+
+
+
+	/** Sets all the blocks in the section to a_Block. Doesn't allocate a section only to fill it with the default value. */
+	void FillSection(ChunkBlockData & a_BlockData, size_t a_Y, BlockState a_Block)
+	{
+		if ((a_Block == ChunkBlockData::DefaultValue) && (a_BlockData.GetSection(a_Y) == nullptr))
+		{
+			return;
+		}
+		auto & Section = a_BlockData.GetSectionForOverwrite(a_Y);
+		std::fill(Section.begin(), Section.end(), a_Block);
+	}
+}  // namespace (anonymous)
+
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// cAnvilSectionDecoder:
+
+cAnvilSectionDecoder::cAnvilSectionDecoder(void) :
+	m_NumMemoHits(0),
+	m_NumMemoMisses(0)
+{
+}
+
+
+
+
+
+cAnvilSectionDecoder::eResult cAnvilSectionDecoder::DecodeSection(
+	const cParsedNBT & a_NBT, int a_PaletteTag, int a_DataTag, bool a_UsePadding,
+	ChunkBlockData & a_BlockData, size_t a_Y, AString & a_FailReason
+)
+{
+	if (!ReadPaletteNames(a_NBT, a_PaletteTag, a_FailReason))
+	{
+		return eResult::Failed;
+	}
+	if (m_Names.empty())
+	{
+		return eResult::Decoded;
+	}
+	const auto & Palette = ResolvePalette();
+	if (Palette.size() == 1)
+	{
+		// Single-block sections need no indices:
+		FillSection(a_BlockData, a_Y, Palette[0]);
+		return eResult::Decoded;
+	}
+
+	const auto BitsPerEntry = GetBitsPerEntry(Palette.size());
+	if (BitsPerEntry > MAX_BITS_PER_ENTRY)
+	{
+		a_FailReason = fmt::format(FMT_STRING("Section palette too large: {} entries"), Palette.size());
+		return eResult::Failed;
+	}
+	const auto NumLongs = GetNumLongs(BitsPerEntry, a_UsePadding);
+	if (
+		(a_DataTag < 0) ||
+		(a_NBT.GetType(a_DataTag) != TAG_LongArray) ||
+		(a_NBT.GetDataLength(a_DataTag) != NumLongs * 8)
+	)
+	{
+		// No usable block data, the section is left as it is:
+		return eResult::Decoded;
+	}
+	if (std::all_of(Palette.begin(), Palette.end(), [](BlockState a_Block) { return (a_Block == ChunkBlockData::DefaultValue); }))
+	{
+		FillSection(a_BlockData, a_Y, ChunkBlockData::DefaultValue);
+		return eResult::Decoded;
+	}
+
+	// Pad the palette with air up to the full index range, then unpack straight into the section:
+	std::copy(Palette.begin(), Palette.end(), m_Lookup.begin());
+	std::fill(m_Lookup.begin() + static_cast<std::ptrdiff_t>(Palette.size()), m_Lookup.begin() + (1 << BitsPerEntry), ChunkBlockData::DefaultValue);
+	auto & Section = a_BlockData.GetSectionForOverwrite(a_Y);
+	Unpack(BitsPerEntry, a_UsePadding, a_NBT.GetData(a_DataTag), m_Lookup.data(), Section.data());
+	return eResult::Decoded;
+}
+
+
+
+
+
+BlockState cAnvilSectionDecoder::ResolveBlockName(std::string_view a_Name)
+{
+	if (const auto Res = GetBlockNameTable().Find(a_Name); Res != nullptr)
+	{
+		return *Res;
+	}
+	return NamespaceSerializer::ToBlockType(a_Name);
+}
+
+
+
+
+
+int cAnvilSectionDecoder::GetBitsPerEntry(size_t a_PaletteSize)
+{
+	int Bits = 4;
+	while ((static_cast<size_t>(1) << Bits) < a_PaletteSize)
+	{
+		Bits += 1;
+	}
+	return Bits;
+}
+
+
+
+
+
+size_t cAnvilSectionDecoder::GetNumLongs(int a_BitsPerEntry, bool a_UsePadding)
+{
+	if (a_UsePadding)
+	{
+		const size_t EntriesPerLong = static_cast<size_t>(64 / a_BitsPerEntry);
+		return (ChunkBlockData::SectionBlockCount + EntriesPerLong - 1) / EntriesPerLong;
+	}
+	return static_cast<size_t>(a_BitsPerEntry) * ChunkBlockData::SectionBlockCount / 64;
+}
+
+
+
+
+
+bool cAnvilSectionDecoder::ReadPaletteNames(const cParsedNBT & a_NBT, int a_PaletteTag, AString & a_FailReason)
+{
+	m_Names.clear();
+	for (int Entry = a_NBT.GetFirstChild(a_PaletteTag); Entry >= 0; Entry = a_NBT.GetNextSibling(Entry))
+	{
+		const int NameTag = a_NBT.FindChildByName(Entry, "Name"_nbt);
+		if ((NameTag < 0) || (a_NBT.GetType(NameTag) != TAG_String))
+		{
+			a_FailReason = "NBT tag missing or has wrong type: Name";
+			return false;
+		}
+		auto Name = a_NBT.GetStringView(NameTag);
+		if (Name.substr(0, VanillaNamespace.size()) != VanillaNamespace)
+		{
+			a_FailReason = fmt::format(FMT_STRING("Invalid namespace: {} Mods arent supported"), Name);
+			return false;
+		}
+		// The "Properties" compound is not read yet, all entries resolve to the default state of their block type
+		m_Names.push_back(Name.substr(VanillaNamespace.size()));
+	}
+	return true;
+}
+
+
+
+
+
+const std::vector<BlockState> & cAnvilSectionDecoder::ResolvePalette(void)
+{
+	// Hash the whole palette, including the name lengths so that the names cannot shift into each other:
+	auto Hash = HASH_BASIS;
+	for (const auto & Name: m_Names)
+	{
+		Hash = (Hash ^ Name.size()) * 0x100000001b3ULL;
+		Hash = HashBytes(Hash, Name);
+	}
+
+	auto itr = m_Memo.find(Hash);
+	if ((itr != m_Memo.end()) && IsSamePalette(itr->second.m_Names))
+	{
+		m_NumMemoHits += 1;
+		return itr->second.m_States;
+	}
+	m_NumMemoMisses += 1;
+
+	// Resolve each name and remember the palette:
+	if (m_Memo.size() >= MAX_MEMO_PALETTES)
+	{
+		m_Memo.clear();
+	}
+	auto & Memo = m_Memo[Hash];
+	Memo.m_Names.clear();
+	Memo.m_States.clear();
+	Memo.m_States.reserve(m_Names.size());
+	for (const auto & Name: m_Names)
+	{
+		Memo.m_Names.push_back(static_cast<char>(std::min<size_t>(Name.size(), 0xff)));
+		Memo.m_Names.append(Name);
+		Memo.m_States.push_back(ResolveBlockName(Name));
+	}
+	return Memo.m_States;
+}
+
+
+
+
+
+bool cAnvilSectionDecoder::IsSamePalette(const AString & a_MemoNames) const
+{
+	size_t Pos = 0;
+	for (const auto & Name: m_Names)
+	{
+		if (
+			(Pos >= a_MemoNames.size()) ||
+			(static_cast<unsigned char>(a_MemoNames[Pos]) != std::min<size_t>(Name.size(), 0xff)) ||
+			(a_MemoNames.compare(Pos + 1, Name.size(), Name) != 0)
+		)
+		{
+			return false;
+		}
+		Pos += 1 + Name.size();
+	}
+	return (Pos == a_MemoNames.size());
+}
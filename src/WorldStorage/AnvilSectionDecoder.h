@@ -0,0 +1,110 @@
+
+// AnvilSectionDecoder.h
+
+// Declares the cAnvilSectionDecoder class that decodes the paletted block data of 1.13+ Anvil chunk sections
+
+
+
+
+
+#pragma once
+
+#include "../ChunkData.h"
+
+
+
+
+
+// fwd:
+class cParsedNBT;
+
+
+
+
+
+/** Decodes the block palette and the packed block indices of a single Anvil chunk section directly into ChunkBlockData.
+Palette names are resolved through a perfect hash table built once over all the known block names, without building any strings.
+The packed indices are unpacked by kernels specialized for each index width, writing straight into the destination section.
+Palettes that repeat across sections (and chunks) are remembered, so that the same palette is resolved only once.
+The decoder keeps per-instance scratch buffers, so a single instance must not be used by multiple threads at once. */
+class cAnvilSectionDecoder
+{
+public:
+
+	/** The outcome of DecodeSection(). */
+	enum class eResult
+	{
+		Decoded,  ///< The section was decoded (or left empty, if all of its blocks are air)
+		Failed,   ///< The section data is malformed, the chunk should be rejected
+	};
+
+	cAnvilSectionDecoder(void);
+
+	/** Decodes the section block data into the section a_Y of a_BlockData.
+	a_PaletteTag is the list of palette entries (compounds with the "Name" string).
+	a_DataTag is the LongArray with the packed indices, or -1 if not present.
+	a_UsePadding specifies whether the indices don't span across longs (1.16+ worlds).
+	On failure, a_FailReason is set to a human-readable description of the problem. */
+	eResult DecodeSection(
+		const cParsedNBT & a_NBT, int a_PaletteTag, int a_DataTag, bool a_UsePadding,
+		ChunkBlockData & a_BlockData, size_t a_Y, AString & a_FailReason
+	);
+
+	/** Resolves a single block name, without the namespace, to its default block state.
+	Unknown names are resolved through NamespaceSerializer, which also handles the legacy aliases. */
+	static BlockState ResolveBlockName(std::string_view a_Name);
+
+	/** Returns the number of palettes that were served from the memo, for diagnostics. */
+	size_t GetNumMemoHits(void) const { return m_NumMemoHits; }
+
+	/** Returns the number of palettes that had to be resolved name by name, for diagnostics. */
+	size_t GetNumMemoMisses(void) const { return m_NumMemoMisses; }
+
+	/** Returns the number of bits per index used for a palette of the specified size (at least 4, as stored by vanilla). */
+	static int GetBitsPerEntry(size_t a_PaletteSize);
+
+	/** Returns the number of longs that store a section with the specified index width. */
+	static size_t GetNumLongs(int a_BitsPerEntry, bool a_UsePadding);
+
+protected:
+
+	/** A palette already resolved, kept for reuse by sections with the same palette. */
+	struct sMemoPalette
+	{
+		/** The raw block names of the palette, each prefixed by its length, used for verifying a hash match. */
+		AString m_Names;
+
+		/** The resolved block states, in palette order. */
+		std::vector<BlockState> m_States;
+	};
+
+	/** Maximum number of palettes remembered; the memo is cleared when it grows above this. */
+	static constexpr size_t MAX_MEMO_PALETTES = 4096;
+
+	/** Maximum number of bits per index that sections can use. */
+	static constexpr int MAX_BITS_PER_ENTRY = 12;
+
+	/** The names of the current section's palette, without the namespace. Points into the NBT data being decoded. */
+	std::vector<std::string_view> m_Names;
+
+	/** The palette of the current section, padded with air up to the full range of the index width,
+	so that malformed indices cannot read outside of it. */
+	std::array<BlockState, 1 << MAX_BITS_PER_ENTRY> m_Lookup;
+
+	/** The remembered palettes, keyed by the hash of their names. */
+	std::unordered_map<UInt64, sMemoPalette> m_Memo;
+
+	size_t m_NumMemoHits;
+	size_t m_NumMemoMisses;
+
+
+	/** Reads the palette names from a_PaletteTag into m_Names.
+	Returns false and sets a_FailReason if an entry is malformed. */
+	bool ReadPaletteNames(const cParsedNBT & a_NBT, int a_PaletteTag, AString & a_FailReason);
+
+	/** Returns the resolved palette for the names in m_Names, from the memo if possible. */
+	const std::vector<BlockState> & ResolvePalette(void);
+
+	/** Returns true if the memoized names are the same as the ones in m_Names. */
+	bool IsSamePalette(const AString & a_MemoNames) const;
+} ;
@@ -149,7 +149,8 @@ std::error_code make_error_code(eNBTParseError a_Err) noexcept
 
 cParsedNBT::cParsedNBT(const ContiguousByteBufferView a_Data) :
 	m_Data(a_Data),
-	m_Pos(0)
+	m_Pos(0),
+	m_NumTagsInData(0)
 {
 	m_Error = Parse();
 }
@@ -172,13 +173,25 @@ eNBTParseError cParsedNBT::Parse(void)
 	}
 
 	m_Tags.reserve(NBT_RESERVE_SIZE);
+	m_Containers.reserve(NBT_RESERVE_SIZE);
 
 	m_Tags.emplace_back(TAG_Compound, -1);
 
 	m_Pos = 1;
+	m_NumTagsInData = 1;
 
 	PROPAGATE_ERROR(ReadString(m_Tags.back().m_NameStart, m_Tags.back().m_NameLength));
-	return ReadCompound();
+
+	// Validate the entire tree, remember the extents of the containers:
+	auto & Root = m_Tags.back();
+	Root.m_DataStart = m_Pos;
+	Root.m_Container = 0;
+	PROPAGATE_ERROR(SkipCompound());
+	Root.m_DataLength = m_Pos - Root.m_DataStart;
+
+	// Reserve room for all the tags, so that the expansion never moves the existing ones around:
+	m_Tags.reserve(m_NumTagsInData);
+	return eNBTParseError::npSuccess;
 }
 
 
@@ -199,13 +212,10 @@ eNBTParseError cParsedNBT::ReadString(size_t & a_StringStart, size_t & a_StringL
 
 
 
-eNBTParseError cParsedNBT::ReadCompound(void)
+eNBTParseError cParsedNBT::SkipCompound(void)
 {
-	ASSERT(m_Tags.size() > 0);
-
-	// Reads the latest tag as a compound
-	size_t ParentIdx = m_Tags.size() - 1;
-	int PrevSibling = -1;
+	const auto Container = m_Containers.size();
+	m_Containers.push_back({0, 0});
 	for (;;)
 	{
 		NEEDBYTES(1, eNBTParseError::npCompoundImbalancedTag);
@@ -220,20 +230,12 @@ eNBTParseError cParsedNBT::ReadCompound(void)
 		{
 			break;
 		}
-		m_Tags.emplace_back(TagType, static_cast<int>(ParentIdx), PrevSibling);
-		if (PrevSibling >= 0)
-		{
-			m_Tags[static_cast<size_t>(PrevSibling)].m_NextSibling = static_cast<int>(m_Tags.size()) - 1;
-		}
-		else
-		{
-			m_Tags[ParentIdx].m_FirstChild = static_cast<int>(m_Tags.size()) - 1;
-		}
-		PrevSibling = static_cast<int>(m_Tags.size()) - 1;
-		PROPAGATE_ERROR(ReadString(m_Tags.back().m_NameStart, m_Tags.back().m_NameLength));
-		PROPAGATE_ERROR(ReadTag());
+		size_t NameStart, NameLength;
+		PROPAGATE_ERROR(ReadString(NameStart, NameLength));
+		PROPAGATE_ERROR(SkipTag(TagType));
+		m_NumTagsInData += 1;
 	}  // while (true)
-	m_Tags[ParentIdx].m_LastChild = PrevSibling;
+	m_Containers[Container] = { m_Pos, static_cast<int>(m_Containers.size() - Container - 1) };
 	return eNBTParseError::npSuccess;
 }
 
@@ -241,9 +243,10 @@ eNBTParseError cParsedNBT::ReadCompound(void)
 
 
 
-eNBTParseError cParsedNBT::ReadList(eTagType a_ChildrenType)
+eNBTParseError cParsedNBT::SkipList(eTagType a_ChildrenType)
 {
-	// Reads the latest tag as a list of items of type a_ChildrenType
+	const auto Container = m_Containers.size();
+	m_Containers.push_back({0, 0});
 
 	// Read the count:
 	NEEDBYTES(4, eNBTParseError::npListMissingLength);
@@ -254,26 +257,21 @@ eNBTParseError cParsedNBT::ReadList(eTagType a_ChildrenType)
 	{
 		return eNBTParseError::npListInvalidLength;
 	}
+	m_NumTagsInData += static_cast<size_t>(Count);
 
-	// Read items:
-	ASSERT(m_Tags.size() > 0);
-	size_t ParentIdx = m_Tags.size() - 1;
-	int PrevSibling = -1;
-	for (int i = 0; i < Count; i++)
+	// Skip the items; the numeric items are all the same size, skip them at once:
+	if ((a_ChildrenType >= TAG_Byte) && (a_ChildrenType <= TAG_Double))
 	{
-		m_Tags.emplace_back(a_ChildrenType, static_cast<int>(ParentIdx), PrevSibling);
-		if (PrevSibling >= 0)
-		{
-			m_Tags[static_cast<size_t>(PrevSibling)].m_NextSibling = static_cast<int>(m_Tags.size()) - 1;
-		}
-		else
+		m_Pos += static_cast<size_t>(Count) * MinChildSize;
+	}
+	else
+	{
+		for (int i = 0; i < Count; i++)
 		{
-			m_Tags[ParentIdx].m_FirstChild = static_cast<int>(m_Tags.size()) - 1;
+			PROPAGATE_ERROR(SkipTag(a_ChildrenType));
 		}
-		PrevSibling = static_cast<int>(m_Tags.size()) - 1;
-		PROPAGATE_ERROR(ReadTag());
-	}  // for (i)
-	m_Tags[ParentIdx].m_LastChild = PrevSibling;
+	}
+	m_Containers[Container] = { m_Pos, static_cast<int>(m_Containers.size() - Container - 1) };
 	return eNBTParseError::npSuccess;
 }
 
@@ -285,16 +283,27 @@ eNBTParseError cParsedNBT::ReadList(eTagType a_ChildrenType)
 	case TAG_##TAGTYPE: \
 	{ \
 		NEEDBYTES(LEN, eNBTParseError::npSimpleMissing); \
-		Tag.m_DataStart = m_Pos; \
-		Tag.m_DataLength = LEN; \
 		m_Pos += LEN; \
 		return eNBTParseError::npSuccess; \
 	}
 
-eNBTParseError cParsedNBT::ReadTag(void)
+#define CASE_ARRAY_TAG(TAGTYPE, ITEMLEN) \
+	case TAG_##TAGTYPE: \
+	{ \
+		NEEDBYTES(4, eNBTParseError::npArrayMissingLength); \
+		int len = NetworkBufToHost<int>(m_Data.data() + m_Pos); \
+		m_Pos += 4; \
+		if ((len < 0) || (static_cast<size_t>(len) > (m_Data.size() - m_Pos) / ITEMLEN)) \
+		{ \
+			return eNBTParseError::npArrayInvalidLength; \
+		} \
+		m_Pos += static_cast<size_t>(len) * ITEMLEN; \
+		return eNBTParseError::npSuccess; \
+	}
+
+eNBTParseError cParsedNBT::SkipTag(eTagType a_TagType)
 {
-	cFastNBTTag & Tag = m_Tags.back();
-	switch (Tag.m_Type)
+	switch (a_TagType)
 	{
 		CASE_SIMPLE_TAG(Byte,   1)
 		CASE_SIMPLE_TAG(Short,  2)
@@ -302,95 +311,192 @@ eNBTParseError cParsedNBT::ReadTag(void)
 		CASE_SIMPLE_TAG(Long,   8)
 		CASE_SIMPLE_TAG(Float,  4)
 		CASE_SIMPLE_TAG(Double, 8)
+		CASE_ARRAY_TAG(ByteArray, 1)
+		CASE_ARRAY_TAG(IntArray,  4)
+		CASE_ARRAY_TAG(LongArray, 8)
 
 		case TAG_String:
 		{
-			return ReadString(Tag.m_DataStart, Tag.m_DataLength);
+			size_t Start, Length;
+			return ReadString(Start, Length);
 		}
 
-		case TAG_ByteArray:
+		case TAG_List:
 		{
-			NEEDBYTES(4, eNBTParseError::npArrayMissingLength);
-			int len = NetworkBufToHost<int>(m_Data.data() + m_Pos);
-			m_Pos += 4;
-			if (len < 0)
+			NEEDBYTES(1, eNBTParseError::npListMissingType);
+			const auto ItemTypeNum = m_Data[m_Pos];
+			if ((ItemTypeNum < std::byte(TAG_Min)) || (ItemTypeNum > std::byte(TAG_Max)))
 			{
-				// Invalid length
-				return eNBTParseError::npArrayInvalidLength;
+				return eNBTParseError::npUnknownTag;
 			}
-			NEEDBYTES(len, eNBTParseError::npArrayInvalidLength);
-			Tag.m_DataLength = static_cast<size_t>(len);
-			Tag.m_DataStart = m_Pos;
-			m_Pos += static_cast<size_t>(len);
-			return eNBTParseError::npSuccess;
+			m_Pos++;
+			return SkipList(static_cast<eTagType>(ItemTypeNum));
 		}
 
-		case TAG_List:
+		case TAG_Compound:
 		{
-			NEEDBYTES(1, eNBTParseError::npListMissingType);
-			eTagType ItemType = static_cast<eTagType>(m_Data[m_Pos]);
-			m_Pos++;
-			PROPAGATE_ERROR(ReadList(ItemType));
-			return eNBTParseError::npSuccess;
+			return SkipCompound();
 		}
 
-		case TAG_Compound:
+		case TAG_Min:
 		{
-			PROPAGATE_ERROR(ReadCompound());
-			return eNBTParseError::npSuccess;
+			return eNBTParseError::npUnknownTag;
 		}
+	}  // switch (iType)
+	UNREACHABLE("Unsupported nbt tag type");
+}
 
-		case TAG_IntArray:
+#undef CASE_SIMPLE_TAG
+#undef CASE_ARRAY_TAG
+
+
+
+
+
+void cParsedNBT::Expand(int a_Tag) const
+{
+	ASSERT(IsValid());
+	const auto Type = m_Tags[static_cast<size_t>(a_Tag)].m_Type;
+	ASSERT((Type == TAG_Compound) || (Type == TAG_List));
+	auto Pos = m_Tags[static_cast<size_t>(a_Tag)].m_DataStart;
+	int NextContainer = m_Tags[static_cast<size_t>(a_Tag)].m_Container + 1;
+
+	// Each child is appended to m_Tags and linked to its previous sibling:
+	int PrevSibling = -1;
+	int NumChildren = 0;
+	auto AddChild = [&](eTagType a_ChildType) -> cFastNBTTag &
+	{
+		const auto Child = static_cast<int>(m_Tags.size());
+		m_Tags.emplace_back(a_ChildType, a_Tag, PrevSibling);
+		if (PrevSibling >= 0)
 		{
-			NEEDBYTES(4, eNBTParseError::npArrayMissingLength);
-			int len = NetworkBufToHost<int>(m_Data.data() + m_Pos);
-			m_Pos += 4;
-			if (len < 0)
-			{
-				// Invalid length
-				return eNBTParseError::npArrayInvalidLength;
-			}
-			len *= 4;
-			NEEDBYTES(len, eNBTParseError::npArrayInvalidLength);
-			Tag.m_DataLength = static_cast<size_t>(len);
-			Tag.m_DataStart = m_Pos;
-			m_Pos += static_cast<size_t>(len);
-			return eNBTParseError::npSuccess;
+			m_Tags[static_cast<size_t>(PrevSibling)].m_NextSibling = Child;
 		}
+		else
+		{
+			m_Tags[static_cast<size_t>(a_Tag)].m_FirstChild = Child;
+		}
+		PrevSibling = Child;
+		NumChildren += 1;
+		return m_Tags.back();
+	};
 
-		case TAG_LongArray:
+	if (Type == TAG_Compound)
+	{
+		for (;;)
 		{
-			NEEDBYTES(4, eNBTParseError::npArrayMissingLength);
-			int len = NetworkBufToHost<int>(m_Data.data() + m_Pos);
-			m_Pos += 4;
-			if (len < 0)
+			const auto ChildType = static_cast<eTagType>(m_Data[Pos]);
+			Pos += 1;
+			if (ChildType == TAG_End)
 			{
-				// Invalid length
-				return eNBTParseError::npArrayInvalidLength;
+				break;
 			}
-			len *= 8;
-			NEEDBYTES(len, eNBTParseError::npArrayInvalidLength);
-			Tag.m_DataLength = static_cast<size_t>(len);
-			Tag.m_DataStart = m_Pos;
-			m_Pos += static_cast<size_t>(len);
-			return eNBTParseError::npSuccess;
+			auto & Child = AddChild(ChildType);
+			Child.m_NameStart = Pos + 2;
+			Child.m_NameLength = static_cast<size_t>(NetworkBufToHost<UInt16>(m_Data.data() + Pos));
+			Child.m_NameHash = sNBTKey::Hash({ reinterpret_cast<const char *>(m_Data.data()) + Child.m_NameStart, Child.m_NameLength });
+			Pos = ExpandTag(Child, Child.m_NameStart + Child.m_NameLength, NextContainer);
 		}
+	}
+	else
+	{
+		// The list header (item type and count) precedes the payload:
+		const auto ChildType = static_cast<eTagType>(m_Data[Pos - 5]);
+		const auto Count = NetworkBufToHost<int>(m_Data.data() + Pos - 4);
+		for (int i = 0; i < Count; i++)
+		{
+			Pos = ExpandTag(AddChild(ChildType), Pos, NextContainer);
+		}
+	}
 
-		case TAG_Min:
+	auto & Tag = m_Tags[static_cast<size_t>(a_Tag)];
+	Tag.m_LastChild = PrevSibling;
+	Tag.m_NumChildren = NumChildren;
+	ASSERT(Pos == Tag.m_DataStart + Tag.m_DataLength);
+}
+
+
+
+
+
+size_t cParsedNBT::ExpandTag(cFastNBTTag & a_Tag, size_t a_Pos, int & a_NextContainer) const
+{
+	switch (a_Tag.m_Type)
+	{
+		case TAG_Byte:   a_Tag.m_DataLength = 1; break;
+		case TAG_Short:  a_Tag.m_DataLength = 2; break;
+		case TAG_Int:    a_Tag.m_DataLength = 4; break;
+		case TAG_Long:   a_Tag.m_DataLength = 8; break;
+		case TAG_Float:  a_Tag.m_DataLength = 4; break;
+		case TAG_Double: a_Tag.m_DataLength = 8; break;
+		case TAG_String:
 		{
-			return eNBTParseError::npUnknownTag;
+			a_Tag.m_DataLength = static_cast<size_t>(NetworkBufToHost<UInt16>(m_Data.data() + a_Pos));
+			a_Pos += 2;
+			break;
 		}
-	}  // switch (iType)
-	UNREACHABLE("Unsupported nbt tag type");
+		case TAG_ByteArray:
+		case TAG_IntArray:
+		case TAG_LongArray:
+		{
+			const size_t ItemSize = (a_Tag.m_Type == TAG_ByteArray) ? 1 : ((a_Tag.m_Type == TAG_IntArray) ? 4 : 8);
+			a_Tag.m_DataLength = static_cast<size_t>(NetworkBufToHost<int>(m_Data.data() + a_Pos)) * ItemSize;
+			a_Pos += 4;
+			break;
+		}
+		case TAG_List:
+		case TAG_Compound:
+		{
+			// Skip over the whole container using its extent remembered during validation:
+			const auto & Container = m_Containers[static_cast<size_t>(a_NextContainer)];
+			a_Tag.m_Container = a_NextContainer;
+			a_Tag.m_DataStart = a_Pos + ((a_Tag.m_Type == TAG_List) ? 5 : 0);
+			a_Tag.m_DataLength = Container.m_End - a_Tag.m_DataStart;
+			a_NextContainer += 1 + Container.m_NumDescendants;
+			return Container.m_End;
+		}
+		case TAG_End:
+		{
+			UNREACHABLE("Validated NBT contains a TAG_End item");
+		}
+	}
+	a_Tag.m_DataStart = a_Pos;
+	return a_Pos + a_Tag.m_DataLength;
 }
 
-#undef CASE_SIMPLE_TAG
+
+
+
+
+void cParsedNBT::IndexChildren(int a_Tag) const
+{
+	const auto NumChildren = m_Tags[static_cast<size_t>(a_Tag)].m_NumChildren;
+	size_t Size = 1;
+	while (Size < static_cast<size_t>(NumChildren) * 2)
+	{
+		Size *= 2;
+	}
+
+	// Insert the children in order, so that the first of the same-named children is found first:
+	const auto Start = m_ChildIndex.size();
+	m_ChildIndex.resize(Start + Size, -1);
+	for (int Child = m_Tags[static_cast<size_t>(a_Tag)].m_FirstChild; Child != -1; Child = m_Tags[static_cast<size_t>(Child)].m_NextSibling)
+	{
+		auto Slot = m_Tags[static_cast<size_t>(Child)].m_NameHash & (Size - 1);
+		while (m_ChildIndex[Start + Slot] != -1)
+		{
+			Slot = (Slot + 1) & (Size - 1);
+		}
+		m_ChildIndex[Start + Slot] = Child;
+	}
+	m_Tags[static_cast<size_t>(a_Tag)].m_ChildIndexStart = static_cast<int>(Start);
+}
 
 
 
 
 
-int cParsedNBT::FindChildByName(int a_Tag, const char * a_Name, size_t a_NameLength) const
+int cParsedNBT::FindChildByName(int a_Tag, const sNBTKey & a_Key) const
 {
 	if (a_Tag < 0)
 	{
@@ -401,21 +507,48 @@ int cParsedNBT::FindChildByName(int a_Tag, const char * a_Name, size_t a_NameLen
 		return -1;
 	}
 
-	if (a_NameLength == 0)
+	const auto & Tag = GetExpandedTag(a_Tag);
+	auto IsMatch = [this, &a_Key](int a_Child)
+	{
+		const auto & Child = m_Tags[static_cast<size_t>(a_Child)];
+		return (
+			(Child.m_NameHash == a_Key.m_Hash) &&
+			(Child.m_NameLength == a_Key.m_Name.size()) &&
+			(memcmp(m_Data.data() + Child.m_NameStart, a_Key.m_Name.data(), a_Key.m_Name.size()) == 0)
+		);
+	};
+
+	if (Tag.m_NumChildren < MIN_INDEXED_CHILDREN)
 	{
-		a_NameLength = strlen(a_Name);
+		for (int Child = Tag.m_FirstChild; Child != -1; Child = m_Tags[static_cast<size_t>(Child)].m_NextSibling)
+		{
+			if (IsMatch(Child))
+			{
+				return Child;
+			}
+		}  // for Child - children of a_Tag
+		return -1;
 	}
-	for (int Child = m_Tags[static_cast<size_t>(a_Tag)].m_FirstChild; Child != -1; Child = m_Tags[static_cast<size_t>(Child)].m_NextSibling)
+
+	// Look up the name in the index, build it on the first lookup:
+	if (Tag.m_ChildIndexStart < 0)
+	{
+		IndexChildren(a_Tag);
+	}
+	const auto Start = static_cast<size_t>(m_Tags[static_cast<size_t>(a_Tag)].m_ChildIndexStart);
+	size_t Size = 1;
+	while (Size < static_cast<size_t>(m_Tags[static_cast<size_t>(a_Tag)].m_NumChildren) * 2)
+	{
+		Size *= 2;
+	}
+	for (auto Slot = a_Key.m_Hash & (Size - 1);; Slot = (Slot + 1) & (Size - 1))
 	{
-		if (
-			(m_Tags[static_cast<size_t>(Child)].m_NameLength == a_NameLength) &&
-			(memcmp(m_Data.data() + m_Tags[static_cast<size_t>(Child)].m_NameStart, a_Name, a_NameLength) == 0)
-		)
+		const auto Child = m_ChildIndex[Start + Slot];
+		if ((Child == -1) || IsMatch(Child))
 		{
 			return Child;
 		}
-	}  // for Child - children of a_Tag
-	return -1;
+	}
 }
 
 
@@ -485,11 +618,13 @@ size_t cParsedNBT::GetMinTagSize(eTagType a_TagType)
 // cFastNBTWriter:
 
 cFastNBTWriter::cFastNBTWriter(const AString & a_RootTagName) :
-	m_CurrentStack(0)
+	m_CurrentStack(0),
+	m_NumAllocations(0),
+	m_NumBytesCopied(0)
 {
 	m_Stack[0].m_Type = TAG_Compound;
-	m_Result.reserve(100 KiB);
-	m_Result.push_back(std::byte(TAG_Compound));
+	Grow(100 KiB);
+	WriteByte(std::byte(TAG_Compound));
 	WriteString(a_RootTagName);
 }
 
@@ -498,11 +633,13 @@ cFastNBTWriter::cFastNBTWriter(const AString & a_RootTagName) :
 
 
 cFastNBTWriter::cFastNBTWriter(bool Network1_21) :
-	m_CurrentStack(0)
+	m_CurrentStack(0),
+	m_NumAllocations(0),
+	m_NumBytesCopied(0)
 {
 	m_Stack[0].m_Type = TAG_Compound;
-	m_Result.reserve(100 KiB);
-	m_Result.push_back(std::byte(TAG_Compound));
+	Grow(100 KiB);
+	WriteByte(std::byte(TAG_Compound));
 	if (!Network1_21)
 	{
 		WriteString("");
@@ -513,6 +650,23 @@ cFastNBTWriter::cFastNBTWriter(bool Network1_21) :
 
 
 
+cFastNBTWriter::cFastNBTWriter(ContiguousByteBuffer && a_Buffer, size_t a_ExpectedSize, const AString & a_RootTagName) :
+	m_CurrentStack(0),
+	m_Result(std::move(a_Buffer)),
+	m_NumAllocations(0),
+	m_NumBytesCopied(0)
+{
+	m_Stack[0].m_Type = TAG_Compound;
+	m_Result.clear();
+	Reserve(a_ExpectedSize);
+	WriteByte(std::byte(TAG_Compound));
+	WriteString(a_RootTagName);
+}
+
+
+
+
+
 void cFastNBTWriter::BeginCompound(const AString & a_Name)
 {
 	if (m_CurrentStack >= MAX_STACK - 1)
@@ -536,7 +690,7 @@ void cFastNBTWriter::EndCompound(void)
 	ASSERT(m_CurrentStack > 0);
 	ASSERT(IsStackTopCompound());
 
-	m_Result.push_back(std::byte(TAG_End));
+	WriteByte(std::byte(TAG_End));
 	--m_CurrentStack;
 }
 
@@ -554,8 +708,8 @@ void cFastNBTWriter::BeginList(const AString & a_Name, eTagType a_ChildrenType)
 
 	TagCommon(a_Name, TAG_List);
 
-	m_Result.push_back(std::byte(a_ChildrenType));
-	m_Result.append(4, std::byte(0));
+	WriteByte(std::byte(a_ChildrenType));
+	WriteNumber(static_cast<Int32>(0));
 
 	++m_CurrentStack;
 	m_Stack[m_CurrentStack].m_Type     = TAG_List;
@@ -587,7 +741,7 @@ void cFastNBTWriter::EndList(void)
 void cFastNBTWriter::AddByte(const AString & a_Name, unsigned char a_Value)
 {
 	TagCommon(a_Name, TAG_Byte);
-	m_Result.push_back(std::byte(a_Value));
+	WriteByte(std::byte(a_Value));
 }
 
 
@@ -597,8 +751,7 @@ void cFastNBTWriter::AddByte(const AString & a_Name, unsigned char a_Value)
 void cFastNBTWriter::AddShort(const AString & a_Name, Int16 a_Value)
 {
 	TagCommon(a_Name, TAG_Short);
-	auto Value = HostToNetwork(a_Value);
-	m_Result.append(Value.begin(), Value.end());
+	WriteNumber(a_Value);
 }
 
 
@@ -608,8 +761,7 @@ void cFastNBTWriter::AddShort(const AString & a_Name, Int16 a_Value)
 void cFastNBTWriter::AddInt(const AString & a_Name, Int32 a_Value)
 {
 	TagCommon(a_Name, TAG_Int);
-	auto Value = HostToNetwork(a_Value);
-	m_Result.append(Value.begin(), Value.end());
+	WriteNumber(a_Value);
 }
 
 
@@ -619,8 +771,7 @@ void cFastNBTWriter::AddInt(const AString & a_Name, Int32 a_Value)
 void cFastNBTWriter::AddLong(const AString & a_Name, Int64 a_Value)
 {
 	TagCommon(a_Name, TAG_Long);
-	auto Value = HostToNetwork(a_Value);
-	m_Result.append(Value.begin(), Value.end());
+	WriteNumber(a_Value);
 }
 
 
@@ -630,8 +781,7 @@ void cFastNBTWriter::AddLong(const AString & a_Name, Int64 a_Value)
 void cFastNBTWriter::AddFloat(const AString & a_Name, float a_Value)
 {
 	TagCommon(a_Name, TAG_Float);
-	auto Value = HostToNetwork(a_Value);
-	m_Result.append(Value.begin(), Value.end());
+	WriteNumber(a_Value);
 }
 
 
@@ -641,8 +791,7 @@ void cFastNBTWriter::AddFloat(const AString & a_Name, float a_Value)
 void cFastNBTWriter::AddDouble(const AString & a_Name, double a_Value)
 {
 	TagCommon(a_Name, TAG_Double);
-	auto Value = HostToNetwork(a_Value);
-	m_Result.append(Value.begin(), Value.end());
+	WriteNumber(a_Value);
 }
 
 
@@ -652,9 +801,8 @@ void cFastNBTWriter::AddDouble(const AString & a_Name, double a_Value)
 void cFastNBTWriter::AddString(const AString & a_Name, const std::string_view a_Value)
 {
 	TagCommon(a_Name, TAG_String);
-	auto Length = HostToNetwork(static_cast<UInt16>(a_Value.size()));
-	m_Result.append(Length.begin(), Length.end());
-	m_Result.append({ reinterpret_cast<const std::byte *>(a_Value.data()), a_Value.size() });
+	WriteNumber(static_cast<UInt16>(a_Value.size()));
+	WriteBytes(a_Value.data(), a_Value.size());
 }
 
 
@@ -664,9 +812,8 @@ void cFastNBTWriter::AddString(const AString & a_Name, const std::string_view a_
 void cFastNBTWriter::AddByteArray(const AString & a_Name, const char * a_Value, size_t a_NumElements)
 {
 	TagCommon(a_Name, TAG_ByteArray);
-	auto Length = HostToNetwork(static_cast<UInt32>(a_NumElements));
-	m_Result.append(Length.begin(), Length.end());
-	m_Result.append(reinterpret_cast<const std::byte *>(a_Value), a_NumElements);
+	WriteNumber(static_cast<UInt32>(a_NumElements));
+	WriteBytes(a_Value, a_NumElements);
 }
 
 
@@ -676,8 +823,8 @@ void cFastNBTWriter::AddByteArray(const AString & a_Name, const char * a_Value,
 void cFastNBTWriter::AddByteArray(const AString & a_Name, size_t a_NumElements, unsigned char a_Value)
 {
 	TagCommon(a_Name, TAG_ByteArray);
-	auto Length = HostToNetwork(static_cast<UInt32>(a_NumElements));
-	m_Result.append(Length.begin(), Length.end());
+	WriteNumber(static_cast<UInt32>(a_NumElements));
+	Reserve(a_NumElements);
 	m_Result.append(a_NumElements, std::byte(a_Value));
 }
 
@@ -688,18 +835,17 @@ void cFastNBTWriter::AddByteArray(const AString & a_Name, size_t a_NumElements,
 void cFastNBTWriter::AddIntArray(const AString & a_Name, const Int32 * a_Value, size_t a_NumElements)
 {
 	TagCommon(a_Name, TAG_IntArray);
-	auto Length = HostToNetwork(static_cast<UInt32>(a_NumElements));
-	size_t cap = m_Result.capacity();
-	size_t size = m_Result.length();
-	if ((cap - size) < (4 + a_NumElements * 4))
-	{
-		m_Result.reserve(size + 4 + (a_NumElements * 4));
-	}
-	m_Result.append(Length.begin(), Length.end());
+	WriteNumber(static_cast<UInt32>(a_NumElements));
+
+	// Convert the elements directly into the result, without appending them one by one:
+	Reserve(a_NumElements * 4);
+	const auto Start = m_Result.size();
+	m_Result.resize(Start + a_NumElements * 4);
+	auto Dest = m_Result.data() + Start;
 	for (size_t i = 0; i < a_NumElements; i++)
 	{
-		auto Element = HostToNetwork(a_Value[i]);
-		m_Result.append(Element.begin(), Element.end());
+		const auto Element = HostToNetwork(a_Value[i]);
+		std::memcpy(Dest + i * 4, Element.data(), 4);
 	}
 }
 
@@ -710,18 +856,17 @@ void cFastNBTWriter::AddIntArray(const AString & a_Name, const Int32 * a_Value,
 void cFastNBTWriter::AddLongArray(const AString & a_Name, const Int64 * a_Value, size_t a_NumElements)
 {
 	TagCommon(a_Name, TAG_LongArray);
-	auto Length = HostToNetwork(static_cast<UInt32>(a_NumElements));
-	size_t cap = m_Result.capacity();
-	size_t size = m_Result.length();
-	if ((cap - size) < (8 + a_NumElements * 8))
-	{
-		m_Result.reserve(size + 8 + (a_NumElements * 8));
-	}
-	m_Result.append(Length.begin(), Length.end());
+	WriteNumber(static_cast<UInt32>(a_NumElements));
+
+	// Convert the elements directly into the result, without appending them one by one:
+	Reserve(a_NumElements * 8);
+	const auto Start = m_Result.size();
+	m_Result.resize(Start + a_NumElements * 8);
+	auto Dest = m_Result.data() + Start;
 	for (size_t i = 0; i < a_NumElements; i++)
 	{
-		auto Element = HostToNetwork(a_Value[i]);
-		m_Result.append(Element.begin(), Element.end());
+		const auto Element = HostToNetwork(a_Value[i]);
+		std::memcpy(Dest + i * 8, Element.data(), 8);
 	}
 }
 
@@ -732,7 +877,7 @@ void cFastNBTWriter::AddLongArray(const AString & a_Name, const Int64 * a_Value,
 void cFastNBTWriter::Finish(void)
 {
 	ASSERT(m_CurrentStack == 0);
-	m_Result.push_back(std::byte(TAG_End));
+	WriteByte(std::byte(TAG_End));
 }
 
 
@@ -742,7 +887,18 @@ void cFastNBTWriter::Finish(void)
 void cFastNBTWriter::WriteString(const std::string_view a_Data)
 {
 	// TODO check size <= short max
-	auto Length = HostToNetwork(static_cast<UInt16>(a_Data.size()));
-	m_Result.append(Length.begin(), Length.end());
-	m_Result.append(reinterpret_cast<const std::byte *>(a_Data.data()), a_Data.size());
+	WriteNumber(static_cast<UInt16>(a_Data.size()));
+	WriteBytes(a_Data.data(), a_Data.size());
+}
+
+
+
+
+
+void cFastNBTWriter::Grow(size_t a_NumBytes)
+{
+	const auto Size = m_Result.size();
+	m_Result.reserve(std::max(Size + a_NumBytes, m_Result.capacity() * 2));
+	m_NumAllocations += 1;
+	m_NumBytesCopied += Size;
 }
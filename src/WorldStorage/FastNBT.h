@@ -11,6 +11,8 @@ The structures have a minimal constructor, setting all member "pointers" to "inv
 The fast writer doesn't need a NBT tree structure built beforehand, it is commanded to open, append and close tags
 (just like XML); it keeps the internal tag stack and reports errors in usage.
 It directly outputs a string containing the serialized NBT data.
+The writer can take over an existing buffer and give it back when done, so that the callers serializing
+many NBTs in a row (such as the chunk saving) can reuse the same buffer instead of allocating a new one each time.
 */
 
 
@@ -63,6 +65,7 @@ public:
 
 	// The following members are indices into the data stream. m_DataLength == 0 if no data available
 	// They must not be pointers, because the datastream may be copied into another AString object in the meantime.
+	// For Compound and List tags, the data is the tag's payload following the name (and the List header).
 	size_t m_NameStart;
 	size_t m_NameLength;
 	size_t m_DataStart;
@@ -76,17 +79,20 @@ public:
 	int m_FirstChild;
 	int m_LastChild;
 
+	/** The hash of the name, as calculated by sNBTKey. */
+	UInt32 m_NameHash;
+
+	/** For Compound and List tags, the index into cParsedNBT::m_Containers. */
+	int m_Container;
+
+	/** The number of the children; -1 for Compound and List tags whose children haven't been parsed into tags yet. */
+	int m_NumChildren;
+
+	/** For Compound tags with many children, the start of their name index in cParsedNBT::m_ChildIndex; -1 if not indexed. */
+	int m_ChildIndexStart;
+
 	cFastNBTTag(eTagType a_Type, int a_Parent) :
-		m_Type(a_Type),
-		m_NameStart(0),
-		m_NameLength(0),
-		m_DataStart(0),
-		m_DataLength(0),
-		m_Parent(a_Parent),
-		m_PrevSibling(-1),
-		m_NextSibling(-1),
-		m_FirstChild(-1),
-		m_LastChild(-1)
+		cFastNBTTag(a_Type, a_Parent, -1)
 	{
 	}
 
@@ -100,7 +106,11 @@ public:
 		m_PrevSibling(a_PrevSibling),
 		m_NextSibling(-1),
 		m_FirstChild(-1),
-		m_LastChild(-1)
+		m_LastChild(-1),
+		m_NameHash(0),
+		m_Container(-1),
+		m_NumChildren(((a_Type == TAG_Compound) || (a_Type == TAG_List)) ? -1 : 0),
+		m_ChildIndexStart(-1)
 	{
 	}
 } ;
@@ -109,6 +119,41 @@ public:
 
 
 
+/** The name of a tag, together with its hash, used for looking up the tags by name.
+The keys for the names known in advance are best created at compile time using the _nbt literal,
+such as a_NBT.FindChildByName(a_Tag, "Pos"_nbt), so that the hash is not recalculated on each lookup. */
+struct sNBTKey
+{
+	std::string_view m_Name;
+	UInt32 m_Hash;
+
+	constexpr sNBTKey(std::string_view a_Name) :
+		m_Name(a_Name),
+		m_Hash(Hash(a_Name))
+	{
+	}
+
+	/** Returns the FNV-1a hash of the name. */
+	static constexpr UInt32 Hash(std::string_view a_Name)
+	{
+		UInt32 Res = 2166136261u;
+		for (auto Ch: a_Name)
+		{
+			Res = (Res ^ static_cast<unsigned char>(Ch)) * 16777619u;
+		}
+		return Res;
+	}
+} ;
+
+constexpr sNBTKey operator ""_nbt(const char * a_Name, size_t a_Length)
+{
+	return sNBTKey(std::string_view(a_Name, a_Length));
+}
+
+
+
+
+
 enum class eNBTParseError
 {
 	npSuccess = 0,
@@ -149,6 +194,12 @@ The parser decomposes the input data into a tree of tags that is stored as an ar
 and accessing the tree is done by using the array indices for tags. Each tag stores the indices for its parent,
 first child, last child, prev sibling and next sibling, a value of -1 indicates that the indice is not valid.
 Each primitive tag also stores the length of the contained data, in bytes.
+
+The whole data is validated in the constructor, but without creating the tags; only the extents of the Compound and List tags
+are remembered. The children of a Compound or List are parsed into tags the first time they are accessed,
+so the subtrees that the caller never looks into cost only the validation. The children of large Compounds
+are indexed by their name hashes on the first lookup by name. Because of this, the accessors modify the internal state
+and a single instance must not be accessed from multiple threads at the same time.
 */
 class cParsedNBT
 {
@@ -167,10 +218,10 @@ public:
 	int GetRoot(void) const { return 0; }
 
 	/** Returns the first child of the specified tag, or -1 if none / not applicable. */
-	int GetFirstChild (int a_Tag) const { return m_Tags[static_cast<size_t>(a_Tag)].m_FirstChild; }
+	int GetFirstChild (int a_Tag) const { return GetExpandedTag(a_Tag).m_FirstChild; }
 
 	/** Returns the last child of the specified tag, or -1 if none / not applicable. */
-	int GetLastChild  (int a_Tag) const { return m_Tags[static_cast<size_t>(a_Tag)].m_LastChild; }
+	int GetLastChild  (int a_Tag) const { return GetExpandedTag(a_Tag).m_LastChild; }
 
 	/** Returns the next sibling of the specified tag, or -1 if none. */
 	int GetNextSibling(int a_Tag) const { return m_Tags[static_cast<size_t>(a_Tag)].m_NextSibling; }
@@ -178,6 +229,9 @@ public:
 	/** Returns the previous sibling of the specified tag, or -1 if none. */
 	int GetPrevSibling(int a_Tag) const { return m_Tags[static_cast<size_t>(a_Tag)].m_PrevSibling; }
 
+	/** Returns the number of children of the specified tag, 0 if not applicable. */
+	int GetNumChildren(int a_Tag) const { return GetExpandedTag(a_Tag).m_NumChildren; }
+
 	/** Returns the length of the tag's data, in bytes.
 	Not valid for Compound or List tags! */
 	size_t GetDataLength(int a_Tag) const
@@ -196,14 +250,20 @@ public:
 		return m_Data.data() + m_Tags[static_cast<size_t>(a_Tag)].m_DataStart;
 	}
 
+	/** Returns the direct child tag of the specified name, or -1 if no such tag. */
+	int FindChildByName(int a_Tag, const sNBTKey & a_Key) const;
+
 	/** Returns the direct child tag of the specified name, or -1 if no such tag. */
 	int FindChildByName(int a_Tag, const AString & a_Name) const
 	{
-		return FindChildByName(a_Tag, a_Name.c_str(), a_Name.length());
+		return FindChildByName(a_Tag, sNBTKey(a_Name));
 	}
 
 	/** Returns the direct child tag of the specified name, or -1 if no such tag. */
-	int FindChildByName(int a_Tag, const char * a_Name, size_t a_NameLength = 0) const;
+	int FindChildByName(int a_Tag, const char * a_Name, size_t a_NameLength = 0) const
+	{
+		return FindChildByName(a_Tag, sNBTKey(std::string_view(a_Name, (a_NameLength == 0) ? strlen(a_Name) : a_NameLength)));
+	}
 
 	/** Returns the child tag of the specified path (Name1 / Name2 / Name3...), or -1 if no such tag. */
 	int FindTagByPath(int a_Tag, const AString & a_Path) const;
@@ -213,8 +273,9 @@ public:
 	/** Returns the children type for a List tag; undefined on other tags. If list empty, returns TAG_End. */
 	eTagType GetChildrenType(int a_Tag) const
 	{
-		ASSERT(m_Tags[static_cast<size_t>(a_Tag)].m_Type == TAG_List);
-		return (m_Tags[static_cast<size_t>(a_Tag)].m_FirstChild < 0) ? TAG_End : m_Tags[static_cast<size_t>(m_Tags[static_cast<size_t>(a_Tag)].m_FirstChild)].m_Type;
+		const auto & Tag = GetExpandedTag(a_Tag);
+		ASSERT(Tag.m_Type == TAG_List);
+		return (Tag.m_FirstChild < 0) ? TAG_End : m_Tags[static_cast<size_t>(Tag.m_FirstChild)].m_Type;
 	}
 
 	/** Returns the value stored in a Byte tag. Not valid for any other tag type. */
@@ -297,18 +358,72 @@ public:
 
 protected:
 
+	/** The extent of a Compound or List tag, found while validating the data.
+	The containers are stored in the order in which they appear in the data (pre-order), so the first child container
+	of container N is N + 1 and its next sibling container is N + 1 + m_NumDescendants. */
+	struct sContainer
+	{
+		/** The position in the data just after the container's payload. */
+		size_t m_End;
+
+		/** The number of containers nested anywhere inside this one. */
+		int m_NumDescendants;
+	} ;
+
+	/** Compounds with at least this many children get their names indexed on the first lookup by name. */
+	static const int MIN_INDEXED_CHILDREN = 8;
+
 	ContiguousByteBufferView m_Data;
-	std::vector<cFastNBTTag> m_Tags;
-	eNBTParseError           m_Error;  // npSuccess if parsing succeeded
+
+	/** The tags parsed so far. Grows as the Compounds and Lists are expanded by the accessors. */
+	mutable std::vector<cFastNBTTag> m_Tags;
+
+	/** The extents of all the Compound and List tags in the data. */
+	std::vector<sContainer> m_Containers;
+
+	/** The open-addressing name indices of the large Compounds, the items are tag indices, -1 for empty slots. */
+	mutable std::vector<int> m_ChildIndex;
+
+	eNBTParseError m_Error;  // npSuccess if parsing succeeded
 
 	// Used while parsing:
 	size_t m_Pos;
 
+	/** The number of tags in the whole tree, counted while validating; m_Tags never needs more than this. */
+	size_t m_NumTagsInData;
+
 	eNBTParseError Parse(void);
 	eNBTParseError ReadString(size_t & a_StringStart, size_t & a_StringLen);  // Reads a simple string (2 bytes length + data), sets the string descriptors
-	eNBTParseError ReadCompound(void);  // Reads the latest tag as a compound
-	eNBTParseError ReadList(eTagType a_ChildrenType);  // Reads the latest tag as a list of items of type a_ChildrenType
-	eNBTParseError ReadTag(void);       // Reads the latest tag, depending on its m_Type setting
+
+	/** Validates a compound's children and remembers its extent, without creating any tags. */
+	eNBTParseError SkipCompound(void);
+
+	/** Validates a list's items of type a_ChildrenType and remembers its extent, without creating any tags. */
+	eNBTParseError SkipList(eTagType a_ChildrenType);
+
+	/** Validates a tag's payload, depending on its type. */
+	eNBTParseError SkipTag(eTagType a_TagType);
+
+	/** Returns the tag, with its children parsed into tags if it is a Compound or List. */
+	const cFastNBTTag & GetExpandedTag(int a_Tag) const
+	{
+		if (m_Tags[static_cast<size_t>(a_Tag)].m_NumChildren < 0)
+		{
+			Expand(a_Tag);
+		}
+		return m_Tags[static_cast<size_t>(a_Tag)];
+	}
+
+	/** Parses the direct children of the Compound or List tag into tags. The data has already been validated. */
+	void Expand(int a_Tag) const;
+
+	/** Sets the data extent of the newly created tag whose payload starts at a_Pos.
+	a_NextContainer is the index of the next container in m_Containers, updated if the tag is a container.
+	Returns the position just after the tag's payload. */
+	size_t ExpandTag(cFastNBTTag & a_Tag, size_t a_Pos, int & a_NextContainer) const;
+
+	/** Builds the name index of the children of the specified Compound tag. */
+	void IndexChildren(int a_Tag) const;
 
 	/** Returns the minimum size, in bytes, of the specified tag type.
 	Used for sanity-checking. */
@@ -325,6 +440,11 @@ public:
 	cFastNBTWriter(const AString & a_RootTagName = "");
 	cFastNBTWriter(bool Network1_21);
 
+	/** Creates a writer that writes into a_Buffer, reusing its storage.
+	The buffer is cleared and reserved to hold at least a_ExpectedSize bytes; the size of a previous similar NBT is a good estimate.
+	Use TakeResult() to get the buffer back for the next use. */
+	cFastNBTWriter(ContiguousByteBuffer && a_Buffer, size_t a_ExpectedSize, const AString & a_RootTagName = "");
+
 	void BeginCompound(const AString & a_Name);
 	void EndCompound(void);
 
@@ -350,8 +470,17 @@ public:
 
 	ContiguousByteBufferView GetResult(void) const { return m_Result; }
 
+	/** Moves the result out of the writer, so that its storage can be reused. The writer must not be used afterwards. */
+	ContiguousByteBuffer TakeResult(void) { return std::move(m_Result); }
+
 	void Finish(void);
 
+	/** Returns the number of times the result buffer was (re)allocated, including the initial reservation. */
+	size_t GetNumAllocations(void) const { return m_NumAllocations; }
+
+	/** Returns the number of bytes copied when growing the result buffer. */
+	size_t GetNumBytesCopied(void) const { return m_NumBytesCopied; }
+
 protected:
 
 	struct sParent
@@ -370,10 +499,51 @@ protected:
 
 	ContiguousByteBuffer m_Result;
 
+	/** The number of times m_Result was (re)allocated. */
+	size_t m_NumAllocations;
+
+	/** The number of bytes copied while reallocating m_Result. */
+	size_t m_NumBytesCopied;
+
 	bool IsStackTopCompound(void) const { return (m_Stack[m_CurrentStack].m_Type == TAG_Compound); }
 
 	void WriteString(std::string_view a_Data);
 
+	/** Makes sure there's space for a_NumBytes more bytes in m_Result, so that appending them doesn't reallocate.
+	All the writes go through this so that the reallocations are counted. */
+	inline void Reserve(size_t a_NumBytes)
+	{
+		if (m_Result.size() + a_NumBytes > m_Result.capacity())
+		{
+			Grow(a_NumBytes);
+		}
+	}
+
+	/** Reallocates m_Result to have space for at least a_NumBytes more bytes, growing geometrically. */
+	void Grow(size_t a_NumBytes);
+
+	/** Appends a single byte. */
+	inline void WriteByte(std::byte a_Value)
+	{
+		Reserve(1);
+		m_Result.push_back(a_Value);
+	}
+
+	/** Appends raw bytes. */
+	inline void WriteBytes(const void * a_Data, size_t a_NumBytes)
+	{
+		Reserve(a_NumBytes);
+		m_Result.append(static_cast<const std::byte *>(a_Data), a_NumBytes);
+	}
+
+	/** Appends a number in the big-endian byte order. */
+	template <typename Value>
+	inline void WriteNumber(Value a_Value)
+	{
+		const auto Bytes = HostToNetwork(a_Value);
+		WriteBytes(Bytes.data(), Bytes.size());
+	}
+
 	inline void TagCommon(const AString & a_Name, eTagType a_Type)
 	{
 		// If we're directly inside a list, check that the list is of the correct type:
@@ -382,7 +552,7 @@ protected:
 		if (IsStackTopCompound())
 		{
 			// Compound: add the type and name:
-			m_Result.push_back(std::byte(a_Type));
+			WriteByte(std::byte(a_Type));
 			WriteString(a_Name);
 		}
 		else
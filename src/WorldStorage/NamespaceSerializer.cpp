@@ -3,11 +3,30 @@
 #include <regex>
 
 #include "NamespaceSerializer.h"
+#include "PerfectHashTable.h"
 
 #include <cctype>
 
 
 
+
+
+namespace
+{
+	/** Returns the ID without the "minecraft:" namespace prefix, if present, without copying it. */
+	std::string_view WithoutVanillaNamespace(std::string_view a_ID)
+	{
+		static const std::string_view VanillaNamespace = "minecraft:";
+		if (a_ID.substr(0, VanillaNamespace.size()) == VanillaNamespace)
+		{
+			a_ID.remove_prefix(VanillaNamespace.size());
+		}
+		return a_ID;
+	}
+}
+
+
+
 unsigned NamespaceSerializer::DataVersion()
 {
 	return 3953;
@@ -2840,7 +2859,7 @@ std::string_view NamespaceSerializer::From(cEntityEffect::eType a_ID)
 
 BlockType NamespaceSerializer::ToBlockType(std::string_view a_ID)
 {
-	static const std::unordered_map<std::string_view, BlockType> BlockTypes
+	static const cPerfectHashTable<BlockType> BlockTypes
 	{
 		{ "acacia_button",                     BlockType::AcaciaButton },
 		{ "acacia_door",                       BlockType::AcaciaDoor },
@@ -3961,15 +3980,12 @@ BlockType NamespaceSerializer::ToBlockType(std::string_view a_ID)
 		{ "deadbush",                            BlockType::DeadBush },
 	};
 
-	try
+	if (const auto Res = BlockTypes.Find(WithoutVanillaNamespace(a_ID)); Res != nullptr)
 	{
-		return BlockTypes.at(a_ID);
-	}
-	catch (...)
-	{
-		FLOGWARNING("Tried to read unknown block type {}, returning air!", a_ID);
-		return BlockType::Air;
+		return *Res;
 	}
+	FLOGWARNING("Tried to read unknown block type {}, returning air!", a_ID);
+	return BlockType::Air;
 }
 
 
@@ -3978,7 +3994,7 @@ BlockType NamespaceSerializer::ToBlockType(std::string_view a_ID)
 
 CustomStatistic NamespaceSerializer::ToCustomStatistic(const std::string_view a_ID)
 {
-	static const std::unordered_map<std::string_view, CustomStatistic> CustomStatistics
+	static const cPerfectHashTable<CustomStatistic> CustomStatistics
 	{
 		{ "animals_bred",                   CustomStatistic::AnimalsBred },
 		{ "aviate_one_cm",                  CustomStatistic::AviateOneCm },
@@ -4095,15 +4111,12 @@ CustomStatistic NamespaceSerializer::ToCustomStatistic(const std::string_view a_
 		{ "cuberite:achievement.breedCow",           CustomStatistic::AchBreedCow },
 		{ "cuberite:achievement.diamondsToYou",      CustomStatistic::AchDiamondsToYou}
 	};
-	try
+	if (const auto Res = CustomStatistics.Find(WithoutVanillaNamespace(a_ID)); Res != nullptr)
 	{
-		return CustomStatistics.at(a_ID);
-	}
-	catch (...)
-	{
-		FLOGWARNING("Tried to read unknown custom statistic {}, returning walk one cm!", a_ID);
-		return CustomStatistic::WalkOneCm;
+		return *Res;
 	}
+	FLOGWARNING("Tried to read unknown custom statistic {}, returning walk one cm!", a_ID);
+	return CustomStatistic::WalkOneCm;
 }
 
 
@@ -4112,7 +4125,7 @@ CustomStatistic NamespaceSerializer::ToCustomStatistic(const std::string_view a_
 
 Item NamespaceSerializer::ToItem(const std::string_view a_ID)
 {
-	static const std::unordered_map<std::string_view, Item> ItemNames =
+	static const cPerfectHashTable<Item> ItemNames =
 	{
 		{ "acacia_boat",                           Item::AcaciaBoat },
 		{ "acacia_button",                         Item::AcaciaButton },
@@ -5677,29 +5690,27 @@ Item NamespaceSerializer::ToItem(const std::string_view a_ID)
 		{ "carpet",                              Item::WhiteCarpet },
 	};
 
-	try
+	if (a_ID.size() == 0)
 	{
-		if (a_ID.size() == 0)
-		{
-			FLOGWARNING("Tried to read empty, returning Air!", a_ID);
-			return Item::Air;
-		}
+		FLOGWARNING("Tried to read empty, returning Air!", a_ID);
+		return Item::Air;
+	}
 
-		return ItemNames.at(a_ID);
+	if (const auto Res = ItemNames.Find(WithoutVanillaNamespace(a_ID)); Res != nullptr)
+	{
+		return *Res;
 	}
-	catch (...)
+
+	if (IsPretty(a_ID))
 	{
-		if (IsPretty(a_ID))
+		auto Res = ToItem(DePrettify(a_ID));
+		if (Res != Item::Air)
 		{
-			auto Res = ToItem(DePrettify(a_ID));
-			if (Res != Item::Air)
-			{
-				return Res;
-			}
+			return Res;
 		}
-		FLOGWARNING("Tried to read unknown item {}, returning Air!", a_ID);
-		return Item::Air;
 	}
+	FLOGWARNING("Tried to read unknown item {}, returning Air!", a_ID);
+	return Item::Air;
 }
 
 
@@ -5708,7 +5719,7 @@ Item NamespaceSerializer::ToItem(const std::string_view a_ID)
 
 eMonsterType NamespaceSerializer::ToMonsterType(const std::string_view a_ID)
 {
-	static const std::unordered_map<std::string_view, eMonsterType> MonsterTypes
+	static const cPerfectHashTable<eMonsterType> MonsterTypes
 	{
 		{ "bat",              mtBat },
 		{ "blaze",            mtBlaze },
@@ -5821,15 +5832,12 @@ eMonsterType NamespaceSerializer::ToMonsterType(const std::string_view a_ID)
 		{ "PigZombie",      mtZombiePigman },
 		{ "ZombieVillager", mtZombieVillager }
 	};
-	try
-	{
-		return MonsterTypes.at(a_ID);
-	}
-	catch (...)
+	if (const auto Res = MonsterTypes.Find(WithoutVanillaNamespace(a_ID)); Res != nullptr)
 	{
-		FLOGWARNING("Tried to read unknown monster type {}, returning cow", a_ID);
-		return mtCow;
+		return *Res;
 	}
+	FLOGWARNING("Tried to read unknown monster type {}, returning cow", a_ID);
+	return mtCow;
 }
 
 
@@ -5838,7 +5846,7 @@ eMonsterType NamespaceSerializer::ToMonsterType(const std::string_view a_ID)
 
 cEntityEffect::eType NamespaceSerializer::ToEntityEffect(std::string_view a_ID)
 {
-	static const std::unordered_map<std::string_view, cEntityEffect::eType> EffectTypes
+	static const cPerfectHashTable<cEntityEffect::eType> EffectTypes
 	{
 		{ "speed",               cEntityEffect::eType::effSpeed},
 		{ "slowness",            cEntityEffect::eType::effSlowness},
@@ -5884,15 +5892,12 @@ cEntityEffect::eType NamespaceSerializer::ToEntityEffect(std::string_view a_ID)
 		{ "infested",            cEntityEffect::eType::effInfested},
 		*/
 	};
-	try
-	{
-		return EffectTypes.at(a_ID);
-	}
-	catch (...)
+	if (const auto Res = EffectTypes.Find(WithoutVanillaNamespace(a_ID)); Res != nullptr)
 	{
-		FLOGWARNING("Tried to read unknown effect type {}, returning effNoEffect", a_ID);
-		return cEntityEffect::eType::effNoEffect;
+		return *Res;
 	}
+	FLOGWARNING("Tried to read unknown effect type {}, returning effNoEffect", a_ID);
+	return cEntityEffect::eType::effNoEffect;
 }
 
 
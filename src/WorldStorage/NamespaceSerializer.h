@@ -25,6 +25,8 @@ namespace NamespaceSerializer
 	std::string_view From(Item a_ID);
 	std::string_view From(cEntityEffect::eType a_ID);
 
+	// The To* functions look the IDs up in perfect hash tables, built on first use.
+	// They accept the IDs both with and without the "minecraft:" namespace prefix.
 	BlockType ToBlockType(std::string_view a_ID);
 	CustomStatistic ToCustomStatistic(std::string_view a_ID);
 	Item ToItem(std::string_view a_ID);
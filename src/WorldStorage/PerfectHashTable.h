@@ -0,0 +1,203 @@
+
+// PerfectHashTable.h
+
+// Declares the cPerfectHashTable class template, a read-only string-keyed table with collision-free lookups
+
+
+
+
+
+#pragma once
+
+
+
+
+
+/** A read-only table mapping string keys to values, looked up through a perfect hash.
+Uses the "hash and displace" scheme: the key hash selects a bucket, and each bucket stores a displacement
+that was chosen when building the table so that all its keys land in distinct, otherwise unused slots.
+A lookup is therefore a single hash of the key, two array reads and a single key comparison, without any probing.
+The entries themselves are stored densely, the slots only hold 16-bit indices into them.
+The table is built once, when constructed; the keys must outlive the table (they are usually string literals). */
+template <typename T>
+class cPerfectHashTable
+{
+public:
+
+	using cEntry = std::pair<std::string_view, T>;
+
+
+	cPerfectHashTable(std::initializer_list<cEntry> a_Entries) :
+		cPerfectHashTable(std::vector<cEntry>(a_Entries))
+	{
+	}
+
+
+	/** Builds the table. If a key is present multiple times, the first entry is used. */
+	explicit cPerfectHashTable(std::vector<cEntry> a_Entries)
+	{
+		// Remove the duplicate keys, keeping the first occurrence:
+		std::unordered_set<std::string_view> Seen;
+		for (auto & Entry: a_Entries)
+		{
+			if (Seen.insert(Entry.first).second)
+			{
+				m_Entries.push_back(std::move(Entry));
+			}
+		}
+		ASSERT(m_Entries.size() < EMPTY_SLOT);
+
+		// Start with about two keys per bucket and a load factor below one half, grow if the keys cannot be placed:
+		size_t NumBuckets = 1;
+		while (NumBuckets * 2 < m_Entries.size())
+		{
+			NumBuckets *= 2;
+		}
+		while (!Build(NumBuckets, NumBuckets * 4))
+		{
+			NumBuckets *= 2;
+		}
+	}
+
+
+	/** Returns the value for the key, or nullptr if the key is not in the table. */
+	const T * Find(std::string_view a_Key) const
+	{
+		const auto Hash = HashKey(a_Key);
+		const auto Index = m_Slots[GetSlot(Hash, m_Displacements[Hash & m_BucketMask])];
+		if ((Index == EMPTY_SLOT) || (m_Entries[Index].first != a_Key))
+		{
+			return nullptr;
+		}
+		return &m_Entries[Index].second;
+	}
+
+
+	/** Returns the number of distinct keys in the table. */
+	size_t GetSize(void) const { return m_Entries.size(); }
+
+
+	/** Returns the hash of the key; reads the key eight bytes at a time and mixes the bits once at the end. */
+	static UInt64 HashKey(std::string_view a_Key)
+	{
+		UInt64 Hash = a_Key.size() * 0x9e3779b97f4a7c15ULL;
+		size_t i = 0;
+		for (; i + 8 <= a_Key.size(); i += 8)
+		{
+			UInt64 Chunk;
+			std::memcpy(&Chunk, a_Key.data() + i, 8);
+			Hash = (Hash ^ Chunk) * 0xff51afd7ed558ccdULL;
+			Hash ^= Hash >> 29;
+		}
+		if (i < a_Key.size())
+		{
+			UInt64 Chunk = 0;
+			std::memcpy(&Chunk, a_Key.data() + i, a_Key.size() - i);
+			Hash = (Hash ^ Chunk) * 0xff51afd7ed558ccdULL;
+		}
+		return MixHash(Hash);
+	}
+
+protected:
+
+	/** The marker for an unused slot. */
+	static constexpr UInt16 EMPTY_SLOT = 0xffff;
+
+	/** The entries, without duplicate keys. */
+	std::vector<cEntry> m_Entries;
+
+	/** The displacement for each bucket. */
+	std::vector<UInt16> m_Displacements;
+
+	/** The slots, each one either EMPTY_SLOT or an index into m_Entries. */
+	std::vector<UInt16> m_Slots;
+
+	UInt64 m_BucketMask;
+	UInt64 m_SlotMask;
+
+
+	/** The SplitMix64 finalizer, spreads the hash bits over the whole value. */
+	static UInt64 MixHash(UInt64 a_Value)
+	{
+		a_Value = (a_Value ^ (a_Value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		a_Value = (a_Value ^ (a_Value >> 27)) * 0x94d049bb133111ebULL;
+		return a_Value ^ (a_Value >> 31);
+	}
+
+
+	/** Returns the slot for the specified key hash and bucket displacement. */
+	UInt64 GetSlot(UInt64 a_Hash, UInt16 a_Displacement) const
+	{
+		return MixHash(a_Hash + a_Displacement * 0x9e3779b97f4a7c15ULL) & m_SlotMask;
+	}
+
+
+	/** Tries to place all the entries into a table of the specified size (both must be powers of two).
+	Returns false if a bucket couldn't be placed with any displacement. */
+	bool Build(size_t a_NumBuckets, size_t a_NumSlots)
+	{
+		m_BucketMask = a_NumBuckets - 1;
+		m_SlotMask = a_NumSlots - 1;
+		m_Displacements.assign(a_NumBuckets, 0);
+		m_Slots.assign(a_NumSlots, EMPTY_SLOT);
+
+		// Distribute the keys into buckets, place the largest buckets first:
+		std::vector<UInt64> Hashes;
+		std::vector<std::vector<UInt16>> Buckets(a_NumBuckets);
+		for (size_t i = 0; i < m_Entries.size(); i++)
+		{
+			Hashes.push_back(HashKey(m_Entries[i].first));
+			Buckets[Hashes.back() & m_BucketMask].push_back(static_cast<UInt16>(i));
+		}
+		std::vector<size_t> Order(a_NumBuckets);
+		for (size_t i = 0; i < a_NumBuckets; i++)
+		{
+			Order[i] = i;
+		}
+		std::stable_sort(Order.begin(), Order.end(), [&Buckets](size_t a_Bucket1, size_t a_Bucket2)
+			{
+				return (Buckets[a_Bucket1].size() > Buckets[a_Bucket2].size());
+			}
+		);
+
+		// Find a displacement for each bucket that puts all its keys into free slots:
+		std::vector<UInt64> Slots;
+		for (auto BucketIdx: Order)
+		{
+			const auto & Bucket = Buckets[BucketIdx];
+			if (Bucket.empty())
+			{
+				break;
+			}
+			bool HasPlaced = false;
+			for (UInt32 Displacement = 0; (Displacement < EMPTY_SLOT) && !HasPlaced; Displacement++)
+			{
+				Slots.clear();
+				for (auto Idx: Bucket)
+				{
+					auto Slot = GetSlot(Hashes[Idx], static_cast<UInt16>(Displacement));
+					if ((m_Slots[Slot] != EMPTY_SLOT) || (std::find(Slots.begin(), Slots.end(), Slot) != Slots.end()))
+					{
+						break;
+					}
+					Slots.push_back(Slot);
+				}
+				if (Slots.size() != Bucket.size())
+				{
+					continue;
+				}
+				for (size_t i = 0; i < Bucket.size(); i++)
+				{
+					m_Slots[Slots[i]] = Bucket[i];
+				}
+				m_Displacements[BucketIdx] = static_cast<UInt16>(Displacement);
+				HasPlaced = true;
+			}
+			if (!HasPlaced)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+} ;
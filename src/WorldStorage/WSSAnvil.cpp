@@ -85,7 +85,13 @@ Since only the header is actually in the memory, this number can be high, but st
 
 cWSSAnvil::cWSSAnvil(cWorld * a_World, int a_CompressionFactor):
 	Super(a_World),
-	m_Compressor(a_CompressionFactor)
+	m_Compressor(a_CompressionFactor),
+	m_NBTSizeEstimate(100 KiB),
+	m_NumSavedChunks(0),
+	m_NumSaveAllocations(0),
+	m_NumSaveBytesCopied(0),
+	m_NumSaveBytesSerialized(0),
+	m_NumSaveBytesCompressed(0)
 {
 	// Create a level.dat file for mapping tools, if it doesn't already exist:
 	auto fnam = fmt::format(FMT_STRING("{}{}level.dat"), a_World->GetDataPath(), cFile::PathSeparator());
@@ -153,7 +159,7 @@ bool cWSSAnvil::SaveChunk(const cChunkCoords & a_Chunk)
 {
 	try
 	{
-		if (!SetChunkData(a_Chunk, SaveChunkToData(a_Chunk).GetView()))
+		if (!SetChunkData(a_Chunk, SaveChunkToData(a_Chunk)))
 		{
 			LOGWARNING("Cannot store chunk [%d, %d] data", a_Chunk.m_ChunkX, a_Chunk.m_ChunkZ);
 			return false;
@@ -332,13 +338,57 @@ bool cWSSAnvil::LoadChunkFromData(const cChunkCoords & a_Chunk, const Contiguous
 
 
 
-Compression::Result cWSSAnvil::SaveChunkToData(const cChunkCoords & a_Chunk)
+sChunkSaveStats cWSSAnvil::GetSaveStats(void) const
 {
-	cFastNBTWriter Writer;
+	sChunkSaveStats Res;
+	Res.m_NumChunks = m_NumSavedChunks;
+	Res.m_NumAllocations = m_NumSaveAllocations;
+	Res.m_NumBytesCopied = m_NumSaveBytesCopied;
+	Res.m_NumBytesSerialized = m_NumSaveBytesSerialized;
+	Res.m_NumBytesCompressed = m_NumSaveBytesCompressed;
+	return Res;
+}
+
+
+
+
+
+ContiguousByteBufferView cWSSAnvil::SaveChunkToData(const cChunkCoords & a_Chunk)
+{
+	// If a huge chunk made the buffer much larger than the chunks usually need, release the excess:
+	size_t NumAllocations = 0;
+	if (m_NBTBuffer.capacity() > 4 * m_NBTSizeEstimate)
+	{
+		ContiguousByteBuffer().swap(m_NBTBuffer);
+	}
+
+	// Serialize into the reused buffer, presized for the expected size:
+	cFastNBTWriter Writer(std::move(m_NBTBuffer), m_NBTSizeEstimate);
 	NBTChunkSerializer::Serialize(*m_World, a_Chunk, Writer);
 	Writer.Finish();
+	NumAllocations += Writer.GetNumAllocations();
+	m_NumSaveBytesCopied += Writer.GetNumBytesCopied();
+	m_NBTBuffer = Writer.TakeResult();
 
-	return m_Compressor.CompressZLib(Writer.GetResult());
+	// Compress directly from the NBT buffer into the reused output buffer:
+	const auto OldCapacity = m_CompressedBuffer.capacity();
+	const auto OldSize = m_CompressedBuffer.size();
+	const auto Compressed = m_Compressor.CompressZLib(m_NBTBuffer, m_CompressedBuffer);
+	if (m_CompressedBuffer.capacity() != OldCapacity)
+	{
+		NumAllocations += 1;
+		m_NumSaveBytesCopied += OldSize;
+	}
+
+	// Expect the next chunk to be about the same size, with some headroom; let the estimate shrink slowly:
+	const auto Size = m_NBTBuffer.size();
+	m_NBTSizeEstimate = std::max(Size + Size / 4, m_NBTSizeEstimate - m_NBTSizeEstimate / 16);
+
+	m_NumSavedChunks += 1;
+	m_NumSaveAllocations += NumAllocations;
+	m_NumSaveBytesSerialized += Size;
+	m_NumSaveBytesCompressed += Compressed.size();
+	return Compressed;
 }
 
 
@@ -351,14 +401,14 @@ bool cWSSAnvil::LoadChunkFromNBT(const cChunkCoords & a_Chunk, const cParsedNBT
 	if (newFormat)
 	{
 		// LOGD("LOADING chunk X %d Z %d", a_Chunk.m_ChunkX, a_Chunk.m_ChunkZ);
-		int Level = a_NBT.FindChildByName(0, "Level");
+		int Level = a_NBT.FindChildByName(0, "Level"_nbt);
 		if (Level < 0)
 		{
 			Level = 0;  // in 1.18+? tag level does not exist
 			// ChunkLoadFailed(a_Chunk, "Missing NBT tag: Level", a_RawChunkData);
 			// return false;
 		}
-		int DataVersionTag = a_NBT.FindChildByName(0, "DataVersion");
+		int DataVersionTag = a_NBT.FindChildByName(0, "DataVersion"_nbt);
 		if (DataVersionTag < 0)
 		{
 			ChunkLoadFailed(a_Chunk, "Missing NBT tag: DataVersion", a_RawChunkData);
@@ -366,11 +416,11 @@ bool cWSSAnvil::LoadChunkFromNBT(const cChunkCoords & a_Chunk, const cParsedNBT
 		}
 		int DataVersion = a_NBT.GetInt(DataVersionTag);
 		const bool usepadding = DataVersion >= 2566;  // Enable padding for worlds generated in 1.16+
-		int Sections = a_NBT.FindChildByName(Level, "Sections");
+		int Sections = a_NBT.FindChildByName(Level, "Sections"_nbt);
 		if (Sections < 0)
 		{
 			// renamed in 1.18+?
-			Sections = a_NBT.FindChildByName(Level, "sections");
+			Sections = a_NBT.FindChildByName(Level, "sections"_nbt);
 		}
 		if ((Sections < 0) || (a_NBT.GetType(Sections) != TAG_List))
 		{
@@ -386,7 +436,7 @@ bool cWSSAnvil::LoadChunkFromNBT(const cChunkCoords & a_Chunk, const cParsedNBT
 
 		for (int Child = a_NBT.GetFirstChild(Sections); Child >= 0; Child = a_NBT.GetNextSibling(Child))
 		{
-			const int SectionYTag = a_NBT.FindChildByName(Child, "Y");
+			const int SectionYTag = a_NBT.FindChildByName(Child, "Y"_nbt);
 			// in 1.18+? Y can be an int
 			if ((SectionYTag < 0) || ((a_NBT.GetType(SectionYTag) != TAG_Byte) && (a_NBT.GetType(SectionYTag) != TAG_Int)))
 			{
@@ -404,14 +454,14 @@ bool cWSSAnvil::LoadChunkFromNBT(const cChunkCoords & a_Chunk, const cParsedNBT
 			}
 			// in 1.18+? versions the palette and data are in a separate compound tag
 			int PaletteList = -1;
-			int block_states_compound = a_NBT.FindChildByName(Child, "block_states");
+			int block_states_compound = a_NBT.FindChildByName(Child, "block_states"_nbt);
 			if (block_states_compound > 0)
 			{
-				PaletteList = a_NBT.FindChildByName(block_states_compound, "palette");
+				PaletteList = a_NBT.FindChildByName(block_states_compound, "palette"_nbt);
 			}
 			else
 			{
-				PaletteList = a_NBT.FindChildByName(Child, "Palette");
+				PaletteList = a_NBT.FindChildByName(Child, "Palette"_nbt);
 			}
 			if (PaletteList < 0)
 			{
@@ -431,164 +481,17 @@ bool cWSSAnvil::LoadChunkFromNBT(const cChunkCoords & a_Chunk, const cParsedNBT
 				return false;
 			}
 
-			AStringList Palette;
-
-			std::vector<BlockState> Paletteids;
-			for (int Child1 = a_NBT.GetFirstChild(PaletteList); Child1 >= 0; Child1 = a_NBT.GetNextSibling(Child1))
-			{
-				const int NameTagId = a_NBT.FindChildByName(Child1, "Name");
-				if ((NameTagId < 0) || (a_NBT.GetType(NameTagId) != TAG_String))
-				{
-					ChunkLoadFailed(a_Chunk, "NBT tag missing or has wrong type: Name", a_RawChunkData);
-					return false;
-				}
-				AString blockid = a_NBT.GetString(NameTagId);
-				if (blockid.compare(0, 10, "minecraft:") != 0)
-				{
-					ChunkLoadFailed(a_Chunk, "Invalid namespace: " + blockid + " Mods arent supported", a_RawChunkData);
-					return false;
-				}
-				// const int BlockStatesId = a_NBT.FindChildByName(Child1, "Properties");
-
-				AString bls;
-				std::vector<AString> strs;
-				#define READ_BLOCK_STATES 0
-				#if READ_BLOCK_STATES  // Temporarily disabled
-				if (BlockStatesId > 0 && false)
-				{
-					if (a_NBT.GetType(BlockStatesId) != TAG_Compound)
-					{
-						ChunkLoadFailed(a_Chunk, "NBT tag has wrong type: Properties", a_RawChunkData);
-						return false;
-					}
-					for (int ProChild = a_NBT.GetFirstChild(BlockStatesId); ProChild >= 0; ProChild = a_NBT.GetNextSibling(ProChild))
-					{
-						AString name = a_NBT.GetName(ProChild);
-						AString value = a_NBT.GetString(ProChild);
-						bls = name + ": " + value + ", ";
-						strs.push_back(bls);
-					}
-				}
-				#endif
-				std::sort(strs.begin(), strs.end());
-
-				AString tosearch = blockid.substr(10, std::string::npos);  // substr to remove the "minecraft:"
-				if (strs.size() != 0)
-				{
-					tosearch += " ";
-				}
-				for (const auto & itm : strs)
-				{
-					tosearch += itm;
-				}
-				if (strs.size() != 0)
-				{
-					tosearch = tosearch.substr(0, tosearch.size() - 2);
-				}
-				// LOGD("%d hash tbl size", (*BlockMap::BlMap::GetMap()).size());
-				BlockState cnt = NamespaceSerializer::ToBlockType(tosearch);  // ( *BlockMap::BlMap::GetMap()).count(tosearch);
-
-				if (cnt == BlockType::Air)
-				{
-					// UNREACHABLE("Could find given block while loading chunk X: " + a_Chunk.m_ChunkX + " Z: " a_Chunk.m_ChunkZ + " Y Section: " + Y);
-				}
-				Paletteids.push_back(cnt);
-
-				Palette.emplace_back(blockid.substr(strlen("minecraft:"), std::string::npos));
-			}
-			int IndexBitSize = std::max(4, static_cast<int>(std::ceil(std::log2(Paletteids.size()))));  // How many bits is one index in length. Min is 4 bits, maximum 12 bits
-			ASSERT((12 >= IndexBitSize) && (IndexBitSize >= 4));
-
-			int SectionBlockLongCount = -1;
-
-			if (usepadding)
-			{
-				int blocks_per_long = FloorC(64.0 / IndexBitSize);
-				SectionBlockLongCount = CeilC(4096.0 / blocks_per_long);
-			}
-			else
-			{
-				SectionBlockLongCount = IndexBitSize * 4096 / 8 / 8;
-			}
-
-			const std::byte* BlockStateData = nullptr;
-
-			if (block_states_compound > 0)
+			int BlockStatesTag = (block_states_compound > 0) ? a_NBT.FindChildByName(block_states_compound, "data"_nbt) : a_NBT.FindChildByName(Child, "BlockStates"_nbt);
+			AString FailReason;
+			if (m_SectionDecoder.DecodeSection(a_NBT, PaletteList, BlockStatesTag, usepadding, Data.BlockData, static_cast<size_t>(Y), FailReason) == cAnvilSectionDecoder::eResult::Failed)
 			{
-				BlockStateData = GetSectionDataLong(a_NBT, block_states_compound, "data", static_cast<size_t>(SectionBlockLongCount));
-				if (BlockStateData != nullptr)
-				{
-					VERIFY(static_cast<size_t>(SectionBlockLongCount) * 8 == a_NBT.GetDataLength(a_NBT.FindChildByName(block_states_compound, "data")));
-				}
-			}
-			else
-			{
-				BlockStateData = GetSectionDataLong(a_NBT, Child, "BlockStates", static_cast<size_t>(SectionBlockLongCount));
-				if (BlockStateData != nullptr)
-				{
-					VERIFY(static_cast<size_t>(SectionBlockLongCount) * 8 == a_NBT.GetDataLength(a_NBT.FindChildByName(Child, "BlockStates")));
-				}
+				ChunkLoadFailed(a_Chunk, FailReason, a_RawChunkData);
+				return false;
 			}
 
-			const auto BlockLightData = GetSectionData(a_NBT, Child, "BlockLight", ChunkLightData::SectionLightCount);  // Still exists but does not have to be present for a valid section
-			const auto SkyLightData = GetSectionData(a_NBT, Child, "SkyLight", ChunkLightData::SectionLightCount);  // Still exists but does not have to be present for a valid section
-
-			if (BlockStateData != nullptr)
-			{
-				ASSERT(SectionBlockLongCount > 0);
-				UInt64 * LEstates = new UInt64[static_cast<UInt64>(SectionBlockLongCount)];
-
-				for (size_t i = 0; i < static_cast<size_t>(SectionBlockLongCount); i++)
-				{
-					LEstates[i] = NetworkBufToHost<UInt64>(BlockStateData + i * 8);
-				}
-
-				BlockState resolveddata[4096] = { BlockType::Air };
-				int numblockdataindex = 0;
+			const auto BlockLightData = GetSectionData(a_NBT, Child, "BlockLight"_nbt, ChunkLightData::SectionLightCount);  // Still exists but does not have to be present for a valid section
+			const auto SkyLightData = GetSectionData(a_NBT, Child, "SkyLight"_nbt, ChunkLightData::SectionLightCount);  // Still exists but does not have to be present for a valid section
 
-				int BitIndex = 0;
-				int arrindex = 0;
-				while (numblockdataindex < 4096)
-				{
-					UInt64 finalv = 0;
-					if (BitIndex + IndexBitSize <= 64)
-					{
-						finalv = (LEstates[arrindex] >> BitIndex) & ((static_cast<UInt64>(1) << IndexBitSize) - 1);
-						BitIndex += IndexBitSize;
-						if (BitIndex == 64)
-						{
-							BitIndex = 0;
-							arrindex++;
-						}
-					}
-					else  // BitIndex + IndexBitSize > 64
-					{
-						if (usepadding)
-						{
-							BitIndex = 0;
-							arrindex++;
-							continue;
-						}
-						UInt64 lowerpart = LEstates[arrindex] >> BitIndex;
-						arrindex++;
-						int BitsRead = (64 - BitIndex);
-						BitIndex = IndexBitSize - BitsRead;
-						UInt64 upperpart = (LEstates[arrindex] & ((static_cast<UInt64>(1) << BitIndex) - 1)) << BitsRead;
-						finalv = lowerpart | upperpart;
-						ASSERT(finalv < Paletteids.size());
-					}
-					resolveddata[numblockdataindex] = Paletteids[finalv];
-					numblockdataindex++;
-				}
-				Data.BlockData.SetSection(resolveddata, static_cast<size_t>(Y));
-				delete[] LEstates;
-			}
-			else if (Paletteids.size() == 1)  // if there is only one block in the palette, we can just fill the section with it
-			{
-				std::array<BlockState, 4096> Oneblock;
-				std::fill(Oneblock.begin(), Oneblock.end(), Paletteids[0]);
-				Data.BlockData.SetSection(reinterpret_cast<ChunkBlockData::SectionType &>(Oneblock), static_cast<size_t>(Y));
-			}
 			if ((BlockLightData != nullptr) && (SkyLightData != nullptr))
 			{
 				Data.LightData.SetSection(*reinterpret_cast<const ChunkLightData::SectionType *>(BlockLightData), *reinterpret_cast<const ChunkLightData::SectionType *>(SkyLightData), static_cast<size_t>(Y));
@@ -601,20 +504,20 @@ bool cWSSAnvil::LoadChunkFromNBT(const cChunkCoords & a_Chunk, const cParsedNBT
 		}  // for itr - LevelSections[]
 
 		// Load the Height maps, if it fails, recalculate it:
-		if (!LoadHeightMapFromNBT(Data.HeightMap, a_NBT, a_NBT.FindChildByName(Level, "Heightmaps")))
+		if (!LoadHeightMapFromNBT(Data.HeightMap, a_NBT, a_NBT.FindChildByName(Level, "Heightmaps"_nbt)))
 		{
 			Data.UpdateHeightMap();
 		}
 		memset(&Data.BiomeMap, 0, 1024);  // temp
 
 		// Load the entities from NBT:
-		int entities = a_NBT.FindChildByName(Level, "Entities");
+		int entities = a_NBT.FindChildByName(Level, "Entities"_nbt);
 		if (entities < 0)
 		{
-			entities = a_NBT.FindChildByName(Level, "entities");
+			entities = a_NBT.FindChildByName(Level, "entities"_nbt);
 		}
 		LoadEntitiesFromNBT(Data.Entities, a_NBT, entities);
-		LoadBlockEntitiesFromNBT(Data.BlockEntities, a_NBT, a_NBT.FindChildByName(Level, "block_entities"), Data.BlockData);
+		LoadBlockEntitiesFromNBT(Data.BlockEntities, a_NBT, a_NBT.FindChildByName(Level, "block_entities"_nbt), Data.BlockData);
 	}
 
 	m_World->QueueSetChunkData(std::move(Data));
@@ -622,14 +525,14 @@ bool cWSSAnvil::LoadChunkFromNBT(const cChunkCoords & a_Chunk, const cParsedNBT
 
 	/*
 	// Load the blockdata, blocklight and skylight:
-	int Level = a_NBT.FindChildByName(0, "Level");
+	int Level = a_NBT.FindChildByName(0, "Level"_nbt);
 	if (Level < 0)
 	{
 		ChunkLoadFailed(a_Chunk, "Missing NBT tag: Level", a_RawChunkData);
 		return false;
 	}
 
-	int Sections = a_NBT.FindChildByName(Level, "Sections");
+	int Sections = a_NBT.FindChildByName(Level, "Sections"_nbt);
 	if ((Sections < 0) || (a_NBT.GetType(Sections) != TAG_List))
 	{
 		ChunkLoadFailed(a_Chunk, "Missing NBT tag: Sections", a_RawChunkData);
@@ -644,7 +547,7 @@ bool cWSSAnvil::LoadChunkFromNBT(const cChunkCoords & a_Chunk, const cParsedNBT
 	}
 	for (int Child = a_NBT.GetFirstChild(Sections); Child >= 0; Child = a_NBT.GetNextSibling(Child))
 	{
-		const int SectionYTag = a_NBT.FindChildByName(Child, "Y");
+		const int SectionYTag = a_NBT.FindChildByName(Child, "Y"_nbt);
 		if ((SectionYTag < 0) || (a_NBT.GetType(SectionYTag) != TAG_Byte))
 		{
 			ChunkLoadFailed(a_Chunk, "NBT tag missing or has wrong: Y", a_RawChunkData);
@@ -659,10 +562,10 @@ bool cWSSAnvil::LoadChunkFromNBT(const cChunkCoords & a_Chunk, const cParsedNBT
 		}
 
 		const auto
-			BlockData = GetSectionData(a_NBT, Child, "Blocks", ChunkBlockData::SectionBlockCount),
-			MetaData = GetSectionData(a_NBT, Child, "Data", ChunkBlockData::SectionMetaCount),
-			BlockLightData = GetSectionData(a_NBT, Child, "BlockLight", ChunkLightData::SectionLightCount),
-			SkyLightData = GetSectionData(a_NBT, Child, "SkyLight", ChunkLightData::SectionLightCount);
+			BlockData = GetSectionData(a_NBT, Child, "Blocks"_nbt, ChunkBlockData::SectionBlockCount),
+			MetaData = GetSectionData(a_NBT, Child, "Data"_nbt, ChunkBlockData::SectionMetaCount),
+			BlockLightData = GetSectionData(a_NBT, Child, "BlockLight"_nbt, ChunkLightData::SectionLightCount),
+			SkyLightData = GetSectionData(a_NBT, Child, "SkyLight"_nbt, ChunkLightData::SectionLightCount);
 		if ((BlockData != nullptr) && (SkyLightData != nullptr) && (BlockLightData != nullptr))
 		{
 			BlockState Blocks[ChunkBlockData::SectionBlockCount];
@@ -688,23 +591,23 @@ bool cWSSAnvil::LoadChunkFromNBT(const cChunkCoords & a_Chunk, const cParsedNBT
 	}  // for itr - LevelSections[]
 
 	// Load the biomes from NBT, if present and valid:
-	if (!LoadBiomeMapFromNBT(Data.BiomeMap, a_NBT, a_NBT.FindChildByName(Level, "Biomes")))
+	if (!LoadBiomeMapFromNBT(Data.BiomeMap, a_NBT, a_NBT.FindChildByName(Level, "Biomes"_nbt)))
 	{
 		ChunkLoadFailed(a_Chunk, "Missing chunk biome data", a_RawChunkData);
 		return false;
 	}
 
 	// Load the Height map, if it fails, recalculate it:
-	if (!LoadHeightMapFromNBT(Data.HeightMap, a_NBT, a_NBT.FindChildByName(Level, "HeightMap")))
+	if (!LoadHeightMapFromNBT(Data.HeightMap, a_NBT, a_NBT.FindChildByName(Level, "HeightMap"_nbt)))
 	{
 		Data.UpdateHeightMap();
 	}
 
 	// Load the entities from NBT:
-	LoadEntitiesFromNBT     (Data.Entities,      a_NBT, a_NBT.FindChildByName(Level, "Entities"));
-	LoadBlockEntitiesFromNBT(Data.BlockEntities, a_NBT, a_NBT.FindChildByName(Level, "TileEntities"), Data.BlockData);
+	LoadEntitiesFromNBT     (Data.Entities,      a_NBT, a_NBT.FindChildByName(Level, "Entities"_nbt));
+	LoadBlockEntitiesFromNBT(Data.BlockEntities, a_NBT, a_NBT.FindChildByName(Level, "TileEntities"_nbt), Data.BlockData);
 
-	Data.IsLightValid = (a_NBT.FindChildByName(Level, "MCSIsLightValid") > 0);
+	Data.IsLightValid = (a_NBT.FindChildByName(Level, "MCSIsLightValid"_nbt) > 0);
 
 	// Uncomment this block for really cool stuff :)
 	// DEBUG magic: Invert the underground, so that we can see the MC generator in action :)
@@ -786,7 +689,7 @@ bool cWSSAnvil::LoadHeightMapFromNBT(cChunkDef::HeightMap & a_HeightMap, const c
 		return false;
 	}
 	/*
-	int WorldSurface = a_NBT.FindChildByName(a_TagIdx, "WORLD_SURFACE");
+	int WorldSurface = a_NBT.FindChildByName(a_TagIdx, "WORLD_SURFACE"_nbt);
 	if ((WorldSurface > 0) && (a_NBT.GetType(WorldSurface) == eTagType::TAG_LongArray))
 	{
 		// auto WorldSurfaceData = a_NBT.GetData(WorldSurface);
@@ -814,7 +717,7 @@ void cWSSAnvil::LoadEntitiesFromNBT(cEntityList & a_Entities, const cParsedNBT &
 		{
 			continue;
 		}
-		int sID = a_NBT.FindChildByName(Child, "id");
+		int sID = a_NBT.FindChildByName(Child, "id"_nbt);
 		if (sID < 0)
 		{
 			continue;
@@ -1004,7 +907,7 @@ OwnedBlockEntity cWSSAnvil::LoadBlockEntityFromNBT(const cParsedNBT & a_NBT, int
 		{
 			// All the other blocktypes should have no entities assigned to them. Report an error:
 			// Get the "id" tag:
-			int TagID = a_NBT.FindChildByName(a_Tag, "id");
+			int TagID = a_NBT.FindChildByName(a_Tag, "id"_nbt);
 			auto NumericBlock = PaletteUpgrade::ToBlock(a_Block);
 			FLOGINFO("WorldLoader({0}): Block entity mismatch: block type {1}, type \"{2}\", at {3}; the entity will be lost.",
 				m_World->GetName(),
@@ -1023,7 +926,7 @@ OwnedBlockEntity cWSSAnvil::LoadBlockEntityFromNBT(const cParsedNBT & a_NBT, int
 
 bool cWSSAnvil::LoadItemFromNBT(cItem & a_Item, const cParsedNBT & a_NBT, int a_TagIdx)
 {
-	int Type = a_NBT.FindChildByName(a_TagIdx, "id");
+	int Type = a_NBT.FindChildByName(a_TagIdx, "id"_nbt);
 	if (Type <= 0)
 	{
 		return false;
@@ -1053,7 +956,7 @@ bool cWSSAnvil::LoadItemFromNBT(cItem & a_Item, const cParsedNBT & a_NBT, int a_
 		return true;
 	}
 
-	int Count = a_NBT.FindChildByName(a_TagIdx, "Count");
+	int Count = a_NBT.FindChildByName(a_TagIdx, "Count"_nbt);
 	if ((Count > 0) && (a_NBT.GetType(Count) == TAG_Int))
 	{
 		a_Item.m_ItemCount = static_cast<char>(a_NBT.GetInt(Count));
@@ -1073,7 +976,7 @@ void cWSSAnvil::LoadItemGridFromNBT(cItemGrid & a_ItemGrid, const cParsedNBT & a
 	int NumSlots = a_ItemGrid.GetNumSlots();
 	for (int Child = a_NBT.GetFirstChild(a_ItemsTagIdx); Child != -1; Child = a_NBT.GetNextSibling(Child))
 	{
-		int SlotTag = a_NBT.FindChildByName(Child, "Slot");
+		int SlotTag = a_NBT.FindChildByName(Child, "Slot"_nbt);
 		if ((SlotTag < 0) || (a_NBT.GetType(SlotTag) != TAG_Byte))
 		{
 			continue;
@@ -1134,7 +1037,7 @@ bool cWSSAnvil::CheckBlockEntityType(const cParsedNBT & a_NBT, int a_TagIdx, con
 	}
 
 	// Get the "id" tag:
-	int TagID = a_NBT.FindChildByName(a_TagIdx, "id");
+	int TagID = a_NBT.FindChildByName(a_TagIdx, "id"_nbt);
 	if (TagID < 0)
 	{
 		return false;
@@ -1187,7 +1090,7 @@ OwnedBlockEntity cWSSAnvil::LoadBannerFromNBT(const cParsedNBT & a_NBT, int a_Ta
 
 	// TODO: read banner patterns
 
-	int CurrentLine = a_NBT.FindChildByName(a_TagIdx, "CustomName");
+	int CurrentLine = a_NBT.FindChildByName(a_TagIdx, "CustomName"_nbt);
 	if ((CurrentLine >= 0) && (a_NBT.GetType(CurrentLine) == TAG_String))
 	{
 		CustomName = a_NBT.GetString(CurrentLine);
@@ -1213,20 +1116,20 @@ OwnedBlockEntity cWSSAnvil::LoadBeaconFromNBT(const cParsedNBT & a_NBT, int a_Ta
 
 	auto Beacon = std::make_unique<cBeaconEntity>(a_Block, a_Pos, m_World);
 
-	int CurrentLine = a_NBT.FindChildByName(a_TagIdx, "primary_effect");
+	int CurrentLine = a_NBT.FindChildByName(a_TagIdx, "primary_effect"_nbt);
 	if (CurrentLine >= 0)
 	{
-		Beacon->SetPrimaryEffect(NamespaceSerializer::ToEntityEffect(a_NBT.GetString(CurrentLine).substr(10, std::string::npos)));
+		Beacon->SetPrimaryEffect(NamespaceSerializer::ToEntityEffect(a_NBT.GetStringView(CurrentLine)));
 	}
 
-	CurrentLine = a_NBT.FindChildByName(a_TagIdx, "secondary_effect");
+	CurrentLine = a_NBT.FindChildByName(a_TagIdx, "secondary_effect"_nbt);
 	if (CurrentLine >= 0)
 	{
-		Beacon->SetSecondaryEffect(NamespaceSerializer::ToEntityEffect(a_NBT.GetString(CurrentLine).substr(10, std::string::npos)));
+		Beacon->SetSecondaryEffect(NamespaceSerializer::ToEntityEffect(a_NBT.GetStringView(CurrentLine)));
 	}
 
 	// We are better than mojang, we load / save the beacon inventory!
-	int Items = a_NBT.FindChildByName(a_TagIdx, "Items");
+	int Items = a_NBT.FindChildByName(a_TagIdx, "Items"_nbt);
 	if ((Items >= 0) && (a_NBT.GetType(Items) == TAG_List))
 	{
 		LoadItemGridFromNBT(Beacon->GetContents(), a_NBT, Items);
@@ -1264,7 +1167,7 @@ OwnedBlockEntity cWSSAnvil::LoadBrewingstandFromNBT(const cParsedNBT & a_NBT, in
 		return nullptr;
 	}
 
-	int Items = a_NBT.FindChildByName(a_TagIdx, "Items");
+	int Items = a_NBT.FindChildByName(a_TagIdx, "Items"_nbt);
 	if ((Items < 0) || (a_NBT.GetType(Items) != TAG_List))
 	{
 		return nullptr;  // Make it an empty brewingstand - the chunk loader will provide an empty cBrewingstandEntity for this
@@ -1273,7 +1176,7 @@ OwnedBlockEntity cWSSAnvil::LoadBrewingstandFromNBT(const cParsedNBT & a_NBT, in
 	auto Brewingstand = std::make_unique<cBrewingstandEntity>(a_Block, a_Pos, m_World);
 
 	// Fuel has to be loaded at first, because of slot events:
-	int Fuel = a_NBT.FindChildByName(a_TagIdx, "Fuel");
+	int Fuel = a_NBT.FindChildByName(a_TagIdx, "Fuel"_nbt);
 	if (Fuel >= 0)
 	{
 		Int16 tb = a_NBT.GetByte(Fuel);
@@ -1283,7 +1186,7 @@ OwnedBlockEntity cWSSAnvil::LoadBrewingstandFromNBT(const cParsedNBT & a_NBT, in
 	// Load slots:
 	for (int Child = a_NBT.GetFirstChild(Items); Child != -1; Child = a_NBT.GetNextSibling(Child))
 	{
-		int Slot = a_NBT.FindChildByName(Child, "Slot");
+		int Slot = a_NBT.FindChildByName(Child, "Slot"_nbt);
 		if ((Slot < 0) || (a_NBT.GetType(Slot) != TAG_Byte))
 		{
 			continue;
@@ -1296,7 +1199,7 @@ OwnedBlockEntity cWSSAnvil::LoadBrewingstandFromNBT(const cParsedNBT & a_NBT, in
 	}  // for itr - ItemDefs[]
 
 	// Load brewing time:
-	int BrewTime = a_NBT.FindChildByName(a_TagIdx, "BrewTime");
+	int BrewTime = a_NBT.FindChildByName(a_TagIdx, "BrewTime"_nbt);
 	if (BrewTime >= 0)
 	{
 		Int16 tb = a_NBT.GetShort(BrewTime);
@@ -1323,7 +1226,7 @@ OwnedBlockEntity cWSSAnvil::LoadChestFromNBT(const cParsedNBT & a_NBT, int a_Tag
 		return nullptr;
 	}
 
-	int Items = a_NBT.FindChildByName(a_TagIdx, "Items");
+	int Items = a_NBT.FindChildByName(a_TagIdx, "Items"_nbt);
 	if ((Items < 0) || (a_NBT.GetType(Items) != TAG_List))
 	{
 		return nullptr;  // Make it an empty chest - the chunk loader will provide an empty cChestEntity for this
@@ -1348,19 +1251,19 @@ OwnedBlockEntity cWSSAnvil::LoadCommandBlockFromNBT(const cParsedNBT & a_NBT, in
 
 	auto CmdBlock = std::make_unique<cCommandBlockEntity>(a_Block, a_Pos, m_World);
 
-	int currentLine = a_NBT.FindChildByName(a_TagIdx, "Command");
+	int currentLine = a_NBT.FindChildByName(a_TagIdx, "Command"_nbt);
 	if (currentLine >= 0)
 	{
 		CmdBlock->SetCommand(a_NBT.GetString(currentLine));
 	}
 
-	currentLine = a_NBT.FindChildByName(a_TagIdx, "SuccessCount");
+	currentLine = a_NBT.FindChildByName(a_TagIdx, "SuccessCount"_nbt);
 	if (currentLine >= 0)
 	{
 		CmdBlock->SetResult(static_cast<unsigned char>(a_NBT.GetInt(currentLine)));
 	}
 
-	currentLine = a_NBT.FindChildByName(a_TagIdx, "LastOutput");
+	currentLine = a_NBT.FindChildByName(a_TagIdx, "LastOutput"_nbt);
 	if (currentLine >= 0)
 	{
 		CmdBlock->SetLastOutput(a_NBT.GetString(currentLine));
@@ -1384,7 +1287,7 @@ OwnedBlockEntity cWSSAnvil::LoadDispenserFromNBT(const cParsedNBT & a_NBT, int a
 		return nullptr;
 	}
 
-	int Items = a_NBT.FindChildByName(a_TagIdx, "Items");
+	int Items = a_NBT.FindChildByName(a_TagIdx, "Items"_nbt);
 	if ((Items < 0) || (a_NBT.GetType(Items) != TAG_List))
 	{
 		return nullptr;  // Make it an empty dispenser - the chunk loader will provide an empty cDispenserEntity for this
@@ -1407,7 +1310,7 @@ OwnedBlockEntity cWSSAnvil::LoadDropperFromNBT(const cParsedNBT & a_NBT, int a_T
 		return nullptr;
 	}
 
-	int Items = a_NBT.FindChildByName(a_TagIdx, "Items");
+	int Items = a_NBT.FindChildByName(a_TagIdx, "Items"_nbt);
 	if ((Items < 0) || (a_NBT.GetType(Items) != TAG_List))
 	{
 		return nullptr;  // Make it an empty dropper - the chunk loader will provide an empty cDropperEntity for this
@@ -1431,7 +1334,7 @@ OwnedBlockEntity cWSSAnvil::LoadEnchantingTableFromNBT(const cParsedNBT & a_NBT,
 	}
 
 	AString CustomName;
-	int currentLine = a_NBT.FindChildByName(a_TagIdx, "CustomName");
+	int currentLine = a_NBT.FindChildByName(a_TagIdx, "CustomName"_nbt);
 	if (currentLine >= 0)
 	{
 		if (a_NBT.GetType(currentLine) == TAG_String)
@@ -1490,7 +1393,7 @@ OwnedBlockEntity cWSSAnvil::LoadFlowerPotFromNBT(const cParsedNBT & a_NBT, int a
 
 	short ItemType = 0, ItemDamage = 0;
 
-	int currentLine = a_NBT.FindChildByName(a_TagIdx, "Item");
+	int currentLine = a_NBT.FindChildByName(a_TagIdx, "Item"_nbt);
 	if (currentLine >= 0)
 	{
 		if (a_NBT.GetType(currentLine) == TAG_String)
@@ -1503,7 +1406,7 @@ OwnedBlockEntity cWSSAnvil::LoadFlowerPotFromNBT(const cParsedNBT & a_NBT, int a
 		}
 	}
 
-	currentLine = a_NBT.FindChildByName(a_TagIdx, "Data");
+	currentLine = a_NBT.FindChildByName(a_TagIdx, "Data"_nbt);
 	if ((currentLine >= 0) && (a_NBT.GetType(currentLine) == TAG_Int))
 	{
 		ItemDamage = static_cast<short>(a_NBT.GetInt(currentLine));
@@ -1531,7 +1434,7 @@ OwnedBlockEntity cWSSAnvil::LoadFurnaceFromNBT(const cParsedNBT & a_NBT, int a_T
 		return nullptr;
 	}
 
-	int Items = a_NBT.FindChildByName(a_TagIdx, "Items");
+	int Items = a_NBT.FindChildByName(a_TagIdx, "Items"_nbt);
 	if ((Items < 0) || (a_NBT.GetType(Items) != TAG_List))
 	{
 		return nullptr;  // Make it an empty furnace - the chunk loader will provide an empty cFurnaceEntity for this
@@ -1543,7 +1446,7 @@ OwnedBlockEntity cWSSAnvil::LoadFurnaceFromNBT(const cParsedNBT & a_NBT, int a_T
 	// Load slots:
 	for (int Child = a_NBT.GetFirstChild(Items); Child != -1; Child = a_NBT.GetNextSibling(Child))
 	{
-		int Slot = a_NBT.FindChildByName(Child, "Slot");
+		int Slot = a_NBT.FindChildByName(Child, "Slot"_nbt);
 		if ((Slot < 0) || (a_NBT.GetType(Slot) != TAG_Byte))
 		{
 			continue;
@@ -1556,7 +1459,7 @@ OwnedBlockEntity cWSSAnvil::LoadFurnaceFromNBT(const cParsedNBT & a_NBT, int a_T
 	}  // for itr - ItemDefs[]
 
 	// Load burn time:
-	int BurnTime = a_NBT.FindChildByName(a_TagIdx, "lit_time_remaining");
+	int BurnTime = a_NBT.FindChildByName(a_TagIdx, "lit_time_remaining"_nbt);
 	if (BurnTime >= 0)
 	{
 		Int16 bt = a_NBT.GetShort(BurnTime);
@@ -1565,7 +1468,7 @@ OwnedBlockEntity cWSSAnvil::LoadFurnaceFromNBT(const cParsedNBT & a_NBT, int a_T
 	}
 
 	// Load cook time:
-	int CookTime = a_NBT.FindChildByName(a_TagIdx, "cooking_time_spent");
+	int CookTime = a_NBT.FindChildByName(a_TagIdx, "cooking_time_spent"_nbt);
 	if (CookTime >= 0)
 	{
 		Int16 ct = a_NBT.GetShort(CookTime);
@@ -1591,7 +1494,7 @@ OwnedBlockEntity cWSSAnvil::LoadHopperFromNBT(const cParsedNBT & a_NBT, int a_Ta
 		return nullptr;
 	}
 
-	int Items = a_NBT.FindChildByName(a_TagIdx, "Items");
+	int Items = a_NBT.FindChildByName(a_TagIdx, "Items"_nbt);
 	if ((Items < 0) || (a_NBT.GetType(Items) != TAG_List))
 	{
 		return nullptr;  // Make it an empty hopper - the chunk loader will provide an empty cHopperEntity for this
@@ -1615,7 +1518,7 @@ OwnedBlockEntity cWSSAnvil::LoadJukeboxFromNBT(const cParsedNBT & a_NBT, int a_T
 	}
 
 	auto Jukebox = std::make_unique<cJukeboxEntity>(a_Block, a_Pos, m_World);
-	int Record = a_NBT.FindChildByName(a_TagIdx, "Record");
+	int Record = a_NBT.FindChildByName(a_TagIdx, "Record"_nbt);
 	if (Record >= 0)
 	{
 		cItem record_item;
@@ -1641,7 +1544,7 @@ OwnedBlockEntity cWSSAnvil::LoadMobSpawnerFromNBT(const cParsedNBT & a_NBT, int
 	auto MobSpawner = std::make_unique<cMobSpawnerEntity>(a_Block, a_Pos, m_World);
 
 	// Load entity type
-	int Type = a_NBT.FindChildByName(a_TagIdx, "EntityId");
+	int Type = a_NBT.FindChildByName(a_TagIdx, "EntityId"_nbt);
 	if ((Type >= 0) && (a_NBT.GetType(Type) == TAG_String))
 	{
 		const auto StatInfo = NamespaceSerializer::SplitNamespacedID(a_NBT.GetStringView(Type));
@@ -1658,48 +1561,48 @@ OwnedBlockEntity cWSSAnvil::LoadMobSpawnerFromNBT(const cParsedNBT & a_NBT, int
 	}
 
 	// Load spawn count:
-	int CurrentLine = a_NBT.FindChildByName(a_TagIdx, "SpawnCount");
+	int CurrentLine = a_NBT.FindChildByName(a_TagIdx, "SpawnCount"_nbt);
 	if ((CurrentLine >= 0) && (a_NBT.GetType(CurrentLine) == TAG_Short))
 	{
 		MobSpawner->SetSpawnCount(a_NBT.GetShort(CurrentLine));
 	}
 
 	// Load spawn range:
-	CurrentLine = a_NBT.FindChildByName(a_TagIdx, "SpawnRange");
+	CurrentLine = a_NBT.FindChildByName(a_TagIdx, "SpawnRange"_nbt);
 	if ((CurrentLine >= 0) && (a_NBT.GetType(CurrentLine) == TAG_Short))
 	{
 		MobSpawner->SetSpawnRange(a_NBT.GetShort(CurrentLine));
 	}
 
 	// Load delay:
-	CurrentLine = a_NBT.FindChildByName(a_TagIdx, "Delay");
+	CurrentLine = a_NBT.FindChildByName(a_TagIdx, "Delay"_nbt);
 	if ((CurrentLine >= 0) && (a_NBT.GetType(CurrentLine) == TAG_Short))
 	{
 		MobSpawner->SetSpawnDelay(a_NBT.GetShort(CurrentLine));
 	}
 
 	// Load delay range:
-	CurrentLine = a_NBT.FindChildByName(a_TagIdx, "MinSpawnDelay");
+	CurrentLine = a_NBT.FindChildByName(a_TagIdx, "MinSpawnDelay"_nbt);
 	if ((CurrentLine >= 0) && (a_NBT.GetType(CurrentLine) == TAG_Short))
 	{
 		MobSpawner->SetMinSpawnDelay(a_NBT.GetShort(CurrentLine));
 	}
 
-	CurrentLine = a_NBT.FindChildByName(a_TagIdx, "MaxSpawnDelay");
+	CurrentLine = a_NBT.FindChildByName(a_TagIdx, "MaxSpawnDelay"_nbt);
 	if ((CurrentLine >= 0) && (a_NBT.GetType(CurrentLine) == TAG_Short))
 	{
 		MobSpawner->SetMaxSpawnDelay(a_NBT.GetShort(CurrentLine));
 	}
 
 	// Load MaxNearbyEntities:
-	CurrentLine = a_NBT.FindChildByName(a_TagIdx, "MaxNearbyEntities");
+	CurrentLine = a_NBT.FindChildByName(a_TagIdx, "MaxNearbyEntities"_nbt);
 	if ((CurrentLine >= 0) && (a_NBT.GetType(CurrentLine) == TAG_Short))
 	{
 		MobSpawner->SetMaxNearbyEntities(a_NBT.GetShort(CurrentLine));
 	}
 
 	// Load RequiredPlayerRange:
-	CurrentLine = a_NBT.FindChildByName(a_TagIdx, "RequiredPlayerRange");
+	CurrentLine = a_NBT.FindChildByName(a_TagIdx, "RequiredPlayerRange"_nbt);
 	if ((CurrentLine >= 0) && (a_NBT.GetType(CurrentLine) == TAG_Short))
 	{
 		MobSpawner->SetRequiredPlayerRange(a_NBT.GetShort(CurrentLine));
@@ -1723,13 +1626,13 @@ OwnedBlockEntity cWSSAnvil::LoadMobHeadFromNBT(const cParsedNBT & a_NBT, int a_T
 	}
 	auto MobHead = std::make_unique<cMobHeadEntity>(a_Block, a_Pos, m_World);
 
-	int ownerLine = a_NBT.FindChildByName(a_TagIdx, "profile");
+	int ownerLine = a_NBT.FindChildByName(a_TagIdx, "profile"_nbt);
 	if (ownerLine >= 0)
 	{
 		AString OwnerName, OwnerTexture, OwnerTextureSignature;
 		cUUID OwnerUUID;
 		MobHead->SetType(Item::PlayerHead);
-		int currentLine = a_NBT.FindChildByName(ownerLine, "Id");
+		int currentLine = a_NBT.FindChildByName(ownerLine, "Id"_nbt);
 		if (currentLine >= 0)
 		{
 			std::array<UInt32, 4> little_endian;
@@ -1740,13 +1643,13 @@ OwnedBlockEntity cWSSAnvil::LoadMobHeadFromNBT(const cParsedNBT & a_NBT, int a_T
 			OwnerUUID.FromRaw(reinterpret_cast<std::array<Byte, 16> &>(little_endian));
 		}
 
-		currentLine = a_NBT.FindChildByName(ownerLine, "name");
+		currentLine = a_NBT.FindChildByName(ownerLine, "name"_nbt);
 		if (currentLine >= 0)
 		{
 			OwnerName = a_NBT.GetString(currentLine);
 		}
 
-		int props = a_NBT.FindChildByName(ownerLine, "properties");
+		int props = a_NBT.FindChildByName(ownerLine, "properties"_nbt);
 		if ((props < 0) || (a_NBT.GetChildrenType(props) != TAG_Compound))
 		{
 			return MobHead;
@@ -1754,21 +1657,21 @@ OwnedBlockEntity cWSSAnvil::LoadMobHeadFromNBT(const cParsedNBT & a_NBT, int a_T
 
 		for (int Child = a_NBT.GetFirstChild(props); Child >= 0; Child = a_NBT.GetNextSibling(Child))
 		{
-			int nametag = a_NBT.FindChildByName(Child, "name");
+			int nametag = a_NBT.FindChildByName(Child, "name"_nbt);
 			if ((nametag < 0) || (a_NBT.GetType(nametag) != TAG_String))
 			{
 				return MobHead;
 			}
 			AString name = a_NBT.GetString(nametag);
 
-			int value_tag = a_NBT.FindChildByName(Child, "value");
+			int value_tag = a_NBT.FindChildByName(Child, "value"_nbt);
 			if ((value_tag < 0) || (a_NBT.GetType(value_tag) != TAG_String))
 			{
 				return MobHead;
 			}
 			AString value = a_NBT.GetString(value_tag);
 
-			int sig_tag = a_NBT.FindChildByName(Child, "signature");
+			int sig_tag = a_NBT.FindChildByName(Child, "signature"_nbt);
 			AString signature;
 			if ((sig_tag > 0) && (a_NBT.GetType(sig_tag) == TAG_String))
 			{
@@ -1802,7 +1705,7 @@ OwnedBlockEntity cWSSAnvil::LoadNoteBlockFromNBT(const cParsedNBT & a_NBT, int a
 	}
 
 	auto NoteBlock = std::make_unique<cNoteEntity>(a_Block, a_Pos, m_World);
-	int note = a_NBT.FindChildByName(a_TagIdx, "note");
+	int note = a_NBT.FindChildByName(a_TagIdx, "note"_nbt);
 	if (note >= 0)
 	{
 		NoteBlock->SetNote(a_NBT.GetByte(note));
@@ -1825,10 +1728,10 @@ OwnedBlockEntity cWSSAnvil::LoadSignFromNBT(const cParsedNBT & a_NBT, int a_TagI
 
 	auto Sign = std::make_unique<cSignEntity>(a_Block, a_Pos, m_World);
 
-	int front = a_NBT.FindChildByName(a_TagIdx, "front_text");
+	int front = a_NBT.FindChildByName(a_TagIdx, "front_text"_nbt);
 	if (front >= 0)
 	{
-		int messages = a_NBT.FindChildByName(front, "messages");
+		int messages = a_NBT.FindChildByName(front, "messages"_nbt);
 		if ((messages < 0) || (a_NBT.GetType(messages) != TAG_List) || (a_NBT.GetChildrenType(messages) != TAG_String))
 		{
 			return Sign;
@@ -2001,7 +1904,7 @@ void cWSSAnvil::LoadEntityFromNBT(cEntityList & a_Entities, const cParsedNBT & a
 void cWSSAnvil::LoadOldMinecartFromNBT(cEntityList & a_Entities, const cParsedNBT & a_NBT, int a_TagIdx)
 {
 	// It is a minecart, old style, find out the type:
-	int TypeTag = a_NBT.FindChildByName(a_TagIdx, "Type");
+	int TypeTag = a_NBT.FindChildByName(a_TagIdx, "Type"_nbt);
 	if ((TypeTag < 0) || (a_NBT.GetType(TypeTag) != TAG_Int))
 	{
 		return;
@@ -2030,7 +1933,7 @@ void cWSSAnvil::LoadBoatFromNBT(cEntityList & a_Entities, const cParsedNBT & a_N
 		return;
 	}
 
-	int TypeIdx = a_NBT.FindChildByName(a_TagIdx, "Type");
+	int TypeIdx = a_NBT.FindChildByName(a_TagIdx, "Type"_nbt);
 	if (TypeIdx > 0)
 	{
 		Boat->SetMaterial(cBoat::StringToMaterial(a_NBT.GetString(TypeIdx)));
@@ -2046,30 +1949,30 @@ void cWSSAnvil::LoadEnderCrystalFromNBT(cEntityList & a_Entities, const cParsedN
 {
 	bool DisplayBeam = false, ShowBottom = false;
 	Vector3i BeamTarget;
-	int CurrentLine = a_NBT.FindChildByName(a_TagIdx, "BeamTarget");
+	int CurrentLine = a_NBT.FindChildByName(a_TagIdx, "BeamTarget"_nbt);
 	if (CurrentLine > 0)
 	{
 		DisplayBeam = true;
 		if (a_NBT.GetType(CurrentLine) == TAG_Compound)
 		{
-			int CoordinateLine = a_NBT.FindChildByName(CurrentLine, "X");
+			int CoordinateLine = a_NBT.FindChildByName(CurrentLine, "X"_nbt);
 			if (CoordinateLine > 0)
 			{
 				BeamTarget.x = a_NBT.GetInt(CoordinateLine);
 			}
-			CoordinateLine = a_NBT.FindChildByName(CurrentLine, "Y");
+			CoordinateLine = a_NBT.FindChildByName(CurrentLine, "Y"_nbt);
 			if (CoordinateLine > 0)
 			{
 				BeamTarget.y = a_NBT.GetInt(CoordinateLine);
 			}
-			CoordinateLine = a_NBT.FindChildByName(CurrentLine, "Z");
+			CoordinateLine = a_NBT.FindChildByName(CurrentLine, "Z"_nbt);
 			if (CoordinateLine > 0)
 			{
 				BeamTarget.z = a_NBT.GetInt(CoordinateLine);
 			}
 		}
 	}
-	CurrentLine = a_NBT.FindChildByName(a_TagIdx, "ShowBottom");
+	CurrentLine = a_NBT.FindChildByName(a_TagIdx, "ShowBottom"_nbt);
 	if (CurrentLine > 0)
 	{
 		ShowBottom = a_NBT.GetByte(CurrentLine) == 1;
@@ -2090,8 +1993,8 @@ void cWSSAnvil::LoadEnderCrystalFromNBT(cEntityList & a_Entities, const cParsedN
 
 void cWSSAnvil::LoadFallingBlockFromNBT(cEntityList & a_Entities, const cParsedNBT & a_NBT, int a_TagIdx)
 {
-	int TypeIdx = a_NBT.FindChildByName(a_TagIdx, "TileID");
-	int MetaIdx = a_NBT.FindChildByName(a_TagIdx, "Data");
+	int TypeIdx = a_NBT.FindChildByName(a_TagIdx, "TileID"_nbt);
+	int MetaIdx = a_NBT.FindChildByName(a_TagIdx, "Data"_nbt);
 
 	if ((TypeIdx < 0) || (MetaIdx < 0))
 	{
@@ -2129,7 +2032,7 @@ void cWSSAnvil::LoadMinecartRFromNBT(cEntityList & a_Entities, const cParsedNBT
 
 void cWSSAnvil::LoadMinecartCFromNBT(cEntityList & a_Entities, const cParsedNBT & a_NBT, int a_TagIdx)
 {
-	int Items = a_NBT.FindChildByName(a_TagIdx, "Items");
+	int Items = a_NBT.FindChildByName(a_TagIdx, "Items"_nbt);
 	if ((Items < 0) || (a_NBT.GetType(Items) != TAG_List))
 	{
 		return;  // Make it an empty chest - the chunk loader will provide an empty cChestEntity for this
@@ -2141,7 +2044,7 @@ void cWSSAnvil::LoadMinecartCFromNBT(cEntityList & a_Entities, const cParsedNBT
 	}
 	for (int Child = a_NBT.GetFirstChild(Items); Child != -1; Child = a_NBT.GetNextSibling(Child))
 	{
-		int Slot = a_NBT.FindChildByName(Child, "Slot");
+		int Slot = a_NBT.FindChildByName(Child, "Slot"_nbt);
 		if ((Slot < 0) || (a_NBT.GetType(Slot) != TAG_Byte))
 		{
 			continue;
@@ -2213,7 +2116,7 @@ void cWSSAnvil::LoadMinecartHFromNBT(cEntityList & a_Entities, const cParsedNBT
 void cWSSAnvil::LoadPickupFromNBT(cEntityList & a_Entities, const cParsedNBT & a_NBT, int a_TagIdx)
 {
 	// Load item:
-	int ItemTag = a_NBT.FindChildByName(a_TagIdx, "Item");
+	int ItemTag = a_NBT.FindChildByName(a_TagIdx, "Item"_nbt);
 	if ((ItemTag < 0) || (a_NBT.GetType(ItemTag) != TAG_Compound))
 	{
 		return;
@@ -2231,7 +2134,7 @@ void cWSSAnvil::LoadPickupFromNBT(cEntityList & a_Entities, const cParsedNBT & a
 	}
 
 	// Load age:
-	int Age = a_NBT.FindChildByName(a_TagIdx, "Age");
+	int Age = a_NBT.FindChildByName(a_TagIdx, "Age"_nbt);
 	if (Age > 0)
 	{
 		Pickup->SetAge(a_NBT.GetShort(Age));
@@ -2253,7 +2156,7 @@ void cWSSAnvil::LoadTNTFromNBT(cEntityList & a_Entities, const cParsedNBT & a_NB
 	}
 
 	// Load Fuse Ticks:
-	int FuseTicks = a_NBT.FindChildByName(a_TagIdx, "Fuse");
+	int FuseTicks = a_NBT.FindChildByName(a_TagIdx, "Fuse"_nbt);
 	if (FuseTicks > 0)
 	{
 		TNT->SetFuseTicks(a_NBT.GetByte(FuseTicks));
@@ -2275,14 +2178,14 @@ void cWSSAnvil::LoadExpOrbFromNBT(cEntityList & a_Entities, const cParsedNBT & a
 	}
 
 	// Load Age:
-	int Age = a_NBT.FindChildByName(a_TagIdx, "Age");
+	int Age = a_NBT.FindChildByName(a_TagIdx, "Age"_nbt);
 	if (Age > 0)
 	{
 		ExpOrb->SetAge(a_NBT.GetShort(Age));
 	}
 
 	// Load Reward (Value):
-	int Reward = a_NBT.FindChildByName(a_TagIdx, "Value");
+	int Reward = a_NBT.FindChildByName(a_TagIdx, "Value"_nbt);
 	if (Reward > 0)
 	{
 		ExpOrb->SetReward(a_NBT.GetShort(Reward));
@@ -2298,7 +2201,7 @@ void cWSSAnvil::LoadExpOrbFromNBT(cEntityList & a_Entities, const cParsedNBT & a
 void cWSSAnvil::LoadHangingFromNBT(cHangingEntity & a_Hanging, const cParsedNBT & a_NBT, int a_TagIdx)
 {
 	// "Facing" tag is the prime source of the Facing; if not available, translate from older "Direction" or "Dir"
-	int Facing = a_NBT.FindChildByName(a_TagIdx, "Facing");
+	int Facing = a_NBT.FindChildByName(a_TagIdx, "Facing"_nbt);
 	if (Facing < 0)
 	{
 		return;
@@ -2306,9 +2209,9 @@ void cWSSAnvil::LoadHangingFromNBT(cHangingEntity & a_Hanging, const cParsedNBT
 
 	a_Hanging.SetProtocolFacing(a_NBT.GetByte(Facing));
 
-	int TileX = a_NBT.FindChildByName(a_TagIdx, "TileX");
-	int TileY = a_NBT.FindChildByName(a_TagIdx, "TileY");
-	int TileZ = a_NBT.FindChildByName(a_TagIdx, "TileZ");
+	int TileX = a_NBT.FindChildByName(a_TagIdx, "TileX"_nbt);
+	int TileY = a_NBT.FindChildByName(a_TagIdx, "TileY"_nbt);
+	int TileZ = a_NBT.FindChildByName(a_TagIdx, "TileZ"_nbt);
 	if ((TileX > 0) && (TileY > 0) && (TileZ > 0))
 	{
 		a_Hanging.SetPosition(
@@ -2326,7 +2229,7 @@ void cWSSAnvil::LoadHangingFromNBT(cHangingEntity & a_Hanging, const cParsedNBT
 void cWSSAnvil::LoadItemFrameFromNBT(cEntityList & a_Entities, const cParsedNBT & a_NBT, int a_TagIdx)
 {
 	// Load item:
-	int ItemTag = a_NBT.FindChildByName(a_TagIdx, "Item");
+	int ItemTag = a_NBT.FindChildByName(a_TagIdx, "Item"_nbt);
 	if ((ItemTag < 0) || (a_NBT.GetType(ItemTag) != TAG_Compound))
 	{
 		return;
@@ -2347,7 +2250,7 @@ void cWSSAnvil::LoadItemFrameFromNBT(cEntityList & a_Entities, const cParsedNBT
 	LoadHangingFromNBT(*ItemFrame.get(), a_NBT, a_TagIdx);
 
 	// Load Rotation:
-	int Rotation = a_NBT.FindChildByName(a_TagIdx, "ItemRotation");
+	int Rotation = a_NBT.FindChildByName(a_TagIdx, "ItemRotation"_nbt);
 	if (Rotation > 0)
 	{
 		ItemFrame->SetItemRotation(static_cast<Byte>(a_NBT.GetByte(Rotation)));
@@ -2381,7 +2284,7 @@ void cWSSAnvil::LoadLeashKnotFromNBT(cEntityList & a_Entities, const cParsedNBT
 void cWSSAnvil::LoadPaintingFromNBT(cEntityList & a_Entities, const cParsedNBT & a_NBT, int a_TagIdx)
 {
 	// Load painting name:
-	int MotiveTag = a_NBT.FindChildByName(a_TagIdx, "Motive");
+	int MotiveTag = a_NBT.FindChildByName(a_TagIdx, "Motive"_nbt);
 	if ((MotiveTag < 0) || (a_NBT.GetType(MotiveTag) != TAG_String))
 	{
 		return;
@@ -2410,7 +2313,7 @@ void cWSSAnvil::LoadArrowFromNBT(cEntityList & a_Entities, const cParsedNBT & a_
 	}
 
 	// Load pickup state:
-	int PickupIdx = a_NBT.FindChildByName(a_TagIdx, "pickup");
+	int PickupIdx = a_NBT.FindChildByName(a_TagIdx, "pickup"_nbt);
 	if ((PickupIdx > 0) && (a_NBT.GetType(PickupIdx) == TAG_Byte))
 	{
 		Arrow->SetPickupState(static_cast<cArrowEntity::ePickupState>(a_NBT.GetByte(PickupIdx)));
@@ -2418,7 +2321,7 @@ void cWSSAnvil::LoadArrowFromNBT(cEntityList & a_Entities, const cParsedNBT & a_
 	else
 	{
 		// Try the older "player" tag:
-		int PlayerIdx = a_NBT.FindChildByName(a_TagIdx, "player");
+		int PlayerIdx = a_NBT.FindChildByName(a_TagIdx, "player"_nbt);
 		if ((PlayerIdx > 0) && (a_NBT.GetType(PlayerIdx) == TAG_Byte))
 		{
 			Arrow->SetPickupState((a_NBT.GetByte(PlayerIdx) == 0) ? cArrowEntity::psNoPickup : cArrowEntity::psInSurvivalOrCreative);
@@ -2426,16 +2329,16 @@ void cWSSAnvil::LoadArrowFromNBT(cEntityList & a_Entities, const cParsedNBT & a_
 	}
 
 	// Load damage:
-	int DamageIdx = a_NBT.FindChildByName(a_TagIdx, "damage");
+	int DamageIdx = a_NBT.FindChildByName(a_TagIdx, "damage"_nbt);
 	if ((DamageIdx > 0) && (a_NBT.GetType(DamageIdx) == TAG_Double))
 	{
 		Arrow->SetDamageCoeff(a_NBT.GetDouble(DamageIdx));
 	}
 
 	// Load block hit:
-	int InBlockXIdx = a_NBT.FindChildByName(a_TagIdx, "xTile");
-	int InBlockYIdx = a_NBT.FindChildByName(a_TagIdx, "yTile");
-	int InBlockZIdx = a_NBT.FindChildByName(a_TagIdx, "zTile");
+	int InBlockXIdx = a_NBT.FindChildByName(a_TagIdx, "xTile"_nbt);
+	int InBlockYIdx = a_NBT.FindChildByName(a_TagIdx, "yTile"_nbt);
+	int InBlockZIdx = a_NBT.FindChildByName(a_TagIdx, "zTile"_nbt);
 	if ((InBlockXIdx > 0) && (InBlockYIdx > 0) && (InBlockZIdx > 0))
 	{
 		eTagType typeX = a_NBT.GetType(InBlockXIdx);
@@ -2480,13 +2383,13 @@ void cWSSAnvil::LoadSplashPotionFromNBT(cEntityList & a_Entities, const cParsedN
 		return;
 	}
 
-	int EffectDuration         = a_NBT.FindChildByName(a_TagIdx, "EffectDuration");
-	int EffectIntensity        = a_NBT.FindChildByName(a_TagIdx, "EffectIntensity");
-	int EffectDistanceModifier = a_NBT.FindChildByName(a_TagIdx, "EffectDistanceModifier");
+	int EffectDuration         = a_NBT.FindChildByName(a_TagIdx, "EffectDuration"_nbt);
+	int EffectIntensity        = a_NBT.FindChildByName(a_TagIdx, "EffectIntensity"_nbt);
+	int EffectDistanceModifier = a_NBT.FindChildByName(a_TagIdx, "EffectDistanceModifier"_nbt);
 
-	SplashPotion->SetEntityEffectType(static_cast<cEntityEffect::eType>(a_NBT.FindChildByName(a_TagIdx, "EffectType")));
+	SplashPotion->SetEntityEffectType(static_cast<cEntityEffect::eType>(a_NBT.FindChildByName(a_TagIdx, "EffectType"_nbt)));
 	SplashPotion->SetEntityEffect(cEntityEffect(EffectDuration, static_cast<Int16>(EffectIntensity), EffectDistanceModifier));
-	SplashPotion->SetPotionColor(a_NBT.FindChildByName(a_TagIdx, "PotionName"));
+	SplashPotion->SetPotionColor(a_NBT.FindChildByName(a_TagIdx, "PotionName"_nbt));
 
 	// Store the new splash potion in the entities list:
 	a_Entities.emplace_back(std::move(SplashPotion));
@@ -2879,9 +2782,9 @@ void cWSSAnvil::LoadGuardianFromNBT(cEntityList & a_Entities, const cParsedNBT &
 
 void cWSSAnvil::LoadHorseFromNBT(cEntityList & a_Entities, const cParsedNBT & a_NBT, int a_TagIdx)
 {
-	int TypeIdx  = a_NBT.FindChildByName(a_TagIdx, "Type");
-	int ColorIdx = a_NBT.FindChildByName(a_TagIdx, "Color");
-	int StyleIdx = a_NBT.FindChildByName(a_TagIdx, "Style");
+	int TypeIdx  = a_NBT.FindChildByName(a_TagIdx, "Type"_nbt);
+	int ColorIdx = a_NBT.FindChildByName(a_TagIdx, "Color"_nbt);
+	int StyleIdx = a_NBT.FindChildByName(a_TagIdx, "Style"_nbt);
 	if ((TypeIdx < 0) || (ColorIdx < 0) || (StyleIdx < 0))
 	{
 		return;
@@ -2903,7 +2806,7 @@ void cWSSAnvil::LoadHorseFromNBT(cEntityList & a_Entities, const cParsedNBT & a_
 		return;
 	}
 
-	int AgeableIdx  = a_NBT.FindChildByName(a_TagIdx, "Age");
+	int AgeableIdx  = a_NBT.FindChildByName(a_TagIdx, "Age"_nbt);
 	if (AgeableIdx > 0)
 	{
 		int Age;
@@ -2981,7 +2884,7 @@ void cWSSAnvil::LoadLlamaFromNBT(cEntityList &a_Entities, const cParsedNBT &a_NB
 
 void cWSSAnvil::LoadMagmaCubeFromNBT(cEntityList & a_Entities, const cParsedNBT & a_NBT, int a_TagIdx)
 {
-	int SizeIdx = a_NBT.FindChildByName(a_TagIdx, "Size");
+	int SizeIdx = a_NBT.FindChildByName(a_TagIdx, "Size"_nbt);
 
 	if (SizeIdx < 0)
 	{
@@ -3057,21 +2960,21 @@ void cWSSAnvil::LoadOcelotFromNBT(cEntityList & a_Entities, const cParsedNBT & a
 		Monster->SetIsTame(true);
 	}
 
-	int TypeIdx  = a_NBT.FindChildByName(a_TagIdx, "CatType");
+	int TypeIdx  = a_NBT.FindChildByName(a_TagIdx, "CatType"_nbt);
 	if (TypeIdx > 0)
 	{
 		int Type = a_NBT.GetInt(TypeIdx);
 		Monster->SetCatType(static_cast<cOcelot::eCatType>(Type));
 	}
 
-	int SittingIdx = a_NBT.FindChildByName(a_TagIdx, "Sitting");
+	int SittingIdx = a_NBT.FindChildByName(a_TagIdx, "Sitting"_nbt);
 	if ((SittingIdx > 0) && (a_NBT.GetType(SittingIdx) == TAG_Byte))
 	{
 		bool Sitting = (a_NBT.GetByte(SittingIdx) == 1);
 		Monster->SetIsSitting(Sitting);
 	}
 
-	int AgeableIdx  = a_NBT.FindChildByName(a_TagIdx, "Age");
+	int AgeableIdx  = a_NBT.FindChildByName(a_TagIdx, "Age"_nbt);
 	if (AgeableIdx > 0)
 	{
 		int Age;
@@ -3131,7 +3034,7 @@ void cWSSAnvil::LoadPigFromNBT(cEntityList & a_Entities, const cParsedNBT & a_NB
 		return;
 	}
 
-	int AgeableIdx  = a_NBT.FindChildByName(a_TagIdx, "Age");
+	int AgeableIdx  = a_NBT.FindChildByName(a_TagIdx, "Age"_nbt);
 	if (AgeableIdx > 0)
 	{
 		int Age;
@@ -3198,8 +3101,8 @@ void cWSSAnvil::LoadPufferfishFromNBT(cEntityList &a_Entities, const cParsedNBT
 
 void cWSSAnvil::LoadRabbitFromNBT(cEntityList & a_Entities, const cParsedNBT & a_NBT, int a_TagIdx)
 {
-	int TypeIdx  = a_NBT.FindChildByName(a_TagIdx, "RabbitType");
-	int MoreCarrotTicksIdx = a_NBT.FindChildByName(a_TagIdx, "MoreCarrotTicks");
+	int TypeIdx  = a_NBT.FindChildByName(a_TagIdx, "RabbitType"_nbt);
+	int MoreCarrotTicksIdx = a_NBT.FindChildByName(a_TagIdx, "MoreCarrotTicks"_nbt);
 
 	if ((TypeIdx < 0) || (MoreCarrotTicksIdx < 0))
 	{
@@ -3220,7 +3123,7 @@ void cWSSAnvil::LoadRabbitFromNBT(cEntityList & a_Entities, const cParsedNBT & a
 		return;
 	}
 
-	int AgeableIdx  = a_NBT.FindChildByName(a_TagIdx, "Age");
+	int AgeableIdx  = a_NBT.FindChildByName(a_TagIdx, "Age"_nbt);
 	if (AgeableIdx > 0)
 	{
 		int Age;
@@ -3260,7 +3163,7 @@ void cWSSAnvil::LoadSalmonFromNBT(cEntityList &a_Entities, const cParsedNBT &a_N
 
 void cWSSAnvil::LoadSheepFromNBT(cEntityList & a_Entities, const cParsedNBT & a_NBT, int a_TagIdx)
 {
-	int ColorIdx = a_NBT.FindChildByName(a_TagIdx, "Color");
+	int ColorIdx = a_NBT.FindChildByName(a_TagIdx, "Color"_nbt);
 	int Color = -1;
 	if (ColorIdx > 0)
 	{
@@ -3278,13 +3181,13 @@ void cWSSAnvil::LoadSheepFromNBT(cEntityList & a_Entities, const cParsedNBT & a_
 		return;
 	}
 
-	int ShearedIdx = a_NBT.FindChildByName(a_TagIdx, "Sheared");
+	int ShearedIdx = a_NBT.FindChildByName(a_TagIdx, "Sheared"_nbt);
 	if (ShearedIdx > 0)
 	{
 		Monster->SetSheared(a_NBT.GetByte(ShearedIdx) != 0);
 	}
 
-	int AgeableIdx  = a_NBT.FindChildByName(a_TagIdx, "Age");
+	int AgeableIdx  = a_NBT.FindChildByName(a_TagIdx, "Age"_nbt);
 	if (AgeableIdx > 0)
 	{
 		int Age;
@@ -3337,7 +3240,7 @@ void cWSSAnvil::LoadSkeletonFromNBT(cEntityList & a_Entities, const cParsedNBT &
 {
 	// Wither skeleton is a separate mob in Minecraft 1.11+, but we need this to
 	// load them from older worlds where wither skeletons were only a skeleton with a flag
-	int TypeIdx = a_NBT.FindChildByName(a_TagIdx, "SkeletonType");
+	int TypeIdx = a_NBT.FindChildByName(a_TagIdx, "SkeletonType"_nbt);
 
 	std::unique_ptr<cMonster> Monster;
 	if ((TypeIdx > 0) && (a_NBT.GetByte(TypeIdx) == 1))
@@ -3377,7 +3280,7 @@ void cWSSAnvil::LoadSkeletonHorseFromNBT(cEntityList &a_Entities, const cParsedN
 
 void cWSSAnvil::LoadSlimeFromNBT(cEntityList & a_Entities, const cParsedNBT & a_NBT, int a_TagIdx)
 {
-	int SizeIdx = a_NBT.FindChildByName(a_TagIdx, "Size");
+	int SizeIdx = a_NBT.FindChildByName(a_TagIdx, "Size"_nbt);
 
 	if (SizeIdx < 0)
 	{
@@ -3520,7 +3423,7 @@ void cWSSAnvil::LoadVexFromNBT(cEntityList &a_Entities, const cParsedNBT &a_NBT,
 
 void cWSSAnvil::LoadVillagerFromNBT(cEntityList & a_Entities, const cParsedNBT & a_NBT, int a_TagIdx)
 {
-	int TypeIdx = a_NBT.FindChildByName(a_TagIdx, "Profession");
+	int TypeIdx = a_NBT.FindChildByName(a_TagIdx, "Profession"_nbt);
 	if (TypeIdx < 0)
 	{
 		return;
@@ -3539,7 +3442,7 @@ void cWSSAnvil::LoadVillagerFromNBT(cEntityList & a_Entities, const cParsedNBT &
 		return;
 	}
 
-	int AgeableIdx  = a_NBT.FindChildByName(a_TagIdx, "Age");
+	int AgeableIdx  = a_NBT.FindChildByName(a_TagIdx, "Age"_nbt);
 	if (AgeableIdx > 0)
 	{
 		int Age;
@@ -3552,7 +3455,7 @@ void cWSSAnvil::LoadVillagerFromNBT(cEntityList & a_Entities, const cParsedNBT &
 		Monster->SetAge(Age);
 	}
 
-	int InventoryIdx = a_NBT.FindChildByName(a_TagIdx, "Inventory");
+	int InventoryIdx = a_NBT.FindChildByName(a_TagIdx, "Inventory"_nbt);
 	if (InventoryIdx > 0)
 	{
 		LoadItemGridFromNBT(Monster->GetInventory(), a_NBT, InventoryIdx);
@@ -3617,7 +3520,7 @@ void cWSSAnvil::LoadWitherFromNBT(cEntityList & a_Entities, const cParsedNBT & a
 		return;
 	}
 
-	int CurrLine = a_NBT.FindChildByName(a_TagIdx, "Invul");
+	int CurrLine = a_NBT.FindChildByName(a_TagIdx, "Invul"_nbt);
 	if (CurrLine > 0)
 	{
 		Monster->SetWitherInvulnerableTicks(static_cast<unsigned int>(a_NBT.GetInt(CurrLine)));
@@ -3669,19 +3572,19 @@ void cWSSAnvil::LoadWolfFromNBT(cEntityList & a_Entities, const cParsedNBT & a_N
 		Monster->SetIsTame(true);
 	}
 
-	int SittingIdx = a_NBT.FindChildByName(a_TagIdx, "Sitting");
+	int SittingIdx = a_NBT.FindChildByName(a_TagIdx, "Sitting"_nbt);
 	if ((SittingIdx > 0) && (a_NBT.GetType(SittingIdx) == TAG_Byte))
 	{
 		bool Sitting = (a_NBT.GetByte(SittingIdx) == 1);
 		Monster->SetIsSitting(Sitting);
 	}
-	int AngryIdx = a_NBT.FindChildByName(a_TagIdx, "Angry");
+	int AngryIdx = a_NBT.FindChildByName(a_TagIdx, "Angry"_nbt);
 	if ((AngryIdx > 0) && (a_NBT.GetType(AngryIdx) == TAG_Byte))
 	{
 		bool Angry = (a_NBT.GetByte(AngryIdx) == 1);
 		Monster->SetIsAngry(Angry);
 	}
-	int CollarColorIdx = a_NBT.FindChildByName(a_TagIdx, "CollarColor");
+	int CollarColorIdx = a_NBT.FindChildByName(a_TagIdx, "CollarColor"_nbt);
 	if (CollarColorIdx > 0)
 	{
 		switch (a_NBT.GetType(CollarColorIdx))
@@ -3706,7 +3609,7 @@ void cWSSAnvil::LoadWolfFromNBT(cEntityList & a_Entities, const cParsedNBT & a_N
 		}
 	}
 
-	int AgeableIdx  = a_NBT.FindChildByName(a_TagIdx, "Age");
+	int AgeableIdx  = a_NBT.FindChildByName(a_TagIdx, "Age"_nbt);
 	if (AgeableIdx > 0)
 	{
 		int Age;
@@ -3748,7 +3651,7 @@ void cWSSAnvil::LoadZombieFromNBT(cEntityList & a_Entities, const cParsedNBT & a
 		return;
 	}
 
-	int AgeableIdx  = a_NBT.FindChildByName(a_TagIdx, "Age");
+	int AgeableIdx  = a_NBT.FindChildByName(a_TagIdx, "Age"_nbt);
 	if (AgeableIdx > 0)
 	{
 		int Age;
@@ -3790,7 +3693,7 @@ void cWSSAnvil::LoadZombifiedPiglinFromNBT(cEntityList & a_Entities, const cPars
 		return;
 	}
 
-	int AgeableIdx  = a_NBT.FindChildByName(a_TagIdx, "Age");
+	int AgeableIdx  = a_NBT.FindChildByName(a_TagIdx, "Age"_nbt);
 	if (AgeableIdx > 0)
 	{
 		int Age;
@@ -3812,7 +3715,7 @@ void cWSSAnvil::LoadZombifiedPiglinFromNBT(cEntityList & a_Entities, const cPars
 
 void cWSSAnvil::LoadZombieVillagerFromNBT(cEntityList & a_Entities, const cParsedNBT & a_NBT, int a_TagIdx)
 {
-	int ProfessionIdx = a_NBT.FindChildByName(a_TagIdx, "Profession");
+	int ProfessionIdx = a_NBT.FindChildByName(a_TagIdx, "Profession"_nbt);
 	if (ProfessionIdx < 0)
 	{
 		return;
@@ -3833,7 +3736,7 @@ void cWSSAnvil::LoadZombieVillagerFromNBT(cEntityList & a_Entities, const cParse
 
 	// TODO: Conversion time
 
-	int AgeableIdx  = a_NBT.FindChildByName(a_TagIdx, "Age");
+	int AgeableIdx  = a_NBT.FindChildByName(a_TagIdx, "Age"_nbt);
 	if (AgeableIdx > 0)
 	{
 		int Age;
@@ -3858,12 +3761,12 @@ std::pair<AString, cUUID> cWSSAnvil::LoadEntityOwner(const cParsedNBT & a_NBT, i
 	// Load the owner information. OwnerUUID or Owner may be specified, possibly both:
 	AString OwnerName;
 	cUUID OwnerUUID;
-	int OwnerUUIDIdx = a_NBT.FindChildByName(a_TagIdx, "OwnerUUID");
+	int OwnerUUIDIdx = a_NBT.FindChildByName(a_TagIdx, "OwnerUUID"_nbt);
 	if (OwnerUUIDIdx > 0)
 	{
 		OwnerUUID.FromString(a_NBT.GetString(OwnerUUIDIdx));
 	}
-	int OwnerIdx = a_NBT.FindChildByName(a_TagIdx, "Owner");
+	int OwnerIdx = a_NBT.FindChildByName(a_TagIdx, "Owner"_nbt);
 	if (OwnerIdx > 0)
 	{
 		OwnerName = a_NBT.GetString(OwnerIdx);
@@ -3909,14 +3812,14 @@ std::pair<AString, cUUID> cWSSAnvil::LoadEntityOwner(const cParsedNBT & a_NBT, i
 bool cWSSAnvil::LoadEntityBaseFromNBT(cEntity & a_Entity, const cParsedNBT & a_NBT, int a_TagIdx)
 {
 	double Pos[3];
-	if (!LoadDoublesListFromNBT(Pos, 3, a_NBT, a_NBT.FindChildByName(a_TagIdx, "Pos")))
+	if (!LoadDoublesListFromNBT(Pos, 3, a_NBT, a_NBT.FindChildByName(a_TagIdx, "Pos"_nbt)))
 	{
 		return false;
 	}
 	a_Entity.SetPosition(Pos[0], Pos[1], Pos[2]);
 
 	double Speed[3];
-	if (!LoadDoublesListFromNBT(Speed, 3, a_NBT, a_NBT.FindChildByName(a_TagIdx, "Motion")))
+	if (!LoadDoublesListFromNBT(Speed, 3, a_NBT, a_NBT.FindChildByName(a_TagIdx, "Motion"_nbt)))
 	{
 		// Provide default speed:
 		Speed[0] = 0;
@@ -3926,7 +3829,7 @@ bool cWSSAnvil::LoadEntityBaseFromNBT(cEntity & a_Entity, const cParsedNBT & a_N
 	a_Entity.SetSpeed(Speed[0], Speed[1], Speed[2]);
 
 	double Rotation[3];
-	if (!LoadDoublesListFromNBT(Rotation, 2, a_NBT, a_NBT.FindChildByName(a_TagIdx, "Rotation")))
+	if (!LoadDoublesListFromNBT(Rotation, 2, a_NBT, a_NBT.FindChildByName(a_TagIdx, "Rotation"_nbt)))
 	{
 		// Provide default rotation:
 		Rotation[0] = 0;
@@ -3938,8 +3841,8 @@ bool cWSSAnvil::LoadEntityBaseFromNBT(cEntity & a_Entity, const cParsedNBT & a_N
 	// Depending on the Minecraft version, the entity's health is
 	// stored either as a float Health tag (HealF prior to 1.9) or
 	// as a short Health tag. The float tags should be preferred.
-	int Health = a_NBT.FindChildByName(a_TagIdx, "Health");
-	int HealF  = a_NBT.FindChildByName(a_TagIdx, "HealF");
+	int Health = a_NBT.FindChildByName(a_TagIdx, "Health"_nbt);
+	int HealF  = a_NBT.FindChildByName(a_TagIdx, "HealF"_nbt);
 
 	if (Health > 0 && a_NBT.GetType(Health) == TAG_Float)
 	{
@@ -3968,7 +3871,7 @@ bool cWSSAnvil::LoadEntityBaseFromNBT(cEntity & a_Entity, const cParsedNBT & a_N
 bool cWSSAnvil::LoadMonsterBaseFromNBT(cMonster & a_Monster, const cParsedNBT & a_NBT, int a_TagIdx)
 {
 	float DropChance[5];
-	if (LoadFloatsListFromNBT(DropChance, 5, a_NBT, a_NBT.FindChildByName(a_TagIdx, "DropChances")))
+	if (LoadFloatsListFromNBT(DropChance, 5, a_NBT, a_NBT.FindChildByName(a_TagIdx, "DropChances"_nbt)))
 	{
 		a_Monster.SetDropChanceWeapon(DropChance[0]);
 		a_Monster.SetDropChanceHelmet(DropChance[1]);
@@ -3976,11 +3879,11 @@ bool cWSSAnvil::LoadMonsterBaseFromNBT(cMonster & a_Monster, const cParsedNBT &
 		a_Monster.SetDropChanceLeggings(DropChance[3]);
 		a_Monster.SetDropChanceBoots(DropChance[4]);
 	}
-	if (LoadFloatsListFromNBT(DropChance, 2, a_NBT, a_NBT.FindChildByName(a_TagIdx, "HandDropChances")))
+	if (LoadFloatsListFromNBT(DropChance, 2, a_NBT, a_NBT.FindChildByName(a_TagIdx, "HandDropChances"_nbt)))
 	{
 		a_Monster.SetDropChanceWeapon(DropChance[0]);
 	}
-	if (LoadFloatsListFromNBT(DropChance, 4, a_NBT, a_NBT.FindChildByName(a_TagIdx, "ArmorDropChances")))
+	if (LoadFloatsListFromNBT(DropChance, 4, a_NBT, a_NBT.FindChildByName(a_TagIdx, "ArmorDropChances"_nbt)))
 	{
 		a_Monster.SetDropChanceHelmet(DropChance[0]);
 		a_Monster.SetDropChanceChestplate(DropChance[1]);
@@ -3988,20 +3891,20 @@ bool cWSSAnvil::LoadMonsterBaseFromNBT(cMonster & a_Monster, const cParsedNBT &
 		a_Monster.SetDropChanceBoots(DropChance[3]);
 	}
 
-	int LootTag = a_NBT.FindChildByName(a_TagIdx, "CanPickUpLoot");
+	int LootTag = a_NBT.FindChildByName(a_TagIdx, "CanPickUpLoot"_nbt);
 	if (LootTag > 0)
 	{
 		bool CanPickUpLoot = (a_NBT.GetByte(LootTag) == 1);
 		a_Monster.SetCanPickUpLoot(CanPickUpLoot);
 	}
 
-	int CustomNameTag = a_NBT.FindChildByName(a_TagIdx, "CustomName");
+	int CustomNameTag = a_NBT.FindChildByName(a_TagIdx, "CustomName"_nbt);
 	if ((CustomNameTag > 0) && (a_NBT.GetType(CustomNameTag) == TAG_String))
 	{
 		a_Monster.SetCustomName(a_NBT.GetString(CustomNameTag));
 	}
 
-	int CustomNameVisibleTag = a_NBT.FindChildByName(a_TagIdx, "CustomNameVisible");
+	int CustomNameVisibleTag = a_NBT.FindChildByName(a_TagIdx, "CustomNameVisible"_nbt);
 	if ((CustomNameVisibleTag > 0) && (a_NBT.GetType(CustomNameVisibleTag) == TAG_Byte))
 	{
 		bool CustomNameVisible = (a_NBT.GetByte(CustomNameVisibleTag) == 1);
@@ -4009,7 +3912,7 @@ bool cWSSAnvil::LoadMonsterBaseFromNBT(cMonster & a_Monster, const cParsedNBT &
 	}
 
 	// Leashed to a knot
-	int LeashedIdx = a_NBT.FindChildByName(a_TagIdx, "Leashed");
+	int LeashedIdx = a_NBT.FindChildByName(a_TagIdx, "Leashed"_nbt);
 	if ((LeashedIdx >= 0) && a_NBT.GetByte(LeashedIdx))
 	{
 		LoadLeashToPosition(a_Monster, a_NBT, a_TagIdx);
@@ -4024,7 +3927,7 @@ bool cWSSAnvil::LoadMonsterBaseFromNBT(cMonster & a_Monster, const cParsedNBT &
 
 void cWSSAnvil::LoadLeashToPosition(cMonster & a_Monster, const cParsedNBT & a_NBT, int a_TagIdx)
 {
-	int LeashIdx = a_NBT.FindChildByName(a_TagIdx, "Leash");
+	int LeashIdx = a_NBT.FindChildByName(a_TagIdx, "Leash"_nbt);
 	if (LeashIdx < 0)
 	{
 		return;
@@ -4032,7 +3935,7 @@ void cWSSAnvil::LoadLeashToPosition(cMonster & a_Monster, const cParsedNBT & a_N
 
 	double PosX = 0.0, PosY = 0.0, PosZ = 0.0;
 	bool KnotPosPresent = true;
-	int LeashDataLine = a_NBT.FindChildByName(LeashIdx, "X");
+	int LeashDataLine = a_NBT.FindChildByName(LeashIdx, "X"_nbt);
 	if (LeashDataLine >= 0)
 	{
 		PosX = a_NBT.GetDouble(LeashDataLine);
@@ -4041,7 +3944,7 @@ void cWSSAnvil::LoadLeashToPosition(cMonster & a_Monster, const cParsedNBT & a_N
 	{
 		KnotPosPresent = false;
 	}
-	LeashDataLine = a_NBT.FindChildByName(LeashIdx, "Y");
+	LeashDataLine = a_NBT.FindChildByName(LeashIdx, "Y"_nbt);
 	if (LeashDataLine >= 0)
 	{
 		PosY = a_NBT.GetDouble(LeashDataLine);
@@ -4050,7 +3953,7 @@ void cWSSAnvil::LoadLeashToPosition(cMonster & a_Monster, const cParsedNBT & a_N
 	{
 		KnotPosPresent = false;
 	}
-	LeashDataLine = a_NBT.FindChildByName(LeashIdx, "Z");
+	LeashDataLine = a_NBT.FindChildByName(LeashIdx, "Z"_nbt);
 	if (LeashDataLine >= 0)
 	{
 		PosZ = a_NBT.GetDouble(LeashDataLine);
@@ -4078,7 +3981,7 @@ bool cWSSAnvil::LoadProjectileBaseFromNBT(cProjectileEntity & a_Entity, const cP
 	}
 
 	bool IsInGround = false;
-	int InGroundIdx = a_NBT.FindChildByName(a_TagIdx, "inGround");
+	int InGroundIdx = a_NBT.FindChildByName(a_TagIdx, "inGround"_nbt);
 	if (InGroundIdx > 0)
 	{
 		IsInGround = (a_NBT.GetByte(InGroundIdx) != 0);
@@ -4130,17 +4033,17 @@ bool cWSSAnvil::LoadFloatsListFromNBT(float * a_Floats, int a_NumFloats, const c
 
 bool cWSSAnvil::GetBlockEntityNBTPos(const cParsedNBT & a_NBT, int a_TagIdx, Vector3i & a_AbsPos)
 {
-	int x = a_NBT.FindChildByName(a_TagIdx, "x");
+	int x = a_NBT.FindChildByName(a_TagIdx, "x"_nbt);
 	if ((x < 0) || (a_NBT.GetType(x) != TAG_Int))
 	{
 		return false;
 	}
-	int y = a_NBT.FindChildByName(a_TagIdx, "y");
+	int y = a_NBT.FindChildByName(a_TagIdx, "y"_nbt);
 	if ((y < 0) || (a_NBT.GetType(y) != TAG_Int))
 	{
 		return false;
 	}
-	int z = a_NBT.FindChildByName(a_TagIdx, "z");
+	int z = a_NBT.FindChildByName(a_TagIdx, "z"_nbt);
 	if ((z < 0) || (a_NBT.GetType(z) != TAG_Int))
 	{
 		return false;
@@ -4303,7 +4206,7 @@ bool cWSSAnvil::cMCAFile::GetChunkData(const cChunkCoords & a_Chunk, ContiguousB
 
 
 
-const std::byte * cWSSAnvil::GetSectionData(const cParsedNBT & a_NBT, int a_Tag, const AString & a_ChildName, size_t a_Length)
+const std::byte * cWSSAnvil::GetSectionData(const cParsedNBT & a_NBT, int a_Tag, const sNBTKey & a_ChildName, size_t a_Length)
 {
 	int Child = a_NBT.FindChildByName(a_Tag, a_ChildName);
 	if ((Child >= 0) && (a_NBT.GetType(Child) == TAG_ByteArray) && (a_NBT.GetDataLength(Child) == a_Length))
@@ -4317,20 +4220,6 @@ const std::byte * cWSSAnvil::GetSectionData(const cParsedNBT & a_NBT, int a_Tag,
 
 
 
-const std::byte * cWSSAnvil::GetSectionDataLong(const cParsedNBT & a_NBT, int a_Tag, const AString & a_ChildName, size_t a_Length)
-{
-	int Child = a_NBT.FindChildByName(a_Tag, a_ChildName);
-	if ((Child >= 0) && (a_NBT.GetType(Child) == TAG_LongArray) && (a_NBT.GetDataLength(Child) == a_Length * 8))
-	{
-		return a_NBT.GetData(Child);
-	}
-	return nullptr;
-}
-
-
-
-
-
 bool cWSSAnvil::cMCAFile::SetChunkData(const cChunkCoords & a_Chunk, const ContiguousByteBufferView a_Data)
 {
 	if (!OpenFile(false))
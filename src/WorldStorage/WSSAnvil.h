@@ -4,6 +4,7 @@
 #include "../Registries/BlockStates.h"
 #include "../Registries/BlockTypes.h"
 #include "WorldStorage.h"
+#include "AnvilSectionDecoder.h"
 #include "FastNBT.h"
 #include "StringCompression.h"
 
@@ -37,6 +38,9 @@ public:
 
 	const static bool newFormat = true;
 
+	// cWSSchema override:
+	virtual sChunkSaveStats GetSaveStats(void) const override;
+
 protected:
 
 	enum
@@ -98,6 +102,28 @@ protected:
 	Compression::Extractor m_Extractor;
 	Compression::Compressor m_Compressor;
 
+	/** The buffer that the chunk NBT is serialized into, reused for all the saved chunks.
+	Only used by the storage thread. */
+	ContiguousByteBuffer m_NBTBuffer;
+
+	/** The buffer that the chunk NBT is compressed into, reused for all the saved chunks.
+	Only used by the storage thread. */
+	ContiguousByteBuffer m_CompressedBuffer;
+
+	/** The expected size of the next chunk's NBT, based on the previously saved chunks.
+	Decays slowly, so that a single huge chunk doesn't keep the buffers large forever. */
+	size_t m_NBTSizeEstimate;
+
+	/** The counters reported by GetSaveStats(); written by the storage thread, read by anyone. */
+	std::atomic<size_t> m_NumSavedChunks;
+	std::atomic<size_t> m_NumSaveAllocations;
+	std::atomic<size_t> m_NumSaveBytesCopied;
+	std::atomic<size_t> m_NumSaveBytesSerialized;
+	std::atomic<size_t> m_NumSaveBytesCompressed;
+
+	/** Decodes the block data of the 1.13+ sections, remembers the palettes across chunks. */
+	cAnvilSectionDecoder m_SectionDecoder;
+
 	/** Reports that the specified chunk failed to load and saves the chunk data to an external file. */
 	void ChunkLoadFailed(const cChunkCoords a_ChunkCoords, const AString & a_Reason, ContiguousByteBufferView a_ChunkDataToSave);
 
@@ -105,10 +131,7 @@ protected:
 	bool GetChunkData(const cChunkCoords & a_Chunk, ContiguousByteBuffer & a_Data);
 
 	/** Copies a_Length bytes of data from the specified NBT Tag's Child into the a_Destination buffer */
-	const std::byte * GetSectionData(const cParsedNBT & a_NBT, int a_Tag, const AString & a_ChildName, size_t a_Length);
-
-	/** Same as GetSectionData but uses TAG_LongArray Instead  */
-	const std::byte * GetSectionDataLong(const cParsedNBT & a_NBT, int a_Tag, const AString & a_ChildName, size_t a_Length);
+	const std::byte * GetSectionData(const cParsedNBT & a_NBT, int a_Tag, const sNBTKey & a_ChildName, size_t a_Length);
 
 	/** Sets chunk data into the correct file; locks file CS as needed */
 	bool SetChunkData(const cChunkCoords & a_Chunk, ContiguousByteBufferView a_Data);
@@ -116,8 +139,9 @@ protected:
 	/** Loads the chunk from the data (no locking needed) */
 	bool LoadChunkFromData(const cChunkCoords & a_Chunk, ContiguousByteBufferView a_Data);
 
-	/** Saves the chunk into datastream (no locking needed) */
-	Compression::Result SaveChunkToData(const cChunkCoords & a_Chunk);
+	/** Saves the chunk into datastream (no locking needed).
+	Returns a view into m_CompressedBuffer, valid until the next call. */
+	ContiguousByteBufferView SaveChunkToData(const cChunkCoords & a_Chunk);
 
 	/** Loads the chunk from NBT data (no locking needed).
 	a_RawChunkData is the raw (compressed) chunk data, used for offloading when chunk loading fails. */
@@ -138,6 +138,19 @@ size_t cWorldStorage::GetSaveQueueLength(void)
 
 
 
+sChunkSaveStats cWorldStorage::GetSaveStats(void) const
+{
+	if (m_SaveSchema == nullptr)
+	{
+		return {};
+	}
+	return m_SaveSchema->GetSaveStats();
+}
+
+
+
+
+
 void cWorldStorage::QueueLoadChunk(int a_ChunkX, int a_ChunkZ)
 {
 	ASSERT((a_ChunkX > -0x08000000) && (a_ChunkX < 0x08000000));
@@ -26,6 +26,20 @@ class cWorld;
 
 
 
+/** Statistics of the buffers used for saving chunks, summed over all the chunks saved so far. */
+struct sChunkSaveStats
+{
+	size_t m_NumChunks = 0;
+	size_t m_NumAllocations = 0;
+	size_t m_NumBytesCopied = 0;
+	size_t m_NumBytesSerialized = 0;
+	size_t m_NumBytesCompressed = 0;
+} ;
+
+
+
+
+
 /** Interface that all the world storage schemas need to implement */
 class cWSSchema abstract
 {
@@ -37,6 +51,10 @@ public:
 	virtual bool SaveChunk(const cChunkCoords & a_Chunk) = 0;
 	virtual const AString GetName(void) const = 0;
 
+	/** Returns the statistics of saving the chunks. Schemas that don't track them return all zeroes.
+	May be called from any thread. */
+	virtual sChunkSaveStats GetSaveStats(void) const { return {}; }
+
 protected:
 
 	cWorld * m_World;
@@ -75,6 +93,9 @@ public:
 	size_t GetLoadQueueLength(void);
 	size_t GetSaveQueueLength(void);
 
+	/** Returns the statistics of saving the chunks with the schema used for saving. */
+	sChunkSaveStats GetSaveStats(void) const;
+
 protected:
 
 	cWorld * m_World;
@@ -0,0 +1,493 @@
+
+// AnvilSectionDecoderBenchmark.cpp
+
+// Checks that cAnvilSectionDecoder produces the same blocks as the original string-based section loader,
+// and measures the section decoding throughput of both.
+// Usage: AnvilSectionDecoder-exe [<region file>]
+// With a region file (r.X.Z.mca from any 1.13+ world), its chunks are used; otherwise synthetic chunks are generated.
+
+#include "Globals.h"
+#include "../TestHelpers.h"
+#include "FastRandom.h"
+#include "StringCompression.h"
+#include "BlockState.h"
+#include "OSSupport/File.h"
+#include "WorldStorage/AnvilSectionDecoder.h"
+#include "WorldStorage/FastNBT.h"
+#include "WorldStorage/NamespaceSerializer.h"
+
+
+
+
+
+/** Number of synthetic chunks generated when no region file is given. */
+static const int NUM_SYNTHETIC_CHUNKS = 512;
+
+/** Number of times all the chunks are decoded when measuring. */
+static const int NUM_ROUNDS = 5;
+
+/** The DataVersion from which the sections are stored with padding (1.16+). */
+static const int PADDING_DATA_VERSION = 2566;
+
+
+
+
+
+/** Calls a_Callback(PaletteTag, DataTag, Y) for each paletted section of the chunk NBT, the same way cWSSAnvil finds them. */
+template <typename Callback>
+static void ForEachSection(const cParsedNBT & a_NBT, Callback a_Callback)
+{
+	int Level = a_NBT.FindChildByName(0, "Level");
+	if (Level < 0)
+	{
+		Level = 0;
+	}
+	int Sections = a_NBT.FindChildByName(Level, "Sections");
+	if (Sections < 0)
+	{
+		Sections = a_NBT.FindChildByName(Level, "sections");
+	}
+	if ((Sections < 0) || (a_NBT.GetType(Sections) != TAG_List))
+	{
+		return;
+	}
+	for (int Child = a_NBT.GetFirstChild(Sections); Child >= 0; Child = a_NBT.GetNextSibling(Child))
+	{
+		const int YTag = a_NBT.FindChildByName(Child, "Y");
+		if (YTag < 0)
+		{
+			continue;
+		}
+		const int Y = (a_NBT.GetType(YTag) == TAG_Int) ? a_NBT.GetInt(YTag) : static_cast<signed char>(a_NBT.GetByte(YTag));
+		if ((Y < 0) || (Y >= cChunkDef::NumSections))
+		{
+			continue;
+		}
+		int PaletteTag, DataTag;
+		const int BlockStates = a_NBT.FindChildByName(Child, "block_states");
+		if (BlockStates > 0)
+		{
+			PaletteTag = a_NBT.FindChildByName(BlockStates, "palette");
+			DataTag = a_NBT.FindChildByName(BlockStates, "data");
+		}
+		else
+		{
+			PaletteTag = a_NBT.FindChildByName(Child, "Palette");
+			DataTag = a_NBT.FindChildByName(Child, "BlockStates");
+		}
+		if ((PaletteTag < 0) || (a_NBT.GetType(PaletteTag) != TAG_List))
+		{
+			continue;
+		}
+		a_Callback(PaletteTag, DataTag, static_cast<size_t>(Y));
+	}
+}
+
+
+
+
+
+/** Returns true if the chunk is stored with index padding. */
+static bool UsesPadding(const cParsedNBT & a_NBT)
+{
+	const int DataVersion = a_NBT.FindChildByName(0, "DataVersion");
+	return ((DataVersion >= 0) && (a_NBT.GetInt(DataVersion) >= PADDING_DATA_VERSION));
+}
+
+
+
+
+
+/** The section decoding as originally done in cWSSAnvil::LoadChunkFromNBT(), used as the reference. */
+static void DecodeReference(const cParsedNBT & a_NBT, int a_PaletteTag, int a_DataTag, bool a_UsePadding, ChunkBlockData & a_BlockData, size_t a_Y)
+{
+	std::vector<BlockState> Paletteids;
+	for (int Child1 = a_NBT.GetFirstChild(a_PaletteTag); Child1 >= 0; Child1 = a_NBT.GetNextSibling(Child1))
+	{
+		AString blockid = a_NBT.GetString(a_NBT.FindChildByName(Child1, "Name"));
+		AString tosearch = blockid.substr(10, std::string::npos);
+		Paletteids.push_back(NamespaceSerializer::ToBlockType(tosearch));
+	}
+	if (Paletteids.empty())
+	{
+		return;
+	}
+	int IndexBitSize = std::max(4, static_cast<int>(std::ceil(std::log2(Paletteids.size()))));
+	int SectionBlockLongCount;
+	if (a_UsePadding)
+	{
+		int blocks_per_long = FloorC(64.0 / IndexBitSize);
+		SectionBlockLongCount = CeilC(4096.0 / blocks_per_long);
+	}
+	else
+	{
+		SectionBlockLongCount = IndexBitSize * 4096 / 8 / 8;
+	}
+	if ((a_DataTag < 0) || (a_NBT.GetType(a_DataTag) != TAG_LongArray) || (a_NBT.GetDataLength(a_DataTag) != static_cast<size_t>(SectionBlockLongCount) * 8))
+	{
+		if (Paletteids.size() == 1)
+		{
+			std::array<BlockState, 4096> Oneblock;
+			std::fill(Oneblock.begin(), Oneblock.end(), Paletteids[0]);
+			a_BlockData.SetSection(reinterpret_cast<ChunkBlockData::SectionType &>(Oneblock), a_Y);
+		}
+		return;
+	}
+	const std::byte * BlockStateData = a_NBT.GetData(a_DataTag);
+	std::vector<UInt64> LEstates(static_cast<size_t>(SectionBlockLongCount));
+	for (size_t i = 0; i < LEstates.size(); i++)
+	{
+		LEstates[i] = NetworkBufToHost<UInt64>(BlockStateData + i * 8);
+	}
+	BlockState resolveddata[4096];
+	int numblockdataindex = 0;
+	int BitIndex = 0;
+	size_t arrindex = 0;
+	while (numblockdataindex < 4096)
+	{
+		UInt64 finalv = 0;
+		if (BitIndex + IndexBitSize <= 64)
+		{
+			finalv = (LEstates[arrindex] >> BitIndex) & ((static_cast<UInt64>(1) << IndexBitSize) - 1);
+			BitIndex += IndexBitSize;
+			if (BitIndex == 64)
+			{
+				BitIndex = 0;
+				arrindex++;
+			}
+		}
+		else
+		{
+			if (a_UsePadding)
+			{
+				BitIndex = 0;
+				arrindex++;
+				continue;
+			}
+			UInt64 lowerpart = LEstates[arrindex] >> BitIndex;
+			arrindex++;
+			int BitsRead = (64 - BitIndex);
+			BitIndex = IndexBitSize - BitsRead;
+			UInt64 upperpart = (LEstates[arrindex] & ((static_cast<UInt64>(1) << BitIndex) - 1)) << BitsRead;
+			finalv = lowerpart | upperpart;
+		}
+		resolveddata[numblockdataindex] = (finalv < Paletteids.size()) ? Paletteids[finalv] : ChunkBlockData::DefaultValue;
+		numblockdataindex++;
+	}
+	a_BlockData.SetSection(resolveddata, a_Y);
+}
+
+
+
+
+
+/** Packs the palette indices into longs, the way vanilla stores them. */
+static std::vector<Int64> PackIndices(const std::vector<UInt16> & a_Indices, int a_BitsPerEntry, bool a_UsePadding)
+{
+	std::vector<Int64> Longs(cAnvilSectionDecoder::GetNumLongs(a_BitsPerEntry, a_UsePadding), 0);
+	size_t Bit = 0;
+	for (auto Index: a_Indices)
+	{
+		if (a_UsePadding && ((Bit % 64) + static_cast<size_t>(a_BitsPerEntry) > 64))
+		{
+			Bit = (Bit / 64 + 1) * 64;
+		}
+		const auto LongIdx = Bit / 64;
+		const auto Shift = Bit % 64;
+		Longs[LongIdx] = static_cast<Int64>(static_cast<UInt64>(Longs[LongIdx]) | (static_cast<UInt64>(Index) << Shift));
+		if (Shift + static_cast<size_t>(a_BitsPerEntry) > 64)
+		{
+			Longs[LongIdx + 1] = static_cast<Int64>(static_cast<UInt64>(Longs[LongIdx + 1]) | (static_cast<UInt64>(Index) >> (64 - Shift)));
+		}
+		Bit += static_cast<size_t>(a_BitsPerEntry);
+	}
+	return Longs;
+}
+
+
+
+
+
+/** Generates the NBT of a chunk resembling natural terrain: a few large palettes at the bottom, common small palettes above, air on top.
+Some of the names are legacy aliases, resolved through NamespaceSerializer's fallback. */
+static ContiguousByteBuffer GenerateChunk(cFastRandom & a_Random, bool a_UsePadding)
+{
+	static const char * CommonBlocks[] =
+	{
+		"stone", "dirt", "grass_block", "water", "granite", "diorite", "andesite", "gravel",
+		"coal_ore", "iron_ore", "sand", "bedrock", "oak_log", "oak_leaves", "short_grass", "grass",
+	};
+	const int LastType = static_cast<int>(BlockType::ZombieWallHead);
+
+	cFastNBTWriter Writer;
+	Writer.AddInt("DataVersion", a_UsePadding ? 3955 : 1976);
+	Writer.BeginList("sections", TAG_Compound);
+	for (int Y = 0; Y < cChunkDef::NumSections; Y++)
+	{
+		Writer.BeginCompound("");
+		Writer.AddInt("Y", Y);
+		Writer.BeginCompound("block_states");
+		Writer.BeginList("palette", TAG_Compound);
+		std::vector<AString> Palette;
+		if (Y >= 8)
+		{
+			Palette.push_back("air");
+		}
+		else if (Y < 2)
+		{
+			// Large palettes, up to 9 bits per index:
+			int Size = a_Random.RandInt(17, 400);
+			for (int i = 0; i < Size; i++)
+			{
+				Palette.emplace_back(NamespaceSerializer::From(static_cast<BlockType>(a_Random.RandInt(LastType))));
+			}
+		}
+		else
+		{
+			int Size = a_Random.RandInt(2, 16);
+			for (int i = 0; i < Size; i++)
+			{
+				Palette.emplace_back(CommonBlocks[(Y + i) % ARRAYCOUNT(CommonBlocks)]);
+			}
+		}
+		for (const auto & Name: Palette)
+		{
+			Writer.BeginCompound("");
+			Writer.AddString("Name", "minecraft:" + Name);
+			Writer.EndCompound();
+		}
+		Writer.EndList();
+		if (Palette.size() > 1)
+		{
+			std::vector<UInt16> Indices(ChunkBlockData::SectionBlockCount);
+			for (auto & Index: Indices)
+			{
+				Index = static_cast<UInt16>(a_Random.RandInt(static_cast<int>(Palette.size()) - 1));
+			}
+			auto Longs = PackIndices(Indices, cAnvilSectionDecoder::GetBitsPerEntry(Palette.size()), a_UsePadding);
+			Writer.AddLongArray("data", Longs.data(), Longs.size());
+		}
+		Writer.EndCompound();
+		Writer.AddByteArray("BlockLight", ChunkLightData::SectionLightCount, 0);
+		Writer.AddByteArray("SkyLight", ChunkLightData::SectionLightCount, 0xff);
+		Writer.EndCompound();
+	}
+	Writer.EndList();
+	Writer.Finish();
+	return ContiguousByteBuffer(Writer.GetResult());
+}
+
+
+
+
+
+/** Reads all the chunks stored in the region file, returns their uncompressed NBT. */
+static std::vector<ContiguousByteBuffer> LoadRegionFile(const AString & a_FileName)
+{
+	std::vector<ContiguousByteBuffer> Chunks;
+	auto Contents = cFile::ReadWholeFile(a_FileName);
+	if (Contents.size() < 8192)
+	{
+		LOGWARNING("Cannot read region file %s", a_FileName);
+		return Chunks;
+	}
+	const auto Data = reinterpret_cast<const std::byte *>(Contents.data());
+	Compression::Extractor Extractor;
+	for (size_t i = 0; i < 1024; i++)
+	{
+		const auto Location = NetworkBufToHost<UInt32>(Data + i * 4);
+		const size_t Offset = (Location >> 8) * 4096;
+		if ((Offset == 0) || (Offset + 5 > Contents.size()))
+		{
+			continue;
+		}
+		const size_t Length = NetworkBufToHost<UInt32>(Data + Offset);
+		const auto CompressionType = static_cast<int>(Data[Offset + 4]);
+		if ((CompressionType != 2) || (Length < 1) || (Offset + 4 + Length > Contents.size()))
+		{
+			continue;
+		}
+		try
+		{
+			auto Result = Extractor.ExtractZLib({ Data + Offset + 5, Length - 1 });
+			Chunks.emplace_back(Result.GetView());
+		}
+		catch (const std::exception & Oops)
+		{
+			LOGWARNING("Cannot decompress chunk %zu: %s", i, Oops.what());
+		}
+	}
+	LOG("Loaded %zu chunks from region file %s", Chunks.size(), a_FileName);
+	return Chunks;
+}
+
+
+
+
+
+/** Returns true if both sections contain the same blocks; a missing section is all air. */
+static bool IsSameSection(const ChunkBlockData::BlockArray * a_Section1, const ChunkBlockData::BlockArray * a_Section2)
+{
+	for (size_t i = 0; i < ChunkBlockData::SectionBlockCount; i++)
+	{
+		auto Block1 = (a_Section1 == nullptr) ? ChunkBlockData::DefaultValue : (*a_Section1)[i];
+		auto Block2 = (a_Section2 == nullptr) ? ChunkBlockData::DefaultValue : (*a_Section2)[i];
+		if (Block1 != Block2)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+
+
+
+/** Checks that the perfect hash table resolves every block name the same way as NamespaceSerializer. */
+static void TestNameResolution(void)
+{
+	for (int Type = 0; Type <= static_cast<int>(BlockType::ZombieWallHead); Type++)
+	{
+		auto Name = NamespaceSerializer::From(static_cast<BlockType>(Type));
+		auto Expected = BlockState(NamespaceSerializer::ToBlockType(Name));
+		TEST_EQUAL_MSG(cAnvilSectionDecoder::ResolveBlockName(Name).ID, Expected.ID, AString(Name));
+	}
+	TEST_EQUAL(cAnvilSectionDecoder::ResolveBlockName("grass").ID, BlockState(BlockType::ShortGrass).ID);
+}
+
+
+
+
+
+/** Checks that the decoder produces the same sections as the reference for all the chunks. */
+static void TestSameResults(const std::vector<ContiguousByteBuffer> & a_Chunks)
+{
+	cAnvilSectionDecoder Decoder;
+	size_t NumSections = 0;
+	for (const auto & Chunk: a_Chunks)
+	{
+		cParsedNBT NBT(Chunk);
+		TEST_TRUE(NBT.IsValid());
+		const bool UsePadding = UsesPadding(NBT);
+		ChunkBlockData Reference, Decoded;
+		AString FailReason;
+		ForEachSection(NBT, [&](int a_PaletteTag, int a_DataTag, size_t a_Y)
+			{
+				DecodeReference(NBT, a_PaletteTag, a_DataTag, UsePadding, Reference, a_Y);
+				auto Result = Decoder.DecodeSection(NBT, a_PaletteTag, a_DataTag, UsePadding, Decoded, a_Y, FailReason);
+				TEST_TRUE(Result == cAnvilSectionDecoder::eResult::Decoded);
+				TEST_TRUE(IsSameSection(Reference.GetSection(a_Y), Decoded.GetSection(a_Y)));
+				NumSections += 1;
+			}
+		);
+	}
+	LOG("Compared %zu sections in %zu chunks, %zu palettes were memoized, %zu resolved",
+		NumSections, a_Chunks.size(), Decoder.GetNumMemoHits(), Decoder.GetNumMemoMisses()
+	);
+}
+
+
+
+
+
+/** Decodes all the chunks NUM_ROUNDS times using a_Decode(NBT, PaletteTag, DataTag, UsePadding, BlockData, Y) and reports the throughput. */
+template <typename DecodeFn>
+static void Measure(const char * a_Name, const std::vector<ContiguousByteBuffer> & a_Chunks, DecodeFn a_Decode)
+{
+	// Parse the NBT up front, only the section decoding is measured:
+	std::vector<std::unique_ptr<cParsedNBT>> Parsed;
+	for (const auto & Chunk: a_Chunks)
+	{
+		Parsed.push_back(std::make_unique<cParsedNBT>(Chunk));
+	}
+
+	size_t NumSections = 0;
+	auto Start = std::chrono::steady_clock::now();
+	for (int Round = 0; Round < NUM_ROUNDS; Round++)
+	{
+		for (const auto & NBT: Parsed)
+		{
+			const bool UsePadding = UsesPadding(*NBT);
+			ChunkBlockData BlockData;
+			ForEachSection(*NBT, [&](int a_PaletteTag, int a_DataTag, size_t a_Y)
+				{
+					a_Decode(*NBT, a_PaletteTag, a_DataTag, UsePadding, BlockData, a_Y);
+					NumSections += 1;
+				}
+			);
+		}
+	}
+	auto Elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - Start).count();
+	auto NumChunks = a_Chunks.size() * NUM_ROUNDS;
+	LOG("%s: %zu chunks (%zu sections) in %lld usec, %.1f chunks / sec",
+		a_Name, NumChunks, NumSections, static_cast<long long>(Elapsed),
+		static_cast<double>(NumChunks) * 1000000 / std::max<long long>(Elapsed, 1)
+	);
+}
+
+
+
+
+
+static void Benchmark(const std::vector<ContiguousByteBuffer> & a_Chunks)
+{
+	Measure("Reference", a_Chunks, DecodeReference);
+	cAnvilSectionDecoder Decoder;
+	Measure("cAnvilSectionDecoder", a_Chunks, [&Decoder](const cParsedNBT & a_NBT, int a_PaletteTag, int a_DataTag, bool a_UsePadding, ChunkBlockData & a_BlockData, size_t a_Y)
+		{
+			AString FailReason;
+			Decoder.DecodeSection(a_NBT, a_PaletteTag, a_DataTag, a_UsePadding, a_BlockData, a_Y, FailReason);
+		}
+	);
+}
+
+
+
+
+
+int main(int argc, char * argv[])
+{
+	LOG("Test started: AnvilSectionDecoder");
+
+	try
+	{
+		std::vector<ContiguousByteBuffer> Chunks;
+		if (argc > 1)
+		{
+			Chunks = LoadRegionFile(argv[1]);
+		}
+		else
+		{
+			LOG("No region file given, using %d synthetic chunks", NUM_SYNTHETIC_CHUNKS);
+			cFastRandom Random;
+			for (int i = 0; i < NUM_SYNTHETIC_CHUNKS; i++)
+			{
+				Chunks.push_back(GenerateChunk(Random, (i % 4) != 0));
+			}
+		}
+		TEST_GREATER_THAN_OR_EQUAL(Chunks.size(), 1);
+
+		TestNameResolution();
+		TestSameResults(Chunks);
+		Benchmark(Chunks);
+	}
+	catch (const TestException & exc)
+	{
+		LOGERROR("Test has failed at file %s, line %d, function %s: %s",
+			exc.mFileName.c_str(),
+			exc.mLineNumber,
+			exc.mFunctionName.c_str(),
+			exc.mMessage.c_str()
+		);
+		return 1;
+	}
+	catch (const std::exception & exc)
+	{
+		LOGERROR("Test has failed, an exception was thrown: %s", exc.what());
+		return 1;
+	}
+
+	LOG("AnvilSectionDecoder test finished");
+	return 0;
+}
@@ -0,0 +1,342 @@
+
+// BlockAreaBenchmark.cpp
+
+// Checks that the cBlockArea rotation, mirroring and merging produce the same blocks as straightforward per-block implementations,
+// and measures their throughput on 64^3 and 256^3 areas.
+
+#include "Globals.h"
+#include "../TestHelpers.h"
+#include "BlockArea.h"
+#include "FastRandom.h"
+#include "Blocks/BlockAir.h"
+
+
+
+
+
+/** Number of times each operation is repeated when measuring. */
+static const int NUM_ROUNDS = 4;
+
+/** The blocks the test areas are made of; includes the blocks that the merge strategies treat specially. */
+static const BlockState TEST_BLOCKS[] =
+{
+	Block::Air::Air(),
+	Block::Air::Air(),
+	Block::Air::Air(),
+	Block::CaveAir::CaveAir(),
+	Block::VoidAir::VoidAir(),
+	Block::Stone::Stone(),
+	Block::Stone::Stone(),
+	Block::Dirt::Dirt(),
+	Block::Sponge::Sponge(),
+	Block::Water::Water(0),
+	Block::Water::Water(3),
+	Block::GrassBlock::GrassBlock(false),
+	Block::Bedrock::Bedrock(),
+};
+
+static const cBlockArea::eMergeStrategy ALL_STRATEGIES[] =
+{
+	cBlockArea::msOverwrite,
+	cBlockArea::msFillAir,
+	cBlockArea::msImprint,
+	cBlockArea::msLake,
+	cBlockArea::msSpongePrint,
+	cBlockArea::msDifference,
+	cBlockArea::msSimpleCompare,
+	cBlockArea::msMask,
+};
+
+
+
+
+
+/** Creates an area of the specified size filled with random blocks.
+Runs of the same block are generated, as in real-world areas. */
+static void CreateRandomArea(cBlockArea & a_Area, Vector3i a_Size, cFastRandom & a_Random)
+{
+	a_Area.Create(a_Size, cBlockArea::baBlocks);
+	auto Blocks = a_Area.GetBlocks();
+	const auto Count = a_Area.GetBlockCount();
+	size_t i = 0;
+	while (i < Count)
+	{
+		const auto Block = TEST_BLOCKS[a_Random.RandInt<size_t>(ARRAYCOUNT(TEST_BLOCKS) - 1)];
+		const auto RunLength = std::min(Count - i, a_Random.RandInt<size_t>(1, 8));
+		std::fill_n(Blocks + i, RunLength, Block);
+		i += RunLength;
+	}
+}
+
+
+
+
+
+/** Returns true if both areas have the same size and the same blocks. */
+static bool IsSameArea(const cBlockArea & a_Area1, const cBlockArea & a_Area2)
+{
+	return (
+		(a_Area1.GetSize() == a_Area2.GetSize()) &&
+		std::equal(a_Area1.GetBlocks(), a_Area1.GetBlocks() + a_Area1.GetBlockCount(), a_Area2.GetBlocks())
+	);
+}
+
+
+
+
+
+/** Rotates the area counter-clockwise (or clockwise) block by block.
+The test stubs have no block handlers that would change the block states. */
+static void RotateReference(const cBlockArea & a_Src, cBlockArea & a_Dst, bool a_IsClockwise)
+{
+	const auto Size = a_Src.GetSize();
+	a_Dst.Create(Size.z, Size.y, Size.x, cBlockArea::baBlocks);
+	for (int y = 0; y < Size.y; y++)
+	{
+		for (int z = 0; z < Size.z; z++)
+		{
+			for (int x = 0; x < Size.x; x++)
+			{
+				const Vector3i NewPos = a_IsClockwise ? Vector3i(Size.z - z - 1, y, x) : Vector3i(z, y, Size.x - x - 1);
+				a_Dst.SetRelBlock(NewPos, a_Src.GetRelBlock({ x, y, z }));
+			}
+		}
+	}
+}
+
+
+
+
+
+/** Mirrors the area block by block; a_Axis is the axis along which the blocks move (0 = X for YZ, 1 = Y for XZ, 2 = Z for XY). */
+static void MirrorReference(const cBlockArea & a_Src, cBlockArea & a_Dst, int a_Axis)
+{
+	const auto Size = a_Src.GetSize();
+	a_Dst.Create(Size, cBlockArea::baBlocks);
+	for (int y = 0; y < Size.y; y++)
+	{
+		for (int z = 0; z < Size.z; z++)
+		{
+			for (int x = 0; x < Size.x; x++)
+			{
+				Vector3i NewPos(x, y, z);
+				switch (a_Axis)
+				{
+					case 0: NewPos.x = Size.x - x - 1; break;
+					case 1: NewPos.y = Size.y - y - 1; break;
+					default: NewPos.z = Size.z - z - 1; break;
+				}
+				a_Dst.SetRelBlock(NewPos, a_Src.GetRelBlock({ x, y, z }));
+			}
+		}
+	}
+}
+
+
+
+
+
+/** Returns the result of merging a single block, as documented in cBlockArea::Merge(). */
+static BlockState MergeReference(BlockState a_Dst, BlockState a_Src, cBlockArea::eMergeStrategy a_Strategy)
+{
+	switch (a_Strategy)
+	{
+		case cBlockArea::msOverwrite: return a_Src;
+		case cBlockArea::msFillAir: return cBlockAirHandler::IsBlockAir(a_Dst) ? a_Src : a_Dst;
+		case cBlockArea::msImprint: return cBlockAirHandler::IsBlockAir(a_Src) ? a_Dst : a_Src;
+		case cBlockArea::msSpongePrint: return (a_Src.Type() == BlockType::Sponge) ? a_Dst : a_Src;
+		case cBlockArea::msDifference: return (a_Dst.Type() == a_Src.Type()) ? BlockState(BlockType::Air) : a_Src;
+		case cBlockArea::msSimpleCompare: return (a_Dst == a_Src) ? Block::Air::Air() : Block::Stone::Stone();
+		case cBlockArea::msMask: return (a_Dst.Type() == a_Src.Type()) ? a_Dst : BlockState(BlockType::Air);
+		case cBlockArea::msLake:
+		{
+			if (a_Src.Type() == BlockType::Sponge)
+			{
+				return a_Dst;
+			}
+			if (cBlockAirHandler::IsBlockAir(a_Src))
+			{
+				return Block::Air::Air();
+			}
+			if ((a_Dst.Type() == BlockType::Water) || (a_Dst.Type() == BlockType::Lava))
+			{
+				return a_Dst;
+			}
+			if ((a_Src.Type() == BlockType::Water) || (a_Src.Type() == BlockType::Lava))
+			{
+				return a_Src;
+			}
+			if ((a_Src.Type() == BlockType::Stone) && ((a_Dst.Type() == BlockType::Dirt) || (a_Dst.Type() == BlockType::ShortGrass) || (a_Dst.Type() == BlockType::Mycelium)))
+			{
+				return BlockType::Stone;
+			}
+			return a_Dst;
+		}
+	}
+	UNREACHABLE("Unsupported block area merge strategy");
+}
+
+
+
+
+
+/** Checks the transformations and merges of an area of the specified size against the reference implementations. */
+static void TestSameResults(Vector3i a_Size, cFastRandom & a_Random)
+{
+	LOG("Checking an area of %d x %d x %d blocks", a_Size.x, a_Size.y, a_Size.z);
+	cBlockArea Area, Expected, Actual;
+	CreateRandomArea(Area, a_Size, a_Random);
+
+	// Rotations:
+	RotateReference(Area, Expected, false);
+	Actual.CopyFrom(Area);
+	Actual.RotateCCW();
+	TEST_TRUE(IsSameArea(Expected, Actual));
+
+	RotateReference(Area, Expected, true);
+	Actual.CopyFrom(Area);
+	Actual.RotateCW();
+	TEST_TRUE(IsSameArea(Expected, Actual));
+
+	// Mirroring:
+	MirrorReference(Area, Expected, 0);
+	Actual.CopyFrom(Area);
+	Actual.MirrorYZ();
+	TEST_TRUE(IsSameArea(Expected, Actual));
+
+	MirrorReference(Area, Expected, 1);
+	Actual.CopyFrom(Area);
+	Actual.MirrorXZ();
+	TEST_TRUE(IsSameArea(Expected, Actual));
+
+	MirrorReference(Area, Expected, 2);
+	Actual.CopyFrom(Area);
+	Actual.MirrorXY();
+	TEST_TRUE(IsSameArea(Expected, Actual));
+
+	// Merging, with the source sticking out of the destination on some sides:
+	cBlockArea Src;
+	CreateRandomArea(Src, { std::max(a_Size.x - 3, 1), std::max(a_Size.y - 2, 1), std::max(a_Size.z - 5, 1) }, a_Random);
+	const Vector3i RelPos(5, -1, -2);
+	for (const auto Strategy: ALL_STRATEGIES)
+	{
+		Expected.CopyFrom(Area);
+		for (int y = 0; y < Src.GetSizeY(); y++)
+		{
+			for (int z = 0; z < Src.GetSizeZ(); z++)
+			{
+				for (int x = 0; x < Src.GetSizeX(); x++)
+				{
+					const auto DstPos = RelPos + Vector3i(x, y, z);
+					if (Expected.IsValidRelCoords(DstPos))
+					{
+						Expected.SetRelBlock(DstPos, MergeReference(Expected.GetRelBlock(DstPos), Src.GetRelBlock({ x, y, z }), Strategy));
+					}
+				}
+			}
+		}
+		Actual.CopyFrom(Area);
+		Actual.Merge(Src, RelPos, Strategy);
+		TEST_EQUAL_MSG(IsSameArea(Expected, Actual), true, fmt::format(FMT_STRING("Merge strategy {}"), static_cast<int>(Strategy)));
+	}
+}
+
+
+
+
+
+/** Runs a_Fn(Area) NUM_ROUNDS times on a fresh copy of a_Area and logs the average time and throughput. */
+template <typename Fn>
+static void Measure(const char * a_Name, const cBlockArea & a_Area, Fn a_Fn)
+{
+	cBlockArea Area;
+	std::chrono::steady_clock::duration Total{};
+	for (int i = 0; i < NUM_ROUNDS; i++)
+	{
+		Area.CopyFrom(a_Area);
+		const auto Start = std::chrono::steady_clock::now();
+		a_Fn(Area);
+		Total += std::chrono::steady_clock::now() - Start;
+	}
+	const auto Seconds = std::chrono::duration<double>(Total).count() / NUM_ROUNDS;
+	LOG("  %-24s %9.3f ms, %8.1f Mblocks / s", a_Name, Seconds * 1000, static_cast<double>(a_Area.GetBlockCount()) / Seconds / 1e6);
+}
+
+
+
+
+
+/** Measures all the operations on a cube area with the specified edge. */
+static void Benchmark(int a_Edge, cFastRandom & a_Random)
+{
+	LOG("Area of %d^3 blocks:", a_Edge);
+	cBlockArea Area, Src;
+	CreateRandomArea(Area, { a_Edge, a_Edge, a_Edge }, a_Random);
+	CreateRandomArea(Src, { a_Edge, a_Edge, a_Edge }, a_Random);
+
+	cBlockArea Dst;
+	Measure("RotateCCW (reference)", Area, [&Dst](cBlockArea & a_Area) { RotateReference(a_Area, Dst, false); });
+	Measure("RotateCCW", Area, [](cBlockArea & a_Area) { a_Area.RotateCCW(); });
+	Measure("RotateCW", Area, [](cBlockArea & a_Area) { a_Area.RotateCW(); });
+	Measure("MirrorXY", Area, [](cBlockArea & a_Area) { a_Area.MirrorXY(); });
+	Measure("MirrorXZ", Area, [](cBlockArea & a_Area) { a_Area.MirrorXZ(); });
+	Measure("MirrorYZ", Area, [](cBlockArea & a_Area) { a_Area.MirrorYZ(); });
+
+	static const char * StrategyNames[] =
+	{
+		"Merge msOverwrite",
+		"Merge msFillAir",
+		"Merge msImprint",
+		"Merge msLake",
+		"Merge msSpongePrint",
+		"Merge msDifference",
+		"Merge msSimpleCompare",
+		"Merge msMask",
+	};
+	for (const auto Strategy: ALL_STRATEGIES)
+	{
+		Measure(StrategyNames[Strategy], Area, [&Src, Strategy](cBlockArea & a_Area) { a_Area.Merge(Src, { 0, 0, 0 }, Strategy); });
+	}
+}
+
+
+
+
+
+int main()
+{
+	LOG("Test started: BlockArea");
+
+	try
+	{
+		cFastRandom Random;
+
+		// Odd sizes exercise the partial tiles and the middle rows / layers of the mirroring:
+		TestSameResults({ 37, 19, 45 }, Random);
+		TestSameResults({ 1, 5, 70 }, Random);
+
+		// Large enough to be processed by multiple threads:
+		TestSameResults({ 161, 97, 150 }, Random);
+
+		Benchmark(64, Random);
+		Benchmark(256, Random);
+	}
+	catch (const TestException & exc)
+	{
+		LOGERROR("Test has failed at file %s, line %d, function %s: %s",
+			exc.mFileName.c_str(),
+			exc.mLineNumber,
+			exc.mFunctionName.c_str(),
+			exc.mMessage.c_str()
+		);
+		return 1;
+	}
+	catch (const std::exception & exc)
+	{
+		LOGERROR("Test has failed, an exception was thrown: %s", exc.what());
+		return 1;
+	}
+
+	LOG("BlockArea test finished");
+	return 0;
+}
@@ -0,0 +1,190 @@
+
+#include "Globals.h"
+#include "../TestHelpers.h"
+#include "ChunkData.h"
+
+
+
+
+
+/** Fills all sections of the data with blocks and light, as a fully populated chunk. */
+static void FillChunk(ChunkBlockData & a_BlockData, ChunkLightData & a_LightData)
+{
+	for (size_t Y = 0; Y < cChunkDef::NumSections; Y++)
+	{
+		auto & Section = a_BlockData.GetSectionForOverwrite(Y);
+		std::fill(Section.begin(), Section.end(), BlockState(static_cast<BlockState::DataType>(Y + 1)));
+
+		ChunkLightData::SectionType Light;
+		std::fill(std::begin(Light), std::end(Light), static_cast<LIGHTTYPE>(Y + 1));
+		a_LightData.SetSection(Light, Light, Y);
+	}
+}
+
+
+
+
+
+/** A snapshot keeps its contents while the source is written into, and only the written sections get cloned. */
+static void TestCopyOnWrite(void)
+{
+	ChunkBlockData Source;
+	ChunkLightData SourceLight;
+	FillChunk(Source, SourceLight);
+
+	ChunkBlockData Snapshot;
+	ChunkLightData SnapshotLight;
+	Snapshot.Assign(Source);
+	SnapshotLight.Assign(SourceLight);
+	for (size_t Y = 0; Y < cChunkDef::NumSections; Y++)
+	{
+		TEST_EQUAL(Snapshot.GetSection(Y), Source.GetSection(Y));
+		TEST_EQUAL(SnapshotLight.GetBlockLightSection(Y), SourceLight.GetBlockLightSection(Y));
+	}
+
+	// Single block:
+	Source.SetBlock({1, 2, 3}, BlockState(1000));
+	TEST_EQUAL(Source.GetBlock({1, 2, 3}), BlockState(1000));
+	TEST_EQUAL(Snapshot.GetBlock({1, 2, 3}), BlockState(1));
+	TEST_NOTEQUAL(Snapshot.GetSection(0), Source.GetSection(0));
+	TEST_EQUAL(Snapshot.GetSection(1), Source.GetSection(1));
+
+	// Whole section, both ways of writing it:
+	BlockState Blocks[ChunkBlockData::SectionBlockCount];
+	std::fill(std::begin(Blocks), std::end(Blocks), BlockState(2000));
+	Source.SetSection(Blocks, 1);
+	auto & Overwritten = Source.GetSectionForOverwrite(2);
+	TEST_EQUAL(Overwritten[0], BlockState(3));  // A shared section is cloned, not handed out uninitialized
+	Overwritten.fill(BlockState(3000));
+	TEST_EQUAL(Snapshot.GetBlock({0, cChunkDef::SectionHeight, 0}), BlockState(2));
+	TEST_EQUAL(Snapshot.GetBlock({0, 2 * cChunkDef::SectionHeight, 0}), BlockState(3));
+	TEST_EQUAL(Source.GetBlock({0, cChunkDef::SectionHeight, 0}), BlockState(2000));
+	TEST_EQUAL(Source.GetBlock({0, 2 * cChunkDef::SectionHeight, 0}), BlockState(3000));
+	TEST_EQUAL(Snapshot.GetSection(3), Source.GetSection(3));
+
+	// Light:
+	ChunkLightData::SectionType Light;
+	std::fill(std::begin(Light), std::end(Light), static_cast<LIGHTTYPE>(0xff));
+	SourceLight.SetSection(Light, Light, 4);
+	TEST_EQUAL(SourceLight.GetSkyLight({0, 4 * cChunkDef::SectionHeight, 0}), 0x0f);
+	TEST_EQUAL(SnapshotLight.GetSkyLight({0, 4 * cChunkDef::SectionHeight, 0}), 0x05);
+
+	// Writing into the snapshot doesn't change the source either:
+	Snapshot.SetBlock({0, 5 * cChunkDef::SectionHeight, 0}, BlockState(4000));
+	TEST_EQUAL(Source.GetBlock({0, 5 * cChunkDef::SectionHeight, 0}), BlockState(6));
+
+	// Once the snapshot is released, the source writes in place again:
+	Snapshot.Clear();
+	SnapshotLight.Clear();
+	TEST_EQUAL(Snapshot.GetSection(6), nullptr);
+	const auto Section = Source.GetSection(6);
+	Source.SetBlock({0, 6 * cChunkDef::SectionHeight, 0}, BlockState(5000));
+	TEST_EQUAL(Source.GetSection(6), Section);
+}
+
+
+
+
+
+/** Snapshots taken under a lock stay consistent while a writer keeps rewriting whole sections. */
+static void TestConcurrentReaders(void)
+{
+	ChunkBlockData Source;
+	ChunkLightData SourceLight;
+	FillChunk(Source, SourceLight);
+	std::mutex Mutex;
+	std::atomic<bool> ShouldStop{false};
+
+	std::thread Writer([&]()
+	{
+		for (UInt16 Value = 0; !ShouldStop; Value++)
+		{
+			std::lock_guard<std::mutex> Lock(Mutex);
+			auto & Section = Source.GetSectionForOverwrite(Value % cChunkDef::NumSections);
+			Section.fill(BlockState(Value));
+		}
+	});
+
+	std::vector<std::thread> Readers;
+	std::atomic<int> NumInconsistent{0};
+	for (int i = 0; i < 3; i++)
+	{
+		Readers.emplace_back([&]()
+		{
+			ChunkBlockData Snapshot;
+			for (int Iteration = 0; Iteration < 20000; Iteration++)
+			{
+				{
+					std::lock_guard<std::mutex> Lock(Mutex);
+					Snapshot.Assign(Source);
+				}
+				for (size_t Y = 0; Y < cChunkDef::NumSections; Y++)
+				{
+					const auto & Section = *Snapshot.GetSection(Y);
+					if (std::any_of(Section.begin(), Section.end(), [&Section](BlockState a_Block) { return (a_Block != Section[0]); }))
+					{
+						NumInconsistent += 1;
+					}
+				}
+				Snapshot.Clear();
+			}
+		});
+	}
+	for (auto & Reader : Readers)
+	{
+		Reader.join();
+	}
+	ShouldStop = true;
+	Writer.join();
+	TEST_EQUAL(NumInconsistent.load(), 0);
+}
+
+
+
+
+
+/** Compares the time a reader holds the lock for copying a full chunk, with a deep copy as done before and with a snapshot. */
+static void BenchmarkLockHoldTime(void)
+{
+	ChunkBlockData Source;
+	ChunkLightData SourceLight;
+	FillChunk(Source, SourceLight);
+	const int NumCopies = 2000;
+
+	auto Start = std::chrono::steady_clock::now();
+	for (int i = 0; i < NumCopies; i++)
+	{
+		// The deep copy of all sections that Assign() used to do:
+		std::unique_ptr<ChunkBlockData::BlockArray> Blocks[cChunkDef::NumSections];
+		std::unique_ptr<ChunkLightData::LightArray> BlockLights[cChunkDef::NumSections], SkyLights[cChunkDef::NumSections];
+		for (size_t Y = 0; Y < cChunkDef::NumSections; Y++)
+		{
+			Blocks[Y] = std::make_unique<ChunkBlockData::BlockArray>(*Source.GetSection(Y));
+			BlockLights[Y] = std::make_unique<ChunkLightData::LightArray>(*SourceLight.GetBlockLightSection(Y));
+			SkyLights[Y] = std::make_unique<ChunkLightData::LightArray>(*SourceLight.GetSkyLightSection(Y));
+		}
+	}
+	const auto DeepCopyTime = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - Start).count() / NumCopies;
+
+	ChunkBlockData Snapshot;
+	ChunkLightData SnapshotLight;
+	Start = std::chrono::steady_clock::now();
+	for (int i = 0; i < NumCopies; i++)
+	{
+		Snapshot.Assign(Source);
+		SnapshotLight.Assign(SourceLight);
+	}
+	const auto SnapshotTime = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - Start).count() / NumCopies;
+
+	LOG("Copying a full chunk under the lock: deep copy %.2f us, snapshot %.3f us", DeepCopyTime, SnapshotTime);
+}
+
+
+
+
+
+IMPLEMENT_TEST_MAIN("ChunkData Snapshots",
+	TestCopyOnWrite();
+	TestConcurrentReaders();
+	BenchmarkLockHoldTime();
+)
@@ -0,0 +1,476 @@
+
+// ChunkLayersTest.cpp
+
+// Checks that the cSectionLayers bitmaps agree with cBlockInfo, both computed for a whole section and updated block by block,
+// and measures raycasts and collision queries answered from the layers against the per-block cBlockInfo lookups.
+
+#include "Globals.h"
+#include "../TestHelpers.h"
+#include "ChunkLayers.h"
+#include "BlockInfo.h"
+#include "FastRandom.h"
+
+
+
+
+
+/** The terrain spans this many chunks on both X and Z, starting at zero. */
+static const int TERRAIN_CHUNKS = 4;
+
+/** The size of the terrain in blocks along X and Z. */
+static const int TERRAIN_SIZE = TERRAIN_CHUNKS * cChunkDef::Width;
+
+/** The number of sections with blocks in each chunk; the sections above are all air. */
+static const size_t NUM_SECTIONS = 6;
+
+/** The height of the terrain's surface. */
+static const int SURFACE_Y = 64;
+
+
+
+
+
+/** Chunk sections of a hilly landscape with caves, ponds, plants, glass and torches, along with their layers. */
+class cTestTerrain
+{
+public:
+
+	cTestTerrain(void)
+	{
+		cFastRandom Random;
+		for (int ChunkZ = 0; ChunkZ < TERRAIN_CHUNKS; ChunkZ++)
+		{
+			for (int ChunkX = 0; ChunkX < TERRAIN_CHUNKS; ChunkX++)
+			{
+				for (size_t SectionY = 0; SectionY < NUM_SECTIONS; SectionY++)
+				{
+					auto & Section = GetSection(ChunkX, ChunkZ, SectionY);
+					for (size_t Index = 0; Index < Section.size(); Index++)
+					{
+						const auto Rel = cChunkDef::IndexToCoordinate(Index);
+						const Vector3i Pos(ChunkX * cChunkDef::Width + Rel.x, static_cast<int>(SectionY) * cChunkDef::SectionHeight + Rel.y, ChunkZ * cChunkDef::Width + Rel.z);
+						Section[Index] = GenerateBlock(Pos, Random);
+					}
+				}
+			}
+		}
+		ComputeLayers();
+	}
+
+
+	/** Recomputes the layers of all sections from their blocks. */
+	void ComputeLayers(void)
+	{
+		for (size_t i = 0; i < m_Sections.size(); i++)
+		{
+			m_Layers[i].Compute(m_Sections[i]);
+		}
+	}
+
+
+	/** Returns true if the position lies within the terrain, including the all-air sections above the blocks. */
+	static bool IsInside(Vector3i a_Pos)
+	{
+		return (
+			(a_Pos.x >= 0) && (a_Pos.x < TERRAIN_SIZE) &&
+			(a_Pos.z >= 0) && (a_Pos.z < TERRAIN_SIZE) &&
+			cChunkDef::IsValidHeight(a_Pos)
+		);
+	}
+
+
+	/** Returns the block at the specified position, which must be inside the terrain, the way cChunk::GetBlock() does. */
+	BlockState GetBlock(Vector3i a_Pos) const
+	{
+		const auto SectionY = static_cast<size_t>(a_Pos.y / cChunkDef::SectionHeight);
+		if (SectionY >= NUM_SECTIONS)
+		{
+			return ChunkBlockData::DefaultValue;
+		}
+		return GetSection(a_Pos.x / cChunkDef::Width, a_Pos.z / cChunkDef::Width, SectionY)[IndexInSection(a_Pos)];
+	}
+
+
+	/** Returns the layers of the section containing the position, which must be inside the terrain, the way cChunk::GetSectionLayers() does. */
+	const cSectionLayers & GetLayers(Vector3i a_Pos) const
+	{
+		const auto SectionY = static_cast<size_t>(a_Pos.y / cChunkDef::SectionHeight);
+		if (SectionY >= NUM_SECTIONS)
+		{
+			return cSectionLayers::AllAir();
+		}
+		return m_Layers[SectionArrayIndex(a_Pos.x / cChunkDef::Width, a_Pos.z / cChunkDef::Width, SectionY)];
+	}
+
+
+	/** Sets the block, updating the layers the way cChunk::FastSetBlock() does. */
+	void SetBlock(Vector3i a_Pos, BlockState a_Block)
+	{
+		const auto SectionY = static_cast<size_t>(a_Pos.y / cChunkDef::SectionHeight);
+		const auto ArrayIndex = SectionArrayIndex(a_Pos.x / cChunkDef::Width, a_Pos.z / cChunkDef::Width, SectionY);
+		m_Sections[ArrayIndex][IndexInSection(a_Pos)] = a_Block;
+		m_Layers[ArrayIndex].SetBlock(IndexInSection(a_Pos), a_Block);
+	}
+
+
+	/** Returns the index of the position's block within its section. */
+	static size_t IndexInSection(Vector3i a_Pos)
+	{
+		return cChunkDef::MakeIndex(a_Pos.x % cChunkDef::Width, a_Pos.y % cChunkDef::SectionHeight, a_Pos.z % cChunkDef::Width);
+	}
+
+
+	std::array<ChunkBlockData::BlockArray, TERRAIN_CHUNKS * TERRAIN_CHUNKS * NUM_SECTIONS> m_Sections;
+	std::array<cSectionLayers, TERRAIN_CHUNKS * TERRAIN_CHUNKS * NUM_SECTIONS> m_Layers;
+
+private:
+
+	static size_t SectionArrayIndex(int a_ChunkX, int a_ChunkZ, size_t a_SectionY)
+	{
+		return (static_cast<size_t>(a_ChunkZ * TERRAIN_CHUNKS + a_ChunkX) * NUM_SECTIONS) + a_SectionY;
+	}
+
+
+	ChunkBlockData::BlockArray & GetSection(int a_ChunkX, int a_ChunkZ, size_t a_SectionY)
+	{
+		return m_Sections[SectionArrayIndex(a_ChunkX, a_ChunkZ, a_SectionY)];
+	}
+
+
+	const ChunkBlockData::BlockArray & GetSection(int a_ChunkX, int a_ChunkZ, size_t a_SectionY) const
+	{
+		return m_Sections[SectionArrayIndex(a_ChunkX, a_ChunkZ, a_SectionY)];
+	}
+
+
+	/** Returns the block of the landscape at the specified position. */
+	static BlockState GenerateBlock(Vector3i a_Pos, cFastRandom & a_Random)
+	{
+		const int Height = SURFACE_Y + static_cast<int>(6 * std::sin(a_Pos.x / 7.0) * std::cos(a_Pos.z / 9.0));
+		if (a_Pos.y > Height)
+		{
+			if ((a_Pos.y <= SURFACE_Y - 2) && (a_Pos.y > Height))
+			{
+				return Block::Water::Water(0);
+			}
+			if (a_Pos.y == Height + 1)
+			{
+				const auto Decoration = a_Random.RandInt(99);
+				if (Decoration < 20)
+				{
+					return Block::ShortGrass::ShortGrass();
+				}
+				if (Decoration < 22)
+				{
+					return Block::Torch::Torch();
+				}
+				if (Decoration < 24)
+				{
+					return Block::Glass::Glass();
+				}
+			}
+			return Block::Air::Air();
+		}
+		if ((a_Pos.y > 20) && (a_Pos.y < 40) && (std::sin(a_Pos.x / 5.0) + std::sin(a_Pos.z / 6.0) + std::sin(a_Pos.y / 4.0) > 1.5))
+		{
+			// A cave, lit here and there:
+			return a_Random.RandBool(0.01) ? Block::Glowstone::Glowstone() : Block::Air::Air();
+		}
+		if (a_Pos.y == Height)
+		{
+			return Block::GrassBlock::GrassBlock();
+		}
+		if (a_Pos.y > Height - 4)
+		{
+			return Block::Dirt::Dirt();
+		}
+		return (a_Pos.y < 8) && a_Random.RandBool(0.05) ? Block::Lava::Lava(0) : Block::Stone::Stone();
+	}
+};
+
+
+
+
+
+/** Checks every layer bit of every block against cBlockInfo. */
+static void CheckLayersMatchBlocks(const cTestTerrain & a_Terrain)
+{
+	for (size_t i = 0; i < a_Terrain.m_Sections.size(); i++)
+	{
+		const auto & Section = a_Terrain.m_Sections[i];
+		const auto & Layers = a_Terrain.m_Layers[i];
+		for (size_t Index = 0; Index < Section.size(); Index++)
+		{
+			const auto Block = Section[Index];
+			const auto Type = Block.Type();
+			TEST_EQUAL(Layers.Test(eBlockLayer::Solid, Index), cBlockInfo::IsSolid(Block));
+			TEST_EQUAL(Layers.Test(eBlockLayer::Transparent, Index), cBlockInfo::IsTransparent(Block));
+			TEST_EQUAL(Layers.Test(eBlockLayer::Fluid, Index), ((Type == BlockType::Water) || (Type == BlockType::Lava)));
+			TEST_EQUAL(Layers.Test(eBlockLayer::LightEmitting, Index), (cBlockInfo::GetLightValue(Block) > 0));
+			TEST_EQUAL(Layers.Test(eBlockLayer::SpawnBlocking, Index), (!IsBlockAir(Block) && (Type != BlockType::Water)));
+			TEST_EQUAL(Layers.Test(eBlockLayer::NonAir, Index), (Type != BlockType::Air));
+		}
+	}
+
+	// The sections without blocks:
+	for (size_t Index = 0; Index < ChunkBlockData::SectionBlockCount; Index++)
+	{
+		TEST_FALSE(cSectionLayers::AllAir().Test(eBlockLayer::Solid, Index));
+		TEST_TRUE(cSectionLayers::AllAir().Test(eBlockLayer::Transparent, Index));
+		TEST_FALSE(cSectionLayers::AllAir().Test(eBlockLayer::SpawnBlocking, Index));
+		TEST_FALSE(cSectionLayers::AllAir().Test(eBlockLayer::NonAir, Index));
+	}
+}
+
+
+
+
+
+/** Sets random blocks, then checks that the incrementally updated layers equal the recomputed ones. */
+static void TestIncrementalUpdates(cTestTerrain & a_Terrain)
+{
+	const std::array<BlockState, 6> Blocks =
+	{
+		Block::Air::Air(), Block::Stone::Stone(), Block::Water::Water(0),
+		Block::Torch::Torch(), Block::Glass::Glass(), Block::ShortGrass::ShortGrass()
+	};
+	cFastRandom Random;
+	for (int i = 0; i < 100000; i++)
+	{
+		const Vector3i Pos(
+			Random.RandInt(TERRAIN_SIZE - 1),
+			Random.RandInt(static_cast<int>(NUM_SECTIONS) * cChunkDef::SectionHeight - 1),
+			Random.RandInt(TERRAIN_SIZE - 1)
+		);
+		a_Terrain.SetBlock(Pos, Blocks[Random.RandInt(Blocks.size() - 1)]);
+	}
+	const auto Updated = a_Terrain.m_Layers;
+	a_Terrain.ComputeLayers();
+	for (size_t i = 0; i < Updated.size(); i++)
+	{
+		for (size_t Layer = 0; Layer < cSectionLayers::NumLayers; Layer++)
+		{
+			TEST_TRUE(Updated[i].GetLayer(static_cast<eBlockLayer>(Layer)) == a_Terrain.m_Layers[i].GetLayer(static_cast<eBlockLayer>(Layer)));
+		}
+	}
+	CheckLayersMatchBlocks(a_Terrain);
+
+	// Walking the set bits visits exactly the blocks in the layer:
+	const auto & Layers = a_Terrain.m_Layers[2];
+	size_t NumVisited = 0;
+	Layers.ForEachInLayer(eBlockLayer::LightEmitting, [&](size_t a_Index)
+	{
+		TEST_TRUE(Layers.Test(eBlockLayer::LightEmitting, a_Index));
+		NumVisited += 1;
+		return false;
+	});
+	size_t NumSet = 0;
+	for (size_t Index = 0; Index < ChunkBlockData::SectionBlockCount; Index++)
+	{
+		NumSet += Layers.Test(eBlockLayer::LightEmitting, Index) ? 1 : 0;
+	}
+	TEST_EQUAL(NumVisited, NumSet);
+}
+
+
+
+
+
+/** Steps along the line from a_Start to a_End block by block, the way cLineBlockTracer does,
+returns the first block for which a_IsSolid returns true, or the end block if there's none. */
+template <typename IsSolidType>
+static Vector3i TraceToFirstSolid(Vector3d a_Start, Vector3d a_End, IsSolidType a_IsSolid)
+{
+	const auto Diff = a_End - a_Start;
+	const Vector3i Dir((Diff.x > 0) ? 1 : -1, (Diff.y > 0) ? 1 : -1, (Diff.z > 0) ? 1 : -1);
+	auto Current = a_Start.Floor();
+	const auto Last = a_End.Floor();
+
+	// The line coefficient of the next wall crossing along each axis, and its increment per block:
+	const auto Coeff = [](double a_Start, double a_Diff, int a_Block, int a_Dir)
+	{
+		if (std::abs(a_Diff) < 1e-9)
+		{
+			return std::numeric_limits<double>::infinity();
+		}
+		return ((a_Dir > 0) ? (a_Block + 1 - a_Start) : (a_Block - a_Start)) / a_Diff;
+	};
+	Vector3d Next(Coeff(a_Start.x, Diff.x, Current.x, Dir.x), Coeff(a_Start.y, Diff.y, Current.y, Dir.y), Coeff(a_Start.z, Diff.z, Current.z, Dir.z));
+	const Vector3d Step(std::abs(1 / Diff.x), std::abs(1 / Diff.y), std::abs(1 / Diff.z));
+
+	while (Current != Last)
+	{
+		if ((Next.x <= Next.y) && (Next.x <= Next.z))
+		{
+			Current.x += Dir.x;
+			Next.x += Step.x;
+		}
+		else if (Next.y <= Next.z)
+		{
+			Current.y += Dir.y;
+			Next.y += Step.y;
+		}
+		else
+		{
+			Current.z += Dir.z;
+			Next.z += Step.z;
+		}
+		if (!cTestTerrain::IsInside(Current) || a_IsSolid(Current))
+		{
+			return Current;
+		}
+	}
+	return Current;
+}
+
+
+
+
+
+/** Returns true if any block intersecting the box is solid, reading the blocks one by one. */
+static bool IsBoxCollidingLookup(const cTestTerrain & a_Terrain, Vector3i a_Min, Vector3i a_Max)
+{
+	for (int y = a_Min.y; y <= a_Max.y; y++)
+	{
+		for (int z = a_Min.z; z <= a_Max.z; z++)
+		{
+			for (int x = a_Min.x; x <= a_Max.x; x++)
+			{
+				if (cBlockInfo::IsSolid(a_Terrain.GetBlock({x, y, z})))
+				{
+					return true;
+				}
+			}
+		}
+	}
+	return false;
+}
+
+
+
+
+
+/** Returns true if any block intersecting the box is solid, testing a whole row of the box along X within a chunk with a single word mask. */
+static bool IsBoxCollidingLayers(const cTestTerrain & a_Terrain, Vector3i a_Min, Vector3i a_Max)
+{
+	for (int y = a_Min.y; y <= a_Max.y; y++)
+	{
+		for (int z = a_Min.z; z <= a_Max.z; z++)
+		{
+			for (int x = a_Min.x; x <= a_Max.x;)
+			{
+				// The part of the row that lies within a single chunk:
+				const int RowEnd = std::min(a_Max.x, (x / cChunkDef::Width + 1) * cChunkDef::Width - 1);
+				const auto Index = cTestTerrain::IndexInSection({x, y, z});
+				const auto NumBits = static_cast<unsigned>(RowEnd - x + 1);
+				const auto Mask = ((static_cast<UInt64>(1) << NumBits) - 1) << (Index % 64);
+				if ((a_Terrain.GetLayers({x, y, z}).GetWord(eBlockLayer::Solid, Index / 64) & Mask) != 0)
+				{
+					return true;
+				}
+				x = RowEnd + 1;
+			}
+		}
+	}
+	return false;
+}
+
+
+
+
+
+/** Traces random rays through the terrain, comparing the hits and the time of the two ways of telling solid blocks. */
+static void BenchmarkRaycasts(const cTestTerrain & a_Terrain, size_t a_NumRays)
+{
+	cFastRandom Random;
+	std::vector<std::pair<Vector3d, Vector3d>> Rays;
+	for (size_t i = 0; i < a_NumRays; i++)
+	{
+		// From above the surface, in a random direction, up to 32 blocks far; the mobs' and projectiles' kind of traces:
+		const Vector3d Start(Random.RandReal(1.0, TERRAIN_SIZE - 1.0), Random.RandReal(SURFACE_Y + 2.0, SURFACE_Y + 20.0), Random.RandReal(1.0, TERRAIN_SIZE - 1.0));
+		const Vector3d Dir(Random.RandReal(-1.0, 1.0), Random.RandReal(-1.0, 0.3), Random.RandReal(-1.0, 1.0));
+		Rays.emplace_back(Start, Start + Dir.NormalizeCopy() * 32);
+	}
+
+	std::vector<Vector3i> LookupHits, LayerHits;
+	LookupHits.reserve(a_NumRays);
+	LayerHits.reserve(a_NumRays);
+
+	const auto LookupStart = std::chrono::steady_clock::now();
+	for (const auto & Ray : Rays)
+	{
+		LookupHits.push_back(TraceToFirstSolid(Ray.first, Ray.second, [&a_Terrain](Vector3i a_Pos)
+		{
+			return cBlockInfo::IsSolid(a_Terrain.GetBlock(a_Pos));
+		}));
+	}
+	const auto LayersStart = std::chrono::steady_clock::now();
+	for (const auto & Ray : Rays)
+	{
+		LayerHits.push_back(TraceToFirstSolid(Ray.first, Ray.second, [&a_Terrain](Vector3i a_Pos)
+		{
+			return a_Terrain.GetLayers(a_Pos).Test(eBlockLayer::Solid, cTestTerrain::IndexInSection(a_Pos));
+		}));
+	}
+	const auto End = std::chrono::steady_clock::now();
+
+	TEST_TRUE(LookupHits == LayerHits);
+	const auto LookupMs = std::chrono::duration<double, std::milli>(LayersStart - LookupStart).count();
+	const auto LayersMs = std::chrono::duration<double, std::milli>(End - LayersStart).count();
+	LOG("Raycasts: %zu rays of 32 blocks, block lookups %.2f ms, solid layer %.2f ms (%.1fx)",
+		a_NumRays, LookupMs, LayersMs, LookupMs / LayersMs
+	);
+}
+
+
+
+
+
+/** Queries random entity-sized boxes for collisions, comparing the results and the time of the two ways of telling solid blocks. */
+static void BenchmarkCollisions(const cTestTerrain & a_Terrain, size_t a_NumQueries)
+{
+	cFastRandom Random;
+	std::vector<std::pair<Vector3i, Vector3i>> Boxes;
+	for (size_t i = 0; i < a_NumQueries; i++)
+	{
+		// Boxes spanning 1 to 3 blocks each way, around the surface, where most entities are:
+		const Vector3i Min(Random.RandInt(TERRAIN_SIZE - 4), Random.RandInt(SURFACE_Y - 8, SURFACE_Y + 8), Random.RandInt(TERRAIN_SIZE - 4));
+		Boxes.emplace_back(Min, Min + Vector3i(Random.RandInt(2), Random.RandInt(2), Random.RandInt(2)));
+	}
+
+	std::vector<bool> LookupResults, LayerResults;
+	LookupResults.reserve(a_NumQueries);
+	LayerResults.reserve(a_NumQueries);
+
+	const auto LookupStart = std::chrono::steady_clock::now();
+	for (const auto & Box : Boxes)
+	{
+		LookupResults.push_back(IsBoxCollidingLookup(a_Terrain, Box.first, Box.second));
+	}
+	const auto LayersStart = std::chrono::steady_clock::now();
+	for (const auto & Box : Boxes)
+	{
+		LayerResults.push_back(IsBoxCollidingLayers(a_Terrain, Box.first, Box.second));
+	}
+	const auto End = std::chrono::steady_clock::now();
+
+	TEST_TRUE(LookupResults == LayerResults);
+	const auto LookupMs = std::chrono::duration<double, std::milli>(LayersStart - LookupStart).count();
+	const auto LayersMs = std::chrono::duration<double, std::milli>(End - LayersStart).count();
+	LOG("Collisions: %zu box queries, block lookups %.2f ms, solid layer %.2f ms (%.1fx); %zu boxes collide",
+		a_NumQueries, LookupMs, LayersMs, LookupMs / LayersMs,
+		static_cast<size_t>(std::count(LayerResults.begin(), LayerResults.end(), true))
+	);
+}
+
+
+
+
+
+IMPLEMENT_TEST_MAIN("ChunkLayers",
+	auto Terrain = std::make_unique<cTestTerrain>();
+	CheckLayersMatchBlocks(*Terrain);
+	BenchmarkRaycasts(*Terrain, 200000);
+	BenchmarkCollisions(*Terrain, 1000000);
+	TestIncrementalUpdates(*Terrain);
+)
@@ -0,0 +1,207 @@
+
+// ChunkTableTest.cpp
+
+// Checks the cChunkTable hash table against a std::map with random additions and removals,
+// and compares the speed of lookups in both.
+
+#include "Globals.h"
+#include "../TestHelpers.h"
+#include "ChunkTable.h"
+#include "FastRandom.h"
+
+
+
+
+
+/** A stand-in for the chunk, remembers its coords and counts the live instances. */
+class cTestChunk
+{
+public:
+
+	cTestChunk(int a_ChunkX, int a_ChunkZ):
+		m_ChunkX(a_ChunkX),
+		m_ChunkZ(a_ChunkZ)
+	{
+		s_NumAlive += 1;
+	}
+
+	~cTestChunk()
+	{
+		s_NumAlive -= 1;
+	}
+
+	int m_ChunkX;
+	int m_ChunkZ;
+
+	static int s_NumAlive;
+};
+
+int cTestChunk::s_NumAlive = 0;
+
+
+
+
+
+/** Checks that the table holds exactly the coords in the reference map, with the same objects. */
+static void CheckSame(const cChunkTable<cTestChunk> & a_Table, const std::map<cChunkCoords, cTestChunk *> & a_Reference)
+{
+	TEST_EQUAL(a_Table.GetCount(), a_Reference.size());
+	TEST_EQUAL(static_cast<size_t>(cTestChunk::s_NumAlive), a_Reference.size());
+	for (const auto & Ref : a_Reference)
+	{
+		TEST_EQUAL(a_Table.Find(Ref.first), Ref.second);
+	}
+
+	size_t NumVisited = 0;
+	for (const auto & Entry : a_Table)
+	{
+		TEST_EQUAL(Entry.second->m_ChunkX, Entry.first.m_ChunkX);
+		TEST_EQUAL(Entry.second->m_ChunkZ, Entry.first.m_ChunkZ);
+		TEST_EQUAL(a_Reference.count(Entry.first), 1);
+		NumVisited += 1;
+	}
+	TEST_EQUAL(NumVisited, a_Reference.size());
+}
+
+
+
+
+
+/** Adds and removes chunks in a small area at random, so that the probe runs get long and wrap around the table. */
+static void TestRandomOperations(void)
+{
+	cFastRandom Random;
+	cChunkTable<cTestChunk> Table;
+	std::map<cChunkCoords, cTestChunk *> Reference;
+	for (int i = 0; i < 200000; i++)
+	{
+		const cChunkCoords Coords(Random.RandInt(-20, 20), Random.RandInt(-20, 20));
+		if (Random.RandBool())
+		{
+			auto & Chunk = Table.FindOrEmplace(Coords, Coords.m_ChunkX, Coords.m_ChunkZ);
+			const auto Ref = Reference.find(Coords);
+			if (Ref == Reference.end())
+			{
+				Reference[Coords] = &Chunk;
+			}
+			else
+			{
+				TEST_EQUAL(&Chunk, Ref->second);
+			}
+		}
+		else if (Table.GetCount() > 0)
+		{
+			const auto Index = static_cast<size_t>(Random.RandInt(static_cast<int>(Table.GetCount()) - 1));
+			const auto Removed = Table.GetEntry(Index).first;
+			Table.RemoveAt(Index);
+			TEST_EQUAL(Reference.erase(Removed), 1);
+			TEST_EQUAL(Table.Find(Removed), nullptr);
+		}
+
+		if ((i % 1000) == 0)
+		{
+			CheckSame(Table, Reference);
+		}
+	}
+	CheckSame(Table, Reference);
+
+	// Removing while iterating by index, as the chunkmap unloads chunks:
+	for (size_t i = 0; i < Table.GetCount();)
+	{
+		const auto Coords = Table.GetEntry(i).first;
+		if (((Coords.m_ChunkX + Coords.m_ChunkZ) % 2) == 0)
+		{
+			Table.RemoveAt(i);
+			Reference.erase(Coords);
+		}
+		else
+		{
+			++i;
+		}
+	}
+	CheckSame(Table, Reference);
+}
+
+
+
+
+
+/** Objects added while iterating are visited as well, even when the table grows. */
+static void TestAddWhileIterating(void)
+{
+	cChunkTable<cTestChunk> Table;
+	Table.FindOrEmplace({0, 0}, 0, 0);
+	int NumVisited = 0;
+	for (const auto & Entry : Table)
+	{
+		NumVisited += 1;
+		if (Entry.first.m_ChunkX < 999)
+		{
+			const auto NextX = Entry.first.m_ChunkX + 1;
+			Table.FindOrEmplace({NextX, 0}, NextX, 0);
+		}
+	}
+	TEST_EQUAL(NumVisited, 1000);
+	TEST_EQUAL(Table.GetCount(), 1000);
+}
+
+
+
+
+
+/** Measures the lookups of the chunks around a number of players, in the table and in a std::map. */
+static void Benchmark(void)
+{
+	// A server with a few players far apart, each with a 21 x 21 chunk view:
+	cChunkTable<cTestChunk> Table;
+	std::map<cChunkCoords, cTestChunk *> Map;
+	for (int Player = 0; Player < 10; Player++)
+	{
+		for (int x = -10; x <= 10; x++)
+		{
+			for (int z = -10; z <= 10; z++)
+			{
+				const cChunkCoords Coords(Player * 100 + x, Player * 37 + z);
+				Map[Coords] = &Table.FindOrEmplace(Coords, Coords.m_ChunkX, Coords.m_ChunkZ);
+			}
+		}
+	}
+
+	cFastRandom Random;
+	std::vector<cChunkCoords> Queries;
+	for (int i = 0; i < 1000000; i++)
+	{
+		const auto Player = Random.RandInt(9);
+		Queries.emplace_back(Player * 100 + Random.RandInt(-12, 12), Player * 37 + Random.RandInt(-12, 12));
+	}
+
+	size_t NumFoundTable = 0, NumFoundMap = 0;
+	auto Start = std::chrono::steady_clock::now();
+	for (const auto & Coords : Queries)
+	{
+		NumFoundTable += (Table.Find(Coords) != nullptr) ? 1 : 0;
+	}
+	const auto TableTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Start).count();
+
+	Start = std::chrono::steady_clock::now();
+	for (const auto & Coords : Queries)
+	{
+		NumFoundMap += (Map.find(Coords) != Map.end()) ? 1 : 0;
+	}
+	const auto MapTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Start).count();
+
+	TEST_EQUAL(NumFoundTable, NumFoundMap);
+	LOG("%zu lookups in %zu chunks: cChunkTable %.1f ms, std::map %.1f ms (%zu found)",
+		Queries.size(), Table.GetCount(), TableTime, MapTime, NumFoundTable
+	);
+}
+
+
+
+
+
+IMPLEMENT_TEST_MAIN("ChunkTable",
+	TestRandomOperations();
+	TestAddWhileIterating();
+	Benchmark();
+)
@@ -0,0 +1,188 @@
+
+// CraftingRecipesBenchmark.cpp
+
+// Checks that the indexed recipe lookup finds the same recipes as the linear scan, and measures both over the whole crafting.txt
+
+#include "Globals.h"
+#include "../TestHelpers.h"
+#include "CraftingRecipes.h"
+
+
+
+
+
+/** Number of times each grid is looked up when measuring. */
+static const int NUM_ROUNDS = 20;
+
+/** A 3x3 crafting grid, as stored in the crafting table. */
+typedef std::array<cItem, cCraftingRecipes::MAX_GRID_WIDTH * cCraftingRecipes::MAX_GRID_HEIGHT> cGrid;
+
+
+
+
+
+/** Fills a_Grid with the ingredients of the recipe, placing the "anywhere" items into the first free cell they allow.
+Meta-agnostic ingredients are placed with damage 0. Returns false if the ingredients don't fit into the grid. */
+static bool FillGrid(const cCraftingRecipes::cRecipe & a_Recipe, cGrid & a_Grid)
+{
+	for (auto & Cell : a_Grid)
+	{
+		Cell.Empty();
+	}
+
+	// Regular items first, then the "anywhere" ones into the remaining cells:
+	for (const auto & Slot : a_Recipe.m_Ingredients)
+	{
+		if ((Slot.x < 0) || (Slot.y < 0))
+		{
+			continue;
+		}
+		auto & Cell = a_Grid[static_cast<size_t>(Slot.x + Slot.y * cCraftingRecipes::MAX_GRID_WIDTH)];
+		Cell = Slot.m_Item;
+		Cell.m_ItemCount = 1;
+		Cell.m_ItemDamage = std::max<short>(Slot.m_Item.m_ItemDamage, 0);
+	}
+	for (const auto & Slot : a_Recipe.m_Ingredients)
+	{
+		if ((Slot.x >= 0) && (Slot.y >= 0))
+		{
+			continue;
+		}
+		bool Placed = false;
+		for (int y = 0; (y < cCraftingRecipes::MAX_GRID_HEIGHT) && !Placed; y++)
+		{
+			for (int x = 0; (x < cCraftingRecipes::MAX_GRID_WIDTH) && !Placed; x++)
+			{
+				if (((Slot.x >= 0) && (Slot.x != x)) || ((Slot.y >= 0) && (Slot.y != y)))
+				{
+					continue;
+				}
+				auto & Cell = a_Grid[static_cast<size_t>(x + y * cCraftingRecipes::MAX_GRID_WIDTH)];
+				if (!Cell.IsEmpty())
+				{
+					continue;
+				}
+				Cell = Slot.m_Item;
+				Cell.m_ItemCount = 1;
+				Cell.m_ItemDamage = std::max<short>(Slot.m_Item.m_ItemDamage, 0);
+				Placed = true;
+			}
+		}
+		if (!Placed)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+
+
+
+/** Returns the grids for all the recipes that can be laid out in the 3x3 grid. */
+static std::vector<cGrid> MakeGrids(cCraftingRecipes & a_Recipes)
+{
+	std::vector<cGrid> Grids;
+	for (UInt32 i = 0; i < a_Recipes.GetNumRecipes(); i++)
+	{
+		cGrid Grid;
+		if (FillGrid(*a_Recipes.GetRecipeById(i), Grid))
+		{
+			Grids.push_back(Grid);
+		}
+	}
+	return Grids;
+}
+
+
+
+
+
+/** Checks that the indexed lookup returns the same recipe as the linear scan for every grid. */
+static void TestSameResults(cCraftingRecipes & a_Recipes, const std::vector<cGrid> & a_Grids)
+{
+	int NumFound = 0;
+	for (const auto & Grid : a_Grids)
+	{
+		std::unique_ptr<cCraftingRecipes::cRecipe> Indexed(a_Recipes.FindRecipe(Grid.data(), cCraftingRecipes::MAX_GRID_WIDTH, cCraftingRecipes::MAX_GRID_HEIGHT));
+		std::unique_ptr<cCraftingRecipes::cRecipe> Linear(a_Recipes.FindRecipeLinear(Grid.data(), cCraftingRecipes::MAX_GRID_WIDTH, cCraftingRecipes::MAX_GRID_HEIGHT));
+		bool HasIndexed = (Indexed != nullptr);
+		bool HasLinear = (Linear != nullptr);
+		TEST_EQUAL(HasIndexed, HasLinear);
+		if (Linear == nullptr)
+		{
+			continue;
+		}
+		NumFound += 1;
+		TEST_TRUE(Indexed->m_Result.IsEqual(Linear->m_Result));
+		TEST_EQUAL(Indexed->m_Result.m_ItemCount, Linear->m_Result.m_ItemCount);
+		TEST_EQUAL(Indexed->m_Ingredients.size(), Linear->m_Ingredients.size());
+	}
+	LOG("%d out of %zu recipe grids have a matching recipe.", NumFound, a_Grids.size());
+}
+
+
+
+
+
+/** Measures the lookup of every grid, NUM_ROUNDS times over, using the specified lookup function. */
+template <typename LookupFn>
+static void Measure(const char * a_Name, const std::vector<cGrid> & a_Grids, LookupFn a_Lookup)
+{
+	auto Start = std::chrono::steady_clock::now();
+	size_t NumFound = 0;
+	for (int Round = 0; Round < NUM_ROUNDS; Round++)
+	{
+		for (const auto & Grid : a_Grids)
+		{
+			std::unique_ptr<cCraftingRecipes::cRecipe> Recipe(a_Lookup(Grid));
+			NumFound += (Recipe != nullptr) ? 1 : 0;
+		}
+	}
+	auto Elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - Start).count();
+	auto NumLookups = a_Grids.size() * NUM_ROUNDS;
+	LOG("%s: %zu lookups (%zu found) in %lld usec, %.2f usec per lookup",
+		a_Name, NumLookups, NumFound, static_cast<long long>(Elapsed),
+		static_cast<double>(Elapsed) / std::max<size_t>(NumLookups, 1)
+	);
+}
+
+
+
+
+
+static void Benchmark(cCraftingRecipes & a_Recipes, const std::vector<cGrid> & a_Grids)
+{
+	Measure("Linear scan", a_Grids, [&a_Recipes](const cGrid & a_Grid)
+		{
+			return a_Recipes.FindRecipeLinear(a_Grid.data(), cCraftingRecipes::MAX_GRID_WIDTH, cCraftingRecipes::MAX_GRID_HEIGHT);
+		}
+	);
+	Measure("Indexed", a_Grids, [&a_Recipes](const cGrid & a_Grid)
+		{
+			return a_Recipes.FindRecipe(a_Grid.data(), cCraftingRecipes::MAX_GRID_WIDTH, cCraftingRecipes::MAX_GRID_HEIGHT);
+		}
+	);
+}
+
+
+
+
+
+static void Test(void)
+{
+	cCraftingRecipes Recipes;
+	TEST_GREATER_THAN_OR_EQUAL(Recipes.GetNumRecipes(), 1);
+	auto Grids = MakeGrids(Recipes);
+	TestSameResults(Recipes, Grids);
+	Benchmark(Recipes, Grids);
+}
+
+
+
+
+
+IMPLEMENT_TEST_MAIN("CraftingRecipes",
+	Test();
+)
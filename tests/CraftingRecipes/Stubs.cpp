@@ -0,0 +1,107 @@
+
+// Stubs.cpp
+
+// Implements stubs of various Cuberite methods that are needed for linking but not for runtime
+// This is required so that we don't bring in the entire Cuberite via dependencies
+
+#include "Globals.h"
+#include "Item.h"
+#include "Root.h"
+#include "Bindings/PluginManager.h"
+
+
+
+
+
+cRoot * cRoot::s_Root = nullptr;
+
+
+
+
+
+bool cPluginManager::CallHookCraftingNoRecipe(cPlayer & a_Player, cCraftingGrid & a_Grid, cCraftingRecipe & a_Recipe)
+{
+	return false;
+}
+
+
+
+
+
+bool cPluginManager::CallHookPostCrafting(cPlayer & a_Player, cCraftingGrid & a_Grid, cCraftingRecipe & a_Recipe)
+{
+	return false;
+}
+
+
+
+
+
+bool cPluginManager::CallHookPreCrafting(cPlayer & a_Player, cCraftingGrid & a_Grid, cCraftingRecipe & a_Recipe)
+{
+	return false;
+}
+
+
+
+
+
+cItem::cItem():
+	m_ItemType(Item::Air),
+	m_ItemCount(0),
+	m_ItemDamage(0)
+{
+}
+
+
+
+
+
+cItem::cItem(
+	enum Item a_ItemType,
+	char a_ItemCount,
+	short a_ItemDamage,
+	const AString & a_Enchantments,
+	const AString & a_CustomName,
+	const AStringVector & a_LoreTable
+):
+	m_ItemType(a_ItemType),
+	m_ItemCount(a_ItemCount),
+	m_ItemDamage(a_ItemDamage)
+{
+	if (!a_Enchantments.empty())
+	{
+		ModifyEnchantments().AddFromString(a_Enchantments);
+	}
+	if (!a_CustomName.empty())
+	{
+		SetCustomName(a_CustomName);
+	}
+	if (!a_LoreTable.empty())
+	{
+		ModifyLoreTable() = a_LoreTable;
+	}
+}
+
+
+
+
+
+void cItem::Empty()
+{
+	m_ItemType = Item::Air;
+	m_ItemCount = 0;
+	m_ItemDamage = 0;
+	m_Components.reset();
+}
+
+
+
+
+
+cItem cItem::CopyOne(void) const
+{
+	cItem res(*this);
+	res.m_ItemCount = 1;
+	return res;
+}
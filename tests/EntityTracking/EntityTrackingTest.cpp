@@ -0,0 +1,125 @@
+// EntityTrackingTest.cpp
+
+// Tests the EntityTracking namespace: the distance tiers at a quarter, a half and the whole of the tracking range,
+// and which of an entity's movement updates the clients in each tier get
+
+#include "Globals.h"
+#include "../TestHelpers.h"
+#include "Entities/EntityTracking.h"
+
+
+
+
+
+using namespace EntityTracking;
+
+static const double TRACKING_RANGE = 64;
+
+
+
+
+
+/** Checks the tier boundaries, the end of each tier belongs to the next one. */
+static void TestTiers(void)
+{
+	auto Tier = [](double a_Distance)
+	{
+		return GetTier(a_Distance * a_Distance, TRACKING_RANGE);
+	};
+	TEST_EQUAL(Tier(0), 0);
+	TEST_EQUAL(Tier(15.9), 0);
+	TEST_EQUAL(Tier(16), 1);
+	TEST_EQUAL(Tier(31.9), 1);
+	TEST_EQUAL(Tier(32), 2);
+	TEST_EQUAL(Tier(63.9), 2);
+	TEST_EQUAL(Tier(64), NUM_TIERS);
+	TEST_EQUAL(Tier(1000), NUM_TIERS);
+
+	// The tiers scale with the range:
+	TEST_EQUAL(GetTier(20 * 20, 128), 0);
+	TEST_EQUAL(GetTier(20 * 20, 32), 2);
+}
+
+
+
+
+
+/** Counts the relative and absolute updates that a client at a constant distance gets out of a_NumUpdates consecutive ones. */
+static std::pair<int, int> CountUpdates(double a_Distance, int a_NumUpdates)
+{
+	int NumRelative = 0, NumAbsolute = 0;
+	for (Int64 Index = 1000; Index < 1000 + a_NumUpdates; Index++)
+	{
+		switch (GetClientUpdate(a_Distance * a_Distance, a_Distance * a_Distance, TRACKING_RANGE, Index))
+		{
+			case eClientUpdate::None: break;
+			case eClientUpdate::Relative: NumRelative += 1; break;
+			case eClientUpdate::Absolute: NumAbsolute += 1; break;
+		}
+	}
+	return { NumRelative, NumAbsolute };
+}
+
+
+
+
+
+/** Checks that the quarter range gets every update, the half range every other one and the whole range every fourth one. */
+static void TestRates(void)
+{
+	static const int NUM_UPDATES = 256;
+
+	// Within a quarter: every update, relative moves with a periodic absolute resync:
+	TEST_EQUAL(CountUpdates(10, NUM_UPDATES).first, NUM_UPDATES - NUM_UPDATES / RESYNC_INTERVAL);
+	TEST_EQUAL(CountUpdates(10, NUM_UPDATES).second, NUM_UPDATES / RESYNC_INTERVAL);
+
+	// Within a half: every other update, absolute:
+	TEST_EQUAL(CountUpdates(20, NUM_UPDATES).first, 0);
+	TEST_EQUAL(CountUpdates(20, NUM_UPDATES).second, NUM_UPDATES / 2);
+
+	// Within the whole range: every fourth update, absolute:
+	TEST_EQUAL(CountUpdates(40, NUM_UPDATES).first, 0);
+	TEST_EQUAL(CountUpdates(40, NUM_UPDATES).second, NUM_UPDATES / 4);
+
+	// Beyond the range: none:
+	TEST_EQUAL(CountUpdates(80, NUM_UPDATES).first, 0);
+	TEST_EQUAL(CountUpdates(80, NUM_UPDATES).second, 0);
+
+	// The farther tiers get a subset of the nearer tiers' updates, so an entity's updates reach all the tiers in the same tick:
+	for (Int64 Index = 0; Index < NUM_UPDATES; Index++)
+	{
+		if (GetClientUpdate(40 * 40, 40 * 40, TRACKING_RANGE, Index) != eClientUpdate::None)
+		{
+			TEST_NOTEQUAL(GetClientUpdate(20 * 20, 20 * 20, TRACKING_RANGE, Index), eClientUpdate::None);
+		}
+	}
+}
+
+
+
+
+
+/** Checks that a client coming closer from a farther tier gets the absolute position first, since it has missed updates. */
+static void TestTierChange(void)
+{
+	for (Int64 Index = 1; Index < RESYNC_INTERVAL; Index++)
+	{
+		TEST_EQUAL(GetClientUpdate(10 * 10, 10 * 10, TRACKING_RANGE, Index), eClientUpdate::Relative);
+		TEST_EQUAL(GetClientUpdate(10 * 10, 20 * 20, TRACKING_RANGE, Index), eClientUpdate::Absolute);
+		TEST_EQUAL(GetClientUpdate(10 * 10, 80 * 80, TRACKING_RANGE, Index), eClientUpdate::Absolute);
+	}
+
+	// Moving away only lowers the rate:
+	TEST_EQUAL(GetClientUpdate(20 * 20, 10 * 10, TRACKING_RANGE, 1), eClientUpdate::None);
+	TEST_EQUAL(GetClientUpdate(20 * 20, 10 * 10, TRACKING_RANGE, 2), eClientUpdate::Absolute);
+}
+
+
+
+
+
+IMPLEMENT_TEST_MAIN("EntityTracking",
+	TestTiers();
+	TestRates();
+	TestTierChange();
+)
@@ -0,0 +1,245 @@
+
+// FastNBTTest.cpp
+
+// Tests the cFastNBTWriter's buffer reuse and the compression into a reused buffer, used by the chunk saving.
+// Compares the allocations and copies per saved chunk against writing into a fresh writer each time.
+
+#include "Globals.h"
+#include "../TestHelpers.h"
+#include "WorldStorage/FastNBT.h"
+#include "StringCompression.h"
+
+
+
+
+
+/** Writes an NBT similar to a saved chunk: sections with block state and light arrays, block entities and entities.
+a_Variant changes the contents and sizes a bit, so that the consecutive chunks aren't all the same. */
+static void WriteChunkLikeNBT(cFastNBTWriter & a_Writer, int a_Variant)
+{
+	std::vector<Int64> BlockStates(256);
+	for (size_t i = 0; i < BlockStates.size(); i++)
+	{
+		BlockStates[i] = static_cast<Int64>(i * 0x9e3779b97f4a7c15ULL) ^ a_Variant;
+	}
+
+	a_Writer.AddInt("DataVersion", 3953);
+	a_Writer.AddInt("xPos", a_Variant);
+	a_Writer.AddInt("zPos", -a_Variant);
+	a_Writer.AddString("Status", "minecraft:full");
+	a_Writer.BeginList("sections", TAG_Compound);
+	for (int Y = -4; Y < 20; Y++)
+	{
+		a_Writer.BeginCompound("");
+		a_Writer.AddByte("Y", static_cast<unsigned char>(Y));
+		a_Writer.BeginCompound("block_states");
+		a_Writer.BeginList("palette", TAG_Compound);
+		for (int i = 0; i < 4 + (a_Variant + Y) % 8; i++)
+		{
+			a_Writer.BeginCompound("");
+			a_Writer.AddString("Name", (i % 2 == 0) ? "minecraft:stone" : "minecraft:deepslate_diamond_ore");
+			a_Writer.EndCompound();
+		}
+		a_Writer.EndList();
+		a_Writer.AddLongArray("data", BlockStates.data(), BlockStates.size());
+		a_Writer.EndCompound();
+		a_Writer.AddByteArray("BlockLight", 2048, static_cast<unsigned char>(Y));
+		a_Writer.AddByteArray("SkyLight", 2048, 0xff);
+		a_Writer.EndCompound();
+	}
+	a_Writer.EndList();
+
+	a_Writer.BeginList("block_entities", TAG_Compound);
+	for (int i = 0; i < a_Variant % 20; i++)
+	{
+		a_Writer.BeginCompound("");
+		a_Writer.AddString("id", "minecraft:chest");
+		a_Writer.AddInt("x", i);
+		a_Writer.AddInt("y", 64);
+		a_Writer.AddInt("z", -i);
+		a_Writer.BeginList("Items", TAG_Compound);
+		for (int Slot = 0; Slot < 27; Slot++)
+		{
+			a_Writer.BeginCompound("");
+			a_Writer.AddByte("Slot", static_cast<unsigned char>(Slot));
+			a_Writer.AddString("id", "minecraft:cobblestone");
+			a_Writer.AddByte("Count", 64);
+			a_Writer.EndCompound();
+		}
+		a_Writer.EndList();
+		a_Writer.EndCompound();
+	}
+	a_Writer.EndList();
+
+	a_Writer.BeginList("Entities", TAG_Compound);
+	for (int i = 0; i < a_Variant % 7; i++)
+	{
+		a_Writer.BeginCompound("");
+		a_Writer.AddString("id", "minecraft:sheep");
+		a_Writer.BeginList("Pos", TAG_Double);
+		a_Writer.AddDouble("", i + 0.5);
+		a_Writer.AddDouble("", 64);
+		a_Writer.AddDouble("", -i - 0.5);
+		a_Writer.EndList();
+		a_Writer.AddFloat("Health", 8);
+		a_Writer.AddShort("Fire", -1);
+		a_Writer.AddLong("UUIDMost", 0x123456789abcdefLL * i);
+		a_Writer.EndCompound();
+	}
+	a_Writer.EndList();
+	a_Writer.Finish();
+}
+
+
+
+
+
+/** Checks that the writer gives the same data when writing into a reused buffer, and that the data parses back. */
+static void TestBufferReuse(void)
+{
+	ContiguousByteBuffer Buffer;
+	size_t Estimate = 0;
+	for (int Variant = 0; Variant < 50; Variant++)
+	{
+		cFastNBTWriter Fresh;
+		WriteChunkLikeNBT(Fresh, Variant);
+
+		cFastNBTWriter Reused(std::move(Buffer), Estimate);
+		WriteChunkLikeNBT(Reused, Variant);
+		TEST_TRUE(Reused.GetResult() == Fresh.GetResult());
+
+		// Once the buffer has grown large enough, reusing it must not allocate anymore:
+		if (Variant > 20)
+		{
+			TEST_EQUAL(Reused.GetNumAllocations(), 0);
+			TEST_EQUAL(Reused.GetNumBytesCopied(), 0);
+		}
+		Buffer = Reused.TakeResult();
+		Estimate = Buffer.size();
+
+		cParsedNBT Parsed(Buffer);
+		TEST_TRUE(Parsed.IsValid());
+		const auto xPos = Parsed.FindChildByName(Parsed.GetRoot(), "xPos");
+		TEST_NOTEQUAL(xPos, -1);
+		TEST_EQUAL(Parsed.GetInt(xPos), Variant);
+		const auto Sections = Parsed.FindChildByName(Parsed.GetRoot(), "sections");
+		TEST_NOTEQUAL(Sections, -1);
+		const auto Data = Parsed.FindTagByPath(Parsed.GetFirstChild(Sections), "block_states\\data");
+		TEST_NOTEQUAL(Data, -1);
+		TEST_EQUAL(Parsed.GetDataLength(Data), 256 * 8);
+		TEST_EQUAL(NetworkBufToHost<Int64>(Parsed.GetData(Data) + 8), (static_cast<Int64>(0x9e3779b97f4a7c15ULL) ^ Variant));
+	}
+
+	// A presized writer must not reallocate for data that fits the estimate:
+	cFastNBTWriter Presized(ContiguousByteBuffer(), 1024 KiB);
+	WriteChunkLikeNBT(Presized, 13);
+	TEST_EQUAL(Presized.GetNumAllocations(), 1);
+	TEST_EQUAL(Presized.GetNumBytesCopied(), 0);
+}
+
+
+
+
+
+/** Checks that compressing into a reused buffer gives the same data as the one-shot compression. */
+static void TestCompressIntoBuffer(void)
+{
+	Compression::Compressor Compressor;
+	Compression::Extractor Extractor;
+	ContiguousByteBuffer Output;
+	for (int Variant = 0; Variant < 10; Variant++)
+	{
+		cFastNBTWriter Writer;
+		WriteChunkLikeNBT(Writer, Variant);
+		const auto Expected = Compressor.CompressZLib(Writer.GetResult());
+		const auto Compressed = Compressor.CompressZLib(Writer.GetResult(), Output);
+		TEST_TRUE(Compressed == Expected.GetView());
+		TEST_TRUE(Extractor.ExtractZLib(Compressed, Writer.GetResult().size()).GetView() == Writer.GetResult());
+	}
+
+	// Empty input must work as well:
+	const auto Compressed = Compressor.CompressZLib(ContiguousByteBufferView(), Output);
+	TEST_EQUAL(Extractor.ExtractZLib(Compressed).Size, 0);
+}
+
+
+
+
+
+/** Saves a series of chunk-like NBTs the old way (a fresh writer, compressed into a new Result)
+and the pooled way (reused buffers), reports the allocations, bytes copied and time per chunk. */
+static void Benchmark(void)
+{
+	static const int NUM_CHUNKS = 500;
+	Compression::Compressor Compressor;
+
+	// Fresh writer and result for each chunk:
+	{
+		size_t NumAllocations = 0, NumBytesCopied = 0, NumBytes = 0;
+		const auto Start = std::chrono::steady_clock::now();
+		for (int i = 0; i < NUM_CHUNKS; i++)
+		{
+			cFastNBTWriter Writer;
+			WriteChunkLikeNBT(Writer, i);
+			const auto Result = Compressor.CompressZLib(Writer.GetResult());
+			NumAllocations += Writer.GetNumAllocations();
+			NumBytesCopied += Writer.GetNumBytesCopied();
+			NumBytes += Result.Size;
+			if (std::holds_alternative<Compression::Result::Static>(Result.Storage))
+			{
+				// The static buffer is copied whole into the returned Result:
+				NumBytesCopied += Compression::Result::StaticCapacity;
+			}
+			else
+			{
+				// Compressed into a heap buffer, after failing to fit into the static one:
+				NumAllocations += 1;
+			}
+		}
+		const auto Time = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+		LOG("Fresh buffers:  %.2f allocations, %.0f bytes copied, %.1f us per chunk (%.0f bytes compressed)",
+			static_cast<double>(NumAllocations) / NUM_CHUNKS, static_cast<double>(NumBytesCopied) / NUM_CHUNKS,
+			Time * 1e6 / NUM_CHUNKS, static_cast<double>(NumBytes) / NUM_CHUNKS
+		);
+	}
+
+	// Reused buffers, presized by the previous chunk:
+	{
+		ContiguousByteBuffer NBTBuffer, CompressedBuffer;
+		size_t NumAllocations = 0, NumBytesCopied = 0, NumBytes = 0, Estimate = 100 KiB;
+		const auto Start = std::chrono::steady_clock::now();
+		for (int i = 0; i < NUM_CHUNKS; i++)
+		{
+			cFastNBTWriter Writer(std::move(NBTBuffer), Estimate);
+			WriteChunkLikeNBT(Writer, i);
+			NBTBuffer = Writer.TakeResult();
+			const auto OldCapacity = CompressedBuffer.capacity();
+			const auto OldSize = CompressedBuffer.size();
+			const auto Compressed = Compressor.CompressZLib(NBTBuffer, CompressedBuffer);
+			NumAllocations += Writer.GetNumAllocations();
+			NumBytesCopied += Writer.GetNumBytesCopied();
+			if (CompressedBuffer.capacity() != OldCapacity)
+			{
+				NumAllocations += 1;
+				NumBytesCopied += OldSize;
+			}
+			NumBytes += Compressed.size();
+			Estimate = NBTBuffer.size() + NBTBuffer.size() / 4;
+		}
+		const auto Time = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+		LOG("Reused buffers: %.2f allocations, %.0f bytes copied, %.1f us per chunk (%.0f bytes compressed)",
+			static_cast<double>(NumAllocations) / NUM_CHUNKS, static_cast<double>(NumBytesCopied) / NUM_CHUNKS,
+			Time * 1e6 / NUM_CHUNKS, static_cast<double>(NumBytes) / NUM_CHUNKS
+		);
+	}
+}
+
+
+
+
+
+IMPLEMENT_TEST_MAIN("FastNBT",
+	TestBufferReuse();
+	TestCompressIntoBuffer();
+	Benchmark();
+)
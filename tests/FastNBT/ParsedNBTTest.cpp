@@ -0,0 +1,584 @@
+
+// ParsedNBTTest.cpp
+
+// Checks the lazily expanded cParsedNBT against the previous eager parser, on valid and corrupted data,
+// and compares the parsing and lookup speed on entity-heavy chunks.
+
+#include "Globals.h"
+#include "../TestHelpers.h"
+#include "WorldStorage/FastNBT.h"
+
+
+
+
+
+/** The previous cParsedNBT implementation: parses all the tags up front and looks up the children by walking the siblings.
+Used as the reference for the results and the speed. The only change is that an invalid list item type is reported
+as npUnknownTag instead of reaching UNREACHABLE(). */
+class cEagerNBT
+{
+public:
+
+	cEagerNBT(ContiguousByteBufferView a_Data):
+		m_Data(a_Data),
+		m_Pos(0)
+	{
+		m_Error = Parse();
+	}
+
+	bool IsValid(void) const { return (m_Error == eNBTParseError::npSuccess); }
+	eNBTParseError GetError(void) const { return m_Error; }
+	int GetFirstChild (int a_Tag) const { return m_Tags[static_cast<size_t>(a_Tag)].m_FirstChild; }
+	int GetLastChild  (int a_Tag) const { return m_Tags[static_cast<size_t>(a_Tag)].m_LastChild; }
+	int GetNextSibling(int a_Tag) const { return m_Tags[static_cast<size_t>(a_Tag)].m_NextSibling; }
+	int GetPrevSibling(int a_Tag) const { return m_Tags[static_cast<size_t>(a_Tag)].m_PrevSibling; }
+	eTagType GetType(int a_Tag) const { return m_Tags[static_cast<size_t>(a_Tag)].m_Type; }
+	size_t GetDataLength(int a_Tag) const { return m_Tags[static_cast<size_t>(a_Tag)].m_DataLength; }
+	const std::byte * GetData(int a_Tag) const { return m_Data.data() + m_Tags[static_cast<size_t>(a_Tag)].m_DataStart; }
+
+	std::string_view GetName(int a_Tag) const
+	{
+		return { reinterpret_cast<const char *>(m_Data.data()) + m_Tags[static_cast<size_t>(a_Tag)].m_NameStart, m_Tags[static_cast<size_t>(a_Tag)].m_NameLength };
+	}
+
+	int FindChildByName(int a_Tag, std::string_view a_Name) const
+	{
+		if ((a_Tag < 0) || (m_Tags[static_cast<size_t>(a_Tag)].m_Type != TAG_Compound))
+		{
+			return -1;
+		}
+		for (int Child = m_Tags[static_cast<size_t>(a_Tag)].m_FirstChild; Child != -1; Child = m_Tags[static_cast<size_t>(Child)].m_NextSibling)
+		{
+			if (GetName(Child) == a_Name)
+			{
+				return Child;
+			}
+		}
+		return -1;
+	}
+
+protected:
+
+	ContiguousByteBufferView m_Data;
+	std::vector<cFastNBTTag> m_Tags;
+	eNBTParseError m_Error;
+	size_t m_Pos;
+
+	bool HasBytes(size_t a_NumBytes) const { return (m_Data.size() - m_Pos >= a_NumBytes); }
+
+	eNBTParseError Parse(void)
+	{
+		if (m_Data.size() < 3)
+		{
+			return eNBTParseError::npNeedBytes;
+		}
+		if (m_Data[0] != std::byte(TAG_Compound))
+		{
+			return eNBTParseError::npNoTopLevelCompound;
+		}
+		m_Tags.reserve(200);
+		m_Tags.emplace_back(TAG_Compound, -1);
+		m_Pos = 1;
+		auto Err = ReadString(m_Tags.back().m_NameStart, m_Tags.back().m_NameLength);
+		return (Err != eNBTParseError::npSuccess) ? Err : ReadCompound();
+	}
+
+	eNBTParseError ReadString(size_t & a_StringStart, size_t & a_StringLen)
+	{
+		if (!HasBytes(2))
+		{
+			return eNBTParseError::npStringMissingLength;
+		}
+		a_StringStart = m_Pos + 2;
+		a_StringLen = static_cast<size_t>(NetworkBufToHost<UInt16>(m_Data.data() + m_Pos));
+		if (!HasBytes(2 + a_StringLen))
+		{
+			return eNBTParseError::npStringInvalidLength;
+		}
+		m_Pos += 2 + a_StringLen;
+		return eNBTParseError::npSuccess;
+	}
+
+	/** Appends a new child tag of the specified parent, links it to the previous sibling. */
+	void AddChild(eTagType a_Type, size_t a_ParentIdx, int & a_PrevSibling)
+	{
+		m_Tags.emplace_back(a_Type, static_cast<int>(a_ParentIdx), a_PrevSibling);
+		if (a_PrevSibling >= 0)
+		{
+			m_Tags[static_cast<size_t>(a_PrevSibling)].m_NextSibling = static_cast<int>(m_Tags.size()) - 1;
+		}
+		else
+		{
+			m_Tags[a_ParentIdx].m_FirstChild = static_cast<int>(m_Tags.size()) - 1;
+		}
+		a_PrevSibling = static_cast<int>(m_Tags.size()) - 1;
+	}
+
+	eNBTParseError ReadCompound(void)
+	{
+		size_t ParentIdx = m_Tags.size() - 1;
+		int PrevSibling = -1;
+		for (;;)
+		{
+			if (!HasBytes(1))
+			{
+				return eNBTParseError::npCompoundImbalancedTag;
+			}
+			const auto TagTypeNum = m_Data[m_Pos];
+			if (TagTypeNum > std::byte(TAG_Max))
+			{
+				return eNBTParseError::npUnknownTag;
+			}
+			eTagType TagType = static_cast<eTagType>(TagTypeNum);
+			m_Pos++;
+			if (TagType == TAG_End)
+			{
+				break;
+			}
+			AddChild(TagType, ParentIdx, PrevSibling);
+			auto Err = ReadString(m_Tags.back().m_NameStart, m_Tags.back().m_NameLength);
+			if (Err == eNBTParseError::npSuccess)
+			{
+				Err = ReadTag();
+			}
+			if (Err != eNBTParseError::npSuccess)
+			{
+				return Err;
+			}
+		}
+		m_Tags[ParentIdx].m_LastChild = PrevSibling;
+		return eNBTParseError::npSuccess;
+	}
+
+	eNBTParseError ReadList(eTagType a_ChildrenType)
+	{
+		if (!HasBytes(4))
+		{
+			return eNBTParseError::npListMissingLength;
+		}
+		int Count = NetworkBufToHost<int>(m_Data.data() + m_Pos);
+		m_Pos += 4;
+		static const size_t MinSizes[] = {1, 1, 2, 4, 8, 4, 8, 4, 2, 5, 1, 4, 4};
+		if ((Count < 0) || (Count > static_cast<int>((m_Data.size() - m_Pos) / MinSizes[a_ChildrenType])))
+		{
+			return eNBTParseError::npListInvalidLength;
+		}
+		size_t ParentIdx = m_Tags.size() - 1;
+		int PrevSibling = -1;
+		for (int i = 0; i < Count; i++)
+		{
+			AddChild(a_ChildrenType, ParentIdx, PrevSibling);
+			auto Err = ReadTag();
+			if (Err != eNBTParseError::npSuccess)
+			{
+				return Err;
+			}
+		}
+		m_Tags[ParentIdx].m_LastChild = PrevSibling;
+		return eNBTParseError::npSuccess;
+	}
+
+	eNBTParseError ReadTag(void)
+	{
+		cFastNBTTag & Tag = m_Tags.back();
+		size_t SimpleLength = 0, ArrayItemLength = 0;
+		switch (Tag.m_Type)
+		{
+			case TAG_Byte:      SimpleLength = 1; break;
+			case TAG_Short:     SimpleLength = 2; break;
+			case TAG_Int:       SimpleLength = 4; break;
+			case TAG_Long:      SimpleLength = 8; break;
+			case TAG_Float:     SimpleLength = 4; break;
+			case TAG_Double:    SimpleLength = 8; break;
+			case TAG_ByteArray: ArrayItemLength = 1; break;
+			case TAG_IntArray:  ArrayItemLength = 4; break;
+			case TAG_LongArray: ArrayItemLength = 8; break;
+			case TAG_String:    return ReadString(Tag.m_DataStart, Tag.m_DataLength);
+			case TAG_Compound:  return ReadCompound();
+			case TAG_List:
+			{
+				if (!HasBytes(1))
+				{
+					return eNBTParseError::npListMissingType;
+				}
+				const auto ItemType = m_Data[m_Pos];
+				if (ItemType > std::byte(TAG_Max))
+				{
+					return eNBTParseError::npUnknownTag;
+				}
+				m_Pos++;
+				return ReadList(static_cast<eTagType>(ItemType));
+			}
+			case TAG_End: return eNBTParseError::npUnknownTag;
+		}
+		if (SimpleLength > 0)
+		{
+			if (!HasBytes(SimpleLength))
+			{
+				return eNBTParseError::npSimpleMissing;
+			}
+			Tag.m_DataStart = m_Pos;
+			Tag.m_DataLength = SimpleLength;
+			m_Pos += SimpleLength;
+			return eNBTParseError::npSuccess;
+		}
+		if (!HasBytes(4))
+		{
+			return eNBTParseError::npArrayMissingLength;
+		}
+		int Len = NetworkBufToHost<int>(m_Data.data() + m_Pos);
+		m_Pos += 4;
+		if ((Len < 0) || !HasBytes(static_cast<size_t>(Len) * ArrayItemLength))
+		{
+			return eNBTParseError::npArrayInvalidLength;
+		}
+		Tag.m_DataStart = m_Pos;
+		Tag.m_DataLength = static_cast<size_t>(Len) * ArrayItemLength;
+		m_Pos += Tag.m_DataLength;
+		return eNBTParseError::npSuccess;
+	}
+};
+
+
+
+
+
+/** Writes an entity-heavy chunk NBT: a few sections, a_NumEntities dropped items and a_NumChests chests full of items. */
+static ContiguousByteBuffer CreateEntityHeavyChunk(int a_NumEntities, int a_NumChests)
+{
+	cFastNBTWriter Writer;
+	std::vector<Int64> BlockStates(256, 0x1111222233334444LL);
+	Writer.AddInt("DataVersion", 3953);
+	Writer.AddInt("xPos", 1);
+	Writer.AddInt("zPos", 2);
+	Writer.BeginList("sections", TAG_Compound);
+	for (int Y = -4; Y < 20; Y++)
+	{
+		Writer.BeginCompound("");
+		Writer.AddByte("Y", static_cast<unsigned char>(Y));
+		Writer.BeginCompound("block_states");
+		Writer.BeginList("palette", TAG_Compound);
+		Writer.BeginCompound("");
+		Writer.AddString("Name", "minecraft:stone");
+		Writer.EndCompound();
+		Writer.EndList();
+		Writer.AddLongArray("data", BlockStates.data(), BlockStates.size());
+		Writer.EndCompound();
+		Writer.AddByteArray("BlockLight", 2048, 0);
+		Writer.AddByteArray("SkyLight", 2048, 0xff);
+		Writer.EndCompound();
+	}
+	Writer.EndList();
+
+	// Structure references and heightmaps, which the loader doesn't look into:
+	Writer.BeginCompound("Heightmaps");
+	for (auto Name: {"MOTION_BLOCKING", "MOTION_BLOCKING_NO_LEAVES", "OCEAN_FLOOR", "WORLD_SURFACE"})
+	{
+		Writer.AddLongArray(Name, BlockStates.data(), 37);
+	}
+	Writer.EndCompound();
+	Writer.BeginList("PostProcessing", TAG_List);
+	for (int i = 0; i < 24; i++)
+	{
+		Writer.BeginList("", TAG_Short);
+		for (Int16 j = 0; j < 30; j++)
+		{
+			Writer.AddShort("", j);
+		}
+		Writer.EndList();
+	}
+	Writer.EndList();
+
+	Writer.BeginList("Entities", TAG_Compound);
+	for (int i = 0; i < a_NumEntities; i++)
+	{
+		Writer.BeginCompound("");
+		Writer.AddString("id", "minecraft:item");
+		Writer.BeginList("Pos", TAG_Double);
+		Writer.AddDouble("", i * 0.01);
+		Writer.AddDouble("", 64);
+		Writer.AddDouble("", -i * 0.01);
+		Writer.EndList();
+		Writer.BeginList("Motion", TAG_Double);
+		Writer.AddDouble("", 0);
+		Writer.AddDouble("", -0.04);
+		Writer.AddDouble("", 0);
+		Writer.EndList();
+		Writer.BeginList("Rotation", TAG_Float);
+		Writer.AddFloat("", 90);
+		Writer.AddFloat("", 0);
+		Writer.EndList();
+		Writer.AddFloat("FallDistance", 0);
+		Writer.AddShort("Fire", -1);
+		Writer.AddShort("Air", 300);
+		Writer.AddByte("OnGround", 1);
+		Writer.AddByte("Invulnerable", 0);
+		Writer.AddInt("PortalCooldown", 0);
+		const Int32 UUID[] = {i, 2, 3, 4};
+		Writer.AddIntArray("UUID", UUID, 4);
+		Writer.AddShort("Health", 5);
+		Writer.AddShort("Age", static_cast<Int16>(i % 6000));
+		Writer.AddShort("PickupDelay", 0);
+		Writer.BeginCompound("Item");
+		Writer.AddString("id", "minecraft:cobblestone");
+		Writer.AddByte("Count", 64);
+		Writer.EndCompound();
+		Writer.EndCompound();
+	}
+	Writer.EndList();
+
+	Writer.BeginList("block_entities", TAG_Compound);
+	for (int i = 0; i < a_NumChests; i++)
+	{
+		Writer.BeginCompound("");
+		Writer.AddString("id", "minecraft:chest");
+		Writer.AddInt("x", i % 16);
+		Writer.AddInt("y", 64 + i / 256);
+		Writer.AddInt("z", (i / 16) % 16);
+		Writer.AddByte("keepPacked", 0);
+		Writer.BeginList("Items", TAG_Compound);
+		for (int Slot = 0; Slot < 27; Slot++)
+		{
+			Writer.BeginCompound("");
+			Writer.AddByte("Slot", static_cast<unsigned char>(Slot));
+			Writer.AddString("id", "minecraft:diamond");
+			Writer.AddByte("Count", 64);
+			Writer.EndCompound();
+		}
+		Writer.EndList();
+		Writer.EndCompound();
+	}
+	Writer.EndList();
+	Writer.Finish();
+	return ContiguousByteBuffer(Writer.GetResult());
+}
+
+
+
+
+
+/** Recursively compares the subtree of a_Tag in the lazy NBT to the subtree of a_RefTag in the eager one. */
+static void CompareTrees(const cParsedNBT & a_NBT, int a_Tag, const cEagerNBT & a_Ref, int a_RefTag)
+{
+	TEST_EQUAL(a_NBT.GetType(a_Tag), a_Ref.GetType(a_RefTag));
+	TEST_EQUAL(a_NBT.GetName(a_Tag), AString(a_Ref.GetName(a_RefTag)));
+	const auto Type = a_NBT.GetType(a_Tag);
+	if ((Type != TAG_Compound) && (Type != TAG_List))
+	{
+		TEST_EQUAL(a_NBT.GetDataLength(a_Tag), a_Ref.GetDataLength(a_RefTag));
+		TEST_TRUE(a_NBT.GetData(a_Tag) == a_Ref.GetData(a_RefTag));
+		return;
+	}
+
+	// Compare the children, and check that looking them up by name gives the same tags as the siblings walk:
+	int Child = a_NBT.GetFirstChild(a_Tag);
+	int RefChild = a_Ref.GetFirstChild(a_RefTag);
+	int NumChildren = 0;
+	while ((Child != -1) && (RefChild != -1))
+	{
+		if (Type == TAG_Compound)
+		{
+			const auto Name = a_NBT.GetName(Child);
+			const auto Found = a_NBT.FindChildByName(a_Tag, Name);
+			const auto RefFound = a_Ref.FindChildByName(a_RefTag, Name);
+			TEST_EQUAL(Found == Child, RefFound == RefChild);
+		}
+		CompareTrees(a_NBT, Child, a_Ref, RefChild);
+		TEST_EQUAL(a_NBT.GetPrevSibling(Child) == -1, a_Ref.GetPrevSibling(RefChild) == -1);
+		Child = a_NBT.GetNextSibling(Child);
+		RefChild = a_Ref.GetNextSibling(RefChild);
+		NumChildren += 1;
+	}
+	TEST_EQUAL(Child, -1);
+	TEST_EQUAL(RefChild, -1);
+	TEST_EQUAL(a_NBT.GetNumChildren(a_Tag), NumChildren);
+	TEST_EQUAL(a_NBT.GetLastChild(a_Tag) == -1, a_Ref.GetLastChild(a_RefTag) == -1);
+	if (Type == TAG_Compound)
+	{
+		TEST_EQUAL(a_NBT.FindChildByName(a_Tag, "NonExistent"_nbt), -1);
+	}
+}
+
+
+
+
+
+/** Checks that the lazy parser gives the same tree as the eager one, including the duplicate names. */
+static void TestSameTree(void)
+{
+	for (int NumEntities: {0, 1, 7, 50})
+	{
+		const auto Data = CreateEntityHeavyChunk(NumEntities, NumEntities / 2);
+		const cParsedNBT NBT(Data);
+		const cEagerNBT Ref(Data);
+		TEST_TRUE(NBT.IsValid());
+		TEST_TRUE(Ref.IsValid());
+		CompareTrees(NBT, NBT.GetRoot(), Ref, 0);
+	}
+
+	// Duplicate names in a large compound, the first one must be found:
+	cFastNBTWriter Writer;
+	for (int i = 0; i < 40; i++)
+	{
+		Writer.AddInt(fmt::format(FMT_STRING("Value{}"), i % 13), i);
+	}
+	Writer.Finish();
+	const cParsedNBT NBT(Writer.GetResult());
+	TEST_TRUE(NBT.IsValid());
+	for (int i = 0; i < 13; i++)
+	{
+		const auto Tag = NBT.FindChildByName(NBT.GetRoot(), fmt::format(FMT_STRING("Value{}"), i));
+		TEST_NOTEQUAL(Tag, -1);
+		TEST_EQUAL(NBT.GetInt(Tag), i);
+	}
+	TEST_EQUAL(NBT.FindTagByPath(NBT.GetRoot(), "Value13"), -1);
+}
+
+
+
+
+
+/** Checks that the lazy parser reports the same errors as the eager one on truncated and corrupted data. */
+static void TestCorruptedData(void)
+{
+	const auto Data = CreateEntityHeavyChunk(5, 3);
+
+	// Truncated data:
+	for (size_t Length = 0; Length < Data.size(); Length += 1 + Length / 64)
+	{
+		const ContiguousByteBufferView View(Data.data(), Length);
+		const cParsedNBT NBT(View);
+		const cEagerNBT Ref(View);
+		TEST_FALSE(NBT.IsValid());
+		TEST_TRUE(NBT.GetErrorCode() == make_error_code(Ref.GetError()));
+	}
+
+	// Single corrupted bytes:
+	for (size_t Pos = 0; Pos < Data.size(); Pos += 1 + Pos / 256)
+	{
+		for (auto Value: {std::byte(0x00), std::byte(0x0d), std::byte(0x7f), std::byte(0xff)})
+		{
+			auto Corrupted = Data;
+			Corrupted[Pos] = Value;
+			const cParsedNBT NBT(Corrupted);
+			const cEagerNBT Ref(Corrupted);
+			TEST_TRUE(NBT.GetErrorCode() == make_error_code(Ref.GetError()));
+			if (NBT.IsValid())
+			{
+				CompareTrees(NBT, NBT.GetRoot(), Ref, 0);
+			}
+		}
+	}
+}
+
+
+
+
+
+/** Looks up the entity and block entity fields like the cWSSAnvil loader does; returns a checksum of the values. */
+template <typename NBT, typename Name>
+static int LoadLikeAnvil(const NBT & a_NBT, Name && a_Name)
+{
+	int Res = 0;
+	auto Found = [&Res](int a_Tag)
+	{
+		Res += (a_Tag >= 0) ? 1 : 0;
+		return a_Tag;
+	};
+	const int Entities = Found(a_NBT.FindChildByName(0, a_Name("Entities")));
+	for (int Entity = a_NBT.GetFirstChild(Entities); Entity != -1; Entity = a_NBT.GetNextSibling(Entity))
+	{
+		for (auto Field: {"id", "Pos", "Motion", "Rotation", "Health", "HealF", "Age", "PickupDelay", "Item", "Fire", "OnGround", "UUID"})
+		{
+			Found(a_NBT.FindChildByName(Entity, a_Name(Field)));
+		}
+		const int Pos = a_NBT.FindChildByName(Entity, a_Name("Pos"));
+		for (int Coord = a_NBT.GetFirstChild(Pos); Coord != -1; Coord = a_NBT.GetNextSibling(Coord))
+		{
+			Res += static_cast<int>(a_NBT.GetDataLength(Coord));
+		}
+		Found(a_NBT.FindChildByName(a_NBT.FindChildByName(Entity, a_Name("Item")), a_Name("Count")));
+	}
+	const int BlockEntities = Found(a_NBT.FindChildByName(0, a_Name("block_entities")));
+	for (int BlockEntity = a_NBT.GetFirstChild(BlockEntities); BlockEntity != -1; BlockEntity = a_NBT.GetNextSibling(BlockEntity))
+	{
+		for (auto Field: {"id", "x", "y", "z", "CustomName", "Lock"})
+		{
+			Found(a_NBT.FindChildByName(BlockEntity, a_Name(Field)));
+		}
+		const int Items = a_NBT.FindChildByName(BlockEntity, a_Name("Items"));
+		for (int Item = a_NBT.GetFirstChild(Items); Item != -1; Item = a_NBT.GetNextSibling(Item))
+		{
+			for (auto Field: {"Slot", "id", "Count", "Damage", "tag"})
+			{
+				Found(a_NBT.FindChildByName(Item, a_Name(Field)));
+			}
+		}
+	}
+	return Res;
+}
+
+
+
+
+
+/** Parses the entity-heavy chunks with both parsers, measures the parsing alone and the parsing with the loader-like lookups. */
+static void Benchmark(void)
+{
+	for (auto NumEntities: {100, 2000, 10000})
+	{
+		const auto Data = CreateEntityHeavyChunk(NumEntities, NumEntities / 10);
+		const int NumRepeats = 2000000 / static_cast<int>(Data.size()) + 5;
+
+		// Only parse, such as when a chunk is loaded just to be rewritten:
+		auto Start = std::chrono::steady_clock::now();
+		size_t Checksum = 0;
+		for (int i = 0; i < NumRepeats; i++)
+		{
+			const cEagerNBT Ref(Data);
+			Checksum += Ref.IsValid() ? 1 : 0;
+		}
+		const auto EagerParse = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count() / NumRepeats;
+		Start = std::chrono::steady_clock::now();
+		for (int i = 0; i < NumRepeats; i++)
+		{
+			const cParsedNBT NBT(Data);
+			Checksum += NBT.IsValid() ? 1 : 0;
+		}
+		const auto LazyParse = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count() / NumRepeats;
+		TEST_EQUAL(Checksum, static_cast<size_t>(2 * NumRepeats));
+
+		// Parse and look up the fields like the loader:
+		int EagerChecksum = 0, LazyChecksum = 0;
+		Start = std::chrono::steady_clock::now();
+		for (int i = 0; i < NumRepeats; i++)
+		{
+			const cEagerNBT Ref(Data);
+			EagerChecksum += LoadLikeAnvil(Ref, [](const char * a_Name) { return std::string_view(a_Name); });
+		}
+		const auto EagerLoad = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count() / NumRepeats;
+		Start = std::chrono::steady_clock::now();
+		for (int i = 0; i < NumRepeats; i++)
+		{
+			const cParsedNBT NBT(Data);
+			LazyChecksum += LoadLikeAnvil(NBT, [](const char * a_Name) { return sNBTKey(a_Name); });
+		}
+		const auto LazyLoad = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count() / NumRepeats;
+		TEST_EQUAL(EagerChecksum, LazyChecksum);
+
+		LOG("%d entities, %d chests (%zu KiB): parse %.0f -> %.0f us, parse and load %.0f -> %.0f us (%.2fx)",
+			NumEntities, NumEntities / 10, Data.size() / 1024,
+			EagerParse * 1e6, LazyParse * 1e6, EagerLoad * 1e6, LazyLoad * 1e6, EagerLoad / LazyLoad
+		);
+	}
+}
+
+
+
+
+
+IMPLEMENT_TEST_MAIN("ParsedNBT",
+	TestSameTree();
+	TestCorruptedData();
+	Benchmark();
+)
@@ -0,0 +1,290 @@
+
+// GenCacheTest.cpp
+
+// Checks the cGenCache and cGenCacheConcurrent classes against a simple model,
+// and compares their speed with the MRU linear-scan caches that the generators used before.
+
+#include "Globals.h"
+#include "../TestHelpers.h"
+#include "FastRandom.h"
+#include "Generating/GenCache.h"
+
+
+
+
+
+/** The value cached for each chunk, derived from its coords so that the hits can be verified. */
+using cValue = std::array<int, 64>;
+
+static cValue MakeValue(cChunkCoords a_Coords)
+{
+	cValue Res;
+	for (size_t i = 0; i < Res.size(); i++)
+	{
+		Res[i] = a_Coords.m_ChunkX * 31 + a_Coords.m_ChunkZ * 17 + static_cast<int>(i);
+	}
+	return Res;
+}
+
+
+
+
+
+/** The MRU cache, as previously implemented by the biome and height caches; used as the reference for the benchmark. */
+class cMRUCache
+{
+public:
+
+	cMRUCache(size_t a_Size) :
+		m_Order(a_Size),
+		m_Data(a_Size, {cChunkCoords(0x7fffffff, 0x7fffffff), cValue()})
+	{
+		for (size_t i = 0; i < a_Size; i++)
+		{
+			m_Order[i] = i;
+		}
+	}
+
+	void GetOrGenerate(cChunkCoords a_Coords, cValue & a_Value)
+	{
+		for (size_t i = 0; i < m_Order.size(); i++)
+		{
+			if (m_Data[m_Order[i]].first != a_Coords)
+			{
+				continue;
+			}
+			auto Idx = m_Order[i];
+			for (size_t j = i; j > 0; j--)
+			{
+				m_Order[j] = m_Order[j - 1];
+			}
+			m_Order[0] = Idx;
+			a_Value = m_Data[Idx].second;
+			return;
+		}
+		a_Value = MakeValue(a_Coords);
+		auto Idx = m_Order.back();
+		for (size_t i = m_Order.size() - 1; i > 0; i--)
+		{
+			m_Order[i] = m_Order[i - 1];
+		}
+		m_Order[0] = Idx;
+		m_Data[Idx] = {a_Coords, a_Value};
+	}
+
+protected:
+
+	std::vector<size_t> m_Order;
+	std::vector<std::pair<cChunkCoords, cValue>> m_Data;
+};
+
+
+
+
+
+/** Returns the chunks queried when generating a_NumChunks chunks in a spiral around the origin,
+with each chunk querying its 5x5 neighbourhood, the way the finishers and structure generators do. */
+static std::vector<cChunkCoords> GetQueries(int a_NumChunks)
+{
+	std::vector<cChunkCoords> Res;
+	int x = 0, z = 0, dx = 1, dz = 0, Len = 1, Step = 0, Turns = 0;
+	for (int i = 0; i < a_NumChunks; i++)
+	{
+		for (int nz = -2; nz <= 2; nz++)
+		{
+			for (int nx = -2; nx <= 2; nx++)
+			{
+				Res.emplace_back(x + nx, z + nz);
+			}
+		}
+		x += dx;
+		z += dz;
+		if (++Step == Len)
+		{
+			Step = 0;
+			std::swap(dx, dz);
+			dx = -dx;
+			if ((++Turns % 2) == 0)
+			{
+				Len++;
+			}
+		}
+	}
+	return Res;
+}
+
+
+
+
+
+/** Checks that the cache returns the right values, never holds more than its capacity,
+and keeps everything while the number of distinct chunks fits. */
+static void TestCorrectness(void)
+{
+	// Everything fits:
+	{
+		cGenCache<cValue> Cache(100);
+		for (int i = 0; i < 100; i++)
+		{
+			Cache.Insert({i, -i}, [i](cValue & a_Value) { a_Value = MakeValue({i, -i}); });
+		}
+		for (int i = 0; i < 100; i++)
+		{
+			cValue Value;
+			TEST_TRUE(Cache.Find({i, -i}, [&Value](const cValue & a_Cached) { Value = a_Cached; }));
+			TEST_TRUE(Value == MakeValue({i, -i}));
+		}
+		TEST_FALSE(Cache.Find({100, -100}, [](const cValue & a_Cached) {}));
+		const auto Stats = Cache.GetStats();
+		TEST_EQUAL(Stats.m_NumHits, 100);
+		TEST_EQUAL(Stats.m_NumMisses, 1);
+		TEST_EQUAL(Stats.m_NumEvictions, 0);
+	}
+
+	// Random accesses over more chunks than fit, with a model of which chunks are cached:
+	cFastRandom Random;
+	cGenCache<cValue> Cache(37);
+	std::set<std::pair<int, int>> Cached;
+	for (int i = 0; i < 200000; i++)
+	{
+		const cChunkCoords Coords(Random.RandInt(-20, 20), Random.RandInt(-20, 20));
+		cValue Value;
+		const bool IsHit = Cache.Find(Coords, [&Value](const cValue & a_Cached) { Value = a_Cached; });
+		TEST_EQUAL(IsHit, Cached.count({Coords.m_ChunkX, Coords.m_ChunkZ}) > 0);
+		if (IsHit)
+		{
+			TEST_TRUE(Value == MakeValue(Coords));
+			continue;
+		}
+		Cache.Insert(Coords, [Coords](cValue & a_Value) { a_Value = MakeValue(Coords); });
+
+		// Update the model, find out which chunk got evicted:
+		if (Cached.size() == Cache.GetCapacity())
+		{
+			for (auto itr = Cached.begin(); itr != Cached.end(); ++itr)
+			{
+				if (!Cache.Peek({itr->first, itr->second}, [](const cValue & a_Cached) {}))
+				{
+					Cached.erase(itr);
+					break;
+				}
+			}
+		}
+		Cached.insert({Coords.m_ChunkX, Coords.m_ChunkZ});
+		TEST_LESS_THAN_OR_EQUAL(Cached.size(), Cache.GetCapacity());
+	}
+	const auto Stats = Cache.GetStats();
+	TEST_EQUAL(Stats.m_NumHits + Stats.m_NumMisses, 200000);
+	TEST_EQUAL(Stats.m_NumEvictions + Cache.GetCapacity(), Stats.m_NumMisses);
+	LOG("Random accesses: %.1f %% hit rate", Stats.GetHitRate());
+
+	// The recently used chunks survive a scan:
+	cGenCache<cValue> Cache2(16);
+	for (int i = 0; i < 1000; i++)
+	{
+		cValue Value;
+		Cache2.GetOrGenerate({0, 0}, Value, [](cValue & a_Value) { a_Value = MakeValue({0, 0}); });
+		Cache2.GetOrGenerate({i, 1}, Value, [i](cValue & a_Value) { a_Value = MakeValue({i, 1}); });
+	}
+	TEST_EQUAL(Cache2.GetStats().m_NumHits, 999);
+}
+
+
+
+
+
+/** Runs several threads over the same concurrent cache, checks that all the hits return the right values. */
+static void TestConcurrent(void)
+{
+	cGenCacheConcurrent<cValue> Cache(16, 32);
+	std::atomic<size_t> NumBad{0};
+	std::vector<std::thread> Threads;
+	for (int t = 0; t < 4; t++)
+	{
+		Threads.emplace_back([&Cache, &NumBad, t]()
+			{
+				const auto Queries = GetQueries(2000);
+				for (size_t i = 0; i < Queries.size(); i++)
+				{
+					const auto & Coords = Queries[(i + static_cast<size_t>(t) * 997) % Queries.size()];
+					cValue Value;
+					Cache.GetOrGenerate(Coords, Value, [Coords](cValue & a_Value) { a_Value = MakeValue(Coords); });
+					if (Value != MakeValue(Coords))
+					{
+						NumBad++;
+					}
+				}
+			}
+		);
+	}
+	for (auto & Thread : Threads)
+	{
+		Thread.join();
+	}
+	TEST_EQUAL(NumBad.load(), 0);
+	const auto Stats = Cache.GetStats();
+	TEST_EQUAL(Stats.m_NumHits + Stats.m_NumMisses, GetQueries(2000).size() * 4);
+	LOG("Concurrent accesses: %.1f %% hit rate", Stats.GetHitRate());
+}
+
+
+
+
+
+/** Measures the lookups of the generator-like access pattern through the MRU cache and the hash caches of the same total size. */
+static void Benchmark(size_t a_CacheSize)
+{
+	const auto Queries = GetQueries(20000);
+
+	cMRUCache MRU(a_CacheSize);
+	cValue Value;
+	Int64 Checksum1 = 0;
+	auto Start = std::chrono::steady_clock::now();
+	for (const auto & Coords : Queries)
+	{
+		MRU.GetOrGenerate(Coords, Value);
+		Checksum1 += Value[0];
+	}
+	const auto MRUTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+
+	cGenCache<cValue> Cache(a_CacheSize);
+	Int64 Checksum2 = 0;
+	Start = std::chrono::steady_clock::now();
+	for (const auto & Coords : Queries)
+	{
+		Cache.GetOrGenerate(Coords, Value, [&Coords](cValue & a_Value) { a_Value = MakeValue(Coords); });
+		Checksum2 += Value[0];
+	}
+	const auto HashTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+
+	cGenCacheConcurrent<cValue> Concurrent(a_CacheSize / 16, 16);
+	Int64 Checksum3 = 0;
+	Start = std::chrono::steady_clock::now();
+	for (const auto & Coords : Queries)
+	{
+		Concurrent.GetOrGenerate(Coords, Value, [&Coords](cValue & a_Value) { a_Value = MakeValue(Coords); });
+		Checksum3 += Value[0];
+	}
+	const auto ConcurrentTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+
+	TEST_EQUAL(Checksum1, Checksum2);
+	TEST_EQUAL(Checksum1, Checksum3);
+	LOG("Cache size %zu: MRU %.1f ns, hash %.1f ns (%.1f %% hits), concurrent %.1f ns per lookup",
+		a_CacheSize,
+		MRUTime * 1e9 / static_cast<double>(Queries.size()),
+		HashTime * 1e9 / static_cast<double>(Queries.size()), Cache.GetStats().GetHitRate(),
+		ConcurrentTime * 1e9 / static_cast<double>(Queries.size())
+	);
+}
+
+
+
+
+
+IMPLEMENT_TEST_MAIN("GenCache",
+	TestCorrectness();
+	TestConcurrent();
+	Benchmark(64);
+	Benchmark(256);
+	Benchmark(2048);
+)
@@ -0,0 +1,115 @@
+
+// GeneratorThroughput.cpp
+
+// Measures the chunk generation throughput of cChunkGeneratorThread for the default world presets with various thread counts
+
+#include "Globals.h"
+#include "../TestHelpers.h"
+#include "ChunkGeneratorThread.h"
+#include "Generating/ChunkDesc.h"
+#include "IniFile.h"
+
+
+
+
+
+/** The size of the generated area, in chunks per side. */
+static const int AREA_SIZE = 16;
+
+
+
+
+
+/** Counts the generated chunks, doesn't call any hooks. */
+class cThroughputCallbacks :
+	public cChunkGeneratorThread::cChunkSink,
+	public cChunkGeneratorThread::cPluginInterface
+{
+public:
+
+	std::atomic<size_t> m_NumGenerated{0};
+
+protected:
+
+	// cChunkSink overrides:
+	virtual void OnChunkGenerated(cChunkDesc & a_ChunkDesc) override { m_NumGenerated++; }
+	virtual bool IsChunkValid(cChunkCoords a_Coords) override { return false; }
+	virtual bool HasChunkAnyClients(cChunkCoords a_Coords) override { return true; }
+	virtual bool IsChunkQueued(cChunkCoords a_Coords) override { return true; }
+
+	// cPluginInterface overrides:
+	virtual void CallHookChunkGenerating(cChunkDesc & a_ChunkDesc) override {}
+	virtual void CallHookChunkGenerated(cChunkDesc & a_ChunkDesc) override {}
+} ;
+
+
+
+
+
+/** Generates the test area using the default generator for the specified dimension and number of threads. */
+static void MeasureThroughput(const AString & a_Dimension, int a_NumThreads)
+{
+	cIniFile Ini;
+	Ini.AddValue("General", "Dimension", a_Dimension);
+	Ini.AddValueI("Seed", "Seed", 1);
+	Ini.AddValueI("Generator", "NumThreads", a_NumThreads);
+
+	cThroughputCallbacks Callbacks;
+	cChunkGeneratorThread Generator;
+	TEST_TRUE(Generator.Initialize(Callbacks, Callbacks, Ini));
+	TEST_EQUAL(Generator.GetNumThreads(), static_cast<size_t>(a_NumThreads));
+
+	auto Start = std::chrono::steady_clock::now();
+	Generator.Start();
+	for (int z = -AREA_SIZE / 2; z < AREA_SIZE / 2; z++)
+	{
+		for (int x = -AREA_SIZE / 2; x < AREA_SIZE / 2; x++)
+		{
+			Generator.QueueGenerateChunk({x, z}, false);
+		}
+	}
+	const size_t NumChunks = AREA_SIZE * AREA_SIZE;
+	while (Callbacks.m_NumGenerated < NumChunks)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	auto Elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - Start).count();
+	const auto CacheStats = Generator.GetCacheStats();
+	Generator.Stop();
+
+	LOG("%s, %d thread(s): %zu chunks in %lld msec, %.2f chunks / sec",
+		a_Dimension, a_NumThreads, NumChunks, static_cast<long long>(Elapsed),
+		static_cast<double>(NumChunks) * 1000 / std::max<long long>(Elapsed, 1)
+	);
+	for (const auto & Entry : CacheStats)
+	{
+		LOG("  %s cache: %llu hits, %llu misses, hit rate %.1f %%",
+			Entry.first, static_cast<unsigned long long>(Entry.second.m_NumHits),
+			static_cast<unsigned long long>(Entry.second.m_NumMisses), Entry.second.GetHitRate()
+		);
+	}
+}
+
+
+
+
+
+/** Measures the specified preset with an increasing number of threads. */
+static void TestPreset(const AString & a_Dimension)
+{
+	int MaxThreads = Clamp(static_cast<int>(std::thread::hardware_concurrency()), 2, 8);
+	for (int NumThreads = 1; NumThreads <= MaxThreads; NumThreads *= 2)
+	{
+		MeasureThroughput(a_Dimension, NumThreads);
+	}
+}
+
+
+
+
+
+IMPLEMENT_TEST_MAIN("GeneratorThroughput",
+	TestPreset("Overworld");
+	TestPreset("Nether");
+	TestPreset("End");
+)
@@ -0,0 +1,241 @@
+
+// HTTPFileCacheTest.cpp
+
+// Tests the cHTTPFileCache class used by the webadmin for serving its static files:
+// loading, gzipping, invalidation on file changes, the conditional request headers,
+// and compares the cost of serving a file from the cache against reading it for each request.
+
+#include "Globals.h"
+#include "../TestHelpers.h"
+#include "HTTP/HTTPFileCache.h"
+#include "HTTP/HTTPMessage.h"
+#include "StringCompression.h"
+
+
+
+
+
+static const char TEST_FILE_NAME[] = "HTTPFileCacheTest.tmp";
+
+
+
+
+
+/** Writes the specified contents into the test file. */
+static void WriteTestFile(const AString & a_Contents)
+{
+	cFile File(TEST_FILE_NAME, cFile::fmWrite);
+	TEST_TRUE(File.IsOpen());
+	TEST_EQUAL(File.Write(a_Contents.data(), a_Contents.size()), static_cast<int>(a_Contents.size()));
+}
+
+
+
+
+
+/** Returns a CSS-like compressible text of roughly the specified size. */
+static AString CreateStylesheet(size_t a_Size)
+{
+	AString Res;
+	for (int i = 0; Res.size() < a_Size; i++)
+	{
+		Res.append(fmt::format(FMT_STRING(".row{} {{ margin: 0 {}px; color: #333; }}\n"), i, i % 17));
+	}
+	return Res;
+}
+
+
+
+
+
+/** Checks the loading, the gzipped variant and the invalidation when the file changes. */
+static void TestLoadAndInvalidate(void)
+{
+	const auto Stylesheet = CreateStylesheet(20000);
+	WriteTestFile(Stylesheet);
+
+	// The cache that never revalidates serves the same entry:
+	cHTTPFileCache Cache(std::chrono::hours(1));
+	auto Entry = Cache.Get(TEST_FILE_NAME);
+	TEST_NOTEQUAL(Entry, nullptr);
+	TEST_EQUAL(Entry->m_Content, Stylesheet);
+	TEST_FALSE(Entry->m_GZipContent.empty());
+	TEST_LESS_THAN_OR_EQUAL(Entry->m_GZipContent.size(), Stylesheet.size() / 4);
+	const auto Extracted = Compression::Extractor().ExtractGZip(
+		{ reinterpret_cast<const std::byte *>(Entry->m_GZipContent.data()), Entry->m_GZipContent.size() }
+	);
+	TEST_EQUAL(AString(Extracted.GetStringView()), Stylesheet);
+	TEST_NOTEQUAL(Entry->m_ETag, Entry->m_GZipETag);
+	TEST_EQUAL(Cache.Get(TEST_FILE_NAME), Entry);
+	WriteTestFile(Stylesheet + "/* changed */");
+	TEST_EQUAL(Cache.Get(TEST_FILE_NAME), Entry);
+	auto Stats = Cache.GetStats();
+	TEST_EQUAL(Stats.m_NumLoads, 1);
+	TEST_EQUAL(Stats.m_NumHits, 2);
+	TEST_EQUAL(Stats.m_CachedBytes, Entry->m_Content.size() + Entry->m_GZipContent.size());
+
+	// The cache that always revalidates notices the change, and keeps the unchanged file:
+	cHTTPFileCache Revalidating(std::chrono::milliseconds(0));
+	WriteTestFile(Stylesheet);
+	auto Original = Revalidating.Get(TEST_FILE_NAME);
+	TEST_EQUAL(Revalidating.Get(TEST_FILE_NAME), Original);
+	WriteTestFile(Stylesheet + "/* changed */");
+	auto Changed = Revalidating.Get(TEST_FILE_NAME);
+	TEST_NOTEQUAL(Changed, Original);
+	TEST_EQUAL(Changed->m_Content, Stylesheet + "/* changed */");
+	TEST_NOTEQUAL(Changed->m_ETag, Original->m_ETag);
+	Stats = Revalidating.GetStats();
+	TEST_EQUAL(Stats.m_NumLoads, 2);
+	TEST_EQUAL(Stats.m_NumRevalidations, 1);
+	TEST_EQUAL(Stats.m_CachedBytes, Changed->m_Content.size() + Changed->m_GZipContent.size());
+
+	// A removed file is dropped from the cache:
+	cFile::DeleteFile(TEST_FILE_NAME);
+	TEST_EQUAL(Revalidating.Get(TEST_FILE_NAME), nullptr);
+	TEST_EQUAL(Revalidating.GetStats().m_CachedBytes, 0);
+
+	// Incompressible files don't get the gzipped variant:
+	std::minstd_rand Rand(1);
+	AString Random;
+	for (int i = 0; i < 1000; i++)
+	{
+		Random.push_back(static_cast<char>(Rand() >> 7));
+	}
+	WriteTestFile(Random);
+	Entry = Revalidating.Get(TEST_FILE_NAME);
+	TEST_NOTEQUAL(Entry, nullptr);
+	TEST_TRUE(Entry->m_GZipContent.empty());
+
+	// Files over the size limit are served, but not kept:
+	cHTTPFileCache Small(std::chrono::hours(1), 1000);
+	WriteTestFile(Stylesheet);
+	TEST_NOTEQUAL(Small.Get(TEST_FILE_NAME), nullptr);
+	TEST_NOTEQUAL(Small.Get(TEST_FILE_NAME), nullptr);
+	TEST_EQUAL(Small.GetStats().m_NumLoads, 2);
+	TEST_EQUAL(Small.GetStats().m_CachedBytes, 0);
+
+	TEST_EQUAL(Cache.Get("NonExistentFile.tmp"), nullptr);
+	cFile::DeleteFile(TEST_FILE_NAME);
+}
+
+
+
+
+
+/** Checks the conditional request headers, the encoding negotiation and the response headers. */
+static void TestHeaders(void)
+{
+	TEST_EQUAL(cHTTPFileCache::FormatHTTPDate(784111777), "Sun, 06 Nov 1994 08:49:37 GMT");
+
+	cHTTPFileCache::sEntry Entry;
+	Entry.m_ETag = "\"0123\"";
+	Entry.m_GZipETag = "\"0123-gz\"";
+	Entry.m_LastModified = "Sun, 06 Nov 1994 08:49:37 GMT";
+
+	auto IsNotModified = [&Entry](const AString & a_Header, const AString & a_Value)
+	{
+		cHTTPIncomingRequest Request("GET", "/style.css");
+		Request.AddHeader(a_Header, a_Value);
+		return cHTTPFileCache::IsNotModified(Entry, Request);
+	};
+	TEST_TRUE(IsNotModified("If-None-Match", "\"0123\""));
+	TEST_TRUE(IsNotModified("If-None-Match", "\"0123-gz\""));
+	TEST_TRUE(IsNotModified("if-none-match", "W/\"0123\""));
+	TEST_TRUE(IsNotModified("If-None-Match", "\"abcd\", \"0123\""));
+	TEST_TRUE(IsNotModified("If-None-Match", "*"));
+	TEST_FALSE(IsNotModified("If-None-Match", "\"abcd\""));
+	TEST_TRUE(IsNotModified("If-Modified-Since", "Sun, 06 Nov 1994 08:49:37 GMT"));
+	TEST_FALSE(IsNotModified("If-Modified-Since", "Sun, 06 Nov 1994 08:49:38 GMT"));
+	TEST_FALSE(IsNotModified("Accept", "*/*"));
+
+	auto AcceptsGZip = [](const AString & a_Value)
+	{
+		cHTTPIncomingRequest Request("GET", "/style.css");
+		Request.AddHeader("Accept-Encoding", a_Value);
+		return cHTTPFileCache::AcceptsGZip(Request);
+	};
+	TEST_TRUE(AcceptsGZip("gzip, deflate, br"));
+	TEST_TRUE(AcceptsGZip("deflate, GZIP;q=0.5"));
+	TEST_TRUE(AcceptsGZip("*"));
+	TEST_FALSE(AcceptsGZip("deflate, br"));
+	TEST_FALSE(AcceptsGZip("gzip;q=0"));
+	TEST_FALSE(AcceptsGZip("br, gzip; q=0.0"));
+	TEST_FALSE(AcceptsGZip(""));
+
+	// The 304 response has the validators, but no body:
+	cHTTPOutgoingResponse Response;
+	Response.SetContentType("text/css");
+	cHTTPFileCache::SetResponseHeaders(Entry, true, Response);
+	Response.SetStatus(304, "Not Modified");
+	TEST_FALSE(Response.HasBody());
+	AString Data;
+	Response.AppendToData(Data);
+	TEST_EQUAL(Data.substr(0, 27), "HTTP/1.1 304 Not Modified\r\n");
+	TEST_EQUAL(Data.find("Transfer-Encoding"), AString::npos);
+	TEST_NOTEQUAL(Data.find("etag: \"0123-gz\"\r\n"), AString::npos);
+	TEST_NOTEQUAL(Data.find("last-modified: Sun, 06 Nov 1994 08:49:37 GMT\r\n"), AString::npos);
+
+	// The default response is still a chunked "200 OK":
+	cHTTPOutgoingResponse Default;
+	Default.SetContentType("text/html");
+	Data.clear();
+	Default.AppendToData(Data);
+	TEST_EQUAL(Data, "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\nContent-Type: text/html\r\n\r\n");
+}
+
+
+
+
+
+/** Serves a stylesheet repeatedly by reading the file for each request (as the webadmin used to) and from the cache,
+reports the time per request and the bytes sent. */
+static void Benchmark(void)
+{
+	static const int NUM_REQUESTS = 20000;
+	const auto Stylesheet = CreateStylesheet(60000);
+	WriteTestFile(Stylesheet);
+
+	size_t BytesSent = 0;
+	auto Start = std::chrono::steady_clock::now();
+	for (int i = 0; i < NUM_REQUESTS; i++)
+	{
+		cFile File(TEST_FILE_NAME, cFile::fmRead);
+		AString Content;
+		TEST_TRUE(File.IsOpen() && (File.ReadRestOfFile(Content) != -1));
+		BytesSent += Content.size();
+	}
+	const auto ReadTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+	LOG("Reading the file:  %.2f us per request, %zu bytes sent", ReadTime * 1e6 / NUM_REQUESTS, BytesSent / NUM_REQUESTS);
+
+	// Every 10th request is a full download, the others are polls revalidating with If-None-Match:
+	cHTTPFileCache Cache;
+	cHTTPIncomingRequest Poll("GET", "/style.css");
+	Poll.AddHeader("Accept-Encoding", "gzip, deflate");
+	Poll.AddHeader("If-None-Match", Cache.Get(TEST_FILE_NAME)->m_GZipETag);
+	BytesSent = 0;
+	Start = std::chrono::steady_clock::now();
+	for (int i = 0; i < NUM_REQUESTS; i++)
+	{
+		auto Entry = Cache.Get(TEST_FILE_NAME);
+		if ((i % 10 != 0) && cHTTPFileCache::IsNotModified(*Entry, Poll))
+		{
+			continue;
+		}
+		BytesSent += cHTTPFileCache::AcceptsGZip(Poll) ? Entry->m_GZipContent.size() : Entry->m_Content.size();
+	}
+	const auto CacheTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+	LOG("Serving from cache: %.2f us per request, %zu bytes sent (%.0fx faster)",
+		CacheTime * 1e6 / NUM_REQUESTS, BytesSent / NUM_REQUESTS, ReadTime / CacheTime
+	);
+	cFile::DeleteFile(TEST_FILE_NAME);
+}
+
+
+
+
+
+IMPLEMENT_TEST_MAIN("HTTPFileCache",
+	TestLoadAndInvalidate();
+	TestHeaders();
+	Benchmark();
+)
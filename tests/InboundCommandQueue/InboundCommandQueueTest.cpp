@@ -0,0 +1,372 @@
+
+// InboundCommandQueueTest.cpp
+
+// Tests the cInboundCommandQueue class that holds the packets decoded in the network thread:
+// merging of the movements, keeping the packet order and data, the flood limits and their time window,
+// decoding the received data into the queue through cReceivedPacketSplitter,
+// and reports how many commands a typical client's tick leaves for the tick thread to apply
+
+#include "Globals.h"
+#include "../TestHelpers.h"
+#include "ByteBuffer.h"
+#include "StringCompression.h"
+#include "Protocol/InboundCommandQueue.h"
+#include "Protocol/ReceivedPacketSplitter.h"
+
+
+
+
+
+using cQueue = cInboundCommandQueue;
+using cClock = std::chrono::steady_clock;
+
+
+
+
+
+static cQueue::sMovement Position(double a_X, bool a_IsOnGround = true)
+{
+	return { { a_X, 64, 0 }, 0, 0, true, false, a_IsOnGround };
+}
+
+
+
+
+
+static cQueue::sMovement Look(float a_Yaw)
+{
+	return { { 0, 0, 0 }, a_Yaw, 10, false, true, false };
+}
+
+
+
+
+
+static ContiguousByteBuffer Packet(const char * a_Data)
+{
+	return ContiguousByteBuffer(reinterpret_cast<const std::byte *>(a_Data), strlen(a_Data));
+}
+
+
+
+
+
+/** Returns the VarInt encoding of the value. */
+static ContiguousByteBuffer VarInt(size_t a_Value)
+{
+	cByteBuffer Buffer(8);
+	VERIFY(Buffer.WriteVarInt32(static_cast<UInt32>(a_Value)));
+	ContiguousByteBuffer Res;
+	Buffer.ReadAll(Res);
+	return Res;
+}
+
+
+
+
+
+/** Returns the packet data (type and payload) framed the way the client sends it with the compression enabled:
+the length, the uncompressed size (0 if not compressed) and the (compressed) data. */
+static ContiguousByteBuffer Frame(const ContiguousByteBufferView a_Packet, bool a_ShouldCompress)
+{
+	ContiguousByteBuffer Compressed;
+	ContiguousByteBuffer Body = VarInt(a_ShouldCompress ? a_Packet.size() : 0);
+	Body.append(a_ShouldCompress ? Compression::Compressor().CompressZLib(a_Packet, Compressed) : a_Packet);
+	auto Res = VarInt(Body.size());
+	Res.append(Body);
+	return Res;
+}
+
+
+
+
+
+/** Checks that consecutive movements merge into the latest state, but not across other packets. */
+static void TestCoalescing(void)
+{
+	cQueue Queue(100, 1000);
+	TEST_TRUE(Queue.IsEmpty());
+	TEST_TRUE(Queue.PushMovement(Position(1)));
+	TEST_TRUE(Queue.PushMovement(Position(2)));
+	TEST_TRUE(Queue.PushMovement(Look(90)));
+	TEST_TRUE(Queue.PushMovement(Position(3, false)));
+	TEST_EQUAL(Queue.GetCommands().size(), 1);
+	TEST_EQUAL(Queue.GetNumCoalesced(), 3);
+
+	// The latest position and look, and the latest on-ground flag:
+	const auto & Merged = std::get<cQueue::sMovement>(Queue.GetCommands()[0]);
+	TEST_TRUE(Merged.m_HasPosition);
+	TEST_TRUE(Merged.m_HasLook);
+	TEST_EQUAL(Merged.m_Position, Vector3d(3, 64, 0));
+	TEST_EQUAL(Merged.m_Yaw, 90);
+	TEST_EQUAL(Merged.m_Pitch, 10);
+	TEST_FALSE(Merged.m_IsOnGround);
+
+	// A packet in between keeps the movements apart, so that e.g. digging sees the position the client had at the time:
+	TEST_TRUE(Queue.PushPacket(Packet("dig")));
+	TEST_TRUE(Queue.PushMovement(Look(180)));
+	TEST_EQUAL(Queue.GetCommands().size(), 3);
+	const auto & Later = std::get<cQueue::sMovement>(Queue.GetCommands()[2]);
+	TEST_FALSE(Later.m_HasPosition);
+	TEST_TRUE(Later.m_HasLook);
+	TEST_EQUAL(Later.m_Yaw, 180);
+}
+
+
+
+
+
+/** Checks that the packet data is kept in order, and that Swap() and Clear() hand the contents over. */
+static void TestPackets(void)
+{
+	cQueue Queue(100, 1000);
+	TEST_TRUE(Queue.PushPacket(Packet("first")));
+	TEST_TRUE(Queue.PushPacket(Packet("")));
+	TEST_TRUE(Queue.PushPacket(Packet("third")));
+
+	cQueue Applied(100, 1000);
+	Queue.Swap(Applied);
+	TEST_TRUE(Queue.IsEmpty());
+	TEST_EQUAL(Applied.GetCommands().size(), 3);
+	AString Data;
+	for (const auto & Command: Applied.GetCommands())
+	{
+		auto Packet = Applied.GetPacketData(std::get<cQueue::sPacket>(Command));
+		Data.append(reinterpret_cast<const char *>(Packet.data()), Packet.size()).push_back('|');
+	}
+	TEST_EQUAL(Data, "first||third|");
+
+	Applied.Clear();
+	TEST_TRUE(Applied.IsEmpty());
+	TEST_TRUE(Applied.PushPacket(Packet("again")));
+	auto Again = Applied.GetPacketData(std::get<cQueue::sPacket>(Applied.GetCommands()[0]));
+	TEST_EQUAL(Again.size(), 5);
+}
+
+
+
+
+
+/** Checks the limits on the number of commands and the packet bytes, and the error. */
+static void TestLimits(void)
+{
+	cQueue Queue(3, 10);
+	const auto Start = cClock::now();
+	Queue.UpdateLimitWindow(Start);
+	TEST_TRUE(Queue.PushPacket(Packet("12345")));
+	TEST_TRUE(Queue.PushPacket(Packet("67890")));
+	TEST_FALSE(Queue.PushPacket(Packet("x")));  // Over the byte limit
+	TEST_TRUE(Queue.PushMovement(Position(1)));
+	TEST_TRUE(Queue.PushMovement(Position(2)));  // Merged, doesn't count
+	TEST_FALSE(Queue.PushPacket(Packet("")));    // Over the command limit
+	TEST_EQUAL(Queue.GetCommands().size(), 3);
+
+	// Taking the commands out doesn't reset the limits, only a new window does:
+	cQueue Taken(3, 10);
+	Queue.Swap(Taken);
+	TEST_FALSE(Queue.PushPacket(Packet("")));
+	Queue.UpdateLimitWindow(Start + cQueue::LIMIT_WINDOW / 2);
+	TEST_FALSE(Queue.PushPacket(Packet("")));
+	Queue.UpdateLimitWindow(Start + cQueue::LIMIT_WINDOW);
+	TEST_TRUE(Queue.PushPacket(Packet("12345")));
+
+	// A packet is accepted whatever its size while the window's bytes are below the limit:
+	Queue.UpdateLimitWindow(Start + cQueue::LIMIT_WINDOW * 2);
+	TEST_TRUE(Queue.PushPacket(Packet("123456789")));
+	TEST_TRUE(Queue.PushPacket(Packet("This is longer than the limit")));
+	TEST_FALSE(Queue.PushPacket(Packet("x")));
+	Queue.UpdateLimitWindow(Start + cQueue::LIMIT_WINDOW * 3);
+	TEST_TRUE(Queue.PushPacket(Packet("This is longer than the limit")));
+
+	TEST_FALSE(Queue.HasError());
+	Queue.SetError("Too many packets");
+	Queue.SetError("Something else");
+	TEST_TRUE(Queue.HasError());
+	TEST_EQUAL(Queue.GetError(), "Too many packets");
+
+	// The error alone makes the queue non-empty, so that the tick thread kicks the client:
+	cQueue Applied(3, 10);
+	Queue.Swap(Applied);
+	Applied.Clear();
+	Applied.SetError("Compression packet incomplete");
+	TEST_FALSE(Applied.IsEmpty());
+}
+
+
+
+
+
+/** Checks that a client sending packets at a steady rate isn't limited while the tick thread stalls and takes nothing out,
+and that a flood within one window is. */
+static void TestTickStall(void)
+{
+	static const int PACKETS_PER_SECOND = 60;
+	cQueue Queue(100, 1000);
+	auto Now = cClock::now();
+	for (int i = 0; i < 10 * PACKETS_PER_SECOND; i++)
+	{
+		Queue.UpdateLimitWindow(Now);
+		TEST_TRUE(Queue.PushPacket(Packet("keepalive")));
+		Now += std::chrono::milliseconds(1000) / PACKETS_PER_SECOND;
+	}
+	TEST_EQUAL(Queue.GetCommands().size(), 10 * PACKETS_PER_SECOND);
+
+	// The same number of packets within one window:
+	cQueue Flooded(100, 1000);
+	Flooded.UpdateLimitWindow(Now);
+	int NumAccepted = 0;
+	for (int i = 0; i < 10 * PACKETS_PER_SECOND; i++)
+	{
+		NumAccepted += Flooded.PushPacket(Packet("keepalive")) ? 1 : 0;
+	}
+	TEST_EQUAL(NumAccepted, 100);
+}
+
+
+
+
+
+/** Checks the decoding of the received data into the queue: splitting, decompressing, partial packets, the movements,
+a single packet larger than the byte limit, and the errors. */
+static void TestDecode(void)
+{
+	// The old per-tick limits, a 1 MiB packet is over the bytes but still legal:
+	cQueue Queue(1024, 256 KiB);
+	cReceivedPacketSplitter Splitter;
+	cByteBuffer Received(4 MiB);
+	const auto Start = cClock::now();
+
+	// The test's movement packets: type 'p' is a position, with the X coord in the payload byte; type 'g' is on-ground only:
+	auto ParseMovement = [](const ContiguousByteBufferView a_Packet, cQueue::sMovement & a_Movement)
+	{
+		if (a_Packet.size() != 2)
+		{
+			return false;
+		}
+		switch (static_cast<char>(a_Packet[0]))
+		{
+			case 'p': a_Movement = Position(static_cast<double>(a_Packet[1])); return true;
+			case 'g': a_Movement = { { 0, 0, 0 }, 0, 0, false, false, true }; return true;
+		}
+		return false;
+	};
+	Queue.UpdateLimitWindow(Start);
+
+	ContiguousByteBuffer Large;
+	Large.push_back(std::byte{'L'});
+	for (size_t i = 1; i < 1 MiB; i++)
+	{
+		Large.push_back(static_cast<std::byte>((i * 7) % 251));
+	}
+	ContiguousByteBuffer Stream;
+	Stream.append(Frame(Packet("p\x01"), false));
+	Stream.append(Frame(Packet("g."), true));     // On-ground only, dropped
+	Stream.append(Frame(Packet("p\x02"), true));  // Merged into the previous position
+	Stream.append(Frame(Packet("chat message"), false));
+	Stream.append(Frame(Large, true));
+	Stream.append(Frame(Packet("after"), true));
+
+	// Everything but the last byte, the last packet stays in the buffer until it is complete:
+	TEST_TRUE(Received.Write(Stream.data(), Stream.size() - 1));
+	Splitter.DecodeInto(Received, Queue, ParseMovement);
+	TEST_FALSE(Queue.HasError());
+	const auto & Commands = Queue.GetCommands();
+	TEST_EQUAL(Commands.size(), 3);
+	TEST_EQUAL(std::get<cQueue::sMovement>(Commands[0]).m_Position.x, 2);
+	TEST_TRUE(Queue.GetPacketData(std::get<cQueue::sPacket>(Commands[1])) == Packet("chat message"));
+	TEST_TRUE(Queue.GetPacketData(std::get<cQueue::sPacket>(Commands[2])) == Large);
+
+	// The rest is over the byte limit in this window:
+	TEST_TRUE(Received.Write(Stream.data() + Stream.size() - 1, 1));
+	Splitter.DecodeInto(Received, Queue, ParseMovement);
+	TEST_EQUAL(Queue.GetError(), "Too many packets");
+	TEST_EQUAL(Commands.size(), 3);
+
+	// The same data spread over two windows is fine:
+	cQueue NextQueue(1024, 256 KiB);
+	NextQueue.UpdateLimitWindow(Start);
+	TEST_TRUE(Received.Write(Stream.data(), Stream.size() - 1));
+	Splitter.DecodeInto(Received, NextQueue, ParseMovement);
+	NextQueue.UpdateLimitWindow(Start + cQueue::LIMIT_WINDOW);
+	TEST_TRUE(Received.Write(Stream.data() + Stream.size() - 1, 1));
+	Splitter.DecodeInto(Received, NextQueue, ParseMovement);
+	TEST_FALSE(NextQueue.HasError());
+	TEST_EQUAL(NextQueue.GetCommands().size(), 4);
+	TEST_TRUE(NextQueue.GetPacketData(std::get<cQueue::sPacket>(NextQueue.GetCommands()[3])) == Packet("after"));
+	TEST_EQUAL(Received.GetReadableSpace(), 0);
+
+	// A packet too short for its uncompressed size is malformed:
+	cQueue Malformed(1024, 256 KiB);
+	const char Incomplete[] = { 1, '\x80' };
+	TEST_TRUE(Received.Write(Incomplete, sizeof(Incomplete)));
+	Splitter.DecodeInto(Received, Malformed, ParseMovement);
+	TEST_EQUAL(Malformed.GetError(), "Compression packet incomplete");
+}
+
+
+
+
+
+/** Simulates a client that sends a position and a look packet each client tick, and a few other packets,
+while the server ticks less often than the client; reports the number of commands applied per server tick. */
+static void Benchmark(void)
+{
+	static const int NUM_SERVER_TICKS = 200000;
+	static const int CLIENT_TICKS_PER_SERVER_TICK = 3;  // The server lagging behind, or a hacked client sending extra movement
+	static const auto SERVER_TICK = std::chrono::milliseconds(50);
+	cQueue Queue(4096, 4 MiB);
+	cQueue Applied(4096, 4 MiB);
+	const auto KeepAlive = Packet("keepalive");
+	size_t NumPushed = 0, NumApplied = 0;
+	double Sum = 0;
+	auto Start = std::chrono::steady_clock::now();
+	auto Now = Start;
+	for (int Tick = 0; Tick < NUM_SERVER_TICKS; Tick++)
+	{
+		Queue.UpdateLimitWindow(Now);
+		Now += SERVER_TICK;
+		for (int i = 0; i < CLIENT_TICKS_PER_SERVER_TICK; i++)
+		{
+			TEST_TRUE(Queue.PushMovement(Position(Tick + i * 0.1)));
+			TEST_TRUE(Queue.PushMovement(Look(static_cast<float>(i))));
+			NumPushed += 2;
+		}
+		if (Tick % 20 == 0)
+		{
+			TEST_TRUE(Queue.PushPacket(KeepAlive));
+			NumPushed += 1;
+		}
+
+		// The tick thread's side:
+		Queue.Swap(Applied);
+		for (const auto & Command: Applied.GetCommands())
+		{
+			if (auto Movement = std::get_if<cQueue::sMovement>(&Command))
+			{
+				Sum += Movement->m_Position.x;
+			}
+			NumApplied += 1;
+		}
+		Applied.Clear();
+	}
+	const auto Time = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+	TEST_LESS_THAN_OR_EQUAL(NumApplied * 5, NumPushed);
+	LOG("%zu packets pushed, %zu commands applied (%.1f per tick instead of %.1f), %.1f ns per packet (checksum %.0f)",
+		NumPushed, NumApplied,
+		static_cast<double>(NumApplied) / NUM_SERVER_TICKS, static_cast<double>(NumPushed) / NUM_SERVER_TICKS,
+		Time * 1e9 / static_cast<double>(NumPushed), Sum
+	);
+}
+
+
+
+
+
+IMPLEMENT_TEST_MAIN("InboundCommandQueue",
+	TestCoalescing();
+	TestPackets();
+	TestLimits();
+	TestTickStall();
+	TestDecode();
+	Benchmark();
+)
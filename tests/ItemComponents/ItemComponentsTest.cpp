@@ -0,0 +1,329 @@
+// ItemComponentsTest.cpp
+
+// Checks the copy-on-write sharing of the cItem components: copies are independent, plain items don't allocate,
+// reading doesn't unshare, and IsEqual() compares the components both when shared and when separate.
+// Measures the memory and the copying of the items of an inventory-heavy chunk, against the inline components layout.
+
+#include "Globals.h"
+#include "../TestHelpers.h"
+#include "Item.h"
+
+
+
+
+
+/** Number of the heap allocations and of the allocated bytes, counted while m_IsCounting is true. */
+static struct
+{
+	bool m_IsCounting = false;
+	size_t m_NumAllocations = 0;
+	size_t m_NumBytes = 0;
+} g_Allocations;
+
+
+
+
+
+void * operator new(size_t a_Size)
+{
+	if (g_Allocations.m_IsCounting)
+	{
+		g_Allocations.m_NumAllocations += 1;
+		g_Allocations.m_NumBytes += a_Size;
+	}
+	if (auto Res = std::malloc((a_Size == 0) ? 1 : a_Size))
+	{
+		return Res;
+	}
+	throw std::bad_alloc();
+}
+
+
+
+
+
+void operator delete(void * a_Ptr) noexcept
+{
+	std::free(a_Ptr);
+}
+
+
+
+
+
+void operator delete(void * a_Ptr, size_t a_Size) noexcept
+{
+	UNUSED(a_Size);
+	std::free(a_Ptr);
+}
+
+
+
+
+
+/** Counts the heap allocations made while the object exists. */
+class cAllocationCounter
+{
+public:
+
+	cAllocationCounter(void)
+	{
+		g_Allocations.m_NumAllocations = 0;
+		g_Allocations.m_NumBytes = 0;
+		g_Allocations.m_IsCounting = true;
+	}
+
+	~cAllocationCounter()
+	{
+		g_Allocations.m_IsCounting = false;
+	}
+
+	size_t GetNumAllocations(void) const { return g_Allocations.m_NumAllocations; }
+	size_t GetNumBytes(void) const { return g_Allocations.m_NumBytes; }
+};
+
+
+
+
+
+/** The cItem layout with the components stored inline in each item, for comparison in the benchmark. */
+struct sInlineItem
+{
+	Item           m_ItemType;
+	char           m_ItemCount;
+	short          m_ItemDamage;
+	cEnchantments  m_Enchantments;
+	AString        m_CustomName;
+	AStringVector  m_LoreTable;
+	int            m_RepairCost;
+	cFireworkItem  m_FireworkItem;
+	cColor         m_ItemColor;
+
+	explicit sInlineItem(const cItem & a_Item):
+		m_ItemType(a_Item.m_ItemType),
+		m_ItemCount(a_Item.m_ItemCount),
+		m_ItemDamage(a_Item.m_ItemDamage),
+		m_Enchantments(a_Item.GetEnchantments()),
+		m_CustomName(a_Item.GetCustomName()),
+		m_LoreTable(a_Item.GetLoreTable()),
+		m_RepairCost(a_Item.GetRepairCost()),
+		m_FireworkItem(a_Item.GetFireworkItem()),
+		m_ItemColor(a_Item.GetItemColor())
+	{
+	}
+};
+
+
+
+
+
+/** Plain items use the default components, copying and comparing them doesn't touch the heap. */
+static void TestPlainItemDoesntAllocate(void)
+{
+	cAllocationCounter Counter;
+	cItem Item1(Item::Stone, 64);
+	cItem Item2(Item1);
+	cItem Item3;
+	Item3 = Item2;
+	TEST_FALSE(Item1.HasComponents());
+	TEST_FALSE(Item3.HasComponents());
+	TEST_TRUE(Item1.IsEqual(Item3));
+	TEST_TRUE(Item3.GetEnchantments().IsEmpty());
+	TEST_TRUE(Item3.IsBothNameAndLoreEmpty());
+	TEST_EQUAL(Item3.GetRepairCost(), 0);
+	TEST_EQUAL(Counter.GetNumAllocations(), 0);
+}
+
+
+
+
+
+/** Changing a copy doesn't change the original, nor the other way round. */
+static void TestCopyThenModify(void)
+{
+	cItem Original(Item::DiamondSword, 1, 0, "unbreaking=3", "Original");
+	cItem Copy(Original);
+	cItem Assigned;
+	Assigned = Original;
+
+	Copy.ModifyEnchantments().SetLevel(cEnchantments::enchSharpness, 5);
+	Copy.SetCustomName("Copy");
+	TEST_EQUAL(Original.GetEnchantments().GetLevel(cEnchantments::enchSharpness), 0);
+	TEST_EQUAL(Original.GetCustomName(), "Original");
+	TEST_EQUAL(Assigned.GetEnchantments().GetLevel(cEnchantments::enchSharpness), 0);
+	TEST_EQUAL(Copy.GetEnchantments().GetLevel(cEnchantments::enchSharpness), 5);
+	TEST_EQUAL(Copy.GetEnchantments().GetLevel(cEnchantments::enchUnbreaking), 3);
+
+	Original.SetRepairCost(7);
+	Original.ModifyLoreTable().push_back("Lore");
+	TEST_EQUAL(Assigned.GetRepairCost(), 0);
+	TEST_TRUE(Assigned.IsLoreEmpty());
+	TEST_EQUAL(Copy.GetRepairCost(), 0);
+	TEST_EQUAL(Assigned.GetCustomName(), "Original");
+
+	// Emptying an item drops its reference to the shared components only:
+	Assigned.Empty();
+	TEST_FALSE(Assigned.HasComponents());
+	TEST_EQUAL(Original.GetEnchantments().GetLevel(cEnchantments::enchUnbreaking), 3);
+}
+
+
+
+
+
+/** Reading the components of an item sharing them with its copies keeps them shared. */
+static void TestReadDoesntUnshare(void)
+{
+	cItem Original(Item::DiamondPickaxe, 1, 0, "efficiency=4", "Shared", {"Lore"});
+	const cItem Copy(Original);
+
+	cAllocationCounter Counter;
+	TEST_EQUAL(Original.GetEnchantments().GetLevel(cEnchantments::enchEfficiency), 4);
+	TEST_EQUAL(Original.GetCustomName(), "Shared");
+	TEST_EQUAL(Original.GetLoreTable().size(), 1);
+	TEST_EQUAL(Original.GetItemColor().IsValid(), false);
+	TEST_TRUE(Original.IsEqual(Copy));
+	TEST_EQUAL(&Original.GetEnchantments(), &Copy.GetEnchantments());
+	TEST_EQUAL(&Original.GetLoreTable(), &Copy.GetLoreTable());
+	TEST_EQUAL(Counter.GetNumAllocations(), 0);
+}
+
+
+
+
+
+/** IsEqual() short-circuits on the shared components, and compares them member by member otherwise. */
+static void TestIsEqual(void)
+{
+	// Fast path, the same (or no) components:
+	cItem Plain1(Item::Dirt, 10), Plain2(Item::Dirt, 20);
+	TEST_TRUE(Plain1.IsEqual(Plain2));
+	cItem Enchanted(Item::DiamondSword, 1, 0, "sharpness=2");
+	cItem EnchantedCopy(Enchanted);
+	TEST_TRUE(Enchanted.IsEqual(EnchantedCopy));
+	TEST_FALSE(Enchanted.IsEqual(cItem(Item::DiamondSword, 1, 1, "sharpness=2")));
+
+	// Slow path, separate components with the same values:
+	cItem EnchantedSeparately(Item::DiamondSword, 1, 0, "sharpness=2");
+	TEST_NOTEQUAL(&Enchanted.GetEnchantments(), &EnchantedSeparately.GetEnchantments());
+	TEST_TRUE(Enchanted.IsEqual(EnchantedSeparately));
+
+	// Slow path, separate components with different values:
+	cItem Named(Enchanted);
+	Named.SetCustomName("Named");
+	TEST_FALSE(Enchanted.IsEqual(Named));
+	cItem Lored(Enchanted);
+	Lored.ModifyLoreTable().push_back("Lore");
+	TEST_FALSE(Enchanted.IsEqual(Lored));
+	cItem Stronger(Enchanted);
+	Stronger.ModifyEnchantments().SetLevel(cEnchantments::enchSharpness, 3);
+	TEST_FALSE(Enchanted.IsEqual(Stronger));
+
+	// Components changed back to the defaults equal the plain item's defaults:
+	cItem Reverted(Item::Dirt, 1, 0, "", "Name");
+	Reverted.SetCustomName("");
+	TEST_TRUE(Reverted.HasComponents());
+	TEST_TRUE(Reverted.IsEqual(Plain1));
+	TEST_TRUE(Plain1.IsEqual(Reverted));
+}
+
+
+
+
+
+/** Fills the slots of the chests of an inventory-heavy chunk: mostly plain stacks, with some enchanted tools and named items. */
+static std::vector<cItem> CreateChunkItems(void)
+{
+	static const int NUM_CHESTS = 200;
+	static const int NUM_SLOTS = 27;
+	std::vector<cItem> Res;
+	Res.reserve(NUM_CHESTS * NUM_SLOTS);
+	for (int i = 0; i < NUM_CHESTS * NUM_SLOTS; i++)
+	{
+		switch (i % 50)
+		{
+			case 0:
+			case 1:
+			case 2:
+			case 3:
+			{
+				Res.emplace_back(Item::DiamondPickaxe, 1, static_cast<short>(i % 300), "efficiency=4;unbreaking=3");
+				break;
+			}
+			case 4:
+			{
+				Res.emplace_back(Item::DiamondSword, 1, 0, "sharpness=5", "Blade " + std::to_string(i), AStringVector{"Forged in chest " + std::to_string(i / NUM_SLOTS)});
+				break;
+			}
+			case 5:
+			{
+				Res.emplace_back();
+				break;
+			}
+			default:
+			{
+				Res.emplace_back(((i % 3) == 0) ? Item::Cobblestone : Item::OakPlanks, 64);
+				break;
+			}
+		}
+	}
+	return Res;
+}
+
+
+
+
+
+/** Measures the heap usage of the chunk's items and the time to copy them (such as for saving the chunk), compared to the inline layout. */
+static void Benchmark(void)
+{
+	static const int NUM_COPIES = 2000;
+
+	size_t ItemsBytes, InlineBytes;
+	std::vector<cItem> Items;
+	std::vector<sInlineItem> InlineItems;
+	{
+		cAllocationCounter Counter;
+		Items = CreateChunkItems();
+		ItemsBytes = Counter.GetNumBytes();
+	}
+	{
+		cAllocationCounter Counter;
+		InlineItems.reserve(Items.size());
+		for (const auto & Item: Items)
+		{
+			InlineItems.emplace_back(Item);
+		}
+		InlineBytes = Counter.GetNumBytes();
+	}
+	LOG("Chunk with %zu item slots:", Items.size());
+	LOG("  cItem:  %zu bytes each, %zu bytes total", sizeof(cItem), ItemsBytes);
+	LOG("  inline: %zu bytes each, %zu bytes total", sizeof(sInlineItem), InlineBytes);
+
+	auto Measure = [](const char * a_Name, auto & a_Items)
+	{
+		cAllocationCounter Counter;
+		const auto Start = std::chrono::steady_clock::now();
+		for (int i = 0; i < NUM_COPIES; i++)
+		{
+			auto Copy = a_Items;
+			TEST_EQUAL(Copy.size(), a_Items.size());
+		}
+		const auto Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count() / NUM_COPIES;
+		LOG("  copying, %-6s %8.1f us, %6zu allocations, %8zu bytes per copy", a_Name, Seconds * 1e6, Counter.GetNumAllocations() / NUM_COPIES, Counter.GetNumBytes() / NUM_COPIES);
+	};
+	Measure("cItem:", Items);
+	Measure("inline:", InlineItems);
+}
+
+
+
+
+
+IMPLEMENT_TEST_MAIN("ItemComponents",
+	TestPlainItemDoesntAllocate();
+	TestCopyThenModify();
+	TestReadDoesntUnshare();
+	TestIsEqual();
+	Benchmark();
+)
@@ -0,0 +1,160 @@
+
+// NamespaceSerializerBenchmark.cpp
+
+// Checks that the NamespaceSerializer lookups map all the known names back to their values, with and without the namespace,
+// and compares their speed with lookups in std::unordered_map tables, as used before.
+
+#include "Globals.h"
+#include "../TestHelpers.h"
+#include "FastRandom.h"
+#include "WorldStorage/NamespaceSerializer.h"
+
+
+
+
+
+/** Number of lookups measured for each table. */
+static const size_t NUM_LOOKUPS = 4000000;
+
+
+
+
+
+/** Returns the names of all the values from a_First to a_Last (inclusive), as returned by NamespaceSerializer::From(). */
+template <typename T>
+static std::vector<std::pair<std::string_view, T>> GetAllNames(T a_First, T a_Last)
+{
+	std::vector<std::pair<std::string_view, T>> Res;
+	for (auto i = static_cast<int>(a_First); i <= static_cast<int>(a_Last); i++)
+	{
+		const auto Value = static_cast<T>(i);
+		Res.emplace_back(NamespaceSerializer::From(Value), Value);
+	}
+	return Res;
+}
+
+
+
+
+
+/** Checks that a_To(name) gives back a value with the same name, for all the names, including the "minecraft:"-prefixed ones. */
+template <typename T, typename ToFn>
+static void TestRoundTrip(const char * a_Kind, const std::vector<std::pair<std::string_view, T>> & a_Names, ToFn a_To)
+{
+	for (const auto & Entry: a_Names)
+	{
+		// Some values share the name, the lookup then returns only one of them:
+		TEST_EQUAL_MSG(NamespaceSerializer::From(a_To(Entry.first)), Entry.first, AString(Entry.first));
+		if (Entry.first.find(':') == std::string_view::npos)
+		{
+			const auto Namespaced = "minecraft:" + AString(Entry.first);
+			TEST_EQUAL_MSG(NamespaceSerializer::From(a_To(Namespaced)), Entry.first, Namespaced);
+		}
+	}
+	LOG("Checked %zu %s names", a_Names.size(), a_Kind);
+}
+
+
+
+
+
+/** Measures NUM_LOOKUPS lookups of random names through the NamespaceSerializer function and through a std::unordered_map. */
+template <typename T, typename ToFn>
+static void Benchmark(const char * a_Kind, const std::vector<std::pair<std::string_view, T>> & a_Names, ToFn a_To, const char * a_Prefix = "")
+{
+	// Own copies of the names, so that the lookups compare the contents rather than pointers:
+	std::vector<AString> Keys;
+	for (const auto & Entry: a_Names)
+	{
+		Keys.push_back(a_Prefix + AString(Entry.first));
+	}
+	cFastRandom Random;
+	std::vector<size_t> Order(NUM_LOOKUPS);
+	for (auto & Idx: Order)
+	{
+		Idx = Random.RandInt<size_t>(Keys.size() - 1);
+	}
+
+	std::unordered_map<std::string_view, T> Map(a_Names.begin(), a_Names.end());
+	const auto PrefixLength = strlen(a_Prefix);
+	int Checksum1 = 0;
+	auto Start = std::chrono::steady_clock::now();
+	for (auto Idx: Order)
+	{
+		// The callers used to strip the namespace by copying the rest of the name:
+		Checksum1 += static_cast<int>(Map.at((PrefixLength > 0) ? AString(Keys[Idx].substr(PrefixLength)) : Keys[Idx]));
+	}
+	const auto MapTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+
+	int Checksum2 = 0;
+	Start = std::chrono::steady_clock::now();
+	for (auto Idx: Order)
+	{
+		Checksum2 += static_cast<int>(a_To(Keys[Idx]));
+	}
+	const auto HashTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+
+	TEST_EQUAL(Checksum1, Checksum2);
+	LOG("%s%s: std::unordered_map %.1f ns, NamespaceSerializer %.1f ns per lookup (%.2fx)",
+		a_Kind, (PrefixLength > 0) ? " (namespaced)" : "",
+		MapTime * 1e9 / NUM_LOOKUPS, HashTime * 1e9 / NUM_LOOKUPS, MapTime / HashTime
+	);
+}
+
+
+
+
+
+int main()
+{
+	LOG("Test started: NamespaceSerializer");
+
+	try
+	{
+		const auto BlockNames = GetAllNames(BlockType::AcaciaButton, BlockType::ZombieWallHead);
+		const auto ItemNames = GetAllNames(Item::AcaciaBoat, Item::ZombifiedPiglinSpawnEgg);
+		const auto StatisticNames = GetAllNames(CustomStatistic::AchOpenInventory, CustomStatistic::WalkUnderWaterOneCm);
+		const auto BlockTo = [](std::string_view a_ID) { return NamespaceSerializer::ToBlockType(a_ID); };
+		const auto ItemTo = [](std::string_view a_ID) { return NamespaceSerializer::ToItem(a_ID); };
+		const auto StatisticTo = [](std::string_view a_ID) { return NamespaceSerializer::ToCustomStatistic(a_ID); };
+
+		TestRoundTrip("block", BlockNames, BlockTo);
+		TestRoundTrip("item", ItemNames, ItemTo);
+		TestRoundTrip("statistic", StatisticNames, StatisticTo);
+
+		// Aliases and the other tables:
+		TEST_EQUAL(NamespaceSerializer::ToBlockType("grass"), BlockType::ShortGrass);
+		TEST_EQUAL(NamespaceSerializer::ToItem("minecraft:gold_pickaxe"), Item::GoldenPickaxe);
+		TEST_EQUAL(NamespaceSerializer::ToMonsterType("minecraft:zombie"), mtZombie);
+		TEST_EQUAL(NamespaceSerializer::ToMonsterType("PigZombie"), mtZombiePigman);
+		TEST_EQUAL(NamespaceSerializer::ToEntityEffect("minecraft:speed"), cEntityEffect::effSpeed);
+
+		// Unknown names give the defaults:
+		TEST_EQUAL(NamespaceSerializer::ToBlockType("no_such_block"), BlockType::Air);
+		TEST_EQUAL(NamespaceSerializer::ToBlockType("minecraft:"), BlockType::Air);
+		TEST_EQUAL(NamespaceSerializer::ToItem(""), Item::Air);
+
+		Benchmark("Blocks", BlockNames, BlockTo);
+		Benchmark("Blocks", BlockNames, BlockTo, "minecraft:");
+		Benchmark("Items", ItemNames, ItemTo);
+		Benchmark("Statistics", StatisticNames, StatisticTo);
+	}
+	catch (const TestException & exc)
+	{
+		LOGERROR("Test has failed at file %s, line %d, function %s: %s",
+			exc.mFileName.c_str(),
+			exc.mLineNumber,
+			exc.mFunctionName.c_str(),
+			exc.mMessage.c_str()
+		);
+		return 1;
+	}
+	catch (const std::exception & exc)
+	{
+		LOGERROR("Test has failed, an exception was thrown: %s", exc.what());
+		return 1;
+	}
+
+	LOG("NamespaceSerializer test finished");
+	return 0;
+}
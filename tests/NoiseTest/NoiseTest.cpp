@@ -1,101 +1,399 @@
 
 // NoiseTest.cpp
 
-// Implements the main app entrypoint
+// Checks that the noise generators give bit-identical results with all the kernel instruction sets supported by the CPU,
+// and that the fused octave accumulation gives the same results as generating the octaves separately.
+// Checks that the improved noise handles queries wider than its precalculated X coords.
+// Measures the throughput of the generators with each instruction set.
 
 #include "Globals.h"
-#include <time.h>
-#include "Noise.h"
+#include <functional>
+#include "../TestHelpers.h"
+#include "Noise/Noise.h"
+#include "Noise/InterpolNoise.h"
 
 
 
 
 
-void SaveValues(NOISE_DATATYPE * a_Values, const AString & a_FileName)
+using eInstructionSet = NoiseKernels::eInstructionSet;
+
+
+
+
+
+/** Returns all the kernel instruction sets usable on this CPU. */
+static std::vector<eInstructionSet> GetInstructionSets(void)
+{
+	std::vector<eInstructionSet> Res;
+	for (auto InstructionSet: {eInstructionSet::Scalar, eInstructionSet::SSE41, eInstructionSet::AVX2})
+	{
+		if (InstructionSet <= NoiseKernels::GetBestInstructionSet())
+		{
+			Res.push_back(InstructionSet);
+		}
+	}
+	return Res;
+}
+
+
+
+
+
+/** Returns the number of values that are not bit-identical in the two arrays. */
+static int CountDifferent(const std::vector<NOISE_DATATYPE> & a_Values1, const std::vector<NOISE_DATATYPE> & a_Values2)
 {
-	cFile f;
-	if (!f.Open(a_FileName, cFile::fmWrite))
+	int Res = 0;
+	for (size_t i = 0; i < a_Values1.size(); i++)
 	{
-		LOGWARNING("Cannot write file %s", a_FileName.c_str());
-		return;
+		if (std::memcmp(&a_Values1[i], &a_Values2[i], sizeof(NOISE_DATATYPE)) != 0)
+		{
+			Res += 1;
+		}
+	}
+	return Res;
+}
+
+
+
+
+
+/** A single call to a noise generator, filling an array of m_NumValues values. */
+struct sQuery
+{
+	AString m_Name;
+	size_t m_NumValues;
+	std::function<void(NOISE_DATATYPE *)> m_Generate;
+};
+
+
+
+
+
+/** The noise generators used by the tests, in the configurations that the world generators use. */
+class cNoises
+{
+public:
+
+	cNoises(int a_Seed):
+		m_Cubic(a_Seed),
+		m_Interp(a_Seed),
+		m_Improved(a_Seed),
+		m_Perlin(a_Seed),
+		m_Ridged(a_Seed),
+		m_InterpOctaves(a_Seed)
+	{
+		m_Perlin.AddOctave(0.04f, 1);
+		m_Perlin.AddOctave(0.2f, 0.5f);
+		m_Perlin.AddOctave(1.1f, 0.25f);
+		m_Ridged.AddOctave(0.01f, 1.5f);
+		m_Ridged.AddOctave(0.05f, 0.5f);
+		m_InterpOctaves.AddOctave(1, 1);
+		m_InterpOctaves.AddOctave(2, 0.5f);
+		m_InterpOctaves.AddOctave(4, 0.25f);
+		m_InterpOctaves.AddOctave(8, 0.125f);
+	}
+
+
+	/** Returns the queries of the generator-typical sizes, starting at the specified noise-space coords. */
+	std::vector<sQuery> GetQueries(NOISE_DATATYPE a_X, NOISE_DATATYPE a_Z) const
+	{
+		return
+		{
+			{"cCubicNoise 2D 16x16", 16 * 16, [=](NOISE_DATATYPE * a_Out)
+				{
+					m_Cubic.Generate2D(a_Out, 16, 16, a_X / 8, a_X / 8 + 1.875f, a_Z / 8, a_Z / 8 + 1.875f);
+				}
+			},
+			{"cCubicNoise 3D 17x33x17", 17 * 33 * 17, [=](NOISE_DATATYPE * a_Out)
+				{
+					m_Cubic.Generate3D(a_Out, 17, 33, 17, a_X / 4, a_X / 4 + 4, 0, 8, a_Z / 4, a_Z / 4 + 4);
+				}
+			},
+			{"cInterp5DegNoise 2D 5x5", 5 * 5, [=](NOISE_DATATYPE * a_Out)
+				{
+					m_Interp.Generate2D(a_Out, 5, 5, a_X / 16, a_X / 16 + 1.0625f, a_Z / 16, a_Z / 16 + 1.0625f);
+				}
+			},
+			{"cInterp5DegNoise 3D 33x5x5", 33 * 5 * 5, [=](NOISE_DATATYPE * a_Out)
+				{
+					m_Interp.Generate3D(a_Out, 33, 5, 5, 0, 257.0f / 40, a_X / 40, (a_X + 17) / 40, a_Z / 40, (a_Z + 17) / 40);
+				}
+			},
+			{"cImprovedNoise 2D 16x16", 16 * 16, [=](NOISE_DATATYPE * a_Out)
+				{
+					m_Improved.Generate2D(a_Out, 16, 16, a_X / 8, a_X / 8 + 1.875f, a_Z / 8, a_Z / 8 + 1.875f);
+				}
+			},
+			{"cImprovedNoise 3D 17x33x17", 17 * 33 * 17, [=](NOISE_DATATYPE * a_Out)
+				{
+					m_Improved.Generate3D(a_Out, 17, 33, 17, a_X / 4, a_X / 4 + 4, 0, 8, a_Z / 4, a_Z / 4 + 4);
+				}
+			},
+			{"cPerlinNoise 2D 16x16, 3 octaves", 16 * 16, [=](NOISE_DATATYPE * a_Out)
+				{
+					m_Perlin.Generate2D(a_Out, 16, 16, a_X, a_X + 15, a_Z, a_Z + 15);
+				}
+			},
+			{"cRidgedMultiNoise 2D 16x16, 2 octaves", 16 * 16, [=](NOISE_DATATYPE * a_Out)
+				{
+					m_Ridged.Generate2D(a_Out, 16, 16, a_X, a_X + 15, a_Z, a_Z + 15);
+				}
+			},
+			{"cOctavedNoise<cInterp5DegNoise> 3D 33x5x5, 4 octaves", 33 * 5 * 5, [=](NOISE_DATATYPE * a_Out)
+				{
+					m_InterpOctaves.Generate3D(a_Out, 33, 5, 5, 0, 257.0f / 40, a_X / 40, (a_X + 17) / 40, a_Z / 40, (a_Z + 17) / 40);
+				}
+			},
+		};
 	}
-	for (int y = 0; y < 256; y++)
+
+protected:
+
+	cCubicNoise m_Cubic;
+	cInterp5DegNoise m_Interp;
+	cImprovedNoise m_Improved;
+	cPerlinNoise m_Perlin;
+	cRidgedMultiNoise m_Ridged;
+	cOctavedNoise<cInterp5DegNoise> m_InterpOctaves;
+};
+
+
+
+
+
+/** Checks that all the instruction sets give the same values as the scalar kernels,
+for the generator-typical queries around various coords, and for sizes that leave partial vectors at the row ends. */
+static void TestBitIdentical(void)
+{
+	const auto InstructionSets = GetInstructionSets();
+	for (int Seed: {0, 1, 1337, -65536})
 	{
-		unsigned char val[256];
-		for (int x = 0; x < 256; x++)
+		cNoises Noises(Seed);
+		std::vector<sQuery> Queries;
+		for (NOISE_DATATYPE Coord: {0.0f, 13.5f, -4097.25f, 123456.0f})
+		{
+			auto CoordQueries = Noises.GetQueries(Coord, -Coord / 3);
+			Queries.insert(Queries.end(), CoordQueries.begin(), CoordQueries.end());
+		}
+		cCubicNoise Cubic(Seed);
+		cImprovedNoise Improved(Seed);
+		cInterp5DegNoise Interp(Seed);
+		for (int Size = 2; Size < 40; Size += 3)
 		{
-			val[x] = std::min(255, std::max(0, (int)(256 * a_Values[x + 256 * y])));
+			const auto NumValues = static_cast<size_t>(Size * 7 * 3);
+			const auto End = static_cast<NOISE_DATATYPE>(Size) * 0.37f;
+			Queries.push_back({fmt::format(FMT_STRING("cCubicNoise 3D {}x7x3"), Size), NumValues, [&Cubic, Size, End](NOISE_DATATYPE * a_Out)
+				{
+					Cubic.Generate3D(a_Out, Size, 7, 3, -End, End, 0.5f, 3, -2, 1);
+				}
+			});
+			Queries.push_back({fmt::format(FMT_STRING("cImprovedNoise 3D {}x7x3"), Size), NumValues, [&Improved, Size, End](NOISE_DATATYPE * a_Out)
+				{
+					Improved.Generate3D(a_Out, Size, 7, 3, -End, End, 0.5f, 3, -2, 1);
+				}
+			});
+			Queries.push_back({fmt::format(FMT_STRING("cInterp5DegNoise 3D {}x7x3"), Size), NumValues, [&Interp, Size, End](NOISE_DATATYPE * a_Out)
+				{
+					Interp.Generate3D(a_Out, Size, 7, 3, -End, End, 0.5f, 3, -2, 1);
+				}
+			});
+		}
+
+		for (const auto & Query: Queries)
+		{
+			std::vector<NOISE_DATATYPE> Expected(Query.m_NumValues);
+			TEST_TRUE(NoiseKernels::SetInstructionSet(eInstructionSet::Scalar));
+			Query.m_Generate(Expected.data());
+			for (auto InstructionSet: InstructionSets)
+			{
+				std::vector<NOISE_DATATYPE> Values(Query.m_NumValues);
+				TEST_TRUE(NoiseKernels::SetInstructionSet(InstructionSet));
+				Query.m_Generate(Values.data());
+				TEST_EQUAL_MSG(CountDifferent(Expected, Values), 0, Query.m_Name + ", " + NoiseKernels::GetInstructionSetName(InstructionSet));
+			}
 		}
-		f.Write(val, 256);
 	}
+	NoiseKernels::SetInstructionSet(NoiseKernels::GetBestInstructionSet());
 }
 
 
 
 
 
-clock_t TestCubicNoise(void)
+/** Checks that the octaved and ridged noises give the same values as generating each octave into a workspace
+and accumulating it into the output afterwards, the way cOctavedNoise used to. */
+static void TestFusedOctaves(void)
 {
-	cCubicNoise Cubic(0);
-	NOISE_DATATYPE Values[256 * 256];
-	
-	// Do a speed test:
-	clock_t Begin = clock();
-	for (int i = 0; i < 1000; i++)
+	static const int SIZE_X = 21;
+	static const int SIZE_Y = 9;
+	static const int SIZE_Z = 13;
+	static const size_t NUM_VALUES = SIZE_X * SIZE_Y * SIZE_Z;
+	const std::vector<std::pair<NOISE_DATATYPE, NOISE_DATATYPE>> Octaves = {{0.1f, 3}, {0.35f, 1.25f}, {1.7f, 0.3f}, {6.1f, 0.07f}};
+
+	for (auto InstructionSet: GetInstructionSets())
 	{
-		Cubic.Generate2D(Values, 256, 256, 0, (NOISE_DATATYPE)25.6, 0, (NOISE_DATATYPE)25.6);
+		TEST_TRUE(NoiseKernels::SetInstructionSet(InstructionSet));
+		cCubicNoise Cubic(42);
+		cPerlinNoise Perlin(42);
+		cRidgedMultiNoise Ridged(42);
+		cInterp5DegNoise Interp(42);
+		cOctavedNoise<cInterp5DegNoise> InterpOctaves(42);
+		for (const auto & Octave: Octaves)
+		{
+			Perlin.AddOctave(Octave.first, Octave.second);
+			Ridged.AddOctave(Octave.first, Octave.second);
+			InterpOctaves.AddOctave(Octave.first, Octave.second);
+		}
+
+		// Generates the octaves separately using the single-octave generator, accumulates them into the expected values:
+		auto Reference = [&Octaves](std::function<void(NOISE_DATATYPE *, NOISE_DATATYPE)> a_Generate, bool a_IsAbsolute)
+		{
+			std::vector<NOISE_DATATYPE> Res(NUM_VALUES), Workspace(NUM_VALUES);
+			for (size_t o = 0; o < Octaves.size(); o++)
+			{
+				a_Generate(Workspace.data(), Octaves[o].first);
+				for (size_t i = 0; i < NUM_VALUES; i++)
+				{
+					const NOISE_DATATYPE Value = (a_IsAbsolute ? std::abs(Workspace[i]) : Workspace[i]) * Octaves[o].second;
+					Res[i] = (o == 0) ? Value : (Res[i] + Value);
+				}
+			}
+			return Res;
+		};
+		const auto CubicOctave2D = [&Cubic](NOISE_DATATYPE * a_Out, NOISE_DATATYPE a_Freq)
+		{
+			Cubic.Generate2D(a_Out, SIZE_X, SIZE_Y * SIZE_Z, -50 * a_Freq, 70 * a_Freq, 10 * a_Freq, 230 * a_Freq);
+		};
+		const auto CubicOctave3D = [&Cubic](NOISE_DATATYPE * a_Out, NOISE_DATATYPE a_Freq)
+		{
+			Cubic.Generate3D(a_Out, SIZE_X, SIZE_Y, SIZE_Z, -50 * a_Freq, 70 * a_Freq, 0, 30 * a_Freq, 10 * a_Freq, 90 * a_Freq);
+		};
+		const auto InterpOctave3D = [&Interp](NOISE_DATATYPE * a_Out, NOISE_DATATYPE a_Freq)
+		{
+			Interp.Generate3D(a_Out, SIZE_X, SIZE_Y, SIZE_Z, -50 * a_Freq, 70 * a_Freq, 0, 30 * a_Freq, 10 * a_Freq, 90 * a_Freq);
+		};
+
+		std::vector<NOISE_DATATYPE> Values(NUM_VALUES);
+		const AString Name = NoiseKernels::GetInstructionSetName(InstructionSet);
+		Perlin.Generate2D(Values.data(), SIZE_X, SIZE_Y * SIZE_Z, -50, 70, 10, 230);
+		TEST_EQUAL_MSG(CountDifferent(Reference(CubicOctave2D, false), Values), 0, "cPerlinNoise 2D, " + Name);
+		Perlin.Generate3D(Values.data(), SIZE_X, SIZE_Y, SIZE_Z, -50, 70, 0, 30, 10, 90);
+		TEST_EQUAL_MSG(CountDifferent(Reference(CubicOctave3D, false), Values), 0, "cPerlinNoise 3D, " + Name);
+		Ridged.Generate2D(Values.data(), SIZE_X, SIZE_Y * SIZE_Z, -50, 70, 10, 230);
+		TEST_EQUAL_MSG(CountDifferent(Reference(CubicOctave2D, true), Values), 0, "cRidgedMultiNoise 2D, " + Name);
+		Ridged.Generate3D(Values.data(), SIZE_X, SIZE_Y, SIZE_Z, -50, 70, 0, 30, 10, 90);
+		TEST_EQUAL_MSG(CountDifferent(Reference(CubicOctave3D, true), Values), 0, "cRidgedMultiNoise 3D, " + Name);
+		InterpOctaves.Generate3D(Values.data(), SIZE_X, SIZE_Y, SIZE_Z, -50, 70, 0, 30, 10, 90);
+		TEST_EQUAL_MSG(CountDifferent(Reference(InterpOctave3D, false), Values), 0, "cOctavedNoise<cInterp5DegNoise> 3D, " + Name);
 	}
-	clock_t Ticks = clock() - Begin;
-	LOG("cCubicNoise generating 1000 * 256x256 values took %d ticks (%.02f sec)", Ticks, (double)Ticks / CLOCKS_PER_SEC);
-	
-	// Save the results into a file for visual comparison:
-	SaveValues(Values, "NoiseCubic.raw");
-	
-	return Ticks;
+	NoiseKernels::SetInstructionSet(NoiseKernels::GetBestInstructionSet());
 }
 
 
 
 
 
-clock_t TestOldNoise(void)
+/** Checks that the improved noise queries wider than its X coord chunk give the same values as querying each X coord separately.
+The first row of the 2 * 2 (* 2) query starting at the X coord is the noise value at that coord, with no interpolation of the coord. */
+static void TestWideImproved(void)
 {
-	cNoise Noise(0);
-	NOISE_DATATYPE Values[256 * 256];
+	static const int SIZE_X = 1300;
+	static const NOISE_DATATYPE START_X = -37.3f;
+	static const NOISE_DATATYPE END_X = 61.9f;
+	cImprovedNoise Improved(7);
 
-	// Do a speed test:
-	clock_t Begin = clock();
-	for (int i = 0; i < 1000; i++)
+	for (auto InstructionSet: GetInstructionSets())
 	{
-		for (int y = 0; y < 256; y++)
+		TEST_TRUE(NoiseKernels::SetInstructionSet(InstructionSet));
+		const AString Name = NoiseKernels::GetInstructionSetName(InstructionSet);
+
+		// Guard the end of the arrays against writes past the queried size:
+		std::vector<NOISE_DATATYPE> Values2D(SIZE_X * 2 + 1, 1000);
+		std::vector<NOISE_DATATYPE> Values3D(SIZE_X * 2 * 2 + 1, 1000);
+		Improved.Generate2D(Values2D.data(), SIZE_X, 2, START_X, END_X, 2.7f, 3.1f);
+		Improved.Generate3D(Values3D.data(), SIZE_X, 2, 2, START_X, END_X, 2.7f, 3.1f, -5.2f, -4.9f);
+		TEST_EQUAL_MSG(Values2D.back(), 1000, "cImprovedNoise 2D guard, " + Name);
+		TEST_EQUAL_MSG(Values3D.back(), 1000, "cImprovedNoise 3D guard, " + Name);
+
+		int NumDifferent2D = 0, NumDifferent3D = 0;
+		for (int x = 0; x < SIZE_X; x++)
 		{
-			float fy = (float)y / 10;
-			for (int x = 0; x < 256; x++)
+			const NOISE_DATATYPE CoordX = Lerp(START_X, END_X, static_cast<NOISE_DATATYPE>(x) / (SIZE_X - 1));
+			NOISE_DATATYPE Expected[2 * 2 * 2];
+			Improved.Generate2D(Expected, 2, 2, CoordX, CoordX + 1, 2.7f, 3.1f);
+			if (std::memcmp(&Expected[0], &Values2D[static_cast<size_t>(x)], sizeof(NOISE_DATATYPE)) != 0)
+			{
+				NumDifferent2D += 1;
+			}
+			Improved.Generate3D(Expected, 2, 2, 2, CoordX, CoordX + 1, 2.7f, 3.1f, -5.2f, -4.9f);
+			if (std::memcmp(&Expected[0], &Values3D[static_cast<size_t>(x)], sizeof(NOISE_DATATYPE)) != 0)
 			{
-				Values[x + 256 * y] = Noise.CubicNoise2D((float)x / 10, fy);
-			}  // for x
-		}  // for y
+				NumDifferent3D += 1;
+			}
+		}
+		TEST_EQUAL_MSG(NumDifferent2D, 0, "cImprovedNoise 2D " + std::to_string(SIZE_X) + "x2, " + Name);
+		TEST_EQUAL_MSG(NumDifferent3D, 0, "cImprovedNoise 3D " + std::to_string(SIZE_X) + "x2x2, " + Name);
 	}
-	clock_t Ticks = clock() - Begin;
-	LOG("cNoise generating 1000 * 256x256 values took %d ticks (%.02f sec)", Ticks, (double)Ticks / CLOCKS_PER_SEC);
-	
-	// Save the results into a file for visual comparison:
-	SaveValues(Values, "NoiseOld.raw");
-	
-	return Ticks;
+	NoiseKernels::SetInstructionSet(NoiseKernels::GetBestInstructionSet());
 }
 
 
 
 
 
-int main(int argc, char * argv[])
+/** Measures the throughput of each generator-typical query with each instruction set, walking over the chunks like the generator does. */
+static void Benchmark(void)
 {
-	new cMCLogger();  // Create a logger (will set itself as the main instance
-	
-	clock_t NewTicks = TestCubicNoise();
-	clock_t OldTicks = TestOldNoise();
-	LOG("New method is %.02fx faster", (double)OldTicks / NewTicks);
-	LOG("Press Enter to quit program");
-	getchar();
+	static const int NUM_CHUNKS = 400;
+	cNoises Noises(1);
+	const auto InstructionSets = GetInstructionSets();
+	const auto NumQueries = Noises.GetQueries(0, 0).size();
+	LOG("Best kernel instruction set: %s", NoiseKernels::GetInstructionSetName(NoiseKernels::GetBestInstructionSet()));
+	for (size_t q = 0; q < NumQueries; q++)
+	{
+		double ScalarTime = 0;
+		NOISE_DATATYPE ScalarChecksum = 0;
+		for (auto InstructionSet: InstructionSets)
+		{
+			TEST_TRUE(NoiseKernels::SetInstructionSet(InstructionSet));
+			std::vector<NOISE_DATATYPE> Values;
+			NOISE_DATATYPE Checksum = 0;
+			size_t NumValues = 0;
+			AString Name;
+			const auto Start = std::chrono::steady_clock::now();
+			for (int i = 0; i < NUM_CHUNKS; i++)
+			{
+				const auto Query = Noises.GetQueries(static_cast<NOISE_DATATYPE>((i % 20) * 16), static_cast<NOISE_DATATYPE>((i / 20) * 16))[q];
+				Values.resize(Query.m_NumValues);
+				Query.m_Generate(Values.data());
+				Checksum += Values[0] + Values.back();
+				NumValues += Query.m_NumValues;
+				Name = Query.m_Name;
+			}
+			const auto Time = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+			if (InstructionSet == eInstructionSet::Scalar)
+			{
+				ScalarTime = Time;
+				ScalarChecksum = Checksum;
+			}
+			TEST_EQUAL(Checksum, ScalarChecksum);
+			LOG("%s, %s: %.1f Mvalues/s (%.2fx scalar)",
+				Name, NoiseKernels::GetInstructionSetName(InstructionSet),
+				static_cast<double>(NumValues) / Time / 1e6, ScalarTime / Time
+			);
+		}
+	}
+	NoiseKernels::SetInstructionSet(NoiseKernels::GetBestInstructionSet());
 }
+
+
+
+
+
+IMPLEMENT_TEST_MAIN("NoiseTest",
+	TestBitIdentical();
+	TestFusedOctaves();
+	TestWideImproved();
+	Benchmark();
+)
@@ -0,0 +1,458 @@
+
+// PalettedContainerTest.cpp
+
+// Tests that cPalettedContainer encodes sections losslessly and reports the packet size and encode time on sample worlds
+
+#include "Globals.h"
+#include "../TestHelpers.h"
+#include "ByteBuffer.h"
+#include "FastRandom.h"
+#include "Protocol/PalettedContainer.h"
+#include "Protocol/Palettes/Palette_1_21.h"
+#include "Registries/BlockStates.h"
+
+
+
+
+
+/** The number of chunks in each sample world. */
+static const int NUM_CHUNKS = 64;
+
+/** The size of a section as encoded before local palettes were used: block count, 15 bits per entry, longs count, 1024 longs. */
+static const size_t DIRECT_SECTION_SIZE = 2 + 1 + 2 + 1024 * 8;
+
+
+
+
+
+/** A sample world: the block data of each of its chunks. */
+struct sSampleWorld
+{
+	AString m_Name;
+	std::vector<std::unique_ptr<ChunkBlockData>> m_Chunks;
+};
+
+
+
+
+
+static UInt32 ToProtocol(UInt16 a_Key)
+{
+	return Palette_1_21::From(BlockState(a_Key));
+}
+
+
+
+
+
+/** Decodes a container written by cPalettedContainer::Write(), returning the protocol IDs of its a_Count entries. */
+static std::vector<UInt32> Decode(cByteBuffer & a_In, size_t a_Count, const cPalettedContainer::sRules & a_Rules)
+{
+	std::vector<UInt32> Res;
+	UInt8 BitsPerEntry = 0;
+	TEST_TRUE(a_In.ReadBEUInt8(BitsPerEntry));
+	if (BitsPerEntry == 0)
+	{
+		UInt32 Value = 0, NumLongs = 0;
+		TEST_TRUE(a_In.ReadVarInt32(Value));
+		TEST_TRUE(a_In.ReadVarInt32(NumLongs));
+		TEST_EQUAL(NumLongs, 0);
+		Res.assign(a_Count, Value);
+		return Res;
+	}
+
+	std::vector<UInt32> Palette;
+	const bool IsIndirect = (BitsPerEntry <= a_Rules.m_MaxIndirectBits);
+	if (IsIndirect)
+	{
+		UInt32 PaletteSize = 0;
+		TEST_TRUE(a_In.ReadVarInt32(PaletteSize));
+		Palette.resize(PaletteSize);
+		for (auto & Entry : Palette)
+		{
+			TEST_TRUE(a_In.ReadVarInt32(Entry));
+		}
+	}
+
+	UInt32 NumLongs = 0;
+	TEST_TRUE(a_In.ReadVarInt32(NumLongs));
+	TEST_EQUAL(NumLongs, cPalettedContainer::GetNumLongs(BitsPerEntry, a_Count));
+	const size_t EntriesPerLong = 64 / BitsPerEntry;
+	const UInt64 Mask = (static_cast<UInt64>(1) << BitsPerEntry) - 1;
+	for (UInt32 i = 0; i < NumLongs; i++)
+	{
+		UInt64 Long = 0;
+		TEST_TRUE(a_In.ReadBEUInt64(Long));
+		for (size_t e = 0; (e < EntriesPerLong) && (Res.size() < a_Count); e++)
+		{
+			const auto Value = static_cast<UInt32>((Long >> (e * BitsPerEntry)) & Mask);
+			if (IsIndirect)
+			{
+				TEST_TRUE(Value < Palette.size());
+				Res.push_back(Palette[Value]);
+			}
+			else
+			{
+				Res.push_back(Value);
+			}
+		}
+	}
+	return Res;
+}
+
+
+
+
+
+/** Encodes the section with the specified rules, checks the size and that it decodes back to the same protocol IDs. */
+static void TestRoundTrip(cPalettedContainer & a_Container, const ChunkBlockData::BlockArray * a_Section, const cPalettedContainer::sRules & a_Rules)
+{
+	a_Container.Analyse(a_Section);
+	a_Container.Map(&ToProtocol, a_Rules);
+
+	cByteBuffer Buffer(64 KiB);
+	a_Container.Write(Buffer, a_Section);
+	TEST_EQUAL(Buffer.GetReadableSpace(), a_Container.GetSize());
+
+	auto Decoded = Decode(Buffer, ChunkBlockData::SectionBlockCount, a_Rules);
+	TEST_EQUAL(Buffer.GetReadableSpace(), 0);
+	TEST_EQUAL(Decoded.size(), ChunkBlockData::SectionBlockCount);
+	for (size_t i = 0; i < ChunkBlockData::SectionBlockCount; i++)
+	{
+		const auto Expected = ToProtocol((a_Section == nullptr) ? ChunkBlockData::DefaultValue.ID : (*a_Section)[i].ID);
+		TEST_EQUAL(Decoded[i], Expected);
+	}
+}
+
+
+
+
+
+/** Checks the format choice and the round trip of sections with a growing number of distinct states. */
+static void TestFormats(void)
+{
+	cPalettedContainer Container;
+
+	// An empty section:
+	Container.Analyse(nullptr);
+	Container.Map(&ToProtocol, cPalettedContainer::BLOCK_RULES_1_18);
+	TEST_EQUAL(Container.GetFormat(), cPalettedContainer::eFormat::SingleValued);
+	Container.Map(&ToProtocol, cPalettedContainer::BLOCK_RULES_1_16);
+	TEST_EQUAL(Container.GetFormat(), cPalettedContainer::eFormat::Indirect);
+	TEST_EQUAL(Container.GetBitsPerEntry(), 4);
+	TestRoundTrip(Container, nullptr, cPalettedContainer::BLOCK_RULES_1_18);
+	TestRoundTrip(Container, nullptr, cPalettedContainer::BLOCK_RULES_1_16);
+
+	// Sections with a growing number of distinct states, shuffled:
+	cFastRandom Random;
+	ChunkBlockData::BlockArray Section;
+	for (size_t NumStates : {1, 2, 16, 17, 256, 257, 4096})
+	{
+		for (size_t i = 0; i < Section.size(); i++)
+		{
+			Section[i] = BlockState(static_cast<UInt16>(1 + (i * 7) % NumStates));
+		}
+		for (size_t i = Section.size() - 1; i > 0; i--)
+		{
+			std::swap(Section[i], Section[Random.RandInt<size_t>(i)]);
+		}
+		TestRoundTrip(Container, &Section, cPalettedContainer::BLOCK_RULES_1_16);
+		TestRoundTrip(Container, &Section, cPalettedContainer::BLOCK_RULES_1_18);
+
+		Container.Analyse(&Section);
+		TEST_EQUAL(Container.GetKeys().size(), NumStates);
+		Container.Map(&ToProtocol, cPalettedContainer::BLOCK_RULES_1_16);
+		LOG("%zu distinct states: %u bits per entry, %zu bytes", NumStates, Container.GetBitsPerEntry(), Container.GetSize());
+	}
+
+	// States mapping to the same protocol ID share the palette entry:
+	Container.Analyse(&Section);
+	Container.Map([](UInt16 a_Key) { return a_Key % 3; }, cPalettedContainer::BLOCK_RULES_1_18);
+	TEST_EQUAL(Container.GetFormat(), cPalettedContainer::eFormat::Indirect);
+	TEST_EQUAL(Container.GetBitsPerEntry(), 4);
+	Container.Map([](UInt16 a_Key) { return 0; }, cPalettedContainer::BLOCK_RULES_1_18);
+	TEST_EQUAL(Container.GetFormat(), cPalettedContainer::eFormat::SingleValued);
+
+	// Biomes:
+	std::array<UInt16, 64> Biomes;
+	Biomes.fill(1);
+	Container.Analyse(Biomes.data(), Biomes.size());
+	Container.Map([](UInt16 a_Biome) { return a_Biome; }, cPalettedContainer::BIOME_RULES_1_18);
+	TEST_EQUAL(Container.GetFormat(), cPalettedContainer::eFormat::SingleValued);
+	TEST_EQUAL(Container.GetSize(), 3);
+	Biomes[10] = 2;
+	Biomes[20] = 3;
+	Container.Analyse(Biomes.data(), Biomes.size());
+	Container.Map([](UInt16 a_Biome) { return a_Biome; }, cPalettedContainer::BIOME_RULES_1_18);
+	TEST_EQUAL(Container.GetFormat(), cPalettedContainer::eFormat::Indirect);
+	TEST_EQUAL(Container.GetBitsPerEntry(), 2);
+	cByteBuffer Buffer(1 KiB);
+	Container.Write(Buffer, Biomes.data());
+	TEST_EQUAL(Buffer.GetReadableSpace(), Container.GetSize());
+	auto Decoded = Decode(Buffer, Biomes.size(), cPalettedContainer::BIOME_RULES_1_18);
+	TEST_TRUE(std::equal(Decoded.begin(), Decoded.end(), Biomes.begin()));
+}
+
+
+
+
+
+/** Checks that the section revisions change with modifications and are shared by copies. */
+static void TestRevisions(void)
+{
+	ChunkBlockData Data;
+	Data.SetBlock({ 1, 17, 1 }, Block::Stone::Stone());
+	TEST_EQUAL(Data.GetSectionRevision(1), 0);
+
+	ChunkBlockData Copy;
+	Copy.Assign(Data);
+	const auto Revision = Copy.GetSectionRevision(1);
+	TEST_NOTEQUAL(Revision, 0);
+	TEST_EQUAL(Data.GetSectionRevision(1), Revision);
+
+	// Copying an unchanged section keeps its revision:
+	ChunkBlockData Copy2;
+	Copy2.Assign(Data);
+	TEST_EQUAL(Copy2.GetSectionRevision(1), Revision);
+
+	// A modification gets a new revision on the next copy:
+	Data.SetBlock({ 2, 17, 1 }, Block::Dirt::Dirt());
+	TEST_EQUAL(Data.GetSectionRevision(1), 0);
+	Copy2.Assign(Data);
+	TEST_NOTEQUAL(Copy2.GetSectionRevision(1), 0);
+	TEST_NOTEQUAL(Copy2.GetSectionRevision(1), Revision);
+}
+
+
+
+
+
+/** Creates a world of layers typical of superflat worlds. */
+static sSampleWorld CreateFlatWorld(void)
+{
+	sSampleWorld World{"Flat", {}};
+	for (int i = 0; i < NUM_CHUNKS; i++)
+	{
+		auto Chunk = std::make_unique<ChunkBlockData>();
+		for (int y = 0; y < 64; y++)
+		{
+			const auto State =
+				(y == 0) ? Block::Bedrock::Bedrock() :
+				(y < 60) ? Block::Stone::Stone() :
+				(y < 63) ? Block::Dirt::Dirt() :
+				Block::GrassBlock::GrassBlock(false);
+			for (int z = 0; z < cChunkDef::Width; z++)
+			{
+				for (int x = 0; x < cChunkDef::Width; x++)
+				{
+					Chunk->SetBlock({ x, y, z }, State);
+				}
+			}
+		}
+		World.m_Chunks.push_back(std::move(Chunk));
+	}
+	return World;
+}
+
+
+
+
+
+/** Creates a world of rolling hills with ores, caves and lakes, similar to what the default generator produces. */
+static sSampleWorld CreateHillsWorld(void)
+{
+	static const int SEA_LEVEL = 62;
+	sSampleWorld World{"Hills", {}};
+	cFastRandom Random;
+	for (int i = 0; i < NUM_CHUNKS; i++)
+	{
+		auto Chunk = std::make_unique<ChunkBlockData>();
+		for (int z = 0; z < cChunkDef::Width; z++)
+		{
+			for (int x = 0; x < cChunkDef::Width; x++)
+			{
+				const int BlockX = (i % 8) * cChunkDef::Width + x;
+				const int BlockZ = (i / 8) * cChunkDef::Width + z;
+				const int Height = 64 + static_cast<int>(12 * std::sin(BlockX / 11.0) + 9 * std::cos(BlockZ / 7.0));
+				for (int y = 0; y <= std::max(Height, SEA_LEVEL); y++)
+				{
+					BlockState State;
+					if (y > Height)
+					{
+						State = Block::Water::Water(0);
+					}
+					else if (y < Random.RandInt(1, 4))
+					{
+						State = Block::Bedrock::Bedrock();
+					}
+					else if (y < Height - 3)
+					{
+						const int Roll = Random.RandInt(999);
+						State =
+							(Roll < 30) ? Block::Air::Air() :
+							(Roll < 40) ? Block::CoalOre::CoalOre() :
+							(Roll < 45) ? Block::IronOre::IronOre() :
+							(Roll < 60) ? Block::Gravel::Gravel() :
+							Block::Stone::Stone();
+					}
+					else
+					{
+						State = ((y == Height) && (y >= SEA_LEVEL)) ? Block::GrassBlock::GrassBlock(false) : Block::Dirt::Dirt();
+					}
+					Chunk->SetBlock({ x, y, z }, State);
+				}
+			}
+		}
+		World.m_Chunks.push_back(std::move(Chunk));
+	}
+	return World;
+}
+
+
+
+
+
+/** Creates a world of random blocks out of 1000 states, the worst case that needs the direct palette. */
+static sSampleWorld CreateNoiseWorld(void)
+{
+	sSampleWorld World{"Noise", {}};
+	cFastRandom Random;
+	for (int i = 0; i < NUM_CHUNKS / 4; i++)
+	{
+		auto Chunk = std::make_unique<ChunkBlockData>();
+		for (size_t Y = 0; Y < cChunkDef::NumSections; Y++)
+		{
+			auto & Section = Chunk->GetSectionForOverwrite(Y);
+			for (auto & Block : Section)
+			{
+				Block = BlockState(static_cast<UInt16>(Random.RandInt(1000, 1999)));
+			}
+		}
+		World.m_Chunks.push_back(std::move(Chunk));
+	}
+	return World;
+}
+
+
+
+
+
+/** Writes the section the way it was written before local palettes, the direct palette with 15 bits per entry. */
+static void WriteDirect(cByteBuffer & a_Out, const ChunkBlockData::BlockArray * a_Section)
+{
+	a_Out.WriteBEInt16(4096);
+	a_Out.WriteBEUInt8(15);
+	a_Out.WriteVarInt32(1024);
+	for (size_t i = 0; i < ChunkBlockData::SectionBlockCount; i += 4)
+	{
+		UInt64 Long = 0;
+		for (size_t e = 0; e < 4; e++)
+		{
+			const auto Block = (a_Section == nullptr) ? ChunkBlockData::DefaultValue : (*a_Section)[i + e];
+			Long |= static_cast<UInt64>(Palette_1_21::From(Block)) << (e * 15);
+		}
+		a_Out.WriteBEUInt64(Long);
+	}
+}
+
+
+
+
+
+/** Measures the size and the time of encoding all the sections of the world, using the old and the new encoding. */
+static void Report(const sSampleWorld & a_World)
+{
+	cPalettedContainer Container;
+	cByteBuffer Buffer(64 KiB);
+	size_t NumSections = 0;
+	size_t OldSize = 0, NewSize116 = 0, NewSize118 = 0;
+	auto Drain = [&Buffer]()
+	{
+		auto Size = Buffer.GetReadableSpace();
+		Buffer.SkipRead(Size);
+		Buffer.CommitRead();
+		return Size;
+	};
+
+	// Old encoding; sections with no blocks were sent as direct containers of air, too:
+	auto Start = std::chrono::steady_clock::now();
+	for (const auto & Chunk : a_World.m_Chunks)
+	{
+		for (size_t Y = 0; Y < cChunkDef::NumSections; Y++)
+		{
+			WriteDirect(Buffer, Chunk->GetSection(Y));
+			OldSize += Drain();
+			NumSections++;
+		}
+	}
+	auto OldTime = std::chrono::steady_clock::now() - Start;
+	TEST_EQUAL(OldSize, NumSections * DIRECT_SECTION_SIZE);
+
+	// New encoding, analysing each section:
+	std::vector<cPalettedContainer::cKeys> Keys;
+	Start = std::chrono::steady_clock::now();
+	for (const auto & Chunk : a_World.m_Chunks)
+	{
+		for (size_t Y = 0; Y < cChunkDef::NumSections; Y++)
+		{
+			const auto Section = Chunk->GetSection(Y);
+			Container.Analyse(Section);
+			Keys.push_back(Container.GetKeys());
+			Container.Map(&ToProtocol, cPalettedContainer::BLOCK_RULES_1_18);
+			Buffer.WriteBEInt16(4096);
+			Container.Write(Buffer, Section);
+			NewSize118 += Drain();
+		}
+	}
+	auto NewTime = std::chrono::steady_clock::now() - Start;
+
+	// New encoding, with the analysis cached:
+	size_t CachedSize = 0;
+	Start = std::chrono::steady_clock::now();
+	size_t Idx = 0;
+	for (const auto & Chunk : a_World.m_Chunks)
+	{
+		for (size_t Y = 0; Y < cChunkDef::NumSections; Y++)
+		{
+			const auto Section = Chunk->GetSection(Y);
+			Container.Assign(Keys[Idx++], ChunkBlockData::SectionBlockCount);
+			Container.Map(&ToProtocol, cPalettedContainer::BLOCK_RULES_1_18);
+			Buffer.WriteBEInt16(4096);
+			Container.Write(Buffer, Section);
+			CachedSize += Drain();
+		}
+	}
+	auto CachedTime = std::chrono::steady_clock::now() - Start;
+	TEST_EQUAL(CachedSize, NewSize118);
+
+	// The 1.16 - 1.17 size, which doesn't have the single-valued format:
+	for (const auto & SectionKeys : Keys)
+	{
+		Container.Assign(SectionKeys, ChunkBlockData::SectionBlockCount);
+		Container.Map(&ToProtocol, cPalettedContainer::BLOCK_RULES_1_16);
+		NewSize116 += 2 + Container.GetSize();
+	}
+
+	using namespace std::chrono;
+	LOG("%s: %zu sections; direct: %zu bytes in %.2f msec; local palettes: %zu bytes (1.16 - 1.17), %zu bytes (1.18+), %.2f %% of direct; %.2f msec analysing, %.2f msec cached",
+		a_World.m_Name, NumSections,
+		OldSize, duration_cast<microseconds>(OldTime).count() / 1000.0,
+		NewSize116, NewSize118, 100.0 * static_cast<double>(NewSize118) / static_cast<double>(OldSize),
+		duration_cast<microseconds>(NewTime).count() / 1000.0,
+		duration_cast<microseconds>(CachedTime).count() / 1000.0
+	);
+	TEST_LESS_THAN_OR_EQUAL(NewSize118, NewSize116);
+	TEST_LESS_THAN_OR_EQUAL(NewSize116, OldSize);
+}
+
+
+
+
+
+IMPLEMENT_TEST_MAIN("PalettedContainer",
+	TestFormats();
+	TestRevisions();
+	Report(CreateFlatWorld());
+	Report(CreateHillsWorld());
+	Report(CreateNoiseWorld());
+)
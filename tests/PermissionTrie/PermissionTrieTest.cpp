@@ -0,0 +1,137 @@
+
+// PermissionTrieTest.cpp
+
+// Tests that cPermissionTrie matches the same permissions as the per-template matching in cPlayer
+
+#include "Globals.h"
+#include "../TestHelpers.h"
+#include "PermissionTrie.h"
+#include "FastRandom.h"
+
+
+
+
+
+/** The reference implementation, the same as cPlayer::PermissionMatches(). */
+static bool PermissionMatches(const AStringVector & a_Permission, const AStringVector & a_Template)
+{
+	size_t lenP = a_Permission.size();
+	size_t lenT = a_Template.size();
+	size_t minLen = std::min(lenP, lenT);
+	for (size_t i = 0; i < minLen; i++)
+	{
+		if (a_Template[i] == "*")
+		{
+			return true;
+		}
+		if (a_Permission[i] != a_Template[i])
+		{
+			return false;
+		}
+	}
+	return (lenP == lenT);
+}
+
+
+
+
+
+/** Returns true if any of the templates matches the permission, using the reference implementation. */
+static bool AnyMatches(const AString & a_Permission, const AStringVector & a_Templates)
+{
+	auto Split = StringSplit(a_Permission, ".");
+	for (const auto & Template : a_Templates)
+	{
+		if (PermissionMatches(Split, StringSplit(Template, ".")))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+
+
+
+
+static void TestBasic(void)
+{
+	cPermissionTrie Trie;
+	TEST_TRUE(Trie.IsEmpty());
+	TEST_FALSE(Trie.Matches("core.tp"));
+
+	Trie.Assign({"core.tp", "core.give.*", "worldedit.*.select", "admin."});
+	TEST_FALSE(Trie.IsEmpty());
+	TEST_TRUE(Trie.Matches("core.tp"));
+	TEST_FALSE(Trie.Matches("core.tp.other"));
+	TEST_FALSE(Trie.Matches("core"));
+	TEST_TRUE(Trie.Matches("core.give.diamond"));
+	TEST_TRUE(Trie.Matches("core.give.diamond.more"));
+	TEST_FALSE(Trie.Matches("core.give"));
+	TEST_TRUE(Trie.Matches("worldedit.anything"));
+	TEST_TRUE(Trie.Matches("admin"));
+	TEST_FALSE(Trie.Matches("admin.kick"));
+
+	Trie.Assign({"*"});
+	TEST_TRUE(Trie.Matches("anything.at.all"));
+	TEST_TRUE(Trie.Matches("."));
+
+	Trie.Clear();
+	TEST_TRUE(Trie.IsEmpty());
+	TEST_FALSE(Trie.Matches("anything"));
+}
+
+
+
+
+
+/** Compares the trie to the reference implementation on random templates and permissions made of a small alphabet of parts. */
+static void TestRandom(void)
+{
+	static const char * Parts[] = {"a", "b", "core", "*", ""};
+	cFastRandom Random;
+	auto RandomString = [&Random]()
+	{
+		AString Res;
+		int NumParts = Random.RandInt(1, 4);
+		for (int i = 0; i < NumParts; i++)
+		{
+			if (i > 0)
+			{
+				Res.push_back('.');
+			}
+			Res.append(Parts[Random.RandInt(0, 4)]);
+		}
+		return Res;
+	};
+
+	for (int i = 0; i < 500; i++)
+	{
+		AStringVector Templates;
+		int NumTemplates = Random.RandInt(0, 5);
+		for (int t = 0; t < NumTemplates; t++)
+		{
+			Templates.push_back(RandomString());
+		}
+		cPermissionTrie Trie;
+		Trie.Assign(Templates);
+		for (int p = 0; p < 50; p++)
+		{
+			auto Permission = RandomString();
+			if (Permission.empty())
+			{
+				continue;
+			}
+			TEST_EQUAL_MSG(Trie.Matches(Permission), AnyMatches(Permission, Templates), Permission);
+		}
+	}
+}
+
+
+
+
+
+IMPLEMENT_TEST_MAIN("PermissionTrie",
+	TestBasic();
+	TestRandom();
+)
@@ -0,0 +1,295 @@
+
+// SimpleBodyBatchTest.cpp
+
+// Checks the cSimpleBodyBatch physics against a small synthetic terrain,
+// and measures its throughput with 20k pickups and arrow-like fast bodies in motion.
+
+#include "Globals.h"
+#include "../TestHelpers.h"
+#include "Physics/SimpleBodyBatch.h"
+#include "FastRandom.h"
+
+
+
+
+
+/** The terrain spans the chunks in [-TERRAIN_CHUNKS, TERRAIN_CHUNKS) on both X and Z; the chunks around are not available. */
+static const int TERRAIN_CHUNKS = 2;
+
+/** The topmost block of the floor; everything from Y = 0 up to here is solid. */
+static const int FLOOR_Y = 64;
+
+/** The length of a tick. */
+static const std::chrono::milliseconds TICK(50);
+
+/** The body properties as set up by the pickups (cPickup constructor). */
+static const float PICKUP_GRAVITY = -16.0f;
+static const float PICKUP_DRAG = 0.02f;
+static const float PICKUP_SIZE = 0.25f;
+
+
+
+
+
+/** A flat floor with a pillar in every chunk, described by section solidity bitmaps. */
+class cTestTerrain
+{
+public:
+
+	cTestTerrain(void)
+	{
+		m_Full.fill(~static_cast<UInt64>(0));
+
+		// The floor's section is solid up to FLOOR_Y, the pillar at relative X = Z = 8 rises through the rest of the section:
+		m_Floor.fill(0);
+		for (int y = 0; y < cChunkDef::SectionHeight; y++)
+		{
+			for (int z = 0; z < cChunkDef::Width; z++)
+			{
+				for (int x = 0; x < cChunkDef::Width; x++)
+				{
+					const bool IsFloor = (FLOOR_SECTION * cChunkDef::SectionHeight + y <= FLOOR_Y);
+					const bool IsPillar = (x == 8) && (z == 8);
+					if (IsFloor || IsPillar)
+					{
+						const auto Index = cChunkDef::MakeIndex(x, y, z);
+						m_Floor[Index / 64] |= static_cast<UInt64>(1) << (Index % 64);
+					}
+				}
+			}
+		}
+	}
+
+
+	/** Provides the bitmaps to the batch, counting the calls. */
+	bool GetBitmap(int a_ChunkX, int a_ChunkZ, size_t a_SectionY, const ChunkBlockData::SectionBitmap *& a_Bitmap)
+	{
+		m_NumLookups += 1;
+		if ((a_ChunkX < -TERRAIN_CHUNKS) || (a_ChunkX >= TERRAIN_CHUNKS) || (a_ChunkZ < -TERRAIN_CHUNKS) || (a_ChunkZ >= TERRAIN_CHUNKS))
+		{
+			return false;
+		}
+		if (a_SectionY < FLOOR_SECTION)
+		{
+			a_Bitmap = &m_Full;
+		}
+		else if (a_SectionY == FLOOR_SECTION)
+		{
+			a_Bitmap = &m_Floor;
+		}
+		else
+		{
+			a_Bitmap = nullptr;
+		}
+		return true;
+	}
+
+
+	/** Returns true if the block at the specified absolute coords is solid. */
+	static bool IsSolid(Vector3i a_Pos)
+	{
+		const int RelX = a_Pos.x - FloorC(a_Pos.x / static_cast<double>(cChunkDef::Width)) * cChunkDef::Width;
+		const int RelZ = a_Pos.z - FloorC(a_Pos.z / static_cast<double>(cChunkDef::Width)) * cChunkDef::Width;
+		return (
+			(a_Pos.y <= FLOOR_Y) ||
+			((RelX == 8) && (RelZ == 8) && (a_Pos.y < (FLOOR_SECTION + 1) * cChunkDef::SectionHeight))
+		);
+	}
+
+
+	size_t m_NumLookups = 0;
+
+private:
+
+	static const size_t FLOOR_SECTION = FLOOR_Y / cChunkDef::SectionHeight;
+
+	ChunkBlockData::SectionBitmap m_Full;
+	ChunkBlockData::SectionBitmap m_Floor;
+};
+
+
+
+
+
+/** Returns a pickup-like body at the specified position with the specified speed. */
+static cSimpleBodyBatch::sBody MakePickup(Vector3d a_Pos, Vector3d a_Speed)
+{
+	return {a_Pos, a_Speed, {}, {}, PICKUP_GRAVITY, PICKUP_DRAG, PICKUP_SIZE, PICKUP_SIZE, 0};
+}
+
+
+
+
+
+/** Runs the batch with a single body for the specified number of ticks, as the chunk would, returns the final state of the body. */
+static cSimpleBodyBatch::sBody SimulateOne(cTestTerrain & a_Terrain, cSimpleBodyBatch::sBody a_Body, int a_NumTicks)
+{
+	cSimpleBodyBatch Batch;
+	for (int i = 0; i < a_NumTicks; i++)
+	{
+		Batch.Clear();
+		Batch.Add(a_Body);
+		Batch.Simulate(TICK, [&a_Terrain](int a_ChunkX, int a_ChunkZ, size_t a_SectionY, const ChunkBlockData::SectionBitmap *& a_Bitmap)
+		{
+			return a_Terrain.GetBitmap(a_ChunkX, a_ChunkZ, a_SectionY, a_Bitmap);
+		});
+		a_Body.m_Position = Batch.GetPosition(0);
+		a_Body.m_Speed = Batch.GetSpeed(0);
+		a_Body.m_WaterSpeed = Batch.GetWaterSpeed(0);
+		a_Body.m_Flags = Batch.IsOnGround(0) ? cSimpleBodyBatch::bfOnGround : 0;
+	}
+	return a_Body;
+}
+
+
+
+
+
+/** A body dropped above the floor lands on it and stops. */
+static void TestLanding(cTestTerrain & a_Terrain)
+{
+	const auto Body = SimulateOne(a_Terrain, MakePickup({2.5, FLOOR_Y + 10.5, 2.5}, {}), 100);
+	TEST_TRUE((Body.m_Flags & cSimpleBodyBatch::bfOnGround) != 0);
+	TEST_EQUAL(Body.m_Position.y, FLOOR_Y + 1);
+	TEST_EQUAL(Body.m_Speed.y, 0);
+	TEST_EQUAL(Body.m_Position.x, 2.5);
+	TEST_EQUAL(Body.m_Position.z, 2.5);
+}
+
+
+
+
+
+/** A body thrown at the pillar stops at its face, the collision box just touching it. */
+static void TestWallHit(cTestTerrain & a_Terrain)
+{
+	const auto Body = SimulateOne(a_Terrain, MakePickup({4.5, FLOOR_Y + 1.5, 8.5}, {20, 0, 0}), 10);
+	TEST_EQUAL(Body.m_Speed.x, 0);
+	TEST_TRUE(std::abs(Body.m_Position.x - (8 - PICKUP_SIZE / 2)) < 1e-9);
+	TEST_EQUAL(Body.m_Position.z, 8.5);
+}
+
+
+
+
+
+/** A body flying towards an unavailable chunk stays where it is. */
+static void TestUnavailableChunk(cTestTerrain & a_Terrain)
+{
+	const double Border = TERRAIN_CHUNKS * cChunkDef::Width;
+	const auto Body = SimulateOne(a_Terrain, MakePickup({Border - 0.5, FLOOR_Y + 5.5, 2.5}, {40, 0, 0}), 1);
+	TEST_EQUAL(Body.m_Position.x, Border - 0.5);
+	TEST_EQUAL(Body.m_Position.y, FLOOR_Y + 5.5);
+}
+
+
+
+
+
+/** A body outside the world's height range only falls. */
+static void TestFreeFall(cTestTerrain & a_Terrain)
+{
+	auto Start = MakePickup({2.5, cChunkDef::Height + 20, 2.5}, {1, 0, 0});
+	Start.m_Flags = cSimpleBodyBatch::bfFreeFall;
+	const auto Body = SimulateOne(a_Terrain, Start, 1);
+	TEST_EQUAL(Body.m_Speed.y, PICKUP_GRAVITY * 0.05);
+	TEST_EQUAL(Body.m_Speed.x, 1);
+	TEST_TRUE(std::abs(Body.m_Position.y - (cChunkDef::Height + 20 + PICKUP_GRAVITY * 0.05 * 0.05)) < 1e-9);
+}
+
+
+
+
+
+/** Simulates the bodies in motion over the terrain, like a chunk would in each tick, and checks that none of them ends up in a block. */
+static void Benchmark(cTestTerrain & a_Terrain, size_t a_NumPickups, size_t a_NumArrows, int a_NumTicks)
+{
+	cFastRandom Random;
+	const auto RandomPosition = [&Random]()
+	{
+		const double Size = TERRAIN_CHUNKS * cChunkDef::Width - 1;
+		for (;;)
+		{
+			const Vector3d Pos(Random.RandReal(-Size, Size), Random.RandReal(FLOOR_Y + 1.0, FLOOR_Y + 20.0), Random.RandReal(-Size, Size));
+			if (!cTestTerrain::IsSolid(Pos.Floor()))
+			{
+				return Pos;
+			}
+		}
+	};
+
+	std::vector<cSimpleBodyBatch::sBody> Bodies;
+	for (size_t i = 0; i < a_NumPickups; i++)
+	{
+		Bodies.push_back(MakePickup(
+			RandomPosition(),
+			{Random.RandReal(-4.0, 4.0), Random.RandReal(0.0, 6.0), Random.RandReal(-4.0, 4.0)}
+		));
+	}
+	for (size_t i = 0; i < a_NumArrows; i++)
+	{
+		// Arrows are fast and cross several blocks in a tick:
+		Bodies.push_back({
+			RandomPosition(),
+			{Random.RandReal(-60.0, 60.0), Random.RandReal(-10.0, 20.0), Random.RandReal(-60.0, 60.0)},
+			{}, {}, -20.0f, 0.01f, 0.5f, 0.5f, 0
+		});
+	}
+
+	cSimpleBodyBatch Batch;
+	a_Terrain.m_NumLookups = 0;
+	const auto Start = std::chrono::steady_clock::now();
+	for (int Tick = 0; Tick < a_NumTicks; Tick++)
+	{
+		Batch.Clear();
+		for (const auto & Body : Bodies)
+		{
+			Batch.Add(Body);
+		}
+		Batch.Simulate(TICK, [&a_Terrain](int a_ChunkX, int a_ChunkZ, size_t a_SectionY, const ChunkBlockData::SectionBitmap *& a_Bitmap)
+		{
+			return a_Terrain.GetBitmap(a_ChunkX, a_ChunkZ, a_SectionY, a_Bitmap);
+		});
+		for (size_t i = 0; i < Bodies.size(); i++)
+		{
+			Bodies[i].m_Position = Batch.GetPosition(i);
+			Bodies[i].m_Speed = Batch.GetSpeed(i);
+			Bodies[i].m_WaterSpeed = Batch.GetWaterSpeed(i);
+			Bodies[i].m_Flags = Batch.IsOnGround(i) ? cSimpleBodyBatch::bfOnGround : 0;
+		}
+	}
+	const auto Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+
+	size_t NumOnGround = 0;
+	for (const auto & Body : Bodies)
+	{
+		TEST_FALSE(cTestTerrain::IsSolid(Body.m_Position.Floor()));
+		TEST_LESS_THAN_OR_EQUAL(std::abs(Body.m_Position.x), TERRAIN_CHUNKS * cChunkDef::Width);
+		TEST_LESS_THAN_OR_EQUAL(std::abs(Body.m_Position.z), TERRAIN_CHUNKS * cChunkDef::Width);
+		if ((Body.m_Flags & cSimpleBodyBatch::bfOnGround) != 0)
+		{
+			NumOnGround += 1;
+		}
+	}
+
+	LOG("%zu pickups and %zu arrows, %d ticks: %.3f ms per tick, %.1f M bodies / s; %zu bodies on the ground, %.2f section lookups per body per tick",
+		a_NumPickups, a_NumArrows, a_NumTicks,
+		Seconds * 1000 / a_NumTicks,
+		static_cast<double>(Bodies.size()) * a_NumTicks / Seconds / 1e6,
+		NumOnGround,
+		static_cast<double>(a_Terrain.m_NumLookups) / static_cast<double>(Bodies.size() * static_cast<size_t>(a_NumTicks))
+	);
+}
+
+
+
+
+
+IMPLEMENT_TEST_MAIN("SimpleBodyBatch",
+	cTestTerrain Terrain;
+	TestLanding(Terrain);
+	TestWallHit(Terrain);
+	TestUnavailableChunk(Terrain);
+	TestFreeFall(Terrain);
+	Benchmark(Terrain, 10000, 10000, 100);
+)